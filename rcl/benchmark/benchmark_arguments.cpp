@@ -0,0 +1,118 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "rcl/arguments.h"
+#include "rcl/error_handling.h"
+#include "rcl/remap.h"
+
+#define BENCHMARK_CHECK(ret) \
+  do { \
+    if (RCL_RET_OK != (ret)) { \
+      fprintf( \
+        stderr, "%s:%d: %s\n", __FILE__, __LINE__, rcl_get_error_string().str); \
+      exit(1); \
+    } \
+  } while (0)
+
+namespace
+{
+
+/// Build an argv with `num_rules` distinct topic remap rules.
+std::vector<std::string> make_remap_args(size_t num_rules)
+{
+  std::vector<std::string> args;
+  args.reserve(num_rules + 1);
+  args.push_back("process_name");
+  for (size_t i = 0; i < num_rules; ++i) {
+    args.push_back(
+      "/topic" + std::to_string(i) + ":=/remapped" + std::to_string(i));
+  }
+  return args;
+}
+
+std::vector<const char *> make_argv(const std::vector<std::string> & args)
+{
+  std::vector<const char *> argv;
+  argv.reserve(args.size());
+  for (const std::string & arg : args) {
+    argv.push_back(arg.c_str());
+  }
+  return argv;
+}
+
+}  // namespace
+
+/// Measure rcl_parse_arguments with N remap rules.
+static void BM_parse_arguments(benchmark::State & state)
+{
+  const size_t num_rules = static_cast<size_t>(state.range(0));
+  const std::vector<std::string> args = make_remap_args(num_rules);
+  const std::vector<const char *> argv = make_argv(args);
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  for (auto _ : state) {
+    (void)_;
+    rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+    BENCHMARK_CHECK(
+      rcl_parse_arguments(
+        static_cast<int>(argv.size()), argv.data(), allocator, &parsed_args));
+    BENCHMARK_CHECK(rcl_arguments_fini(&parsed_args));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_rules));
+}
+BENCHMARK(BM_parse_arguments)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+/// Measure a topic remap lookup against N parsed rules.
+/**
+ * The looked-up name matches the last rule, so every rule is considered;
+ * this is the worst case an entity creation pays per name.
+ */
+static void BM_remap_topic_name(benchmark::State & state)
+{
+  const size_t num_rules = static_cast<size_t>(state.range(0));
+  const std::vector<std::string> args = make_remap_args(num_rules);
+  const std::vector<const char *> argv = make_argv(args);
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+  BENCHMARK_CHECK(
+    rcl_parse_arguments(
+      static_cast<int>(argv.size()), argv.data(), allocator, &parsed_args));
+
+  const std::string topic_name = "/topic" + std::to_string(num_rules - 1);
+  for (auto _ : state) {
+    (void)_;
+    char * output = nullptr;
+    BENCHMARK_CHECK(
+      rcl_remap_topic_name(
+        &parsed_args, nullptr, topic_name.c_str(), "node_name", "/", allocator,
+        &output));
+    if (output) {
+      allocator.deallocate(output, allocator.state);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  BENCHMARK_CHECK(rcl_arguments_fini(&parsed_args));
+}
+BENCHMARK(BM_remap_topic_name)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
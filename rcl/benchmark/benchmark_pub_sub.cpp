@@ -0,0 +1,156 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rosidl_generator_c/message_type_support_struct.h"
+#include "test_msgs/msg/primitives.h"
+
+#define BENCHMARK_CHECK(ret) \
+  do { \
+    if (RCL_RET_OK != (ret)) { \
+      fprintf( \
+        stderr, "%s:%d: %s\n", __FILE__, __LINE__, rcl_get_error_string().str); \
+      exit(1); \
+    } \
+  } while (0)
+
+namespace
+{
+
+/// Context, node, publisher and subscription on one topic, torn down in
+/// reverse order.
+class PubSubFixture
+{
+public:
+  PubSubFixture()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    BENCHMARK_CHECK(rcl_init_options_init(&init_options, rcl_get_default_allocator()));
+    context = rcl_get_zero_initialized_context();
+    BENCHMARK_CHECK(rcl_init(0, nullptr, &init_options, &context));
+    BENCHMARK_CHECK(rcl_init_options_fini(&init_options));
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    BENCHMARK_CHECK(
+      rcl_node_init(&node, "benchmark_pub_sub_node", "", &context, &node_options));
+    const rosidl_message_type_support_t * type_support =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+    const char * topic_name = "benchmark_pub_sub_topic";
+    publisher = rcl_get_zero_initialized_publisher();
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    BENCHMARK_CHECK(
+      rcl_publisher_init(&publisher, &node, type_support, topic_name, &publisher_options));
+    subscription = rcl_get_zero_initialized_subscription();
+    rcl_subscription_options_t subscription_options =
+      rcl_subscription_get_default_options();
+    BENCHMARK_CHECK(
+      rcl_subscription_init(
+        &subscription, &node, type_support, topic_name, &subscription_options));
+  }
+
+  ~PubSubFixture()
+  {
+    BENCHMARK_CHECK(rcl_subscription_fini(&subscription, &node));
+    BENCHMARK_CHECK(rcl_publisher_fini(&publisher, &node));
+    BENCHMARK_CHECK(rcl_node_fini(&node));
+    BENCHMARK_CHECK(rcl_shutdown(&context));
+    BENCHMARK_CHECK(rcl_context_fini(&context));
+  }
+
+  rcl_context_t context;
+  rcl_node_t node;
+  rcl_publisher_t publisher;
+  rcl_subscription_t subscription;
+};
+
+}  // namespace
+
+/// Measure a publish + take round trip through the middleware.
+/**
+ * Each iteration publishes one message and spins on rcl_take until it comes
+ * back, so the number includes serialization, transport and the take path.
+ * The subscription is discovered once, before timing starts.
+ */
+static void BM_publish_take_round_trip(benchmark::State & state)
+{
+  PubSubFixture fixture;
+
+  test_msgs__msg__Primitives message;
+  test_msgs__msg__Primitives__init(&message);
+  message.int64_value = 0;
+
+  // Prime discovery so the first timed iteration does not measure matching.
+  bool matched = false;
+  for (int attempt = 0; attempt < 1000 && !matched; ++attempt) {
+    BENCHMARK_CHECK(rcl_publish(&fixture.publisher, &message));
+    rcl_ret_t ret = rcl_take(&fixture.subscription, &message, nullptr);
+    if (RCL_RET_OK == ret) {
+      matched = true;
+    } else if (RCL_RET_SUBSCRIPTION_TAKE_FAILED != ret) {
+      BENCHMARK_CHECK(ret);
+    }
+    rcl_reset_error();
+  }
+  if (!matched) {
+    state.SkipWithError("publisher and subscription never matched");
+    test_msgs__msg__Primitives__fini(&message);
+    return;
+  }
+  // Drain anything left over from priming.
+  while (RCL_RET_OK == rcl_take(&fixture.subscription, &message, nullptr)) {}
+  rcl_reset_error();
+
+  int64_t sequence = 0;
+  for (auto _ : state) {
+    (void)_;
+    message.int64_value = sequence++;
+    BENCHMARK_CHECK(rcl_publish(&fixture.publisher, &message));
+    rcl_ret_t ret = RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+    while (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      ret = rcl_take(&fixture.subscription, &message, nullptr);
+    }
+    BENCHMARK_CHECK(ret);
+    rcl_reset_error();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  test_msgs__msg__Primitives__fini(&message);
+}
+BENCHMARK(BM_publish_take_round_trip);
+
+/// Measure rcl_publish alone, without waiting for delivery.
+static void BM_publish_only(benchmark::State & state)
+{
+  PubSubFixture fixture;
+
+  test_msgs__msg__Primitives message;
+  test_msgs__msg__Primitives__init(&message);
+
+  for (auto _ : state) {
+    (void)_;
+    BENCHMARK_CHECK(rcl_publish(&fixture.publisher, &message));
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  test_msgs__msg__Primitives__fini(&message);
+}
+BENCHMARK(BM_publish_only);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,156 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+
+// Abort the whole run on setup failures so a broken environment cannot
+// produce misleading numbers.
+#define BENCHMARK_CHECK(ret) \
+  do { \
+    if (RCL_RET_OK != (ret)) { \
+      fprintf( \
+        stderr, "%s:%d: %s\n", __FILE__, __LINE__, rcl_get_error_string().str); \
+      exit(1); \
+    } \
+  } while (0)
+
+namespace
+{
+
+class ScopedContext
+{
+public:
+  ScopedContext()
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    BENCHMARK_CHECK(rcl_init_options_init(&init_options, rcl_get_default_allocator()));
+    context = rcl_get_zero_initialized_context();
+    BENCHMARK_CHECK(rcl_init(0, nullptr, &init_options, &context));
+    BENCHMARK_CHECK(rcl_init_options_fini(&init_options));
+  }
+
+  ~ScopedContext()
+  {
+    BENCHMARK_CHECK(rcl_shutdown(&context));
+    BENCHMARK_CHECK(rcl_context_fini(&context));
+  }
+
+  rcl_context_t context;
+};
+
+}  // namespace
+
+/// Measure one wait set populate + wait cycle with N guard conditions.
+/**
+ * This is the executor inner loop: clear the set, re-add every entity, and
+ * wait with a zero timeout so only the rebuild and collection cost is
+ * measured, not time spent blocked in the middleware.
+ */
+static void BM_wait_set_populate_and_wait(benchmark::State & state)
+{
+  const size_t num_guard_conditions = static_cast<size_t>(state.range(0));
+  ScopedContext scoped_context;
+
+  std::vector<rcl_guard_condition_t> guard_conditions(
+    num_guard_conditions, rcl_get_zero_initialized_guard_condition());
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    BENCHMARK_CHECK(
+      rcl_guard_condition_init(
+        &guard_condition, &scoped_context.context,
+        rcl_guard_condition_get_default_options()));
+  }
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  BENCHMARK_CHECK(
+    rcl_wait_set_init(
+      &wait_set, 0, num_guard_conditions, 0, 0, 0, rcl_get_default_allocator()));
+
+  for (auto _ : state) {
+    (void)_;
+    BENCHMARK_CHECK(rcl_wait_set_clear(&wait_set));
+    for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+      BENCHMARK_CHECK(
+        rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+    }
+    rcl_ret_t ret = rcl_wait(&wait_set, 0);
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      BENCHMARK_CHECK(ret);
+    }
+    rcl_reset_error();
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<int64_t>(num_guard_conditions));
+
+  BENCHMARK_CHECK(rcl_wait_set_fini(&wait_set));
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    BENCHMARK_CHECK(rcl_guard_condition_fini(&guard_condition));
+  }
+}
+BENCHMARK(BM_wait_set_populate_and_wait)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+/// Measure the wait cycle without repopulating the set between waits.
+/**
+ * The retained-set fast path: entities are added once and only rcl_wait is
+ * paid per cycle, so the delta against BM_wait_set_populate_and_wait is the
+ * rebuild cost itself.
+ */
+static void BM_wait_set_wait_only(benchmark::State & state)
+{
+  const size_t num_guard_conditions = static_cast<size_t>(state.range(0));
+  ScopedContext scoped_context;
+
+  std::vector<rcl_guard_condition_t> guard_conditions(
+    num_guard_conditions, rcl_get_zero_initialized_guard_condition());
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    BENCHMARK_CHECK(
+      rcl_guard_condition_init(
+        &guard_condition, &scoped_context.context,
+        rcl_guard_condition_get_default_options()));
+  }
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  BENCHMARK_CHECK(
+    rcl_wait_set_init(
+      &wait_set, 0, num_guard_conditions, 0, 0, 0, rcl_get_default_allocator()));
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    BENCHMARK_CHECK(
+      rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, nullptr));
+  }
+
+  for (auto _ : state) {
+    (void)_;
+    rcl_ret_t ret = rcl_wait(&wait_set, 0);
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      BENCHMARK_CHECK(ret);
+    }
+    rcl_reset_error();
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<int64_t>(num_guard_conditions));
+
+  BENCHMARK_CHECK(rcl_wait_set_fini(&wait_set));
+  for (rcl_guard_condition_t & guard_condition : guard_conditions) {
+    BENCHMARK_CHECK(rcl_guard_condition_fini(&guard_condition));
+  }
+}
+BENCHMARK(BM_wait_set_wait_only)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,124 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ARENA_H_
+#define RCL__ARENA_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// \file
+/// Bump allocator for groups of allocations with a common lifetime.
+/**
+ * Memory is carved from a chain of blocks obtained from an underlying
+ * allocator; individual deallocations are no-ops and the whole chain is
+ * released at once by rcl_arena_fini().  This turns workloads that make many
+ * small allocations which all die together (like argument parsing, or a
+ * large graph query result) into a handful of block allocations.
+ *
+ * The arena is not thread-safe.
+ */
+
+struct rcl_arena_block_t;
+
+typedef struct rcl_arena_t
+{
+  /// Chain of blocks, most recently allocated first, or NULL.
+  struct rcl_arena_block_t * blocks;
+  /// Size of the next block to allocate; grows geometrically.
+  size_t next_block_size;
+  /// Underlying allocator the blocks are obtained from.
+  rcl_allocator_t allocator;
+} rcl_arena_t;
+
+/// Return an arena on which rcl_arena_fini() is safe to call.
+RCL_PUBLIC
+rcl_arena_t
+rcl_get_zero_initialized_arena(void);
+
+/// Initialize an arena; no block is allocated until the first allocation.
+/**
+ * \param[inout] arena a zero initialized arena to set up
+ * \param[in] initial_block_size size in bytes of the first block to allocate
+ * \param[in] allocator the allocator blocks are obtained from
+ * \return `RCL_RET_OK`, or `RCL_RET_INVALID_ARGUMENT`.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arena_init(
+  rcl_arena_t * arena,
+  size_t initial_block_size,
+  rcl_allocator_t allocator);
+
+/// Release every block in the arena, invalidating all carved allocations.
+RCL_PUBLIC
+void
+rcl_arena_fini(rcl_arena_t * arena);
+
+/// Reset the arena for reuse, invalidating all carved allocations.
+/**
+ * The most recently allocated block, which is also the largest one, is kept
+ * and rewound so a steady-state workload stops going to the underlying
+ * allocator altogether; every other block is released.
+ */
+RCL_PUBLIC
+void
+rcl_arena_reset(rcl_arena_t * arena);
+
+/// Get an allocator that carves its allocations out of the arena.
+/**
+ * The returned allocator's deallocate is a no-op and its reallocate copies
+ * into fresh space, so it can be passed anywhere an rcl_allocator_t is
+ * expected as long as everything allocated with it may live until
+ * rcl_arena_fini().
+ * It holds a pointer to the arena, which therefore must not be moved or
+ * finalized while the allocator is in use.
+ */
+RCL_PUBLIC
+rcl_allocator_t
+rcl_arena_get_allocator(rcl_arena_t * arena);
+
+/// Initialize an arena and an allocator carving out of it in one call.
+/**
+ * Equivalent to rcl_arena_init() followed by rcl_arena_get_allocator().
+ *
+ * \param[out] allocator filled with the carving allocator
+ * \param[inout] arena a zero initialized arena to set up
+ * \param[in] initial_block_size size in bytes of the first block to allocate
+ * \param[in] parent the allocator blocks are obtained from
+ * \return `RCL_RET_OK`, or `RCL_RET_INVALID_ARGUMENT`.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arena_allocator_init(
+  rcl_allocator_t * allocator,
+  rcl_arena_t * arena,
+  size_t initial_block_size,
+  rcl_allocator_t parent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ARENA_H_
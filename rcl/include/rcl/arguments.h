@@ -195,6 +195,39 @@ rcl_arguments_get_param_files(
   rcl_allocator_t allocator,
   char *** parameter_files);
 
+/// Borrow a view of the yaml parameter file paths specified on the command line.
+/**
+ * Unlike rcl_arguments_get_param_files() nothing is copied: the output
+ * points straight at the parsed arguments' internal storage, so reading the
+ * list costs no allocations.  The view stays valid for the lifetime of the
+ * given arguments structure, including past copies made with
+ * rcl_arguments_copy(), which share the parsed storage.  Use
+ * rcl_arguments_get_param_files_count() when only the count is needed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] arguments An arguments structure that has been parsed.
+ * \param[out] parameter_files Set to the internal array of parameter file
+ *   names, or `NULL` if there were no parameter files; not to be deallocated
+ *   or modified by the caller.
+ * \param[out] count Set to the number of parameter files.
+ * \return `RCL_RET_OK` if everything goes correctly, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arguments_get_param_files_view(
+  const rcl_arguments_t * arguments,
+  const char * const ** parameter_files,
+  int * count);
+
 /// Return a list of arguments with ROS-specific arguments removed.
 /**
  * Some arguments may not have been intended as ROS arguments.
@@ -234,16 +267,20 @@ rcl_remove_ros_arguments(
 
 /// Copy one arguments structure into another.
 /**
+ * The parsed rules are immutable, so the copy shares them with the original
+ * by incrementing a reference count rather than duplicating them.
+ * Both structures must still be finalized with rcl_arguments_fini(); the
+ * shared storage is released when the last reference is finalized.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] args The structure to be copied.
- *  Its allocator is used to copy memory into the new structure.
  * \param[out] args_out A zero-initialized arguments structure to be copied into.
  * \return `RCL_RET_OK` if the structure was copied successfully, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
@@ -257,6 +294,84 @@ rcl_arguments_copy(
   const rcl_arguments_t * args,
   rcl_arguments_t * args_out);
 
+/// Serialize parsed arguments into a flat relocatable blob.
+/**
+ * The blob holds everything rcl_parse_arguments() produced — remap rules
+ * including their precompiled sides, parameter file paths, unparsed argument
+ * indices and the log level — with internal references stored as offsets, so
+ * it can be handed to another process through shared memory, a pipe, or a
+ * file and loaded there with rcl_arguments_deserialize() without re-running
+ * the parser.
+ * A launcher that assembles the same long argument vector for every child
+ * parses it once, serializes, and passes the blob to the children, which
+ * load it through rcl_init_options_set_serialized_arguments().
+ *
+ * The blob is not portable between machines of different endianness or
+ * pointer width; it is meant for processes sharing one build on one host.
+ * Unparsed argument indices refer to the argument vector that was originally
+ * parsed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] args An arguments structure that has been parsed.
+ * \param[in] allocator A valid allocator, used to allocate the blob.
+ * \param[out] buffer Set to the allocated blob; the caller must deallocate
+ *   it with the given allocator.
+ * \param[out] buffer_length Set to the size of the blob in bytes.
+ * \return `RCL_RET_OK` if the arguments were serialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating the blob failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arguments_serialize(
+  const rcl_arguments_t * args,
+  rcl_allocator_t allocator,
+  uint8_t ** buffer,
+  size_t * buffer_length);
+
+/// Load parsed arguments from a blob made by rcl_arguments_serialize().
+/**
+ * The output is equivalent to the structure the blob was serialized from and
+ * is independent of the blob, which may be unmapped or freed afterwards; the
+ * remap rule index is rebuilt during loading.
+ * Loading validates the blob's framing and rejects truncated or foreign
+ * input, but the content itself is trusted the same way argv is.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] buffer The serialized arguments blob.
+ * \param[in] buffer_length The size of the blob in bytes.
+ * \param[in] allocator A valid allocator.
+ * \param[out] args_out A zero-initialized arguments structure to load into,
+ *   to be finalized with rcl_arguments_fini() by the caller.
+ * \return `RCL_RET_OK` if the arguments were loaded, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid
+ *   or the blob is malformed, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_arguments_deserialize(
+  const uint8_t * buffer,
+  size_t buffer_length,
+  rcl_allocator_t allocator,
+  rcl_arguments_t * args_out);
+
 /// Reclaim resources held inside rcl_arguments_t structure.
 /**
  * <hr>
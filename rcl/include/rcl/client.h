@@ -22,7 +22,9 @@ extern "C"
 
 #include "rosidl_generator_c/service_type_support_struct.h"
 
+#include "rcl/event_callback.h"
 #include "rcl/macros.h"
+#include "rcl/statistics.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
 
@@ -43,6 +45,25 @@ typedef struct rcl_client_options_t
   /// Custom allocator for the client, used for incidental allocations.
   /** For default behavior (malloc/free), use: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// Number of concurrently outstanding requests to track; 0 disables it.
+  /**
+   * With tracking enabled, rcl_client_init() preallocates a table of this
+   * many slots and rcl_send_request() registers each request's sequence
+   * number in it, refusing with `RCL_RET_CLIENT_IN_FLIGHT_FULL` once the
+   * table is full, which gives callers natural backpressure when
+   * pipelining many requests on one client.  Responses taken with
+   * rcl_take_response() complete their slot in O(1); a per-request user
+   * data pointer can be attached for correlation, see
+   * rcl_client_set_request_user_data().
+   */
+  size_t max_in_flight_requests;
+  /// If true, keep hot path statistics for this client.
+  /**
+   * The counters are updated with relaxed atomics on every send and take and
+   * read back with rcl_client_get_statistics().
+   * The default is false.
+   */
+  bool enable_statistics;
 } rcl_client_options_t;
 
 /// Return a rcl_client_t struct with members set to `NULL`.
@@ -239,6 +260,8 @@ rcl_client_get_default_options(void);
  * \return `RCL_RET_OK` if the request was sent successfully, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
  * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_CLIENT_IN_FLIGHT_FULL` if in-flight tracking is enabled and
+ *   as many requests as the table can track are already outstanding, or
  * \return `RCL_RET_ERROR` if an unspecified error occurs.
  */
 RCL_PUBLIC
@@ -247,6 +270,34 @@ rcl_ret_t
 rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t * sequence_number);
 
 
+/// Send an already serialized ROS request using a client.
+/**
+ * This is the serialized counterpart of rcl_send_request(); the request is
+ * passed through as a raw binary blob matching the service type's wire
+ * representation, so bridges and replay tools can forward recorded requests
+ * without a deserialize/reserialize cycle.
+ *
+ * The rmw interface in use must support sending serialized requests; with
+ * one that does not, this function fails with `RCL_RET_UNSUPPORTED`.
+ *
+ * \param[in] client handle to the client which will make the request
+ * \param[in] serialized_request pointer to the serialized request message
+ * \param[out] sequence_number the sequence number
+ * \return `RCL_RET_OK` if the request was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the rmw interface in use cannot send
+ *   serialized requests, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_request_serialized(
+  const rcl_client_t * client,
+  const rcl_serialized_message_t * serialized_request,
+  int64_t * sequence_number);
+
 /// Take a ROS response using a client
 /**
  * It is the job of the caller to ensure that the type of the `ros_response`
@@ -290,6 +341,27 @@ rcl_take_response(
   rmw_request_id_t * request_header,
   void * ros_response);
 
+/// Get a snapshot of the client's hot path statistics.
+/**
+ * Only valid on clients whose options had `enable_statistics` set; on others
+ * this fails with `RCL_RET_UNSUPPORTED`.
+ * Sent requests and taken responses count as succeeded operations; failed
+ * sends and takes, including takes with nothing pending, as failed ones.
+ *
+ * \param[in] client pointer to the rcl client
+ * \param[out] statistics filled with the current counts
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the client does not keep statistics.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_get_statistics(
+  const rcl_client_t * client,
+  rcl_statistics_t * statistics);
+
 /// Get the name of the service that this client will request a response from.
 /**
  * This function returns the client's internal service name string.
@@ -344,6 +416,103 @@ RCL_WARN_UNUSED
 const rcl_client_options_t *
 rcl_client_get_options(const rcl_client_t * client);
 
+/// Take a pending response in its serialized form using a client.
+/**
+ * In contrast to rcl_take_response(), this function stores the taken
+ * response in its raw binary representation, analogous to
+ * rcl_take_serialized_message() on a subscription.
+ *
+ * The rmw interface in use must support taking serialized responses; with
+ * one that does not, this function fails with `RCL_RET_UNSUPPORTED`.
+ *
+ * \param[in] client handle to the client that received the response
+ * \param[inout] request_header ptr to the struct holding the metadata about the request ID
+ * \param[inout] serialized_response pointer to a (pre-allocated) serialized message
+ * \return `RCL_RET_OK` if the response was taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the rmw interface in use cannot take
+ *   serialized responses, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_CLIENT_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_response_serialized(
+  const rcl_client_t * client,
+  rmw_request_id_t * request_header,
+  rcl_serialized_message_t * serialized_response);
+
+/// Attach user data to an in-flight request for response correlation.
+/**
+ * The request must have been sent by rcl_send_request() on a client with
+ * in-flight tracking enabled (see the max_in_flight_requests option) and
+ * not yet completed by rcl_take_response().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] client handle to the client that sent the request
+ * \param[in] sequence_number the sequence number returned by rcl_send_request()
+ * \param[in] user_data opaque pointer stored with the request, may be `NULL`
+ * \return `RCL_RET_OK` if the user data was attached, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if in-flight tracking is not enabled, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the sequence number is not in flight.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_set_request_user_data(
+  const rcl_client_t * client,
+  int64_t sequence_number,
+  const void * user_data);
+
+/// Get the user data of the most recently completed request.
+/**
+ * Valid after a successful rcl_take_response() on a client with in-flight
+ * tracking enabled, until the next successful take; returns the user data
+ * attached to the request the taken response answered, or `NULL` if none
+ * was attached.
+ *
+ * \param[in] client handle to the client that took the response
+ * \param[out] user_data where to store the user data pointer
+ * \return `RCL_RET_OK` if the user data was retrieved, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if in-flight tracking is not enabled, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_get_completed_request_user_data(
+  const rcl_client_t * client,
+  const void ** user_data);
+
+/// Get the number of requests currently in flight on the client.
+/**
+ * \param[in] client handle to the client to query
+ * \param[out] count where to store the in-flight request count
+ * \return `RCL_RET_OK` if the count was retrieved, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if in-flight tracking is not enabled, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_get_in_flight_count(
+  const rcl_client_t * client,
+  size_t * count);
+
 /// Return the rmw client handle.
 /**
  * The handle returned is a pointer to the internally held rmw handle.
@@ -397,6 +566,19 @@ RCL_PUBLIC
 bool
 rcl_client_is_valid(const rcl_client_t * client);
 
+/// Set a callback to be invoked when the client has new responses.
+/**
+ * This function behaves exactly the same as for subscription messages.
+ * \see rcl_subscription_set_on_new_message_callback
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_set_on_new_response_callback(
+  const rcl_client_t * client,
+  rcl_event_callback_t callback,
+  const void * user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,252 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__CLIENT_GROUP_H_
+#define RCL__CLIENT_GROUP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/client.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Internal rcl client group implementation struct.
+struct rcl_client_group_impl_t;
+
+/// A set of clients waited on together and demultiplexed after the wait.
+/**
+ * A node holding many clients pays for each of them twice per wake up: every
+ * client occupies its own spot in the wait set, and every spot has to be
+ * checked afterwards to find the few that are ready.  A client group bundles
+ * N clients into one logical wait set entity: the whole group is added with
+ * a single rcl_wait_set_add_client_group() call, and after the wait rcl has
+ * already demultiplexed the readiness results, so the group appears at most
+ * once in the ready entity list (see rcl_wait_set_get_ready_entities()) and
+ * rcl_client_group_get_ready_clients() hands back exactly the members with a
+ * response waiting.  Responses themselves stay queued per client inside the
+ * middleware until taken with rcl_take_response() on those members, so no
+ * response is copied or reordered by the grouping.
+ *
+ * The group borrows its clients; they must stay valid while they are in the
+ * group, and a grouped client should not additionally be added to wait sets
+ * on its own, or it would be reported through both paths.  A group may be in
+ * at most one wait set at a time.  Membership changes take effect the next
+ * time the group is added to a wait set; retained wait sets (see
+ * rcl_wait_set_set_retained()) have to be cleared and refilled after one.
+ */
+typedef struct rcl_client_group_t
+{
+  struct rcl_client_group_impl_t * impl;
+} rcl_client_group_t;
+
+/// Options available for a rcl client group.
+typedef struct rcl_client_group_options_t
+{
+  /// Custom allocator for the client group, used for internal allocations.
+  rcl_allocator_t allocator;
+  /// Most clients the group can hold; 0 means the default.
+  /**
+   * See RCL_CLIENT_GROUP_MAX_CLIENTS_DEFAULT.
+   */
+  size_t max_clients;
+  /// Dispatch priority of the group within a wait set.
+  /**
+   * Applied to the group's single ready entity, see the priority field of
+   * rcl_subscription_options_t.  The default is 0.
+   */
+  uint8_t priority;
+} rcl_client_group_options_t;
+
+/// Default capacity of a client group.
+#define RCL_CLIENT_GROUP_MAX_CLIENTS_DEFAULT 64
+
+/// Return a rcl_client_group_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_client_group_t
+rcl_get_zero_initialized_client_group(void);
+
+/// Return the default options in a rcl_client_group_options_t struct.
+/**
+ * The defaults are:
+ *
+ * - allocator = rcl_get_default_allocator()
+ * - max_clients = 0 (RCL_CLIENT_GROUP_MAX_CLIENTS_DEFAULT)
+ * - priority = 0
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_client_group_options_t
+rcl_client_group_get_default_options(void);
+
+/// Initialize a client group.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group preallocated, zero initialized group structure
+ * \param[in] options the client group's options
+ * \return `RCL_RET_OK` if the group was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the group is already initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_init(
+  rcl_client_group_t * group,
+  const rcl_client_group_options_t options);
+
+/// Finalize a client group.
+/**
+ * The member clients themselves are not finalized; they simply stop being
+ * grouped.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] group the group to be finalized
+ * \return `RCL_RET_OK` if the group was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_fini(rcl_client_group_t * group);
+
+/// Add a client to the group.
+/**
+ * The client is borrowed, not copied; it must stay valid until it is removed
+ * from the group or the group is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] group valid group to add the client to
+ * \param[in] client valid client to add
+ * \return `RCL_RET_OK` if the client was added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the group is invalid or the client
+ *   is already in the group, or
+ * \return `RCL_RET_CLIENT_INVALID` if the client is invalid, or
+ * \return `RCL_RET_CLIENT_GROUP_FULL` if the group is at capacity.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_add_client(
+  rcl_client_group_t * group,
+  const rcl_client_t * client);
+
+/// Remove a client from the group.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] group valid group to remove the client from
+ * \param[in] client the client to remove
+ * \return `RCL_RET_OK` if the client was removed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   client is not in the group.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_remove_client(
+  rcl_client_group_t * group,
+  const rcl_client_t * client);
+
+/// Get the number of clients currently in the group.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] group valid client group
+ * \param[out] count the number of member clients
+ * \return `RCL_RET_OK` if the count was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_get_number_of_clients(
+  const rcl_client_group_t * group,
+  size_t * count);
+
+/// Get the member clients made ready by the last wait.
+/**
+ * Borrows a view of the group's internal ready list: the members which had a
+ * response waiting when the wait set containing the group woke up, in the
+ * order they were added to the group.  The view stays valid until the next
+ * wait on that wait set or the next membership change, and is empty before
+ * the group has been waited on.  Take the pending responses by calling
+ * rcl_take_response() on each listed client.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] group valid client group
+ * \param[out] ready_clients set to the group's ready list
+ * \param[out] number_ready set to the length of the ready list
+ * \return `RCL_RET_OK` if the ready list was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_group_get_ready_clients(
+  const rcl_client_group_t * group,
+  const rcl_client_t *** ready_clients,
+  size_t * number_ready);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__CLIENT_GROUP_H_
@@ -254,6 +254,86 @@ RCL_WARN_UNUSED
 bool
 rcl_context_is_valid(rcl_context_t * context);
 
+/// Destroy rmw handles parked by the deferred fini functions.
+/**
+ * The deferred fini variants, like rcl_publisher_fini_deferred(), unlink
+ * their entity and return without calling into the middleware's destroy
+ * functions, which can block on middleware locks.
+ * This function drains the context's queue of parked rmw handles and
+ * destroys them; run it periodically from a thread that may block, for
+ * example a low priority reclamation thread, to keep deferred finalization
+ * from stalling latency sensitive threads.
+ *
+ * Draining may run concurrently with one thread deferring finalization, but
+ * only one thread may drain at a time.
+ * Handles deferred and not yet reclaimed are destroyed when the context is
+ * finalized; the nodes their entities were created on must outlive the last
+ * reclaim of their handles.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] for one concurrent draining thread</i>
+ *
+ * \param[in] context the context entities were deferred through
+ * \param[out] number_reclaimed filled with the number of handles destroyed,
+ *   may be `NULL`
+ * \return `RCL_RET_OK` if the queue was drained, even if it was empty, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the context is invalid, or
+ * \return `RCL_RET_ERROR` if destroying one of the handles failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_reclaim(rcl_context_t * context, size_t * number_reclaimed);
+
+/// Finalize every entity created on the context in bulk.
+/**
+ * The init functions record each node, publisher, subscription, client and
+ * service on its context, and this function finalizes all of them at once:
+ * publishers, subscriptions, clients and services first, then one drain of
+ * the deferred destruction queue, then the nodes.
+ * A process shutting down calls this instead of finalizing hundreds of
+ * entities one by one, each of which can block on the middleware's
+ * destruction locks; the deferred fini variants park the blocking work on
+ * the reclamation queue, so the middleware is entered once rather than once
+ * per entity, and rcl_context_reclaim() may additionally be run from a
+ * second thread to overlap the draining with the unlinking.
+ *
+ * The entity and node structs themselves stay owned by the caller and must
+ * still be live when this is called; afterwards they are finalized and must
+ * not be finalized again.
+ * Entities already finalized individually are skipped, as is any entity
+ * whose registration failed for lack of memory during init (a warning was
+ * logged at that point).
+ * Failures are logged and teardown continues, so a stuck entity does not
+ * leak the rest.
+ *
+ * This function may be called before or after rcl_shutdown(), but must be
+ * called before rcl_context_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose entities should be finalized
+ * \return `RCL_RET_OK` if all tracked entities were finalized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the context is invalid, or
+ * \return `RCL_RET_ERROR` if finalizing any entity failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_fini_all_entities(rcl_context_t * context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,163 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__COUNTING_ALLOCATOR_H_
+#define RCL__COUNTING_ALLOCATOR_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Subsystem an allocation is attributed to, see rcl_counting_allocator_wrap().
+typedef enum rcl_alloc_tag_t
+{
+  /// Node initialization and the node's internal state.
+  RCL_ALLOC_TAG_NODE = 0,
+  /// Wait set storage and resizing.
+  RCL_ALLOC_TAG_WAIT_SET,
+  /// Argument parsing, including remap rules and parameter file names.
+  RCL_ALLOC_TAG_ARGUMENTS,
+  /// Graph queries, including the arrays handed back to the caller.
+  RCL_ALLOC_TAG_GRAPH,
+  /// Number of tags; not a valid tag.
+  RCL_ALLOC_TAG_COUNT
+} rcl_alloc_tag_t;
+
+/// A snapshot of the allocation activity attributed to one tag.
+/**
+ * Retrieved with rcl_get_allocation_stats(); all counts are cumulative
+ * since process start or the last rcl_reset_allocation_stats() call.
+ */
+typedef struct rcl_alloc_stats_t
+{
+  /// Number of allocations, including reallocations that grew a block.
+  uint64_t allocation_count;
+  /// Total bytes requested over the lifetime of the process.
+  uint64_t total_bytes;
+  /// Bytes currently allocated and not yet deallocated.
+  uint64_t current_bytes;
+  /// Highest value current_bytes has reached.
+  uint64_t peak_bytes;
+} rcl_alloc_stats_t;
+
+/// Wrap an allocator so its allocations are counted against a tag.
+/**
+ * The returned allocator forwards to the given inner allocator and
+ * attributes every allocation, reallocation, and deallocation made through
+ * it to the given tag, keeping the per-tag count, byte, and peak statistics
+ * reported by rcl_get_allocation_stats() up to date.
+ *
+ * Accounting is off by default and the inner allocator is returned
+ * unchanged, so instrumented builds pay nothing; it is enabled by setting
+ * the environment variable `RCL_ALLOCATION_STATS` to `1` before the first
+ * allocator is wrapped.
+ *
+ * When accounting is enabled each block is prefixed with a small size
+ * header, so memory allocated through the wrapped allocator must also be
+ * deallocated through it (or through a copy of it, which rcl's convention
+ * of storing the allocator next to the memory it manages already ensures).
+ * The first inner allocator wrapped with a tag is remembered; wrapping the
+ * same tag with a different inner allocator returns that allocator
+ * unwrapped rather than mixing two backing allocators in one tag.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] inner allocator to forward to, must be valid
+ * \param[in] tag subsystem to attribute allocations to
+ * \return an allocator counting against the tag, or
+ * \return the inner allocator unchanged if accounting is disabled, the tag
+ *   is out of range, or the tag is already bound to a different allocator.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_allocator_t
+rcl_counting_allocator_wrap(rcl_allocator_t inner, rcl_alloc_tag_t tag);
+
+/// Get a snapshot of the allocation statistics for one tag.
+/**
+ * The snapshot is taken field by field, so it may be slightly inconsistent
+ * with respect to allocations happening concurrently on other threads.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] tag subsystem to report on
+ * \param[out] stats filled with the tag's statistics
+ * \return `RCL_RET_OK` if the statistics were retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_allocation_stats(rcl_alloc_tag_t tag, rcl_alloc_stats_t * stats);
+
+/// Reset the allocation statistics of all tags to zero.
+/**
+ * Blocks currently allocated keep their headers, so deallocating them
+ * after a reset can make current_bytes wrap below zero; reset between
+ * measurement runs, not while instrumented subsystems hold memory.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCL_PUBLIC
+void
+rcl_reset_allocation_stats(void);
+
+/// Log the allocation statistics of every tag, one line per tag.
+/**
+ * Output goes to the rcl logger at INFO severity, so it lands wherever
+ * the process's logging is routed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ */
+RCL_PUBLIC
+void
+rcl_log_allocation_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__COUNTING_ALLOCATOR_H_
@@ -0,0 +1,103 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENTITY_BATCH_H_
+#define RCL__ENTITY_BATCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/macros.h"
+#include "rcl/node.h"
+#include "rcl/publisher.h"
+#include "rcl/subscription.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// The kind of entity described by an rcl_entity_spec_t.
+typedef enum rcl_entity_kind_t
+{
+  RCL_ENTITY_KIND_PUBLISHER = 0,
+  RCL_ENTITY_KIND_SUBSCRIPTION,
+} rcl_entity_kind_t;
+
+/// Description of one entity to be created by rcl_node_create_entities().
+/**
+ * Exactly one of the handle fields is used, selected by `kind`; the handle
+ * it points to must be zero initialized, like for the individual init
+ * functions.  The options pointer matching `kind` must be non-`NULL`, the
+ * other fields of the unused kind are ignored.
+ */
+typedef struct rcl_entity_spec_t
+{
+  /// Which kind of entity this spec describes.
+  rcl_entity_kind_t kind;
+  /// Type support for the entity's message type.
+  const rosidl_message_type_support_t * type_support;
+  /// Topic name, as given to the individual init functions.
+  const char * topic_name;
+  /// Options used when `kind` is RCL_ENTITY_KIND_PUBLISHER.
+  const rcl_publisher_options_t * publisher_options;
+  /// Options used when `kind` is RCL_ENTITY_KIND_SUBSCRIPTION.
+  const rcl_subscription_options_t * subscription_options;
+  /// Publisher to initialize when `kind` is RCL_ENTITY_KIND_PUBLISHER.
+  rcl_publisher_t * publisher;
+  /// Subscription to initialize when `kind` is RCL_ENTITY_KIND_SUBSCRIPTION.
+  rcl_subscription_t * subscription;
+} rcl_entity_spec_t;
+
+/// Create a batch of publishers and subscriptions on one node.
+/**
+ * Equivalent to calling rcl_publisher_init() or rcl_subscription_init() for
+ * each spec in order, but transactional: if any entity fails to initialize,
+ * the entities created earlier in the batch are finalized again and the
+ * error of the failing entity is returned, so the caller never has to track
+ * partial bring-up.
+ *
+ * Per-node resolution state - the remap rule memo and the substitutions used
+ * for expanding names - is shared across the batch; the first entity warms
+ * it and the rest resolve against it, so the fixed name resolution cost is
+ * paid once per node rather than once per entity.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node valid node on which to create the entities
+ * \param[inout] specs array of entity descriptions, handles are written
+ * \param[in] count number of entries in `specs`
+ * \return `RCL_RET_OK` if all entities were created successfully, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return the error of the first entity that failed to initialize.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_create_entities(
+  rcl_node_t * node,
+  rcl_entity_spec_t * specs,
+  size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENTITY_BATCH_H_
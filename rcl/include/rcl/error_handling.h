@@ -15,8 +15,12 @@
 #ifndef RCL__ERROR_HANDLING_H_
 #define RCL__ERROR_HANDLING_H_
 
+#include <stdbool.h>
+
 #include "rcutils/error_handling.h"
 
+#include "rcl/visibility_control.h"
+
 /// The error handling in RCL is just an alias to the error handling in rcutils.
 
 typedef rcutils_error_state_t rcl_error_state_t;
@@ -46,4 +50,101 @@ typedef rcutils_error_string_t rcl_error_string_t;
 
 #define rcl_reset_error rcutils_reset_error
 
+/// \name Compile-time removable validation for designated hot functions.
+/**
+ * The per-message entry points - rcl_publish(), rcl_take(),
+ * rcl_timer_call(), rcl_wait_set_add_*() - front-load null and
+ * entity-valid checks which are redundant for pinned, well-tested
+ * applications that never pass invalid handles.
+ * Those functions use the RCL_HOT_CHECK_* macros below, which behave like
+ * their RCL_CHECK_* counterparts by default but compile to nothing when
+ * RCL_DISABLE_ARG_VALIDATION is defined at build time.
+ * Every other function keeps unconditional validation, and checked
+ * behavior remains the default everywhere.
+ */
+/// \{
+#ifdef RCL_DISABLE_ARG_VALIDATION
+
+#define RCL_HOT_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type)
+
+#define RCL_HOT_CHECK_FOR_VALID(is_valid_expr, error_return_type)
+
+#define RCL_HOT_CHECK_FOR_VALID_WITH_MSG(is_valid_expr, msg, error_return_type)
+
+#else
+
+#define RCL_HOT_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type) \
+  RCL_CHECK_ARGUMENT_FOR_NULL(argument, error_return_type)
+
+/// Return if the given is-valid call fails; the call sets the error itself.
+#define RCL_HOT_CHECK_FOR_VALID(is_valid_expr, error_return_type) \
+  do { \
+    if (!(is_valid_expr)) { \
+      return error_return_type;  /* error already set */ \
+    } \
+  } while (0)
+
+/// Return with the given message if the given is-valid call fails.
+#define RCL_HOT_CHECK_FOR_VALID_WITH_MSG(is_valid_expr, msg, error_return_type) \
+  do { \
+    if (!(is_valid_expr)) { \
+      RCL_SET_ERROR_MSG(msg); \
+      return error_return_type; \
+    } \
+  } while (0)
+
+#endif  // RCL_DISABLE_ARG_VALIDATION
+/// \}
+
+/// Enable or disable quiet error mode for the calling thread.
+/**
+ * While quiet mode is enabled, error messages set with
+ * RCL_SET_EXPECTED_ERROR_MSG() are skipped entirely - no string is formatted
+ * or copied into thread local storage and only the error code of the failing
+ * call is returned.
+ * This is meant for callers that hit certain failures at rate as part of
+ * normal operation, e.g. polling a service whose queue another thread just
+ * drained, and would otherwise pay for diagnostics they always discard.
+ * Errors set with the regular RCL_SET_ERROR_MSG() are not affected, so
+ * genuinely exceptional paths keep their full diagnostics.
+ *
+ * The mode is thread local and defaults to disabled.
+ *
+ * \param[in] enabled true to skip expected error messages on this thread
+ * \return the previous mode, so a caller can scope the change and restore it
+ */
+RCL_PUBLIC
+bool
+rcl_set_error_quiet(bool enabled);
+
+/// Return true if quiet error mode is enabled for the calling thread.
+RCL_PUBLIC
+bool
+rcl_error_quiet_enabled(void);
+
+/// Set an error message for a failure that callers may hit at rate.
+/**
+ * Behaves like RCL_SET_ERROR_MSG(), except that the message is skipped when
+ * the calling thread enabled quiet mode with rcl_set_error_quiet().
+ * Use this at call sites whose failure is part of normal operation and is
+ * fully described by the returned error code.
+ */
+#define RCL_SET_EXPECTED_ERROR_MSG(msg) \
+  do { \
+    if (!rcl_error_quiet_enabled()) { \
+      RCL_SET_ERROR_MSG(msg); \
+    } \
+  } while (0)
+
+/// Format and set an error message for a failure that callers may hit at rate.
+/**
+ * \sa RCL_SET_EXPECTED_ERROR_MSG()
+ */
+#define RCL_SET_EXPECTED_ERROR_MSG_WITH_FORMAT_STRING(fmt_str, ...) \
+  do { \
+    if (!rcl_error_quiet_enabled()) { \
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(fmt_str, __VA_ARGS__); \
+    } \
+  } while (0)
+
 #endif  // RCL__ERROR_HANDLING_H_
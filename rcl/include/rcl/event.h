@@ -0,0 +1,210 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__EVENT_H_
+#define RCL__EVENT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/macros.h"
+#include "rcl/publisher.h"
+#include "rcl/subscription.h"
+#include "rcl/time.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Internal rcl event implementation struct.
+struct rcl_event_impl_t;
+
+/// A deadline event bound to a publisher or subscription.
+/**
+ * An event watches the activity of one publisher or subscription and becomes
+ * ready when no successful publish respectively take has happened for the
+ * configured deadline.  Added to a wait set with rcl_wait_set_add_event() it
+ * wakes the wait exactly when the deadline expires and is reported in the
+ * ready entity list like any other entity, so monitoring message flow across
+ * many topics needs no polling at all: a quiet topic costs one wake per
+ * missed deadline instead of continuous state queries.
+ *
+ * The middleware in use does not surface QoS events of its own, so the event
+ * is computed entirely in rcl from the bound entity's activity timestamp;
+ * the entity therefore must keep statistics (see the `enable_statistics`
+ * option field of publishers and subscriptions).  Detection happens when a
+ * wait or rcl_event_take() looks, which the wait set's timeout calculation
+ * arranges to be no later than the deadline.
+ *
+ * After a miss the event re-arms when it is taken: the next miss is reported
+ * one deadline after the take, or after the last activity, whichever is
+ * later.  An event that is never taken stays ready.
+ */
+typedef struct rcl_event_t
+{
+  struct rcl_event_impl_t * impl;
+} rcl_event_t;
+
+/// Options available for a rcl event.
+typedef struct rcl_event_options_t
+{
+  /// Custom allocator for the event, used for internal allocations.
+  rcl_allocator_t allocator;
+  /// Activity deadline in nanoseconds, must be greater than 0.
+  int64_t deadline;
+  /// Dispatch priority of the event within a wait set.
+  /**
+   * See the priority field of rcl_subscription_options_t.  The default is 0.
+   */
+  uint8_t priority;
+} rcl_event_options_t;
+
+/// The state of a deadline event, filled by rcl_event_take().
+typedef struct rcl_event_status_t
+{
+  /// Number of deadline misses taken from this event so far.
+  uint64_t total_count;
+  /// Nanoseconds since the bound entity's last activity, at take time.
+  /**
+   * Measured from the start of monitoring when there was no activity yet.
+   */
+  int64_t time_since_last_activity;
+} rcl_event_status_t;
+
+/// Return a rcl_event_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_event_t
+rcl_get_zero_initialized_event(void);
+
+/// Return the default options in a rcl_event_options_t struct.
+/**
+ * The defaults are:
+ *
+ * - allocator = rcl_get_default_allocator()
+ * - deadline = 0 (invalid, must be set by the caller)
+ * - priority = 0
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_event_options_t
+rcl_event_get_default_options(void);
+
+/// Initialize an event bound to a publisher.
+/**
+ * The publisher is borrowed, not copied; it must stay valid until the event
+ * is finalized, and it must have been initialized with `enable_statistics`
+ * set, since the event is driven by the publisher's activity timestamp.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] event preallocated, zero initialized event structure
+ * \param[in] publisher valid publisher whose activity is watched
+ * \param[in] options the event's options, with a positive deadline
+ * \return `RCL_RET_OK` if the event was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the event is already initialized, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the publisher keeps no statistics, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_init_for_publisher(
+  rcl_event_t * event,
+  const rcl_publisher_t * publisher,
+  const rcl_event_options_t options);
+
+/// Initialize an event bound to a subscription.
+/**
+ * This function behaves exactly the same as for publishers, watching takes
+ * instead of publishes.
+ * \see rcl_event_init_for_publisher
+ *
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid,
+ *   otherwise the return values of rcl_event_init_for_publisher().
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_init_for_subscription(
+  rcl_event_t * event,
+  const rcl_subscription_t * subscription,
+  const rcl_event_options_t options);
+
+/// Finalize an event.
+/**
+ * The bound entity itself is not finalized; it simply stops being watched.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] event the event to be finalized
+ * \return `RCL_RET_OK` if the event was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_fini(rcl_event_t * event);
+
+/// Take a pending deadline miss from the event.
+/**
+ * When the bound entity's deadline is currently missed the status is filled,
+ * the miss counts as taken, and the event re-arms: it becomes ready again one
+ * deadline after this call, unless there is activity first.  When the
+ * deadline is not missed `RCL_RET_EVENT_TAKE_FAILED` is returned, analogous
+ * to taking from a subscription with nothing pending.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] event valid event to take from
+ * \param[out] status filled with the state of the event
+ * \return `RCL_RET_OK` if a miss was taken successfully, or
+ * \return `RCL_RET_EVENT_INVALID` if the event is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_EVENT_TAKE_FAILED` if the deadline is not missed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_event_take(
+  const rcl_event_t * event,
+  rcl_event_status_t * status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__EVENT_H_
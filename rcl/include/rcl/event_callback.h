@@ -0,0 +1,44 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__EVENT_CALLBACK_H_
+#define RCL__EVENT_CALLBACK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+/// Callback invoked when an entity has new work available.
+/**
+ * The user data given when the callback was registered is passed back
+ * unmodified, along with the number of events since the callback was last
+ * invoked (at least 1).
+ *
+ * Callbacks are invoked from the wait path, so they must be fast and must
+ * not block; typical implementations push a token onto an executor queue or
+ * signal a condition variable and return.
+ *
+ * \param[in] user_data the user data given when registering the callback
+ * \param[in] number_of_events the number of events since the last invocation
+ */
+typedef void (* rcl_event_callback_t)(const void * user_data, size_t number_of_events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__EVENT_CALLBACK_H_
@@ -20,6 +20,8 @@ extern "C"
 {
 #endif
 
+#include <stddef.h>
+
 #include "rcutils/types/string_map.h"
 #include "rcl/allocator.h"
 #include "rcl/macros.h"
@@ -122,6 +124,240 @@ rcl_expand_topic_name(
   rcl_allocator_t allocator,
   char ** output_topic_name);
 
+/// Recommended buffer length for rcl_expand_topic_name_with_buffer().
+/**
+ * Large enough for typical fully expanded topic names; names which do not
+ * fit need a larger buffer or the allocating rcl_expand_topic_name().
+ */
+#define RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH 256
+
+/// Expand a given topic name into a caller provided buffer.
+/**
+ * This function behaves like rcl_expand_topic_name(), but writes the
+ * expanded name into a fixed buffer provided by the caller instead of
+ * allocating the output string, and therefore does not allocate memory.
+ * It is intended for hot paths like entity creation, where the expanded
+ * name is a short lived temporary.
+ *
+ * The output buffer will contain a null terminated c string on success.
+ * If the expanded name, including the null terminator, does not fit in
+ * `output_buffer_length` bytes, `RCL_RET_BUFFER_TOO_SMALL` is returned and
+ * the buffer contents are undefined; the caller can retry with a larger
+ * buffer or fall back to rcl_expand_topic_name().
+ *
+ * The substitutions map may come from
+ * rcl_get_default_topic_name_substitutions(), or from a map cached by the
+ * caller (for example, the one kept by each node) to avoid rebuilding it
+ * for every expansion.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] input_topic_name topic name to be expanded
+ * \param[in] node_name name of the node associated with the topic
+ * \param[in] node_namespace namespace of the node associated with the topic
+ * \param[in] substitutions string map with possible substitutions
+ * \param[out] output_buffer buffer to write the expanded topic name into
+ * \param[in] output_buffer_length length of output_buffer in bytes
+ * \return `RCL_RET_OK` if the topic name was expanded successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BUFFER_TOO_SMALL` if the result does not fit, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if the given topic name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the namespace_ is invalid, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` for unknown substitutions in name, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_expand_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length);
+
+/// Expand a topic name into a caller provided buffer, validating the result.
+/**
+ * This function behaves like rcl_expand_topic_name_with_buffer(), but checks
+ * the fully expanded name against the full topic name rules of
+ * rmw_validate_full_topic_name() as the name is produced, instead of
+ * requiring a separate validation pass over the finished string.
+ * It is intended for entity creation, which previously expanded and then
+ * validated in two full traversals per name.
+ *
+ * Unlike rcl_expand_topic_name(), the node name and namespace are not
+ * re-validated here; they must already be valid, which holds for the name
+ * and namespace of an initialized node.
+ *
+ * On `RCL_RET_OK`, `validation_result` holds one of the `RMW_TOPIC_*`
+ * validation results, `RMW_TOPIC_VALID` if the expanded name is a valid
+ * full topic name.  An invalid name is not a function error, matching
+ * rmw_validate_full_topic_name(); the buffer contents are only meaningful
+ * when the name is valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] input_topic_name topic name to be expanded
+ * \param[in] node_name valid name of the node associated with the topic
+ * \param[in] node_namespace valid namespace of the node associated with the topic
+ * \param[in] substitutions string map with possible substitutions
+ * \param[out] output_buffer buffer to write the expanded topic name into
+ * \param[in] output_buffer_length length of output_buffer in bytes
+ * \param[out] validation_result rmw validation result for the expanded name
+ * \return `RCL_RET_OK` if the topic name was expanded, valid or not, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BUFFER_TOO_SMALL` if the result does not fit, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if a substitution brace is unmatched, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` for unknown substitutions in name, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_expand_and_validate_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length,
+  int * validation_result);
+
+struct rcl_topic_template_impl_t;
+
+/// A topic name spec compiled into segments for repeated expansion.
+typedef struct rcl_topic_template_t
+{
+  /// Implementation specific pointer.
+  struct rcl_topic_template_impl_t * impl;
+} rcl_topic_template_t;
+
+/// Return a zero initialized rcl_topic_template_t struct.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_topic_template_t
+rcl_get_zero_initialized_topic_template(void);
+
+/// Compile a topic name spec for repeated expansion.
+/**
+ * The spec is scanned once for `~` and `{substitution}` markers and broken
+ * into a list of literal runs and substitution slots, so that rendering the
+ * template with rcl_topic_template_render() is a handful of memcpys with no
+ * scanning.  Use it when the same spec is expanded repeatedly, for example
+ * when entities are recreated on every reconfiguration; for one-off
+ * expansions rcl_expand_topic_name_with_buffer() is simpler.
+ *
+ * The spec is validated with rcl_validate_topic_name() and copied, so the
+ * given string does not need to outlive the template.  The built-in
+ * substitutions `{node}`, `{ns}`, and `{namespace}` are resolved to their
+ * slot kinds here; other substitutions are looked up in the map given to
+ * each render, which may change between renders.
+ *
+ * The template must be finalized with rcl_topic_template_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] topic_name_spec topic name to be compiled
+ * \param[in] allocator the allocator to store the compiled template with
+ * \param[out] topic_template zero initialized template to be setup
+ * \return `RCL_RET_OK` if the spec was compiled successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the template is already compiled, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_TOPIC_NAME_INVALID` if the given spec is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topic_template_compile(
+  const char * topic_name_spec,
+  rcl_allocator_t allocator,
+  rcl_topic_template_t * topic_template);
+
+/// Expand a compiled template into a caller provided buffer.
+/**
+ * Produces the same name as rcl_expand_topic_name_with_buffer() would for
+ * the template's spec, by concatenating the precompiled segments; nothing
+ * is scanned or allocated.
+ * Like rcl_expand_and_validate_topic_name_with_buffer(), the node name and
+ * namespace are not re-validated; they must already be valid, which holds
+ * for the name and namespace of an initialized node.
+ *
+ * If the expanded name, including the null terminator, does not fit in
+ * `output_buffer_length` bytes, `RCL_RET_BUFFER_TOO_SMALL` is returned and
+ * the buffer contents are undefined.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] topic_template compiled template to expand
+ * \param[in] node_name valid name of the node associated with the topic
+ * \param[in] node_namespace valid namespace of the node associated with the topic
+ * \param[in] substitutions string map with possible substitutions
+ * \param[out] output_buffer buffer to write the expanded topic name into
+ * \param[in] output_buffer_length length of output_buffer in bytes
+ * \return `RCL_RET_OK` if the topic name was expanded successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BUFFER_TOO_SMALL` if the result does not fit, or
+ * \return `RCL_RET_UNKNOWN_SUBSTITUTION` for unknown substitutions in name.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topic_template_render(
+  const rcl_topic_template_t * topic_template,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length);
+
+/// Finalize a compiled topic template.
+/**
+ * Finalizing a zero initialized or already finalized template is ok.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] topic_template template to be finalized
+ * \return `RCL_RET_OK` if finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if topic_template is `NULL`.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topic_template_fini(rcl_topic_template_t * topic_template);
+
 /// Fill a given string map with the default substitution pairs.
 /**
  * If the string map is not initialized RCL_RET_INVALID_ARGUMENT is returned.
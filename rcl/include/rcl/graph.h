@@ -27,8 +27,10 @@ extern "C"
 
 #include "rosidl_generator_c/service_type_support_struct.h"
 
+#include "rcl/arena.h"
 #include "rcl/macros.h"
 #include "rcl/client.h"
+#include "rcl/guard_condition.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
 
@@ -87,6 +89,353 @@ rcl_get_topic_names_and_types(
   bool no_demangle,
   rcl_names_and_types_t * topic_names_and_types);
 
+/// Return a list of topic names and their types, allocated from an arena.
+/**
+ * Behaves like rcl_get_topic_names_and_types(), except that every string
+ * and array of the result is carved out of `arena`.  A result for N topics
+ * normally costs several allocations per topic, all torn down individually
+ * by rcl_names_and_types_fini(); with an arena the whole result is a few
+ * block allocations and is released in one step by rcl_arena_fini().
+ *
+ * The result must not be used after the arena is finalized, and must not
+ * be passed to rcl_names_and_types_fini() (doing so is harmless but
+ * pointless, as arena deallocations are no-ops).
+ * The arena may be reused across queries; it keeps growing until finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] arena initialized arena the result is allocated from
+ * \param[in] no_demangle if true, list all topics without any demangling
+ * \param[out] topic_names_and_types list of topic names and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_topic_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_arena_t * arena,
+  bool no_demangle,
+  rcl_names_and_types_t * topic_names_and_types);
+
+/// Cursor for streaming the topic graph in fixed-size chunks.
+/**
+ * The members are an implementation detail; do not access them directly.
+ * \sa rcl_topics_cursor_init()
+ */
+typedef struct rcl_topics_cursor_t
+{
+  /// Node the cursor iterates on; NULL when zero initialized or finalized.
+  const rcl_node_t * node;
+  /// Allocator the chunks are allocated with.
+  rcl_allocator_t allocator;
+  /// Demangle setting the snapshot was captured with.
+  bool no_demangle;
+  /// Index of the next topic to yield.
+  size_t position;
+  /// Private snapshot, used only when the node has no graph cache.
+  rcl_names_and_types_t snapshot;
+  /// Whether `snapshot` is owned and must be finalized.
+  bool owns_snapshot;
+  /// Graph cache generation the iteration is pinned to.
+  uint64_t generation;
+} rcl_topics_cursor_t;
+
+/// Get a zero initialized rcl_topics_cursor_t instance.
+/**
+ * \sa rcl_topics_cursor_init()
+ * \return zero initialized topics cursor.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_topics_cursor_t
+rcl_get_zero_initialized_topics_cursor(void);
+
+/// Start streaming the list of topic names and types in chunks.
+/**
+ * Where rcl_get_topic_names_and_types() materializes the entire result at
+ * once, a cursor yields it in fixed-size chunks via
+ * rcl_topics_cursor_next(), so introspection tools process the graph with
+ * O(chunk) peak memory instead of O(graph).
+ *
+ * With the node's graph cache enabled (see rcl_node_graph_cache_enable())
+ * the cursor iterates the cached snapshot in place and allocates nothing
+ * beyond the chunks; the iteration is pinned to the snapshot present at
+ * init and fails if rcl_node_graph_cache_mark_changed() is called before
+ * it finishes, in which case the caller restarts it.  Without a cache the
+ * cursor takes a private snapshot, which is finalized with the cursor.
+ *
+ * The node must outlive the cursor.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used when allocating chunks
+ * \param[in] no_demangle if true, list all topics without any demangling
+ * \param[inout] cursor a zero initialized cursor to set up
+ * \return `RCL_RET_OK` if the cursor is ready, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topics_cursor_init(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  rcl_topics_cursor_t * cursor);
+
+/// Yield the next chunk of topics from a cursor.
+/**
+ * Fills `chunk` with up to `chunk_size` topics and their types; a chunk
+ * with zero names means the iteration is complete.  The chunk buffer is
+ * reusable: any contents from the previous call are finalized before it
+ * is refilled, so the expected usage is a zero initialized
+ * rcl_names_and_types_t passed to every call and finalized once with
+ * rcl_names_and_types_fini() after the loop.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cursor the cursor being iterated
+ * \param[in] chunk_size maximum number of topics to yield, must be nonzero
+ * \param[inout] chunk buffer receiving the next topics, reused across calls
+ * \return `RCL_RET_OK` if the chunk was filled (possibly with zero topics), or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if the graph changed while iterating, or an
+ *   unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topics_cursor_next(
+  rcl_topics_cursor_t * cursor,
+  size_t chunk_size,
+  rcl_names_and_types_t * chunk);
+
+/// Finalize a topics cursor.
+/**
+ * Releases the private snapshot, if any, and zero initializes the cursor.
+ * Chunks already yielded are owned by the caller and stay valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] cursor the cursor to finalize
+ * \return `RCL_RET_OK` if the cursor was finalized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the cursor is `NULL`, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_topics_cursor_fini(rcl_topics_cursor_t * cursor);
+
+/// Return the types for a specific list of topics.
+/**
+ * For callers that only care about a known set of topics (a bridge
+ * resolving a configured topic list, for example) this resolves just the
+ * requested names in one pass over the graph data, instead of the caller
+ * fetching all topics with rcl_get_topic_names_and_types() and discarding
+ * most of the result.  With the node's graph cache enabled the pass runs
+ * over the cached snapshot without copying it.
+ *
+ * The `types` parameter must point to a caller allocated array of
+ * `topic_count` zero initialized string arrays; `types[i]` receives the
+ * types of `topics[i]`, or an empty array if the topic is not in the
+ * graph.  Each entry must be finalized with rcutils_string_array_fini()
+ * when no longer needed.  On error, entries filled so far are finalized
+ * again before returning.
+ *
+ * The topic names are compared exactly as given, so they must be fully
+ * qualified like the names returned by rcl_get_topic_names_and_types().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used when allocating space for strings
+ * \param[in] topics the fully qualified topic names to resolve
+ * \param[in] topic_count number of entries in `topics` and `types`
+ * \param[in] no_demangle if true, match topics as they appear to the middleware
+ * \param[out] types caller allocated array receiving the types per topic
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_types_for_topics(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const char ** topics,
+  size_t topic_count,
+  bool no_demangle,
+  rcutils_string_array_t * types);
+
+/// Return a list of topics published by a specific remote node, with their types.
+/**
+ * Rather than pulling the entire topic list and filtering client-side,
+ * this queries just the publishers created by the node named `node_name`
+ * in `node_namespace`, so per-node introspection is proportional to that
+ * node's entity count.
+ *
+ * Like rcl_get_topic_names_and_types(), `topic_names_and_types` must be
+ * zero initialized, must be finalized with rcl_names_and_types_fini(), and
+ * the returned names are not remapped.
+ *
+ * \see rcl_get_node_names() for how to enumerate the nodes to query.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used when allocating space for strings
+ * \param[in] no_demangle if true, list all topics without any demangling
+ * \param[in] node_name name of the node whose publishers are listed
+ * \param[in] node_namespace namespace of the node whose publishers are listed
+ * \param[out] topic_names_and_types list of published topic names and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the queried node name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the queried namespace is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_publisher_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * topic_names_and_types);
+
+/// Return a list of topics subscribed to by a specific remote node, with their types.
+/**
+ * Identical to rcl_get_publisher_names_and_types_by_node() except that the
+ * node's subscriptions are listed.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used when allocating space for strings
+ * \param[in] no_demangle if true, list all topics without any demangling
+ * \param[in] node_name name of the node whose subscriptions are listed
+ * \param[in] node_namespace namespace of the node whose subscriptions are listed
+ * \param[out] topic_names_and_types list of subscribed topic names and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the queried node name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the queried namespace is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_subscriber_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * topic_names_and_types);
+
+/// Return a list of services offered by a specific remote node, with their types.
+/**
+ * Identical to rcl_get_publisher_names_and_types_by_node() except that the
+ * node's services are listed and there is no demangle option, like
+ * rcl_get_service_names_and_types().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used when allocating space for strings
+ * \param[in] node_name name of the node whose services are listed
+ * \param[in] node_namespace namespace of the node whose services are listed
+ * \param[out] service_names_and_types list of offered service names and their types
+ * \return `RCL_RET_OK` if the query was successful, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the queried node name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the queried namespace is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_service_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * service_names_and_types);
+
 /// Return a list of service names and their types.
 /**
  * This function returns a list of service names in the ROS graph and their types.
@@ -214,6 +563,253 @@ rcl_get_node_names(
   rcutils_string_array_t * node_names,
   rcutils_string_array_t * node_namespaces);
 
+/// Enable caching of graph queries on this node.
+/**
+ * Once enabled, rcl_get_topic_names_and_types(),
+ * rcl_get_service_names_and_types() and rcl_get_node_names() serve their
+ * results from a per-node snapshot instead of issuing a full rmw graph
+ * query per call, which matters for callers that poll them at a fixed
+ * rate.  A snapshot is refreshed through rmw the first time a query runs
+ * after rcl_node_graph_cache_mark_changed() reported a graph change, so
+ * the intended usage is event driven:
+ *
+ * - add the node's graph guard condition (see
+ *   rcl_node_get_graph_guard_condition()) to a wait set,
+ * - call rcl_node_graph_cache_mark_changed() whenever the wait set wakes
+ *   up on it,
+ * - query the graph as often as needed; rmw is only consulted again after
+ *   a reported change.
+ *
+ * Without mark_changed() calls the queries keep returning the first
+ * snapshot taken, so enabling the cache without wiring up the guard
+ * condition trades staleness for speed.
+ *
+ * The cached queries are not thread-safe, unlike the uncached ones.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node whose graph queries should be cached
+ * \return `RCL_RET_OK` if the cache is enabled (also if it already was), or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_graph_cache_enable(rcl_node_t * node);
+
+/// Report a graph change to the node's graph cache.
+/**
+ * Marks the cached snapshots stale and bumps the cache generation; the
+ * next graph query per kind refreshes through rmw.  Typically called
+ * after a wait set woke up on the node's graph guard condition.
+ *
+ * Topics with a registered count change callback (see
+ * rcl_node_graph_cache_set_publisher_count_callback()) are re-counted
+ * through rmw before this returns, and their callbacks fire from here
+ * when a count crossed zero.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] rmw may allocate while re-counting watched topics.</i>
+ *
+ * \param[in] node the handle to the node whose graph cache should be marked
+ * \return `RCL_RET_OK` if the change was recorded, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled, or
+ * \return `RCL_RET_ERROR` if re-counting a watched topic failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_graph_cache_mark_changed(const rcl_node_t * node);
+
+/// Get the generation counter of the node's graph cache.
+/**
+ * The generation starts at 1 and grows by one per reported graph change,
+ * so a caller that remembers the last generation it saw can skip querying
+ * (and copying) altogether while the generation is unchanged.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node whose graph cache is queried
+ * \param[out] generation the current cache generation
+ * \return `RCL_RET_OK` if the generation was written, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if generation is `NULL`, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_graph_cache_get_generation(const rcl_node_t * node, uint64_t * generation);
+
+/// Get the topics that appeared and disappeared since a previous call.
+/**
+ * Diffs the current topic graph against the snapshot identified by
+ * `since_token`: topics that appeared since then (or whose type set
+ * changed) are written to `additions`, topics that disappeared (or whose
+ * type set changed) to `removals`, and the token identifying the current
+ * snapshot to `new_token`.  Pass 0 as `since_token` on the first call,
+ * which reports the whole graph as additions, and the last `new_token` on
+ * subsequent calls.  A token the cache no longer recognizes also falls
+ * back to reporting the whole graph as additions, so callers must treat
+ * an addition of an already known topic as a no-op.
+ *
+ * This lets discovery-reactive components process O(changes) work per
+ * graph guard condition wakeup instead of diffing full snapshots:
+ * call rcl_node_graph_cache_mark_changed() when the wait set wakes up on
+ * the node's graph guard condition, then fetch the delta with this
+ * function.
+ *
+ * The cache keeps a single baseline snapshot, so only one consumer per
+ * node can track deltas; a second consumer invalidates the first one's
+ * token, degrading it to full resyncs rather than wrong results.
+ *
+ * The node's graph cache must be enabled, see rcl_node_graph_cache_enable().
+ * Both `additions` and `removals` must be zero initialized and must be
+ * finalized by the caller with rcl_names_and_types_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node being used to query the ROS graph
+ * \param[in] allocator allocator to be used for the output structures
+ * \param[in] since_token snapshot to diff against, or 0 for a full resync
+ * \param[out] additions topics present now but not at `since_token`
+ * \param[out] removals topics present at `since_token` but not now
+ * \param[out] new_token token identifying the current snapshot
+ * \return `RCL_RET_OK` if the delta was written, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_get_graph_changes(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  uint64_t since_token,
+  rcl_names_and_types_t * additions,
+  rcl_names_and_types_t * removals,
+  uint64_t * new_token);
+
+/// Called when a watched topic's publisher or subscriber count crosses zero.
+/**
+ * \sa rcl_node_graph_cache_set_publisher_count_callback()
+ *
+ * \param[in] topic_name fully qualified name of the topic that was counted
+ * \param[in] count the new count; either 0, or nonzero after a count of 0
+ * \param[in] user_data the pointer given when the callback was registered
+ */
+typedef void (* rcl_count_change_callback_t)(
+  const char * topic_name, size_t count, void * user_data);
+
+/// Watch a topic's publisher count for zero crossings.
+/**
+ * Registers a callback fired from rcl_node_graph_cache_mark_changed()
+ * whenever the number of publishers on `topic_name` drops to zero or rises
+ * from zero.  Together with the cached counts this removes polling from
+ * patterns like lazy publishers, which only need to know when the count
+ * crosses zero: wait on the node's graph guard condition, report wakeups
+ * with rcl_node_graph_cache_mark_changed(), and react in the callback.
+ *
+ * The topic name must be fully qualified, as passed to
+ * rcl_count_publishers(); it is copied, so it does not need to outlive the
+ * call.  A topic supports one publisher count callback per node;
+ * registering another replaces it, and a `NULL` callback unregisters.
+ * Registering counts the topic once through rmw to prime the crossing
+ * detection.
+ *
+ * The node's graph cache must be enabled, see rcl_node_graph_cache_enable().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node used to count publishers
+ * \param[in] topic_name fully qualified name of the topic to watch
+ * \param[in] callback callback to fire on zero crossings, or `NULL` to unregister
+ * \param[in] user_data opaque pointer handed to the callback, may be `NULL`
+ * \return `RCL_RET_OK` if the callback was registered or cleared, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if topic_name is `NULL`, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if the priming count fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_graph_cache_set_publisher_count_callback(
+  const rcl_node_t * node,
+  const char * topic_name,
+  rcl_count_change_callback_t callback,
+  void * user_data);
+
+/// Watch a topic's subscriber count for zero crossings.
+/**
+ * Identical to rcl_node_graph_cache_set_publisher_count_callback() except
+ * that the number of subscribers on `topic_name` is watched, as counted by
+ * rcl_count_subscribers().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node used to count subscribers
+ * \param[in] topic_name fully qualified name of the topic to watch
+ * \param[in] callback callback to fire on zero crossings, or `NULL` to unregister
+ * \param[in] user_data opaque pointer handed to the callback, may be `NULL`
+ * \return `RCL_RET_OK` if the callback was registered or cleared, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if topic_name is `NULL`, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if the priming count fails.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_graph_cache_set_subscriber_count_callback(
+  const rcl_node_t * node,
+  const char * topic_name,
+  rcl_count_change_callback_t callback,
+  void * user_data);
+
 /// Return the number of publishers on a given topic.
 /**
  * This function returns the number of publishers on a given topic.
@@ -351,6 +947,96 @@ rcl_service_server_is_available(
   const rcl_client_t * client,
   bool * is_available);
 
+/// Block until a server for the client's service is available or a timeout passes.
+/**
+ * Instead of the caller polling rcl_service_server_is_available() in a
+ * loop, this parks on the node's graph guard condition and re-checks
+ * availability only when the graph actually changed, so a client waiting
+ * on startup sequencing wakes up as soon as the server appears.
+ *
+ * A `timeout` of 0 is a non-blocking check, a negative `timeout` blocks
+ * until the server is available, and a positive `timeout` is the maximum
+ * time to wait in nanoseconds.
+ *
+ * The node's graph guard condition must not be waited on concurrently from
+ * another thread while this blocks, see rcl_wait().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Maybe [1]
+ * <i>[1] implementation may need to protect the data structure with a lock</i>
+ *
+ * \param[in] node the handle to the node whose graph guard condition is waited on
+ * \param[in] client the handle to the service client being waited for
+ * \param[in] timeout maximum time to wait in nanoseconds, 0 or negative as above
+ * \param[out] is_available set to true if a service server became available
+ * \return `RCL_RET_OK` if a server is available, or
+ * \return `RCL_RET_TIMEOUT` if the timeout passed without a server appearing, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_wait_for_service(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  int64_t timeout,
+  bool * is_available);
+
+/// Trigger a guard condition once, when a server for the client's service appears.
+/**
+ * The asynchronous counterpart of rcl_client_wait_for_service(): the given
+ * guard condition is triggered once a service server for `client` is seen,
+ * letting the caller park it in its own wait set alongside its other work
+ * instead of blocking.
+ *
+ * If the server is already available, the guard condition is triggered
+ * before this returns and nothing is registered, so the appearance cannot
+ * be missed.  Otherwise availability is re-checked from
+ * rcl_node_graph_cache_mark_changed(), so the caller (or another component
+ * in the process) must report graph guard condition wakeups as usual.
+ *
+ * The registration is one-shot: after the guard condition fires it is
+ * dropped, and it can be cancelled earlier by passing a `NULL` guard
+ * condition for the same client.  The client and the guard condition must
+ * outlive the registration.  A client supports one pending notification;
+ * registering another guard condition replaces the previous one.
+ *
+ * The node's graph cache must be enabled, see rcl_node_graph_cache_enable().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node the handle to the node used to check availability
+ * \param[in] client the handle to the service client being waited for
+ * \param[in] guard_condition guard condition to trigger, or `NULL` to cancel
+ * \return `RCL_RET_OK` if the notification was registered (or fired), or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the client is `NULL`, or
+ * \return `RCL_RET_UNSUPPORTED` if the graph cache is not enabled, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_client_notify_on_service_available(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  rcl_guard_condition_t * guard_condition);
+
 #ifdef __cplusplus
 }
 #endif
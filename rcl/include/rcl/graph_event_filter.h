@@ -0,0 +1,267 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_EVENT_FILTER_H_
+#define RCL__GRAPH_EVENT_FILTER_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/guard_condition.h"
+#include "rcl/macros.h"
+#include "rcl/node.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// The set of topic endpoints (publishers or subscriptions) changed.
+#define RCL_GRAPH_EVENT_TOPICS_CHANGED (1u << 0)
+/// The set of services changed.
+#define RCL_GRAPH_EVENT_SERVICES_CHANGED (1u << 1)
+/// The set of nodes changed.
+#define RCL_GRAPH_EVENT_NODES_CHANGED (1u << 2)
+/// All graph change kinds.
+#define RCL_GRAPH_EVENT_ANY_CHANGED \
+  (RCL_GRAPH_EVENT_TOPICS_CHANGED | \
+  RCL_GRAPH_EVENT_SERVICES_CHANGED | \
+  RCL_GRAPH_EVENT_NODES_CHANGED)
+
+/// Internal rcl graph event filter implementation struct.
+struct rcl_graph_event_filter_impl_t;
+
+/// Debouncing, classifying layer over a node's graph guard condition.
+/**
+ * The graph guard condition returned by rcl_node_get_graph_guard_condition()
+ * fires on every discovery packet and says nothing about what changed, so a
+ * node watching for, say, new services wakes on every unrelated change and
+ * has to query the graph to find out it did not care.
+ *
+ * A graph event filter sits between the raw guard condition and such a
+ * watcher.  One loop - typically the one already waiting on the raw graph
+ * guard condition - pumps the filter with rcl_graph_event_filter_process(),
+ * which classifies what changed by kind and triggers the filter's own guard
+ * condition only when a watched kind actually changed, at most once per
+ * configured minimum interval.  Watchers wait on that filtered guard
+ * condition instead of the raw one and drain the accumulated change kinds
+ * with rcl_graph_event_filter_take_events(), so a discovery storm costs them
+ * one wake instead of thousands.
+ *
+ * Classification works by re-querying the watched graph sets and comparing
+ * signatures of the results, so it shares the cost profile of the graph
+ * query functions; enabling the node's graph cache (see
+ * rcl_node_graph_cache_enable()) makes those queries and therefore the
+ * filter considerably cheaper.  While deliveries are being held back by the
+ * minimum interval the queries are skipped entirely, which is what bounds
+ * the per-packet cost during a storm.
+ */
+typedef struct rcl_graph_event_filter_t
+{
+  struct rcl_graph_event_filter_impl_t * impl;
+} rcl_graph_event_filter_t;
+
+/// Options available for a rcl graph event filter.
+typedef struct rcl_graph_event_filter_options_t
+{
+  /// Custom allocator for the filter, used for internal allocations.
+  rcl_allocator_t allocator;
+  /// Minimum time between deliveries in nanoseconds; 0 delivers every change.
+  /**
+   * With a minimum interval of, for example, RCL_MS_TO_NS(200), watchers of
+   * the filter wake at most five times per second no matter how fast the
+   * underlying graph guard condition fires.  Changes noticed while a
+   * delivery is held back are not lost; they are reported by the first call
+   * to rcl_graph_event_filter_process() after the interval has passed.
+   */
+  int64_t min_interval;
+  /// Which kinds of changes to watch, a bitwise OR of RCL_GRAPH_EVENT_* bits.
+  /**
+   * Unwatched kinds are never queried, never classified, and never wake the
+   * filtered guard condition.
+   */
+  uint32_t event_mask;
+} rcl_graph_event_filter_options_t;
+
+/// Return a rcl_graph_event_filter_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_graph_event_filter_t
+rcl_get_zero_initialized_graph_event_filter(void);
+
+/// Return the default options in a rcl_graph_event_filter_options_t struct.
+/**
+ * The defaults are:
+ *
+ * - allocator = rcl_get_default_allocator()
+ * - min_interval = 0
+ * - event_mask = RCL_GRAPH_EVENT_ANY_CHANGED
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_graph_event_filter_options_t
+rcl_graph_event_filter_get_default_options(void);
+
+/// Initialize a graph event filter for a node.
+/**
+ * The current graph is queried once to prime the change detection, so the
+ * filter reports changes relative to the graph as it was at init time.
+ *
+ * The node is borrowed, not copied; it must outlive the filter.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] filter preallocated, zero initialized filter structure
+ * \param[in] node valid node whose graph guard condition is being filtered
+ * \param[in] options the filter's options, including the watched event mask
+ * \return `RCL_RET_OK` if the filter was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the filter is already initialized, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_event_filter_init(
+  rcl_graph_event_filter_t * filter,
+  const rcl_node_t * node,
+  const rcl_graph_event_filter_options_t options);
+
+/// Finalize a graph event filter.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] filter the filter to be finalized
+ * \return `RCL_RET_OK` if the filter was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_event_filter_fini(rcl_graph_event_filter_t * filter);
+
+/// Get the filtered guard condition watchers should wait on.
+/**
+ * The guard condition is owned by the filter and triggered by
+ * rcl_graph_event_filter_process() when a watched kind of change is
+ * delivered.  It coalesces triggers, so waking on it and then draining with
+ * rcl_graph_event_filter_take_events() handles every delivery since the
+ * last drain in one batch.
+ *
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - filter is `NULL`
+ *   - filter is invalid (never called init or called fini)
+ *
+ * The returned pointer is made invalid if the filter is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] filter pointer to the filter
+ * \return the filtered guard condition if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+const rcl_guard_condition_t *
+rcl_graph_event_filter_get_guard_condition(const rcl_graph_event_filter_t * filter);
+
+/// Pump the filter; call when the raw graph guard condition fires.
+/**
+ * If the minimum interval since the last delivery has not yet passed the
+ * call returns immediately without touching the graph, reporting no events;
+ * this is the cheap path a discovery storm takes.  Otherwise the watched
+ * graph sets are re-queried, changes are classified by kind, and if any
+ * watched kind changed the filtered guard condition is triggered and the
+ * delivered kinds are reported in `events` as well as accumulated for
+ * rcl_graph_event_filter_take_events().
+ *
+ * Because deliveries only happen from inside this function, a change that
+ * arrives at the very end of a storm is reported by the next pump after the
+ * interval has passed - typically the next discovery packet, or a periodic
+ * call from a timer for callers that need a hard delivery bound.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when the minimum interval has passed and the graph is queried</i>
+ *
+ * \param[in] filter valid filter to pump
+ * \param[out] events the kinds delivered by this call, 0 if none
+ * \return `RCL_RET_OK` if the filter was pumped successfully, or
+ * \return `RCL_RET_NODE_INVALID` if the filter's node is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_event_filter_process(
+  rcl_graph_event_filter_t * filter,
+  uint32_t * events);
+
+/// Take the kinds of changes delivered since the last take.
+/**
+ * Returns the accumulated RCL_GRAPH_EVENT_* bits and resets them, also
+ * re-arming the filtered guard condition.  Watchers call this after waking
+ * on the filtered guard condition to decide which queries are worth making.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] filter valid filter to drain
+ * \param[out] events the accumulated change kinds, 0 if none
+ * \return `RCL_RET_OK` if the events were taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_graph_event_filter_take_events(
+  rcl_graph_event_filter_t * filter,
+  uint32_t * events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_EVENT_FILTER_H_
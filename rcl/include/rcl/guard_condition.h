@@ -43,6 +43,30 @@ typedef struct rcl_guard_condition_options_t
 {
   /// Custom allocator for the guard condition, used for internal allocations.
   rcl_allocator_t allocator;
+  /// If true, redundant triggers are coalesced rather than passed to rmw.
+  /**
+   * With coalescing enabled, each call to rcl_trigger_guard_condition()
+   * increments an atomic pending count and only the transition from zero to
+   * one is forwarded to rmw_trigger_guard_condition(); the guard condition
+   * wakes a wait set at most once until the count is drained with
+   * rcl_guard_condition_take_pending_count().
+   */
+  bool enable_trigger_coalescing;
+  /// If true, the trigger is handed to the waiter in-process.
+  /**
+   * A local guard condition is meant for the common case where the trigger
+   * and the waiter live in the same process, so the round trip through the
+   * middleware's condition variable machinery is pure overhead.
+   * Triggering sets an atomic flag that rcl_wait() consults before blocking
+   * and after waking; rmw is only involved when a waiter is already blocked
+   * in rmw_wait() and has to be interrupted, through a single rmw guard
+   * condition shared by all local guard conditions in the context.
+   * When no wait is in progress a trigger is one atomic store.
+   *
+   * A local guard condition cannot be initialized from an existing rmw
+   * guard condition, and its rmw handle is owned by the context.
+   */
+  bool local;
 } rcl_guard_condition_options_t;
 
 /// Return a rcl_guard_condition_t struct with members set to `NULL`.
@@ -164,11 +188,89 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_guard_condition_fini(rcl_guard_condition_t * guard_condition);
 
+/// Acquire an initialized guard condition from the context's reuse pool.
+/**
+ * For callers that need a guard condition per one-shot wakeup,
+ * rcl_guard_condition_init() pays an allocation plus middleware guard
+ * condition creation every time, and rcl_guard_condition_fini() the
+ * matching destruction.
+ * This function instead recycles a previously released condition when one
+ * is pooled on the context, which touches neither the allocator nor the
+ * middleware; a fresh condition is initialized with the context's allocator
+ * and the default options when the pool is empty.
+ *
+ * The returned condition must be returned with
+ * rcl_context_release_guard_condition() instead of
+ * rcl_guard_condition_fini(), before the context is finalized; any
+ * conditions still in the pool are finalized with the context.
+ * A condition released while a trigger is still pending may wake the next
+ * acquirer's first wait spuriously.
+ *
+ * Like entity creation on a context, acquiring and releasing guard
+ * conditions is not thread-safe; concurrent callers must serialize these
+ * calls, though they may use the acquired conditions concurrently.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose pool is used
+ * \param[out] guard_condition set to a ready-to-use guard condition on success
+ * \return `RCL_RET_OK` if a guard condition was acquired successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_acquire_guard_condition(
+  rcl_context_t * context,
+  rcl_guard_condition_t ** guard_condition);
+
+/// Return an acquired guard condition to the context's reuse pool.
+/**
+ * The guard condition keeps its middleware handle, so a later
+ * rcl_context_acquire_guard_condition() reuses it without touching the
+ * allocator or the middleware.
+ *
+ * The guard condition must have come from
+ * rcl_context_acquire_guard_condition() on the same context; releasing any
+ * other guard condition results in undefined behavior.
+ * The caller must not use the guard condition after releasing it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose pool the guard condition came from
+ * \param[in] guard_condition the guard condition to return to the pool
+ * \return `RCL_RET_OK` if the guard condition was released successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_release_guard_condition(
+  rcl_context_t * context,
+  rcl_guard_condition_t * guard_condition);
+
 /// Return the default options in a rcl_guard_condition_options_t struct.
 /**
  * The defaults are:
  *
  * - allocator = rcl_get_default_allocator()
+ * - enable_trigger_coalescing = false
+ * - local = false
  */
 RCL_PUBLIC
 RCL_WARN_UNUSED
@@ -202,6 +304,36 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition);
 
+/// Take the number of coalesced triggers since the last take.
+/**
+ * Atomically retrieves the pending trigger count and resets it to zero, so
+ * that consumers draining the guard condition after a wait can handle all
+ * coalesced triggers in one batch.  The next trigger after the count is
+ * taken will cross into rmw again and wake the wait set.
+ *
+ * For guard conditions without coalescing enabled the count is always zero.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_uint_least64_t` is lock-free</i>
+ *
+ * \param[in] guard_condition handle to the guard_condition to drain
+ * \param[out] count the number of triggers since the last take
+ * \return `RCL_RET_OK` if the count was retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_guard_condition_take_pending_count(
+  const rcl_guard_condition_t * guard_condition,
+  size_t * count);
+
 /// Return the guard condition options.
 /**
  * Returned is a pointer to the internally held rcl_guard_condition_options_t.
@@ -77,6 +77,13 @@ rcl_init_options_init(rcl_init_options_t * init_options, rcl_allocator_t allocat
  * The allocator from the source is used for any allocations and stored in the
  * destination.
  *
+ * The underlying rmw init options are shared with the source by reference
+ * count rather than deep-copied; they are only duplicated when one of the
+ * copies is about to be mutated, e.g. through
+ * rcl_init_options_get_rmw_init_options().
+ * Both structures must still be finalized with rcl_init_options_fini(); the
+ * shared storage is released when the last reference is finalized.
+ *
  * The destination should either be zero initialized with
  * `rcl_get_zero_initialized_init_options()` or should have had
  * `rcl_init_options_fini()` called on it.
@@ -129,19 +136,25 @@ rcl_init_options_fini(rcl_init_options_t * init_options);
 
 /// Return the rmw init options which are stored internally.
 /**
+ * The returned pointer is mutable, so if the rmw init options are still
+ * shared with copies of this object they are deep-copied first; other copies
+ * keep seeing the values from before this call.
+ *
  * This function can fail and return `NULL` if:
  *   - init_options is NULL
  *   - init_options is invalid, e.g. init_options->impl is NULL
+ *   - un-sharing the rmw init options required a copy and the copy failed
  *
  * If NULL is returned an error message will have been set.
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [1]
  * Thread-Safe        | No
  * Uses Atomics       | Yes
  * Lock-Free          | Yes
+ * <i>[1] only if the rmw init options are still shared with copies</i>
  *
  * \param[in] init_options object from which the rmw init options should be retrieved
  * \return pointer to the the rmw init options, or
@@ -152,6 +165,99 @@ RCL_WARN_UNUSED
 rmw_init_options_t *
 rcl_init_options_get_rmw_init_options(rcl_init_options_t * init_options);
 
+/// Set whether nodes in the context share one middleware participant.
+/**
+ * When enabled, the first node initialized in the context creates the
+ * middleware node and every further node multiplexes its entities onto that
+ * same node, so a process with many nodes announces a single participant to
+ * the network instead of one per node.
+ * The participant is created with the first node's name, namespace, domain
+ * id and security settings; those of later nodes are not reflected in the
+ * middleware, and per-node graph introspection reports everything under the
+ * first node.
+ * The shared participant is destroyed when the last node using it is
+ * finalized.
+ *
+ * Defaults to false.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] init_options object in which the mode is set
+ * \param[in] share_participant true to share one participant per context
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_init_options_set_share_participant(
+  rcl_init_options_t * init_options,
+  bool share_participant);
+
+/// Get whether nodes in the context share one middleware participant.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] init_options object from which the mode is retrieved
+ * \param[out] share_participant set to the currently configured mode
+ * \return `RCL_RET_OK` if the mode was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_init_options_get_share_participant(
+  const rcl_init_options_t * init_options,
+  bool * share_participant);
+
+/// Set a pre-parsed arguments blob to load instead of parsing argv.
+/**
+ * When a blob made by rcl_arguments_serialize() is set, rcl_init() fills the
+ * context's global arguments by loading it with rcl_arguments_deserialize()
+ * and does not parse the given argument vector for ROS arguments, so a child
+ * process receiving the blob from its launcher skips the parse of a long
+ * argument vector entirely.
+ * The given argv is still copied into the context for later retrieval.
+ *
+ * The blob is copied into the options; the caller keeps ownership of the
+ * given buffer.  Setting a new blob replaces a previously set one, and
+ * setting `NULL` with a length of 0 clears it, restoring normal parsing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] init_options object in which the blob is set
+ * \param[in] buffer serialized arguments blob, or `NULL` to clear
+ * \param[in] buffer_length size of the blob in bytes
+ * \return `RCL_RET_OK` if the blob was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if copying the blob failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_init_options_set_serialized_arguments(
+  rcl_init_options_t * init_options,
+  const uint8_t * buffer,
+  size_t buffer_length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,298 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__LATENCY_PROBE_H_
+#define RCL__LATENCY_PROBE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/node.h"
+#include "rcl/time.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+#include "rosidl_generator_c/message_type_support_struct.h"
+#include "rosidl_generator_c/service_type_support_struct.h"
+
+/// \file
+/// In-process round trip latency self-measurement.
+/**
+ * A latency probe pairs a loopback publisher with a subscription, and a
+ * loopback service with a client, all inside one node on hidden names, and
+ * measures how long a message or a request takes to make the round trip
+ * through the rcl and rmw layers of this process.
+ * The resulting percentiles are a baseline to subtract from application
+ * level measurements: a latency regression that reproduces on the probe
+ * comes from the middleware stack, one that does not comes from the
+ * application.
+ */
+
+/// Internal rcl implementation struct.
+struct rcl_latency_probe_impl_t;
+
+/// Handle for a latency probe and its loopback entities.
+typedef struct rcl_latency_probe_t
+{
+  struct rcl_latency_probe_impl_t * impl;
+} rcl_latency_probe_t;
+
+/// Options available for a rcl_latency_probe_t.
+typedef struct rcl_latency_probe_options_t
+{
+  /// Middleware quality of service settings for the loopback entities.
+  rmw_qos_profile_t qos;
+  /// Custom allocator for the probe, used for incidental allocations.
+  /** For default behavior (malloc/free), use: rcl_get_default_allocator() */
+  rcl_allocator_t allocator;
+  /// Number of most recent samples retained per channel; must be non-zero.
+  /**
+   * Each measured round trip appends one sample; once the capacity is
+   * reached the oldest sample is overwritten, so the percentiles reflect a
+   * sliding window of the most recent measurements.
+   */
+  size_t max_samples;
+  /// Round trips run before each measurement without recording samples.
+  /**
+   * The first trips after a quiet period pay for cold caches and lazily
+   * initialized middleware paths; warm up trips keep them out of the
+   * percentiles.  The default is 1.
+   */
+  size_t warmup_iterations;
+} rcl_latency_probe_options_t;
+
+/// Percentile summary over the retained round trip samples of one channel.
+typedef struct rcl_latency_stats_t
+{
+  /// Number of samples the other fields were computed over; if zero, the
+  /// remaining fields are zero as well.
+  uint64_t sample_count;
+  /// Smallest retained round trip time, in nanoseconds.
+  rcl_duration_value_t min;
+  /// Largest retained round trip time, in nanoseconds.
+  rcl_duration_value_t max;
+  /// 50th percentile (median) round trip time, in nanoseconds.
+  rcl_duration_value_t p50;
+  /// 90th percentile round trip time, in nanoseconds.
+  rcl_duration_value_t p90;
+  /// 99th percentile round trip time, in nanoseconds.
+  rcl_duration_value_t p99;
+} rcl_latency_stats_t;
+
+/// Return a rcl_latency_probe_t struct with members set to `NULL`.
+RCL_PUBLIC
+rcl_latency_probe_t
+rcl_get_zero_initialized_latency_probe(void);
+
+/// Return the default latency probe options.
+/**
+ * The defaults are:
+ * - qos = rmw_qos_profile_default
+ * - allocator = rcl_get_default_allocator()
+ * - max_samples = 256
+ * - warmup_iterations = 1
+ */
+RCL_PUBLIC
+rcl_latency_probe_options_t
+rcl_latency_probe_get_default_options(void);
+
+/// Initialize a latency probe on the given node.
+/**
+ * A publisher and a subscription are created on the hidden topic
+ * `~/_latency_probe` when \p message_type_support is given, and a service
+ * and a client on the hidden service name `~/_latency_probe` when
+ * \p service_type_support is given; at least one of the two must be given.
+ * rcl carries no message definitions of its own, so the caller picks the
+ * types the probe loops back; a small bounded type keeps the measured cost
+ * close to the per message floor of the stack.
+ *
+ * The probe's entities count against the node's middleware resources like
+ * any other entities, and the hidden names keep them out of undecorated
+ * graph introspection.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] probe a zero initialized probe to set up
+ * \param[inout] node the node to create the loopback entities on
+ * \param[in] message_type_support type support for the loopback topic, or
+ *   `NULL` to measure only the service channel
+ * \param[in] service_type_support type support for the loopback service, or
+ *   `NULL` to measure only the message channel
+ * \param[in] options the probe options, including the loopback qos
+ * \return `RCL_RET_OK` if the probe was initialized successfully, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the probe is already initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory fails, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_init(
+  rcl_latency_probe_t * probe,
+  rcl_node_t * node,
+  const rosidl_message_type_support_t * message_type_support,
+  const rosidl_service_type_support_t * service_type_support,
+  const rcl_latency_probe_options_t * options);
+
+/// Finalize a latency probe.
+/**
+ * The loopback entities are destroyed and the retained samples released.
+ *
+ * \param[inout] probe the probe to be finalized
+ * \param[inout] node the node the probe was initialized on
+ * \return `RCL_RET_OK` if the probe was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_fini(rcl_latency_probe_t * probe, rcl_node_t * node);
+
+/// Measure publish to take round trips over the loopback topic.
+/**
+ * Each iteration publishes \p ros_message, waits for the loopback
+ * subscription to report it, takes it into \p taken_message, and records the
+ * elapsed steady clock time as one sample.
+ * The scratch message is overwritten on every trip; its content after the
+ * call is the last message taken.
+ *
+ * Discovery between the loopback pair may not have completed right after
+ * rcl_latency_probe_init(); a measurement started before then times out, and
+ * the caller should retry until the first measurement succeeds.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] probe the probe to measure with
+ * \param[in] ros_message the message published on every round trip
+ * \param[inout] taken_message scratch message each round trip is taken into
+ * \param[in] iterations number of samples to record; must be non-zero
+ * \param[in] timeout maximum time to wait for any single round trip, in
+ *   nanoseconds; negative blocks indefinitely
+ * \return `RCL_RET_OK` if all round trips were measured, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or the
+ *   probe was initialized without a message channel, or
+ * \return `RCL_RET_TIMEOUT` if a round trip did not complete in time, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_measure_messages(
+  rcl_latency_probe_t * probe,
+  const void * ros_message,
+  void * taken_message,
+  size_t iterations,
+  int64_t timeout);
+
+/// Measure request to response round trips over the loopback service.
+/**
+ * Each iteration sends \p ros_request from the loopback client, takes it on
+ * the loopback service into \p taken_request, answers with \p ros_response,
+ * takes the response into \p taken_response, and records the elapsed steady
+ * clock time as one sample.
+ * The scratch messages are overwritten on every trip.
+ *
+ * \see rcl_latency_probe_measure_messages() for the discovery caveat and
+ *   the attribute table, which apply here as well.
+ *
+ * \param[inout] probe the probe to measure with
+ * \param[in] ros_request the request sent on every round trip
+ * \param[inout] taken_request scratch message each request is taken into
+ * \param[in] ros_response the response sent back on every round trip
+ * \param[inout] taken_response scratch message each response is taken into
+ * \param[in] iterations number of samples to record; must be non-zero
+ * \param[in] timeout maximum time to wait for any single exchange, in
+ *   nanoseconds; negative blocks indefinitely
+ * \return `RCL_RET_OK` if all round trips were measured, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or the
+ *   probe was initialized without a service channel, or
+ * \return `RCL_RET_TIMEOUT` if a round trip did not complete in time, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_measure_services(
+  rcl_latency_probe_t * probe,
+  const void * ros_request,
+  void * taken_request,
+  const void * ros_response,
+  void * taken_response,
+  size_t iterations,
+  int64_t timeout);
+
+/// Get the percentile summary of the retained message round trip samples.
+/**
+ * The percentiles are computed on demand over the retained sliding window
+ * (see the max_samples option); with no samples recorded yet all fields are
+ * zero, which is not an error.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] probe the probe to query
+ * \param[out] stats struct the summary is written into
+ * \return `RCL_RET_OK` if the summary was computed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or the
+ *   probe was initialized without a message channel.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_get_message_stats(
+  const rcl_latency_probe_t * probe,
+  rcl_latency_stats_t * stats);
+
+/// Get the percentile summary of the retained service round trip samples.
+/**
+ * This function behaves exactly the same as for message samples.
+ * \see rcl_latency_probe_get_message_stats
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_latency_probe_get_service_stats(
+  const rcl_latency_probe_t * probe,
+  rcl_latency_stats_t * stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__LATENCY_PROBE_H_
@@ -28,13 +28,42 @@ extern "C"
 {
 #endif
 
-// Forward declaration
-struct rcl_lexer_lookahead2_impl_t;
+/// Analysis state of a lookahead2 buffer.
+/**
+ * This is an implementation detail; do not access the members directly.
+ * The state lives inline in rcl_lexer_lookahead2_t so that initializing a
+ * buffer does not allocate, which keeps parsing (for example of remap
+ * rules, one lexer per argument tried) free of per-parse allocations.
+ */
+struct rcl_lexer_lookahead2_impl_t
+{
+  // Text that is being analyzed for lexemes
+  const char * text;
+  // Where in the text analysis is being performed
+  size_t text_idx;
+
+  // first character of lexeme
+  size_t start[2];
+  // One past last character of lexeme
+  size_t end[2];
+  // Type of lexeme
+  rcl_lexeme_t type[2];
+
+  // Allocator to use if an error occurrs
+  rcl_allocator_t allocator;
+};
 
 /// Track lexical analysis and allow looking ahead 2 lexemes.
+/**
+ * Because `impl` points at the inline `state`, an initialized buffer must
+ * not be copied or moved; initialize it where it will be used.
+ */
 typedef struct rcl_lexer_lookahead2_t
 {
+  /// Points at `state` once initialized; NULL when zero initialized or finalized.
   struct rcl_lexer_lookahead2_impl_t * impl;
+  /// Inline analysis state; valid only while `impl` points at it.
+  struct rcl_lexer_lookahead2_impl_t state;
 } rcl_lexer_lookahead2_t;
 
 /// Get a zero initialized rcl_lexer_lookahead2_t instance.
@@ -59,13 +88,15 @@ rcl_get_zero_initialized_lexer_lookahead2();
 /**
  * The lookahead2 buffer borrows a reference to the provided text.
  * The text must not be freed before the buffer is finalized.
+ * The buffer's analysis state is stored inline, so initialization does not
+ * allocate and the buffer must stay where it was initialized.
  * The lookahead2 buffer only needs to be finalized if this function does not return RCL_RET_OK.
  * \sa rcl_lexer_lookahead2_fini()
  *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
+ * Allocates Memory   | No
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
@@ -76,7 +107,6 @@ rcl_get_zero_initialized_lexer_lookahead2();
  * \param[in] allocator An allocator to use if an error occurs.
  * \return `RCL_RET_OK` if the buffer is successfully initialized, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
- * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
  * \return `RCL_RET_ERROR` if an unspecified error occurrs.
  */
 RCL_PUBLIC
@@ -94,13 +124,12 @@ rcl_lexer_lookahead2_init(
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes [1]
+ * Allocates Memory   | No
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
- * <i>[1] Only allocates if an argument is invalid.</i>
  *
- * \param[in] buffer The structure to be deallocated.
+ * \param[in] buffer The structure to be finalized.
  * \return `RCL_RET_OK` if the structure was successfully finalized, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
  * \return `RCL_RET_ERROR` if an unspecified error occurs.
@@ -172,6 +201,9 @@ rcl_lexer_lookahead2_peek2(
 /// Accept a lexeme and advance analysis.
 /**
  * A token must have been peeked before it can be accepted.
+ * The returned lexeme text is a borrowed (pointer, length) view into the
+ * original string given at initialization; nothing is copied, so the view
+ * is only valid while that string is.
  * \sa rcl_lexer_lookahead2_peek()
  * \sa rcl_lexer_lookahead2_peek2()
  *
@@ -28,6 +28,7 @@ extern "C"
 #include "rcl/macros.h"
 #include "rcl/types.h"
 #include "rcl/visibility_control.h"
+#include "rcutils/types/string_map.h"
 
 /// Constant which indicates that the default domain id should be used.
 #define RCL_NODE_OPTIONS_DEFAULT_DOMAIN_ID SIZE_MAX
@@ -193,6 +194,98 @@ rcl_node_init(
   rcl_context_t * context,
   const rcl_node_options_t * options);
 
+/// Start initializing a node, deferring the middleware portion.
+/**
+ * Performs the rcl side of rcl_node_init() - argument copy, name and
+ * namespace remapping, logger name assembly, domain id and security
+ * resolution - but does not talk to the middleware.
+ * The node is not valid until rcl_node_init_complete() returns `RCL_RET_OK`;
+ * the only other functions that may be called on it before then are
+ * rcl_node_init_complete() and rcl_node_fini().
+ *
+ * Because the expensive, blocking part of initialization (middleware node
+ * creation and discovery) is isolated in rcl_node_init_complete(), a process
+ * creating many nodes can run that part for each node from its own thread
+ * while staging the next node, instead of serializing everything.
+ *
+ * Expected usage:
+ *
+ * ```c
+ * rcl_node_t node = rcl_get_zero_initialized_node();
+ * rcl_node_options_t node_ops = rcl_node_get_default_options();
+ * rcl_ret_t ret = rcl_node_init_async(&node, "node_name", "/node_ns", &context, &node_ops);
+ * // ... error handling, possibly hand the node to a worker thread, then:
+ * ret = rcl_node_init_complete(&node);
+ * // ... error handling, the node is now valid
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \pre the node handle must be allocated, zero initialized, and invalid
+ *
+ * \param[inout] node a preallocated rcl_node_t
+ * \param[in] name the name of the node, must be a valid c-string
+ * \param[in] namespace_ the namespace of the node, must be a valid c-string
+ * \param[in] context the context instance with which the node should be
+ *   associated
+ * \param[in] options the node options.
+ *   The options are deep copied into the node.
+ * \return `RCL_RET_OK` if the rcl side of initialization succeeded, or
+ * \return `RCL_RET_ALREADY_INIT` if the node has already be initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_NODE_INVALID_NAME` if the name is invalid, or
+ * \return `RCL_RET_NODE_INVALID_NAMESPACE` if the namespace_ is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_init_async(
+  rcl_node_t * node,
+  const char * name,
+  const char * namespace_,
+  rcl_context_t * context,
+  const rcl_node_options_t * options);
+
+/// Finish an initialization started with rcl_node_init_async().
+/**
+ * Creates the middleware node, which may block on discovery, and the graph
+ * guard condition, and makes the node valid.
+ * Completions of different nodes only touch their own node and may therefore
+ * run concurrently from different threads.
+ *
+ * On failure the node is torn down completely, as if rcl_node_init() had
+ * failed, and must be zero initialized again before reuse.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_uint_least64_t`</i>
+ *
+ * \pre rcl_node_init_async() returned `RCL_RET_OK` for the node
+ * \post the node handle is valid and can be used in other `rcl_*` functions
+ *
+ * \param[inout] node a node staged by rcl_node_init_async()
+ * \return `RCL_RET_OK` if the node was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if no initialization is in flight, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_node_init_complete(rcl_node_t * node);
+
 /// Finalize a rcl_node_t.
 /**
  * Destroys any automatically created infrastructure and deallocates memory.
@@ -223,16 +316,22 @@ rcl_node_fini(rcl_node_t * node);
 
 /// Copy one options structure into another.
 /**
+ * The embedded arguments are shared with the original by reference count
+ * rather than deep-copied (see rcl_arguments_copy()), so copying options is
+ * O(1) no matter how many remap rules were parsed; a process with many nodes
+ * built from the same option set holds one parsed copy, not one per node.
+ * The copy must still be cleaned up like any other options structure, which
+ * releases its reference to the shared arguments.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | Yes
+ * Allocates Memory   | No
  * Thread-Safe        | No
- * Uses Atomics       | No
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] options The structure to be copied.
- *   Its allocator is used to copy memory into the new structure.
  * \param[out] options_out An options structure containing default values.
  * \return `RCL_RET_OK` if the structure was copied successfully, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
@@ -379,6 +478,35 @@ RCL_WARN_UNUSED
 const rcl_node_options_t *
 rcl_node_get_options(const rcl_node_t * node);
 
+/// Return the node's cached topic name substitutions map.
+/**
+ * The map is created during rcl_node_init() and filled with
+ * rcl_get_default_topic_name_substitutions().
+ * Entity creation functions pass it to rcl_expand_topic_name() rather than
+ * rebuilding an identical map for every entity created on the node.
+ * This function can fail, and therefore return `NULL`, if:
+ *   - node is `NULL`
+ *   - node has not been initialized (the implementation is invalid)
+ *
+ * The returned map is owned by the node and is only valid as long as the
+ * given rcl_node_t is valid; it must not be modified or finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] node pointer to the node
+ * \return substitutions map if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+const rcutils_string_map_t *
+rcl_node_get_topic_name_substitutions(const rcl_node_t * node);
+
 /// Return the ROS domain ID that the node is using.
 /**
  * This function returns the ROS domain ID that the node is in.
@@ -508,9 +636,12 @@ rcl_node_get_graph_guard_condition(const rcl_node_t * node);
 /// Return the logger name of the node.
 /**
  * This function returns the node's internal logger name string.
+ * The logger name is built by the first call on a given node and cached, so
+ * node creation does not pay for it and later calls just return the cache.
  * This function can fail, and therefore return `NULL`, if:
  *   - node is `NULL`
  *   - node has not been initialized (the implementation is invalid)
+ *   - building the logger name fails on the first call, e.g. on bad alloc
  *
  * The returned string is only valid as long as the given rcl_node_t is valid.
  * The value of the string may change if the value in the rcl_node_t changes,
@@ -519,10 +650,11 @@ rcl_node_get_graph_guard_condition(const rcl_node_t * node);
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
- * Allocates Memory   | No
+ * Allocates Memory   | Maybe [1]
  * Thread-Safe        | No
  * Uses Atomics       | No
  * Lock-Free          | Yes
+ * <i>[1] only on the first call for a given node</i>
  *
  * \param[in] node pointer to the node
  * \return logger_name string if successful, otherwise `NULL`
@@ -20,9 +20,14 @@ extern "C"
 {
 #endif
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include "rosidl_generator_c/message_type_support_struct.h"
 
+#include "rcl/guard_condition.h"
 #include "rcl/macros.h"
+#include "rcl/statistics.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
 
@@ -43,6 +48,55 @@ typedef struct rcl_publisher_options_t
   /// Custom allocator for the publisher, used for incidental allocations.
   /** For default behavior (malloc/free), use: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// If true, deliver to same-process subscriptions without crossing rmw.
+  /**
+   * Subscriptions in this process which also set use_intra_process and
+   * match this publisher's expanded topic name receive the message pointer
+   * given to rcl_publish() directly; everyone else is still served through
+   * the middleware.  The application must keep the published message valid
+   * for as long as same-process subscriptions may read it.
+   */
+  bool use_intra_process;
+  /// Number of messages to preallocate storage for; 0 disables the pool.
+  /**
+   * With a pool configured, rcl_publisher_init() preallocates
+   * message_pool_size slots of message_pool_message_bound bytes with the
+   * publisher's allocator, and rcl_publisher_acquire_pool_message() hands
+   * them out without touching the allocator on the hot path.
+   */
+  size_t message_pool_size;
+  /// Upper bound, in bytes, of one message's in-memory size.
+  /** Must be non-zero when message_pool_size is non-zero; sizing it is the
+   * application's responsibility (only bounded message types qualify). */
+  size_t message_pool_message_bound;
+  /// If true, keep hot path statistics for this publisher.
+  /**
+   * The counters are updated with relaxed atomics on every publish and read
+   * back with rcl_publisher_get_statistics().
+   * The default is false.
+   */
+  bool enable_statistics;
+  /// Upper bound, in bytes, of one message's serialized size; 0 if unknown.
+  /**
+   * For bounded message types the serialized size has a fixed maximum.
+   * Declaring it here makes rcl_publisher_init() preallocate a persistent
+   * serialization buffer of that capacity, so
+   * rcl_publish_as_serialized_message() never touches the allocator.
+   * Sizing it is the application's responsibility; a bound that turns out
+   * too small only costs a one-time buffer growth on first use.
+   * The default is 0, which defers buffer growth to the first publishes.
+   */
+  size_t max_serialized_size;
+  /// If true, the application promises to publish from one thread at a time.
+  /**
+   * With the promise made, rcl skips the read-modify-write synchronization
+   * on the hot path statistics counters (plain updates replace the atomic
+   * increments; reading the statistics from other threads stays safe).
+   * Publishing through a single threaded publisher from two threads at once
+   * is undefined behavior; see the concurrency contract on rcl_publish().
+   * The default is false.
+   */
+  bool single_threaded;
 } rcl_publisher_options_t;
 
 /// Return a rcl_publisher_t struct with members set to `NULL`.
@@ -181,6 +235,39 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node);
 
+/// Finalize a publisher, deferring the middleware destruction.
+/**
+ * Behaves like rcl_publisher_fini(), except that the rmw publisher is not
+ * destroyed inline; it is parked on the publisher's context and destroyed by
+ * a later rcl_context_reclaim().
+ * The rmw destroy functions can block on middleware locks, so this keeps
+ * finalizing many publishers from stalling latency sensitive threads.
+ *
+ * The node and context must stay valid until the handle is reclaimed; the
+ * context drains any not yet reclaimed handles when it is finalized.
+ * If the handle cannot be queued the middleware destruction happens inline,
+ * as in rcl_publisher_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher handle to the publisher to be finalized
+ * \param[in] node handle to the node used to create the publisher
+ * \return `RCL_RET_OK` if publisher was finalized successfully, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_fini_deferred(rcl_publisher_t * publisher, rcl_node_t * node);
+
 /// Return the default publisher options in a rcl_publisher_options_t.
 /**
  * The defaults are:
@@ -233,14 +320,31 @@ rcl_publisher_get_default_options(void);
  * rcl_publish() simultaneously, even if the publishers differ.
  * The `ros_message` is unmodified by rcl_publish().
  *
+ * The concurrency contract for one publisher is:
+ *
+ * - Distinct publishers may always publish concurrently; rcl shares no
+ *   mutable publish state between them.
+ * - Concurrent rcl_publish() calls on the same publisher take no locks on
+ *   the rcl side: the statistics counters are multi-producer safe relaxed
+ *   atomics, so rcl itself is lock free and multi-producer capable.
+ *   Whether the middleware below synchronizes, and at what cost, is rmw
+ *   implementation defined.
+ * - Publishers with the use_intra_process option are the exception: the
+ *   intra-process fast path is single producer, so at most one thread may
+ *   publish through such a publisher at a time.
+ * - Publishers initialized with the single_threaded option promise at most
+ *   one publishing thread, and in exchange the statistics counters are
+ *   updated without read-modify-write synchronization.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
  * Thread-Safe        | Yes [1]
- * Uses Atomics       | No
+ * Uses Atomics       | Maybe [2]
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of publishers and messages, see above for more</i>
+ * <i>[2] for the statistics counters when statistics are enabled</i>
  *
  * \param[in] publisher handle to the publisher which will do the publishing
  * \param[in] ros_message type-erased pointer to the ROS message
@@ -254,6 +358,161 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_publish(const rcl_publisher_t * publisher, const void * ros_message);
 
+/// Publish a batch of messages on a topic using a publisher.
+/**
+ * This is equivalent to calling rcl_publish() once per message, but the
+ * publisher and arguments are validated only once for the whole batch,
+ * which reduces the per-message overhead when publishing bursts of many
+ * small messages.
+ *
+ * All messages must be non-null and of the type the publisher was
+ * initialized with.
+ * The messages are handed to the middleware in array order; middlewares
+ * without native batch support receive them as individual publishes.
+ * If publishing fails part way through, the messages before the failing one
+ * have already been handed to the middleware.
+ *
+ * \see rcl_publish() for the ownership, thread-safety, and blocking
+ *   caveats that apply to each message in the batch.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Maybe [2]
+ * <i>[1] for unique pairs of publishers and messages, see rcl_publish()</i>
+ * <i>[2] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] ros_messages array of pointers to properly initialized ROS messages
+ * \param[in] count number of messages in the array
+ * \return `RCL_RET_OK` if all messages were published successfully, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_batch(
+  const rcl_publisher_t * publisher, const void ** ros_messages, size_t count);
+
+/// Structure which encapsulates a fixed group of publishers published together.
+typedef struct rcl_publisher_bundle_t
+{
+  struct rcl_publisher_bundle_impl_t * impl;
+} rcl_publisher_bundle_t;
+
+/// Return a rcl_publisher_bundle_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_publisher_bundle_t
+rcl_get_zero_initialized_publisher_bundle(void);
+
+/// Initialize a publisher bundle from existing publishers.
+/**
+ * A bundle groups publishers whose topics are always published together,
+ * e.g. the related topics of one control tick, so that one
+ * rcl_publish_bundle() call replaces a separate validated rcl_publish()
+ * per topic.
+ * Every publisher is validated here, once, instead of on every publish.
+ *
+ * The bundle stores the publisher handles, not copies; each publisher must
+ * remain valid and unfinalized for the lifetime of the bundle.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher_bundle preallocated, zero-initialized, bundle to initialize
+ * \param[in] publishers array of pointers to valid publishers
+ * \param[in] number_of_publishers non-zero length of the `publishers` array
+ * \param[in] allocator a valid allocator for the bundle's bookkeeping
+ * \return `RCL_RET_OK` if the bundle was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the bundle is already initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if any publisher is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_bundle_init(
+  rcl_publisher_bundle_t * publisher_bundle,
+  const rcl_publisher_t ** publishers,
+  size_t number_of_publishers,
+  const rcl_allocator_t * allocator);
+
+/// Finalize a rcl_publisher_bundle_t.
+/**
+ * Releases the bundle's bookkeeping only; the member publishers are not
+ * finalized and stay usable.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] publisher_bundle handle to the bundle to be finalized
+ * \return `RCL_RET_OK` if the bundle was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_bundle_fini(rcl_publisher_bundle_t * publisher_bundle);
+
+/// Publish one message per bundle member in a single validated call.
+/**
+ * `ros_messages` holds one properly initialized message per member, in the
+ * order the publishers were given to rcl_publisher_bundle_init(), each of
+ * the type its publisher was initialized with.
+ * The bundle and message array are validated once and the messages are
+ * then handed to the middleware back to back, skipping the per-call
+ * validation a separate rcl_publish() per topic would repeat.
+ *
+ * The submissions are batched, not atomic: subscribers may observe some of
+ * the messages before the rest, and if publishing fails part way through,
+ * the messages before the failing member have already been handed to the
+ * middleware.
+ *
+ * \see rcl_publish() for the ownership, thread-safety, and blocking
+ *   caveats that apply to each message published.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Maybe [2]
+ * Lock-Free          | Maybe [2]
+ * <i>[1] for unique pairs of bundles and messages, see rcl_publish()</i>
+ * <i>[2] rmw implementation defined</i>
+ *
+ * \param[in] publisher_bundle handle to the bundle which will do the publishing
+ * \param[in] ros_messages array of one message pointer per bundle member
+ * \return `RCL_RET_OK` if all messages were published successfully, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the bundle is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_bundle(
+  const rcl_publisher_bundle_t * publisher_bundle, const void ** ros_messages);
+
 /// Publish a serialized message on a topic using a publisher.
 /**
  * It is the job of the caller to ensure that the type of the serialized message
@@ -277,6 +536,10 @@ rcl_publish(const rcl_publisher_t * publisher, const void * ros_message);
  * Lock-Free          | Yes
  * <i>[1] for unique pairs of publishers and messages, see above for more</i>
  *
+ * The serialized message is only read, never modified or freed, so its
+ * buffer may live in read-only memory, for example a memory mapped bag
+ * file, as long as it stays mapped for the duration of the call.
+ *
  * \param[in] publisher handle to the publisher which will do the publishing
  * \param[in] serialized_message  pointer to the already serialized message in raw form
  * \return `RCL_RET_OK` if the message was published successfully, or
@@ -290,6 +553,265 @@ rcl_ret_t
 rcl_publish_serialized_message(
   const rcl_publisher_t * publisher, const rcl_serialized_message_t * serialized_message);
 
+/// One fragment of a serialized message, given to
+/// rcl_publish_serialized_message_fragments().
+typedef struct rcl_serialized_message_fragment_t
+{
+  /// Start of the fragment's bytes; may point into read-only memory.
+  const uint8_t * data;
+  /// Number of bytes in the fragment.
+  size_t length;
+} rcl_serialized_message_fragment_t;
+
+/// Publish a serialized message given as a list of fragments.
+/**
+ * The fragments, concatenated in order, must form the same byte stream
+ * that rcl_publish_serialized_message() would be given; the same caveats
+ * about matching the publisher's registered type apply.
+ *
+ * A single fragment is published directly out of the caller's memory with
+ * no copy, like rcl_publish_serialized_message(); the caller does not need
+ * to assemble a contiguous rcl_serialized_message_t first.  Multiple
+ * fragments are gathered into the publisher's persistent serialization
+ * buffer with one memcpy each, so a reader replaying records from a memory
+ * mapped file avoids the extra staging copy into a caller-side buffer.
+ * The gather allocates only when the total length exceeds the buffer's
+ * capacity; size the `max_serialized_size` publisher option to the largest
+ * record to avoid that entirely.
+ *
+ * The fragment bytes are only read, so they may live in read-only memory.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No [2]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if gathering exceeds the persistent buffer's capacity</i>
+ * <i>[2] the persistent serialization buffer is shared per publisher</i>
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] fragments array of fragments forming the serialized message
+ * \param[in] fragment_count number of fragments, must be at least one
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if growing the gather buffer failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_serialized_message_fragments(
+  const rcl_publisher_t * publisher,
+  const rcl_serialized_message_fragment_t * fragments,
+  size_t fragment_count);
+
+/// Serialize a ROS message into the publisher's buffer and publish it.
+/**
+ * The message is serialized into a buffer owned by the publisher and then
+ * published as with rcl_publish_serialized_message().
+ * The buffer persists across calls; with max_serialized_size declared in
+ * the publisher options it is preallocated at init, making this call
+ * allocation-free for bounded types.
+ * Without the option the buffer grows on the first calls with the
+ * publisher's allocator and is reused after that.
+ *
+ * Unlike rcl_publish(), concurrent calls on the same publisher are not
+ * safe, since they share the serialization buffer.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] if the buffer capacity already fits the message, see above</i>
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] ros_message pointer to the properly initialized ROS message
+ * \return `RCL_RET_OK` if the message was published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_as_serialized_message(
+  const rcl_publisher_t * publisher, const void * ros_message);
+
+/// Borrow a loaned message owned by the middleware.
+/**
+ * Shared-memory capable middlewares can hand out a message allocated in
+ * their own buffers; filling it in place and publishing it with
+ * rcl_publish_loaned_message() avoids copying the user struct into the
+ * middleware, enabling true zero-copy for large messages.
+ *
+ * The returned message is owned by the middleware until it is published or
+ * given back with rcl_return_loaned_message_from_publisher().
+ * Use rcl_publisher_can_loan_messages() to check for support before relying
+ * on this; without middleware support `RCL_RET_UNSUPPORTED` is returned and
+ * callers should fall back to rcl_publish().
+ *
+ * The rmw interface in use by this version has no loaning entry points, so
+ * this currently always reports `RCL_RET_UNSUPPORTED`; the API is provided
+ * so applications can be written against it and light up automatically once
+ * the middleware gains support.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher which will publish the message
+ * \param[in] type_support type support of the message to be borrowed
+ * \param[out] ros_message where to store the pointer to the loaned message
+ * \return `RCL_RET_OK` if a message was borrowed, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot loan messages, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_borrow_loaned_message(
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message);
+
+/// Return a borrowed message to the middleware without publishing it.
+/**
+ * \see rcl_borrow_loaned_message()
+ *
+ * \param[in] publisher handle to the publisher the message was borrowed from
+ * \param[in] loaned_message the message to give back to the middleware
+ * \return `RCL_RET_OK` if the message was returned, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot loan messages, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_message_from_publisher(
+  const rcl_publisher_t * publisher,
+  void * loaned_message);
+
+/// Publish a message borrowed with rcl_borrow_loaned_message().
+/**
+ * Ownership of the message passes back to the middleware; the caller must
+ * not access it after this call, and must not return it separately.
+ *
+ * \see rcl_borrow_loaned_message()
+ *
+ * \param[in] publisher handle to the publisher which will do the publishing
+ * \param[in] ros_message the loaned message to publish
+ * \return `RCL_RET_OK` if the message was published, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot loan messages, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publish_loaned_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message);
+
+/// Check if the publisher's middleware can loan messages.
+/**
+ * Returns false if the publisher is invalid (error set) or if the
+ * middleware in use does not support message loaning.
+ *
+ * \param[in] publisher handle to the publisher to check
+ * \return true if the middleware can loan messages, otherwise false
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+bool
+rcl_publisher_can_loan_messages(const rcl_publisher_t * publisher);
+
+/// Acquire preallocated message storage from the publisher's pool.
+/**
+ * Pops one slot from the pool configured via the message_pool_size and
+ * message_pool_message_bound publisher options; no allocator is involved.
+ * The slot is zeroed when the pool is created, not on each acquire; the
+ * caller is responsible for initializing the message in it and for giving
+ * the slot back with rcl_publisher_release_pool_message() when the message
+ * is no longer in flight.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] publisher handle to the publisher with a configured pool
+ * \param[out] message_storage where to store the pointer to the slot
+ * \return `RCL_RET_OK` if a slot was acquired, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the publisher has no pool configured, or
+ * \return `RCL_RET_BAD_ALLOC` if the pool is exhausted.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_acquire_pool_message(
+  const rcl_publisher_t * publisher,
+  void ** message_storage);
+
+/// Release message storage back to the publisher's pool.
+/**
+ * \see rcl_publisher_acquire_pool_message()
+ *
+ * \param[in] publisher handle to the publisher the slot was acquired from
+ * \param[in] message_storage the slot to give back
+ * \return `RCL_RET_OK` if the slot was released, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the publisher has no pool configured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_release_pool_message(
+  const rcl_publisher_t * publisher,
+  void * message_storage);
+
+/// Get a snapshot of the publisher's hot path statistics.
+/**
+ * Only valid on publishers whose options had `enable_statistics` set; on
+ * others this fails with `RCL_RET_UNSUPPORTED`.
+ * Successful publishes count as succeeded operations, failed publishes as
+ * failed ones.
+ *
+ * \param[in] publisher pointer to the rcl publisher
+ * \param[out] statistics filled with the current counts
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the publisher does not keep statistics.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_get_statistics(
+  const rcl_publisher_t * publisher,
+  rcl_statistics_t * statistics);
+
 /// Get the topic name for the publisher.
 /**
  * This function returns the publisher's internal topic name string.
@@ -465,6 +987,93 @@ rcl_publisher_get_subscription_count(
   const rcl_publisher_t * publisher,
   size_t * subscription_count);
 
+/// Block until all reliable subscribers acknowledged every published message.
+/**
+ * Intended for shutdown flushes and synchronous command barriers, where the
+ * caller must not continue until everything published so far has reached its
+ * reliable subscribers, and where sleeping a fixed interval in a loop wastes
+ * milliseconds per flush.
+ *
+ * Returns immediately with `RCL_RET_OK` when there is nothing to wait for:
+ * the publisher's reliability QoS is best effort, so no acknowledgments
+ * exist, or no subscriptions are currently matched.
+ *
+ * The rmw interface in use by this version has no entry point for observing
+ * acknowledgments, so with matched reliable subscribers this currently
+ * always reports `RCL_RET_UNSUPPORTED` and callers should fall back to their
+ * own settling delay; the API is provided so applications can be written
+ * against it and block exactly as long as the network requires once the
+ * middleware gains support.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher whose messages must be acked
+ * \param[in] timeout maximum time to wait in nanoseconds; negative blocks
+ *   indefinitely and `0` only checks without blocking
+ * \return `RCL_RET_OK` if all published messages were acknowledged, or
+ * \return `RCL_RET_TIMEOUT` if the timeout expired first, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot report
+ *   acknowledgments, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_wait_for_all_acked(
+  const rcl_publisher_t * publisher,
+  int64_t timeout);
+
+/// Trigger a guard condition once all published messages are acknowledged.
+/**
+ * Asynchronous variant of rcl_publisher_wait_for_all_acked(): instead of
+ * blocking, the given guard condition is triggered when every message
+ * published so far has been acknowledged by all matched reliable
+ * subscribers, so the caller can fold the flush into an existing
+ * rcl_wait() loop.
+ *
+ * When there is nothing to wait for (best effort reliability QoS or no
+ * matched subscriptions) the guard condition is triggered before this
+ * call returns.
+ *
+ * The rmw interface in use by this version has no entry point for observing
+ * acknowledgments, so with matched reliable subscribers this currently
+ * always reports `RCL_RET_UNSUPPORTED`; see
+ * rcl_publisher_wait_for_all_acked().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] publisher handle to the publisher whose messages must be acked
+ * \param[in] guard_condition guard condition to trigger once all
+ *   acknowledgments arrived
+ * \return `RCL_RET_OK` if the notification was armed or already fired, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_PUBLISHER_INVALID` if the publisher is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot report
+ *   acknowledgments, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_publisher_notify_on_all_acked(
+  const rcl_publisher_t * publisher,
+  rcl_guard_condition_t * guard_condition);
+
 #ifdef __cplusplus
 }
 #endif
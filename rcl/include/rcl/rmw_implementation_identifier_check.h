@@ -0,0 +1,51 @@
+// Copyright 2016 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
+#define RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/macros.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Check that the rmw implementation matches what the environment asked for.
+/**
+ * If the RMW_IMPLEMENTATION or RCL_ASSERT_RMW_ID_MATCHES environment
+ * variables are set, the linked rmw implementation's identifier must match
+ * them.
+ *
+ * The verdict is computed once per process and cached, so after the first
+ * call (which happens automatically during library initialization) this is
+ * just an atomic load and can be called on hot restart paths like rcl_init().
+ *
+ * \return `RCL_RET_OK` if the identifier matches or no match was asked for, or
+ * \return `RCL_RET_MISMATCHED_RMW_ID` if the identifier does not match, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_rmw_implementation_identifier_check(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__RMW_IMPLEMENTATION_IDENTIFIER_CHECK_H_
@@ -22,7 +22,9 @@ extern "C"
 
 #include "rosidl_generator_c/service_type_support_struct.h"
 
+#include "rcl/event_callback.h"
 #include "rcl/macros.h"
+#include "rcl/statistics.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
 
@@ -43,6 +45,22 @@ typedef struct rcl_service_options_t
   /// Custom allocator for the service, used for incidental allocations.
   /** For default behavior (malloc/free), see: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// If true, keep hot path statistics for this service.
+  /**
+   * The counters are updated with relaxed atomics on every take and send and
+   * read back with rcl_service_get_statistics().
+   * The default is false.
+   */
+  bool enable_statistics;
+  /// Dispatch priority of the service within a wait set.
+  /**
+   * When the service is ready, its entry in the compact ready entity list
+   * (see rcl_wait_set_get_ready_entities()) is placed before entities with a
+   * lower priority, so executors can dispatch urgent services first without
+   * sorting after every wake up.
+   * The default is 0.
+   */
+  uint8_t priority;
 } rcl_service_options_t;
 
 /// Return a rcl_service_t struct with members set to `NULL`.
@@ -185,6 +203,37 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_service_fini(rcl_service_t * service, rcl_node_t * node);
 
+/// Finalize a service, deferring the middleware destruction.
+/**
+ * Behaves like rcl_service_fini(), except that the rmw service is not
+ * destroyed inline; it is parked on the service's context and destroyed by
+ * a later rcl_context_reclaim().
+ *
+ * The node and context must stay valid until the handle is reclaimed; the
+ * context drains any not yet reclaimed handles when it is finalized.
+ * If the handle cannot be queued the middleware destruction happens inline,
+ * as in rcl_service_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] service handle to the service to be finalized
+ * \param[in] node handle to the node used to create the service
+ * \return `RCL_RET_OK` if service was finalized successfully, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_fini_deferred(rcl_service_t * service, rcl_node_t * node);
+
 /// Return the default service options in a rcl_service_options_t.
 /**
  * The defaults are:
@@ -250,6 +299,94 @@ rcl_take_request(
   rmw_request_id_t * request_header,
   void * ros_request);
 
+/// Take a pending request in its serialized form using a rcl service.
+/**
+ * In contrast to rcl_take_request(), this function stores the taken request
+ * in its raw binary representation, so bridges and recorders can forward
+ * service traffic without a deserialize/reserialize cycle, analogous to
+ * rcl_take_serialized_message() on a subscription.
+ *
+ * The rmw interface in use must support taking serialized requests; with one
+ * that does not, this function fails with `RCL_RET_UNSUPPORTED`.
+ *
+ * \param[in] service the handle to the service from which to take
+ * \param[inout] request_header ptr to the struct holding metadata about the request ID
+ * \param[inout] serialized_request pointer to a (pre-allocated) serialized message
+ * 
+eturn `RCL_RET_OK` if the request was taken, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * 
+eturn `RCL_RET_UNSUPPORTED` if the rmw interface in use cannot take
+ *   serialized requests, or
+ * 
+eturn `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * 
+eturn `RCL_RET_SERVICE_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * 
+eturn `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_request_serialized(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_header,
+  rcl_serialized_message_t * serialized_request);
+
+/// Take up to `capacity` pending ROS requests using a rcl service.
+/**
+ * This behaves like calling rcl_take_request() in a loop, but validates the
+ * service and its arguments only once, which matters for services that see
+ * thousands of requests per second.
+ * Requests are written to `ros_requests[0]` through `ros_requests[*taken - 1]`
+ * with their headers in the corresponding slots of `request_headers`; the loop
+ * stops when `capacity` requests were taken or no request was pending.
+ * Taking zero requests is not an error; `*taken` is just zero then.
+ *
+ * Every element of `ros_requests` must point to an already allocated ROS
+ * request message struct of the correct type, and `request_headers` must have
+ * room for `capacity` headers.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling a request, avoided for fixed sizes</i>
+ *
+ * \param[in] service the handle to the service from which to take
+ * \param[inout] request_headers array of `capacity` structs for request metadata
+ * \param[inout] ros_requests array of `capacity` type-erased ptrs to allocated
+ *   ROS request messages
+ * \param[in] capacity maximum number of requests to take
+ * \param[out] taken set to the number of requests actually taken
+ * 
+eturn `RCL_RET_OK` if up to `capacity` requests were taken, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * 
+eturn `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * 
+eturn `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_request_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_headers,
+  void ** ros_requests,
+  size_t capacity,
+  size_t * taken);
+
 /// Send a ROS response to a client using a service.
 /**
  * It is the job of the caller to ensure that the type of the `ros_response`
@@ -303,6 +440,101 @@ rcl_send_response(
   rmw_request_id_t * response_header,
   void * ros_response);
 
+/// Send `count` ROS responses to clients using a service.
+/**
+ * This behaves like calling rcl_send_response() once per response, but
+ * validates the service and its arguments only once, pairing with
+ * rcl_take_request_batch() for high rate service loops.
+ * `response_headers[i]` must be the request header taken with response
+ * `ros_responses[i]`'s request.
+ * Responses are sent in order; if sending one fails, the ones before it have
+ * already been sent and the error refers to the failed one.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] for unique pairs of services and responses, see rcl_send_response()</i>
+ *
+ * \param[in] service handle to the service which will make the responses
+ * \param[inout] response_headers array of `count` structs with request metadata
+ * \param[in] ros_responses array of `count` type-erased ptrs to ROS response
+ *   messages
+ * \param[in] count number of responses to send
+ * 
+eturn `RCL_RET_OK` if all responses were sent successfully, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * 
+eturn `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_response_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_headers,
+  void ** ros_responses,
+  size_t count);
+
+/// Send an already serialized response to a client using a service.
+/**
+ * This is the serialized counterpart of rcl_send_response(); the response is
+ * passed through as a raw binary blob, matching the service type's wire
+ * representation.
+ *
+ * The rmw interface in use must support sending serialized responses; with
+ * one that does not, this function fails with `RCL_RET_UNSUPPORTED`.
+ *
+ * \param[in] service handle to the service which will make the response
+ * \param[inout] response_header ptr to the struct holding metadata about the request ID
+ * \param[in] serialized_response pointer to the serialized response message
+ * 
+eturn `RCL_RET_OK` if the response was sent successfully, or
+ * 
+eturn `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * 
+eturn `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * 
+eturn `RCL_RET_UNSUPPORTED` if the rmw interface in use cannot send
+ *   serialized responses, or
+ * 
+eturn `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_send_response_serialized(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_header,
+  const rcl_serialized_message_t * serialized_response);
+
+/// Get a snapshot of the service's hot path statistics.
+/**
+ * Only valid on services whose options had `enable_statistics` set; on
+ * others this fails with `RCL_RET_UNSUPPORTED`.
+ * Taken requests and sent responses count as succeeded operations; failed
+ * takes and sends, including takes with nothing pending, as failed ones.
+ *
+ * \param[in] service pointer to the rcl service
+ * \param[out] statistics filled with the current counts
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SERVICE_INVALID` if the service is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the service does not keep statistics.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_get_statistics(
+  const rcl_service_t * service,
+  rcl_statistics_t * statistics);
+
 /// Get the topic name for the service.
 /**
  * This function returns the service's internal topic name string.
@@ -410,6 +642,19 @@ RCL_PUBLIC
 bool
 rcl_service_is_valid(const rcl_service_t * service);
 
+/// Set a callback to be invoked when the service has new requests.
+/**
+ * This function behaves exactly the same as for subscription messages.
+ * \see rcl_subscription_set_on_new_message_callback
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_service_set_on_new_request_callback(
+  const rcl_service_t * service,
+  rcl_event_callback_t callback,
+  const void * user_data);
+
 #ifdef __cplusplus
 }
 #endif
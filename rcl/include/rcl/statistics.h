@@ -0,0 +1,49 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__STATISTICS_H_
+#define RCL__STATISTICS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcl/time.h"
+
+/// A snapshot of the hot path activity of one rcl entity.
+/**
+ * Publishers, subscriptions, services, and clients that opt in with the
+ * `enable_statistics` field of their options keep these counts up to date on
+ * every publish/take, so monitoring infrastructure does not need to wrap and
+ * instrument the call sites itself.
+ * A snapshot is retrieved with the entity's rcl_*_get_statistics() function.
+ */
+typedef struct rcl_statistics_t
+{
+  /// Number of operations that succeeded, e.g. publishes or takes.
+  uint64_t succeeded_count;
+  /// Number of operations that failed, including takes with nothing pending.
+  uint64_t failed_count;
+  /// Steady clock time of the last successful operation, 0 if none yet.
+  rcl_time_point_value_t last_activity_time;
+} rcl_statistics_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__STATISTICS_H_
@@ -22,13 +22,26 @@ extern "C"
 
 #include "rosidl_generator_c/message_type_support_struct.h"
 
+#include "rcl/event_callback.h"
+#include "rcl/guard_condition.h"
 #include "rcl/macros.h"
+#include "rcl/statistics.h"
 #include "rcl/node.h"
 #include "rcl/visibility_control.h"
 
 /// Internal rcl implementation struct.
 struct rcl_subscription_impl_t;
 
+/// Signature of a subscription content filter.
+/**
+ * Called with a message taken from the middleware and the context pointer
+ * from the subscription options; return true to deliver the message to the
+ * caller and false to drop it.
+ * The filter must not keep a reference to the message past the call.
+ */
+typedef bool (* rcl_subscription_filter_fn_t)(
+  const void * ros_message, void * context);
+
 /// Structure which encapsulates a ROS Subscription.
 typedef struct rcl_subscription_t
 {
@@ -45,8 +58,67 @@ typedef struct rcl_subscription_options_t
   /// Custom allocator for the subscription, used for incidental allocations.
   /** For default behavior (malloc/free), see: rcl_get_default_allocator() */
   rcl_allocator_t allocator;
+  /// If true, receive messages from same-process publishers without rmw.
+  /**
+   * Publishers in this process which also set use_intra_process and match
+   * this subscription's expanded topic name move message pointers through a
+   * per-subscription ring instead of the middleware; combine with
+   * ignore_local_publications to avoid receiving those messages twice.
+   * See rcl_take_intra_process().
+   */
+  bool use_intra_process;
+  /// Capacity of the intra-process pointer ring; 0 means the default.
+  /** See RCL_INTRA_PROCESS_BUFFER_SIZE_DEFAULT; ignored unless
+   * use_intra_process is true. */
+  size_t intra_process_buffer_size;
+  /// Number of messages to preallocate storage for; 0 disables the pool.
+  /**
+   * With a pool configured, rcl_subscription_init() preallocates
+   * message_pool_size slots of message_pool_message_bound bytes with the
+   * subscription's allocator, and rcl_subscription_acquire_pool_message()
+   * hands them out without touching the allocator on the hot path.
+   */
+  size_t message_pool_size;
+  /// Upper bound, in bytes, of one message's in-memory size.
+  /** Must be non-zero when message_pool_size is non-zero; sizing it is the
+   * application's responsibility (only bounded message types qualify). */
+  size_t message_pool_message_bound;
+  /// If true, keep hot path statistics for this subscription.
+  /**
+   * The counters are updated with relaxed atomics on every take and read
+   * back with rcl_subscription_get_statistics().
+   * The default is false.
+   */
+  bool enable_statistics;
+  /// Dispatch priority of the subscription within a wait set.
+  /**
+   * When the subscription is ready, its entry in the compact ready entity
+   * list (see rcl_wait_set_get_ready_entities()) is placed before entities
+   * with a lower priority, so executors can dispatch urgent topics first
+   * without sorting after every wake up.
+   * The default is 0.
+   */
+  uint8_t priority;
+  /// Content filter applied to messages before they reach the caller.
+  /**
+   * Messages the filter rejects are dropped inside rcl_take() and
+   * rcl_take_batch(), which keep taking until the filter accepts a message
+   * or the middleware runs dry, so irrelevant traffic never reaches the
+   * caller.
+   * The current rmw API offers no way to push the filter into the
+   * middleware; once it does, rcl will forward it there and this becomes
+   * the fallback for middlewares without native support.
+   * Serialized takes are not filtered.
+   * The default is NULL, which delivers every message.
+   */
+  rcl_subscription_filter_fn_t content_filter;
+  /// Opaque pointer passed to every content_filter invocation.
+  void * content_filter_context;
 } rcl_subscription_options_t;
 
+/// Default capacity of the intra-process pointer ring of a subscription.
+#define RCL_INTRA_PROCESS_BUFFER_SIZE_DEFAULT 16
+
 /// Return a rcl_subscription_t struct with members set to `NULL`.
 /**
  * Should be called to get a null rcl_subscription_t before passing to
@@ -186,6 +258,40 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node);
 
+/// Finalize a subscription, deferring the middleware destruction.
+/**
+ * Behaves like rcl_subscription_fini(), except that the rmw subscription is
+ * not destroyed inline; it is parked on the subscription's context and
+ * destroyed by a later rcl_context_reclaim().
+ * All rcl-side state, including the intra-process fast path registration,
+ * is torn down before returning, so the subscription no longer receives
+ * messages or wakes wait sets.
+ *
+ * The node and context must stay valid until the handle is reclaimed; the
+ * context drains any not yet reclaimed handles when it is finalized.
+ * If the handle cannot be queued the middleware destruction happens inline,
+ * as in rcl_subscription_fini().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[inout] subscription handle to the subscription to be finalized
+ * \param[in] node handle to the node used to create the subscription
+ * \return `RCL_RET_OK` if subscription was finalized successfully, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_NODE_INVALID` if the node is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_fini_deferred(rcl_subscription_t * subscription, rcl_node_t * node);
+
 /// Return the default subscription options in a rcl_subscription_options_t.
 /**
  * The defaults are:
@@ -227,7 +333,10 @@ rcl_subscription_get_default_options(void);
  * process.
  * The message_info argument should be an already allocated rmw_message_info_t
  * structure.
- * Passing `NULL` for message_info will result in the argument being ignored.
+ * Passing `NULL` for message_info will result in the argument being ignored,
+ * and lets the take skip populating the meta information entirely, which
+ * avoids the cost of copying the publisher gid for callers that never read
+ * it.
  *
  * <hr>
  * Attribute          | Adherence
@@ -257,6 +366,121 @@ rcl_take(
   void * ros_message,
   rmw_message_info_t * message_info);
 
+/// Take a batch of messages from a topic using a rcl subscription.
+/**
+ * This is equivalent to calling rcl_take() repeatedly until it reports that
+ * nothing was taken, except that the subscription is validated only once and
+ * up to `capacity` messages are drained in one call, which amortizes the
+ * per-call overhead when catching up on a deep QoS history.
+ *
+ * All `capacity` entries of `ros_messages` must point to properly allocated
+ * messages of the subscribed type; the first `*taken` of them are filled in.
+ * If `message_infos` is not `NULL` it must have room for `capacity` entries,
+ * and entry i is populated for message i.
+ *
+ * \see rcl_take() for the ownership and thread-safety caveats that apply to
+ *   each message in the batch.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] only if required when filling a message, avoided if possible</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[inout] ros_messages array of pointers to allocated messages to fill
+ * \param[in] capacity number of messages in the array
+ * \param[out] taken how many messages were actually taken
+ * \param[out] message_infos array for message metadata, may be `NULL`
+ * \return `RCL_RET_OK` if one or more messages were taken, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no messages were available, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_batch(
+  const rcl_subscription_t * subscription,
+  void ** ros_messages,
+  size_t capacity,
+  size_t * taken,
+  rmw_message_info_t * message_infos);
+
+/// Signature of the per-message callback of rcl_subscription_drain().
+/**
+ * Called once for every message taken during the drain with the scratch
+ * message, the message metadata (`NULL` if the caller passed no scratch
+ * info struct) and the context pointer given to rcl_subscription_drain();
+ * return true to keep draining and false to stop early.
+ * The scratch message is reused for the next take as soon as the callback
+ * returns, so the callback must not keep a reference to it past the call.
+ */
+typedef bool (* rcl_subscription_drain_callback_t)(
+  const void * ros_message, const rmw_message_info_t * message_info, void * context);
+
+/// Drain queued messages from a topic through a callback.
+/**
+ * This is equivalent to calling rcl_take() in a loop and handing each message
+ * to `callback`, except that the subscription is validated only once and the
+ * loop runs inside rcl, so one call services an entire burst instead of
+ * paying the per-call overhead once per message.
+ *
+ * Unlike rcl_take_batch() no array of messages is needed: `ros_message` is a
+ * single properly allocated message of the subscribed type which is reused
+ * as scratch storage for every take, and the callback consumes each message
+ * before the next one overwrites it.
+ * If `message_info` is not `NULL` it is populated before each callback
+ * invocation and passed along; otherwise the callback receives `NULL` and
+ * the middleware can skip gathering the metadata.
+ *
+ * The drain stops when the middleware runs dry, when `max_messages` messages
+ * have been delivered (0 means no limit), or when the callback returns
+ * false; `*taken` reports how many messages reached the callback either way.
+ * Messages rejected by the content filter of the subscription options are
+ * dropped without invoking the callback and do not count against
+ * `max_messages`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] only if required when filling a message, avoided if possible</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[inout] ros_message allocated message reused as scratch for each take
+ * \param[inout] message_info scratch for message metadata, may be `NULL`
+ * \param[in] max_messages most messages to deliver, 0 for no limit
+ * \param[in] callback invoked once per taken message
+ * \param[in] context opaque pointer passed to every callback invocation
+ * \param[out] taken how many messages were delivered to the callback
+ * \return `RCL_RET_OK` if one or more messages were taken, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no messages were available, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_drain(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  size_t max_messages,
+  rcl_subscription_drain_callback_t callback,
+  void * context,
+  size_t * taken);
+
 /// Take a serialized raw message from a topic using a rcl subscription.
 /**
  * In contrast to `rcl_take`, this function stores the taken message in
@@ -300,6 +524,283 @@ rcl_take_serialized_message(
   rcl_serialized_message_t * serialized_message,
   rmw_message_info_t * message_info);
 
+/// Get the suggested preallocation size for serialized message buffers.
+/**
+ * Returns the size of the largest serialized message taken through this
+ * subscription so far, i.e. the high-water mark of
+ * rcl_take_serialized_message().
+ * Preallocating caller-owned buffers to this size avoids growth reallocations
+ * on subsequent takes; newly acquired buffers from
+ * rcl_subscription_acquire_serialized_message() are already sized to it.
+ * Returns `0` if no serialized message was taken yet, or, with an error set,
+ * if the subscription is invalid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] subscription handle to the subscription
+ * \return size in bytes of the largest serialized message taken so far
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+size_t
+rcl_subscription_get_suggested_buffer_size(const rcl_subscription_t * subscription);
+
+/// Acquire a recycled serialized message buffer from the subscription.
+/**
+ * Pops a previously released buffer, or, when none is available, allocates a
+ * new one with capacity for the largest serialized message taken so far (see
+ * rcl_subscription_get_suggested_buffer_size()).
+ * Once the working set of buffers is warm, acquiring, taking into, and
+ * releasing buffers does no allocation at all, which keeps steady-state
+ * recording of serialized messages allocation free.
+ *
+ * The buffer stays owned by the subscription: give it back with
+ * rcl_subscription_release_serialized_message() when done, and do not
+ * finalize it with rcutils_uint8_array_fini().
+ * Buffers not released before rcl_subscription_fini() are leaked.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when no released buffer is available</i>
+ *
+ * \param[in] subscription handle to the subscription
+ * \param[out] serialized_message where to store the pointer to the buffer
+ * \return `RCL_RET_OK` if a buffer was acquired, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating a new buffer failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_acquire_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t ** serialized_message);
+
+/// Release a serialized message buffer back to the subscription.
+/**
+ * The buffer keeps its capacity and is handed out again by a later
+ * rcl_subscription_acquire_serialized_message().
+ *
+ * \see rcl_subscription_acquire_serialized_message()
+ *
+ * \param[in] subscription handle the buffer was acquired from
+ * \param[in] serialized_message the buffer to give back
+ * \return `RCL_RET_OK` if the buffer was released, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_release_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t * serialized_message);
+
+/// Take a message loaned from the middleware's buffers.
+/**
+ * Shared-memory capable middlewares can hand out the received message in
+ * place instead of copying it into a caller-allocated struct, enabling true
+ * zero-copy for large messages.  The message must be given back with
+ * rcl_return_loaned_message_from_subscription() when done.
+ *
+ * Use rcl_subscription_can_loan_messages() to check for support before
+ * relying on this; without middleware support `RCL_RET_UNSUPPORTED` is
+ * returned and callers should fall back to rcl_take().
+ *
+ * The rmw interface in use by this version has no loaning entry points, so
+ * this currently always reports `RCL_RET_UNSUPPORTED`; the API is provided
+ * so applications can be written against it and light up automatically once
+ * the middleware gains support.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Maybe [1]
+ * Lock-Free          | Maybe [1]
+ * <i>[1] rmw implementation defined</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[out] loaned_message where to store the pointer to the loaned message
+ * \param[out] message_info rmw struct for message metadata, may be `NULL`
+ * \return `RCL_RET_OK` if a message was taken, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot loan messages, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if take failed but no error
+ *   occurred in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_loaned_message(
+  const rcl_subscription_t * subscription,
+  void ** loaned_message,
+  rmw_message_info_t * message_info);
+
+/// Return a loaned message to the middleware.
+/**
+ * \see rcl_take_loaned_message()
+ *
+ * \param[in] subscription the handle the message was loaned through
+ * \param[in] loaned_message the message to give back to the middleware
+ * \return `RCL_RET_OK` if the message was returned, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the middleware cannot loan messages, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_return_loaned_message_from_subscription(
+  const rcl_subscription_t * subscription,
+  void * loaned_message);
+
+/// Check if the subscription's middleware can loan messages.
+/**
+ * Returns false if the subscription is invalid (error set) or if the
+ * middleware in use does not support message loaning.
+ *
+ * \param[in] subscription handle to the subscription to check
+ * \return true if the middleware can loan messages, otherwise false
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+bool
+rcl_subscription_can_loan_messages(const rcl_subscription_t * subscription);
+
+/// Take a message pointer published by a same-process publisher.
+/**
+ * Takes the oldest message pointer delivered through the intra-process fast
+ * path (see the use_intra_process subscription option), without crossing
+ * into the middleware or copying the message.
+ *
+ * The pointer is the very one the publisher passed to rcl_publish(); the
+ * application owns the message memory and defines for how long it stays
+ * valid after publishing.
+ * New intra-process messages wake wait sets through the guard condition
+ * returned by rcl_subscription_get_intra_process_guard_condition().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] for one concurrent taker per subscription</i>
+ *
+ * \param[in] subscription the handle to the subscription from which to take
+ * \param[out] ros_message where to store the taken message pointer
+ * \return `RCL_RET_OK` if a message pointer was taken, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the subscription did not opt into the
+ *   intra-process fast path, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if no message was pending.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_take_intra_process(
+  const rcl_subscription_t * subscription,
+  const void ** ros_message);
+
+/// Get the guard condition that signals intra-process messages.
+/**
+ * The returned guard condition is owned by the subscription and is valid
+ * until rcl_subscription_fini() is called; add it to a wait set to be woken
+ * when a same-process publisher delivers a message.
+ * Returns `NULL`, with an error set, if the subscription is invalid or did
+ * not opt into the intra-process fast path.
+ *
+ * \param[in] subscription handle to the subscription
+ * \return guard condition if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+const rcl_guard_condition_t *
+rcl_subscription_get_intra_process_guard_condition(const rcl_subscription_t * subscription);
+
+/// Acquire preallocated message storage from the subscription's pool.
+/**
+ * Pops one slot from the pool configured via the message_pool_size and
+ * message_pool_message_bound subscription options; no allocator is
+ * involved.  The caller initializes the message in the slot, takes into it,
+ * and gives the slot back with rcl_subscription_release_pool_message().
+ *
+ * \see rcl_publisher_acquire_pool_message() for attributes; this behaves
+ *   identically on the subscription side.
+ *
+ * \param[in] subscription handle to the subscription with a configured pool
+ * \param[out] message_storage where to store the pointer to the slot
+ * \return `RCL_RET_OK` if a slot was acquired, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if no pool is configured, or
+ * \return `RCL_RET_BAD_ALLOC` if the pool is exhausted.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_acquire_pool_message(
+  const rcl_subscription_t * subscription,
+  void ** message_storage);
+
+/// Release message storage back to the subscription's pool.
+/**
+ * \see rcl_subscription_acquire_pool_message()
+ *
+ * \param[in] subscription handle the slot was acquired from
+ * \param[in] message_storage the slot to give back
+ * \return `RCL_RET_OK` if the slot was released, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if no pool is configured.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_release_pool_message(
+  const rcl_subscription_t * subscription,
+  void * message_storage);
+
+/// Get a snapshot of the subscription's hot path statistics.
+/**
+ * Only valid on subscriptions whose options had `enable_statistics` set; on
+ * others this fails with `RCL_RET_UNSUPPORTED`.
+ * Takes that returned a message count as succeeded operations; takes that
+ * failed, including with nothing pending, count as failed ones.
+ *
+ * \param[in] subscription pointer to the rcl subscription
+ * \param[out] statistics filled with the current counts
+ * \return `RCL_RET_OK` if the statistics were retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid, or
+ * \return `RCL_RET_UNSUPPORTED` if the subscription does not keep statistics.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_get_statistics(
+  const rcl_subscription_t * subscription,
+  rcl_statistics_t * statistics);
+
 /// Get the topic name for the subscription.
 /**
  * This function returns the subscription's internal topic name string.
@@ -434,6 +935,36 @@ rcl_subscription_get_publisher_count(
   const rcl_subscription_t * subscription,
   size_t * publisher_count);
 
+/// Set a callback to be invoked when the subscription has new messages.
+/**
+ * The callback is invoked from within rcl_wait() when the subscription
+ * becomes ready, before rcl_wait() returns, so executors can react to data
+ * without scanning the wait set.  It must be fast and must not block.
+ *
+ * Setting the callback to `NULL` clears any previously registered callback.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] subscription the subscription on which to set the callback
+ * \param[in] callback the callback to be invoked, or `NULL` to clear it
+ * \param[in] user_data passed to the callback on every invocation, may be `NULL`
+ * \return `RCL_RET_OK` if the callback was set, or
+ * \return `RCL_RET_SUBSCRIPTION_INVALID` if the subscription is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_subscription_set_on_new_message_callback(
+  const rcl_subscription_t * subscription,
+  rcl_event_callback_t callback,
+  const void * user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -118,9 +118,17 @@ typedef struct rcl_clock_t
 {
   enum rcl_clock_type_t type;
   /// An array of added jump callbacks.
+  /**
+   * This is the registration-side view of the callbacks and must only be
+   * inspected by the thread doing the registration.  Time jumps traverse an
+   * atomically published snapshot of this array instead, so callbacks fire
+   * without taking a lock.
+   */
   rcl_jump_callback_info_t * jump_callbacks;
   /// Number of callbacks in jump_callbacks.
   size_t num_jump_callbacks;
+  /// Atomically published snapshot of the jump callbacks, implementation detail.
+  struct rcl_jump_callback_list_t * jump_callback_list;
   rcl_ret_t (* get_now)(void * data, rcl_time_point_value_t * now);
   // void (*set_now) (rcl_time_point_value_t);
   void * data;
@@ -142,6 +150,30 @@ typedef struct rcl_time_point_t
 // } rcl_rate_t;
 // TODO(tfoote) integrate rate and timer implementations
 
+/// Compute the duration between two time point values as finish - start.
+/**
+ * This is the pure arithmetic core of rcl_difference_times(), defined
+ * inline so that hot paths like timer deadline computations can fold the
+ * subtraction into the caller instead of paying a function call and
+ * argument checks for it.
+ * If start is after finish the duration is negative.
+ *
+ * \param[in] start The time point value for the start of the duration.
+ * \param[in] finish The time point value for the end of the duration.
+ * \return the duration between start and finish in nanoseconds.
+ */
+static inline
+rcl_duration_value_t
+rcl_difference_time_point_values(
+  rcl_time_point_value_t start, rcl_time_point_value_t finish)
+{
+  if (finish < start) {
+    rcl_time_point_value_t intermediate = start - finish;
+    return -1 * (rcl_duration_value_t)intermediate;
+  }
+  return (rcl_duration_value_t)(finish - start);
+}
+
 /// Check if the clock has valid values.
 /**
  * This function returns true if the time source appears to be valid.
@@ -247,6 +279,41 @@ rcl_steady_clock_init(
   rcl_clock_t * clock,
   rcl_allocator_t * allocator);
 
+/// Initialize a `RCL_STEADY_TIME` clock with a fast CPU tick counter backend.
+/**
+ * This behaves like rcl_steady_clock_init(), but where the platform has an
+ * invariant CPU tick counter (constant-rate TSC on x86), reads are served
+ * from the counter plus a calibrated offset instead of going through a
+ * system call per read.  A read costs tens of nanoseconds, which matters
+ * for hot paths like timer checks and message stamping that read the
+ * clock constantly.
+ *
+ * The tick rate is calibrated against the regular steady clock during
+ * init (blocking for roughly two milliseconds) and the offset is
+ * re-anchored to the steady clock about once per second of runtime, so
+ * drift stays bounded; reads are clamped to be monotonic across
+ * re-anchoring.  On platforms without a usable counter this falls back to
+ * rcl_steady_clock_init() and behaves identically to it.
+ *
+ * Unlike the regular backend, reading this clock from multiple threads
+ * concurrently is not supported.
+ *
+ * The clock must be finalized with rcl_steady_clock_fini().
+ *
+ * \param[in] clock the handle to the clock which is being initialized
+ * \param[in] allocator The allocator to use for allocations
+ * \return `RCL_RET_OK` if the time source was successfully initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_steady_clock_init_fast(
+  rcl_clock_t * clock,
+  rcl_allocator_t * allocator);
+
 /// Finalize a clock as a `RCL_STEADY_TIME` time source.
 /**
  * Finalize the clock as a `RCL_STEADY_TIME` time source.
@@ -286,6 +353,34 @@ rcl_system_clock_init(
   rcl_clock_t * clock,
   rcl_allocator_t * allocator);
 
+/// Initialize a clock as a coarse `RCL_SYSTEM_TIME` time source.
+/**
+ * This behaves like rcl_system_clock_init(), but reads are served from the
+ * operating system's coarse system clock where one is available (e.g.
+ * `CLOCK_REALTIME_COARSE` on Linux).
+ * Coarse reads avoid the cost of a full time read and are suitable for
+ * high-frequency stamping that tolerates the scheduler-tick granularity of
+ * the coarse clock, typically between one and ten milliseconds.
+ *
+ * On platforms without a coarse clock this falls back to
+ * rcl_system_clock_init(), so reads are always correct, just not always
+ * cheaper.
+ *
+ * The clock is finalized with rcl_system_clock_fini().
+ *
+ * \param[in] clock the handle to the clock which is being initialized
+ * \param[in] allocator The allocator to use for allocations
+ * \return `RCL_RET_OK` if the time source was successfully initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_system_clock_init_coarse(
+  rcl_clock_t * clock,
+  rcl_allocator_t * allocator);
+
 /// Finalize a clock as a `RCL_SYSTEM_TIME` time source.
 /**
  * Finalize the clock as a `RCL_SYSTEM_TIME` time source.
@@ -314,6 +409,10 @@ rcl_system_clock_fini(
  * The value will be computed as duration = finish - start. If start is after
  * finish the duration will be negative.
  *
+ * This is the ABI-stable wrapper around rcl_difference_time_point_values(),
+ * which callers on hot paths can use directly to avoid the call and the
+ * clock type check.
+ *
  * \param[in] start The time point for the start of the duration.
  * \param[in] finish The time point for the end of the duration.
  * \param[out] delta The duration between the start and finish.
@@ -342,6 +441,54 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_clock_get_now(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value);
 
+/// Get the current steady time without dispatching through a clock.
+/**
+ * This is equivalent to reading an `RCL_STEADY_TIME` clock created with
+ * rcl_steady_clock_init(), defined inline so that hot paths which
+ * statically know they want steady time can avoid the indirect call
+ * through the clock's get_now function pointer.
+ *
+ * \param[out] now The current steady time in nanoseconds.
+ * \return `RCL_RET_OK` if the time was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if now is `NULL`, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+static inline
+rcl_ret_t
+rcl_steady_time_now(rcl_time_point_value_t * now)
+{
+  return rcutils_steady_time_now(now);
+}
+
+/// Get a clock's time, devirtualizing the default steady clock backend.
+/**
+ * This behaves like rcl_clock_get_now(), but when the given clock is a
+ * steady clock using the default backend the time is read inline via
+ * rcl_steady_time_now() instead of dispatching through the clock's
+ * get_now function pointer.
+ * The default backend is identified by the clock having no per-clock
+ * state (`data` is `NULL`); steady clock backends with state, like the
+ * calibrated one set up by rcl_steady_clock_init_fast(), keep their
+ * registered get_now.
+ *
+ * \param[in] clock The time source from which to set the value.
+ * \param[out] time_point_value The time_point value to populate.
+ * \return `RCL_RET_OK` if the last call time was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+static inline
+rcl_ret_t
+rcl_clock_get_now_fast(rcl_clock_t * clock, rcl_time_point_value_t * time_point_value)
+{
+  if (NULL != clock && NULL != time_point_value &&
+    RCL_STEADY_TIME == clock->type && NULL == clock->data)
+  {
+    return rcl_steady_time_now(time_point_value);
+  }
+  return rcl_clock_get_now(clock, time_point_value);
+}
+
 
 /// Enable the ROS time abstraction override.
 /**
@@ -413,6 +560,36 @@ rcl_ret_t
 rcl_set_ros_time_override(
   rcl_clock_t * clock, rcl_time_point_value_t time_value);
 
+/// Limit how often ROS time override updates are fully applied.
+/**
+ * With a nonzero `min_update_period_ns`, calls to rcl_set_ros_time_override()
+ * arriving within that steady-clock window of the last applied update are
+ * coalesced: they neither publish new state nor walk the jump callbacks, so a
+ * high rate `/clock` source no longer pays that cost per message.  Reads in
+ * the gap interpolate linearly from the last applied value toward the newest
+ * received one, so time still advances smoothly for callers of
+ * rcl_clock_get_now().
+ *
+ * Because coalesced updates fire no jump callbacks, consumers woken by them
+ * (such as ROS time timers) can observe a deadline up to one window late;
+ * pick a window small enough for the deadlines in use.  Updates that move
+ * time backward are never coalesced.  A `min_update_period_ns` of 0 (the
+ * default) applies every update and publishes the newest coalesced value, if
+ * any, so time does not move backward when interpolation stops.
+ *
+ * \param[in] clock The `RCL_ROS_TIME` clock to configure.
+ * \param[in] min_update_period_ns Minimum steady time between applied
+ *   updates, in nanoseconds, or 0 to apply every update.
+ * \return `RCL_RET_OK` if the limit was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_ros_clock_set_override_rate_limit(
+  rcl_clock_t * clock, uint64_t min_update_period_ns);
+
 /// Add a callback to be called when a time jump exceeds a threshold.
 /**
  * The callback is called twice when the threshold is exceeded: once before the clock is
@@ -158,6 +158,69 @@ rcl_timer_init(
   const rcl_timer_callback_t callback,
   rcl_allocator_t allocator);
 
+/// Same as rcl_timer_init(), but also storing opaque user data on the timer.
+/**
+ * In addition to the documentation for rcl_timer_init(), the `user_data`
+ * pointer is stored on the timer and handed back by
+ * rcl_timer_get_user_data(), typically from inside the callback.
+ * This lets client libraries attach their closure or handle wrapper
+ * directly to the timer instead of keeping a map from timer pointers to
+ * closures that must be consulted on every fire.
+ *
+ * The user data is not interpreted or freed by rcl; its life time must
+ * exceed the life time of the timer.
+ * `NULL` is a valid value and is what rcl_timer_init() stores.
+ *
+ * \param[inout] timer the timer handle to be initialized
+ * \param[in] clock the clock providing the current time
+ * \param[in] context the context that this timer is to be associated with
+ * \param[in] period the duration between calls to the callback in nanoseconds
+ * \param[in] callback the user defined function to be called every period
+ * \param[in] user_data opaque pointer returned by rcl_timer_get_user_data()
+ * \param[in] allocator the allocator to use for allocations
+ * \return `RCL_RET_OK` if the timer was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the timer was already initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_init_with_user_data(
+  rcl_timer_t * timer,
+  rcl_clock_t * clock,
+  rcl_context_t * context,
+  int64_t period,
+  const rcl_timer_callback_t callback,
+  void * user_data,
+  rcl_allocator_t allocator);
+
+/// Return the user data stored on the timer at initialization.
+/**
+ * The pointer given to rcl_timer_init_with_user_data() is returned as is;
+ * it is set once at initialization and never changes afterwards, so this
+ * is a direct read safe to call from within the timer callback.
+ *
+ * Returns `NULL` if the timer is invalid (error set), or if the timer was
+ * initialized without user data.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] timer the handle to the timer being queried
+ * \return the stored user data pointer, or `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+void *
+rcl_timer_get_user_data(const rcl_timer_t * timer);
+
 /// Finalize a timer.
 /**
  * This function will deallocate any memory and make the timer invalid.
@@ -233,6 +296,84 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_timer_call(rcl_timer_t * timer);
 
+/// Call the timer's callback and report how many periods were missed.
+/**
+ * This behaves exactly like rcl_timer_call(), but additionally reports how
+ * many whole periods beyond the first were skipped when advancing the next
+ * call time past the current time.
+ * The count is zero when the timer is serviced on schedule, and grows by one
+ * for each period the process slept through, e.g. after being descheduled.
+ * The next call time is advanced past the current time in a single
+ * computation, so catching up an overdue timer never requires repeated calls.
+ *
+ * The expected usage is:
+ *
+ * ```c
+ * uint64_t missed_periods = 0;
+ * rcl_ret_t ret = rcl_timer_call_with_info(timer, &missed_periods);
+ * // handle ret, then optionally compensate for missed_periods
+ * ```
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [2]
+ * <i>[1] user callback might not be thread-safe</i>
+ *
+ * <i>[2] if `atomic_is_lock_free()` returns true for `atomic_int_least64_t`</i>
+ *
+ * \param[inout] timer the handle to the timer to call
+ * \param[out] missed_periods the number of whole periods skipped beyond the
+ *   first when moving the next call time past the current time
+ * \return `RCL_RET_OK` if the timer was called successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid, or
+ * \return `RCL_RET_TIMER_CANCELED` if the timer has been canceled, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_call_with_info(rcl_timer_t * timer, uint64_t * missed_periods);
+
+/// Call every ready timer in a batch, sharing clock reads between them.
+/**
+ * The current time is read once per distinct clock in the batch rather than
+ * once per timer, and each ready timer is serviced with the semantics of
+ * rcl_timer_call().
+ * Timers that are canceled or whose period has not yet elapsed are skipped
+ * without error, so the batch may simply be every timer owned by the caller.
+ * `NULL` entries in the array are not allowed.
+ *
+ * If servicing one timer fails, the remaining timers are still serviced and
+ * the first error encountered is returned.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [2]
+ * <i>[1] user callbacks might not be thread-safe</i>
+ *
+ * <i>[2] if `atomic_is_lock_free()` returns true for `atomic_int_least64_t`</i>
+ *
+ * \param[inout] timers an array of timers to be serviced
+ * \param[in] timer_count the number of timers in the array
+ * \return `RCL_RET_OK` if all ready timers were called successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if a timer in the array is invalid, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timers_call_ready(rcl_timer_t ** timers, size_t timer_count);
+
 /// Retrieve the clock of the timer.
 /**
  * This function retrieves the clock pointer and copies it into the given variable.
@@ -324,6 +465,37 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_timer_get_time_until_next_call(const rcl_timer_t * timer, int64_t * time_until_next_call);
 
+/// Retrieve the absolute time of the next call to rcl_timer_call().
+/**
+ * This function copies the timer's next call time, expressed in nanoseconds
+ * on the timer's clock, into the given int64_t variable.
+ * Unlike rcl_timer_get_time_until_next_call() this does not read the clock,
+ * so it is cheaper and the result is stable until the timer is called,
+ * reset, or its period is exchanged.
+ *
+ * The `next_call_time` argument must point to an allocated int64_t, as the
+ * time is copied into that instance.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes [1]
+ * <i>[1] if `atomic_is_lock_free()` returns true for `atomic_int_least64_t`</i>
+ *
+ * \param[in] timer the handle to the timer that is being queried
+ * \param[out] next_call_time the output variable for the result
+ * \return `RCL_RET_OK` if the next call time was successfully retrieved, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_get_next_call_time(const rcl_timer_t * timer, int64_t * next_call_time);
+
 /// Retrieve the time since the previous call to rcl_timer_call() occurred.
 /**
  * This function calculates the time since the last call and copies it into
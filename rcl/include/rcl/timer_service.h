@@ -0,0 +1,339 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TIMER_SERVICE_H_
+#define RCL__TIMER_SERVICE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+#include "rcl/guard_condition.h"
+#include "rcl/macros.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+/// Internal rcl timer service implementation struct.
+struct rcl_timer_service_impl_t;
+
+/// Opt-in batched timer expiry delivery, decoupled from the wait loop.
+/**
+ * Timers waited on through a wait set fire with the latency of the executor
+ * spin: a callback that runs long delays every timer behind it.  A timer
+ * service separates the two.  Timers are registered with the service once;
+ * a dedicated caller-owned thread then drives expiry by alternating between
+ * rcl_timer_service_get_next_deadline() (to know how long to sleep) and
+ * rcl_timer_service_collect() (to sweep due timers into the service's
+ * expiry queue).  Each sweep that delivers something triggers the service's
+ * guard condition, so the consumer - typically an executor waiting on the
+ * guard condition through its wait set - wakes once per batch and drains the
+ * due handles with rcl_timer_service_take_expired() instead of polling every
+ * timer every spin.  Timer jitter is then bounded by the driving thread's
+ * wake up accuracy, not by executor load.
+ *
+ * rcl itself never creates a thread; the driving loop belongs to the
+ * application.  A minimal driver looks like:
+ *
+ * ```c
+ * while (running) {
+ *   int64_t deadline;
+ *   ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+ *   // ... error handling, sleep until `deadline` on the service's clock
+ *   size_t delivered;
+ *   ret = rcl_timer_service_collect(&timer_service, &delivered);
+ *   // ... error handling
+ * }
+ * ```
+ *
+ * A delivered timer is parked until the consumer calls rcl_timer_call() on
+ * it; the call re-arms the timer in the service with its next deadline.
+ * This means a handle is never sitting in the queue twice, and a consumer
+ * which drops a batch on the floor loses those timer ticks.
+ *
+ * Thread-safety: rcl_timer_service_collect() (one driving thread) and
+ * rcl_timer_service_take_expired() (one consuming thread) may run
+ * concurrently with each other.  All other functions, including adding and
+ * removing timers, must be externally serialized with the driving thread,
+ * e.g. by parking it first.
+ */
+typedef struct rcl_timer_service_t
+{
+  struct rcl_timer_service_impl_t * impl;
+} rcl_timer_service_t;
+
+/// Options available for a rcl timer service.
+typedef struct rcl_timer_service_options_t
+{
+  /// Custom allocator for the timer service, used for internal allocations.
+  rcl_allocator_t allocator;
+  /// Capacity of the expiry queue; 0 means the default.
+  /**
+   * See RCL_TIMER_SERVICE_QUEUE_CAPACITY_DEFAULT.  When the queue is full,
+   * due timers stay recorded and are delivered by a later collect, after the
+   * consumer has drained the queue; no expiry is lost.
+   */
+  size_t queue_capacity;
+} rcl_timer_service_options_t;
+
+/// Default capacity of the expiry queue of a timer service.
+#define RCL_TIMER_SERVICE_QUEUE_CAPACITY_DEFAULT 64
+
+/// Return a rcl_timer_service_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_timer_service_t
+rcl_get_zero_initialized_timer_service(void);
+
+/// Return the default options in a rcl_timer_service_options_t struct.
+/**
+ * The defaults are:
+ *
+ * - allocator = rcl_get_default_allocator()
+ * - queue_capacity = 0 (RCL_TIMER_SERVICE_QUEUE_CAPACITY_DEFAULT)
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_timer_service_options_t
+rcl_timer_service_get_default_options(void);
+
+/// Initialize a timer service.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] timer_service preallocated, zero initialized service structure
+ * \param[in] context the context instance the service's guard condition
+ *   should be associated with
+ * \param[in] options the timer service's options
+ * \return `RCL_RET_OK` if the service was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the service is already initialized, or
+ * \return `RCL_RET_NOT_INIT` if the given context is invalid, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_init(
+  rcl_timer_service_t * timer_service,
+  rcl_context_t * context,
+  const rcl_timer_service_options_t options);
+
+/// Finalize a timer service.
+/**
+ * The registered timers themselves are not finalized; they simply stop being
+ * tracked.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] timer_service the service to be finalized
+ * \return `RCL_RET_OK` if the service was finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_fini(rcl_timer_service_t * timer_service);
+
+/// Register a timer with the service.
+/**
+ * The timer is borrowed, not copied; it must stay valid until it is removed
+ * from the service or the service is finalized, and it must not also be
+ * added to wait sets, or it would be dispatched through both paths.
+ *
+ * All timers of one service must use clocks of a single type, either
+ * `RCL_STEADY_TIME` or `RCL_SYSTEM_TIME`, since their absolute deadlines
+ * share the service's deadline ordering; the first added timer decides.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] timer_service valid service to register the timer with
+ * \param[in] timer valid timer to register
+ * \return `RCL_RET_OK` if the timer was registered successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   timer's clock type does not match the service, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_add_timer(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t * timer);
+
+/// Remove a timer from the service.
+/**
+ * A handle of the timer may still sit in the expiry queue from an earlier
+ * collect; the caller is responsible for not finalizing the timer before
+ * draining the queue.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] timer_service valid service to remove the timer from
+ * \param[in] timer the timer to remove
+ * \return `RCL_RET_OK` if the timer was removed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   timer is not registered with the service.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_remove_timer(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t * timer);
+
+/// Get the guard condition signaled when a batch of timers is delivered.
+/**
+ * The guard condition is owned by the service and coalesces triggers, so
+ * waking on it and draining with rcl_timer_service_take_expired() handles
+ * every batch delivered since the last drain.
+ *
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - timer_service is `NULL`
+ *   - timer_service is invalid (never called init or called fini)
+ *
+ * \param[in] timer_service pointer to the timer service
+ * \return the guard condition if successful, otherwise `NULL`
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+const rcl_guard_condition_t *
+rcl_timer_service_get_guard_condition(const rcl_timer_service_t * timer_service);
+
+/// Get the earliest deadline of the registered timers.
+/**
+ * Writes the absolute time, on the clock shared by the service's timers, at
+ * which the earliest timer is due; the driving thread sleeps until then.
+ * With no registered timers, or only parked ones (delivered and not yet
+ * called), `INT64_MAX` is written.  Timers called or reset since their
+ * deadline was recorded are re-examined by this function, so calling it at
+ * the top of each driving loop iteration keeps the recorded deadlines fresh.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] callable only from the driving thread, see rcl_timer_service_t</i>
+ *
+ * \param[in] timer_service valid timer service
+ * \param[out] deadline the earliest absolute deadline, or `INT64_MAX`
+ * \return `RCL_RET_OK` if the deadline was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_get_next_deadline(
+  rcl_timer_service_t * timer_service,
+  int64_t * deadline);
+
+/// Sweep due timers into the expiry queue, waking the consumer once.
+/**
+ * Every registered timer that is ready is appended to the expiry queue and
+ * parked; if at least one was appended the service's guard condition is
+ * triggered.  When the queue is full the remaining due timers stay recorded
+ * and a later collect delivers them, so a slow consumer delays ticks but
+ * does not lose timers.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] callable only from the driving thread, see rcl_timer_service_t</i>
+ *
+ * \param[in] timer_service valid timer service
+ * \param[out] number_delivered how many timers this sweep appended
+ * \return `RCL_RET_OK` if the sweep completed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_collect(
+  rcl_timer_service_t * timer_service,
+  size_t * number_delivered);
+
+/// Take a batch of expired timer handles from the expiry queue.
+/**
+ * Copies up to `capacity` due timer handles into `timers` and re-arms the
+ * guard condition.  The caller is expected to invoke rcl_timer_call() on
+ * each returned handle; that re-arms the timer with its next deadline.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No [1]
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ * <i>[1] callable only from one consuming thread, see rcl_timer_service_t</i>
+ *
+ * \param[in] timer_service valid timer service
+ * \param[out] timers array to copy the due timer handles into
+ * \param[in] capacity number of entries available in `timers`
+ * \param[out] number_taken how many handles were copied
+ * \return `RCL_RET_OK` if the batch was taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_service_take_expired(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t ** timers,
+  size_t capacity,
+  size_t * number_taken);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TIMER_SERVICE_H_
@@ -0,0 +1,194 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TIMER_WHEEL_H_
+#define RCL__TIMER_WHEEL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/allocator.h"
+#include "rcl/macros.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+#include "rcl/visibility_control.h"
+
+struct rcl_timer_wheel_impl_t;
+
+/// Hierarchical timing wheel for scheduling large numbers of timers.
+/**
+ * The wheel buckets timers by absolute deadline into fixed-size slots across
+ * several levels of increasing resolution, giving O(1) insertion and removal
+ * and amortized O(1) expiry per timer, independent of how many timers are
+ * scheduled.  It is intended for executors driving thousands of short-period
+ * timers, where querying every timer's deadline on every spin dominates.
+ *
+ * The wheel is an optional, stand-alone scheduler: timers are added to it
+ * explicitly with rcl_timer_wheel_add() after rcl_timer_init(), and the
+ * executor drives it by calling rcl_timer_wheel_advance() with the current
+ * time.  The wheel caches each timer's deadline when the timer is added and
+ * re-buckets the timer from its actual next call time each time it expires,
+ * so out-of-band changes (rcl_timer_reset(), rcl_timer_exchange_period())
+ * take effect the next time the timer expires on the wheel, or immediately
+ * if the timer is removed and re-added.
+ */
+typedef struct rcl_timer_wheel_t
+{
+  struct rcl_timer_wheel_impl_t * impl;
+} rcl_timer_wheel_t;
+
+/// Options used to configure a timer wheel.
+typedef struct rcl_timer_wheel_options_t
+{
+  /// Duration of one slot at the finest level, in nanoseconds.
+  /**
+   * Deadlines are quantized to this resolution; a timer may expire up to one
+   * resolution later than its exact deadline.  Must be greater than zero.
+   */
+  int64_t resolution;
+  /// Custom allocator for the wheel, used for internal allocations.
+  rcl_allocator_t allocator;
+} rcl_timer_wheel_options_t;
+
+/// Return a rcl_timer_wheel_t struct with members set to `NULL`.
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_timer_wheel_t
+rcl_get_zero_initialized_timer_wheel(void);
+
+/// Return the default timer wheel options (1 millisecond resolution).
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_timer_wheel_options_t
+rcl_timer_wheel_get_default_options(void);
+
+/// Initialize a timer wheel.
+/**
+ * \param[inout] timer_wheel the timer wheel to be initialized
+ * \param[in] start_time the current time of the clock the wheel will be
+ *   advanced with, used as the origin of slot zero
+ * \param[in] options the options to configure the wheel with
+ * \return `RCL_RET_OK` if the wheel was initialized successfully, or
+ * \return `RCL_RET_ALREADY_INIT` if the wheel is already initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_init(
+  rcl_timer_wheel_t * timer_wheel,
+  int64_t start_time,
+  const rcl_timer_wheel_options_t * options);
+
+/// Finalize a timer wheel, freeing all internal storage.
+/**
+ * Timers added to the wheel are not finalized; they simply stop being
+ * scheduled by this wheel.
+ *
+ * \return `RCL_RET_OK` if finalized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if timer_wheel is `NULL`.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_fini(rcl_timer_wheel_t * timer_wheel);
+
+/// Add a timer to the wheel, bucketed by its current next call time.
+/**
+ * The timer must outlive its membership in the wheel; remove it with
+ * rcl_timer_wheel_remove() before finalizing it.  Adding the same timer
+ * twice schedules it twice.
+ *
+ * \return `RCL_RET_OK` if the timer was added, or
+ * \return `RCL_RET_NOT_INIT` if the wheel is not initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_TIMER_INVALID` if the timer is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_add(rcl_timer_wheel_t * timer_wheel, const rcl_timer_t * timer);
+
+/// Remove a timer from the wheel.
+/**
+ * \return `RCL_RET_OK` if the timer was removed (or was not on the wheel), or
+ * \return `RCL_RET_NOT_INIT` if the wheel is not initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_remove(rcl_timer_wheel_t * timer_wheel, const rcl_timer_t * timer);
+
+/// Advance the wheel to the given time, collecting expired timers.
+/**
+ * All timers whose deadline falls at or before `current_time` are written to
+ * `expired_timers` (up to `capacity` of them) and automatically re-bucketed
+ * by their next call time, so periodic timers keep firing without being
+ * re-added.  Canceled timers are parked and re-bucketed on the next advance
+ * after they are reset.
+ *
+ * The caller is expected to call rcl_timer_call() on the returned timers;
+ * the wheel itself never calls timer callbacks.
+ *
+ * \param[inout] timer_wheel the wheel to advance
+ * \param[in] current_time the current time of the same clock used at init
+ * \param[out] expired_timers array to fill with timers that expired
+ * \param[in] capacity size of the expired_timers array
+ * \param[out] number_expired how many entries of expired_timers were written
+ * \return `RCL_RET_OK` if the wheel was advanced (even if no timers expired,
+ *   or more than `capacity` timers expired — call again to drain), or
+ * \return `RCL_RET_NOT_INIT` if the wheel is not initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_advance(
+  rcl_timer_wheel_t * timer_wheel,
+  int64_t current_time,
+  const rcl_timer_t ** expired_timers,
+  size_t capacity,
+  size_t * number_expired);
+
+/// Get the earliest recorded deadline of any timer on the wheel.
+/**
+ * Scans the wheel's recorded deadlines, which the executor can use as its
+ * wait timeout.  The value does not account for changes made to a timer
+ * since it was last bucketed, so the corresponding timer may expire up to
+ * one slot later than this.
+ *
+ * \param[in] timer_wheel the wheel to query
+ * \param[out] next_deadline the earliest deadline lower bound, or `INT64_MAX`
+ *   if the wheel is empty
+ * \return `RCL_RET_OK` if the deadline was retrieved, or
+ * \return `RCL_RET_NOT_INIT` if the wheel is not initialized, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_timer_wheel_get_next_deadline(
+  const rcl_timer_wheel_t * timer_wheel,
+  int64_t * next_deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TIMER_WHEEL_H_
@@ -0,0 +1,77 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TRACEPOINTS_H_
+#define RCL__TRACEPOINTS_H_
+
+#include "rcl/visibility_control.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Tracepoint hook, called from instrumented hot paths.
+/**
+ * rcl places tracepoints at the critical boundaries of the message and
+ * executor hot paths: publish, take, wait, timer call, and the client
+ * request/response pair.
+ * They are compiled out by default; building with RCL_ENABLE_TRACEPOINTS
+ * defined (see the RCL_ENABLE_TRACEPOINTS CMake option) compiles a call to
+ * this function into each of them.
+ *
+ * The default implementation shipped with rcl does nothing; tracing tools
+ * provide their own by interposing this symbol, e.g. with LD_PRELOAD, and
+ * forward the events to their backend of choice such as LTTng userspace
+ * tracepoints.
+ *
+ * `handle` identifies the entity and is stable for its lifetime.
+ * Creation events (`rcl_publisher_init`, `rcl_subscription_init`,
+ * `rcl_client_init`) additionally carry the entity's topic or service name
+ * in `info`, so a tool can tie the per-call events that follow back to
+ * their creation-time names and reconstruct per-topic distributions.
+ *
+ * Implementations must be async-signal-safe to the extent the traced
+ * application requires, must not call back into rcl, and should return
+ * quickly; every instrumented call on every thread funnels through here.
+ *
+ * \param[in] event_name statically allocated name of the tracepoint
+ * \param[in] handle identity of the entity the event concerns, may be NULL
+ * \param[in] info extra creation-time detail, NULL for per-call events
+ */
+RCL_PUBLIC
+void
+rcl_tracepoint_fire(const char * event_name, const void * handle, const char * info);
+
+#ifdef RCL_ENABLE_TRACEPOINTS
+
+#define RCL_TRACEPOINT(event_name, handle) \
+  rcl_tracepoint_fire(event_name, handle, NULL)
+
+#define RCL_TRACEPOINT_REGISTER(event_name, handle, info) \
+  rcl_tracepoint_fire(event_name, handle, info)
+
+#else
+
+#define RCL_TRACEPOINT(event_name, handle)
+
+#define RCL_TRACEPOINT_REGISTER(event_name, handle, info)
+
+#endif  // RCL_ENABLE_TRACEPOINTS
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TRACEPOINTS_H_
@@ -44,6 +44,10 @@ typedef rmw_ret_t rcl_ret_t;
 #define RCL_RET_UNKNOWN_SUBSTITUTION 105
 /// rcl_shutdown() already called return code.
 #define RCL_RET_ALREADY_SHUTDOWN 106
+/// Feature is not supported by the rmw implementation in use return code.
+#define RCL_RET_UNSUPPORTED 107
+/// Caller provided buffer is too small for the result return code.
+#define RCL_RET_BUFFER_TOO_SMALL 108
 
 // rcl node specific ret codes in 2XX
 /// Invalid rcl_node_t given return code.
@@ -66,6 +70,10 @@ typedef rmw_ret_t rcl_ret_t;
 #define RCL_RET_CLIENT_INVALID 500
 /// Failed to take a response from the client return code.
 #define RCL_RET_CLIENT_TAKE_FAILED 501
+/// Client has as many requests in flight as its table can track return code.
+#define RCL_RET_CLIENT_IN_FLIGHT_FULL 502
+/// Client group already holds as many clients as it has capacity for return code.
+#define RCL_RET_CLIENT_GROUP_FULL 503
 
 // rcl service server specific ret codes in 6XX
 /// Invalid rcl_service_t given return code.
@@ -99,6 +107,12 @@ typedef rmw_ret_t rcl_ret_t;
 /// Argument is not a valid log level rule
 #define RCL_RET_INVALID_LOG_LEVEL_RULE 1020
 
+// rcl event specific ret codes in 11XX
+/// Invalid rcl_event_t given return code.
+#define RCL_RET_EVENT_INVALID 1100
+/// The event's deadline is not currently missed return code.
+#define RCL_RET_EVENT_TAKE_FAILED 1101
+
 /// typedef for rmw_serialized_message_t;
 typedef rmw_serialized_message_t rcl_serialized_message_t;
 
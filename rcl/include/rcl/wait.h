@@ -22,8 +22,11 @@ extern "C"
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "rcl/client.h"
+#include "rcl/client_group.h"
+#include "rcl/event.h"
 #include "rcl/guard_condition.h"
 #include "rcl/macros.h"
 #include "rcl/service.h"
@@ -34,6 +37,34 @@ extern "C"
 
 struct rcl_wait_set_impl_t;
 
+/// The kind of an entity stored in a wait set.
+typedef enum rcl_wait_set_entity_type_t
+{
+  RCL_WAIT_SET_SUBSCRIPTION = 0,
+  RCL_WAIT_SET_GUARD_CONDITION,
+  RCL_WAIT_SET_TIMER,
+  RCL_WAIT_SET_CLIENT,
+  RCL_WAIT_SET_SERVICE,
+  RCL_WAIT_SET_CLIENT_GROUP,
+  RCL_WAIT_SET_EVENT
+} rcl_wait_set_entity_type_t;
+
+/// A single ready entity, identified by kind and index into the entity array.
+typedef struct rcl_ready_entity_t
+{
+  /// Which of the wait set's entity arrays the entity is stored in.
+  rcl_wait_set_entity_type_t type;
+  /// Index of the ready entity in that array.
+  /**
+   * Client groups and events have no public array; their index counts the
+   * entities of their kind in the order they were added, as reported by
+   * rcl_wait_set_add_client_group() and rcl_wait_set_add_event().
+   */
+  size_t index;
+  /// Dispatch priority of the entity, see rcl_subscription_options_t.
+  uint8_t priority;
+} rcl_ready_entity_t;
+
 /// Container for subscription's, guard condition's, etc to be waited on.
 typedef struct rcl_wait_set_t
 {
@@ -154,6 +185,87 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait_set_fini(rcl_wait_set_t * wait_set);
 
+/// Acquire an initialized wait set from the context's reuse pool.
+/**
+ * For callers that need a wait set per blocking call, e.g. a single take
+ * with a timeout, rcl_wait_set_init() pays its full allocation chain plus
+ * middleware wait set creation every time.
+ * This function instead recycles a previously released set when one is
+ * pooled on the context, only resizing it if the requested sizes differ
+ * from its current capacity; a fresh set is initialized with the context's
+ * allocator when the pool is empty.
+ *
+ * The returned set is cleared and ready to use exactly as if it came from
+ * rcl_wait_set_init().
+ * It must be returned with rcl_context_release_wait_set() instead of
+ * rcl_wait_set_fini(), before the context is finalized; any sets still in
+ * the pool are finalized with the context.
+ *
+ * Like entity creation on a context, acquiring and releasing wait sets is
+ * not thread-safe; concurrent callers must serialize these calls, though
+ * they may use the acquired sets concurrently.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose pool is used
+ * \param[in] number_of_subscriptions non-zero size of the subscriptions set
+ * \param[in] number_of_guard_conditions non-zero size of the guard conditions set
+ * \param[in] number_of_timers non-zero size of the timers set
+ * \param[in] number_of_clients non-zero size of the clients set
+ * \param[in] number_of_services non-zero size of the services set
+ * \param[out] wait_set set to a ready-to-use wait set on success
+ * \return `RCL_RET_OK` if a wait set was acquired successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_acquire_wait_set(
+  rcl_context_t * context,
+  size_t number_of_subscriptions,
+  size_t number_of_guard_conditions,
+  size_t number_of_timers,
+  size_t number_of_clients,
+  size_t number_of_services,
+  rcl_wait_set_t ** wait_set);
+
+/// Return an acquired wait set to the context's reuse pool.
+/**
+ * The wait set keeps its capacity and middleware handle, so a later
+ * rcl_context_acquire_wait_set() with the same sizes reuses it without
+ * touching the allocator or the middleware.
+ *
+ * The wait set must have come from rcl_context_acquire_wait_set() on the
+ * same context; releasing any other wait set results in undefined behavior.
+ * The caller must not use the wait set after releasing it.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] context the context whose pool the wait set came from
+ * \param[in] wait_set the wait set to return to the pool
+ * \return `RCL_RET_OK` if the wait set was released successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_context_release_wait_set(rcl_context_t * context, rcl_wait_set_t * wait_set);
+
 /// Retrieve the wait set's allocator.
 /**
  * The allocator must be an allocated rcl_allocator_t struct, as the result is
@@ -212,6 +324,103 @@ rcl_wait_set_add_subscription(
   const rcl_subscription_t * subscription,
   size_t * index);
 
+/// Store pointers to the given subscriptions in the next empty spots in the set.
+/**
+ * This is the bulk equivalent of calling rcl_wait_set_add_subscription() for
+ * each entry of the given array, but the wait set is validated once and the
+ * handles are stored with a single copy, which is significantly cheaper when
+ * populating large wait sets.
+ *
+ * Either all of the subscriptions are added or none are: if any entry is
+ * `NULL` or has no rmw handle, or if there is not enough space left in the
+ * set, an error is returned and the wait set is unchanged except for the rmw
+ * handles already staged, in which case the wait set should be cleared.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct in which the subscriptions are to be stored
+ * \param[in] subscriptions array of subscriptions to be added to the wait set
+ * \param[in] number_of_subscriptions length of the subscriptions array
+ * \param[out] first_index the index of the first added subscription in the
+ *   storage container; the rest follow contiguously.
+ *   This parameter is optional and can be set to `NULL` to be ignored.
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_FULL` if there is not enough space left, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_subscriptions(
+  rcl_wait_set_t * wait_set,
+  const rcl_subscription_t ** subscriptions,
+  size_t number_of_subscriptions,
+  size_t * first_index);
+
+/// Store pointers to the guard conditions in the next empty spots in the set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_add_subscriptions
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_guard_conditions(
+  rcl_wait_set_t * wait_set,
+  const rcl_guard_condition_t ** guard_conditions,
+  size_t number_of_guard_conditions,
+  size_t * first_index);
+
+/// Store pointers to the timers in the next empty spots in the set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_add_subscriptions
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_timers(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t ** timers,
+  size_t number_of_timers,
+  size_t * first_index);
+
+/// Store pointers to the clients in the next empty spots in the set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_add_subscriptions
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_clients(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_t ** clients,
+  size_t number_of_clients,
+  size_t * first_index);
+
+/// Store pointers to the services in the next empty spots in the set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_add_subscriptions
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_services(
+  rcl_wait_set_t * wait_set,
+  const rcl_service_t ** services,
+  size_t number_of_services,
+  size_t * first_index);
+
 /// Remove (sets to `NULL`) all entities in the wait set.
 /**
  * This function should be used after passing using rcl_wait, but before
@@ -240,11 +449,110 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait_set_clear(rcl_wait_set_t * wait_set);
 
+/// Enable or disable retained mode on a wait set.
+/**
+ * In retained mode entities stay registered across calls to rcl_wait():
+ * a snapshot of the wait set contents is taken on the first wait after the
+ * set is modified, and restored before every subsequent wait.
+ * This removes the need to call rcl_wait_set_clear() and re-add every entity
+ * before each wait, which is the dominant cost for large, mostly static wait
+ * sets spun at high rates.
+ *
+ * Adding an entity, clearing, or resizing the wait set marks the snapshot
+ * dirty and it is rebuilt on the next rcl_wait() call.
+ * A single entity can be removed with the rcl_wait_set_remove_* functions
+ * (see rcl_wait_set_remove_subscription()), which also mark the snapshot
+ * dirty; there is no need to clear and re-add the remaining entities.
+ *
+ * After rcl_wait() returns, the entity arrays are pruned as usual, i.e.
+ * entries which are not ready are set to `NULL`.
+ * The retained snapshot is unaffected by this pruning.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct on which retained mode is set
+ * \param[in] retained true to enable retained mode, false to disable it
+ * \return `RCL_RET_OK` if the mode was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_retained(rcl_wait_set_t * wait_set, bool retained);
+
+/// Attach a child wait set to a parent for composite waits.
+/**
+ * Waiting on the parent then waits on the union of the parent's own entities
+ * and the entities of every attached child, and readiness is reported per
+ * member: after rcl_wait() on the parent returns, each child's entity arrays
+ * and ready entity list (see rcl_wait_set_get_ready_entities()) reflect that
+ * child's ready entities exactly as if it had been waited on alone.
+ *
+ * This lets an executor register a static group of entities in its own wait
+ * set once and hand the whole group to a worker thread as a unit, instead of
+ * copying every group's entities into and out of one flat wait set on each
+ * spin.  Children pair naturally with retained mode
+ * (see rcl_wait_set_set_retained()) so their contents also survive waits.
+ *
+ * The child must stay valid while attached; it can still be waited on
+ * directly, but not concurrently with a wait on the parent.
+ * Composition is one level deep: a wait set which has children of its own
+ * cannot be attached.
+ * Attaching does not transfer ownership; the child must be detached (or the
+ * parent finalized) before the child is finalized.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] parent wait set which will wait on the union
+ * \param[in] child wait set whose entities join the parent's waits
+ * \return `RCL_RET_OK` if the child was attached successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if either wait set is zero initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_attach(rcl_wait_set_t * parent, rcl_wait_set_t * child);
+
+/// Detach a child wait set attached with rcl_wait_set_attach().
+/**
+ * Subsequent waits on the parent no longer include the child's entities.
+ *
+ * \param[inout] parent wait set the child was attached to
+ * \param[in] child wait set to detach
+ * \return `RCL_RET_OK` if the child was detached successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   child is not attached, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the parent is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_detach(rcl_wait_set_t * parent, rcl_wait_set_t * child);
+
 /// Reallocate space for entities in the wait set.
 /**
  * This function will deallocate and reallocate the memory for all entity sets.
+ * All entity arrays and their underlying rmw mirrors are backed by a single
+ * contiguous allocation, so a resize is one reallocation rather than one per
+ * array.
  *
- * A size of 0 will just deallocate the memory and assign `NULL` to the array.
+ * A size of 0 for all entity types will just deallocate the memory and assign
+ * `NULL` to the arrays.
  *
  * Allocation and deallocation is done with the allocator given during the
  * wait set's initialization.
@@ -288,6 +596,84 @@ rcl_wait_set_resize(
   size_t clients_size,
   size_t services_size);
 
+/// Shrink the wait set's capacities down to its current occupancy.
+/**
+ * This is equivalent to calling rcl_wait_set_resize() with the number of
+ * entities of each kind currently added as the new sizes, and like any
+ * resize it leaves the wait set empty.
+ * Use it in place of rcl_wait_set_clear() when a wait set that once held
+ * many entities should stop retaining its peak allocation, e.g. after a
+ * burst of clients has finished in a long-running process.
+ *
+ * Deadline events count against the guard condition capacity, so the
+ * guard condition size is kept large enough for the events currently
+ * added as well.
+ *
+ * If every capacity already matches its occupancy this is a no-op.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct to be shrunk
+ * \return `RCL_RET_OK` if shrunk successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_shrink_to_fit(rcl_wait_set_t * wait_set);
+
+/// Set a high-watermark policy that shrinks the wait set automatically.
+/**
+ * When enabled, every call to rcl_wait() checks how much of the wait set's
+ * capacity is actually occupied.
+ * Once the occupancy has stayed below \p occupancy_percent percent for
+ * \p number_of_waits consecutive waits, the next rcl_wait_set_clear() call
+ * resizes the wait set down to the highest per-kind occupancy seen during
+ * that streak.
+ * The shrink is deferred to the clear so the entity arrays are never
+ * reallocated while the caller may still be reading them after a wait.
+ *
+ * This keeps wait set memory tracking the actual load in long uptimes,
+ * instead of retaining the peak reached during a transient burst, while
+ * leaving enough headroom that a steady load does not resize at all.
+ *
+ * Passing `0` for either parameter disables the policy and resets any
+ * streak in progress; the policy is disabled by default.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct the policy is set on
+ * \param[in] occupancy_percent occupancy below which a wait counts towards
+ *   the streak, as a percentage of the total capacity in [0, 100]
+ * \param[in] number_of_waits consecutive low occupancy waits required
+ *   before the wait set is shrunk
+ * \return `RCL_RET_OK` if the policy was set successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_set_shrink_policy(
+  rcl_wait_set_t * wait_set,
+  uint8_t occupancy_percent,
+  size_t number_of_waits);
+
 /// Store a pointer to the guard condition in the next empty spot in the set.
 /**
  * This function behaves exactly the same as for subscriptions.
@@ -327,6 +713,81 @@ rcl_wait_set_add_client(
   const rcl_client_t * client,
   size_t * index);
 
+/// Store pointers to a client group's members in the next empty client spots.
+/**
+ * Every member of the group consumes one client spot in the set, so the wait
+ * set must have been sized with enough client capacity for its individually
+ * added clients plus all grouped ones.  After a wait the group is reported
+ * as at most one entry of type `RCL_WAIT_SET_CLIENT_GROUP` in the ready
+ * entity list (see rcl_wait_set_get_ready_entities()), with the index
+ * written to the optional `index` argument here, and the members with a
+ * pending response are listed by rcl_client_group_get_ready_clients();
+ * grouped members never appear as individual `RCL_WAIT_SET_CLIENT` entries.
+ *
+ * The group must hold at least one client when it is added.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct in which the group's clients are stored
+ * \param[in] group the client group to be added to the wait set
+ * \param[out] index the index of the group in the ready entity list, or `NULL`
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   group is empty, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_FULL` if the client set is full, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_client_group(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_group_t * group,
+  size_t * index);
+
+/// Add a deadline event to the wait set.
+/**
+ * Events are tracked next to the wait set's entity arrays and do not occupy
+ * an entity spot of their own; instead the wait set can hold at most as many
+ * events as its guard condition capacity, so size the guard condition count
+ * given to rcl_wait_set_init() to cover guard conditions plus events.  The
+ * wait wakes no later than the earliest event deadline, and a missed
+ * deadline is reported as an entry of type `RCL_WAIT_SET_EVENT` in the ready
+ * entity list (see rcl_wait_set_get_ready_entities()), with the index
+ * written to the optional `index` argument here; take it with
+ * rcl_event_take().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct in which the event is tracked
+ * \param[in] event the event to be added to the wait set
+ * \param[out] index the index of the event in the ready entity list, or `NULL`
+ * \return `RCL_RET_OK` if added successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_FULL` if the event capacity is exhausted.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_add_event(
+  rcl_wait_set_t * wait_set,
+  const rcl_event_t * event,
+  size_t * index);
+
 /// Store a pointer to the service in the next empty spot in the set.
 /**
  * This function behaves exactly the same as for subscriptions.
@@ -340,6 +801,93 @@ rcl_wait_set_add_service(
   const rcl_service_t * service,
   size_t * index);
 
+/// Remove a previously added subscription from the wait set.
+/**
+ * The first entry matching the given subscription is removed and the entries
+ * after it move down one spot, so indices returned by earlier add calls are
+ * no longer valid, nor is the ready entity list of the last wait.
+ *
+ * Combined with retained mode (see rcl_wait_set_set_retained()) this makes
+ * moving an entity between two wait sets a remove from one and an add to the
+ * other, instead of clearing and repopulating either set.
+ * An executor running one wait set per thread can rebalance this way, e.g.
+ * shedding entities from a busy thread's set to an idle one based on the
+ * per set load counters (see rcl_wait_set_get_load()); each wait set must
+ * still only be modified and waited on by one thread at a time.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] wait_set struct from which the subscription is removed
+ * \param[in] subscription the subscription to be removed
+ * \return `RCL_RET_OK` if removed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid or the
+ *   subscription is not in the wait set, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_remove_subscription(
+  rcl_wait_set_t * wait_set,
+  const rcl_subscription_t * subscription);
+
+/// Remove a previously added guard condition from the wait set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_remove_subscription
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_remove_guard_condition(
+  rcl_wait_set_t * wait_set,
+  const rcl_guard_condition_t * guard_condition);
+
+/// Remove a previously added timer from the wait set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_remove_subscription
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_remove_timer(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t * timer);
+
+/// Remove a previously added client from the wait set.
+/**
+ * This function behaves exactly the same as for subscriptions, except that
+ * clients added as part of a client group (see rcl_wait_set_add_client_group())
+ * cannot be removed individually; attempting to do so fails with
+ * `RCL_RET_INVALID_ARGUMENT` and leaves the wait set unchanged.
+ * \see rcl_wait_set_remove_subscription
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_remove_client(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_t * client);
+
+/// Remove a previously added service from the wait set.
+/**
+ * This function behaves exactly the same as for subscriptions.
+ * \see rcl_wait_set_remove_subscription
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_remove_service(
+  rcl_wait_set_t * wait_set,
+  const rcl_service_t * service);
+
 /// Block until the wait set is ready or until the timeout has been exceeded.
 /**
  * This function will collect the items in the rcl_wait_set_t and pass them
@@ -435,6 +983,132 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout);
 
+/// Block until the wait set is ready or until an absolute deadline passes.
+/**
+ * This function behaves like rcl_wait() with a positive timeout, except that
+ * the wake up time is given as an absolute time point of the given clock
+ * rather than as a relative duration.
+ * The deadline is converted to a relative timeout immediately before waiting,
+ * so callers waking up periodically do not accumulate drift from the time
+ * spent between their clock read and the wait, nor do they need to read the
+ * clock and subtract on every spin themselves.
+ *
+ * A deadline that already passed makes this function non-blocking, like a
+ * timeout of 0.
+ * Timers in the wait set still shorten the effective wake up time as they do
+ * in rcl_wait().
+ *
+ * \see rcl_wait() for the behavior, thread-safety, and failure modes shared
+ *   with this function.
+ *
+ * \param[inout] wait_set the set of things to be waited on and to be pruned if not ready
+ * \param[in] deadline the absolute time to wake up at, if nothing is ready sooner
+ * \param[in] clock the clock the deadline is measured against
+ * \return `RCL_RET_OK` something in the wait set became ready, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized, or
+ * \return `RCL_RET_WAIT_SET_EMPTY` if the wait set contains no items, or
+ * \return `RCL_RET_TIMEOUT` if the deadline passed before anything was ready, or
+ * \return `RCL_RET_ERROR` an unspecified error occur.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_until(
+  rcl_wait_set_t * wait_set,
+  rcl_time_point_value_t deadline,
+  rcl_clock_t * clock);
+
+/// Get the compact list of entities made ready by the last rcl_wait() call.
+/**
+ * As an alternative to scanning every entity array for non-`NULL` entries,
+ * this returns a pointer to a compact array of (kind, index) pairs which was
+ * populated while rcl_wait() pruned the entity arrays.
+ * For large wait sets with few ready entities this avoids touching the
+ * entire set after every wake up.
+ *
+ * The returned array is owned by the wait set and is only valid until the
+ * next call to rcl_wait(), rcl_wait_set_resize(), or rcl_wait_set_fini().
+ * Calling this before rcl_wait() has been called yields a count of zero.
+ *
+ * The entries are ordered by descending priority (see the priority field of
+ * rcl_subscription_options_t and rcl_service_options_t; entities without a
+ * priority field have priority 0), and entities of equal priority keep the
+ * order in which they were found ready, so dispatching the list front to
+ * back serves urgent entities first without any post-wait sorting.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set that was waited on
+ * \param[out] ready_entities pointer to be set to the ready entity array
+ * \param[out] number_of_ready_entities the number of valid entries in the array
+ * \return `RCL_RET_OK` if the list was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_ready_entities(
+  const rcl_wait_set_t * wait_set,
+  const rcl_ready_entity_t ** ready_entities,
+  size_t * number_of_ready_entities);
+
+/// Cumulative load statistics of one wait set, see rcl_wait_set_get_load().
+typedef struct rcl_wait_set_load_t
+{
+  /// Number of entities currently added to the wait set, of all kinds.
+  size_t entity_count;
+  /// Number of completed waits the wait set took part in, directly or as an
+  /// attached child.
+  uint64_t wait_count;
+  /// Number of those waits which ended with at least one entity ready.
+  uint64_t wake_count;
+  /// Total number of entities reported ready across all waits.
+  uint64_t ready_entity_count;
+} rcl_wait_set_load_t;
+
+/// Get cumulative load statistics for a wait set.
+/**
+ * The counters accumulate over the wait set's lifetime: every completed wait
+ * the set takes part in, directly or as a child attached with
+ * rcl_wait_set_attach(), counts one wait, one wake if any of the set's own
+ * entities was ready, and the number of its ready entities.
+ *
+ * The counters are written with atomic stores by the waiting thread and read
+ * with atomic loads here, so an executor running one wait set per thread can
+ * compare the load of those sets from any thread without interrupting the
+ * waits, and migrate entities from a busy set to an idle one (see
+ * rcl_wait_set_remove_subscription()).
+ * The entity count, by contrast, is maintained by the add and remove calls;
+ * it is exact when read from the thread modifying the wait set and may lag
+ * behind in-flight modifications when read from another.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
+ * Lock-Free          | Yes
+ *
+ * \param[in] wait_set the wait set to query
+ * \param[out] load struct the statistics are copied into
+ * \return `RCL_RET_OK` if the statistics were retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_WAIT_SET_INVALID` if the wait set is zero initialized.
+ */
+RCL_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_wait_set_get_load(const rcl_wait_set_t * wait_set, rcl_wait_set_load_t * load);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,223 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/arena.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+
+// Alignment of every carved allocation; also the size of the per-allocation
+// header that records the requested size for reallocate.
+#define RCL_ARENA_ALIGNMENT (sizeof(max_align_t))
+
+// Cap on block size growth so a long-lived arena doesn't hold huge blocks.
+#define RCL_ARENA_MAX_BLOCK_SIZE (1024u * 1024u)
+
+typedef struct rcl_arena_block_t
+{
+  struct rcl_arena_block_t * next;
+  size_t capacity;
+  size_t used;
+  // block data follows the header, at an aligned offset
+} rcl_arena_block_t;
+
+/// Round a size up to the arena alignment.
+static size_t
+_rcl_arena_align(size_t size)
+{
+  return (size + RCL_ARENA_ALIGNMENT - 1u) & ~(RCL_ARENA_ALIGNMENT - 1u);
+}
+
+/// Get the start of a block's data area.
+static uint8_t *
+_rcl_arena_block_data(rcl_arena_block_t * block)
+{
+  return (uint8_t *)block + _rcl_arena_align(sizeof(rcl_arena_block_t));
+}
+
+static void *
+_rcl_arena_allocate(size_t size, void * state)
+{
+  rcl_arena_t * arena = (rcl_arena_t *)state;
+  if (0u == size) {
+    return NULL;
+  }
+  // a header slot records the requested size, then the aligned payload
+  size_t needed = RCL_ARENA_ALIGNMENT + _rcl_arena_align(size);
+  rcl_arena_block_t * block = arena->blocks;
+  if (NULL == block || block->capacity - block->used < needed) {
+    size_t capacity = arena->next_block_size;
+    if (capacity < needed) {
+      capacity = needed;
+    }
+    block = (rcl_arena_block_t *)arena->allocator.allocate(
+      _rcl_arena_align(sizeof(rcl_arena_block_t)) + capacity, arena->allocator.state);
+    if (NULL == block) {
+      return NULL;
+    }
+    block->next = arena->blocks;
+    block->capacity = capacity;
+    block->used = 0u;
+    arena->blocks = block;
+    // grow geometrically so the number of underlying allocations stays small
+    if (arena->next_block_size < RCL_ARENA_MAX_BLOCK_SIZE) {
+      arena->next_block_size *= 2u;
+    }
+  }
+  uint8_t * header = _rcl_arena_block_data(block) + block->used;
+  *(size_t *)header = size;
+  block->used += needed;
+  return header + RCL_ARENA_ALIGNMENT;
+}
+
+static void
+_rcl_arena_deallocate(void * pointer, void * state)
+{
+  // individual allocations are released with the arena as a whole
+  (void)pointer;
+  (void)state;
+}
+
+static void *
+_rcl_arena_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (0u != size_of_element && number_of_elements > SIZE_MAX / size_of_element) {
+    return NULL;
+  }
+  size_t size = number_of_elements * size_of_element;
+  void * pointer = _rcl_arena_allocate(size, state);
+  if (NULL != pointer) {
+    memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+static void *
+_rcl_arena_reallocate(void * pointer, size_t size, void * state)
+{
+  if (NULL == pointer) {
+    return _rcl_arena_allocate(size, state);
+  }
+  size_t old_size = *(size_t *)((uint8_t *)pointer - RCL_ARENA_ALIGNMENT);
+  if (size <= old_size) {
+    // shrinking in place just wastes the tail until the arena is released
+    return pointer;
+  }
+  void * new_pointer = _rcl_arena_allocate(size, state);
+  if (NULL != new_pointer) {
+    memcpy(new_pointer, pointer, old_size);
+  }
+  return new_pointer;
+}
+
+rcl_arena_t
+rcl_get_zero_initialized_arena(void)
+{
+  static rcl_arena_t zero_arena;
+  return zero_arena;
+}
+
+rcl_ret_t
+rcl_arena_init(
+  rcl_arena_t * arena,
+  size_t initial_block_size,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(arena, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (NULL != arena->blocks) {
+    RCL_SET_ERROR_MSG("arena is not zero initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  arena->blocks = NULL;
+  arena->next_block_size = _rcl_arena_align(initial_block_size > 0u ? initial_block_size : 1u);
+  arena->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+void
+rcl_arena_fini(rcl_arena_t * arena)
+{
+  if (NULL == arena) {
+    return;
+  }
+  rcl_arena_block_t * block = arena->blocks;
+  while (NULL != block) {
+    rcl_arena_block_t * next = block->next;
+    arena->allocator.deallocate(block, arena->allocator.state);
+    block = next;
+  }
+  arena->blocks = NULL;
+}
+
+void
+rcl_arena_reset(rcl_arena_t * arena)
+{
+  if (NULL == arena || NULL == arena->blocks) {
+    return;
+  }
+  // the head block is the most recently (and largest) allocated one;
+  // keep it rewound for reuse and release the rest of the chain
+  rcl_arena_block_t * keep = arena->blocks;
+  rcl_arena_block_t * block = keep->next;
+  while (NULL != block) {
+    rcl_arena_block_t * next = block->next;
+    arena->allocator.deallocate(block, arena->allocator.state);
+    block = next;
+  }
+  keep->next = NULL;
+  keep->used = 0u;
+  arena->blocks = keep;
+}
+
+rcl_allocator_t
+rcl_arena_get_allocator(rcl_arena_t * arena)
+{
+  rcl_allocator_t allocator = {
+    .allocate = _rcl_arena_allocate,
+    .deallocate = _rcl_arena_deallocate,
+    .reallocate = _rcl_arena_reallocate,
+    .zero_allocate = _rcl_arena_zero_allocate,
+    .state = arena,
+  };
+  return allocator;
+}
+
+rcl_ret_t
+rcl_arena_allocator_init(
+  rcl_allocator_t * allocator,
+  rcl_arena_t * arena,
+  size_t initial_block_size,
+  rcl_allocator_t parent)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_arena_init(arena, initial_block_size, parent);
+  if (RCL_RET_OK != ret) {
+    // error already set
+    return ret;
+  }
+  *allocator = rcl_arena_get_allocator(arena);
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -20,6 +20,7 @@
 
 #include "./arguments_impl.h"
 #include "./remap_impl.h"
+#include "rcl/counting_allocator.h"
 #include "rcl/error_handling.h"
 #include "rcl/lexer_lookahead.h"
 #include "rcl/validate_topic_name.h"
@@ -104,6 +105,21 @@ rcl_arguments_get_param_files(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_arguments_get_param_files_view(
+  const rcl_arguments_t * arguments,
+  const char * const ** parameter_files,
+  int * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(arguments, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(arguments->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(parameter_files, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  *parameter_files = (const char * const *)arguments->impl->parameter_files;
+  *count = arguments->impl->num_param_files_args;
+  return RCL_RET_OK;
+}
+
 int
 rcl_arguments_get_param_files_count(
   const rcl_arguments_t * args)
@@ -139,6 +155,9 @@ rcl_parse_arguments(
   rcl_arguments_t * args_output)
 {
   RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  // Attribute parsing allocations, arena pages included; a no-op unless
+  // accounting is on.
+  allocator = rcl_counting_allocator_wrap(allocator, RCL_ALLOC_TAG_ARGUMENTS);
   if (argc < 0) {
     RCL_SET_ERROR_MSG("Argument count cannot be negative");
     return RCL_RET_INVALID_ARGUMENT;
@@ -162,11 +181,14 @@ rcl_parse_arguments(
   rcl_arguments_impl_t * args_impl = args_output->impl;
   args_impl->num_remap_rules = 0;
   args_impl->remap_rules = NULL;
+  args_impl->remap_index = NULL;
   args_impl->log_level = -1;
   args_impl->unparsed_args = NULL;
   args_impl->num_unparsed_args = 0;
   args_impl->parameter_files = NULL;
   args_impl->num_param_files_args = 0;
+  args_impl->arena = rcl_get_zero_initialized_arena();
+  atomic_init(&args_impl->reference_count, 1u);
   args_impl->allocator = allocator;
 
   if (argc == 0) {
@@ -174,18 +196,30 @@ rcl_parse_arguments(
     return RCL_RET_OK;
   }
 
-  // over-allocate arrays to match the number of arguments
-  args_impl->remap_rules = allocator.allocate(sizeof(rcl_remap_t) * argc, allocator.state);
+  // Everything parsed out of argv is carved from one arena and freed as a
+  // unit in rcl_arguments_fini(), instead of making per-rule allocations.
+  ret = rcl_arena_init(&(args_impl->arena), (size_t)argc * 128u + 1024u, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;  // error already set
+  }
+  rcl_allocator_t arena_allocator = rcl_arena_get_allocator(&(args_impl->arena));
+
+  // over-allocate arrays to match the number of arguments; the unused tails
+  // cost nothing beyond their arena space
+  args_impl->remap_rules = arena_allocator.allocate(
+    sizeof(rcl_remap_t) * argc, arena_allocator.state);
   if (NULL == args_impl->remap_rules) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
   }
-  args_impl->unparsed_args = allocator.allocate(sizeof(int) * argc, allocator.state);
+  args_impl->unparsed_args = arena_allocator.allocate(
+    sizeof(int) * argc, arena_allocator.state);
   if (NULL == args_impl->unparsed_args) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
   }
-  args_impl->parameter_files = allocator.allocate(sizeof(char *) * argc, allocator.state);
+  args_impl->parameter_files = arena_allocator.allocate(
+    sizeof(char *) * argc, arena_allocator.state);
   if (NULL == args_impl->parameter_files) {
     ret = RCL_RET_BAD_ALLOC;
     goto fail;
@@ -196,7 +230,7 @@ rcl_parse_arguments(
     args_impl->parameter_files[args_impl->num_param_files_args] = NULL;
     if (
       RCL_RET_OK == _rcl_parse_param_file_rule(
-        argv[i], allocator, &(args_impl->parameter_files[args_impl->num_param_files_args])))
+        argv[i], arena_allocator, &(args_impl->parameter_files[args_impl->num_param_files_args])))
     {
       ++(args_impl->num_param_files_args);
       RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME,
@@ -213,8 +247,13 @@ rcl_parse_arguments(
     // Attempt to parse argument as remap rule
     rcl_remap_t * rule = &(args_impl->remap_rules[args_impl->num_remap_rules]);
     *rule = rcl_remap_get_zero_initialized();
-    if (RCL_RET_OK == _rcl_parse_remap_rule(argv[i], allocator, rule)) {
+    if (RCL_RET_OK == _rcl_parse_remap_rule(argv[i], arena_allocator, rule)) {
       ++(args_impl->num_remap_rules);
+      // Precompile node independent rules so lookups skip the expansion step.
+      ret = rcl_remap_compile(rule);
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
+      }
       continue;
     }
     RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME,
@@ -223,7 +262,7 @@ rcl_parse_arguments(
 
     // Attempt to parse argument as log level configuration
     int log_level;
-    if (RCL_RET_OK == _rcl_parse_log_level_rule(argv[i], allocator, &log_level)) {
+    if (RCL_RET_OK == _rcl_parse_log_level_rule(argv[i], arena_allocator, &log_level)) {
       args_impl->log_level = log_level;
       continue;
     }
@@ -237,43 +276,25 @@ rcl_parse_arguments(
     ++(args_impl->num_unparsed_args);
   }
 
-  // Shrink remap_rules array to match number of successfully parsed rules
+  // The arrays live in the arena, so empty ones are just dropped rather
+  // than deallocated, and partially used ones are not worth shrinking
+  if (0 == args_impl->num_remap_rules) {
+    args_impl->remap_rules = NULL;
+  }
+  // Index the precompiled rules so lookups don't scan the whole rule array
   if (args_impl->num_remap_rules > 0) {
-    args_impl->remap_rules = rcutils_reallocf(
-      args_impl->remap_rules, sizeof(rcl_remap_t) * args_impl->num_remap_rules, &allocator);
-    if (NULL == args_impl->remap_rules) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
+    ret = rcl_remap_index_init(
+      &(args_impl->remap_index), args_impl->remap_rules, args_impl->num_remap_rules,
+      arena_allocator);
+    if (RCL_RET_OK != ret) {
+      goto fail;  // error already set
     }
-  } else {
-    // No remap rules
-    allocator.deallocate(args_impl->remap_rules, allocator.state);
-    args_impl->remap_rules = NULL;
   }
-  // Shrink Parameter files
   if (0 == args_impl->num_param_files_args) {
-    allocator.deallocate(args_impl->parameter_files, allocator.state);
     args_impl->parameter_files = NULL;
-  } else if (args_impl->num_param_files_args < argc) {
-    args_impl->parameter_files = rcutils_reallocf(
-      args_impl->parameter_files, sizeof(char *) * args_impl->num_param_files_args, &allocator);
-    if (NULL == args_impl->parameter_files) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
-    }
   }
-  // Shrink unparsed_args
   if (0 == args_impl->num_unparsed_args) {
-    // No unparsed args
-    allocator.deallocate(args_impl->unparsed_args, allocator.state);
     args_impl->unparsed_args = NULL;
-  } else if (args_impl->num_unparsed_args < argc) {
-    args_impl->unparsed_args = rcutils_reallocf(
-      args_impl->unparsed_args, sizeof(int) * args_impl->num_unparsed_args, &allocator);
-    if (NULL == args_impl->unparsed_args) {
-      ret = RCL_RET_BAD_ALLOC;
-      goto fail;
-    }
   }
 
   return RCL_RET_OK;
@@ -387,124 +408,376 @@ rcl_arguments_copy(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  rcl_allocator_t allocator = args->impl->allocator;
+  // The parsed rules are never modified after parsing, so a copy is just
+  // another reference to the same storage.
+  atomic_fetch_add_explicit(&args->impl->reference_count, 1u, memory_order_relaxed);
+  args_out->impl = args->impl;
+  return RCL_RET_OK;
+}
 
-  args_out->impl = allocator.allocate(sizeof(rcl_arguments_impl_t), allocator.state);
-  if (NULL == args_out->impl) {
-    return RCL_RET_BAD_ALLOC;
+rcl_ret_t
+rcl_arguments_fini(
+  rcl_arguments_t * args)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
+  if (args->impl) {
+    // Release one reference; the storage stays alive while other
+    // rcl_arguments_t still share it.
+    // acq_rel orders the release of the last reference after all prior use.
+    if (1u != atomic_fetch_sub_explicit(
+        &args->impl->reference_count, 1u, memory_order_acq_rel))
+    {
+      args->impl = NULL;
+      return RCL_RET_OK;
+    }
+    // The rule strings, rule and index arrays, parameter file paths, and
+    // the remap index are all carved from the arena and released with it
+    args->impl->remap_index = NULL;
+    args->impl->remap_rules = NULL;
+    args->impl->num_remap_rules = 0;
+    args->impl->unparsed_args = NULL;
+    args->impl->num_unparsed_args = 0;
+    args->impl->parameter_files = NULL;
+    args->impl->num_param_files_args = 0;
+    rcl_arena_fini(&(args->impl->arena));
+
+    args->impl->allocator.deallocate(args->impl, args->impl->allocator.state);
+    args->impl = NULL;
+    return RCL_RET_OK;
   }
+  RCL_SET_ERROR_MSG("rcl_arguments_t finalized twice");
+  return RCL_RET_ERROR;
+}
 
-  args_out->impl->allocator = allocator;
+// Serialized arguments blob layout: a fixed header, the unparsed argument
+// indices, the parameter file offset array, the remap rule records, then the
+// string data.  Strings are referenced by their byte offset from the start of
+// the blob; offset zero (inside the header) doubles as NULL.
 
-  // Zero so it's safe to call rcl_arguments_fini() if an error occurrs while copying.
-  args_out->impl->num_remap_rules = 0;
-  args_out->impl->num_unparsed_args = 0;
-  args_out->impl->num_param_files_args = 0;
+#define RCL_ARGUMENTS_BLOB_MAGIC 0x414C4352u  // "RCLA"
+#define RCL_ARGUMENTS_BLOB_VERSION 1u
 
-  // Copy unparsed args
-  args_out->impl->unparsed_args = allocator.allocate(
-    sizeof(int) * args->impl->num_unparsed_args, allocator.state);
-  if (NULL == args_out->impl->unparsed_args) {
-    if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-      RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-    }
+typedef struct rcl_arguments_blob_header_t
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t total_size;
+  int32_t log_level;
+  int32_t num_unparsed_args;
+  int32_t num_param_files;
+  int32_t num_remap_rules;
+} rcl_arguments_blob_header_t;
+
+typedef struct rcl_arguments_blob_rule_t
+{
+  uint32_t type;
+  uint32_t reserved;
+  uint64_t node_name;
+  uint64_t match;
+  uint64_t replacement;
+  uint64_t compiled_match;
+  uint64_t compiled_replacement;
+} rcl_arguments_blob_rule_t;
+
+/// Number of bytes a string occupies in the blob's string section.
+static size_t
+__blob_string_size(const char * value)
+{
+  return (NULL != value) ? strlen(value) + 1u : 0u;
+}
+
+/// Append a string to the blob's string section, returning its offset.
+static uint64_t
+__blob_write_string(uint8_t * blob, size_t * cursor, const char * value)
+{
+  if (NULL == value) {
+    return 0u;
+  }
+  size_t size = strlen(value) + 1u;
+  memcpy(blob + *cursor, value, size);
+  uint64_t offset = (uint64_t)*cursor;
+  *cursor += size;
+  return offset;
+}
+
+/// Copy a string out of the blob into the arena, validating its framing.
+static rcl_ret_t
+__blob_read_string(
+  const uint8_t * buffer,
+  size_t buffer_length,
+  uint64_t offset,
+  rcl_allocator_t arena_allocator,
+  char ** output)
+{
+  *output = NULL;
+  if (0u == offset) {
+    return RCL_RET_OK;
+  }
+  if (offset >= (uint64_t)buffer_length) {
+    RCL_SET_ERROR_MSG("string offset in serialized arguments is out of range");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const char * start = (const char *)buffer + offset;
+  const void * terminator = memchr(start, '\0', buffer_length - (size_t)offset);
+  if (NULL == terminator) {
+    RCL_SET_ERROR_MSG("unterminated string in serialized arguments");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  size_t size = (size_t)((const char *)terminator - start) + 1u;
+  char * copy = arena_allocator.allocate(size, arena_allocator.state);
+  if (NULL == copy) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
     return RCL_RET_BAD_ALLOC;
   }
-  for (int i = 0; i < args->impl->num_unparsed_args; ++i) {
-    args_out->impl->unparsed_args[i] = args->impl->unparsed_args[i];
+  memcpy(copy, start, size);
+  *output = copy;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_arguments_serialize(
+  const rcl_arguments_t * args,
+  rcl_allocator_t allocator,
+  uint8_t ** buffer,
+  size_t * buffer_length)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(args->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer_length, RCL_RET_INVALID_ARGUMENT);
+  const rcl_arguments_impl_t * impl = args->impl;
+
+  // Size the sections; the rule records are kept 8 byte aligned by padding
+  // after the unparsed indices.
+  size_t unparsed_offset = sizeof(rcl_arguments_blob_header_t);
+  size_t unparsed_bytes = sizeof(int32_t) * (size_t)impl->num_unparsed_args;
+  size_t param_files_offset = unparsed_offset + unparsed_bytes;
+  param_files_offset += (8u - param_files_offset % 8u) % 8u;
+  size_t rules_offset =
+    param_files_offset + sizeof(uint64_t) * (size_t)impl->num_param_files_args;
+  size_t strings_offset =
+    rules_offset + sizeof(rcl_arguments_blob_rule_t) * (size_t)impl->num_remap_rules;
+  size_t total_size = strings_offset;
+  for (int i = 0; i < impl->num_param_files_args; ++i) {
+    total_size += __blob_string_size(impl->parameter_files[i]);
+  }
+  for (int i = 0; i < impl->num_remap_rules; ++i) {
+    const rcl_remap_t * rule = &(impl->remap_rules[i]);
+    total_size += __blob_string_size(rule->node_name);
+    total_size += __blob_string_size(rule->match);
+    total_size += __blob_string_size(rule->replacement);
+    total_size += __blob_string_size(rule->compiled_match);
+    total_size += __blob_string_size(rule->compiled_replacement);
+  }
+
+  uint8_t * blob = allocator.zero_allocate(1, total_size, allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(blob, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+
+  rcl_arguments_blob_header_t header = {
+    .magic = RCL_ARGUMENTS_BLOB_MAGIC,
+    .version = RCL_ARGUMENTS_BLOB_VERSION,
+    .total_size = (uint64_t)total_size,
+    .log_level = (int32_t)impl->log_level,
+    .num_unparsed_args = (int32_t)impl->num_unparsed_args,
+    .num_param_files = (int32_t)impl->num_param_files_args,
+    .num_remap_rules = (int32_t)impl->num_remap_rules,
+  };
+  memcpy(blob, &header, sizeof(header));
+  for (int i = 0; i < impl->num_unparsed_args; ++i) {
+    int32_t index = (int32_t)impl->unparsed_args[i];
+    memcpy(blob + unparsed_offset + sizeof(int32_t) * (size_t)i, &index, sizeof(index));
+  }
+  size_t cursor = strings_offset;
+  for (int i = 0; i < impl->num_param_files_args; ++i) {
+    uint64_t offset = __blob_write_string(blob, &cursor, impl->parameter_files[i]);
+    memcpy(blob + param_files_offset + sizeof(uint64_t) * (size_t)i, &offset, sizeof(offset));
+  }
+  for (int i = 0; i < impl->num_remap_rules; ++i) {
+    const rcl_remap_t * rule = &(impl->remap_rules[i]);
+    rcl_arguments_blob_rule_t record = {
+      .type = (uint32_t)rule->type,
+      .reserved = 0u,
+      .node_name = __blob_write_string(blob, &cursor, rule->node_name),
+      .match = __blob_write_string(blob, &cursor, rule->match),
+      .replacement = __blob_write_string(blob, &cursor, rule->replacement),
+      .compiled_match = __blob_write_string(blob, &cursor, rule->compiled_match),
+      .compiled_replacement = __blob_write_string(blob, &cursor, rule->compiled_replacement),
+    };
+    memcpy(blob + rules_offset + sizeof(record) * (size_t)i, &record, sizeof(record));
+  }
+
+  *buffer = blob;
+  *buffer_length = total_size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_arguments_deserialize(
+  const uint8_t * buffer,
+  size_t buffer_length,
+  rcl_allocator_t allocator,
+  rcl_arguments_t * args_out)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(args_out, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != args_out->impl) {
+    RCL_SET_ERROR_MSG("Deserialize output is not zero-initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (buffer_length < sizeof(rcl_arguments_blob_header_t)) {
+    RCL_SET_ERROR_MSG("serialized arguments blob is truncated");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_arguments_blob_header_t header;
+  memcpy(&header, buffer, sizeof(header));
+  if (RCL_ARGUMENTS_BLOB_MAGIC != header.magic) {
+    RCL_SET_ERROR_MSG("buffer is not a serialized arguments blob");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (RCL_ARGUMENTS_BLOB_VERSION != header.version) {
+    RCL_SET_ERROR_MSG("serialized arguments blob has an unsupported version");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (header.total_size > (uint64_t)buffer_length ||
+    header.num_unparsed_args < 0 || header.num_param_files < 0 || header.num_remap_rules < 0)
+  {
+    RCL_SET_ERROR_MSG("serialized arguments blob is malformed");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  buffer_length = (size_t)header.total_size;
+  size_t unparsed_offset = sizeof(rcl_arguments_blob_header_t);
+  size_t param_files_offset =
+    unparsed_offset + sizeof(int32_t) * (size_t)header.num_unparsed_args;
+  param_files_offset += (8u - param_files_offset % 8u) % 8u;
+  size_t rules_offset =
+    param_files_offset + sizeof(uint64_t) * (size_t)header.num_param_files;
+  size_t strings_offset =
+    rules_offset + sizeof(rcl_arguments_blob_rule_t) * (size_t)header.num_remap_rules;
+  if (strings_offset > buffer_length) {
+    RCL_SET_ERROR_MSG("serialized arguments blob is truncated");
+    return RCL_RET_INVALID_ARGUMENT;
   }
-  args_out->impl->num_unparsed_args = args->impl->num_unparsed_args;
 
-  // Copy remap rules
-  args_out->impl->remap_rules = allocator.allocate(
-    sizeof(rcl_remap_t) * args->impl->num_remap_rules, allocator.state);
-  if (NULL == args_out->impl->remap_rules) {
-    if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-      RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-    }
+  rcl_ret_t ret;
+  rcl_ret_t fail_ret;
+  args_out->impl = allocator.allocate(sizeof(rcl_arguments_impl_t), allocator.state);
+  if (NULL == args_out->impl) {
     return RCL_RET_BAD_ALLOC;
   }
-  args_out->impl->num_remap_rules = args->impl->num_remap_rules;
-  for (int i = 0; i < args->impl->num_remap_rules; ++i) {
-    args_out->impl->remap_rules[i] = rcl_remap_get_zero_initialized();
-    rcl_ret_t ret = rcl_remap_copy(
-      &(args->impl->remap_rules[i]), &(args_out->impl->remap_rules[i]));
-    if (RCL_RET_OK != ret) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return ret;
+  rcl_arguments_impl_t * args_impl = args_out->impl;
+  args_impl->num_remap_rules = 0;
+  args_impl->remap_rules = NULL;
+  args_impl->remap_index = NULL;
+  args_impl->log_level = (int)header.log_level;
+  args_impl->unparsed_args = NULL;
+  args_impl->num_unparsed_args = 0;
+  args_impl->parameter_files = NULL;
+  args_impl->num_param_files_args = 0;
+  args_impl->arena = rcl_get_zero_initialized_arena();
+  atomic_init(&args_impl->reference_count, 1u);
+  args_impl->allocator = allocator;
+
+  // Like rcl_parse_arguments(), everything loaded out of the blob is carved
+  // from one arena and freed as a unit in rcl_arguments_fini().
+  ret = rcl_arena_init(&(args_impl->arena), buffer_length + 1024u, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;  // error already set
+  }
+  rcl_allocator_t arena_allocator = rcl_arena_get_allocator(&(args_impl->arena));
+
+  if (header.num_unparsed_args > 0) {
+    args_impl->unparsed_args = arena_allocator.allocate(
+      sizeof(int) * (size_t)header.num_unparsed_args, arena_allocator.state);
+    if (NULL == args_impl->unparsed_args) {
+      ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+    for (int i = 0; i < header.num_unparsed_args; ++i) {
+      int32_t index;
+      memcpy(&index, buffer + unparsed_offset + sizeof(int32_t) * (size_t)i, sizeof(index));
+      args_impl->unparsed_args[i] = (int)index;
     }
+    args_impl->num_unparsed_args = (int)header.num_unparsed_args;
   }
-  // Copy parameter files
-  if (args->impl->num_param_files_args) {
-    args_out->impl->parameter_files = allocator.allocate(
-      sizeof(char *) * args->impl->num_param_files_args, allocator.state);
-    if (NULL == args_out->impl->parameter_files) {
-      if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-        RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-      }
-      return RCL_RET_BAD_ALLOC;
+  if (header.num_param_files > 0) {
+    args_impl->parameter_files = arena_allocator.allocate(
+      sizeof(char *) * (size_t)header.num_param_files, arena_allocator.state);
+    if (NULL == args_impl->parameter_files) {
+      ret = RCL_RET_BAD_ALLOC;
+      goto fail;
     }
-    args_out->impl->num_param_files_args = args->impl->num_param_files_args;
-    for (int i = 0; i < args->impl->num_param_files_args; ++i) {
-      args_out->impl->parameter_files[i] =
-        rcutils_strdup(args->impl->parameter_files[i], allocator);
-      if (NULL == args_out->impl->parameter_files[i]) {
-        if (RCL_RET_OK != rcl_arguments_fini(args_out)) {
-          RCL_SET_ERROR_MSG("Error while finalizing arguments due to another error");
-        }
-        return RCL_RET_BAD_ALLOC;
+    for (int i = 0; i < header.num_param_files; ++i) {
+      uint64_t offset;
+      memcpy(&offset, buffer + param_files_offset + sizeof(uint64_t) * (size_t)i, sizeof(offset));
+      ret = __blob_read_string(
+        buffer, buffer_length, offset, arena_allocator,
+        &(args_impl->parameter_files[i]));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
       }
     }
-  } else {
-    args_out->impl->parameter_files = NULL;
+    args_impl->num_param_files_args = (int)header.num_param_files;
   }
-  return RCL_RET_OK;
-}
-
-rcl_ret_t
-rcl_arguments_fini(
-  rcl_arguments_t * args)
-{
-  RCL_CHECK_ARGUMENT_FOR_NULL(args, RCL_RET_INVALID_ARGUMENT);
-  if (args->impl) {
-    rcl_ret_t ret = RCL_RET_OK;
-    if (args->impl->remap_rules) {
-      for (int i = 0; i < args->impl->num_remap_rules; ++i) {
-        rcl_ret_t remap_ret = rcl_remap_fini(&(args->impl->remap_rules[i]));
-        if (remap_ret != RCL_RET_OK) {
-          ret = remap_ret;
-          RCUTILS_LOG_ERROR_NAMED(
-            ROS_PACKAGE_NAME,
-            "Failed to finalize remap rule while finalizing arguments. Continuing...");
-        }
-      }
-      args->impl->allocator.deallocate(args->impl->remap_rules, args->impl->allocator.state);
-      args->impl->remap_rules = NULL;
-      args->impl->num_remap_rules = 0;
+  if (header.num_remap_rules > 0) {
+    args_impl->remap_rules = arena_allocator.allocate(
+      sizeof(rcl_remap_t) * (size_t)header.num_remap_rules, arena_allocator.state);
+    if (NULL == args_impl->remap_rules) {
+      ret = RCL_RET_BAD_ALLOC;
+      goto fail;
     }
-
-    args->impl->allocator.deallocate(args->impl->unparsed_args, args->impl->allocator.state);
-    args->impl->num_unparsed_args = 0;
-    args->impl->unparsed_args = NULL;
-
-    if (args->impl->parameter_files) {
-      for (int p = 0; p < args->impl->num_param_files_args; ++p) {
-        args->impl->allocator.deallocate(
-          args->impl->parameter_files[p], args->impl->allocator.state);
+    for (int i = 0; i < header.num_remap_rules; ++i) {
+      rcl_arguments_blob_rule_t record;
+      memcpy(&record, buffer + rules_offset + sizeof(record) * (size_t)i, sizeof(record));
+      rcl_remap_t * rule = &(args_impl->remap_rules[i]);
+      *rule = rcl_remap_get_zero_initialized();
+      rule->type = (rcl_remap_type_t)record.type;
+      rule->allocator = arena_allocator;
+      ret = __blob_read_string(
+        buffer, buffer_length, record.node_name, arena_allocator, &(rule->node_name));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
+      }
+      ret = __blob_read_string(
+        buffer, buffer_length, record.match, arena_allocator, &(rule->match));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
+      }
+      ret = __blob_read_string(
+        buffer, buffer_length, record.replacement, arena_allocator, &(rule->replacement));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
+      }
+      ret = __blob_read_string(
+        buffer, buffer_length, record.compiled_match, arena_allocator, &(rule->compiled_match));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
+      }
+      ret = __blob_read_string(
+        buffer, buffer_length, record.compiled_replacement, arena_allocator,
+        &(rule->compiled_replacement));
+      if (RCL_RET_OK != ret) {
+        goto fail;  // error already set
       }
-      args->impl->allocator.deallocate(args->impl->parameter_files, args->impl->allocator.state);
-      args->impl->num_param_files_args = 0;
-      args->impl->parameter_files = NULL;
+      ++(args_impl->num_remap_rules);
+    }
+    // The precompiled sides came with the blob; only the index is rebuilt.
+    ret = rcl_remap_index_init(
+      &(args_impl->remap_index), args_impl->remap_rules, args_impl->num_remap_rules,
+      arena_allocator);
+    if (RCL_RET_OK != ret) {
+      goto fail;  // error already set
     }
-
-    args->impl->allocator.deallocate(args->impl, args->impl->allocator.state);
-    args->impl = NULL;
-    return ret;
   }
-  RCL_SET_ERROR_MSG("rcl_arguments_t finalized twice");
-  return RCL_RET_ERROR;
+  return RCL_RET_OK;
+fail:
+  fail_ret = ret;
+  ret = rcl_arguments_fini(args_out);
+  if (RCL_RET_OK != ret) {
+    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to fini arguments after earlier failure");
+  }
+  return fail_ret;
 }
 
 /// Parses a fully qualified namespace for a namespace replacement rule (ex: `/foo/bar`)
@@ -15,6 +15,9 @@
 #ifndef RCL__ARGUMENTS_IMPL_H_
 #define RCL__ARGUMENTS_IMPL_H_
 
+#include <stdatomic.h>
+
+#include "rcl/arena.h"
 #include "rcl/arguments.h"
 #include "./remap_impl.h"
 
@@ -41,11 +44,28 @@ typedef struct rcl_arguments_impl_t
   rcl_remap_t * remap_rules;
   /// Length of remap_rules.
   int num_remap_rules;
+  /// Hash index over the precompiled rules in remap_rules, or NULL.
+  rcl_remap_index_t * remap_index;
 
   /// Default log level (represented by `RCUTILS_LOG_SEVERITY` enum) or -1 if not specified.
   int log_level;
 
-  /// Allocator used to allocate objects in this struct
+  /// Arena backing the rule strings and index arrays above.
+  /**
+   * Everything parsed out of argv is carved from this arena and released
+   * with it as a unit in rcl_arguments_fini().
+   */
+  rcl_arena_t arena;
+
+  /// Number of rcl_arguments_t sharing this struct.
+  /**
+   * The parsed rules are immutable, so rcl_arguments_copy() shares them by
+   * incrementing this count and rcl_arguments_fini() only releases the
+   * storage when the last reference is finalized.
+   */
+  atomic_uint_least64_t reference_count;
+
+  /// Allocator used to allocate this struct and the arena's blocks.
   rcl_allocator_t allocator;
 } rcl_arguments_impl_t;
 
@@ -25,21 +25,72 @@ extern "C"
 #include "rcl/error_handling.h"
 #include "rcl/expand_topic_name.h"
 #include "rcl/remap.h"
+#include "rcl/tracepoints.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
+#include "./entity_event_callbacks.h"
+#include "./entity_registry.h"
+#include "./entity_slab.h"
+#include "./entity_statistics.h"
+#include "./remap_cache.h"
+
 #include "./common.h"
 
+// One slot of the in-flight request table, see max_in_flight_requests.
+typedef struct rcl_client_in_flight_slot_t
+{
+  bool in_use;
+  int64_t sequence_number;
+  const void * user_data;
+} rcl_client_in_flight_slot_t;
+
 typedef struct rcl_client_impl_t
 {
   rcl_client_options_t options;
   rmw_client_t * rmw_handle;
   atomic_int_least64_t sequence_number;
+  // Invoked from the wait path when new responses are available,
+  // see rcl_client_set_on_new_response_callback().
+  rcl_event_callback_t on_new_response_callback;
+  const void * on_new_response_user_data;
+  // Open addressing table of outstanding requests, NULL if tracking is
+  // disabled; sized by options.max_in_flight_requests.
+  rcl_client_in_flight_slot_t * in_flight_slots;
+  size_t in_flight_count;
+  // User data of the request answered by the last taken response.
+  const void * completed_user_data;
+  // Hot path counters, NULL unless statistics were enabled in the options.
+  rcl_entity_statistics_t * statistics;
 } rcl_client_impl_t;
 
+/// Find the slot for a sequence number, or the first free slot when
+/// inserting; returns NULL when the table is full (insert) or the sequence
+/// number is not present (lookup).
+static rcl_client_in_flight_slot_t *
+__client_in_flight_find(const rcl_client_impl_t * impl, int64_t sequence_number, bool for_insert)
+{
+  const size_t capacity = impl->options.max_in_flight_requests;
+  size_t index = (size_t)((uint64_t)sequence_number % capacity);
+  for (size_t probes = 0; probes < capacity; ++probes) {
+    rcl_client_in_flight_slot_t * slot = &impl->in_flight_slots[index];
+    if (for_insert) {
+      if (!slot->in_use) {
+        return slot;
+      }
+    } else {
+      if (slot->in_use && slot->sequence_number == sequence_number) {
+        return slot;
+      }
+    }
+    index = (index + 1) % capacity;
+  }
+  return NULL;
+}
+
 rcl_client_t
 rcl_get_zero_initialized_client()
 {
@@ -73,46 +124,43 @@ rcl_client_init(
     RCL_SET_ERROR_MSG("client already initialized, or memory was unintialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given service name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (rcutils_ret == RCUTILS_RET_BAD_ALLOC) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s\n",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (ret == RCL_RET_BAD_ALLOC) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
+  // Expand the given service name, using the node's cached substitutions map.
+  const rcutils_string_map_t * substitutions_map = rcl_node_get_topic_name_substitutions(node);
+  if (NULL == substitutions_map) {
+    return RCL_RET_NODE_INVALID;  // error already set
   }
+  char expanded_name_buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
   char * expanded_service_name = NULL;
   char * remapped_service_name = NULL;
-  ret = rcl_expand_topic_name(
+  // The fused expansion validates the expanded name in the same pass, so the
+  // separate rmw validation below only runs when remapping changed the name.
+  bool expanded_name_validated = false;
+  int validation_result = RMW_TOPIC_VALID;
+  rcl_ret_t ret = rcl_expand_and_validate_topic_name_with_buffer(
     service_name,
     rcl_node_get_name(node),
     rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_service_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    allocator->deallocate(expanded_service_name, allocator->state);
-    return RCL_RET_ERROR;
+    substitutions_map,
+    expanded_name_buffer,
+    sizeof(expanded_name_buffer),
+    &validation_result);
+  if (RCL_RET_OK == ret) {
+    if (RMW_TOPIC_VALID != validation_result) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      return RCL_RET_SERVICE_NAME_INVALID;
+    }
+    expanded_service_name = expanded_name_buffer;
+    expanded_name_validated = true;
+  } else if (RCL_RET_BUFFER_TOO_SMALL == ret) {
+    // unusually long name, fall back to the allocating expansion
+    rcl_reset_error();
+    ret = rcl_expand_topic_name(
+      service_name,
+      rcl_node_get_name(node),
+      rcl_node_get_namespace(node),
+      substitutions_map,
+      *allocator,
+      &expanded_service_name);
   }
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
@@ -133,32 +181,54 @@ rcl_client_init(
   if (node_options->use_global_arguments) {
     global_args = &(node->context->global_arguments);
   }
-  ret = rcl_remap_service_name(
-    &(node_options->arguments), global_args, expanded_service_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_service_name) {
+  rcl_remap_cache_t * remap_cache = rcl_node_get_remap_cache(node);
+  bool remap_cache_hit = false;
+  if (NULL != remap_cache) {
+    ret = rcl_remap_cache_lookup(
+      remap_cache, RCL_SERVICE_REMAP, expanded_service_name, *allocator,
+      &remap_cache_hit, &remapped_service_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+  }
+  if (!remap_cache_hit) {
+    ret = rcl_remap_service_name(
+      &(node_options->arguments), global_args, expanded_service_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+    rcl_remap_cache_store(
+      remap_cache, RCL_SERVICE_REMAP, expanded_service_name, remapped_service_name);
+  }
+  // A remap rule produced a new name which still needs validating; without
+  // one the expanded name is used, already validated unless the expansion
+  // fell back to the allocating path.
+  bool needs_validation = (NULL != remapped_service_name) || !expanded_name_validated;
+  if (NULL == remapped_service_name) {
     remapped_service_name = expanded_service_name;
     expanded_service_name = NULL;
   }
 
   // Validate the expanded service name.
-  int validation_result;
-  rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_service_name, &validation_result, NULL);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (validation_result != RMW_TOPIC_VALID) {
-    RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
-    ret = RCL_RET_SERVICE_NAME_INVALID;
-    goto cleanup;
+  if (needs_validation) {
+    rmw_ret_t rmw_ret =
+      rmw_validate_full_topic_name(remapped_service_name, &validation_result, NULL);
+    if (rmw_ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = RCL_RET_ERROR;
+      goto cleanup;
+    }
+    if (validation_result != RMW_TOPIC_VALID) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      ret = RCL_RET_SERVICE_NAME_INVALID;
+      goto cleanup;
+    }
   }
-  // Allocate space for the implementation struct.
-  client->impl = (rcl_client_impl_t *)allocator->allocate(
-    sizeof(rcl_client_impl_t), allocator->state);
+  // Allocate space for the implementation struct, from the node's slab so
+  // the node's entity impls sit contiguously.
+  client->impl = (rcl_client_impl_t *)rcl_node_allocate_entity_impl(
+    node, allocator, sizeof(rcl_client_impl_t));
   RCL_CHECK_FOR_NULL_WITH_MSG(
     client->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
   // Fill out implementation struct.
@@ -175,20 +245,63 @@ rcl_client_init(
   }
   // options
   client->impl->options = *options;
+  client->impl->on_new_response_callback = NULL;
+  client->impl->on_new_response_user_data = NULL;
+  // in-flight request table
+  client->impl->in_flight_slots = NULL;
+  client->impl->in_flight_count = 0;
+  client->impl->completed_user_data = NULL;
+  if (options->max_in_flight_requests > 0) {
+    client->impl->in_flight_slots = (rcl_client_in_flight_slot_t *)allocator->zero_allocate(
+      options->max_in_flight_requests, sizeof(rcl_client_in_flight_slot_t), allocator->state);
+    if (!client->impl->in_flight_slots) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (RMW_RET_OK != rmw_destroy_client(
+          rcl_node_get_rmw_handle(node), client->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw client: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // hot path statistics
+  client->impl->statistics = NULL;
+  if (options->enable_statistics) {
+    client->impl->statistics = rcl_entity_statistics_create(allocator, false);
+    if (!client->impl->statistics) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (client->impl->in_flight_slots) {
+        allocator->deallocate(client->impl->in_flight_slots, allocator->state);
+      }
+      if (RMW_RET_OK != rmw_destroy_client(
+          rcl_node_get_rmw_handle(node), client->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw client: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // record for bulk teardown by rcl_context_fini_all_entities()
+  rcl_context_track_entity(node->context, RCL_TRACKED_CLIENT, client, node);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client initialized");
+  RCL_TRACEPOINT_REGISTER("rcl_client_init", client->impl, remapped_service_name);
   ret = RCL_RET_OK;
   goto cleanup;
 fail:
   if (client->impl) {
-    allocator->deallocate(client->impl, allocator->state);
+    rcl_node_deallocate_entity_impl(node, allocator, client->impl);
   }
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_service_name) {
+  if (NULL != expanded_service_name && expanded_name_buffer != expanded_service_name) {
     allocator->deallocate(expanded_service_name, allocator->state);
   }
-  if (NULL != remapped_service_name) {
+  if (NULL != remapped_service_name && expanded_name_buffer != remapped_service_name) {
     allocator->deallocate(remapped_service_name, allocator->state);
   }
   return ret;
@@ -209,12 +322,17 @@ rcl_client_fini(rcl_client_t * client, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
+    rcl_context_untrack_entity(node->context, client);
     rmw_ret_t ret = rmw_destroy_client(rmw_node, client->impl->rmw_handle);
     if (ret != RMW_RET_OK) {
       RCL_SET_ERROR_MSG(rmw_get_error_string().str);
       result = RCL_RET_ERROR;
     }
-    allocator.deallocate(client->impl, allocator.state);
+    if (client->impl->in_flight_slots) {
+      allocator.deallocate(client->impl->in_flight_slots, allocator.state);
+    }
+    rcl_entity_statistics_destroy(client->impl->statistics, &allocator);
+    rcl_node_deallocate_entity_impl(node, &allocator, client->impl);
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client finalized");
   return result;
@@ -228,9 +346,28 @@ rcl_client_get_default_options()
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_services_default;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.max_in_flight_requests = 0;
+  default_options.enable_statistics = false;
   return default_options;
 }
 
+rcl_ret_t
+rcl_client_get_statistics(
+  const rcl_client_t * client,
+  rcl_statistics_t * statistics)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  if (!client->impl->statistics) {
+    RCL_SET_ERROR_MSG("client does not keep statistics");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_entity_statistics_snapshot(client->impl->statistics, statistics);
+  return RCL_RET_OK;
+}
+
 const char *
 rcl_client_get_service_name(const rcl_client_t * client)
 {
@@ -269,17 +406,54 @@ rcl_send_request(const rcl_client_t * client, const void * ros_request, int64_t
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
+  if (
+    client->impl->in_flight_slots &&
+    client->impl->in_flight_count >= client->impl->options.max_in_flight_requests)
+  {
+    RCL_SET_ERROR_MSG("client in-flight request table is full");
+    return RCL_RET_CLIENT_IN_FLIGHT_FULL;
+  }
+  RCL_TRACEPOINT("rcl_send_request", client->impl);
   *sequence_number = rcutils_atomic_load_int64_t(&client->impl->sequence_number);
   if (rmw_send_request(
       client->impl->rmw_handle, ros_request, sequence_number) != RMW_RET_OK)
   {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    rcl_entity_statistics_record_failed(client->impl->statistics);
     return RCL_RET_ERROR;
   }
+  rcl_entity_statistics_record_succeeded(client->impl->statistics, 1);
   rcutils_atomic_exchange_int64_t(&client->impl->sequence_number, *sequence_number);
+  if (client->impl->in_flight_slots) {
+    // Cannot fail: fullness was checked above and slots are only freed here
+    // and in rcl_take_response().
+    rcl_client_in_flight_slot_t * slot =
+      __client_in_flight_find(client->impl, *sequence_number, true);
+    slot->in_use = true;
+    slot->sequence_number = *sequence_number;
+    slot->user_data = NULL;
+    ++client->impl->in_flight_count;
+  }
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_send_request_serialized(
+  const rcl_client_t * client,
+  const rcl_serialized_message_t * serialized_request,
+  int64_t * sequence_number)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sequence_number, RCL_RET_INVALID_ARGUMENT);
+  // The rmw interface in use has no serialized service entry points yet;
+  // relays on top of it have to fall back to rcl_send_request().
+  RCL_SET_ERROR_MSG("sending serialized requests is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
 rcl_ret_t
 rcl_take_response(
   const rcl_client_t * client,
@@ -299,13 +473,103 @@ rcl_take_response(
       client->impl->rmw_handle, request_header, ros_response, &taken) != RMW_RET_OK)
   {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    rcl_entity_statistics_record_failed(client->impl->statistics);
     return RCL_RET_ERROR;
   }
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Client take response succeeded: %s", taken ? "true" : "false");
   if (!taken) {
+    rcl_entity_statistics_record_failed(client->impl->statistics);
     return RCL_RET_CLIENT_TAKE_FAILED;
   }
+  rcl_entity_statistics_record_succeeded(client->impl->statistics, 1);
+  RCL_TRACEPOINT("rcl_take_response", client->impl);
+  if (client->impl->in_flight_slots) {
+    // Complete the slot of the answered request; responses to requests sent
+    // before tracking was enabled simply have no slot.
+    rcl_client_in_flight_slot_t * slot =
+      __client_in_flight_find(client->impl, request_header->sequence_number, false);
+    client->impl->completed_user_data = NULL;
+    if (slot) {
+      client->impl->completed_user_data = slot->user_data;
+      slot->in_use = false;
+      --client->impl->in_flight_count;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_response_serialized(
+  const rcl_client_t * client,
+  rmw_request_id_t * request_header,
+  rcl_serialized_message_t * serialized_response)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_response, RCL_RET_INVALID_ARGUMENT);
+  // The rmw interface in use has no serialized service entry points yet;
+  // relays on top of it have to fall back to rcl_take_response().
+  RCL_SET_ERROR_MSG("taking serialized responses is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_client_set_request_user_data(
+  const rcl_client_t * client,
+  int64_t sequence_number,
+  const void * user_data)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  if (!client->impl->in_flight_slots) {
+    RCL_SET_ERROR_MSG("client does not track in-flight requests");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_client_in_flight_slot_t * slot =
+    __client_in_flight_find(client->impl, sequence_number, false);
+  if (!slot) {
+    RCL_SET_ERROR_MSG("given sequence number is not in flight");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  slot->user_data = user_data;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_get_completed_request_user_data(
+  const rcl_client_t * client,
+  const void ** user_data)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(user_data, RCL_RET_INVALID_ARGUMENT);
+  if (!client->impl->in_flight_slots) {
+    RCL_SET_ERROR_MSG("client does not track in-flight requests");
+    return RCL_RET_UNSUPPORTED;
+  }
+  *user_data = client->impl->completed_user_data;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_get_in_flight_count(
+  const rcl_client_t * client,
+  size_t * count)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  if (!client->impl->in_flight_slots) {
+    RCL_SET_ERROR_MSG("client does not track in-flight requests");
+    return RCL_RET_UNSUPPORTED;
+  }
+  *count = client->impl->in_flight_count;
   return RCL_RET_OK;
 }
 
@@ -319,6 +583,29 @@ rcl_client_is_valid(const rcl_client_t * client)
     client->impl->rmw_handle, "client's rmw handle is invalid", return false);
   return true;
 }
+rcl_ret_t
+rcl_client_set_on_new_response_callback(
+  const rcl_client_t * client,
+  rcl_event_callback_t callback,
+  const void * user_data)
+{
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  client->impl->on_new_response_callback = callback;
+  client->impl->on_new_response_user_data = user_data;
+  return RCL_RET_OK;
+}
+
+void
+rcl_client_dispatch_on_new_response(const rcl_client_t * client)
+{
+  rcl_event_callback_t callback = client->impl->on_new_response_callback;
+  if (NULL != callback) {
+    callback(client->impl->on_new_response_user_data, 1);
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,192 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/client_group.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+
+#include "./client_group_impl.h"
+#include "./common.h"
+
+rcl_client_group_t
+rcl_get_zero_initialized_client_group()
+{
+  static rcl_client_group_t null_group = {0};
+  return null_group;
+}
+
+rcl_client_group_options_t
+rcl_client_group_get_default_options()
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  static rcl_client_group_options_t default_options;
+  // Must set the allocator after because it is not a compile time constant.
+  default_options.allocator = rcl_get_default_allocator();
+  default_options.max_clients = 0;
+  default_options.priority = 0;
+  return default_options;
+}
+
+/// Find the position of a client in the group, or the group's size when the
+/// client is not a member.
+static size_t
+__client_group_find(const rcl_client_group_impl_t * impl, const rcl_client_t * client)
+{
+  size_t position = 0;
+  while (position < impl->client_count && impl->clients[position] != client) {
+    ++position;
+  }
+  return position;
+}
+
+rcl_ret_t
+rcl_client_group_init(
+  rcl_client_group_t * group,
+  const rcl_client_group_options_t options)
+{
+  rcl_allocator_t * allocator = (rcl_allocator_t *)&options.allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  if (group->impl) {
+    RCL_SET_ERROR_MSG("client group already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  size_t max_clients = options.max_clients;
+  if (0 == max_clients) {
+    max_clients = RCL_CLIENT_GROUP_MAX_CLIENTS_DEFAULT;
+  }
+  group->impl = (rcl_client_group_impl_t *)allocator->allocate(
+    sizeof(rcl_client_group_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  group->impl->options = options;
+  group->impl->options.max_clients = max_clients;
+  // One block backs both the member list and the ready list.
+  group->impl->clients = (const rcl_client_t **)allocator->zero_allocate(
+    2 * max_clients, sizeof(rcl_client_t *), allocator->state);
+  if (!group->impl->clients) {
+    allocator->deallocate(group->impl, allocator->state);
+    group->impl = NULL;
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  group->impl->client_count = 0;
+  group->impl->ready_clients = group->impl->clients + max_clients;
+  group->impl->ready_count = 0;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client group initialized");
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_group_fini(rcl_client_group_t * group)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  if (group->impl) {
+    rcl_allocator_t allocator = group->impl->options.allocator;
+    allocator.deallocate((void *)group->impl->clients, allocator.state);
+    allocator.deallocate(group->impl, allocator.state);
+    group->impl = NULL;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Client group finalized");
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_group_add_client(
+  rcl_client_group_t * group,
+  const rcl_client_t * client)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "client group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_client_is_valid(client)) {
+    return RCL_RET_CLIENT_INVALID;  // error already set
+  }
+  rcl_client_group_impl_t * impl = group->impl;
+  if (__client_group_find(impl, client) < impl->client_count) {
+    RCL_SET_ERROR_MSG("client is already in the group");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (impl->client_count >= impl->options.max_clients) {
+    RCL_SET_ERROR_MSG("client group is full");
+    return RCL_RET_CLIENT_GROUP_FULL;
+  }
+  impl->clients[impl->client_count++] = client;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_group_remove_client(
+  rcl_client_group_t * group,
+  const rcl_client_t * client)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "client group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  rcl_client_group_impl_t * impl = group->impl;
+  size_t position = __client_group_find(impl, client);
+  if (position == impl->client_count) {
+    RCL_SET_ERROR_MSG("client is not in the group");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  memmove(
+    (void *)&impl->clients[position], (void *)&impl->clients[position + 1],
+    sizeof(rcl_client_t *) * (impl->client_count - position - 1));
+  --impl->client_count;
+  // The ready list may reference the removed client, drop it wholesale.
+  impl->ready_count = 0;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_group_get_number_of_clients(
+  const rcl_client_group_t * group,
+  size_t * count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "client group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  *count = group->impl->client_count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_client_group_get_ready_clients(
+  const rcl_client_group_t * group,
+  const rcl_client_t *** ready_clients,
+  size_t * number_ready)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "client group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ready_clients, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_ready, RCL_RET_INVALID_ARGUMENT);
+  *ready_clients = group->impl->ready_clients;
+  *number_ready = group->impl->ready_count;
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
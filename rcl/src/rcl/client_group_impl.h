@@ -0,0 +1,33 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__CLIENT_GROUP_IMPL_H_
+#define RCL__CLIENT_GROUP_IMPL_H_
+
+#include "rcl/client_group.h"
+
+typedef struct rcl_client_group_impl_t
+{
+  rcl_client_group_options_t options;
+  // Borrowed member clients, in addition order; sized by options.max_clients.
+  const rcl_client_t ** clients;
+  size_t client_count;
+  // Members made ready by the last wait, written by the post-wait fixup in
+  // wait.c and read through rcl_client_group_get_ready_clients(); shares the
+  // allocation of `clients` and has the same capacity.
+  const rcl_client_t ** ready_clients;
+  size_t ready_count;
+} rcl_client_group_impl_t;
+
+#endif  // RCL__CLIENT_GROUP_IMPL_H_
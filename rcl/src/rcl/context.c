@@ -22,7 +22,16 @@ extern "C"
 #include <stdbool.h>
 
 #include "./context_impl.h"
+#include "./entity_registry.h"
+#include "./env_snapshot.h"
+#include "./guard_condition_pool.h"
+#include "./intra_process.h"
+#include "./reclaim.h"
+#include "./string_pool.h"
+#include "./wait_set_pool.h"
 #include "rcutils/stdatomic_helper.h"
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
 
 rcl_context_t
 rcl_get_zero_initialized_context(void)
@@ -113,6 +122,42 @@ __cleanup_context(rcl_context_t * context)
     // pull allocator out for use during deallocation
     rcl_allocator_t allocator = context->impl->allocator;
 
+    // free the intra-process registry if it was created
+    rcl_intra_process_registry_fini(context);
+
+    // free the interned string pool if it was created
+    rcl_string_pool_fini(context);
+
+    // free the pooled wait sets if the pool was created
+    rcl_wait_set_pool_fini(context);
+
+    // free the pooled guard conditions if the pool was created
+    rcl_guard_condition_pool_fini(context);
+
+    // drain and free the reclamation queue if it was created
+    rcl_reclaim_queue_fini(context);
+
+    // free the entity registry if it was created
+    rcl_entity_registry_fini(context);
+
+    // destroy the wakeup guard condition shared by local guard conditions
+    if (NULL != context->impl->local_wakeup_guard_condition) {
+      if (RMW_RET_OK !=
+        rmw_destroy_guard_condition(context->impl->local_wakeup_guard_condition))
+      {
+        RCUTILS_SAFE_FWRITE_TO_STDERR(
+          "[rcl|context.c:" RCUTILS_STRINGIFY(__LINE__)
+          "] failed to destroy local wakeup guard condition: ");
+        RCUTILS_SAFE_FWRITE_TO_STDERR(rmw_get_error_string().str);
+        RCUTILS_SAFE_FWRITE_TO_STDERR("\n");
+        rmw_reset_error();
+      }
+      context->impl->local_wakeup_guard_condition = NULL;
+    }
+
+    // free the string copies held by the environment snapshot
+    rcl_env_snapshot_fini(&(context->impl->env_snapshot));
+
     // finalize init options if valid
     if (NULL != context->impl->init_options.impl) {
       rcl_ret_t ret = rcl_init_options_fini(&(context->impl->init_options));
@@ -18,6 +18,9 @@
 #include "rcl/context.h"
 #include "rcl/error_handling.h"
 
+#include "rmw/types.h"
+
+#include "./env_snapshot.h"
 #include "./init_options_impl.h"
 
 #ifdef __cplusplus
@@ -38,6 +41,28 @@ typedef struct rcl_context_impl_t
   char ** argv;
   /// rmw context.
   rmw_context_t rmw_context;
+  /// rmw node shared by every node in the context when participant sharing
+  /// is enabled, created by the first node to finish init; may be `NULL`.
+  rmw_node_t * shared_rmw_node;
+  /// Number of rcl nodes currently referencing the shared rmw node.
+  uint64_t shared_rmw_node_count;
+  /// Intra-process fast path registry, created lazily; may be `NULL`.
+  struct rcl_intra_process_registry_t * intra_process_registry;
+  /// Interned string pool for entity and node names, created lazily; may be `NULL`.
+  struct rcl_string_pool_t * string_pool;
+  /// Pool of initialized wait sets for transient waits, created lazily; may be `NULL`.
+  struct rcl_wait_set_pool_t * wait_set_pool;
+  /// Pool of initialized guard conditions for one-shot wakeups, created lazily; may be `NULL`.
+  struct rcl_guard_condition_pool_t * guard_condition_pool;
+  /// Queue of rmw handles awaiting deferred destruction, created lazily; may be `NULL`.
+  struct rcl_reclaim_queue_t * reclaim_queue;
+  /// Registry of live entities for bulk teardown, created lazily; may be `NULL`.
+  struct rcl_entity_registry_t * entity_registry;
+  /// rmw guard condition shared by all local guard conditions in the context
+  /// to interrupt blocked waits, created lazily; may be `NULL`.
+  rmw_guard_condition_t * local_wakeup_guard_condition;
+  /// Snapshot of the rcl-relevant environment variables, taken during init.
+  rcl_env_snapshot_t env_snapshot;
 } rcl_context_impl_t;
 
 RCL_LOCAL
@@ -0,0 +1,253 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/counting_allocator.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/get_env.h"
+#include "rcutils/logging_macros.h"
+
+/// Prefixed to every counted block so deallocation knows the size and tag.
+/**
+ * Two size_t fields keep the user pointer aligned for any fundamental type
+ * on the platforms rcl supports.
+ */
+typedef struct rcl_counting_header_t
+{
+  size_t size;
+  size_t tag;
+} rcl_counting_header_t;
+
+typedef struct rcl_counting_stats_t
+{
+  atomic_uint_least64_t allocation_count;
+  atomic_uint_least64_t total_bytes;
+  atomic_uint_least64_t current_bytes;
+  atomic_uint_least64_t peak_bytes;
+} rcl_counting_stats_t;
+
+/// One slot per tag; wrap binds the inner allocator, the stats are global.
+typedef struct rcl_counting_slot_t
+{
+  rcl_allocator_t inner;
+  bool bound;
+} rcl_counting_slot_t;
+
+static rcl_counting_stats_t __counting_stats[RCL_ALLOC_TAG_COUNT];
+static rcl_counting_slot_t __counting_slots[RCL_ALLOC_TAG_COUNT];
+
+static const char * const __counting_tag_names[RCL_ALLOC_TAG_COUNT] = {
+  "node",
+  "wait_set",
+  "arguments",
+  "graph",
+};
+
+/// Whether accounting is enabled: -1 unknown, 0 disabled, 1 enabled.
+static atomic_int __counting_enabled = ATOMIC_VAR_INIT(-1);
+
+static bool
+__counting_is_enabled(void)
+{
+  int enabled = atomic_load_explicit(&__counting_enabled, memory_order_acquire);
+  if (-1 == enabled) {
+    const char * value = NULL;
+    if (NULL != rcutils_get_env("RCL_ALLOCATION_STATS", &value) || NULL == value) {
+      enabled = 0;
+    } else {
+      enabled = (0 == strcmp(value, "1")) ? 1 : 0;
+    }
+    atomic_store_explicit(&__counting_enabled, enabled, memory_order_release);
+  }
+  return 1 == enabled;
+}
+
+static void
+__counting_record_allocation(rcl_counting_stats_t * stats, size_t size)
+{
+  atomic_fetch_add_explicit(&stats->allocation_count, 1u, memory_order_relaxed);
+  atomic_fetch_add_explicit(&stats->total_bytes, size, memory_order_relaxed);
+  uint64_t current =
+    atomic_fetch_add_explicit(&stats->current_bytes, size, memory_order_relaxed) + size;
+  uint64_t peak = atomic_load_explicit(&stats->peak_bytes, memory_order_relaxed);
+  while (current > peak &&
+    !atomic_compare_exchange_weak_explicit(
+      &stats->peak_bytes, &peak, current, memory_order_relaxed, memory_order_relaxed))
+  {
+    // peak was reloaded by the failed exchange; retry until it is current
+  }
+}
+
+static void *
+__counting_allocate(size_t size, void * state)
+{
+  rcl_counting_slot_t * slot = state;
+  void * block = slot->inner.allocate(
+    size + sizeof(rcl_counting_header_t), slot->inner.state);
+  if (NULL == block) {
+    return NULL;
+  }
+  rcl_counting_header_t * header = block;
+  header->size = size;
+  header->tag = (size_t)(slot - __counting_slots);
+  __counting_record_allocation(&__counting_stats[header->tag], size);
+  return header + 1;
+}
+
+static void *
+__counting_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  rcl_counting_slot_t * slot = state;
+  size_t size = number_of_elements * size_of_element;
+  void * block = slot->inner.zero_allocate(
+    1u, size + sizeof(rcl_counting_header_t), slot->inner.state);
+  if (NULL == block) {
+    return NULL;
+  }
+  rcl_counting_header_t * header = block;
+  header->size = size;
+  header->tag = (size_t)(slot - __counting_slots);
+  __counting_record_allocation(&__counting_stats[header->tag], size);
+  return header + 1;
+}
+
+static void
+__counting_deallocate(void * pointer, void * state)
+{
+  rcl_counting_slot_t * slot = state;
+  if (NULL == pointer) {
+    return;
+  }
+  rcl_counting_header_t * header = ((rcl_counting_header_t *)pointer) - 1;
+  atomic_fetch_sub_explicit(
+    &__counting_stats[header->tag].current_bytes, header->size, memory_order_relaxed);
+  slot->inner.deallocate(header, slot->inner.state);
+}
+
+static void *
+__counting_reallocate(void * pointer, size_t size, void * state)
+{
+  rcl_counting_slot_t * slot = state;
+  if (NULL == pointer) {
+    return __counting_allocate(size, state);
+  }
+  rcl_counting_header_t * header = ((rcl_counting_header_t *)pointer) - 1;
+  size_t old_size = header->size;
+  header = slot->inner.reallocate(
+    header, size + sizeof(rcl_counting_header_t), slot->inner.state);
+  if (NULL == header) {
+    return NULL;
+  }
+  header->size = size;
+  rcl_counting_stats_t * stats = &__counting_stats[header->tag];
+  if (size > old_size) {
+    __counting_record_allocation(stats, size - old_size);
+  } else {
+    atomic_fetch_sub_explicit(&stats->current_bytes, old_size - size, memory_order_relaxed);
+  }
+  return header + 1;
+}
+
+rcl_allocator_t
+rcl_counting_allocator_wrap(rcl_allocator_t inner, rcl_alloc_tag_t tag)
+{
+  if (!__counting_is_enabled() || (int)tag < 0 || tag >= RCL_ALLOC_TAG_COUNT) {
+    return inner;
+  }
+  rcl_counting_slot_t * slot = &__counting_slots[tag];
+  if (slot->bound) {
+    // A tag counts against exactly one backing allocator; a second,
+    // different allocator stays unwrapped rather than corrupting frees of
+    // blocks obtained through the first one.
+    if (slot->inner.allocate != inner.allocate ||
+      slot->inner.deallocate != inner.deallocate ||
+      slot->inner.reallocate != inner.reallocate ||
+      slot->inner.zero_allocate != inner.zero_allocate ||
+      slot->inner.state != inner.state)
+    {
+      return inner;
+    }
+  } else {
+    slot->inner = inner;
+    slot->bound = true;
+  }
+  rcl_allocator_t wrapped;
+  wrapped.allocate = __counting_allocate;
+  wrapped.deallocate = __counting_deallocate;
+  wrapped.reallocate = __counting_reallocate;
+  wrapped.zero_allocate = __counting_zero_allocate;
+  wrapped.state = slot;
+  return wrapped;
+}
+
+rcl_ret_t
+rcl_get_allocation_stats(rcl_alloc_tag_t tag, rcl_alloc_stats_t * stats)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  if ((int)tag < 0 || tag >= RCL_ALLOC_TAG_COUNT) {
+    RCL_SET_ERROR_MSG("given tag is out of range");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_counting_stats_t * counters = &__counting_stats[tag];
+  stats->allocation_count =
+    atomic_load_explicit(&counters->allocation_count, memory_order_relaxed);
+  stats->total_bytes = atomic_load_explicit(&counters->total_bytes, memory_order_relaxed);
+  stats->current_bytes = atomic_load_explicit(&counters->current_bytes, memory_order_relaxed);
+  stats->peak_bytes = atomic_load_explicit(&counters->peak_bytes, memory_order_relaxed);
+  return RCL_RET_OK;
+}
+
+void
+rcl_reset_allocation_stats(void)
+{
+  for (size_t tag = 0; tag < RCL_ALLOC_TAG_COUNT; ++tag) {
+    rcl_counting_stats_t * counters = &__counting_stats[tag];
+    atomic_store_explicit(&counters->allocation_count, 0u, memory_order_relaxed);
+    atomic_store_explicit(&counters->total_bytes, 0u, memory_order_relaxed);
+    atomic_store_explicit(&counters->current_bytes, 0u, memory_order_relaxed);
+    atomic_store_explicit(&counters->peak_bytes, 0u, memory_order_relaxed);
+  }
+}
+
+void
+rcl_log_allocation_stats(void)
+{
+  for (size_t tag = 0; tag < RCL_ALLOC_TAG_COUNT; ++tag) {
+    rcl_alloc_stats_t stats;
+    if (RCL_RET_OK != rcl_get_allocation_stats((rcl_alloc_tag_t)tag, &stats)) {
+      rcl_reset_error();
+      continue;
+    }
+    RCUTILS_LOG_INFO_NAMED(
+      ROS_PACKAGE_NAME,
+      "allocation stats [%s]: count=%" PRIu64 " total=%" PRIu64
+      "B current=%" PRIu64 "B peak=%" PRIu64 "B",
+      __counting_tag_names[tag], stats.allocation_count, stats.total_bytes,
+      stats.current_bytes, stats.peak_bytes);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
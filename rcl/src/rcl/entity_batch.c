@@ -0,0 +1,111 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/entity_batch.h"
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+
+/// Validate one spec before anything in the batch is created.
+static rcl_ret_t
+__entity_spec_check(const rcl_entity_spec_t * spec)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(spec->type_support, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(spec->topic_name, RCL_RET_INVALID_ARGUMENT);
+  switch (spec->kind) {
+    case RCL_ENTITY_KIND_PUBLISHER:
+      RCL_CHECK_ARGUMENT_FOR_NULL(spec->publisher, RCL_RET_INVALID_ARGUMENT);
+      RCL_CHECK_ARGUMENT_FOR_NULL(spec->publisher_options, RCL_RET_INVALID_ARGUMENT);
+      break;
+    case RCL_ENTITY_KIND_SUBSCRIPTION:
+      RCL_CHECK_ARGUMENT_FOR_NULL(spec->subscription, RCL_RET_INVALID_ARGUMENT);
+      RCL_CHECK_ARGUMENT_FOR_NULL(spec->subscription_options, RCL_RET_INVALID_ARGUMENT);
+      break;
+    default:
+      RCL_SET_ERROR_MSG("unknown entity kind in spec");
+      return RCL_RET_INVALID_ARGUMENT;
+  }
+  return RCL_RET_OK;
+}
+
+/// Finalize the already created entities of a partially applied batch.
+static void
+__entity_batch_unwind(rcl_node_t * node, rcl_entity_spec_t * specs, size_t created)
+{
+  for (size_t i = 0; i < created; ++i) {
+    rcl_ret_t ret = RCL_RET_OK;
+    if (RCL_ENTITY_KIND_PUBLISHER == specs[i].kind) {
+      ret = rcl_publisher_fini(specs[i].publisher, node);
+    } else {
+      ret = rcl_subscription_fini(specs[i].subscription, node);
+    }
+    if (RCL_RET_OK != ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME,
+        "failed to fini entity %zu while unwinding a failed batch: %s",
+        i, rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+  }
+}
+
+rcl_ret_t
+rcl_node_create_entities(
+  rcl_node_t * node,
+  rcl_entity_spec_t * specs,
+  size_t count)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(specs, RCL_RET_INVALID_ARGUMENT);
+  // Reject a malformed batch up front so nothing has to be unwound for it.
+  for (size_t i = 0; i < count; ++i) {
+    rcl_ret_t ret = __entity_spec_check(&specs[i]);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  // The first init warms the node's remap memo and substitutions map; the
+  // rest of the batch resolves names against them.
+  for (size_t i = 0; i < count; ++i) {
+    rcl_ret_t ret;
+    if (RCL_ENTITY_KIND_PUBLISHER == specs[i].kind) {
+      ret = rcl_publisher_init(
+        specs[i].publisher, node, specs[i].type_support,
+        specs[i].topic_name, specs[i].publisher_options);
+    } else {
+      ret = rcl_subscription_init(
+        specs[i].subscription, node, specs[i].type_support,
+        specs[i].topic_name, specs[i].subscription_options);
+    }
+    if (RCL_RET_OK != ret) {
+      rcl_error_string_t error_string = rcl_get_error_string();
+      rcl_reset_error();
+      __entity_batch_unwind(node, specs, i);
+      RCL_SET_ERROR_MSG(error_string.str);
+      return ret;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,44 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENTITY_EVENT_CALLBACKS_H_
+#define RCL__ENTITY_EVENT_CALLBACKS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/client.h"
+#include "rcl/service.h"
+#include "rcl/subscription.h"
+
+// Internal hooks used by rcl_wait() to invoke the event callbacks registered
+// with rcl_subscription_set_on_new_message_callback() and friends when an
+// entity becomes ready.  They do nothing when no callback is registered.
+
+void
+rcl_subscription_dispatch_on_new_message(const rcl_subscription_t * subscription);
+
+void
+rcl_service_dispatch_on_new_request(const rcl_service_t * service);
+
+void
+rcl_client_dispatch_on_new_response(const rcl_client_t * client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENTITY_EVENT_CALLBACKS_H_
@@ -0,0 +1,242 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./entity_registry.h"
+
+#include "rcl/client.h"
+#include "rcl/error_handling.h"
+#include "rcl/publisher.h"
+#include "rcl/service.h"
+#include "rcl/subscription.h"
+#include "rcutils/logging_macros.h"
+
+#include "./context_impl.h"
+
+// Sized for a typical process; the array grows geometrically beyond that.
+#define RCL_ENTITY_REGISTRY_INITIAL_CAPACITY 32u
+
+typedef struct rcl_tracked_entity_t
+{
+  rcl_tracked_entity_kind_t kind;
+  void * entity;
+  rcl_node_t * node;
+} rcl_tracked_entity_t;
+
+typedef struct rcl_entity_registry_t
+{
+  rcl_tracked_entity_t * records;
+  size_t count;
+  size_t capacity;
+  rcl_allocator_t allocator;
+} rcl_entity_registry_t;
+
+/// Get the context's registry, creating it on first use; NULL on failure.
+static rcl_entity_registry_t *
+__entity_registry_get(rcl_context_t * context)
+{
+  if (!context || !context->impl) {
+    return NULL;
+  }
+  if (!context->impl->entity_registry) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_entity_registry_t * registry = (rcl_entity_registry_t *)allocator.zero_allocate(
+      1, sizeof(rcl_entity_registry_t), allocator.state);
+    if (!registry) {
+      return NULL;
+    }
+    registry->allocator = allocator;
+    context->impl->entity_registry = registry;
+  }
+  return context->impl->entity_registry;
+}
+
+void
+rcl_context_track_entity(
+  rcl_context_t * context,
+  rcl_tracked_entity_kind_t kind,
+  void * entity,
+  rcl_node_t * node)
+{
+  rcl_entity_registry_t * registry = __entity_registry_get(context);
+  if (!registry) {
+    RCUTILS_LOG_WARN_NAMED(
+      ROS_PACKAGE_NAME,
+      "failed to allocate entity registry, entity will not be covered by bulk teardown");
+    return;
+  }
+  if (registry->count == registry->capacity) {
+    size_t new_capacity =
+      registry->capacity ? 2 * registry->capacity : RCL_ENTITY_REGISTRY_INITIAL_CAPACITY;
+    rcl_tracked_entity_t * new_records = (rcl_tracked_entity_t *)registry->allocator.reallocate(
+      registry->records, new_capacity * sizeof(rcl_tracked_entity_t),
+      registry->allocator.state);
+    if (!new_records) {
+      RCUTILS_LOG_WARN_NAMED(
+        ROS_PACKAGE_NAME,
+        "failed to grow entity registry, entity will not be covered by bulk teardown");
+      return;
+    }
+    registry->records = new_records;
+    registry->capacity = new_capacity;
+  }
+  registry->records[registry->count].kind = kind;
+  registry->records[registry->count].entity = entity;
+  registry->records[registry->count].node = node;
+  ++registry->count;
+}
+
+void
+rcl_context_untrack_entity(rcl_context_t * context, void * entity)
+{
+  if (!context || !context->impl || !context->impl->entity_registry) {
+    return;
+  }
+  rcl_entity_registry_t * registry = context->impl->entity_registry;
+  // Scan from the end: entities are typically finalized in reverse creation
+  // order, so the match is usually at or near the back.
+  size_t i = registry->count;
+  while (i > 0) {
+    --i;
+    if (registry->records[i].entity == entity) {
+      registry->records[i] = registry->records[--registry->count];
+      return;
+    }
+  }
+}
+
+void
+rcl_entity_registry_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->entity_registry) {
+    return;
+  }
+  rcl_entity_registry_t * registry = context->impl->entity_registry;
+  rcl_allocator_t allocator = registry->allocator;
+  if (registry->records) {
+    allocator.deallocate(registry->records, allocator.state);
+  }
+  allocator.deallocate(registry, allocator.state);
+  context->impl->entity_registry = NULL;
+}
+
+/// Finalize one tracked entity through the fini function for its kind.
+static rcl_ret_t
+__finalize_tracked_entity(const rcl_tracked_entity_t * record)
+{
+  switch (record->kind) {
+    case RCL_TRACKED_PUBLISHER:
+      // Deferred: the blocking middleware destruction is parked on the
+      // reclamation queue and drained once for all entities below.
+      return rcl_publisher_fini_deferred((rcl_publisher_t *)record->entity, record->node);
+    case RCL_TRACKED_SUBSCRIPTION:
+      return rcl_subscription_fini_deferred(
+        (rcl_subscription_t *)record->entity, record->node);
+    case RCL_TRACKED_SERVICE:
+      return rcl_service_fini_deferred((rcl_service_t *)record->entity, record->node);
+    case RCL_TRACKED_CLIENT:
+      return rcl_client_fini((rcl_client_t *)record->entity, record->node);
+    case RCL_TRACKED_NODE:
+      return rcl_node_fini((rcl_node_t *)record->entity);
+    default:
+      RCL_SET_ERROR_MSG("tracked entity has an unknown kind");
+      return RCL_RET_ERROR;
+  }
+}
+
+/// Finalize every tracked entity of the given kind, continuing past failures.
+static rcl_ret_t
+__finalize_tracked_kind(rcl_entity_registry_t * registry, rcl_tracked_entity_kind_t kind)
+{
+  rcl_ret_t result = RCL_RET_OK;
+  size_t i = 0;
+  while (i < registry->count) {
+    if (registry->records[i].kind != kind) {
+      ++i;
+      continue;
+    }
+    // Copy the record: a successful fini untracks it, replacing this slot
+    // with the record from the back of the array.
+    rcl_tracked_entity_t record = registry->records[i];
+    rcl_ret_t fini_ret = __finalize_tracked_entity(&record);
+    if (RCL_RET_OK != fini_ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME,
+        "failed to finalize a tracked entity during bulk teardown: %s",
+        rcl_get_error_string().str);
+      rcl_reset_error();
+      result = RCL_RET_ERROR;
+    }
+    if (i < registry->count && registry->records[i].entity == record.entity) {
+      // The fini failed before untracking the entity; step over it rather
+      // than retrying forever.
+      ++i;
+    }
+  }
+  return result;
+}
+
+rcl_ret_t
+rcl_context_fini_all_entities(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is zero-initialized", return RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  rcl_entity_registry_t * registry = context->impl->entity_registry;
+  if (NULL != registry) {
+    // Entities first, through the deferred fini variants where they exist,
+    // so no pass below blocks on the middleware's destruction locks.
+    static const rcl_tracked_entity_kind_t entity_kinds[] = {
+      RCL_TRACKED_PUBLISHER,
+      RCL_TRACKED_SUBSCRIPTION,
+      RCL_TRACKED_CLIENT,
+      RCL_TRACKED_SERVICE,
+    };
+    for (size_t k = 0; k < sizeof(entity_kinds) / sizeof(entity_kinds[0]); ++k) {
+      if (RCL_RET_OK != __finalize_tracked_kind(registry, entity_kinds[k])) {
+        result = RCL_RET_ERROR;
+      }
+    }
+  }
+  // Destroy the parked rmw handles while the nodes they were created on are
+  // still alive.
+  rcl_ret_t reclaim_ret = rcl_context_reclaim(context, NULL);
+  if (RCL_RET_OK != reclaim_ret) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME,
+      "failed to reclaim deferred rmw handles during bulk teardown: %s",
+      rcl_get_error_string().str);
+    rcl_reset_error();
+    result = RCL_RET_ERROR;
+  }
+  // Nodes last, now that nothing created on them remains.
+  if (NULL != registry) {
+    if (RCL_RET_OK != __finalize_tracked_kind(registry, RCL_TRACKED_NODE)) {
+      result = RCL_RET_ERROR;
+    }
+  }
+  if (RCL_RET_OK != result) {
+    RCL_SET_ERROR_MSG("finalizing one or more tracked entities failed");
+  }
+  return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
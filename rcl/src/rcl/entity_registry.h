@@ -0,0 +1,78 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENTITY_REGISTRY_H_
+#define RCL__ENTITY_REGISTRY_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+#include "rcl/node.h"
+
+// Internal registry of the entities created on a context, hung off the
+// context.
+//
+// The init functions register each node, publisher, subscription, client and
+// service here so that rcl_context_fini_all_entities(), declared in
+// rcl/context.h, can tear the whole process down in bulk at shutdown instead
+// of relying on callers to fini hundreds of entities one by one.  The fini
+// functions remove their entity again, so the registry always mirrors what is
+// currently alive.
+//
+// Tracking is best effort: if allocating a record fails the entity still
+// initializes, a warning is logged, and that entity is simply not covered by
+// the bulk teardown.  The registry is not thread-safe, matching entity
+// creation on a context.
+
+struct rcl_entity_registry_t;
+
+/// Kinds of entities the registry knows how to finalize.
+typedef enum rcl_tracked_entity_kind_t
+{
+  RCL_TRACKED_NODE,
+  RCL_TRACKED_PUBLISHER,
+  RCL_TRACKED_SUBSCRIPTION,
+  RCL_TRACKED_CLIENT,
+  RCL_TRACKED_SERVICE,
+} rcl_tracked_entity_kind_t;
+
+/// Record an entity for bulk teardown, creating the registry on first use.
+/**
+ * `node` is the node the entity was created on and is stored for the later
+ * fini call; for a node it is the node itself.
+ * Failure to allocate the record is logged and otherwise ignored.
+ */
+void
+rcl_context_track_entity(
+  rcl_context_t * context,
+  rcl_tracked_entity_kind_t kind,
+  void * entity,
+  rcl_node_t * node);
+
+/// Remove an entity recorded by rcl_context_track_entity(), if present.
+void
+rcl_context_untrack_entity(rcl_context_t * context, void * entity);
+
+/// Free the context's entity registry if it was created.
+void
+rcl_entity_registry_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENTITY_REGISTRY_H_
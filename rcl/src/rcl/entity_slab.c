@@ -0,0 +1,173 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./entity_slab.h"
+
+#include <stdint.h>
+
+// Alignment of every slot; max_align_t keeps any impl struct placeable and
+// leaves room for the free list pointer threaded through released slots.
+#define RCL_ENTITY_SLAB_ALIGNMENT (sizeof(max_align_t))
+
+// Slots per chunk.  A typical node holds a few dozen entities split over
+// four impl sizes, so 16 slots of one size usually means one chunk per kind.
+#define RCL_ENTITY_SLAB_SLOTS_PER_CHUNK 16u
+
+typedef struct rcl_entity_slab_chunk_t
+{
+  struct rcl_entity_slab_chunk_t * next;
+  // Aligned size every slot in this chunk serves; chunks are segregated by
+  // size so a slot never has to remember what was carved from it.
+  size_t slot_size;
+  // Slots handed out at least once; slots past the high water mark are
+  // virgin and carved in address order.
+  size_t high_water;
+  // Released slots, threaded through their own first bytes.
+  void * free_list;
+  // RCL_ENTITY_SLAB_SLOTS_PER_CHUNK * slot_size bytes, contiguous, placed
+  // directly after this header in the same allocation.
+  uint8_t * slots;
+} rcl_entity_slab_chunk_t;
+
+struct rcl_entity_slab_t
+{
+  rcl_allocator_t allocator;
+  rcl_entity_slab_chunk_t * chunks;
+};
+
+/// Round a size up to the slab alignment.
+static size_t
+_rcl_entity_slab_align(size_t size)
+{
+  return (size + RCL_ENTITY_SLAB_ALIGNMENT - 1u) & ~(RCL_ENTITY_SLAB_ALIGNMENT - 1u);
+}
+
+rcl_entity_slab_t *
+rcl_entity_slab_create(const rcl_allocator_t * allocator)
+{
+  rcl_entity_slab_t * slab = (rcl_entity_slab_t *)allocator->allocate(
+    sizeof(rcl_entity_slab_t), allocator->state);
+  if (NULL == slab) {
+    return NULL;
+  }
+  slab->allocator = *allocator;
+  slab->chunks = NULL;
+  return slab;
+}
+
+void
+rcl_entity_slab_destroy(rcl_entity_slab_t * slab)
+{
+  if (NULL == slab) {
+    return;
+  }
+  rcl_entity_slab_chunk_t * chunk = slab->chunks;
+  while (NULL != chunk) {
+    rcl_entity_slab_chunk_t * next = chunk->next;
+    slab->allocator.deallocate(chunk, slab->allocator.state);
+    chunk = next;
+  }
+  slab->allocator.deallocate(slab, slab->allocator.state);
+}
+
+void *
+rcl_entity_slab_allocate(rcl_entity_slab_t * slab, size_t size)
+{
+  if (NULL == slab || 0u == size) {
+    return NULL;
+  }
+  size = _rcl_entity_slab_align(size);
+  rcl_entity_slab_chunk_t * chunk = slab->chunks;
+  while (NULL != chunk) {
+    if (chunk->slot_size == size &&
+      (NULL != chunk->free_list || chunk->high_water < RCL_ENTITY_SLAB_SLOTS_PER_CHUNK))
+    {
+      break;
+    }
+    chunk = chunk->next;
+  }
+  if (NULL == chunk) {
+    chunk = (rcl_entity_slab_chunk_t *)slab->allocator.allocate(
+      _rcl_entity_slab_align(sizeof(rcl_entity_slab_chunk_t)) +
+      RCL_ENTITY_SLAB_SLOTS_PER_CHUNK * size,
+      slab->allocator.state);
+    if (NULL == chunk) {
+      return NULL;
+    }
+    chunk->next = slab->chunks;
+    chunk->slot_size = size;
+    chunk->high_water = 0u;
+    chunk->free_list = NULL;
+    chunk->slots = (uint8_t *)chunk + _rcl_entity_slab_align(sizeof(rcl_entity_slab_chunk_t));
+    slab->chunks = chunk;
+  }
+  if (NULL != chunk->free_list) {
+    void * slot = chunk->free_list;
+    chunk->free_list = *(void **)slot;
+    return slot;
+  }
+  return chunk->slots + chunk->high_water++ * chunk->slot_size;
+}
+
+bool
+rcl_entity_slab_deallocate(rcl_entity_slab_t * slab, void * pointer)
+{
+  if (NULL == slab || NULL == pointer) {
+    return false;
+  }
+  rcl_entity_slab_chunk_t * chunk = slab->chunks;
+  while (NULL != chunk) {
+    uint8_t * end = chunk->slots + RCL_ENTITY_SLAB_SLOTS_PER_CHUNK * chunk->slot_size;
+    if ((uint8_t *)pointer >= chunk->slots && (uint8_t *)pointer < end) {
+      *(void **)pointer = chunk->free_list;
+      chunk->free_list = pointer;
+      return true;
+    }
+    chunk = chunk->next;
+  }
+  return false;
+}
+
+void *
+rcl_node_allocate_entity_impl(
+  const rcl_node_t * node, const rcl_allocator_t * allocator, size_t size)
+{
+  void * impl = rcl_entity_slab_allocate(rcl_node_get_entity_slab(node), size);
+  if (NULL != impl) {
+    return impl;
+  }
+  // no slab or the slab could not grow; the plain allocator still works
+  return allocator->allocate(size, allocator->state);
+}
+
+void
+rcl_node_deallocate_entity_impl(
+  const rcl_node_t * node, const rcl_allocator_t * allocator, void * impl)
+{
+  if (NULL == impl) {
+    return;
+  }
+  if (!rcl_entity_slab_deallocate(rcl_node_get_entity_slab(node), impl)) {
+    allocator->deallocate(impl, allocator->state);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,96 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENTITY_SLAB_H_
+#define RCL__ENTITY_SLAB_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "rcl/allocator.h"
+#include "rcl/node.h"
+
+// Internal per-node slab for entity impl structs.
+//
+// Allocating each publisher/subscription/service/client impl individually
+// scatters a node's entities across the heap, so loops that touch all of a
+// node's handles (wait set fixup, bulk teardown) miss on nearly every
+// dereference.  The slab hands out fixed size slots from chunks of
+// contiguous memory, one chunk chain per distinct impl size, so entities of
+// the same kind created on one node end up adjacent.
+//
+// Freed slots are recycled through a per-chunk free list, so a node that
+// churns entities reuses the same hot memory instead of growing.  The slab
+// is not thread-safe, matching entity creation on a node.
+
+struct rcl_entity_slab_t;
+typedef struct rcl_entity_slab_t rcl_entity_slab_t;
+
+/// Allocate an empty slab, or return NULL on allocation failure.
+rcl_entity_slab_t *
+rcl_entity_slab_create(const rcl_allocator_t * allocator);
+
+/// Free a slab and every chunk it owns.  NULL is ignored.
+/**
+ * Outstanding slots are released wholesale; by the time a node destroys its
+ * slab all of its entities must already have been finalized.
+ */
+void
+rcl_entity_slab_destroy(rcl_entity_slab_t * slab);
+
+/// Carve a slot of at least `size` bytes, or return NULL on failure.
+void *
+rcl_entity_slab_allocate(rcl_entity_slab_t * slab, size_t size);
+
+/// Return a slot to the slab.
+/**
+ * Returns false, without side effects, when `pointer` was not carved from
+ * this slab (or the slab is NULL); the caller then frees it through the
+ * allocator it fell back to at allocation time.
+ */
+bool
+rcl_entity_slab_deallocate(rcl_entity_slab_t * slab, void * pointer);
+
+/// Allocate an entity impl struct from the node's slab.
+/**
+ * Falls back to `allocator` when the node has no slab or the slab cannot
+ * grow, so entity creation never fails on account of the slab; pair with
+ * rcl_node_deallocate_entity_impl() which undoes either path.
+ */
+void *
+rcl_node_allocate_entity_impl(
+  const rcl_node_t * node, const rcl_allocator_t * allocator, size_t size);
+
+/// Free an entity impl struct allocated by rcl_node_allocate_entity_impl().
+void
+rcl_node_deallocate_entity_impl(
+  const rcl_node_t * node, const rcl_allocator_t * allocator, void * impl);
+
+/// Get the entity slab of a node, or NULL if it could not be allocated.
+/**
+ * Implemented in node.c, where the node impl struct lives.
+ */
+rcl_entity_slab_t *
+rcl_node_get_entity_slab(const rcl_node_t * node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENTITY_SLAB_H_
@@ -0,0 +1,140 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENTITY_STATISTICS_H_
+#define RCL__ENTITY_STATISTICS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdatomic.h>
+
+#include "rcl/allocator.h"
+#include "rcl/statistics.h"
+#include "rcutils/time.h"
+
+// Internal hot path statistics block shared by publishers, subscriptions,
+// services, and clients.
+//
+// The block is allocated separately from the entity's impl struct and padded
+// to a cache line multiple, so the counters, which are written on every
+// publish/take, do not false-share with the mostly read-only impl fields.
+// Updates use relaxed atomics: the counters are independent and monotonic,
+// and readers only need an eventually consistent snapshot.
+
+#define RCL_ENTITY_STATISTICS_CACHE_LINE_SIZE 64
+
+typedef struct rcl_entity_statistics_t
+{
+  atomic_uint_least64_t succeeded_count;
+  atomic_uint_least64_t failed_count;
+  atomic_int_least64_t last_activity_time;
+  // True when the owning entity promised a single updating thread; the
+  // counters are then written with plain load/store pairs instead of
+  // read-modify-write atomics, which snapshot readers tolerate.
+  bool single_threaded;
+  // Pad the block to a full cache line so a neighboring allocation cannot
+  // land on the same line as the counters.
+  uint8_t padding[
+    RCL_ENTITY_STATISTICS_CACHE_LINE_SIZE -
+    (3 * sizeof(atomic_uint_least64_t) + sizeof(bool)) %
+    RCL_ENTITY_STATISTICS_CACHE_LINE_SIZE];
+} rcl_entity_statistics_t;
+
+/// Allocate and zero a statistics block, or return NULL on allocation failure.
+/** With single_threaded, the caller promises one updating thread at a time. */
+static inline rcl_entity_statistics_t *
+rcl_entity_statistics_create(const rcl_allocator_t * allocator, bool single_threaded)
+{
+  rcl_entity_statistics_t * statistics =
+    (rcl_entity_statistics_t *)allocator->zero_allocate(
+    1, sizeof(rcl_entity_statistics_t), allocator->state);
+  if (!statistics) {
+    return NULL;
+  }
+  atomic_init(&statistics->succeeded_count, 0);
+  atomic_init(&statistics->failed_count, 0);
+  atomic_init(&statistics->last_activity_time, 0);
+  statistics->single_threaded = single_threaded;
+  return statistics;
+}
+
+/// Free a statistics block; a NULL block is ignored.
+static inline void
+rcl_entity_statistics_destroy(
+  rcl_entity_statistics_t * statistics, const rcl_allocator_t * allocator)
+{
+  if (statistics) {
+    allocator->deallocate(statistics, allocator->state);
+  }
+}
+
+/// Record `count` successful operations and refresh the activity timestamp.
+static inline void
+rcl_entity_statistics_record_succeeded(rcl_entity_statistics_t * statistics, uint64_t count)
+{
+  if (!statistics || 0 == count) {
+    return;
+  }
+  if (statistics->single_threaded) {
+    atomic_store_explicit(
+      &statistics->succeeded_count,
+      atomic_load_explicit(&statistics->succeeded_count, memory_order_relaxed) + count,
+      memory_order_relaxed);
+  } else {
+    atomic_fetch_add_explicit(&statistics->succeeded_count, count, memory_order_relaxed);
+  }
+  rcutils_time_point_value_t now;
+  if (RCUTILS_RET_OK == rcutils_steady_time_now(&now)) {
+    atomic_store_explicit(&statistics->last_activity_time, now, memory_order_relaxed);
+  }
+}
+
+/// Record one failed operation.
+static inline void
+rcl_entity_statistics_record_failed(rcl_entity_statistics_t * statistics)
+{
+  if (!statistics) {
+    return;
+  }
+  if (statistics->single_threaded) {
+    atomic_store_explicit(
+      &statistics->failed_count,
+      atomic_load_explicit(&statistics->failed_count, memory_order_relaxed) + 1,
+      memory_order_relaxed);
+  } else {
+    atomic_fetch_add_explicit(&statistics->failed_count, 1, memory_order_relaxed);
+  }
+}
+
+/// Copy the current counts into a caller provided snapshot.
+static inline void
+rcl_entity_statistics_snapshot(
+  rcl_entity_statistics_t * statistics, rcl_statistics_t * snapshot)
+{
+  snapshot->succeeded_count =
+    atomic_load_explicit(&statistics->succeeded_count, memory_order_relaxed);
+  snapshot->failed_count =
+    atomic_load_explicit(&statistics->failed_count, memory_order_relaxed);
+  snapshot->last_activity_time =
+    atomic_load_explicit(&statistics->last_activity_time, memory_order_relaxed);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENTITY_STATISTICS_H_
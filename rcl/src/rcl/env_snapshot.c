@@ -0,0 +1,147 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./env_snapshot.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/get_env.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "./common.h"
+#include "./context_impl.h"
+
+rcl_ret_t
+rcl_env_snapshot_capture(rcl_env_snapshot_t * env_snapshot, const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(env_snapshot, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+
+  env_snapshot->captured = false;
+  env_snapshot->domain_id_invalid = false;
+  env_snapshot->domain_id = 0;
+  env_snapshot->use_security = false;
+  env_snapshot->enforce_security = false;
+  env_snapshot->secure_node_directory = NULL;
+  env_snapshot->secure_root_directory = NULL;
+  env_snapshot->allocator = *allocator;
+
+  const char * ros_domain_id = NULL;
+  rcl_ret_t ret = rcl_impl_getenv("ROS_DOMAIN_ID", &ros_domain_id);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (ros_domain_id) {
+    unsigned long number = strtoul(ros_domain_id, NULL, 0);  // NOLINT(runtime/int)
+    if (ULONG_MAX == number) {
+      // recorded and reported on node creation, see the header
+      env_snapshot->domain_id_invalid = true;
+    } else {
+      env_snapshot->domain_id = (size_t)number;
+    }
+  }
+
+  const char * ros_security_enable = NULL;
+  if (rcutils_get_env(ROS_SECURITY_ENABLE_VAR_NAME, &ros_security_enable)) {
+    RCL_SET_ERROR_MSG(
+      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_ENABLE_VAR_NAME)
+      " could not be read");
+    return RCL_RET_ERROR;
+  }
+  env_snapshot->use_security = (0 == strcmp(ros_security_enable, "true"));
+
+  const char * ros_enforce_security = NULL;
+  if (rcutils_get_env(ROS_SECURITY_STRATEGY_VAR_NAME, &ros_enforce_security)) {
+    RCL_SET_ERROR_MSG(
+      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_STRATEGY_VAR_NAME)
+      " could not be read");
+    return RCL_RET_ERROR;
+  }
+  env_snapshot->enforce_security = (0 == strcmp(ros_enforce_security, "Enforce"));
+
+  const char * ros_secure_directory = NULL;
+  if (rcutils_get_env(ROS_SECURITY_NODE_DIRECTORY_VAR_NAME, &ros_secure_directory)) {
+    RCL_SET_ERROR_MSG(
+      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_NODE_DIRECTORY_VAR_NAME)
+      " could not be read");
+    return RCL_RET_ERROR;
+  }
+  if (ros_secure_directory && strlen(ros_secure_directory) > 0) {
+    env_snapshot->secure_node_directory = rcutils_strdup(ros_secure_directory, *allocator);
+    if (NULL == env_snapshot->secure_node_directory) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+
+  ros_secure_directory = NULL;
+  if (rcutils_get_env(ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME, &ros_secure_directory)) {
+    RCL_SET_ERROR_MSG(
+      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME)
+      " could not be read");
+    rcl_env_snapshot_fini(env_snapshot);
+    return RCL_RET_ERROR;
+  }
+  if (ros_secure_directory && strlen(ros_secure_directory) > 0) {
+    env_snapshot->secure_root_directory = rcutils_strdup(ros_secure_directory, *allocator);
+    if (NULL == env_snapshot->secure_root_directory) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      rcl_env_snapshot_fini(env_snapshot);
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+
+  env_snapshot->captured = true;
+  return RCL_RET_OK;
+}
+
+void
+rcl_env_snapshot_fini(rcl_env_snapshot_t * env_snapshot)
+{
+  if (NULL == env_snapshot) {
+    return;
+  }
+  rcl_allocator_t allocator = env_snapshot->allocator;
+  if (env_snapshot->secure_node_directory) {
+    allocator.deallocate(env_snapshot->secure_node_directory, allocator.state);
+    env_snapshot->secure_node_directory = NULL;
+  }
+  if (env_snapshot->secure_root_directory) {
+    allocator.deallocate(env_snapshot->secure_root_directory, allocator.state);
+    env_snapshot->secure_root_directory = NULL;
+  }
+  env_snapshot->captured = false;
+}
+
+const rcl_env_snapshot_t *
+rcl_context_get_env_snapshot(const rcl_context_t * context)
+{
+  if (NULL == context || NULL == context->impl || !context->impl->env_snapshot.captured) {
+    return NULL;
+  }
+  return &(context->impl->env_snapshot);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,79 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__ENV_SNAPSHOT_H_
+#define RCL__ENV_SNAPSHOT_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+
+// Internal snapshot of the rcl-relevant environment variables.
+//
+// The environment used to be re-read on every node creation: the domain id,
+// the security toggles and the security directories, each a getenv syscall
+// plus parsing and string copies.  The environment does not meaningfully
+// change during the lifetime of a context, so it is captured once during
+// rcl_init() and node creation reads the cached values instead.
+
+#define ROS_SECURITY_NODE_DIRECTORY_VAR_NAME "ROS_SECURITY_NODE_DIRECTORY"
+#define ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME "ROS_SECURITY_ROOT_DIRECTORY"
+#define ROS_SECURITY_STRATEGY_VAR_NAME "ROS_SECURITY_STRATEGY"
+#define ROS_SECURITY_ENABLE_VAR_NAME "ROS_SECURITY_ENABLE"
+
+/// \internal
+typedef struct rcl_env_snapshot_t
+{
+  /// True once the snapshot has been captured, false when zero initialized.
+  bool captured;
+  /// True when ROS_DOMAIN_ID was set but could not be parsed as a number.
+  bool domain_id_invalid;
+  /// Domain id parsed from ROS_DOMAIN_ID, `0` when it was not set.
+  size_t domain_id;
+  /// True when ROS_SECURITY_ENABLE was set to exactly "true".
+  bool use_security;
+  /// True when ROS_SECURITY_STRATEGY was set to exactly "Enforce".
+  bool enforce_security;
+  /// Copy of ROS_SECURITY_NODE_DIRECTORY, `NULL` when unset or empty.
+  char * secure_node_directory;
+  /// Copy of ROS_SECURITY_ROOT_DIRECTORY, `NULL` when unset or empty.
+  char * secure_root_directory;
+  /// Allocator owning the string copies above.
+  rcl_allocator_t allocator;
+} rcl_env_snapshot_t;
+
+/// Capture the environment into the given snapshot.
+/**
+ * A bad ROS_DOMAIN_ID value is recorded rather than reported, so the error
+ * still surfaces on node creation like it did when nodes read it themselves.
+ */
+rcl_ret_t
+rcl_env_snapshot_capture(rcl_env_snapshot_t * env_snapshot, const rcl_allocator_t * allocator);
+
+/// Free the string copies held by the snapshot, if any.
+void
+rcl_env_snapshot_fini(rcl_env_snapshot_t * env_snapshot);
+
+/// Return the context's environment snapshot, or NULL if it was not captured.
+const rcl_env_snapshot_t *
+rcl_context_get_env_snapshot(const rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__ENV_SNAPSHOT_H_
@@ -0,0 +1,48 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/error_handling.h"
+
+#if defined(_MSC_VER)
+#define RCL_THREAD_LOCAL __declspec(thread)
+#else
+#define RCL_THREAD_LOCAL _Thread_local
+#endif
+
+// Per-thread switch consulted by RCL_SET_EXPECTED_ERROR_MSG(); see the
+// header for the semantics.
+static RCL_THREAD_LOCAL bool __rcl_error_quiet = false;
+
+bool
+rcl_set_error_quiet(bool enabled)
+{
+  bool previous = __rcl_error_quiet;
+  __rcl_error_quiet = enabled;
+  return previous;
+}
+
+bool
+rcl_error_quiet_enabled(void)
+{
+  return __rcl_error_quiet;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,189 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/event.h"
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/time.h"
+
+#include "./common.h"
+#include "./event_impl.h"
+
+rcl_event_t
+rcl_get_zero_initialized_event()
+{
+  static rcl_event_t null_event = {0};
+  return null_event;
+}
+
+rcl_event_options_t
+rcl_event_get_default_options()
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  static rcl_event_options_t default_options;
+  // Must set the allocator after because it is not a compile time constant.
+  default_options.allocator = rcl_get_default_allocator();
+  default_options.deadline = 0;
+  default_options.priority = 0;
+  return default_options;
+}
+
+/// Shared part of the per-entity init functions, binding the event to the
+/// given statistics block.
+static rcl_ret_t
+__event_init(
+  rcl_event_t * event,
+  const rcl_entity_statistics_t * statistics,
+  const rcl_event_options_t * options)
+{
+  rcl_allocator_t * allocator = (rcl_allocator_t *)&options->allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(event, RCL_RET_INVALID_ARGUMENT);
+  if (event->impl) {
+    RCL_SET_ERROR_MSG("event already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (options->deadline <= 0) {
+    RCL_SET_ERROR_MSG("event deadline must be greater than 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL == statistics) {
+    RCL_SET_ERROR_MSG(
+      "the bound entity keeps no statistics, which the event needs; "
+      "set enable_statistics in the entity's options");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  event->impl = (rcl_event_impl_t *)allocator->allocate(
+    sizeof(rcl_event_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    event->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  event->impl->options = *options;
+  event->impl->statistics = statistics;
+  event->impl->monitor_start_time = now;
+  event->impl->last_take_time = 0;
+  event->impl->total_count = 0;
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Event initialized");
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_event_init_for_publisher(
+  rcl_event_t * event,
+  const rcl_publisher_t * publisher,
+  const rcl_event_options_t options)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  return __event_init(event, rcl_publisher_get_statistics_block(publisher), &options);
+}
+
+rcl_ret_t
+rcl_event_init_for_subscription(
+  rcl_event_t * event,
+  const rcl_subscription_t * subscription,
+  const rcl_event_options_t options)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  return __event_init(event, rcl_subscription_get_statistics_block(subscription), &options);
+}
+
+rcl_ret_t
+rcl_event_fini(rcl_event_t * event)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(event, RCL_RET_INVALID_ARGUMENT);
+  if (event->impl) {
+    rcl_allocator_t allocator = event->impl->options.allocator;
+    allocator.deallocate(event->impl, allocator.state);
+    event->impl = NULL;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Event finalized");
+  return RCL_RET_OK;
+}
+
+/// Return the steady clock time the current deadline period started at:
+/// the latest of the last activity, the last taken miss, and the start of
+/// monitoring.
+static rcl_time_point_value_t
+__event_reference_time(const rcl_event_impl_t * impl)
+{
+  rcl_statistics_t snapshot;
+  rcl_entity_statistics_snapshot(
+    (rcl_entity_statistics_t *)impl->statistics, &snapshot);
+  rcl_time_point_value_t reference = impl->monitor_start_time;
+  if (snapshot.last_activity_time > reference) {
+    reference = snapshot.last_activity_time;
+  }
+  if (impl->last_take_time > reference) {
+    reference = impl->last_take_time;
+  }
+  return reference;
+}
+
+int64_t
+rcl_event_time_until_deadline(const rcl_event_t * event, rcl_time_point_value_t now)
+{
+  return __event_reference_time(event->impl) + event->impl->options.deadline - now;
+}
+
+rcl_ret_t
+rcl_event_take(
+  const rcl_event_t * event,
+  rcl_event_status_t * status)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(event, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    event->impl, "event is invalid", return RCL_RET_EVENT_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(status, RCL_RET_INVALID_ARGUMENT);
+  rcl_time_point_value_t now = 0;
+  if (RCUTILS_RET_OK != rcutils_steady_time_now(&now)) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  rcl_event_impl_t * impl = event->impl;
+  const rcl_time_point_value_t reference = __event_reference_time(impl);
+  if (now - reference < impl->options.deadline) {
+    RCL_SET_ERROR_MSG("event deadline is not missed");
+    return RCL_RET_EVENT_TAKE_FAILED;
+  }
+  ++impl->total_count;
+  impl->last_take_time = now;
+  status->total_count = impl->total_count;
+  // Report the time since real activity, not since the last taken miss.
+  rcl_statistics_t snapshot;
+  rcl_entity_statistics_snapshot((rcl_entity_statistics_t *)impl->statistics, &snapshot);
+  rcl_time_point_value_t last_activity = impl->monitor_start_time;
+  if (snapshot.last_activity_time > last_activity) {
+    last_activity = snapshot.last_activity_time;
+  }
+  status->time_since_last_activity = now - last_activity;
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__EVENT_IMPL_H_
+#define RCL__EVENT_IMPL_H_
+
+#include "rcl/event.h"
+
+#include "./entity_statistics.h"
+
+typedef struct rcl_event_impl_t
+{
+  rcl_event_options_t options;
+  // Borrowed statistics block of the bound publisher or subscription, whose
+  // last_activity_time drives the deadline check.
+  const rcl_entity_statistics_t * statistics;
+  // Steady clock time at which monitoring began, the activity reference
+  // until the entity's first activity.
+  rcl_time_point_value_t monitor_start_time;
+  // Steady clock time of the last taken miss, 0 if none; re-arms the event.
+  rcl_time_point_value_t last_take_time;
+  // Number of misses taken so far, reported in rcl_event_status_t.
+  uint64_t total_count;
+} rcl_event_impl_t;
+
+// Internal hooks used by rcl_wait() to fold event deadlines into the wait
+// timeout and to detect missed deadlines after the wait.
+
+/// Return the nanoseconds from `now` until the event's deadline expires;
+/// zero or negative means the deadline is currently missed.
+int64_t
+rcl_event_time_until_deadline(const rcl_event_t * event, rcl_time_point_value_t now);
+
+// Internal accessors for the statistics blocks of the entities an event can
+// bind to, NULL when the entity keeps no statistics.
+
+rcl_entity_statistics_t *
+rcl_publisher_get_statistics_block(const rcl_publisher_t * publisher);
+
+rcl_entity_statistics_t *
+rcl_subscription_get_statistics_block(const rcl_subscription_t * subscription);
+
+#endif  // RCL__EVENT_IMPL_H_
@@ -23,6 +23,7 @@ extern "C"
 #include <string.h>
 
 #include "./common.h"
+#include "./topic_charclass.h"
 #include "rcl/error_handling.h"
 #include "rcl/types.h"
 #include "rcl/validate_topic_name.h"
@@ -32,6 +33,7 @@ extern "C"
 #include "rcutils/strdup.h"
 #include "rmw/error_handling.h"
 #include "rmw/types.h"
+#include "rmw/validate_full_topic_name.h"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 
@@ -40,21 +42,13 @@ extern "C"
 #define SUBSTITUION_NAMESPACE "{ns}"
 #define SUBSTITUION_NAMESPACE2 "{namespace}"
 
-rcl_ret_t
-rcl_expand_topic_name(
+/// Validate the topic name, node name, and namespace for expansion.
+static rcl_ret_t
+_rcl_expand_topic_name_validate_inputs(
   const char * input_topic_name,
   const char * node_name,
-  const char * node_namespace,
-  const rcutils_string_map_t * substitutions,
-  rcl_allocator_t allocator,
-  char ** output_topic_name)
+  const char * node_namespace)
 {
-  // check arguments that could be null
-  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
   // validate the input topic
   int validation_result;
   rcl_ret_t ret = rcl_validate_topic_name(input_topic_name, &validation_result, NULL);
@@ -101,6 +95,30 @@ rcl_expand_topic_name(
     RCL_SET_ERROR_MSG("node namespace is invalid");
     return RCL_RET_NODE_INVALID_NAMESPACE;
   }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_expand_topic_name(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  rcl_allocator_t allocator,
+  char ** output_topic_name)
+{
+  // check arguments that could be null
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_topic_name, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret =
+    _rcl_expand_topic_name_validate_inputs(input_topic_name, node_name, node_namespace);
+  if (ret != RCL_RET_OK) {
+    // error message already set
+    return ret;
+  }
   // check if the topic has substitutions to be made
   bool has_a_substitution = strchr(input_topic_name, '{') != NULL;
   bool has_a_namespace_tilde = input_topic_name[0] == '~';
@@ -234,6 +252,597 @@ rcl_expand_topic_name(
   return RCL_RET_OK;
 }
 
+/// Append length bytes of str to the buffer, keeping it null terminated.
+static bool
+_rcl_expand_topic_name_append(
+  char * buffer, size_t buffer_length, size_t * offset, const char * str, size_t length)
+{
+  if (*offset + length + 1 > buffer_length) {
+    return false;
+  }
+  memcpy(buffer + *offset, str, length);
+  *offset += length;
+  buffer[*offset] = '\0';
+  return true;
+}
+
+rcl_ret_t
+rcl_expand_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length)
+{
+  // check arguments that could be null
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_buffer, RCL_RET_INVALID_ARGUMENT);
+  if (0 == output_buffer_length) {
+    RCL_SET_ERROR_MSG("output buffer length is zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_ret_t ret =
+    _rcl_expand_topic_name_validate_inputs(input_topic_name, node_name, node_namespace);
+  if (ret != RCL_RET_OK) {
+    // error message already set
+    return ret;
+  }
+  size_t offset = 0;
+  output_buffer[0] = '\0';
+  size_t node_namespace_length = strlen(node_namespace);
+  const char * remaining = input_topic_name;
+  // if it starts with a namespace tilde, replace that first
+  if ('~' == input_topic_name[0]) {
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_namespace, node_namespace_length))
+    {
+      goto buffer_too_small;
+    }
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    if (node_namespace_length > 1) {
+      if (!_rcl_expand_topic_name_append(output_buffer, output_buffer_length, &offset, "/", 1)) {
+        goto buffer_too_small;
+      }
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_name, strlen(node_name)))
+    {
+      goto buffer_too_small;
+    }
+    remaining = input_topic_name + 1;
+  }
+  // copy the rest of the name, expanding substitutions as they are found
+  // (see rcl_expand_topic_name() for the assumptions about balanced braces,
+  // which are guaranteed by the validation above)
+  while (true) {
+    const char * next_opening_brace = strchr(remaining, '{');
+    if (NULL == next_opening_brace) {
+      if (!_rcl_expand_topic_name_append(
+          output_buffer, output_buffer_length, &offset, remaining, strlen(remaining)))
+      {
+        goto buffer_too_small;
+      }
+      break;
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, remaining,
+        (size_t)(next_opening_brace - remaining)))
+    {
+      goto buffer_too_small;
+    }
+    const char * next_closing_brace = strchr(next_opening_brace, '}');
+    size_t substitution_substr_len = next_closing_brace - next_opening_brace + 1;
+    // figure out what the replacement is for this substitution
+    const char * replacement = NULL;
+    if (strncmp(SUBSTITUION_NODE_NAME, next_opening_brace, substitution_substr_len) == 0) {
+      replacement = node_name;
+    } else if (  // NOLINT
+      strncmp(SUBSTITUION_NAMESPACE, next_opening_brace, substitution_substr_len) == 0 ||
+      strncmp(SUBSTITUION_NAMESPACE2, next_opening_brace, substitution_substr_len) == 0)
+    {
+      replacement = node_namespace;
+    } else {
+      replacement = rcutils_string_map_getn(
+        substitutions,
+        // compare {substitution}
+        //          ^ until    ^
+        next_opening_brace + 1, substitution_substr_len - 2);
+      if (!replacement) {
+        // in this case, it is neither node name nor ns nor in the substitutions map, so error
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "unknown substitution: %.*s", (int)substitution_substr_len, next_opening_brace);
+        return RCL_RET_UNKNOWN_SUBSTITUTION;
+      }
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, replacement, strlen(replacement)))
+    {
+      goto buffer_too_small;
+    }
+    remaining = next_closing_brace + 1;
+  }
+  // finally make the name absolute if it isn't already
+  if (output_buffer[0] != '/') {
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    size_t prefix_length = (node_namespace_length == 1) ? 1 : node_namespace_length + 1;
+    if (offset + prefix_length + 1 > output_buffer_length) {
+      goto buffer_too_small;
+    }
+    // shift the expanded name right, including the null terminator
+    memmove(output_buffer + prefix_length, output_buffer, offset + 1);
+    memcpy(output_buffer, node_namespace, node_namespace_length);
+    if (node_namespace_length > 1) {
+      output_buffer[node_namespace_length] = '/';
+    }
+  }
+  return RCL_RET_OK;
+buffer_too_small:
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+    "expanded topic name does not fit in buffer of length %zu", output_buffer_length);
+  return RCL_RET_BUFFER_TOO_SMALL;
+}
+
+/// Full topic name checks applied to the expanded name as it is produced.
+typedef struct rcl_expand_validate_state_t
+{
+  // one of the RMW_TOPIC_* validation results
+  int result;
+  // last character appended so far, '\0' before the first one
+  char prev;
+} rcl_expand_validate_state_t;
+
+/// Run the per-character full name rules over a newly appended segment.
+/**
+ * The absoluteness rule is not checked here because the expansion makes the
+ * name absolute by construction, and the trailing slash and length rules
+ * need the complete name, so they are checked once at the end.
+ */
+static void
+_rcl_expand_topic_name_validate_appended(
+  rcl_expand_validate_state_t * state, const char * str, size_t length)
+{
+  if (RMW_TOPIC_VALID != state->result) {
+    return;  // already invalid, keep the first result
+  }
+  for (size_t i = 0; i < length; ++i) {
+    const char c = str[i];
+    const uint8_t char_class = RCL_TOPIC_CHAR_CLASS(c);
+    if (char_class & RCL_TOPIC_CHAR_SLASH) {
+      if ('/' == state->prev) {
+        state->result = RMW_TOPIC_INVALID_CONTAINS_REPEATED_FORWARD_SLASH;
+        return;
+      }
+    } else if (char_class & RCL_TOPIC_CHAR_DIGIT) {
+      // position 0 is a token start too: the name either already begins the
+      // first token or gets the namespace and a '/' prepended before it
+      if ('\0' == state->prev || '/' == state->prev) {
+        state->result = RMW_TOPIC_INVALID_NAME_TOKEN_STARTS_WITH_NUMBER;
+        return;
+      }
+    } else if (!(char_class & RCL_TOPIC_CHAR_RUN)) {
+      // tildes and braces are not allowed in a fully expanded name either
+      state->result = RMW_TOPIC_INVALID_CONTAINS_UNALLOWED_CHARACTERS;
+      return;
+    }
+    state->prev = c;
+  }
+}
+
+rcl_ret_t
+rcl_expand_and_validate_topic_name_with_buffer(
+  const char * input_topic_name,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length,
+  int * validation_result)
+{
+  // check arguments that could be null
+  RCL_CHECK_ARGUMENT_FOR_NULL(input_topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_buffer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(validation_result, RCL_RET_INVALID_ARGUMENT);
+  if (0 == output_buffer_length) {
+    RCL_SET_ERROR_MSG("output buffer length is zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // The node name and namespace are taken to be valid already (they were
+  // validated when the node was initialized), so unlike the plain expansion
+  // there is no separate input validation pass; the brace assumptions it
+  // provided are checked inline below, and everything else is covered by
+  // validating the expanded output.
+  rcl_expand_validate_state_t state = {RMW_TOPIC_VALID, '\0'};
+  size_t offset = 0;
+  output_buffer[0] = '\0';
+  size_t node_namespace_length = strlen(node_namespace);
+  const char * remaining = input_topic_name;
+  // if it starts with a namespace tilde, replace that first
+  if ('~' == input_topic_name[0]) {
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_namespace, node_namespace_length))
+    {
+      goto buffer_too_small;
+    }
+    _rcl_expand_topic_name_validate_appended(&state, node_namespace, node_namespace_length);
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    if (node_namespace_length > 1) {
+      if (!_rcl_expand_topic_name_append(output_buffer, output_buffer_length, &offset, "/", 1)) {
+        goto buffer_too_small;
+      }
+      _rcl_expand_topic_name_validate_appended(&state, "/", 1);
+    }
+    size_t node_name_length = strlen(node_name);
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_name, node_name_length))
+    {
+      goto buffer_too_small;
+    }
+    _rcl_expand_topic_name_validate_appended(&state, node_name, node_name_length);
+    remaining = input_topic_name + 1;
+  }
+  // copy the rest of the name, validating each segment as it is appended
+  while (true) {
+    const char * next_opening_brace = strchr(remaining, '{');
+    if (NULL == next_opening_brace) {
+      size_t remaining_length = strlen(remaining);
+      if (!_rcl_expand_topic_name_append(
+          output_buffer, output_buffer_length, &offset, remaining, remaining_length))
+      {
+        goto buffer_too_small;
+      }
+      _rcl_expand_topic_name_validate_appended(&state, remaining, remaining_length);
+      break;
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, remaining,
+        (size_t)(next_opening_brace - remaining)))
+    {
+      goto buffer_too_small;
+    }
+    _rcl_expand_topic_name_validate_appended(
+      &state, remaining, (size_t)(next_opening_brace - remaining));
+    const char * next_closing_brace = strchr(next_opening_brace, '}');
+    if (NULL == next_closing_brace) {
+      // without the separate input validation pass, the brace balance the
+      // scan relies on has to be checked here
+      RCL_SET_ERROR_MSG("topic name has an unmatched '{'");
+      return RCL_RET_TOPIC_NAME_INVALID;
+    }
+    size_t substitution_substr_len = next_closing_brace - next_opening_brace + 1;
+    // figure out what the replacement is for this substitution
+    const char * replacement = NULL;
+    if (strncmp(SUBSTITUION_NODE_NAME, next_opening_brace, substitution_substr_len) == 0) {
+      replacement = node_name;
+    } else if (  // NOLINT
+      strncmp(SUBSTITUION_NAMESPACE, next_opening_brace, substitution_substr_len) == 0 ||
+      strncmp(SUBSTITUION_NAMESPACE2, next_opening_brace, substitution_substr_len) == 0)
+    {
+      replacement = node_namespace;
+    } else {
+      replacement = rcutils_string_map_getn(
+        substitutions,
+        // compare {substitution}
+        //          ^ until    ^
+        next_opening_brace + 1, substitution_substr_len - 2);
+      if (!replacement) {
+        // in this case, it is neither node name nor ns nor in the substitutions map, so error
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "unknown substitution: %.*s", (int)substitution_substr_len, next_opening_brace);
+        return RCL_RET_UNKNOWN_SUBSTITUTION;
+      }
+    }
+    size_t replacement_length = strlen(replacement);
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, replacement, replacement_length))
+    {
+      goto buffer_too_small;
+    }
+    _rcl_expand_topic_name_validate_appended(&state, replacement, replacement_length);
+    remaining = next_closing_brace + 1;
+  }
+  if (0 == offset) {
+    *validation_result = RMW_TOPIC_INVALID_IS_EMPTY_STRING;
+    return RCL_RET_OK;
+  }
+  // finally make the name absolute if it isn't already; the namespace was
+  // validated at node init, so the prefix needs no further checking
+  if (output_buffer[0] != '/') {
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    size_t prefix_length = (node_namespace_length == 1) ? 1 : node_namespace_length + 1;
+    if (offset + prefix_length + 1 > output_buffer_length) {
+      goto buffer_too_small;
+    }
+    // shift the expanded name right, including the null terminator
+    memmove(output_buffer + prefix_length, output_buffer, offset + 1);
+    memcpy(output_buffer, node_namespace, node_namespace_length);
+    if (node_namespace_length > 1) {
+      output_buffer[node_namespace_length] = '/';
+    }
+    offset += prefix_length;
+  }
+  // the rules which need the complete name
+  if (RMW_TOPIC_VALID == state.result) {
+    if ('/' == state.prev && offset > 1) {
+      state.result = RMW_TOPIC_INVALID_ENDS_WITH_FORWARD_SLASH;
+    } else if (offset > RMW_TOPIC_MAX_NAME_LENGTH) {
+      state.result = RMW_TOPIC_INVALID_TOO_LONG;
+    }
+  }
+  *validation_result = state.result;
+  return RCL_RET_OK;
+buffer_too_small:
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+    "expanded topic name does not fit in buffer of length %zu", output_buffer_length);
+  return RCL_RET_BUFFER_TOO_SMALL;
+}
+
+/// What a template segment contributes to the expanded name.
+typedef enum rcl_topic_template_segment_kind_t
+{
+  // a literal run of the spec, copied as-is
+  RCL_TOPIC_TEMPLATE_SEGMENT_LITERAL,
+  // the node name, i.e. a {node} slot
+  RCL_TOPIC_TEMPLATE_SEGMENT_NODE_NAME,
+  // the node namespace, i.e. a {ns} or {namespace} slot
+  RCL_TOPIC_TEMPLATE_SEGMENT_NAMESPACE,
+  // a substitution looked up in the map given to each render
+  RCL_TOPIC_TEMPLATE_SEGMENT_CUSTOM,
+} rcl_topic_template_segment_kind_t;
+
+typedef struct rcl_topic_template_segment_t
+{
+  rcl_topic_template_segment_kind_t kind;
+  // literal run or custom substitution key, pointing into the owned spec copy
+  const char * text;
+  size_t length;
+} rcl_topic_template_segment_t;
+
+typedef struct rcl_topic_template_impl_t
+{
+  rcl_allocator_t allocator;
+  /// Owned copy of the spec; segments point into it.
+  char * spec;
+  rcl_topic_template_segment_t * segments;
+  size_t segment_count;
+  /// The spec began with '~', expanded to namespace + node name up front.
+  bool has_tilde;
+} rcl_topic_template_impl_t;
+
+rcl_topic_template_t
+rcl_get_zero_initialized_topic_template(void)
+{
+  static rcl_topic_template_t null_template = {
+    .impl = NULL
+  };
+  return null_template;
+}
+
+rcl_ret_t
+rcl_topic_template_compile(
+  const char * topic_name_spec,
+  rcl_allocator_t allocator,
+  rcl_topic_template_t * topic_template)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name_spec, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_template, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != topic_template->impl) {
+    RCL_SET_ERROR_MSG("topic template already compiled, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  // validation establishes the brace assumptions the scan below relies on:
+  // all {} matched and balanced, no nesting, no empty {}
+  int validation_result;
+  rcl_ret_t ret = rcl_validate_topic_name(topic_name_spec, &validation_result, NULL);
+  if (ret != RCL_RET_OK) {
+    // error message already set
+    return ret;
+  }
+  if (validation_result != RCL_TOPIC_NAME_VALID) {
+    RCL_SET_ERROR_MSG("topic name is invalid");
+    return RCL_RET_TOPIC_NAME_INVALID;
+  }
+  rcl_topic_template_impl_t * impl =
+    allocator.zero_allocate(1, sizeof(rcl_topic_template_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "failed to allocate memory for topic template", return RCL_RET_BAD_ALLOC);
+  impl->allocator = allocator;
+  impl->spec = rcutils_strdup(topic_name_spec, allocator);
+  if (NULL == impl->spec) {
+    allocator.deallocate(impl, allocator.state);
+    RCL_SET_ERROR_MSG("failed to allocate memory for topic template spec");
+    return RCL_RET_BAD_ALLOC;
+  }
+  // every substitution contributes one slot and at most one literal run
+  // before it, plus at most one trailing literal run
+  size_t max_segments = 1;
+  for (const char * p = impl->spec; '\0' != *p; ++p) {
+    if ('{' == *p) {
+      max_segments += 2;
+    }
+  }
+  impl->segments = allocator.allocate(
+    sizeof(rcl_topic_template_segment_t) * max_segments, allocator.state);
+  if (NULL == impl->segments) {
+    allocator.deallocate(impl->spec, allocator.state);
+    allocator.deallocate(impl, allocator.state);
+    RCL_SET_ERROR_MSG("failed to allocate memory for topic template segments");
+    return RCL_RET_BAD_ALLOC;
+  }
+  const char * remaining = impl->spec;
+  if ('~' == remaining[0]) {
+    impl->has_tilde = true;
+    ++remaining;
+  }
+  while ('\0' != *remaining) {
+    const char * next_opening_brace = strchr(remaining, '{');
+    size_t literal_length = (NULL != next_opening_brace) ?
+      (size_t)(next_opening_brace - remaining) : strlen(remaining);
+    if (literal_length > 0) {
+      rcl_topic_template_segment_t * segment = &impl->segments[impl->segment_count++];
+      segment->kind = RCL_TOPIC_TEMPLATE_SEGMENT_LITERAL;
+      segment->text = remaining;
+      segment->length = literal_length;
+    }
+    if (NULL == next_opening_brace) {
+      break;
+    }
+    const char * next_closing_brace = strchr(next_opening_brace, '}');
+    size_t substitution_substr_len = next_closing_brace - next_opening_brace + 1;
+    rcl_topic_template_segment_t * segment = &impl->segments[impl->segment_count++];
+    if (strncmp(SUBSTITUION_NODE_NAME, next_opening_brace, substitution_substr_len) == 0) {
+      segment->kind = RCL_TOPIC_TEMPLATE_SEGMENT_NODE_NAME;
+      segment->text = NULL;
+      segment->length = 0;
+    } else if (  // NOLINT
+      strncmp(SUBSTITUION_NAMESPACE, next_opening_brace, substitution_substr_len) == 0 ||
+      strncmp(SUBSTITUION_NAMESPACE2, next_opening_brace, substitution_substr_len) == 0)
+    {
+      segment->kind = RCL_TOPIC_TEMPLATE_SEGMENT_NAMESPACE;
+      segment->text = NULL;
+      segment->length = 0;
+    } else {
+      segment->kind = RCL_TOPIC_TEMPLATE_SEGMENT_CUSTOM;
+      // store {substitution}
+      //        ^ until    ^
+      segment->text = next_opening_brace + 1;
+      segment->length = substitution_substr_len - 2;
+    }
+    remaining = next_closing_brace + 1;
+  }
+  topic_template->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_topic_template_render(
+  const rcl_topic_template_t * topic_template,
+  const char * node_name,
+  const char * node_namespace,
+  const rcutils_string_map_t * substitutions,
+  char * output_buffer,
+  size_t output_buffer_length)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_template, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    topic_template->impl, "topic template is not compiled", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(substitutions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(output_buffer, RCL_RET_INVALID_ARGUMENT);
+  if (0 == output_buffer_length) {
+    RCL_SET_ERROR_MSG("output buffer length is zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const rcl_topic_template_impl_t * impl = topic_template->impl;
+  size_t offset = 0;
+  output_buffer[0] = '\0';
+  size_t node_namespace_length = strlen(node_namespace);
+  if (impl->has_tilde) {
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_namespace, node_namespace_length))
+    {
+      goto buffer_too_small;
+    }
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    if (node_namespace_length > 1) {
+      if (!_rcl_expand_topic_name_append(output_buffer, output_buffer_length, &offset, "/", 1)) {
+        goto buffer_too_small;
+      }
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, node_name, strlen(node_name)))
+    {
+      goto buffer_too_small;
+    }
+  }
+  for (size_t i = 0; i < impl->segment_count; ++i) {
+    const rcl_topic_template_segment_t * segment = &impl->segments[i];
+    const char * text = NULL;
+    size_t length = 0;
+    switch (segment->kind) {
+      case RCL_TOPIC_TEMPLATE_SEGMENT_LITERAL:
+        text = segment->text;
+        length = segment->length;
+        break;
+      case RCL_TOPIC_TEMPLATE_SEGMENT_NODE_NAME:
+        text = node_name;
+        length = strlen(node_name);
+        break;
+      case RCL_TOPIC_TEMPLATE_SEGMENT_NAMESPACE:
+        text = node_namespace;
+        length = node_namespace_length;
+        break;
+      case RCL_TOPIC_TEMPLATE_SEGMENT_CUSTOM:
+        text = rcutils_string_map_getn(substitutions, segment->text, segment->length);
+        if (NULL == text) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "unknown substitution: {%.*s}", (int)segment->length, segment->text);
+          return RCL_RET_UNKNOWN_SUBSTITUTION;
+        }
+        length = strlen(text);
+        break;
+      default:
+        RCL_SET_ERROR_MSG("corrupt topic template segment");
+        return RCL_RET_ERROR;
+    }
+    if (!_rcl_expand_topic_name_append(
+        output_buffer, output_buffer_length, &offset, text, length))
+    {
+      goto buffer_too_small;
+    }
+  }
+  // finally make the name absolute if it isn't already
+  if (output_buffer[0] != '/') {
+    // special case where node_namespace is just '/'
+    // then no additional separating '/' is needed
+    size_t prefix_length = (node_namespace_length == 1) ? 1 : node_namespace_length + 1;
+    if (offset + prefix_length + 1 > output_buffer_length) {
+      goto buffer_too_small;
+    }
+    // shift the expanded name right, including the null terminator
+    memmove(output_buffer + prefix_length, output_buffer, offset + 1);
+    memcpy(output_buffer, node_namespace, node_namespace_length);
+    if (node_namespace_length > 1) {
+      output_buffer[node_namespace_length] = '/';
+    }
+  }
+  return RCL_RET_OK;
+buffer_too_small:
+  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+    "expanded topic name does not fit in buffer of length %zu", output_buffer_length);
+  return RCL_RET_BUFFER_TOO_SMALL;
+}
+
+rcl_ret_t
+rcl_topic_template_fini(rcl_topic_template_t * topic_template)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_template, RCL_RET_INVALID_ARGUMENT);
+  rcl_topic_template_impl_t * impl = topic_template->impl;
+  if (NULL == impl) {
+    // repeat calls to fini or fini on a zero initialized template is ok
+    return RCL_RET_OK;
+  }
+  rcl_allocator_t allocator = impl->allocator;
+  allocator.deallocate(impl->segments, allocator.state);
+  allocator.deallocate(impl->spec, allocator.state);
+  allocator.deallocate(impl, allocator.state);
+  topic_template->impl = NULL;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_get_default_topic_name_substitutions(rcutils_string_map_t * string_map)
 {
@@ -19,15 +19,27 @@ extern "C"
 
 #include "rcl/graph.h"
 
+#include <string.h>
+
+#include "rcl/counting_allocator.h"
 #include "rcl/error_handling.h"
+#include "rcl/wait.h"
 #include "rcutils/allocator.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/strdup.h"
+#include "rcutils/time.h"
 #include "rcutils/types.h"
+#include "rmw/error_handling.h"
+#include "rmw/get_node_info_and_types.h"
+#include "rmw/validate_namespace.h"
+#include "rmw/validate_node_name.h"
 #include "rmw/get_service_names_and_types.h"
 #include "rmw/get_topic_names_and_types.h"
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 
 #include "./common.h"
+#include "./graph_cache.h"
 
 rcl_ret_t
 rcl_get_topic_names_and_types(
@@ -46,7 +58,13 @@ rcl_get_topic_names_and_types(
   if (rmw_ret != RMW_RET_OK) {
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
-  rcutils_allocator_t rcutils_allocator = *allocator;
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    return rcl_graph_cache_get_topic_names_and_types(
+      graph_cache, node, allocator, no_demangle, topic_names_and_types);
+  }
+  rcutils_allocator_t rcutils_allocator =
+    rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
   rmw_ret = rmw_get_topic_names_and_types(
     rcl_node_get_rmw_handle(node),
     &rcutils_allocator,
@@ -71,7 +89,13 @@ rcl_get_service_names_and_types(
   if (rmw_ret != RMW_RET_OK) {
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
-  rcutils_allocator_t rcutils_allocator = *allocator;
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    return rcl_graph_cache_get_service_names_and_types(
+      graph_cache, node, allocator, service_names_and_types);
+  }
+  rcutils_allocator_t rcutils_allocator =
+    rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
   rmw_ret = rmw_get_service_names_and_types(
     rcl_node_get_rmw_handle(node),
     &rcutils_allocator,
@@ -80,6 +104,407 @@ rcl_get_service_names_and_types(
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+/// Copy `input` into `output` using `allocator`; `output` must be zero initialized.
+static rcl_ret_t
+__copy_type_array(
+  const rcutils_string_array_t * input,
+  rcl_allocator_t * allocator,
+  rcutils_string_array_t * output)
+{
+  rcutils_ret_t rcutils_ret = rcutils_string_array_init(output, input->size, allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < input->size; ++i) {
+    output->data[i] = rcutils_strdup(input->data[i], *allocator);
+    if (NULL == output->data[i]) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_types_for_topics(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const char ** topics,
+  size_t topic_count,
+  bool no_demangle,
+  rcutils_string_array_t * types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topics, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(types, RCL_RET_INVALID_ARGUMENT);
+
+  // Take the full snapshot once; with the graph cache enabled the cached
+  // one is borrowed instead of queried and copied.
+  rcl_names_and_types_t local_snapshot = rmw_get_zero_initialized_names_and_types();
+  bool owns_snapshot = false;
+  const rcl_names_and_types_t * snapshot = NULL;
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    snapshot = rcl_graph_cache_peek_topic_names_and_types(graph_cache, node, no_demangle);
+    if (NULL == snapshot) {
+      return RCL_RET_ERROR;  // error already set
+    }
+  } else {
+    rcutils_allocator_t rcutils_allocator =
+      rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
+    rmw_ret_t rmw_ret = rmw_get_topic_names_and_types(
+      rcl_node_get_rmw_handle(node), &rcutils_allocator, no_demangle, &local_snapshot);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    snapshot = &local_snapshot;
+    owns_snapshot = true;
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+  size_t filled = 0;
+  for (; filled < topic_count; ++filled) {
+    const rcutils_string_array_t * found = NULL;
+    for (size_t i = 0; i < snapshot->names.size; ++i) {
+      if (0 == strcmp(topics[filled], snapshot->names.data[i])) {
+        found = &snapshot->types[i];
+        break;
+      }
+    }
+    if (NULL != found) {
+      ret = __copy_type_array(found, allocator, &types[filled]);
+    } else {
+      // an unknown topic yields an empty type list
+      rcutils_ret_t rcutils_ret = rcutils_string_array_init(&types[filled], 0, allocator);
+      if (RCUTILS_RET_OK != rcutils_ret) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        ret = RCL_RET_BAD_ALLOC;
+      }
+    }
+    if (RCL_RET_OK != ret) {
+      break;
+    }
+  }
+  if (RCL_RET_OK != ret) {
+    // unwind the arrays filled so far, including the partially filled one
+    for (size_t i = 0; i <= filled; ++i) {
+      if (RCUTILS_RET_OK != rcutils_string_array_fini(&types[i])) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini string array after error occurred");
+      }
+    }
+  }
+  if (owns_snapshot) {
+    rmw_ret_t rmw_ret = rmw_names_and_types_fini(&local_snapshot);
+    if (RMW_RET_OK != rmw_ret && RCL_RET_OK == ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_get_topic_names_and_types_arena(
+  const rcl_node_t * node,
+  rcl_arena_t * arena,
+  bool no_demangle,
+  rcl_names_and_types_t * topic_names_and_types)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(arena, RCL_RET_INVALID_ARGUMENT);
+  // The arena allocator lands every string and array of the result in the
+  // arena; the other arguments are checked by the delegate.
+  rcl_allocator_t allocator = rcl_arena_get_allocator(arena);
+  return rcl_get_topic_names_and_types(node, &allocator, no_demangle, topic_names_and_types);
+}
+
+rcl_ret_t
+rcl_get_graph_changes(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  uint64_t since_token,
+  rcl_names_and_types_t * additions,
+  rcl_names_and_types_t * removals,
+  uint64_t * new_token)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(additions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(removals, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(new_token, RCL_RET_INVALID_ARGUMENT);
+  rmw_ret_t rmw_ret = rmw_names_and_types_check_zero(additions);
+  if (rmw_ret != RMW_RET_OK) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rmw_ret = rmw_names_and_types_check_zero(removals);
+  if (rmw_ret != RMW_RET_OK) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    graph_cache, "graph cache is not enabled on this node", return RCL_RET_UNSUPPORTED);
+  return rcl_graph_cache_get_graph_changes(
+    graph_cache, node, allocator, since_token, additions, removals, new_token);
+}
+
+rcl_topics_cursor_t
+rcl_get_zero_initialized_topics_cursor(void)
+{
+  static rcl_topics_cursor_t zero_initialized_cursor;
+  return zero_initialized_cursor;
+}
+
+rcl_ret_t
+rcl_topics_cursor_init(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  rcl_topics_cursor_t * cursor)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cursor, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != cursor->node) {
+    RCL_SET_ERROR_MSG("cursor is already initialized");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  cursor->allocator = *allocator;
+  cursor->no_demangle = no_demangle;
+  cursor->position = 0;
+  cursor->snapshot = rmw_get_zero_initialized_names_and_types();
+  cursor->owns_snapshot = false;
+  cursor->generation = 0;
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    // iterate the cache's snapshot in place; the generation pins the
+    // iteration to one consistent snapshot
+    if (NULL == rcl_graph_cache_peek_topic_names_and_types(graph_cache, node, no_demangle)) {
+      return RCL_RET_ERROR;  // error already set
+    }
+    cursor->generation = rcl_graph_cache_generation(graph_cache);
+  } else {
+    // without a cache the cursor holds its own snapshot; the caller's
+    // working set per chunk is still O(chunk)
+    rcutils_allocator_t rcutils_allocator =
+      rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
+    rmw_ret_t rmw_ret = rmw_get_topic_names_and_types(
+      rcl_node_get_rmw_handle(node), &rcutils_allocator, no_demangle, &cursor->snapshot);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    cursor->owns_snapshot = true;
+  }
+  cursor->node = node;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_topics_cursor_next(
+  rcl_topics_cursor_t * cursor,
+  size_t chunk_size,
+  rcl_names_and_types_t * chunk)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(cursor, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    cursor->node, "cursor not initialized", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(chunk, RCL_RET_INVALID_ARGUMENT);
+  if (0 == chunk_size) {
+    RCL_SET_ERROR_MSG("chunk_size must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // reuse the chunk buffer: tear down what the previous call put in it
+  if (RMW_RET_OK != rmw_names_and_types_check_zero(chunk)) {
+    rmw_reset_error();
+    rmw_ret_t rmw_ret = rmw_names_and_types_fini(chunk);
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+  }
+  const rcl_names_and_types_t * snapshot = &cursor->snapshot;
+  if (!cursor->owns_snapshot) {
+    rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(cursor->node);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      graph_cache, "graph cache disappeared while iterating", return RCL_RET_ERROR);
+    if (rcl_graph_cache_generation(graph_cache) != cursor->generation) {
+      RCL_SET_ERROR_MSG("graph changed while iterating, restart the cursor");
+      return RCL_RET_ERROR;
+    }
+    snapshot = rcl_graph_cache_peek_topic_names_and_types(
+      graph_cache, cursor->node, cursor->no_demangle);
+    if (NULL == snapshot) {
+      return RCL_RET_ERROR;  // error already set
+    }
+  }
+  rcl_ret_t ret = rcl_graph_cache_copy_names_and_types_slice(
+    snapshot, cursor->position, chunk_size, &cursor->allocator, chunk);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  cursor->position += chunk->names.size;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_topics_cursor_fini(rcl_topics_cursor_t * cursor)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(cursor, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = RCL_RET_OK;
+  if (cursor->owns_snapshot) {
+    rmw_ret_t rmw_ret = rmw_names_and_types_fini(&cursor->snapshot);
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+  }
+  *cursor = rcl_get_zero_initialized_topics_cursor();
+  return ret;
+}
+
+/// Validate the name and namespace of a (possibly remote) node.
+static rcl_ret_t
+__validate_remote_node_name(const char * node_name, const char * node_namespace)
+{
+  int validation_result = 0;
+  rmw_ret_t rmw_ret = rmw_validate_node_name(node_name, &validation_result, NULL);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (RMW_NODE_NAME_VALID != validation_result) {
+    RCL_SET_ERROR_MSG(rmw_node_name_validation_result_string(validation_result));
+    return RCL_RET_NODE_INVALID_NAME;
+  }
+  validation_result = 0;
+  rmw_ret = rmw_validate_namespace(node_namespace, &validation_result, NULL);
+  if (RMW_RET_OK != rmw_ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  if (RMW_NAMESPACE_VALID != validation_result) {
+    RCL_SET_ERROR_MSG(rmw_namespace_validation_result_string(validation_result));
+    return RCL_RET_NODE_INVALID_NAMESPACE;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_get_publisher_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * topic_names_and_types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  rmw_ret_t rmw_ret = rmw_names_and_types_check_zero(topic_names_and_types);
+  if (rmw_ret != RMW_RET_OK) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcl_ret_t ret = __validate_remote_node_name(node_name, node_namespace);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  rcutils_allocator_t rcutils_allocator =
+    rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
+  rmw_ret = rmw_get_publisher_names_and_types_by_node(
+    rcl_node_get_rmw_handle(node),
+    &rcutils_allocator,
+    node_name,
+    node_namespace,
+    no_demangle,
+    topic_names_and_types
+  );
+  return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+}
+
+rcl_ret_t
+rcl_get_subscriber_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * topic_names_and_types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  rmw_ret_t rmw_ret = rmw_names_and_types_check_zero(topic_names_and_types);
+  if (rmw_ret != RMW_RET_OK) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcl_ret_t ret = __validate_remote_node_name(node_name, node_namespace);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  rcutils_allocator_t rcutils_allocator =
+    rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
+  rmw_ret = rmw_get_subscriber_names_and_types_by_node(
+    rcl_node_get_rmw_handle(node),
+    &rcutils_allocator,
+    node_name,
+    node_namespace,
+    no_demangle,
+    topic_names_and_types
+  );
+  return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+}
+
+rcl_ret_t
+rcl_get_service_names_and_types_by_node(
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rcl_names_and_types_t * service_names_and_types)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_namespace, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(service_names_and_types, RCL_RET_INVALID_ARGUMENT);
+  rmw_ret_t rmw_ret = rmw_names_and_types_check_zero(service_names_and_types);
+  if (rmw_ret != RMW_RET_OK) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  rcl_ret_t ret = __validate_remote_node_name(node_name, node_namespace);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  rcutils_allocator_t rcutils_allocator =
+    rcl_counting_allocator_wrap(*allocator, RCL_ALLOC_TAG_GRAPH);
+  rmw_ret = rmw_get_service_names_and_types_by_node(
+    rcl_node_get_rmw_handle(node),
+    &rcutils_allocator,
+    node_name,
+    node_namespace,
+    service_names_and_types
+  );
+  return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+}
+
 rcl_ret_t
 rcl_names_and_types_fini(rcl_names_and_types_t * topic_names_and_types)
 {
@@ -116,6 +541,12 @@ rcl_get_node_names(
     RCL_SET_ERROR_MSG("node_namespaces is not null");
     return RCL_RET_INVALID_ARGUMENT;
   }
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    // the cached copies handed to the caller are made with this allocator
+    return rcl_graph_cache_get_node_names(
+      graph_cache, node, allocator, node_names, node_namespaces);
+  }
   (void)allocator;  // to be used in rmw_get_node_names in the future
   rmw_ret_t rmw_ret = rmw_get_node_names(
     rcl_node_get_rmw_handle(node),
@@ -139,6 +570,10 @@ rcl_count_publishers(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    return rcl_graph_cache_count_entities(graph_cache, node, topic_name, false, count);
+  }
   rmw_ret_t rmw_ret = rmw_count_publishers(rcl_node_get_rmw_handle(node), topic_name, count);
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
@@ -158,6 +593,10 @@ rcl_count_subscribers(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  if (NULL != graph_cache) {
+    return rcl_graph_cache_count_entities(graph_cache, node, topic_name, true, count);
+  }
   rmw_ret_t rmw_ret = rmw_count_subscribers(rcl_node_get_rmw_handle(node), topic_name, count);
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
@@ -185,6 +624,95 @@ rcl_service_server_is_available(
   return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
 }
 
+rcl_ret_t
+rcl_client_wait_for_service(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  int64_t timeout,
+  bool * is_available)
+{
+  // node, client and is_available are checked by the availability query below
+  rcl_ret_t ret = rcl_service_server_is_available(node, client, is_available);
+  if (RCL_RET_OK != ret || *is_available || 0 == timeout) {
+    return ret;
+  }
+  const rcl_guard_condition_t * graph_guard_condition =
+    rcl_node_get_graph_guard_condition(node);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    graph_guard_condition, "failed to get graph guard condition", return RCL_RET_ERROR);
+
+  rcutils_time_point_value_t deadline = 0;
+  if (timeout > 0) {
+    rcutils_ret_t rcutils_ret = rcutils_steady_time_now(&deadline);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    deadline += timeout;
+  }
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, rcl_node_get_options(node)->allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  while (true) {
+    int64_t wait_timeout = -1;
+    if (timeout > 0) {
+      rcutils_time_point_value_t now = 0;
+      rcutils_ret_t rcutils_ret = rcutils_steady_time_now(&now);
+      if (RCUTILS_RET_OK != rcutils_ret) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        ret = RCL_RET_ERROR;
+        break;
+      }
+      if (now >= deadline) {
+        ret = RCL_RET_TIMEOUT;
+        break;
+      }
+      wait_timeout = deadline - now;
+    }
+    ret = rcl_wait_set_clear(&wait_set);
+    if (RCL_RET_OK != ret) {
+      break;
+    }
+    ret = rcl_wait_set_add_guard_condition(&wait_set, graph_guard_condition, NULL);
+    if (RCL_RET_OK != ret) {
+      break;
+    }
+    ret = rcl_wait(&wait_set, wait_timeout);
+    if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
+      break;
+    }
+    // The graph changed (or the wait timed out); re-check before deciding.
+    ret = rcl_service_server_is_available(node, client, is_available);
+    if (RCL_RET_OK != ret || *is_available) {
+      break;
+    }
+  }
+  rcl_ret_t fini_ret = rcl_wait_set_fini(&wait_set);
+  if (RCL_RET_OK == ret && RCL_RET_OK != fini_ret) {
+    ret = fini_ret;
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_client_notify_on_service_available(
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  rcl_guard_condition_t * guard_condition)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(client, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_cache_t * graph_cache = rcl_node_get_graph_cache(node);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    graph_cache, "graph cache is not enabled on this node", return RCL_RET_UNSUPPORTED);
+  return rcl_graph_cache_set_service_watch(graph_cache, node, client, guard_condition);
+}
+
 #ifdef __cplusplus
 }
 #endif
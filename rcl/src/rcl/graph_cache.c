@@ -0,0 +1,738 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./graph_cache.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcl/guard_condition.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/string_array.h"
+#include "rmw/error_handling.h"
+#include "rmw/get_service_names_and_types.h"
+#include "rmw/get_topic_names_and_types.h"
+#include "rmw/names_and_types.h"
+#include "rmw/rmw.h"
+
+#include "./common.h"
+
+/// One-shot watch firing a user guard condition when a service appears.
+typedef struct rcl_graph_service_watch_t
+{
+  const rcl_client_t * client;
+  rcl_guard_condition_t * guard_condition;
+  struct rcl_graph_service_watch_t * next;
+} rcl_graph_service_watch_t;
+
+/// Cached entity count for one topic and direction (publishers or subscribers).
+typedef struct rcl_graph_count_entry_t
+{
+  char * topic_name;
+  bool count_subscribers;
+  size_t count;
+  // Generation of the cached count; 0 means never counted.
+  uint64_t count_generation;
+  // Fired when the count crosses zero in either direction, or NULL.
+  rcl_count_change_callback_t callback;
+  void * callback_user_data;
+  struct rcl_graph_count_entry_t * next;
+} rcl_graph_count_entry_t;
+
+typedef struct rcl_graph_cache_t
+{
+  rcl_allocator_t allocator;
+  // Bumped by rcl_graph_cache_mark_changed(); a snapshot captured at an
+  // older generation is stale.  Starts at 1 so generation 0 can mean
+  // "never captured" below.
+  uint64_t generation;
+
+  // topic snapshot
+  rcl_names_and_types_t topics;
+  uint64_t topics_generation;
+  bool topics_no_demangle;
+
+  // service snapshot
+  rcl_names_and_types_t services;
+  uint64_t services_generation;
+
+  // node name snapshot
+  rcutils_string_array_t node_names;
+  rcutils_string_array_t node_namespaces;
+  uint64_t nodes_generation;
+
+  // baseline topic snapshot for rcl_get_graph_changes(); holds the topics
+  // as of the last delta query, identified by its token (0 means none).
+  rcl_names_and_types_t delta_baseline;
+  uint64_t delta_token;
+
+  // cached per-topic publisher/subscriber counts
+  rcl_graph_count_entry_t * count_entries;
+
+  // pending service availability notifications
+  rcl_graph_service_watch_t * service_watches;
+} rcl_graph_cache_t;
+
+rcl_graph_cache_t *
+rcl_graph_cache_create(const rcl_allocator_t * allocator)
+{
+  rcl_graph_cache_t * cache = (rcl_graph_cache_t *)allocator->zero_allocate(
+    1, sizeof(rcl_graph_cache_t), allocator->state);
+  if (NULL == cache) {
+    return NULL;
+  }
+  cache->allocator = *allocator;
+  cache->generation = 1;
+  cache->topics = rmw_get_zero_initialized_names_and_types();
+  cache->services = rmw_get_zero_initialized_names_and_types();
+  cache->node_names = rcutils_get_zero_initialized_string_array();
+  cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+  cache->delta_baseline = rmw_get_zero_initialized_names_and_types();
+  return cache;
+}
+
+void
+rcl_graph_cache_destroy(rcl_graph_cache_t * cache)
+{
+  if (NULL == cache) {
+    return;
+  }
+  if (0 != cache->topics_generation) {
+    if (RMW_RET_OK != rmw_names_and_types_fini(&cache->topics)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini cached topic names: %s", rmw_get_error_string().str);
+    }
+  }
+  if (0 != cache->services_generation) {
+    if (RMW_RET_OK != rmw_names_and_types_fini(&cache->services)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini cached service names: %s", rmw_get_error_string().str);
+    }
+  }
+  if (0 != cache->nodes_generation) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(&cache->node_names) ||
+      RCUTILS_RET_OK != rcutils_string_array_fini(&cache->node_namespaces))
+    {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini cached node names: %s",
+        rcutils_get_error_string().str);
+    }
+  }
+  if (0 != cache->delta_token) {
+    if (RMW_RET_OK != rmw_names_and_types_fini(&cache->delta_baseline)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini delta baseline: %s", rmw_get_error_string().str);
+    }
+  }
+  rcl_graph_count_entry_t * entry = cache->count_entries;
+  while (NULL != entry) {
+    rcl_graph_count_entry_t * next = entry->next;
+    cache->allocator.deallocate(entry->topic_name, cache->allocator.state);
+    cache->allocator.deallocate(entry, cache->allocator.state);
+    entry = next;
+  }
+  rcl_graph_service_watch_t * watch = cache->service_watches;
+  while (NULL != watch) {
+    rcl_graph_service_watch_t * next = watch->next;
+    cache->allocator.deallocate(watch, cache->allocator.state);
+    watch = next;
+  }
+  cache->allocator.deallocate(cache, cache->allocator.state);
+}
+
+void
+rcl_graph_cache_mark_changed(rcl_graph_cache_t * cache)
+{
+  if (NULL == cache) {
+    return;
+  }
+  ++cache->generation;
+}
+
+uint64_t
+rcl_graph_cache_generation(const rcl_graph_cache_t * cache)
+{
+  if (NULL == cache) {
+    return 0;
+  }
+  return cache->generation;
+}
+
+/// Deep copy a string array using the given allocator.
+static rcl_ret_t
+_rcl_graph_cache_copy_string_array(
+  const rcutils_string_array_t * input,
+  rcl_allocator_t allocator,
+  rcutils_string_array_t * output)
+{
+  rcutils_ret_t rcutils_ret = rcutils_string_array_init(output, input->size, &allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0; i < input->size; ++i) {
+    output->data[i] = rcutils_strdup(input->data[i], allocator);
+    if (NULL == output->data[i]) {
+      if (RCUTILS_RET_OK != rcutils_string_array_fini(output)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini string array after error occurred");
+      }
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+/// Deep copy entry `i` of `input` into entry `out_i` of an initialized `output`.
+static rcl_ret_t
+_rcl_graph_cache_copy_entry(
+  const rcl_names_and_types_t * input,
+  size_t i,
+  rcl_allocator_t allocator,
+  rcl_names_and_types_t * output,
+  size_t out_i)
+{
+  output->names.data[out_i] = rcutils_strdup(input->names.data[i], allocator);
+  if (NULL == output->names.data[out_i]) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcutils_allocator_t rcutils_allocator = allocator;
+  rcutils_ret_t rcutils_ret =
+    rcutils_string_array_init(&output->types[out_i], input->types[i].size, &rcutils_allocator);
+  if (RCUTILS_RET_OK != rcutils_ret) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t j = 0; j < input->types[i].size; ++j) {
+    output->types[out_i].data[j] = rcutils_strdup(input->types[i].data[j], allocator);
+    if (NULL == output->types[out_i].data[j]) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_copy_names_and_types_slice(
+  const rcl_names_and_types_t * input,
+  size_t begin,
+  size_t count,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * output)
+{
+  if (begin > input->names.size) {
+    begin = input->names.size;
+  }
+  if (count > input->names.size - begin) {
+    count = input->names.size - begin;
+  }
+  rcutils_allocator_t rcutils_allocator = *allocator;
+  rmw_ret_t rmw_ret = rmw_names_and_types_init(output, count, &rcutils_allocator);
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    if (RCL_RET_OK != _rcl_graph_cache_copy_entry(input, begin + i, *allocator, output, i)) {
+      if (RMW_RET_OK != rmw_names_and_types_fini(output)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini names and types after error occurred");
+      }
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+/// Deep copy a cached snapshot into a caller owned names and types struct.
+static rcl_ret_t
+_rcl_graph_cache_copy_names_and_types(
+  const rcl_names_and_types_t * input,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * output)
+{
+  return rcl_graph_cache_copy_names_and_types_slice(
+    input, 0, input->names.size, allocator, output);
+}
+
+/// Refresh the topic snapshot through rmw if it cannot serve this query.
+static rcl_ret_t
+_rcl_graph_cache_refresh_topics(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  bool no_demangle)
+{
+  if (cache->topics_generation == cache->generation &&
+    cache->topics_no_demangle == no_demangle)
+  {
+    return RCL_RET_OK;
+  }
+  // stale, missing, or captured with the other demangle setting
+  if (0 != cache->topics_generation) {
+    rmw_ret_t rmw_ret = rmw_names_and_types_fini(&cache->topics);
+    cache->topics_generation = 0;
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+  }
+  cache->topics = rmw_get_zero_initialized_names_and_types();
+  rcutils_allocator_t rcutils_allocator = cache->allocator;
+  rmw_ret_t rmw_ret = rmw_get_topic_names_and_types(
+    rcl_node_get_rmw_handle(node), &rcutils_allocator, no_demangle, &cache->topics);
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  cache->topics_generation = cache->generation;
+  cache->topics_no_demangle = no_demangle;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_get_topic_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  rcl_names_and_types_t * topic_names_and_types)
+{
+  rcl_ret_t ret = _rcl_graph_cache_refresh_topics(cache, node, no_demangle);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  return _rcl_graph_cache_copy_names_and_types(&cache->topics, allocator, topic_names_and_types);
+}
+
+const rcl_names_and_types_t *
+rcl_graph_cache_peek_topic_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  bool no_demangle)
+{
+  if (RCL_RET_OK != _rcl_graph_cache_refresh_topics(cache, node, no_demangle)) {
+    return NULL;  // error already set
+  }
+  return &cache->topics;
+}
+
+rcl_ret_t
+rcl_graph_cache_get_service_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * service_names_and_types)
+{
+  if (cache->services_generation != cache->generation) {
+    if (0 != cache->services_generation) {
+      rmw_ret_t rmw_ret = rmw_names_and_types_fini(&cache->services);
+      cache->services_generation = 0;
+      if (RMW_RET_OK != rmw_ret) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+      }
+    }
+    cache->services = rmw_get_zero_initialized_names_and_types();
+    rcutils_allocator_t rcutils_allocator = cache->allocator;
+    rmw_ret_t rmw_ret = rmw_get_service_names_and_types(
+      rcl_node_get_rmw_handle(node), &rcutils_allocator, &cache->services);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    cache->services_generation = cache->generation;
+  }
+  return _rcl_graph_cache_copy_names_and_types(
+    &cache->services, allocator, service_names_and_types);
+}
+
+rcl_ret_t
+rcl_graph_cache_get_node_names(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t allocator,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces)
+{
+  if (cache->nodes_generation != cache->generation) {
+    if (0 != cache->nodes_generation) {
+      rcutils_ret_t rcutils_ret = rcutils_string_array_fini(&cache->node_names);
+      if (RCUTILS_RET_OK == rcutils_ret) {
+        rcutils_ret = rcutils_string_array_fini(&cache->node_namespaces);
+      }
+      cache->nodes_generation = 0;
+      if (RCUTILS_RET_OK != rcutils_ret) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        return RCL_RET_ERROR;
+      }
+    }
+    cache->node_names = rcutils_get_zero_initialized_string_array();
+    cache->node_namespaces = rcutils_get_zero_initialized_string_array();
+    rmw_ret_t rmw_ret = rmw_get_node_names(
+      rcl_node_get_rmw_handle(node), &cache->node_names, &cache->node_namespaces);
+    if (RMW_RET_OK != rmw_ret) {
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    cache->nodes_generation = cache->generation;
+  }
+  rcl_ret_t ret = _rcl_graph_cache_copy_string_array(&cache->node_names, allocator, node_names);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  ret = _rcl_graph_cache_copy_string_array(&cache->node_namespaces, allocator, node_namespaces);
+  if (RCL_RET_OK != ret) {
+    if (RCUTILS_RET_OK != rcutils_string_array_fini(node_names)) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini string array after error occurred");
+    }
+    return ret;
+  }
+  return RCL_RET_OK;
+}
+
+/// Check whether `reference` has an entry with the same name and type set.
+static bool
+_rcl_graph_cache_entry_unchanged(
+  const rcl_names_and_types_t * entries,
+  size_t i,
+  const rcl_names_and_types_t * reference)
+{
+  for (size_t r = 0; r < reference->names.size; ++r) {
+    if (0 != strcmp(entries->names.data[i], reference->names.data[r])) {
+      continue;
+    }
+    if (entries->types[i].size != reference->types[r].size) {
+      return false;
+    }
+    for (size_t j = 0; j < entries->types[i].size; ++j) {
+      if (0 != strcmp(entries->types[i].data[j], reference->types[r].data[j])) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+/// Copy the entries of `from` that are absent or different in `reference`.
+static rcl_ret_t
+_rcl_graph_cache_copy_changed(
+  const rcl_names_and_types_t * from,
+  const rcl_names_and_types_t * reference,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * output)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < from->names.size; ++i) {
+    if (!_rcl_graph_cache_entry_unchanged(from, i, reference)) {
+      ++count;
+    }
+  }
+  rcutils_allocator_t rcutils_allocator = *allocator;
+  rmw_ret_t rmw_ret = rmw_names_and_types_init(output, count, &rcutils_allocator);
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  size_t out_i = 0;
+  for (size_t i = 0; i < from->names.size; ++i) {
+    if (_rcl_graph_cache_entry_unchanged(from, i, reference)) {
+      continue;
+    }
+    if (RCL_RET_OK != _rcl_graph_cache_copy_entry(from, i, *allocator, output, out_i++)) {
+      if (RMW_RET_OK != rmw_names_and_types_fini(output)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini names and types after error occurred");
+      }
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_get_graph_changes(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  uint64_t since_token,
+  rcl_names_and_types_t * additions,
+  rcl_names_and_types_t * removals,
+  uint64_t * new_token)
+{
+  rcl_ret_t ret = _rcl_graph_cache_refresh_topics(cache, node, false);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  // With an unknown token everything is reported as added, i.e. the empty
+  // baseline is diffed against; this covers the first call (token 0) and a
+  // token issued to a different consumer or cache.
+  const rcl_names_and_types_t empty_baseline = rmw_get_zero_initialized_names_and_types();
+  const rcl_names_and_types_t * baseline = &empty_baseline;
+  if (0 != since_token && since_token == cache->delta_token) {
+    baseline = &cache->delta_baseline;
+  }
+  ret = _rcl_graph_cache_copy_changed(&cache->topics, baseline, allocator, additions);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  ret = _rcl_graph_cache_copy_changed(baseline, &cache->topics, allocator, removals);
+  if (RCL_RET_OK != ret) {
+    goto fail_removals;
+  }
+  // The current snapshot becomes the baseline for the next delta query.
+  if (0 != cache->delta_token && cache->delta_token != cache->topics_generation) {
+    rmw_ret_t rmw_ret = rmw_names_and_types_fini(&cache->delta_baseline);
+    cache->delta_token = 0;
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+      goto fail;
+    }
+  }
+  if (0 == cache->delta_token) {
+    cache->delta_baseline = rmw_get_zero_initialized_names_and_types();
+    rcl_allocator_t cache_allocator = cache->allocator;
+    ret = _rcl_graph_cache_copy_names_and_types(
+      &cache->topics, &cache_allocator, &cache->delta_baseline);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+    cache->delta_token = cache->topics_generation;
+  }
+  *new_token = cache->delta_token;
+  return RCL_RET_OK;
+fail:
+  if (RMW_RET_OK != rmw_names_and_types_fini(removals)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to fini names and types after error occurred");
+  }
+fail_removals:
+  if (RMW_RET_OK != rmw_names_and_types_fini(additions)) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to fini names and types after error occurred");
+  }
+  return ret;
+}
+
+/// Find the count entry for a topic and direction, creating it if asked to.
+static rcl_graph_count_entry_t *
+_rcl_graph_cache_count_entry_get(
+  rcl_graph_cache_t * cache,
+  const char * topic_name,
+  bool count_subscribers,
+  bool create)
+{
+  rcl_graph_count_entry_t * entry = cache->count_entries;
+  while (NULL != entry) {
+    if (entry->count_subscribers == count_subscribers &&
+      0 == strcmp(entry->topic_name, topic_name))
+    {
+      return entry;
+    }
+    entry = entry->next;
+  }
+  if (!create) {
+    return NULL;
+  }
+  entry = (rcl_graph_count_entry_t *)cache->allocator.zero_allocate(
+    1, sizeof(rcl_graph_count_entry_t), cache->allocator.state);
+  if (NULL == entry) {
+    return NULL;
+  }
+  entry->topic_name = rcutils_strdup(topic_name, cache->allocator);
+  if (NULL == entry->topic_name) {
+    cache->allocator.deallocate(entry, cache->allocator.state);
+    return NULL;
+  }
+  entry->count_subscribers = count_subscribers;
+  entry->next = cache->count_entries;
+  cache->count_entries = entry;
+  return entry;
+}
+
+/// Count through rmw if the entry is stale, firing the callback on a zero crossing.
+static rcl_ret_t
+_rcl_graph_cache_count_entry_refresh(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_graph_count_entry_t * entry)
+{
+  if (entry->count_generation == cache->generation) {
+    return RCL_RET_OK;
+  }
+  size_t count = 0;
+  rmw_ret_t rmw_ret;
+  if (entry->count_subscribers) {
+    rmw_ret = rmw_count_subscribers(rcl_node_get_rmw_handle(node), entry->topic_name, &count);
+  } else {
+    rmw_ret = rmw_count_publishers(rcl_node_get_rmw_handle(node), entry->topic_name, &count);
+  }
+  if (RMW_RET_OK != rmw_ret) {
+    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  }
+  // Only a transition between counted states is a crossing; the first count
+  // of an entry (generation 0) just primes it.
+  bool crossed_zero = 0 != entry->count_generation && (0 == entry->count) != (0 == count);
+  entry->count = count;
+  entry->count_generation = cache->generation;
+  if (crossed_zero && NULL != entry->callback) {
+    entry->callback(entry->topic_name, count, entry->callback_user_data);
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_count_entities(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const char * topic_name,
+  bool count_subscribers,
+  size_t * count)
+{
+  rcl_graph_count_entry_t * entry =
+    _rcl_graph_cache_count_entry_get(cache, topic_name, count_subscribers, true);
+  RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  rcl_ret_t ret = _rcl_graph_cache_count_entry_refresh(cache, node, entry);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  *count = entry->count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_set_count_callback(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const char * topic_name,
+  bool count_subscribers,
+  rcl_count_change_callback_t callback,
+  void * user_data)
+{
+  rcl_graph_count_entry_t * entry =
+    _rcl_graph_cache_count_entry_get(cache, topic_name, count_subscribers, NULL != callback);
+  if (NULL == callback) {
+    if (NULL != entry) {
+      entry->callback = NULL;
+      entry->callback_user_data = NULL;
+    }
+    return RCL_RET_OK;
+  }
+  RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->callback = callback;
+  entry->callback_user_data = user_data;
+  // Prime the count now so the first reported change is a real crossing.
+  return _rcl_graph_cache_count_entry_refresh(cache, node, entry);
+}
+
+rcl_ret_t
+rcl_graph_cache_set_service_watch(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  rcl_guard_condition_t * guard_condition)
+{
+  // find the client's pending watch, remembering where it is linked in
+  rcl_graph_service_watch_t ** link = &cache->service_watches;
+  while (NULL != *link && (*link)->client != client) {
+    link = &(*link)->next;
+  }
+  if (NULL == guard_condition) {
+    // cancel the pending notification, if any
+    if (NULL != *link) {
+      rcl_graph_service_watch_t * watch = *link;
+      *link = watch->next;
+      cache->allocator.deallocate(watch, cache->allocator.state);
+    }
+    return RCL_RET_OK;
+  }
+  // Check availability up front: a server that is already up would otherwise
+  // never fire, as no further graph change needs to happen.
+  bool is_available = false;
+  rcl_ret_t ret = rcl_service_server_is_available(node, client, &is_available);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  if (is_available) {
+    return rcl_trigger_guard_condition(guard_condition);
+  }
+  if (NULL != *link) {
+    (*link)->guard_condition = guard_condition;
+    return RCL_RET_OK;
+  }
+  rcl_graph_service_watch_t * watch = (rcl_graph_service_watch_t *)cache->allocator.zero_allocate(
+    1, sizeof(rcl_graph_service_watch_t), cache->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(watch, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  watch->client = client;
+  watch->guard_condition = guard_condition;
+  watch->next = cache->service_watches;
+  cache->service_watches = watch;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_cache_refresh_service_watches(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node)
+{
+  rcl_ret_t result = RCL_RET_OK;
+  rcl_graph_service_watch_t ** link = &cache->service_watches;
+  while (NULL != *link) {
+    rcl_graph_service_watch_t * watch = *link;
+    bool is_available = false;
+    rcl_ret_t ret = rcl_service_server_is_available(node, watch->client, &is_available);
+    if (RCL_RET_OK == ret && is_available) {
+      ret = rcl_trigger_guard_condition(watch->guard_condition);
+      // the watch is one-shot; remove it whether or not the trigger worked
+      *link = watch->next;
+      cache->allocator.deallocate(watch, cache->allocator.state);
+    } else {
+      link = &watch->next;
+    }
+    if (RCL_RET_OK != ret) {
+      // keep checking the remaining watches; the last error is reported
+      result = ret;
+    }
+  }
+  return result;
+}
+
+rcl_ret_t
+rcl_graph_cache_refresh_count_watches(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node)
+{
+  rcl_ret_t result = RCL_RET_OK;
+  rcl_graph_count_entry_t * entry = cache->count_entries;
+  while (NULL != entry) {
+    if (NULL != entry->callback) {
+      rcl_ret_t ret = _rcl_graph_cache_count_entry_refresh(cache, node, entry);
+      if (RCL_RET_OK != ret) {
+        // keep refreshing the remaining watches; the last error is reported
+        result = ret;
+      }
+    }
+    entry = entry->next;
+  }
+  return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
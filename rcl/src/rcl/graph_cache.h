@@ -0,0 +1,211 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GRAPH_CACHE_H_
+#define RCL__GRAPH_CACHE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/graph.h"
+#include "rcl/guard_condition.h"
+#include "rcl/node.h"
+
+// Internal per-node cache of graph query snapshots.
+//
+// Callers which poll the graph query functions (introspection dashboards
+// typically do, at a fixed rate per node) trigger a full rmw graph snapshot
+// on every call.  The cache keeps the last snapshot per query and serves
+// repeat queries from it; a generation counter, bumped whenever the caller
+// reports a graph change, decides when a snapshot is stale and must be
+// refreshed through rmw.  With the counter driven from the node's graph
+// guard condition the rmw queries happen once per graph change instead of
+// once per poll.
+//
+// The cache is opt-in per node (see rcl_node_graph_cache_enable() in
+// graph.h) and not thread-safe, like the node's other caches.
+
+struct rcl_graph_cache_t;
+typedef struct rcl_graph_cache_t rcl_graph_cache_t;
+
+/// Allocate an empty cache, or return NULL on allocation failure.
+rcl_graph_cache_t *
+rcl_graph_cache_create(const rcl_allocator_t * allocator);
+
+/// Free a cache and the snapshots held by it; a NULL cache is ignored.
+void
+rcl_graph_cache_destroy(rcl_graph_cache_t * cache);
+
+/// Bump the generation, marking all snapshots stale.
+void
+rcl_graph_cache_mark_changed(rcl_graph_cache_t * cache);
+
+/// Get the current generation; it starts at 1 and only ever grows.
+uint64_t
+rcl_graph_cache_generation(const rcl_graph_cache_t * cache);
+
+/// Serve rcl_get_topic_names_and_types() from the cache.
+/**
+ * Refreshes the topic snapshot through rmw if it is stale, missing, or was
+ * captured with a different `no_demangle` setting, then copies it into
+ * `topic_names_and_types` with `allocator`.
+ */
+rcl_ret_t
+rcl_graph_cache_get_topic_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  bool no_demangle,
+  rcl_names_and_types_t * topic_names_and_types);
+
+/// Deep copy `count` entries of `input` starting at `begin` into `output`.
+/**
+ * The range is clamped to the input's size, so an out of range `begin`
+ * yields an empty result.  `output` must be zero initialized and is
+ * owned by the caller.
+ */
+rcl_ret_t
+rcl_graph_cache_copy_names_and_types_slice(
+  const rcl_names_and_types_t * input,
+  size_t begin,
+  size_t count,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * output);
+
+/// Borrow the current topic snapshot without copying it.
+/**
+ * Refreshes like rcl_graph_cache_get_topic_names_and_types() and returns a
+ * pointer to the internal snapshot, or NULL on error (error already set).
+ * The snapshot is only valid until the next call into the cache.
+ */
+const rcl_names_and_types_t *
+rcl_graph_cache_peek_topic_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  bool no_demangle);
+
+/// Serve rcl_get_service_names_and_types() from the cache.
+rcl_ret_t
+rcl_graph_cache_get_service_names_and_types(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  rcl_names_and_types_t * service_names_and_types);
+
+/// Serve rcl_get_graph_changes() from the cache.
+/**
+ * Diffs the current topic snapshot against the baseline identified by
+ * `since_token` and copies the entries that appeared into `additions` and
+ * those that disappeared into `removals` (an entry whose type set changed
+ * shows up in both).  The current snapshot then becomes the baseline for
+ * the token written to `new_token`.  An unknown token, including 0, diffs
+ * against an empty baseline, reporting the whole graph as additions.
+ */
+rcl_ret_t
+rcl_graph_cache_get_graph_changes(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t * allocator,
+  uint64_t since_token,
+  rcl_names_and_types_t * additions,
+  rcl_names_and_types_t * removals,
+  uint64_t * new_token);
+
+/// Serve rcl_get_node_names() from the cache.
+rcl_ret_t
+rcl_graph_cache_get_node_names(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  rcl_allocator_t allocator,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces);
+
+/// Serve rcl_count_publishers() or rcl_count_subscribers() from the cache.
+/**
+ * Counts through rmw only when the cached count for `topic_name` is older
+ * than the current generation; `count_subscribers` selects the direction.
+ */
+rcl_ret_t
+rcl_graph_cache_count_entities(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const char * topic_name,
+  bool count_subscribers,
+  size_t * count);
+
+/// Register (or with a NULL callback, clear) a count change callback.
+/**
+ * The callback fires from rcl_graph_cache_refresh_count_watches() when the
+ * topic's count crosses zero in either direction.  Registering counts the
+ * topic once to prime the crossing detection.
+ */
+rcl_ret_t
+rcl_graph_cache_set_count_callback(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const char * topic_name,
+  bool count_subscribers,
+  rcl_count_change_callback_t callback,
+  void * user_data);
+
+/// Register, replace, or with a NULL guard condition cancel a service watch.
+/**
+ * The watch is one-shot: rcl_graph_cache_refresh_service_watches() triggers
+ * the guard condition and drops the watch once the client's server is seen.
+ * A server that is already available triggers immediately without
+ * registering, so the caller cannot miss the appearance.
+ */
+rcl_ret_t
+rcl_graph_cache_set_service_watch(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node,
+  const rcl_client_t * client,
+  rcl_guard_condition_t * guard_condition);
+
+/// Check all service watches, triggering and dropping the ones now available.
+/**
+ * On error the remaining watches are still checked and the last error is
+ * returned.
+ */
+rcl_ret_t
+rcl_graph_cache_refresh_service_watches(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node);
+
+/// Re-count all watched topics, firing callbacks on zero crossings.
+/**
+ * Entries without a callback are left stale; they are re-counted on their
+ * next query instead.  On error the remaining watches are still refreshed
+ * and the last error is returned.
+ */
+rcl_ret_t
+rcl_graph_cache_refresh_count_watches(
+  rcl_graph_cache_t * cache,
+  const rcl_node_t * node);
+
+/// Get the graph cache of a node, or NULL if it is not enabled.
+/**
+ * Implemented in node.c, where the node impl struct lives; the graph query
+ * functions use this to divert to the cache when it is enabled.
+ */
+rcl_graph_cache_t *
+rcl_node_get_graph_cache(const rcl_node_t * node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GRAPH_CACHE_H_
@@ -0,0 +1,344 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/graph_event_filter.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/graph.h"
+#include "rcutils/time.h"
+#include "rcutils/types/string_array.h"
+#include "rmw/names_and_types.h"
+
+typedef struct rcl_graph_event_filter_impl_t
+{
+  rcl_graph_event_filter_options_t options;
+  // Borrowed; the node must outlive the filter.
+  const rcl_node_t * node;
+  // The filtered guard condition watchers wait on, with trigger coalescing
+  // enabled so a burst of deliveries between drains wakes them only once.
+  rcl_guard_condition_t guard_condition;
+  // Signatures of the last seen graph, one per kind.  A signature is a
+  // commutative 64 bit hash of the query result, so it is independent of the
+  // order rmw happens to return entries in.  Colliding signatures would hide
+  // a change, but at 64 bits that is far less likely than losing the wake to
+  // a crashed process.
+  uint64_t topics_signature;
+  uint64_t services_signature;
+  uint64_t nodes_signature;
+  // Steady time of the last delivery; 0 before the first one.
+  rcutils_time_point_value_t last_delivery;
+  // Delivered kinds not yet drained with rcl_graph_event_filter_take_events().
+  uint32_t pending_events;
+} rcl_graph_event_filter_impl_t;
+
+/// FNV-1a hash of a string.
+static uint64_t
+__string_signature(const char * value)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (; *value; ++value) {
+    hash ^= (uint64_t)(unsigned char)*value;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/// Order independent signature of a names and types query result.
+static uint64_t
+__names_and_types_signature(const rcl_names_and_types_t * names_and_types)
+{
+  uint64_t signature = 0;
+  for (size_t i = 0; i < names_and_types->names.size; ++i) {
+    // Multiplying each type hash by the (odd) name hash binds the types to
+    // their name; summing keeps the whole both commutative and sensitive to
+    // a type set moving between names.
+    uint64_t name_hash = __string_signature(names_and_types->names.data[i]) | 1u;
+    uint64_t entry_hash = name_hash;
+    const rcutils_string_array_t * types = &names_and_types->types[i];
+    for (size_t j = 0; j < types->size; ++j) {
+      entry_hash += name_hash * __string_signature(types->data[j]);
+    }
+    signature += entry_hash;
+  }
+  return signature;
+}
+
+/// Order independent signature of the node name and namespace lists.
+static uint64_t
+__node_names_signature(
+  const rcutils_string_array_t * node_names,
+  const rcutils_string_array_t * node_namespaces)
+{
+  uint64_t signature = 0;
+  for (size_t i = 0; i < node_names->size; ++i) {
+    uint64_t name_hash = __string_signature(node_names->data[i]) | 1u;
+    signature += name_hash * __string_signature(node_namespaces->data[i]);
+  }
+  return signature;
+}
+
+/// Re-query the watched kinds, updating signatures and reporting changed bits.
+/**
+ * The queries go through the public graph functions, so they are served from
+ * the node's graph cache when it is enabled.
+ */
+static rcl_ret_t
+__refresh_signatures(rcl_graph_event_filter_impl_t * impl, uint32_t * changed)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  *changed = 0;
+  if (impl->options.event_mask & RCL_GRAPH_EVENT_TOPICS_CHANGED) {
+    rcl_names_and_types_t topics = rmw_get_zero_initialized_names_and_types();
+    rcl_ret_t ret = rcl_get_topic_names_and_types(impl->node, &allocator, false, &topics);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    uint64_t signature = __names_and_types_signature(&topics);
+    ret = rcl_names_and_types_fini(&topics);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    if (signature != impl->topics_signature) {
+      impl->topics_signature = signature;
+      *changed |= RCL_GRAPH_EVENT_TOPICS_CHANGED;
+    }
+  }
+  if (impl->options.event_mask & RCL_GRAPH_EVENT_SERVICES_CHANGED) {
+    rcl_names_and_types_t services = rmw_get_zero_initialized_names_and_types();
+    rcl_ret_t ret = rcl_get_service_names_and_types(impl->node, &allocator, &services);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    uint64_t signature = __names_and_types_signature(&services);
+    ret = rcl_names_and_types_fini(&services);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    if (signature != impl->services_signature) {
+      impl->services_signature = signature;
+      *changed |= RCL_GRAPH_EVENT_SERVICES_CHANGED;
+    }
+  }
+  if (impl->options.event_mask & RCL_GRAPH_EVENT_NODES_CHANGED) {
+    rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+    rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+    rcl_ret_t ret = rcl_get_node_names(impl->node, allocator, &node_names, &node_namespaces);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    uint64_t signature = __node_names_signature(&node_names, &node_namespaces);
+    rcutils_ret_t rcutils_ret = rcutils_string_array_fini(&node_names);
+    if (RCUTILS_RET_OK == rcutils_ret) {
+      rcutils_ret = rcutils_string_array_fini(&node_namespaces);
+    }
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (signature != impl->nodes_signature) {
+      impl->nodes_signature = signature;
+      *changed |= RCL_GRAPH_EVENT_NODES_CHANGED;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_graph_event_filter_t
+rcl_get_zero_initialized_graph_event_filter(void)
+{
+  static rcl_graph_event_filter_t null_filter = {
+    .impl = 0
+  };
+  return null_filter;
+}
+
+rcl_graph_event_filter_options_t
+rcl_graph_event_filter_get_default_options(void)
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  rcl_graph_event_filter_options_t default_options = {
+    .allocator = rcl_get_default_allocator(),
+    .min_interval = 0,
+    .event_mask = RCL_GRAPH_EVENT_ANY_CHANGED,
+  };
+  return default_options;
+}
+
+rcl_ret_t
+rcl_graph_event_filter_init(
+  rcl_graph_event_filter_t * filter,
+  const rcl_node_t * node,
+  const rcl_graph_event_filter_options_t options)
+{
+  const rcl_allocator_t * allocator = &options.allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(filter, RCL_RET_INVALID_ARGUMENT);
+  if (filter->impl) {
+    RCL_SET_ERROR_MSG("filter already initialized, or memory was unintialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  if (options.min_interval < 0) {
+    RCL_SET_ERROR_MSG("min_interval must not be negative");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (options.event_mask & ~(uint32_t)RCL_GRAPH_EVENT_ANY_CHANGED) {
+    RCL_SET_ERROR_MSG("event_mask contains unknown event bits");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_graph_event_filter_impl_t * impl = (rcl_graph_event_filter_impl_t *)allocator->allocate(
+    sizeof(rcl_graph_event_filter_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->options = options;
+  impl->node = node;
+  impl->guard_condition = rcl_get_zero_initialized_guard_condition();
+  impl->topics_signature = 0;
+  impl->services_signature = 0;
+  impl->nodes_signature = 0;
+  impl->last_delivery = 0;
+  impl->pending_events = 0;
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = options.allocator;
+  guard_condition_options.enable_trigger_coalescing = true;
+  rcl_ret_t ret = rcl_guard_condition_init(
+    &impl->guard_condition, node->context, guard_condition_options);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate(impl, allocator->state);
+    return ret;  // error already set
+  }
+  // Prime the change detection, so the first pump diffs against the graph as
+  // it is now rather than reporting everything as changed.
+  uint32_t ignored = 0;
+  ret = __refresh_signatures(impl, &ignored);
+  if (RCL_RET_OK != ret) {
+    rcl_error_string_t error_string = rcl_get_error_string();
+    rcl_reset_error();
+    rcl_ret_t fini_ret = rcl_guard_condition_fini(&impl->guard_condition);
+    if (RCL_RET_OK != fini_ret) {
+      rcl_reset_error();
+    }
+    allocator->deallocate(impl, allocator->state);
+    RCL_SET_ERROR_MSG(error_string.str);
+    return ret;
+  }
+  filter->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_event_filter_fini(rcl_graph_event_filter_t * filter)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(filter, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  if (filter->impl) {
+    // assuming the allocator is valid because it is checked in
+    // rcl_graph_event_filter_init()
+    rcl_allocator_t allocator = filter->impl->options.allocator;
+    result = rcl_guard_condition_fini(&filter->impl->guard_condition);
+    allocator.deallocate(filter->impl, allocator.state);
+    filter->impl = NULL;
+  }
+  return result;
+}
+
+const rcl_guard_condition_t *
+rcl_graph_event_filter_get_guard_condition(const rcl_graph_event_filter_t * filter)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(filter, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    filter->impl,
+    "graph event filter implementation is invalid",
+    return NULL);
+  return &filter->impl->guard_condition;
+}
+
+rcl_ret_t
+rcl_graph_event_filter_process(
+  rcl_graph_event_filter_t * filter,
+  uint32_t * events)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(filter, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    filter->impl,
+    "graph event filter implementation is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  rcl_graph_event_filter_impl_t * impl = filter->impl;
+  *events = 0;
+  if (!rcl_node_is_valid(impl->node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  rcutils_time_point_value_t now = 0;
+  if (impl->options.min_interval > 0) {
+    rcutils_ret_t rcutils_ret = rcutils_steady_time_now(&now);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    // Still inside the minimum interval: skip even the queries.  This is the
+    // path every discovery packet of a storm takes after the first delivery.
+    if (0 != impl->last_delivery && now - impl->last_delivery < impl->options.min_interval) {
+      return RCL_RET_OK;
+    }
+  }
+  uint32_t changed = 0;
+  rcl_ret_t ret = __refresh_signatures(impl, &changed);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (0 == changed) {
+    return RCL_RET_OK;
+  }
+  impl->pending_events |= changed;
+  impl->last_delivery = now;
+  ret = rcl_trigger_guard_condition(&impl->guard_condition);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  *events = changed;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_graph_event_filter_take_events(
+  rcl_graph_event_filter_t * filter,
+  uint32_t * events)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(filter, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    filter->impl,
+    "graph event filter implementation is invalid",
+    return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(events, RCL_RET_INVALID_ARGUMENT);
+  *events = filter->impl->pending_events;
+  filter->impl->pending_events = 0;
+  // Drain the coalesced trigger count too, so the next delivery crosses into
+  // rmw again and wakes the wait set.
+  size_t ignored = 0;
+  return rcl_guard_condition_take_pending_count(
+    &filter->impl->guard_condition, &ignored);
+}
+
+#ifdef __cplusplus
+}
+#endif
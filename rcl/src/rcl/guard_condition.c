@@ -21,17 +21,29 @@ extern "C"
 
 #include "rcl/error_handling.h"
 #include "rcl/rcl.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 
 #include "./context_impl.h"
+#include "./guard_condition_impl.h"
 
-typedef struct rcl_guard_condition_impl_t
+// Number of threads currently blocked (or about to block) in rmw_wait().
+// Triggering a local guard condition only needs to cross into rmw while a
+// waiter could miss the in-process flag, see rcl_trigger_guard_condition().
+static atomic_uint_least64_t __blocked_waiter_count = ATOMIC_VAR_INIT(0);
+
+void
+rcl_guard_condition_waiter_enter(void)
+{
+  (void)atomic_fetch_add(&__blocked_waiter_count, 1);
+}
+
+void
+rcl_guard_condition_waiter_exit(void)
 {
-  rmw_guard_condition_t * rmw_handle;
-  bool allocated_rmw_guard_condition;
-  rcl_guard_condition_options_t options;
-} rcl_guard_condition_impl_t;
+  (void)atomic_fetch_sub(&__blocked_waiter_count, 1);
+}
 
 rcl_guard_condition_t
 rcl_get_zero_initialized_guard_condition()
@@ -77,7 +89,23 @@ __rcl_guard_condition_init_from_rmw_impl(
     return RCL_RET_BAD_ALLOC;
   }
   // Create the rmw guard condition.
-  if (rmw_guard_condition) {
+  if (options.local) {
+    // Local guard conditions share one rmw guard condition per context,
+    // used only to interrupt a blocked rmw_wait(); readiness is carried by
+    // the in-process flag.  Create the shared handle on first use.
+    if (!context->impl->local_wakeup_guard_condition) {
+      context->impl->local_wakeup_guard_condition =
+        rmw_create_guard_condition(&(context->impl->rmw_context));
+      if (!context->impl->local_wakeup_guard_condition) {
+        allocator->deallocate(guard_condition->impl, allocator->state);
+        guard_condition->impl = NULL;
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        return RCL_RET_ERROR;
+      }
+    }
+    guard_condition->impl->rmw_handle = context->impl->local_wakeup_guard_condition;
+    guard_condition->impl->allocated_rmw_guard_condition = false;
+  } else if (rmw_guard_condition) {
     // If given, just assign (cast away const).
     guard_condition->impl->rmw_handle = (rmw_guard_condition_t *)rmw_guard_condition;
     guard_condition->impl->allocated_rmw_guard_condition = false;
@@ -93,6 +121,8 @@ __rcl_guard_condition_init_from_rmw_impl(
     guard_condition->impl->allocated_rmw_guard_condition = true;
   }
   // Copy options into impl.
+  atomic_init(&guard_condition->impl->pending_count, 0);
+  atomic_init(&guard_condition->impl->local_triggered, false);
   guard_condition->impl->options = options;
   return RCL_RET_OK;
 }
@@ -114,6 +144,10 @@ rcl_guard_condition_init_from_rmw(
   rcl_context_t * context,
   const rcl_guard_condition_options_t options)
 {
+  if (options.local) {
+    RCL_SET_ERROR_MSG("a local guard condition cannot wrap a given rmw guard condition");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
   return __rcl_guard_condition_init_from_rmw_impl(
     guard_condition, rmw_guard_condition, context, options);
 }
@@ -155,6 +189,25 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
   if (!options) {
     return RCL_RET_INVALID_ARGUMENT;  // error already set
   }
+  if (options->enable_trigger_coalescing) {
+    // Only the transition from no pending triggers to some pending triggers
+    // needs to cross into rmw; while the condition is already pending,
+    // triggering again just bumps the count.
+    if (0 != atomic_fetch_add(&guard_condition->impl->pending_count, 1)) {
+      return RCL_RET_OK;
+    }
+  }
+  if (options->local) {
+    // Hand the trigger to the waiter in-process: one atomic store, which a
+    // concurrent rcl_wait() picks up before blocking.  The shared rmw
+    // handle is only poked when a waiter may already be blocked in
+    // rmw_wait() and would otherwise miss the flag.
+    bool was_triggered = false;
+    rcutils_atomic_exchange(&guard_condition->impl->local_triggered, was_triggered, true);
+    if (was_triggered || 0 == rcutils_atomic_load_uint64_t(&__blocked_waiter_count)) {
+      return RCL_RET_OK;
+    }
+  }
   // Trigger the guard condition.
   if (rmw_trigger_guard_condition(guard_condition->impl->rmw_handle) != RMW_RET_OK) {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
@@ -163,6 +216,22 @@ rcl_trigger_guard_condition(rcl_guard_condition_t * guard_condition)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_guard_condition_take_pending_count(
+  const rcl_guard_condition_t * guard_condition,
+  size_t * count)
+{
+  const rcl_guard_condition_options_t * options = rcl_guard_condition_get_options(guard_condition);
+  if (!options) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(count, RCL_RET_INVALID_ARGUMENT);
+  uint64_t pending_count =
+    rcutils_atomic_exchange_uint64_t(&guard_condition->impl->pending_count, 0);
+  *count = (size_t)pending_count;
+  return RCL_RET_OK;
+}
+
 const rcl_guard_condition_options_t *
 rcl_guard_condition_get_options(const rcl_guard_condition_t * guard_condition)
 {
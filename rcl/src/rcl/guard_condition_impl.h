@@ -0,0 +1,58 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GUARD_CONDITION_IMPL_H_
+#define RCL__GUARD_CONDITION_IMPL_H_
+
+#include "rcl/guard_condition.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/rmw.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// \internal Shared with wait.c so local guard conditions can be checked
+/// without crossing into rmw.
+typedef struct rcl_guard_condition_impl_t
+{
+  rmw_guard_condition_t * rmw_handle;
+  bool allocated_rmw_guard_condition;
+  // Number of triggers not yet drained with
+  // rcl_guard_condition_take_pending_count(); only used when coalescing.
+  atomic_uint_least64_t pending_count;
+  // Set by rcl_trigger_guard_condition() and consumed by rcl_wait();
+  // only used when the guard condition is local.
+  atomic_bool local_triggered;
+  rcl_guard_condition_options_t options;
+} rcl_guard_condition_impl_t;
+
+/// \internal Mark one more thread as blocked (or about to block) in
+/// rmw_wait(), called by rcl_wait().  Triggering a local guard condition
+/// only crosses into rmw while at least one waiter is registered.
+RCL_LOCAL
+void
+rcl_guard_condition_waiter_enter(void);
+
+/// \internal Undo rcl_guard_condition_waiter_enter() after rmw_wait() returns.
+RCL_LOCAL
+void
+rcl_guard_condition_waiter_exit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GUARD_CONDITION_IMPL_H_
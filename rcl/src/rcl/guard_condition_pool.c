@@ -0,0 +1,148 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./guard_condition_pool.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/guard_condition.h"
+#include "rcutils/logging_macros.h"
+
+#include "./context_impl.h"
+
+// One pooled guard condition.  The guard condition is the first member so
+// the pointer handed to callers can be mapped back to its entry on release.
+typedef struct rcl_guard_condition_pool_entry_t
+{
+  rcl_guard_condition_t guard_condition;
+  struct rcl_guard_condition_pool_entry_t * next;
+} rcl_guard_condition_pool_entry_t;
+
+typedef struct rcl_guard_condition_pool_t
+{
+  /// Entries not currently handed out; acquired entries are only tracked by
+  /// their caller until released.
+  rcl_guard_condition_pool_entry_t * free_list;
+  rcl_allocator_t allocator;
+} rcl_guard_condition_pool_t;
+
+// Get the context's pool, creating it on first use; returns NULL and sets
+// an error message on failure.
+static rcl_guard_condition_pool_t *
+__get_guard_condition_pool(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(context->impl, "context is invalid", return NULL);
+  if (!context->impl->guard_condition_pool) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_guard_condition_pool_t * pool = (rcl_guard_condition_pool_t *)allocator.zero_allocate(
+      1, sizeof(rcl_guard_condition_pool_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(pool, "allocating memory failed", return NULL);
+    pool->allocator = allocator;
+    context->impl->guard_condition_pool = pool;
+  }
+  return context->impl->guard_condition_pool;
+}
+
+rcl_ret_t
+rcl_context_acquire_guard_condition(
+  rcl_context_t * context,
+  rcl_guard_condition_t ** guard_condition)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  rcl_guard_condition_pool_t * pool = __get_guard_condition_pool(context);
+  if (!pool) {
+    return RCL_RET_ERROR;  // error already set
+  }
+  rcl_guard_condition_pool_entry_t * entry = pool->free_list;
+  if (entry) {
+    // A recycled condition keeps its middleware handle; this path touches
+    // neither the allocator nor rmw.
+    pool->free_list = entry->next;
+    entry->next = NULL;
+    *guard_condition = &entry->guard_condition;
+    return RCL_RET_OK;
+  }
+  // Nothing pooled; construct a fresh entry.
+  entry = (rcl_guard_condition_pool_entry_t *)pool->allocator.zero_allocate(
+    1, sizeof(rcl_guard_condition_pool_entry_t), pool->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t options = rcl_guard_condition_get_default_options();
+  options.allocator = pool->allocator;
+  rcl_ret_t ret = rcl_guard_condition_init(&entry->guard_condition, context, options);
+  if (RCL_RET_OK != ret) {
+    pool->allocator.deallocate(entry, pool->allocator.state);
+    return ret;  // error already set
+  }
+  *guard_condition = &entry->guard_condition;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_context_release_guard_condition(
+  rcl_context_t * context,
+  rcl_guard_condition_t * guard_condition)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl->guard_condition_pool, "context has no guard condition pool",
+    return RCL_RET_INVALID_ARGUMENT);
+  rcl_guard_condition_pool_t * pool = context->impl->guard_condition_pool;
+  // The guard condition is the first member of its entry, see
+  // rcl_guard_condition_pool_entry_t.
+  rcl_guard_condition_pool_entry_t * entry =
+    (rcl_guard_condition_pool_entry_t *)guard_condition;
+  entry->next = pool->free_list;
+  pool->free_list = entry;
+  return RCL_RET_OK;
+}
+
+void
+rcl_guard_condition_pool_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->guard_condition_pool) {
+    return;
+  }
+  rcl_guard_condition_pool_t * pool = context->impl->guard_condition_pool;
+  rcl_guard_condition_pool_entry_t * entry = pool->free_list;
+  while (entry) {
+    rcl_guard_condition_pool_entry_t * next = entry->next;
+    rcl_ret_t ret = rcl_guard_condition_fini(&entry->guard_condition);
+    if (RCL_RET_OK != ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini pooled guard condition: %s",
+        rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+    pool->allocator.deallocate(entry, pool->allocator.state);
+    entry = next;
+  }
+  rcl_allocator_t allocator = pool->allocator;
+  allocator.deallocate(pool, allocator.state);
+  context->impl->guard_condition_pool = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__GUARD_CONDITION_POOL_H_
+#define RCL__GUARD_CONDITION_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+
+// Internal pool of initialized guard conditions, hung off the context.
+//
+// Bindings that create a guard condition per one-shot wakeup would otherwise
+// pay rcl_guard_condition_init's allocation plus rmw_create_guard_condition
+// and the matching destruction every time.  Released conditions keep their
+// middleware handle, so an acquire from a non-empty pool touches neither the
+// allocator nor the middleware.
+//
+// The public entry points are rcl_context_acquire_guard_condition() and
+// rcl_context_release_guard_condition(), declared in rcl/guard_condition.h.
+
+struct rcl_guard_condition_pool_t;
+
+/// Free the context's guard condition pool if it was created.
+void
+rcl_guard_condition_pool_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__GUARD_CONDITION_POOL_H_
@@ -22,9 +22,11 @@ extern "C"
 #include "./arguments_impl.h"
 #include "./common.h"
 #include "./context_impl.h"
+#include "./env_snapshot.h"
 #include "./init_options_impl.h"
 #include "rcl/arguments.h"
 #include "rcl/error_handling.h"
+#include "rcl/rmw_implementation_identifier_check.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
@@ -54,6 +56,13 @@ rcl_init(
   RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
 
+  // The verdict is computed once per process, so this is just an atomic load
+  // on anything but the first call.
+  rcl_ret_t ret = rcl_rmw_implementation_identifier_check();
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME,
     "Initializing ROS client library, for context at address: %p", context);
@@ -76,7 +85,15 @@ rcl_init(
     context->impl, "failed to allocate memory for context impl", return RCL_RET_BAD_ALLOC);
 
   // Copy the options into the context for future reference.
-  rcl_ret_t ret = rcl_init_options_copy(options, &(context->impl->init_options));
+  ret = rcl_init_options_copy(options, &(context->impl->init_options));
+  if (RCL_RET_OK != ret) {
+    fail_ret = ret;  // error message already set
+    goto fail;
+  }
+
+  // Snapshot the environment once; node creation reads the cached values
+  // instead of re-reading the environment per node.
+  ret = rcl_env_snapshot_capture(&(context->impl->env_snapshot), &allocator);
   if (RCL_RET_OK != ret) {
     fail_ret = ret;  // error message already set
     goto fail;
@@ -103,12 +120,26 @@ rcl_init(
     }
   }
 
-  // Parse the ROS specific arguments.
-  ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
-  if (RCL_RET_OK != ret) {
-    fail_ret = ret;
-    RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
-    goto fail;
+  // Parse the ROS specific arguments, unless the options carry a pre-parsed
+  // blob from a launcher, which is loaded instead of re-running the parser.
+  if (NULL != options->impl->serialized_arguments) {
+    ret = rcl_arguments_deserialize(
+      options->impl->serialized_arguments,
+      options->impl->serialized_arguments_length,
+      allocator,
+      &context->global_arguments);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to load serialized global arguments");
+      goto fail;
+    }
+  } else {
+    ret = rcl_parse_arguments(argc, argv, allocator, &context->global_arguments);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to parse global arguments");
+      goto fail;
+    }
   }
   // Update the default log level if specified in arguments.
   if (context->global_arguments.impl->log_level >= 0) {
@@ -125,12 +156,20 @@ rcl_init(
     goto fail;
   }
   rcutils_atomic_store((atomic_uint_least64_t *)(&context->instance_id_storage), next_instance_id);
-  context->impl->init_options.impl->rmw_init_options.instance_id = next_instance_id;
+  // Setting the instance id mutates the rmw options, so the payload shared
+  // with the caller's options must be unshared first.
+  rmw_init_options_t * rmw_init_options =
+    rcl_init_options_impl_unshare(context->impl->init_options.impl);
+  if (NULL == rmw_init_options) {
+    fail_ret = RCL_RET_ERROR;  // error already set
+    goto fail;
+  }
+  rmw_init_options->instance_id = next_instance_id;
 
   // Initialize rmw_init.
   context->impl->rmw_context = rmw_get_zero_initialized_context();
   rmw_ret_t rmw_ret = rmw_init(
-    &(context->impl->init_options.impl->rmw_init_options),
+    rmw_init_options,
     &(context->impl->rmw_context));
   if (RMW_RET_OK != rmw_ret) {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
@@ -19,6 +19,8 @@ extern "C"
 
 #include "rcl/init_options.h"
 
+#include <string.h>
+
 #include "./common.h"
 #include "./init_options_impl.h"
 #include "rcl/error_handling.h"
@@ -48,10 +50,26 @@ rcl_init_options_init(rcl_init_options_t * init_options, rcl_allocator_t allocat
     "failed to allocate memory for init options impl",
     return RCL_RET_BAD_ALLOC);
   init_options->impl->allocator = allocator;
-  init_options->impl->rmw_init_options = rmw_get_zero_initialized_init_options();
-  rmw_ret_t rmw_ret = rmw_init_options_init(&(init_options->impl->rmw_init_options), allocator);
+  init_options->impl->share_participant = false;
+  init_options->impl->serialized_arguments = NULL;
+  init_options->impl->serialized_arguments_length = 0;
+  init_options->impl->payload = allocator.allocate(
+    sizeof(rcl_init_options_payload_t), allocator.state);
+  if (NULL == init_options->impl->payload) {
+    allocator.deallocate(init_options->impl, allocator.state);
+    init_options->impl = NULL;
+    RCL_SET_ERROR_MSG("failed to allocate memory for init options payload");
+    return RCL_RET_BAD_ALLOC;
+  }
+  init_options->impl->payload->allocator = allocator;
+  atomic_init(&(init_options->impl->payload->reference_count), 1u);
+  init_options->impl->payload->rmw_init_options = rmw_get_zero_initialized_init_options();
+  rmw_ret_t rmw_ret = rmw_init_options_init(
+    &(init_options->impl->payload->rmw_init_options), allocator);
   if (RMW_RET_OK != rmw_ret) {
+    allocator.deallocate(init_options->impl->payload, allocator.state);
     allocator.deallocate(init_options->impl, allocator.state);
+    init_options->impl = NULL;
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
     return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
   }
@@ -69,49 +87,35 @@ rcl_init_options_copy(const rcl_init_options_t * src, rcl_init_options_t * dst)
     return RCL_RET_ALREADY_INIT;
   }
 
-  // initialize dst (since we know it's in a zero initialized state)
-  rcl_ret_t ret = rcl_init_options_init(dst, src->impl->allocator);
-  if (RCL_RET_OK != ret) {
-    return ret;  // error already set
-  }
-
-  // copy src information into dst
-  dst->impl->allocator = src->impl->allocator;
-  // first zero-initialize rmw init options
-  rmw_ret_t rmw_ret = rmw_init_options_fini(&(dst->impl->rmw_init_options));
-  if (RMW_RET_OK != rmw_ret) {
-    rmw_error_string_t error_string = rmw_get_error_string();
-    rmw_reset_error();
-    ret = rcl_init_options_fini(dst);
-    if (RCL_RET_OK != ret) {
-      RCUTILS_LOG_ERROR_NAMED(
-        "rcl",
-        "failed to finalize dst rcl_init_options while handling failure to "
-        "finalize rmw_init_options, original ret '%d' and error: %s", rmw_ret, error_string.str);
-      return ret;  // error already set
-    }
-    RCL_SET_ERROR_MSG(error_string.str);
-    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
-  }
-  // then copy
-  dst->impl->rmw_init_options = rmw_get_zero_initialized_init_options();
-  rmw_ret =
-    rmw_init_options_copy(&(src->impl->rmw_init_options), &(dst->impl->rmw_init_options));
-  if (RMW_RET_OK != rmw_ret) {
-    rmw_error_string_t error_string = rmw_get_error_string();
-    rmw_reset_error();
-    ret = rcl_init_options_fini(dst);
-    if (RCL_RET_OK != ret) {
-      RCUTILS_LOG_ERROR_NAMED(
-        "rcl",
-        "failed to finalize dst rcl_init_options while handling failure to "
-        "copy rmw_init_options, original ret '%d' and error: %s", rmw_ret, error_string.str);
-      return ret;  // error already set
+  // The rmw options payload is only duplicated when a copy is about to be
+  // mutated, so a copy is just another reference to the same payload.
+  rcl_allocator_t allocator = src->impl->allocator;
+  dst->impl = allocator.allocate(sizeof(rcl_init_options_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    dst->impl,
+    "failed to allocate memory for init options impl",
+    return RCL_RET_BAD_ALLOC);
+  dst->impl->allocator = allocator;
+  dst->impl->share_participant = src->impl->share_participant;
+  dst->impl->serialized_arguments = NULL;
+  dst->impl->serialized_arguments_length = 0;
+  if (NULL != src->impl->serialized_arguments) {
+    dst->impl->serialized_arguments = allocator.allocate(
+      src->impl->serialized_arguments_length, allocator.state);
+    if (NULL == dst->impl->serialized_arguments) {
+      allocator.deallocate(dst->impl, allocator.state);
+      dst->impl = NULL;
+      RCL_SET_ERROR_MSG("failed to allocate memory for serialized arguments");
+      return RCL_RET_BAD_ALLOC;
     }
-    RCL_SET_ERROR_MSG(error_string.str);
-    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    memcpy(
+      dst->impl->serialized_arguments, src->impl->serialized_arguments,
+      src->impl->serialized_arguments_length);
+    dst->impl->serialized_arguments_length = src->impl->serialized_arguments_length;
   }
-
+  dst->impl->payload = src->impl->payload;
+  atomic_fetch_add_explicit(
+    &(dst->impl->payload->reference_count), 1u, memory_order_relaxed);
   return RCL_RET_OK;
 }
 
@@ -122,12 +126,25 @@ rcl_init_options_fini(rcl_init_options_t * init_options)
   RCL_CHECK_ARGUMENT_FOR_NULL(init_options->impl, RCL_RET_INVALID_ARGUMENT);
   rcl_allocator_t allocator = init_options->impl->allocator;
   RCL_CHECK_ALLOCATOR(&allocator, return RCL_RET_INVALID_ARGUMENT);
-  rmw_ret_t rmw_ret = rmw_init_options_fini(&(init_options->impl->rmw_init_options));
-  if (RMW_RET_OK != rmw_ret) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+  // Release one reference on the payload; it stays alive while other copies
+  // still share it.
+  // acq_rel orders the release of the last reference after all prior use.
+  rcl_init_options_payload_t * payload = init_options->impl->payload;
+  if (1u == atomic_fetch_sub_explicit(
+      &payload->reference_count, 1u, memory_order_acq_rel))
+  {
+    rmw_ret_t rmw_ret = rmw_init_options_fini(&(payload->rmw_init_options));
+    if (RMW_RET_OK != rmw_ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return rcl_convert_rmw_ret_to_rcl_ret(rmw_ret);
+    }
+    payload->allocator.deallocate(payload, payload->allocator.state);
+  }
+  if (NULL != init_options->impl->serialized_arguments) {
+    allocator.deallocate(init_options->impl->serialized_arguments, allocator.state);
   }
   allocator.deallocate(init_options->impl, allocator.state);
+  init_options->impl = NULL;
   return RCL_RET_OK;
 }
 
@@ -136,7 +153,101 @@ rcl_init_options_get_rmw_init_options(rcl_init_options_t * init_options)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(init_options, NULL);
   RCL_CHECK_ARGUMENT_FOR_NULL(init_options->impl, NULL);
-  return &(init_options->impl->rmw_init_options);
+  // The returned pointer is mutable, so the payload must be privately owned.
+  return rcl_init_options_impl_unshare(init_options->impl);
+}
+
+rmw_init_options_t *
+rcl_init_options_impl_unshare(rcl_init_options_impl_t * impl)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(impl, NULL);
+  rcl_init_options_payload_t * payload = impl->payload;
+  if (1u == atomic_load_explicit(&payload->reference_count, memory_order_acquire)) {
+    // Sole owner; no other copy can gain a reference concurrently because
+    // copying requires an owning rcl_init_options_t.
+    return &payload->rmw_init_options;
+  }
+  rcl_allocator_t allocator = impl->allocator;
+  rcl_init_options_payload_t * fresh = allocator.allocate(
+    sizeof(rcl_init_options_payload_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    fresh, "failed to allocate memory for init options payload", return NULL);
+  fresh->allocator = allocator;
+  atomic_init(&fresh->reference_count, 1u);
+  fresh->rmw_init_options = rmw_get_zero_initialized_init_options();
+  rmw_ret_t rmw_ret = rmw_init_options_copy(
+    &(payload->rmw_init_options), &(fresh->rmw_init_options));
+  if (RMW_RET_OK != rmw_ret) {
+    allocator.deallocate(fresh, allocator.state);
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return NULL;
+  }
+  // Drop the reference on the shared payload; another owner may have
+  // released theirs meanwhile, leaving this one as the last.
+  if (1u == atomic_fetch_sub_explicit(
+      &payload->reference_count, 1u, memory_order_acq_rel))
+  {
+    if (RMW_RET_OK != rmw_init_options_fini(&(payload->rmw_init_options))) {
+      RCUTILS_LOG_ERROR_NAMED(
+        "rcl", "failed to finalize unshared rmw init options: %s",
+        rmw_get_error_string().str);
+      rmw_reset_error();
+    }
+    payload->allocator.deallocate(payload, payload->allocator.state);
+  }
+  impl->payload = fresh;
+  return &fresh->rmw_init_options;
+}
+
+rcl_ret_t
+rcl_init_options_set_share_participant(
+  rcl_init_options_t * init_options,
+  bool share_participant)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options->impl, RCL_RET_INVALID_ARGUMENT);
+  init_options->impl->share_participant = share_participant;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_init_options_get_share_participant(
+  const rcl_init_options_t * init_options,
+  bool * share_participant)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options->impl, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(share_participant, RCL_RET_INVALID_ARGUMENT);
+  *share_participant = init_options->impl->share_participant;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_init_options_set_serialized_arguments(
+  rcl_init_options_t * init_options,
+  const uint8_t * buffer,
+  size_t buffer_length)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(init_options->impl, RCL_RET_INVALID_ARGUMENT);
+  if (NULL == buffer && 0u != buffer_length) {
+    RCL_SET_ERROR_MSG("buffer is NULL, but buffer_length is not 0");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_allocator_t allocator = init_options->impl->allocator;
+  uint8_t * copy = NULL;
+  if (NULL != buffer) {
+    copy = allocator.allocate(buffer_length, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      copy, "failed to allocate memory for serialized arguments", return RCL_RET_BAD_ALLOC);
+    memcpy(copy, buffer, buffer_length);
+  }
+  if (NULL != init_options->impl->serialized_arguments) {
+    allocator.deallocate(init_options->impl->serialized_arguments, allocator.state);
+  }
+  init_options->impl->serialized_arguments = copy;
+  init_options->impl->serialized_arguments_length = (NULL != copy) ? buffer_length : 0u;
+  return RCL_RET_OK;
 }
 
 #ifdef __cplusplus
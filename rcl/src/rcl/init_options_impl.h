@@ -15,6 +15,8 @@
 #ifndef RCL__INIT_OPTIONS_IMPL_H_
 #define RCL__INIT_OPTIONS_IMPL_H_
 
+#include <stdatomic.h>
+
 #include "rcl/init_options.h"
 
 #include "rmw/init.h"
@@ -24,13 +26,48 @@ extern "C"
 {
 #endif
 
+/// \internal
+/// Reference counted rmw init options payload.
+/**
+ * The rmw options block is deep-copied by rmw_init_options_copy(), including
+ * any strings owned by the middleware, so rcl_init_options_copy() shares one
+ * payload between copies instead and only duplicates it when a copy is about
+ * to be mutated, see rcl_init_options_impl_unshare().
+ */
+typedef struct rcl_init_options_payload_t
+{
+  rmw_init_options_t rmw_init_options;
+  atomic_uint_least64_t reference_count;
+  rcl_allocator_t allocator;
+} rcl_init_options_payload_t;
+
 /// \internal
 typedef struct rcl_init_options_impl_t
 {
   rcl_allocator_t allocator;
-  rmw_init_options_t rmw_init_options;
+  /// Shared rmw options payload; never mutate it without unsharing first.
+  rcl_init_options_payload_t * payload;
+  /// When true all nodes in the context share one middleware participant.
+  bool share_participant;
+  /// Pre-parsed arguments blob loaded instead of parsing argv, or `NULL`.
+  /**
+   * \sa rcl_init_options_set_serialized_arguments()
+   */
+  uint8_t * serialized_arguments;
+  /// Length of serialized_arguments in bytes.
+  size_t serialized_arguments_length;
 } rcl_init_options_impl_t;
 
+/// \internal
+/// Make the impl's payload privately owned, copying it if it is shared.
+/**
+ * Returns a pointer to the now mutable rmw init options, or `NULL` with an
+ * error set if copying the shared payload failed.
+ */
+RCL_LOCAL
+rmw_init_options_t *
+rcl_init_options_impl_unshare(rcl_init_options_impl_t * impl);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,265 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./intra_process.h"
+
+#include <string.h>
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
+
+#include "./context_impl.h"
+#include "./string_pool.h"
+
+typedef struct rcl_intra_process_sub_t
+{
+  const void * owner;
+  // Single-producer single-consumer pointer ring; indices grow without
+  // bound and are reduced modulo capacity on access.
+  const void ** ring;
+  size_t capacity;
+  atomic_uint_least64_t write_index;
+  atomic_uint_least64_t read_index;
+  // Borrowed from the subscription, triggered when a pointer is pushed.
+  rcl_guard_condition_t * guard_condition;
+  struct rcl_intra_process_sub_t * next;
+} rcl_intra_process_sub_t;
+
+typedef struct rcl_intra_process_registry_t
+{
+  rcl_intra_process_topic_t * topics;
+  rcl_allocator_t allocator;
+} rcl_intra_process_registry_t;
+
+/// Get the context's registry, creating it on first use.
+static rcl_intra_process_registry_t *
+__intra_process_registry_get(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(context->impl, "context is invalid", return NULL);
+  if (!context->impl->intra_process_registry) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_intra_process_registry_t * registry =
+      (rcl_intra_process_registry_t *)allocator.zero_allocate(
+      1, sizeof(rcl_intra_process_registry_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(registry, "allocating memory failed", return NULL);
+    registry->allocator = allocator;
+    context->impl->intra_process_registry = registry;
+  }
+  return context->impl->intra_process_registry;
+}
+
+/// Find or create the node for a topic name.
+static rcl_intra_process_topic_t *
+__intra_process_topic_get(
+  rcl_context_t * context,
+  rcl_intra_process_registry_t * registry,
+  const char * topic_name)
+{
+  // Interning gives the stored name and makes the search a pointer compare.
+  const char * interned_name = rcl_context_intern_string(context, topic_name);
+  if (!interned_name) {
+    return NULL;  // error already set
+  }
+  rcl_intra_process_topic_t * topic = registry->topics;
+  for (; topic; topic = topic->next) {
+    if (topic->name == interned_name) {
+      return topic;
+    }
+  }
+  topic = (rcl_intra_process_topic_t *)registry->allocator.zero_allocate(
+    1, sizeof(rcl_intra_process_topic_t), registry->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(topic, "allocating memory failed", return NULL);
+  topic->name = interned_name;
+  topic->next = registry->topics;
+  registry->topics = topic;
+  return topic;
+}
+
+rcl_ret_t
+rcl_intra_process_register_publisher(
+  rcl_context_t * context,
+  const char * topic_name,
+  rcl_intra_process_topic_t ** topic_entry)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_entry, RCL_RET_INVALID_ARGUMENT);
+  rcl_intra_process_registry_t * registry = __intra_process_registry_get(context);
+  if (!registry) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_intra_process_topic_t * topic = __intra_process_topic_get(context, registry, topic_name);
+  if (!topic) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  *topic_entry = topic;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_process_register_subscription(
+  rcl_context_t * context,
+  const char * topic_name,
+  const void * owner,
+  size_t buffer_capacity,
+  rcl_guard_condition_t * guard_condition,
+  rcl_intra_process_sub_t ** sub_entry)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(owner, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(sub_entry, RCL_RET_INVALID_ARGUMENT);
+  if (0 == buffer_capacity) {
+    RCL_SET_ERROR_MSG("intra-process buffer capacity must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_intra_process_registry_t * registry = __intra_process_registry_get(context);
+  if (!registry) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_intra_process_topic_t * topic = __intra_process_topic_get(context, registry, topic_name);
+  if (!topic) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_intra_process_sub_t * sub = (rcl_intra_process_sub_t *)registry->allocator.zero_allocate(
+    1, sizeof(rcl_intra_process_sub_t), registry->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(sub, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  sub->ring = (const void **)registry->allocator.zero_allocate(
+    buffer_capacity, sizeof(const void *), registry->allocator.state);
+  if (!sub->ring) {
+    registry->allocator.deallocate(sub, registry->allocator.state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  sub->owner = owner;
+  sub->capacity = buffer_capacity;
+  atomic_init(&sub->write_index, 0);
+  atomic_init(&sub->read_index, 0);
+  sub->guard_condition = guard_condition;
+  sub->next = topic->subs;
+  topic->subs = sub;
+  *sub_entry = sub;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_process_unregister_subscription(
+  rcl_context_t * context,
+  const void * owner)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(owner, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is invalid", return RCL_RET_INVALID_ARGUMENT);
+  rcl_intra_process_registry_t * registry = context->impl->intra_process_registry;
+  if (!registry) {
+    return RCL_RET_OK;
+  }
+  for (rcl_intra_process_topic_t * topic = registry->topics; topic; topic = topic->next) {
+    rcl_intra_process_sub_t ** link = &topic->subs;
+    while (*link) {
+      if ((*link)->owner == owner) {
+        rcl_intra_process_sub_t * sub = *link;
+        *link = sub->next;
+        registry->allocator.deallocate(sub->ring, registry->allocator.state);
+        registry->allocator.deallocate(sub, registry->allocator.state);
+        return RCL_RET_OK;
+      }
+      link = &(*link)->next;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_process_publish(
+  rcl_intra_process_topic_t * topic_entry,
+  const void * ros_message)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_entry, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  for (rcl_intra_process_sub_t * sub = topic_entry->subs; sub; sub = sub->next) {
+    uint64_t write_index = rcutils_atomic_load_uint64_t(&sub->write_index);
+    uint64_t read_index = rcutils_atomic_load_uint64_t(&sub->read_index);
+    if (write_index - read_index >= sub->capacity) {
+      // Ring is full; this subscription misses the message rather than
+      // blocking the publisher or overwriting unread pointers.
+      RCUTILS_LOG_DEBUG_NAMED(
+        ROS_PACKAGE_NAME, "Intra-process buffer full on '%s', message dropped",
+        topic_entry->name);
+      continue;
+    }
+    sub->ring[write_index % sub->capacity] = ros_message;
+    // The store above must be visible before the new write index.
+    rcutils_atomic_store(&sub->write_index, write_index + 1);
+    rcl_ret_t ret = rcl_trigger_guard_condition(sub->guard_condition);
+    if (RCL_RET_OK != ret) {
+      return ret;  // The rcl error state should already be set.
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_intra_process_take(
+  rcl_intra_process_sub_t * sub_entry,
+  const void ** ros_message)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(sub_entry, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  uint64_t read_index = rcutils_atomic_load_uint64_t(&sub_entry->read_index);
+  uint64_t write_index = rcutils_atomic_load_uint64_t(&sub_entry->write_index);
+  if (read_index == write_index) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  *ros_message = sub_entry->ring[read_index % sub_entry->capacity];
+  rcutils_atomic_store(&sub_entry->read_index, read_index + 1);
+  return RCL_RET_OK;
+}
+
+void
+rcl_intra_process_registry_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->intra_process_registry) {
+    return;
+  }
+  rcl_intra_process_registry_t * registry = context->impl->intra_process_registry;
+  rcl_allocator_t allocator = registry->allocator;
+  rcl_intra_process_topic_t * topic = registry->topics;
+  while (topic) {
+    rcl_intra_process_topic_t * next_topic = topic->next;
+    rcl_intra_process_sub_t * sub = topic->subs;
+    while (sub) {
+      rcl_intra_process_sub_t * next_sub = sub->next;
+      allocator.deallocate(sub->ring, allocator.state);
+      allocator.deallocate(sub, allocator.state);
+      sub = next_sub;
+    }
+    // topic->name is owned by the context's string pool
+    allocator.deallocate(topic, allocator.state);
+    topic = next_topic;
+  }
+  allocator.deallocate(registry, allocator.state);
+  context->impl->intra_process_registry = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
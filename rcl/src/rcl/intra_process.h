@@ -0,0 +1,120 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__INTRA_PROCESS_H_
+#define RCL__INTRA_PROCESS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+#include "rcl/guard_condition.h"
+#include "rcl/types.h"
+
+// Internal intra-process fast path registry, hung off the context.
+//
+// Publishers and subscriptions that opt in (use_intra_process in their
+// options) are matched by their expanded and remapped topic name at init
+// time: each topic gets one registry node, publishers cache a pointer to
+// their node, and subscriptions hang a single-producer single-consumer
+// pointer ring off it.  rcl_publish() then moves the message pointer
+// through the ring and triggers the subscription's intra-process guard
+// condition without crossing into the middleware.
+//
+// The registry moves pointers, not copies: the application owns the
+// message memory and must keep it valid until the taking side is done with
+// it, which makes this suitable for messages from a process-wide pool.
+// Registration and unregistration are not thread-safe; the ring itself is
+// safe for one concurrent publisher and one concurrent taker.
+
+struct rcl_intra_process_sub_t;
+
+/// One topic known to the registry, shared by its publishers/subscriptions.
+typedef struct rcl_intra_process_topic_t
+{
+  // Interned in the context's string pool, which owns the storage.
+  const char * name;
+  struct rcl_intra_process_sub_t * subs;
+  struct rcl_intra_process_topic_t * next;
+} rcl_intra_process_topic_t;
+
+/// Register an intra-process publisher, resolving its topic node.
+/**
+ * The topic node is created if this is the first entity on the topic and
+ * stays valid until the context is cleaned up, so the publisher can keep
+ * the pointer for the lifetime of its rmw handle.
+ *
+ * \return `RCL_RET_OK`, `RCL_RET_INVALID_ARGUMENT`, or `RCL_RET_BAD_ALLOC`.
+ */
+rcl_ret_t
+rcl_intra_process_register_publisher(
+  rcl_context_t * context,
+  const char * topic_name,
+  rcl_intra_process_topic_t ** topic_entry);
+
+/// Register an intra-process subscription on a topic.
+/**
+ * A pointer ring with `buffer_capacity` slots is hung off the topic node;
+ * `guard_condition` is borrowed and triggered whenever a message pointer is
+ * pushed, so wait sets containing it wake up.  `owner` identifies the
+ * subscription for unregistration.
+ *
+ * \return `RCL_RET_OK`, `RCL_RET_INVALID_ARGUMENT`, or `RCL_RET_BAD_ALLOC`.
+ */
+rcl_ret_t
+rcl_intra_process_register_subscription(
+  rcl_context_t * context,
+  const char * topic_name,
+  const void * owner,
+  size_t buffer_capacity,
+  rcl_guard_condition_t * guard_condition,
+  struct rcl_intra_process_sub_t ** sub_entry);
+
+/// Unregister a subscription previously registered with the given owner.
+rcl_ret_t
+rcl_intra_process_unregister_subscription(
+  rcl_context_t * context,
+  const void * owner);
+
+/// Publish a message pointer to every subscription on the topic.
+/**
+ * Subscriptions whose ring is full miss this message; the pointer is
+ * delivered to the remaining ones and their guard conditions triggered.
+ */
+rcl_ret_t
+rcl_intra_process_publish(
+  rcl_intra_process_topic_t * topic_entry,
+  const void * ros_message);
+
+/// Take the oldest pending message pointer from a subscription's ring.
+/**
+ * \return `RCL_RET_OK` if a pointer was taken, or
+ * \return `RCL_RET_SUBSCRIPTION_TAKE_FAILED` if the ring was empty.
+ */
+rcl_ret_t
+rcl_intra_process_take(
+  struct rcl_intra_process_sub_t * sub_entry,
+  const void ** ros_message);
+
+/// Free the registry and everything in it; called during context cleanup.
+void
+rcl_intra_process_registry_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__INTRA_PROCESS_H_
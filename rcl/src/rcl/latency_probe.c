@@ -0,0 +1,535 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/latency_probe.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "rcl/client.h"
+#include "rcl/error_handling.h"
+#include "rcl/publisher.h"
+#include "rcl/service.h"
+#include "rcl/subscription.h"
+#include "rcl/wait.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/time.h"
+
+// Hidden, node private names keep the loopback entities out of undecorated
+// graph introspection and distinct between nodes of one process.
+#define RCL_LATENCY_PROBE_NAME "~/_latency_probe"
+
+typedef struct rcl_latency_probe_impl_t
+{
+  rcl_allocator_t allocator;
+  bool has_message_channel;
+  bool has_service_channel;
+  rcl_publisher_t publisher;
+  rcl_subscription_t subscription;
+  rcl_service_t service;
+  rcl_client_t client;
+  // wait set used to block for the loopback half of each round trip
+  rcl_wait_set_t wait_set;
+  size_t warmup_iterations;
+  // ring buffers of round trip times; once full the oldest is overwritten
+  size_t sample_capacity;
+  int64_t * message_samples;
+  size_t message_sample_count;
+  size_t message_sample_next;
+  int64_t * service_samples;
+  size_t service_sample_count;
+  size_t service_sample_next;
+  // scratch for the on demand percentile sort
+  int64_t * sorted_scratch;
+} rcl_latency_probe_impl_t;
+
+rcl_latency_probe_t
+rcl_get_zero_initialized_latency_probe(void)
+{
+  static rcl_latency_probe_t null_probe = {0};
+  return null_probe;
+}
+
+rcl_latency_probe_options_t
+rcl_latency_probe_get_default_options(void)
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  rcl_latency_probe_options_t default_options = {
+    .qos = rmw_qos_profile_default,
+    .max_samples = 256,
+    .warmup_iterations = 1,
+  };
+  default_options.allocator = rcl_get_default_allocator();
+  return default_options;
+}
+
+static bool
+__latency_probe_is_valid(const rcl_latency_probe_t * probe)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(probe, "latency probe pointer is invalid", return false);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    probe->impl, "latency probe implementation is invalid", return false);
+  return true;
+}
+
+rcl_ret_t
+rcl_latency_probe_init(
+  rcl_latency_probe_t * probe,
+  rcl_node_t * node,
+  const rosidl_message_type_support_t * message_type_support,
+  const rosidl_service_type_support_t * service_type_support,
+  const rcl_latency_probe_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(probe, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    &options->allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (probe->impl) {
+    RCL_SET_ERROR_MSG("latency probe already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (!message_type_support && !service_type_support) {
+    RCL_SET_ERROR_MSG("at least one type support must be given");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (0 == options->max_samples) {
+    RCL_SET_ERROR_MSG("max_samples must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_allocator_t allocator = options->allocator;
+  rcl_ret_t fail_ret = RCL_RET_ERROR;
+
+  rcl_latency_probe_impl_t * impl = (rcl_latency_probe_impl_t *)allocator.allocate(
+    sizeof(rcl_latency_probe_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  memset(impl, 0, sizeof(rcl_latency_probe_impl_t));
+  impl->allocator = allocator;
+  impl->publisher = rcl_get_zero_initialized_publisher();
+  impl->subscription = rcl_get_zero_initialized_subscription();
+  impl->service = rcl_get_zero_initialized_service();
+  impl->client = rcl_get_zero_initialized_client();
+  impl->wait_set = rcl_get_zero_initialized_wait_set();
+  impl->sample_capacity = options->max_samples;
+  impl->warmup_iterations = options->warmup_iterations;
+  probe->impl = impl;
+
+  if (message_type_support) {
+    rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+    publisher_options.qos = options->qos;
+    publisher_options.allocator = allocator;
+    rcl_ret_t ret = rcl_publisher_init(
+      &impl->publisher, node, message_type_support, RCL_LATENCY_PROBE_NAME,
+      &publisher_options);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto fail;
+    }
+    rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+    subscription_options.qos = options->qos;
+    subscription_options.allocator = allocator;
+    ret = rcl_subscription_init(
+      &impl->subscription, node, message_type_support, RCL_LATENCY_PROBE_NAME,
+      &subscription_options);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto fail;
+    }
+    impl->message_samples = (int64_t *)allocator.allocate(
+      sizeof(int64_t) * impl->sample_capacity, allocator.state);
+    if (!impl->message_samples) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+    impl->has_message_channel = true;
+  }
+  if (service_type_support) {
+    rcl_service_options_t service_options = rcl_service_get_default_options();
+    service_options.qos = options->qos;
+    service_options.allocator = allocator;
+    rcl_ret_t ret = rcl_service_init(
+      &impl->service, node, service_type_support, RCL_LATENCY_PROBE_NAME,
+      &service_options);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto fail;
+    }
+    rcl_client_options_t client_options = rcl_client_get_default_options();
+    client_options.qos = options->qos;
+    client_options.allocator = allocator;
+    ret = rcl_client_init(
+      &impl->client, node, service_type_support, RCL_LATENCY_PROBE_NAME,
+      &client_options);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto fail;
+    }
+    impl->service_samples = (int64_t *)allocator.allocate(
+      sizeof(int64_t) * impl->sample_capacity, allocator.state);
+    if (!impl->service_samples) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      goto fail;
+    }
+    impl->has_service_channel = true;
+  }
+  impl->sorted_scratch = (int64_t *)allocator.allocate(
+    sizeof(int64_t) * impl->sample_capacity, allocator.state);
+  if (!impl->sorted_scratch) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    fail_ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  {
+    rcl_ret_t ret = rcl_wait_set_init(
+      &impl->wait_set,
+      impl->has_message_channel ? 1 : 0, 0, 0,
+      impl->has_service_channel ? 1 : 0,
+      impl->has_service_channel ? 1 : 0,
+      allocator);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto fail;
+    }
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Latency probe initialized on '%s'", RCL_LATENCY_PROBE_NAME);
+  return RCL_RET_OK;
+fail:
+  {
+    // Tear down whatever was created; the first error state is the one the
+    // caller should see, so a secondary cleanup failure is only logged.
+    rcl_ret_t fini_ret = rcl_latency_probe_fini(probe, node);
+    if (RCL_RET_OK != fini_ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "Failed to clean up latency probe after failed initialization");
+    }
+  }
+  return fail_ret;
+}
+
+rcl_ret_t
+rcl_latency_probe_fini(rcl_latency_probe_t * probe, rcl_node_t * node)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(probe, RCL_RET_INVALID_ARGUMENT);
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  rcl_ret_t result = RCL_RET_OK;
+  rcl_latency_probe_impl_t * impl = probe->impl;
+  if (impl) {
+    rcl_allocator_t allocator = impl->allocator;
+    // Only the entities whose init succeeded have an impl to finalize.
+    if (impl->publisher.impl) {
+      rcl_ret_t ret = rcl_publisher_fini(&impl->publisher, node);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    if (impl->subscription.impl) {
+      rcl_ret_t ret = rcl_subscription_fini(&impl->subscription, node);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    if (impl->service.impl) {
+      rcl_ret_t ret = rcl_service_fini(&impl->service, node);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    if (impl->client.impl) {
+      rcl_ret_t ret = rcl_client_fini(&impl->client, node);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    if (impl->wait_set.impl) {
+      rcl_ret_t ret = rcl_wait_set_fini(&impl->wait_set);
+      if (RCL_RET_OK != ret) {
+        result = ret;
+      }
+    }
+    if (impl->message_samples) {
+      allocator.deallocate(impl->message_samples, allocator.state);
+    }
+    if (impl->service_samples) {
+      allocator.deallocate(impl->service_samples, allocator.state);
+    }
+    if (impl->sorted_scratch) {
+      allocator.deallocate(impl->sorted_scratch, allocator.state);
+    }
+    allocator.deallocate(impl, allocator.state);
+    probe->impl = NULL;
+  }
+  return result;
+}
+
+static void
+__latency_probe_record(
+  int64_t * samples, size_t capacity, size_t * count, size_t * next, int64_t sample)
+{
+  samples[*next] = sample;
+  *next = (*next + 1) % capacity;
+  if (*count < capacity) {
+    ++(*count);
+  }
+}
+
+rcl_ret_t
+rcl_latency_probe_measure_messages(
+  rcl_latency_probe_t * probe,
+  const void * ros_message,
+  void * taken_message,
+  size_t iterations,
+  int64_t timeout)
+{
+  if (!__latency_probe_is_valid(probe)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken_message, RCL_RET_INVALID_ARGUMENT);
+  if (0 == iterations) {
+    RCL_SET_ERROR_MSG("iterations must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_latency_probe_impl_t * impl = probe->impl;
+  if (!impl->has_message_channel) {
+    RCL_SET_ERROR_MSG("latency probe has no message channel");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const size_t total = impl->warmup_iterations + iterations;
+  for (size_t i = 0; i < total; ++i) {
+    rcutils_time_point_value_t start = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&start)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    rcl_ret_t ret = rcl_publish(&impl->publisher, ros_message);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    // The loopback delivery is asynchronous in most middlewares; block until
+    // the subscription reports the message, then take it.  A wake without a
+    // message (e.g. another message in flight) just waits again.
+    rcl_ret_t take_ret = RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+    do {
+      ret = rcl_wait_set_clear(&impl->wait_set);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+      ret = rcl_wait_set_add_subscription(&impl->wait_set, &impl->subscription, NULL);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+      ret = rcl_wait(&impl->wait_set, timeout);
+      if (RCL_RET_TIMEOUT == ret) {
+        return RCL_RET_TIMEOUT;  // error already set
+      }
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+      take_ret = rcl_take(&impl->subscription, taken_message, NULL);
+      if (RCL_RET_OK != take_ret && RCL_RET_SUBSCRIPTION_TAKE_FAILED != take_ret) {
+        return take_ret;  // error already set
+      }
+      rcl_reset_error();
+    } while (RCL_RET_OK != take_ret);
+    rcutils_time_point_value_t end = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&end)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (i >= impl->warmup_iterations) {
+      __latency_probe_record(
+        impl->message_samples, impl->sample_capacity,
+        &impl->message_sample_count, &impl->message_sample_next, end - start);
+    }
+  }
+  return RCL_RET_OK;
+}
+
+// Block until the given entity kind is ready on the probe's wait set.
+#define LATENCY_PROBE_WAIT_FOR(AddCall) \
+  do { \
+    rcl_ret_t wait_ret = rcl_wait_set_clear(&impl->wait_set); \
+    if (RCL_RET_OK != wait_ret) { \
+      return wait_ret;  /* error already set */ \
+    } \
+    wait_ret = AddCall; \
+    if (RCL_RET_OK != wait_ret) { \
+      return wait_ret;  /* error already set */ \
+    } \
+    wait_ret = rcl_wait(&impl->wait_set, timeout); \
+    if (RCL_RET_OK != wait_ret) { \
+      return wait_ret;  /* error already set, including RCL_RET_TIMEOUT */ \
+    } \
+  } while (false)
+
+rcl_ret_t
+rcl_latency_probe_measure_services(
+  rcl_latency_probe_t * probe,
+  const void * ros_request,
+  void * taken_request,
+  const void * ros_response,
+  void * taken_response,
+  size_t iterations,
+  int64_t timeout)
+{
+  if (!__latency_probe_is_valid(probe)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_response, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken_response, RCL_RET_INVALID_ARGUMENT);
+  if (0 == iterations) {
+    RCL_SET_ERROR_MSG("iterations must be non-zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_latency_probe_impl_t * impl = probe->impl;
+  if (!impl->has_service_channel) {
+    RCL_SET_ERROR_MSG("latency probe has no service channel");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const size_t total = impl->warmup_iterations + iterations;
+  for (size_t i = 0; i < total; ++i) {
+    rcutils_time_point_value_t start = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&start)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    int64_t sequence_number = 0;
+    rcl_ret_t ret = rcl_send_request(&impl->client, ros_request, &sequence_number);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    LATENCY_PROBE_WAIT_FOR(
+      rcl_wait_set_add_service(&impl->wait_set, &impl->service, NULL));
+    rmw_request_id_t request_header;
+    memset(&request_header, 0, sizeof(request_header));
+    ret = rcl_take_request(&impl->service, &request_header, taken_request);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    // Casting away const mirrors rcl_send_response(), which does not
+    // modify the response but is not const correct.
+    ret = rcl_send_response(&impl->service, &request_header, (void *)ros_response);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    LATENCY_PROBE_WAIT_FOR(
+      rcl_wait_set_add_client(&impl->wait_set, &impl->client, NULL));
+    rmw_request_id_t response_header;
+    memset(&response_header, 0, sizeof(response_header));
+    ret = rcl_take_response(&impl->client, &response_header, taken_response);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+    rcutils_time_point_value_t end = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&end)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (i >= impl->warmup_iterations) {
+      __latency_probe_record(
+        impl->service_samples, impl->sample_capacity,
+        &impl->service_sample_count, &impl->service_sample_next, end - start);
+    }
+  }
+  return RCL_RET_OK;
+}
+
+static int
+__latency_probe_compare_samples(const void * lhs, const void * rhs)
+{
+  const int64_t left = *(const int64_t *)lhs;
+  const int64_t right = *(const int64_t *)rhs;
+  if (left < right) {
+    return -1;
+  }
+  if (left > right) {
+    return 1;
+  }
+  return 0;
+}
+
+static void
+__latency_probe_summarize(
+  rcl_latency_probe_impl_t * impl,
+  const int64_t * samples,
+  size_t count,
+  rcl_latency_stats_t * stats)
+{
+  memset(stats, 0, sizeof(rcl_latency_stats_t));
+  stats->sample_count = count;
+  if (0 == count) {
+    return;
+  }
+  memcpy(impl->sorted_scratch, samples, sizeof(int64_t) * count);
+  qsort(impl->sorted_scratch, count, sizeof(int64_t), __latency_probe_compare_samples);
+  stats->min = impl->sorted_scratch[0];
+  stats->max = impl->sorted_scratch[count - 1];
+  stats->p50 = impl->sorted_scratch[(count - 1) * 50 / 100];
+  stats->p90 = impl->sorted_scratch[(count - 1) * 90 / 100];
+  stats->p99 = impl->sorted_scratch[(count - 1) * 99 / 100];
+}
+
+rcl_ret_t
+rcl_latency_probe_get_message_stats(
+  const rcl_latency_probe_t * probe,
+  rcl_latency_stats_t * stats)
+{
+  if (!__latency_probe_is_valid(probe)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  if (!probe->impl->has_message_channel) {
+    RCL_SET_ERROR_MSG("latency probe has no message channel");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  __latency_probe_summarize(
+    probe->impl, probe->impl->message_samples, probe->impl->message_sample_count, stats);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_latency_probe_get_service_stats(
+  const rcl_latency_probe_t * probe,
+  rcl_latency_stats_t * stats)
+{
+  if (!__latency_probe_is_valid(probe)) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(stats, RCL_RET_INVALID_ARGUMENT);
+  if (!probe->impl->has_service_channel) {
+    RCL_SET_ERROR_MSG("latency probe has no service channel");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  __latency_probe_summarize(
+    probe->impl, probe->impl->service_samples, probe->impl->service_sample_count, stats);
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
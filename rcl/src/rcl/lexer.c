@@ -12,9 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <stdbool.h>
+
 #include "rcl/error_handling.h"
 #include "rcl/lexer.h"
 
+#include "rcutils/stdatomic_helper.h"
+
 /* The lexer tries to find a lexeme in a string.
  * It looks at one character at a time, and uses that character's value to decide how to transition
  * a state machine.
@@ -575,6 +579,56 @@ static const rcl_lexeme_t g_terminals[LAST_TERMINAL + 1] = {
   RCL_LEXEME_NONE,
 };
 
+// Number of possible character values, indexed by unsigned char
+#define NUM_CHAR_VALUES 256u
+
+// Flat state x character tables derived from g_states, so the hot loop can
+// find the next state and movement with two array lookups instead of
+// scanning transition ranges.
+static unsigned char g_flat_next_state[LAST_STATE + 1][NUM_CHAR_VALUES];
+static unsigned char g_flat_movement[LAST_STATE + 1][NUM_CHAR_VALUES];
+// True for characters which keep the lexer in the token body state (S8)
+static bool g_token_body_char[NUM_CHAR_VALUES];
+static atomic_bool g_flat_tables_ready = ATOMIC_VAR_INIT(false);
+
+/// Derive the flat lookup tables from the transition ranges in g_states.
+/**
+ * This runs once, on the first call to rcl_lexer_analyze().
+ * Concurrent initialization is harmless because every caller derives
+ * identical values from the constant state machine.
+ * \internal
+ */
+static void
+_rcl_lexer_build_flat_tables(void)
+{
+  for (size_t state_idx = 0u; state_idx <= LAST_STATE; ++state_idx) {
+    const rcl_lexer_state_t * state = &(g_states[state_idx]);
+    for (size_t char_value = 0u; char_value < NUM_CHAR_VALUES; ++char_value) {
+      // default to the else transition, overridden if a range matches
+      unsigned char next_state = state->else_state;
+      unsigned char movement = state->else_movement;
+      const rcl_lexer_transition_t * transition = state->transitions;
+      for (; 0u != transition->to_state; ++transition) {
+        if (
+          (size_t)(unsigned char)transition->range_start <= char_value &&
+          char_value <= (size_t)(unsigned char)transition->range_end)
+        {
+          next_state = transition->to_state;
+          movement = 0u;
+          break;
+        }
+      }
+      g_flat_next_state[state_idx][char_value] = next_state;
+      g_flat_movement[state_idx][char_value] = movement;
+    }
+    if (S8 == state_idx) {
+      for (size_t char_value = 0u; char_value < NUM_CHAR_VALUES; ++char_value) {
+        g_token_body_char[char_value] = S8 == g_flat_next_state[S8][char_value];
+      }
+    }
+  }
+}
+
 rcl_ret_t
 rcl_lexer_analyze(
   const char * text,
@@ -585,6 +639,11 @@ rcl_lexer_analyze(
   RCL_CHECK_ARGUMENT_FOR_NULL(lexeme, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(length, RCL_RET_INVALID_ARGUMENT);
 
+  if (!rcutils_atomic_load_bool(&g_flat_tables_ready)) {
+    _rcl_lexer_build_flat_tables();
+    rcutils_atomic_store(&g_flat_tables_ready, true);
+  }
+
   *length = 0u;
 
   if ('\0' == text[0u]) {
@@ -593,8 +652,6 @@ rcl_lexer_analyze(
     return RCL_RET_OK;
   }
 
-  const rcl_lexer_state_t * state;
-  char current_char;
   size_t next_state = S0;
   size_t movement;
 
@@ -605,33 +662,24 @@ rcl_lexer_analyze(
       RCL_SET_ERROR_MSG("Internal lexer bug: next state does not exist");
       return RCL_RET_ERROR;
     }
-    state = &(g_states[next_state]);
-    current_char = text[*length];
-    next_state = 0u;
-    movement = 0u;
-
-    // Look for a transition that contains this character in its range
-    size_t transition_idx = 0u;
-    const rcl_lexer_transition_t * transition;
-    do {
-      transition = &(state->transitions[transition_idx]);
-      if (transition->range_start <= current_char && transition->range_end >= current_char) {
-        next_state = transition->to_state;
-        break;
-      }
-      ++transition_idx;
-    } while (0u != transition->to_state);
-
-    // if no transition was found, take the else transition
-    if (0u == next_state) {
-      next_state = state->else_state;
-      movement = state->else_movement;
-    }
+    size_t char_value = (size_t)(unsigned char)text[*length];
+    movement = g_flat_movement[next_state][char_value];
+    next_state = g_flat_next_state[next_state][char_value];
 
     // Move the lexer to another character in the string
     if (0u == movement) {
       // Go forwards 1 char
       ++(*length);
+      if (S8 == next_state) {
+        // Token bodies are the longest runs in remap rules; consume the
+        // whole run here in a tight scan of the classification table
+        // rather than going through the state machine per character.
+        // Each skipped character is the S8 -> S8 transition with no
+        // movement, so the state machine is unchanged by this shortcut.
+        while (g_token_body_char[(unsigned char)text[*length]]) {
+          ++(*length);
+        }
+      }
     } else {
       // Go backwards N chars
       if (movement - 1u > *length) {
@@ -15,24 +15,6 @@
 #include "rcl/error_handling.h"
 #include "rcl/lexer_lookahead.h"
 
-struct rcl_lexer_lookahead2_impl_t
-{
-  // Text that is being analyzed for lexemes
-  const char * text;
-  // Where in the text analysis is being performed
-  size_t text_idx;
-
-  // first character of lexeme
-  size_t start[2];
-  // One past last character of lexeme
-  size_t end[2];
-  // Type of lexeme
-  rcl_lexeme_t type[2];
-
-  // Allocator to use if an error occurrs
-  rcl_allocator_t allocator;
-};
-
 rcl_lexer_lookahead2_t
 rcl_get_zero_initialized_lexer_lookahead2()
 {
@@ -56,9 +38,8 @@ rcl_lexer_lookahead2_init(
     return RCL_RET_INVALID_ARGUMENT;
   }
 
-  buffer->impl = allocator.allocate(sizeof(struct rcl_lexer_lookahead2_impl_t), allocator.state);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    buffer->impl, "Failed to allocate lookahead impl", return RCL_RET_BAD_ALLOC);
+  // the analysis state lives inline in the buffer; no allocation needed
+  buffer->impl = &(buffer->state);
 
   buffer->impl->text = text;
   buffer->impl->text_idx = 0u;
@@ -80,10 +61,8 @@ rcl_lexer_lookahead2_fini(
   RCL_CHECK_ARGUMENT_FOR_NULL(buffer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     buffer->impl, "buffer finalized twice", return RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ALLOCATOR_WITH_MSG(
-    &(buffer->impl->allocator), "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
 
-  buffer->impl->allocator.deallocate(buffer->impl, buffer->impl->allocator.state);
+  // the state is inline in the buffer, so there is nothing to deallocate
   buffer->impl = NULL;
   return RCL_RET_OK;
 }
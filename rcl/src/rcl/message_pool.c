@@ -0,0 +1,127 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./message_pool.h"
+
+#include <stdalign.h>
+#include <string.h>
+
+#include "rcl/error_handling.h"
+
+rcl_message_pool_t
+rcl_get_zero_initialized_message_pool(void)
+{
+  static rcl_message_pool_t null_pool = {0};
+  return null_pool;
+}
+
+rcl_ret_t
+rcl_message_pool_init(
+  rcl_message_pool_t * pool,
+  size_t capacity,
+  size_t message_bound,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (0 == capacity || 0 == message_bound) {
+    RCL_SET_ERROR_MSG("message pool capacity and message bound must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Round the slot size up so every slot is aligned for any message type.
+  size_t alignment = alignof(max_align_t);
+  size_t slot_size = (message_bound + alignment - 1) / alignment * alignment;
+  pool->storage = (uint8_t *)allocator.allocate(capacity * slot_size, allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(pool->storage, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  pool->free_indices = (size_t *)allocator.allocate(capacity * sizeof(size_t), allocator.state);
+  if (!pool->free_indices) {
+    allocator.deallocate(pool->storage, allocator.state);
+    pool->storage = NULL;
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  memset(pool->storage, 0, capacity * slot_size);
+  for (size_t i = 0; i < capacity; ++i) {
+    pool->free_indices[i] = i;
+  }
+  pool->slot_size = slot_size;
+  pool->capacity = capacity;
+  pool->free_count = capacity;
+  pool->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_message_pool_fini(rcl_message_pool_t * pool)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+  if (pool->storage) {
+    pool->allocator.deallocate(pool->storage, pool->allocator.state);
+    pool->storage = NULL;
+  }
+  if (pool->free_indices) {
+    pool->allocator.deallocate(pool->free_indices, pool->allocator.state);
+    pool->free_indices = NULL;
+  }
+  pool->slot_size = 0;
+  pool->capacity = 0;
+  pool->free_count = 0;
+  return RCL_RET_OK;
+}
+
+void *
+rcl_message_pool_acquire(rcl_message_pool_t * pool)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(pool->storage, "message pool is not initialized", return NULL);
+  if (0 == pool->free_count) {
+    RCL_SET_ERROR_MSG("message pool exhausted");
+    return NULL;
+  }
+  size_t index = pool->free_indices[--pool->free_count];
+  return pool->storage + index * pool->slot_size;
+}
+
+rcl_ret_t
+rcl_message_pool_release(rcl_message_pool_t * pool, void * message_storage)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_storage, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    pool->storage, "message pool is not initialized", return RCL_RET_INVALID_ARGUMENT);
+  uint8_t * storage = (uint8_t *)message_storage;
+  if (
+    storage < pool->storage ||
+    storage >= pool->storage + pool->capacity * pool->slot_size ||
+    0 != (size_t)(storage - pool->storage) % pool->slot_size)
+  {
+    RCL_SET_ERROR_MSG("given message storage is not a slot of this pool");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (pool->free_count >= pool->capacity) {
+    RCL_SET_ERROR_MSG("message pool double release");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  pool->free_indices[pool->free_count++] = (size_t)(storage - pool->storage) / pool->slot_size;
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
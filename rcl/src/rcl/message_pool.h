@@ -0,0 +1,87 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__MESSAGE_POOL_H_
+#define RCL__MESSAGE_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/types.h"
+
+/// Fixed pool of message storage, preallocated in one block at init time.
+/**
+ * Used internally by publishers and subscriptions configured with a message
+ * pool in their options, so that acquiring storage for a message on the hot
+ * path is a pop from a free list rather than a call into the allocator.
+ */
+typedef struct rcl_message_pool_t
+{
+  // One block of capacity * slot_size bytes.
+  uint8_t * storage;
+  // Size of one slot, rounded up for worst case alignment.
+  size_t slot_size;
+  size_t capacity;
+  // Stack of indices of slots not currently acquired.
+  size_t * free_indices;
+  size_t free_count;
+  rcl_allocator_t allocator;
+} rcl_message_pool_t;
+
+/// Return a rcl_message_pool_t struct with members set to zero values.
+rcl_message_pool_t
+rcl_get_zero_initialized_message_pool(void);
+
+/// Initialize a pool of `capacity` slots of at least `message_bound` bytes.
+/**
+ * All storage is allocated here; no allocation happens on acquire/release.
+ *
+ * \return `RCL_RET_OK` if initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+rcl_ret_t
+rcl_message_pool_init(
+  rcl_message_pool_t * pool,
+  size_t capacity,
+  size_t message_bound,
+  rcl_allocator_t allocator);
+
+/// Finalize a pool, freeing its storage; outstanding slots become invalid.
+rcl_ret_t
+rcl_message_pool_fini(rcl_message_pool_t * pool);
+
+/// Acquire one slot, or `NULL` (with an error set) if the pool is exhausted.
+void *
+rcl_message_pool_acquire(rcl_message_pool_t * pool);
+
+/// Release a slot previously acquired from this pool.
+/**
+ * \return `RCL_RET_OK` if the slot was released, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if the pointer is not a slot of this
+ *   pool or any arguments are invalid.
+ */
+rcl_ret_t
+rcl_message_pool_release(rcl_message_pool_t * pool, void * message_storage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__MESSAGE_POOL_H_
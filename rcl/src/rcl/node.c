@@ -19,19 +19,18 @@ extern "C"
 
 #include "rcl/node.h"
 
-#include <limits.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
 #include "rcl/arguments.h"
+#include "rcl/counting_allocator.h"
 #include "rcl/error_handling.h"
+#include "rcl/expand_topic_name.h"
 #include "rcl/rcl.h"
 #include "rcl/remap.h"
 #include "rcutils/filesystem.h"
 #include "rcutils/find.h"
 #include "rcutils/format_string.h"
-#include "rcutils/get_env.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/macros.h"
 #include "rcutils/repl_str.h"
@@ -43,13 +42,21 @@ extern "C"
 #include "rmw/validate_namespace.h"
 #include "rmw/validate_node_name.h"
 
-#include "./common.h"
 #include "./context_impl.h"
-
-#define ROS_SECURITY_NODE_DIRECTORY_VAR_NAME "ROS_SECURITY_NODE_DIRECTORY"
-#define ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME "ROS_SECURITY_ROOT_DIRECTORY"
-#define ROS_SECURITY_STRATEGY_VAR_NAME "ROS_SECURITY_STRATEGY"
-#define ROS_SECURITY_ENABLE_VAR_NAME "ROS_SECURITY_ENABLE"
+#include "./entity_registry.h"
+#include "./entity_slab.h"
+#include "./env_snapshot.h"
+#include "./graph_cache.h"
+#include "./remap_cache.h"
+
+/// State staged by rcl_node_init_async() for rcl_node_init_complete().
+typedef struct rcl_node_init_pending_t
+{
+  char * name;
+  char * namespace_;
+  size_t domain_id;
+  rmw_node_security_options_t security_options;
+} rcl_node_init_pending_t;
 
 typedef struct rcl_node_impl_t
 {
@@ -57,7 +64,25 @@ typedef struct rcl_node_impl_t
   size_t actual_domain_id;
   rmw_node_t * rmw_node_handle;
   rcl_guard_condition_t * graph_guard_condition;
+  // Dotted logger name, built lazily by the first call to
+  // rcl_node_get_logger_name(); NULL until then.
   const char * logger_name;
+  // Resolved identity waiting for the middleware portion of init, or NULL
+  // when no init is in flight.
+  rcl_node_init_pending_t * pending_init;
+  // Memo of remap resolutions for entities created on this node, or NULL if
+  // its allocation failed (entities then just run the rules every time).
+  rcl_remap_cache_t * remap_cache;
+  // Cached substitutions for expanding entity names, built once per node
+  // instead of once per entity created.
+  rcutils_string_map_t substitutions_map;
+  // Opt-in cache of graph query snapshots, or NULL when not enabled.
+  // \sa rcl_node_graph_cache_enable()
+  rcl_graph_cache_t * graph_cache;
+  // Slab backing the impl structs of entities created on this node, so they
+  // sit contiguously in memory, or NULL if its allocation failed (entity
+  // impls then come from the plain allocator).
+  rcl_entity_slab_t * entity_slab;
 } rcl_node_impl_t;
 
 
@@ -108,45 +133,37 @@ const char * rcl_create_node_logger_name(
  * Such an override is useful for where the FQN of a node is non-deterministic before runtime,
  * or when testing and using additional tools that may not otherwise not be easily provisioned.
  *
+ * The directories come from the context's environment snapshot rather than
+ * being re-read from the environment for every node.
+ *
  * \param[in] node_name validated node name (a single token)
  * \param[in] node_namespace validated, absolute namespace (starting with "/")
+ * \param[in] env_snapshot environment snapshot of the node's context
  * \param[in] allocator the allocator to use for allocation
  * \returns machine specific (absolute) node secure root path or NULL on failure
  */
 const char * rcl_get_secure_root(
   const char * node_name,
   const char * node_namespace,
+  const rcl_env_snapshot_t * env_snapshot,
   const rcl_allocator_t * allocator)
 {
   bool ros_secure_node_override = true;
-  const char * ros_secure_root_env = NULL;
   if (NULL == node_name) {
     return NULL;
   }
-  if (rcutils_get_env(ROS_SECURITY_NODE_DIRECTORY_VAR_NAME, &ros_secure_root_env)) {
-    return NULL;
-  }
+  const char * ros_secure_root_env = env_snapshot->secure_node_directory;
   if (!ros_secure_root_env) {
-    return NULL;
-  }
-  size_t ros_secure_root_size = strlen(ros_secure_root_env);
-  if (!ros_secure_root_size) {
-    // check root directory if node directory environment variable is empty
-    if (rcutils_get_env(ROS_SECURITY_ROOT_DIRECTORY_VAR_NAME, &ros_secure_root_env)) {
-      return NULL;
-    }
+    // check root directory if node directory environment variable was empty
+    ros_secure_root_env = env_snapshot->secure_root_directory;
     if (!ros_secure_root_env) {
-      return NULL;
-    }
-    ros_secure_root_size = strlen(ros_secure_root_env);
-    if (!ros_secure_root_size) {
-      return NULL;  // environment variable was empty
-    } else {
-      ros_secure_node_override = false;
+      return NULL;  // environment variables were unset or empty
     }
+    ros_secure_node_override = false;
   }
   char * node_secure_root = NULL;
   if (ros_secure_node_override) {
+    size_t ros_secure_root_size = strlen(ros_secure_root_env);
     node_secure_root =
       (char *)allocator->allocate(ros_secure_root_size + 1, allocator->state);
     memcpy(node_secure_root, ros_secure_root_env, ros_secure_root_size + 1);
@@ -189,8 +206,95 @@ rcl_get_zero_initialized_node()
   return null_node;
 }
 
+/// Free the staged init state, if any.
+static void
+_rcl_node_pending_init_destroy(rcl_node_impl_t * impl, const rcl_allocator_t * allocator)
+{
+  if (NULL == impl->pending_init) {
+    return;
+  }
+  allocator->deallocate(impl->pending_init->name, allocator->state);
+  allocator->deallocate(impl->pending_init->namespace_, allocator->state);
+  allocator->deallocate(
+    (char *)impl->pending_init->security_options.security_root_path, allocator->state);
+  allocator->deallocate(impl->pending_init, allocator->state);
+  impl->pending_init = NULL;
+}
+
+/// Drop the node's reference on its rmw node, destroying it when this node
+/// was the last user (always, unless the context shares one participant).
+static rmw_ret_t
+_rcl_node_release_rmw_node(rcl_node_t * node)
+{
+  rmw_node_t * rmw_node = node->impl->rmw_node_handle;
+  node->impl->rmw_node_handle = NULL;
+  if (NULL == rmw_node) {
+    return RMW_RET_OK;
+  }
+  rcl_context_impl_t * context_impl = node->context ? node->context->impl : NULL;
+  if (NULL != context_impl && rmw_node == context_impl->shared_rmw_node) {
+    if (0u != --context_impl->shared_rmw_node_count) {
+      return RMW_RET_OK;
+    }
+    context_impl->shared_rmw_node = NULL;
+  }
+  return rmw_destroy_node(rmw_node);
+}
+
+/// Undo a partial init, shared by the async and complete fail paths.
+static void
+_rcl_node_init_fail_cleanup(rcl_node_t * node, const rcl_allocator_t * allocator)
+{
+  rcl_ret_t ret;
+  if (node->impl) {
+    if (node->impl->logger_name) {
+      allocator->deallocate((char *)node->impl->logger_name, allocator->state);
+    }
+    if (node->impl->rmw_node_handle) {
+      ret = _rcl_node_release_rmw_node(node);
+      if (ret != RMW_RET_OK) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to fini rmw node in error recovery: %s", rmw_get_error_string().str
+        );
+      }
+    }
+    if (node->impl->graph_guard_condition) {
+      ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
+      if (ret != RCL_RET_OK) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to fini guard condition in error recovery: %s", rcl_get_error_string().str
+        );
+      }
+      allocator->deallocate(node->impl->graph_guard_condition, allocator->state);
+    }
+    if (NULL != node->impl->options.arguments.impl) {
+      ret = rcl_arguments_fini(&(node->impl->options.arguments));
+      if (ret != RCL_RET_OK) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME,
+          "failed to fini arguments in error recovery: %s", rcl_get_error_string().str
+        );
+      }
+    }
+    rcl_remap_cache_destroy(node->impl->remap_cache);
+    rcl_graph_cache_destroy(node->impl->graph_cache);
+    rcl_entity_slab_destroy(node->impl->entity_slab);
+    if (rcutils_string_map_fini(&(node->impl->substitutions_map)) != RCUTILS_RET_OK) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME,
+        "failed to fini substitutions map in error recovery: %s", rcutils_get_error_string().str
+      );
+    }
+    _rcl_node_pending_init_destroy(node->impl, allocator);
+    allocator->deallocate(node->impl, allocator->state);
+  }
+  *node = rcl_get_zero_initialized_node();
+}
+
 rcl_ret_t
-rcl_node_init(
+rcl_node_init_async(
   rcl_node_t * node,
   const char * name,
   const char * namespace_,
@@ -198,10 +302,6 @@ rcl_node_init(
   const rcl_node_options_t * options)
 {
   size_t domain_id = 0;
-  const char * ros_domain_id;
-  const rmw_guard_condition_t * rmw_graph_guard_condition = NULL;
-  rcl_guard_condition_options_t graph_guard_condition_options =
-    rcl_guard_condition_get_default_options();
   rcl_ret_t ret;
   rcl_ret_t fail_ret = RCL_RET_ERROR;
   char * remapped_node_name = NULL;
@@ -210,6 +310,10 @@ rcl_node_init(
   RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
   const rcl_allocator_t * allocator = &options->allocator;
   RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  // Attribute the node's allocations; a no-op unless accounting is on.
+  rcl_allocator_t node_allocator =
+    rcl_counting_allocator_wrap(options->allocator, RCL_ALLOC_TAG_NODE);
+  allocator = &node_allocator;
 
   RCL_CHECK_ARGUMENT_FOR_NULL(name, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(namespace_, RCL_RET_INVALID_ARGUMENT);
@@ -283,6 +387,11 @@ rcl_node_init(
   node->impl->rmw_node_handle = NULL;
   node->impl->graph_guard_condition = NULL;
   node->impl->logger_name = NULL;
+  node->impl->pending_init = NULL;
+  node->impl->remap_cache = NULL;
+  node->impl->substitutions_map = rcutils_get_zero_initialized_string_map();
+  node->impl->graph_cache = NULL;
+  node->impl->entity_slab = NULL;
   node->impl->options = rcl_node_get_default_options();
   node->context = context;
   // Initialize node impl.
@@ -290,6 +399,9 @@ rcl_node_init(
   if (RCL_RET_OK != ret) {
     goto fail;
   }
+  // Store the wrapped allocator so frees in rcl_node_fini() pair with the
+  // allocations made here.
+  node->impl->options.allocator = node_allocator;
 
   // Remap the node name and namespace if remap rules are given
   rcl_arguments_t * global_args = NULL;
@@ -318,26 +430,20 @@ rcl_node_init(
     local_namespace_ = remapped_namespace;
   }
 
-  // node logger name
-  node->impl->logger_name = rcl_create_node_logger_name(name, local_namespace_, allocator);
-  RCL_CHECK_FOR_NULL_WITH_MSG(
-    node->impl->logger_name, "creating logger name failed", goto fail);
+  // The logger name is not built here; most nodes never log with the node
+  // logger, so it is materialized by the first rcl_node_get_logger_name().
 
   // node rmw_node_handle
+  const rcl_env_snapshot_t * env_snapshot = rcl_context_get_env_snapshot(context);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    env_snapshot, "context has no environment snapshot", goto fail);
   if (node->impl->options.domain_id == RCL_NODE_OPTIONS_DEFAULT_DOMAIN_ID) {
-    // Find the domain ID set by the environment.
-    ret = rcl_impl_getenv("ROS_DOMAIN_ID", &ros_domain_id);
-    if (ret != RCL_RET_OK) {
+    // Use the domain ID captured from the environment during init.
+    if (env_snapshot->domain_id_invalid) {
+      RCL_SET_ERROR_MSG("failed to interpret ROS_DOMAIN_ID as integral number");
       goto fail;
     }
-    if (ros_domain_id) {
-      unsigned long number = strtoul(ros_domain_id, NULL, 0);  // NOLINT(runtime/int)
-      if (number == ULONG_MAX) {
-        RCL_SET_ERROR_MSG("failed to interpret ROS_DOMAIN_ID as integral number");
-        goto fail;
-      }
-      domain_id = (size_t)number;
-    }
+    domain_id = env_snapshot->domain_id;
   } else {
     domain_id = node->impl->options.domain_id;
   }
@@ -345,39 +451,21 @@ rcl_node_init(
   node->impl->actual_domain_id = domain_id;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Using domain ID of '%zu'", domain_id);
 
-  const char * ros_security_enable = NULL;
-  const char * ros_enforce_security = NULL;
-
-  if (rcutils_get_env(ROS_SECURITY_ENABLE_VAR_NAME, &ros_security_enable)) {
-    RCL_SET_ERROR_MSG(
-      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_ENABLE_VAR_NAME)
-      " could not be read");
-    ret = RCL_RET_ERROR;
-    goto fail;
-  }
-
-  bool use_security = (0 == strcmp(ros_security_enable, "true"));
+  bool use_security = env_snapshot->use_security;
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Using security: %s", use_security ? "true" : "false");
 
-  if (rcutils_get_env(ROS_SECURITY_STRATEGY_VAR_NAME, &ros_enforce_security)) {
-    RCL_SET_ERROR_MSG(
-      "Environment variable " RCUTILS_STRINGIFY(ROS_SECURITY_STRATEGY_VAR_NAME)
-      " could not be read");
-    ret = RCL_RET_ERROR;
-    goto fail;
-  }
-
   rmw_node_security_options_t node_security_options =
     rmw_get_zero_initialized_node_security_options();
-  node_security_options.enforce_security = (0 == strcmp(ros_enforce_security, "Enforce")) ?
+  node_security_options.enforce_security = env_snapshot->enforce_security ?
     RMW_SECURITY_ENFORCEMENT_ENFORCE : RMW_SECURITY_ENFORCEMENT_PERMISSIVE;
 
   if (!use_security) {
     node_security_options.enforce_security = RMW_SECURITY_ENFORCEMENT_PERMISSIVE;
   } else {  // if use_security
     // File discovery magic here
-    const char * node_secure_root = rcl_get_secure_root(name, local_namespace_, allocator);
+    const char * node_secure_root =
+      rcl_get_secure_root(name, local_namespace_, env_snapshot, allocator);
     if (node_secure_root) {
       node_security_options.security_root_path = node_secure_root;
     } else {
@@ -393,85 +481,150 @@ rcl_node_init(
       }
     }
   }
-  node->impl->rmw_node_handle = rmw_create_node(
-    &(node->context->impl->rmw_context),
-    name, local_namespace_, domain_id, &node_security_options);
+  // Stash everything the middleware portion needs; rcl_node_init_complete()
+  // picks it up from here.
+  node->impl->pending_init = (rcl_node_init_pending_t *)allocator->allocate(
+    sizeof(rcl_node_init_pending_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->pending_init, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto fail);
+  node->impl->pending_init->name = rcutils_strdup(name, *allocator);
+  node->impl->pending_init->namespace_ = rcutils_strdup(local_namespace_, *allocator);
+  node->impl->pending_init->domain_id = domain_id;
+  node->impl->pending_init->security_options = node_security_options;
+  if (NULL == node->impl->pending_init->name || NULL == node->impl->pending_init->namespace_) {
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Node init staged for completion");
+  ret = RCL_RET_OK;
+  goto cleanup;
+fail:
+  _rcl_node_init_fail_cleanup(node, allocator);
+
+  ret = fail_ret;
+  // fall through from fail -> cleanup
+cleanup:
+  if (should_free_local_namespace_) {
+    allocator->deallocate((char *)local_namespace_, allocator->state);
+    local_namespace_ = NULL;
+  }
+  if (NULL != remapped_node_name) {
+    allocator->deallocate(remapped_node_name, allocator->state);
+  }
+  return ret;
+}
+
+rcl_ret_t
+rcl_node_init_complete(rcl_node_t * node)
+{
+  rcl_ret_t ret;
+  const rmw_guard_condition_t * rmw_graph_guard_condition = NULL;
+  rcl_guard_condition_options_t graph_guard_condition_options =
+    rcl_guard_condition_get_default_options();
 
+  RCL_CHECK_ARGUMENT_FOR_NULL(node, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_FOR_NULL_WITH_MSG(
-    node->impl->rmw_node_handle, rmw_get_error_string().str, goto fail);
+    node->impl, "node was not started with rcl_node_init_async()",
+    return RCL_RET_INVALID_ARGUMENT);
+  rcl_node_init_pending_t * pending = node->impl->pending_init;
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    pending, "no node initialization is in flight", return RCL_RET_INVALID_ARGUMENT);
+  // keep a copy, the impl is deallocated on failure
+  rcl_allocator_t allocator = node->impl->options.allocator;
+
+  rcl_context_impl_t * context_impl = node->context->impl;
+  bool share_participant = context_impl->init_options.impl->share_participant;
+  if (share_participant && NULL != context_impl->shared_rmw_node) {
+    // multiplex this node onto the context's existing participant
+    node->impl->rmw_node_handle = context_impl->shared_rmw_node;
+    ++context_impl->shared_rmw_node_count;
+  } else {
+    // This is the part that blocks on middleware discovery; completions of
+    // many nodes can run concurrently, each only touches its own node.
+    node->impl->rmw_node_handle = rmw_create_node(
+      &(context_impl->rmw_context),
+      pending->name, pending->namespace_, pending->domain_id, &pending->security_options);
+
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      node->impl->rmw_node_handle, rmw_get_error_string().str, goto fail);
+    if (share_participant) {
+      // later nodes in this context reuse this participant
+      context_impl->shared_rmw_node = node->impl->rmw_node_handle;
+      context_impl->shared_rmw_node_count = 1;
+    }
+  }
   // graph guard condition
   rmw_graph_guard_condition = rmw_node_get_graph_guard_condition(node->impl->rmw_node_handle);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     rmw_graph_guard_condition, rmw_get_error_string().str, goto fail);
 
-  node->impl->graph_guard_condition = (rcl_guard_condition_t *)allocator->allocate(
-    sizeof(rcl_guard_condition_t), allocator->state);
+  node->impl->graph_guard_condition = (rcl_guard_condition_t *)allocator.allocate(
+    sizeof(rcl_guard_condition_t), allocator.state);
   RCL_CHECK_FOR_NULL_WITH_MSG(
     node->impl->graph_guard_condition,
     "allocating memory failed",
     goto fail);
   *node->impl->graph_guard_condition = rcl_get_zero_initialized_guard_condition();
-  graph_guard_condition_options.allocator = *allocator;
+  graph_guard_condition_options.allocator = allocator;
   ret = rcl_guard_condition_init_from_rmw(
     node->impl->graph_guard_condition,
     rmw_graph_guard_condition,
-    context,
+    node->context,
     graph_guard_condition_options);
   if (ret != RCL_RET_OK) {
     // error message already set
     goto fail;
   }
+  // Build the substitutions map once; entity creation reuses it for every
+  // name expanded on this node.
+  rcutils_ret_t rcutils_ret = rcutils_string_map_init(
+    &(node->impl->substitutions_map), 0, allocator);
+  if (rcutils_ret != RCUTILS_RET_OK) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    goto fail;
+  }
+  ret = rcl_get_default_topic_name_substitutions(&(node->impl->substitutions_map));
+  if (ret != RCL_RET_OK) {
+    // error message already set
+    goto fail;
+  }
+  // The rule sets are fixed from here on, so remap results can be memoized.
+  node->impl->remap_cache = rcl_remap_cache_create(node->context, &allocator);
+  if (NULL == node->impl->remap_cache) {
+    RCUTILS_LOG_WARN_NAMED(
+      ROS_PACKAGE_NAME, "failed to allocate remap cache, name resolutions will not be memoized");
+  }
+  // Entity impl structs come from a per-node slab so they stay contiguous.
+  node->impl->entity_slab = rcl_entity_slab_create(&allocator);
+  if (NULL == node->impl->entity_slab) {
+    RCUTILS_LOG_WARN_NAMED(
+      ROS_PACKAGE_NAME, "failed to allocate entity slab, entity impls will be heap allocated");
+  }
+  _rcl_node_pending_init_destroy(node->impl, &allocator);
+  // record for bulk teardown by rcl_context_fini_all_entities()
+  rcl_context_track_entity(node->context, RCL_TRACKED_NODE, node, node);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Node initialized");
-  ret = RCL_RET_OK;
-  goto cleanup;
+  return RCL_RET_OK;
 fail:
-  if (node->impl) {
-    if (node->impl->logger_name) {
-      allocator->deallocate((char *)node->impl->logger_name, allocator->state);
-    }
-    if (node->impl->rmw_node_handle) {
-      ret = rmw_destroy_node(node->impl->rmw_node_handle);
-      if (ret != RMW_RET_OK) {
-        RCUTILS_LOG_ERROR_NAMED(
-          ROS_PACKAGE_NAME,
-          "failed to fini rmw node in error recovery: %s", rmw_get_error_string().str
-        );
-      }
-    }
-    if (node->impl->graph_guard_condition) {
-      ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
-      if (ret != RCL_RET_OK) {
-        RCUTILS_LOG_ERROR_NAMED(
-          ROS_PACKAGE_NAME,
-          "failed to fini guard condition in error recovery: %s", rcl_get_error_string().str
-        );
-      }
-      allocator->deallocate(node->impl->graph_guard_condition, allocator->state);
-    }
-    if (NULL != node->impl->options.arguments.impl) {
-      ret = rcl_arguments_fini(&(node->impl->options.arguments));
-      if (ret != RCL_RET_OK) {
-        RCUTILS_LOG_ERROR_NAMED(
-          ROS_PACKAGE_NAME,
-          "failed to fini arguments in error recovery: %s", rcl_get_error_string().str
-        );
-      }
-    }
-    allocator->deallocate(node->impl, allocator->state);
-  }
-  *node = rcl_get_zero_initialized_node();
+  _rcl_node_init_fail_cleanup(node, &allocator);
+  return RCL_RET_ERROR;
+}
 
-  ret = fail_ret;
-  // fall through from fail -> cleanup
-cleanup:
-  if (should_free_local_namespace_) {
-    allocator->deallocate((char *)local_namespace_, allocator->state);
-    local_namespace_ = NULL;
-  }
-  if (NULL != remapped_node_name) {
-    allocator->deallocate(remapped_node_name, allocator->state);
+rcl_ret_t
+rcl_node_init(
+  rcl_node_t * node,
+  const char * name,
+  const char * namespace_,
+  rcl_context_t * context,
+  const rcl_node_options_t * options)
+{
+  rcl_ret_t ret = rcl_node_init_async(node, name, namespace_, context, options);
+  if (RCL_RET_OK != ret) {
+    // error already set
+    return ret;
   }
-  return ret;
+  return rcl_node_init_complete(node);
 }
 
 rcl_ret_t
@@ -485,17 +638,25 @@ rcl_node_fini(rcl_node_t * node)
   }
   rcl_allocator_t allocator = node->impl->options.allocator;
   rcl_ret_t result = RCL_RET_OK;
-  rmw_ret_t rmw_ret = rmw_destroy_node(node->impl->rmw_node_handle);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    result = RCL_RET_ERROR;
+  rcl_context_untrack_entity(node->context, node);
+  // the rmw node and guard condition do not exist yet on a node whose
+  // rcl_node_init_async() was never completed
+  if (node->impl->rmw_node_handle) {
+    rmw_ret_t rmw_ret = _rcl_node_release_rmw_node(node);
+    if (rmw_ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      result = RCL_RET_ERROR;
+    }
   }
-  rcl_ret_t rcl_ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
-  if (rcl_ret != RCL_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    result = RCL_RET_ERROR;
+  if (node->impl->graph_guard_condition) {
+    rcl_ret_t rcl_ret = rcl_guard_condition_fini(node->impl->graph_guard_condition);
+    if (rcl_ret != RCL_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      result = RCL_RET_ERROR;
+    }
+    allocator.deallocate(node->impl->graph_guard_condition, allocator.state);
   }
-  allocator.deallocate(node->impl->graph_guard_condition, allocator.state);
+  _rcl_node_pending_init_destroy(node->impl, &allocator);
   // assuming that allocate and deallocate are ok since they are checked in init
   allocator.deallocate((char *)node->impl->logger_name, allocator.state);
   if (NULL != node->impl->options.arguments.impl) {
@@ -504,12 +665,139 @@ rcl_node_fini(rcl_node_t * node)
       return ret;
     }
   }
+  rcl_remap_cache_destroy(node->impl->remap_cache);
+  rcl_graph_cache_destroy(node->impl->graph_cache);
+  // All of the node's entities must already be finalized, so the slab only
+  // holds released slots at this point.
+  rcl_entity_slab_destroy(node->impl->entity_slab);
+  if (rcutils_string_map_fini(&(node->impl->substitutions_map)) != RCUTILS_RET_OK) {
+    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+    result = RCL_RET_ERROR;
+  }
   allocator.deallocate(node->impl, allocator.state);
   node->impl = NULL;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Node finalized");
   return result;
 }
 
+rcl_remap_cache_t *
+rcl_node_get_remap_cache(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return NULL;  // error already set
+  }
+  return node->impl->remap_cache;
+}
+
+rcl_entity_slab_t *
+rcl_node_get_entity_slab(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return NULL;  // error already set
+  }
+  return node->impl->entity_slab;
+}
+
+rcl_graph_cache_t *
+rcl_node_get_graph_cache(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return NULL;  // error already set
+  }
+  return node->impl->graph_cache;
+}
+
+rcl_ret_t
+rcl_node_graph_cache_enable(rcl_node_t * node)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  if (NULL != node->impl->graph_cache) {
+    return RCL_RET_OK;
+  }
+  node->impl->graph_cache = rcl_graph_cache_create(&(node->impl->options.allocator));
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->graph_cache, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_node_graph_cache_mark_changed(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->graph_cache, "graph cache is not enabled on this node",
+    return RCL_RET_UNSUPPORTED);
+  rcl_graph_cache_mark_changed(node->impl->graph_cache);
+  // fire count change callbacks for watched topics whose count crossed zero
+  rcl_ret_t ret = rcl_graph_cache_refresh_count_watches(node->impl->graph_cache, node);
+  // trigger pending service availability notifications
+  rcl_ret_t watch_ret = rcl_graph_cache_refresh_service_watches(node->impl->graph_cache, node);
+  return RCL_RET_OK != ret ? ret : watch_ret;
+}
+
+rcl_ret_t
+rcl_node_graph_cache_set_publisher_count_callback(
+  const rcl_node_t * node,
+  const char * topic_name,
+  rcl_count_change_callback_t callback,
+  void * user_data)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->graph_cache, "graph cache is not enabled on this node",
+    return RCL_RET_UNSUPPORTED);
+  return rcl_graph_cache_set_count_callback(
+    node->impl->graph_cache, node, topic_name, false, callback, user_data);
+}
+
+rcl_ret_t
+rcl_node_graph_cache_set_subscriber_count_callback(
+  const rcl_node_t * node,
+  const char * topic_name,
+  rcl_count_change_callback_t callback,
+  void * user_data)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->graph_cache, "graph cache is not enabled on this node",
+    return RCL_RET_UNSUPPORTED);
+  return rcl_graph_cache_set_count_callback(
+    node->impl->graph_cache, node, topic_name, true, callback, user_data);
+}
+
+rcl_ret_t
+rcl_node_graph_cache_get_generation(const rcl_node_t * node, uint64_t * generation)
+{
+  if (!rcl_node_is_valid(node)) {
+    return RCL_RET_NODE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(generation, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    node->impl->graph_cache, "graph cache is not enabled on this node",
+    return RCL_RET_UNSUPPORTED);
+  *generation = rcl_graph_cache_generation(node->impl->graph_cache);
+  return RCL_RET_OK;
+}
+
+const rcutils_string_map_t *
+rcl_node_get_topic_name_substitutions(const rcl_node_t * node)
+{
+  if (!rcl_node_is_valid_except_context(node)) {
+    return NULL;  // error already set
+  }
+  return &(node->impl->substitutions_map);
+}
+
 bool
 rcl_node_is_valid_except_context(const rcl_node_t * node)
 {
@@ -563,6 +851,9 @@ rcl_node_options_copy(
   options_out->allocator = options->allocator;
   options_out->use_global_arguments = options->use_global_arguments;
   if (NULL != options->arguments.impl) {
+    // Shares the parsed arguments by reference count instead of deep-copying
+    // them, so copying options costs the same no matter how many rules were
+    // parsed.
     rcl_ret_t ret = rcl_arguments_copy(&(options->arguments), &(options_out->arguments));
     return ret;
   }
@@ -641,7 +932,17 @@ rcl_node_get_logger_name(const rcl_node_t * node)
   if (!rcl_node_is_valid_except_context(node)) {
     return NULL;  // error already set
   }
-  return node->impl->logger_name;
+  rcl_node_impl_t * impl = node->impl;
+  if (NULL == impl->logger_name) {
+    // built on first use and cached for the lifetime of the node
+    impl->logger_name = rcl_create_node_logger_name(
+      impl->rmw_node_handle->name,
+      impl->rmw_node_handle->namespace_,
+      &(impl->options.allocator));
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      impl->logger_name, "creating logger name failed", return NULL);
+  }
+  return impl->logger_name;
 }
 
 #ifdef __cplusplus
@@ -27,16 +27,39 @@ extern "C"
 #include "rcl/error_handling.h"
 #include "rcl/expand_topic_name.h"
 #include "rcl/remap.h"
+#include "rcl/tracepoints.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/types/uint8_array.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
+#include "./entity_registry.h"
+#include "./entity_statistics.h"
+#include "./entity_slab.h"
+#include "./event_impl.h"
+#include "./intra_process.h"
+#include "./reclaim.h"
+#include "./remap_cache.h"
+#include "./message_pool.h"
+
 typedef struct rcl_publisher_impl_t
 {
   rcl_publisher_options_t options;
   rcl_context_t * context;
   rmw_publisher_t * rmw_handle;
+  // Topic node in the context's intra-process registry, or NULL if the
+  // publisher did not opt into the intra-process fast path.
+  rcl_intra_process_topic_t * intra_process_topic;
+  // Type support the publisher was created with, for serializing messages.
+  const rosidl_message_type_support_t * type_support;
+  // Persistent serialization buffer, presized to max_serialized_size when
+  // the option is set; zero initialized and grown on demand otherwise.
+  rcl_serialized_message_t serialized_buffer;
+  // Preallocated message storage, zero initialized if not configured.
+  rcl_message_pool_t message_pool;
+  // Hot path counters, NULL unless statistics were enabled in the options.
+  rcl_entity_statistics_t * statistics;
 } rcl_publisher_impl_t;
 
 rcl_publisher_t
@@ -73,46 +96,43 @@ rcl_publisher_init(
   RCL_CHECK_ARGUMENT_FOR_NULL(topic_name, RCL_RET_INVALID_ARGUMENT);
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Initializing publisher for topic name '%s'", topic_name);
-  // Expand the given topic name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (rcutils_ret == RCUTILS_RET_BAD_ALLOC) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (ret == RCL_RET_BAD_ALLOC) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
+  // Expand the given topic name, using the node's cached substitutions map.
+  const rcutils_string_map_t * substitutions_map = rcl_node_get_topic_name_substitutions(node);
+  if (NULL == substitutions_map) {
+    return RCL_RET_NODE_INVALID;  // error already set
   }
+  char expanded_name_buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
   char * expanded_topic_name = NULL;
   char * remapped_topic_name = NULL;
-  ret = rcl_expand_topic_name(
+  // The fused expansion validates the expanded name in the same pass, so the
+  // separate rmw validation below only runs when remapping changed the name.
+  bool expanded_name_validated = false;
+  int validation_result = RMW_TOPIC_VALID;
+  rcl_ret_t ret = rcl_expand_and_validate_topic_name_with_buffer(
     topic_name,
     rcl_node_get_name(node),
     rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_topic_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
+    substitutions_map,
+    expanded_name_buffer,
+    sizeof(expanded_name_buffer),
+    &validation_result);
+  if (RCL_RET_OK == ret) {
+    if (RMW_TOPIC_VALID != validation_result) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      return RCL_RET_TOPIC_NAME_INVALID;
+    }
+    expanded_topic_name = expanded_name_buffer;
+    expanded_name_validated = true;
+  } else if (RCL_RET_BUFFER_TOO_SMALL == ret) {
+    // unusually long name, fall back to the allocating expansion
+    rcl_reset_error();
+    ret = rcl_expand_topic_name(
+      topic_name,
+      rcl_node_get_name(node),
+      rcl_node_get_namespace(node),
+      substitutions_map,
+      *allocator,
+      &expanded_topic_name);
   }
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
@@ -133,34 +153,58 @@ rcl_publisher_init(
   if (node_options->use_global_arguments) {
     global_args = &(node->context->global_arguments);
   }
-  ret = rcl_remap_topic_name(
-    &(node_options->arguments), global_args, expanded_topic_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_topic_name) {
+  rcl_remap_cache_t * remap_cache = rcl_node_get_remap_cache(node);
+  bool remap_cache_hit = false;
+  if (NULL != remap_cache) {
+    ret = rcl_remap_cache_lookup(
+      remap_cache, RCL_TOPIC_REMAP, expanded_topic_name, *allocator,
+      &remap_cache_hit, &remapped_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+  }
+  if (!remap_cache_hit) {
+    ret = rcl_remap_topic_name(
+      &(node_options->arguments), global_args, expanded_topic_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+    rcl_remap_cache_store(remap_cache, RCL_TOPIC_REMAP, expanded_topic_name, remapped_topic_name);
+  }
+  // A remap rule produced a new name which still needs validating; without
+  // one the expanded name is used, already validated unless the expansion
+  // fell back to the allocating path.
+  bool needs_validation = (NULL != remapped_topic_name) || !expanded_name_validated;
+  if (NULL == remapped_topic_name) {
     remapped_topic_name = expanded_topic_name;
     expanded_topic_name = NULL;
   }
 
   // Validate the expanded topic name.
-  int validation_result;
-  rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_topic_name, &validation_result, NULL);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (validation_result != RMW_TOPIC_VALID) {
-    RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
-    ret = RCL_RET_TOPIC_NAME_INVALID;
-    goto cleanup;
+  if (needs_validation) {
+    rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_topic_name, &validation_result, NULL);
+    if (rmw_ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = RCL_RET_ERROR;
+      goto cleanup;
+    }
+    if (validation_result != RMW_TOPIC_VALID) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      ret = RCL_RET_TOPIC_NAME_INVALID;
+      goto cleanup;
+    }
   }
-  // Allocate space for the implementation struct.
-  publisher->impl = (rcl_publisher_impl_t *)allocator->allocate(
-    sizeof(rcl_publisher_impl_t), allocator->state);
+  // Allocate space for the implementation struct, from the node's slab so
+  // the node's entity impls sit contiguously.
+  publisher->impl = (rcl_publisher_impl_t *)rcl_node_allocate_entity_impl(
+    node, allocator, sizeof(rcl_publisher_impl_t));
   RCL_CHECK_FOR_NULL_WITH_MSG(
     publisher->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  // Zero the serialization buffer and message pool first so the fail path
+  // can always inspect them safely.
+  publisher->impl->serialized_buffer = rcutils_get_zero_initialized_uint8_array();
+  publisher->impl->message_pool = rcl_get_zero_initialized_message_pool();
   // Fill out implementation struct.
   // rmw handle (create rmw publisher)
   // TODO(wjwwood): pass along the allocator to rmw when it supports it
@@ -173,28 +217,110 @@ rcl_publisher_init(
     rmw_get_error_string().str, goto fail);
   // options
   publisher->impl->options = *options;
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher initialized");
   // context
   publisher->impl->context = node->context;
+  // intra-process fast path, matched by the expanded and remapped name
+  publisher->impl->intra_process_topic = NULL;
+  // persistent serialization buffer
+  publisher->impl->type_support = type_support;
+  if (options->max_serialized_size > 0) {
+    rcutils_ret_t buffer_ret = rcutils_uint8_array_init(
+      &publisher->impl->serialized_buffer, options->max_serialized_size, allocator);
+    if (RCUTILS_RET_OK != buffer_ret) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (RMW_RET_OK != rmw_destroy_publisher(
+          rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw publisher: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // preallocated message pool
+  if (options->message_pool_size > 0) {
+    ret = rcl_message_pool_init(
+      &publisher->impl->message_pool,
+      options->message_pool_size,
+      options->message_pool_message_bound,
+      *allocator);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      if (RMW_RET_OK != rmw_destroy_publisher(
+          rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw publisher: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  if (options->use_intra_process) {
+    ret = rcl_intra_process_register_publisher(
+      node->context, remapped_topic_name, &publisher->impl->intra_process_topic);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      if (RMW_RET_OK != rmw_destroy_publisher(
+          rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw publisher: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // hot path statistics
+  publisher->impl->statistics = NULL;
+  if (options->enable_statistics) {
+    publisher->impl->statistics = rcl_entity_statistics_create(allocator, options->single_threaded);
+    if (!publisher->impl->statistics) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (RMW_RET_OK != rmw_destroy_publisher(
+          rcl_node_get_rmw_handle(node), publisher->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw publisher: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // record for bulk teardown by rcl_context_fini_all_entities()
+  rcl_context_track_entity(node->context, RCL_TRACKED_PUBLISHER, publisher, node);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher initialized");
+  RCL_TRACEPOINT_REGISTER("rcl_publisher_init", publisher->impl, remapped_topic_name);
   goto cleanup;
 fail:
   if (publisher->impl) {
-    allocator->deallocate(publisher->impl, allocator->state);
+    if (publisher->impl->message_pool.storage) {
+      if (RCL_RET_OK != rcl_message_pool_fini(&publisher->impl->message_pool)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini message pool");
+      }
+    }
+    if (publisher->impl->serialized_buffer.buffer) {
+      if (RCUTILS_RET_OK != rcutils_uint8_array_fini(&publisher->impl->serialized_buffer)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini serialization buffer");
+      }
+    }
+    rcl_node_deallocate_entity_impl(node, allocator, publisher->impl);
   }
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_topic_name) {
+  if (NULL != expanded_topic_name && expanded_name_buffer != expanded_topic_name) {
     allocator->deallocate(expanded_topic_name, allocator->state);
   }
-  if (NULL != remapped_topic_name) {
+  if (NULL != remapped_topic_name && expanded_name_buffer != remapped_topic_name) {
     allocator->deallocate(remapped_topic_name, allocator->state);
   }
   return ret;
 }
 
-rcl_ret_t
-rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node)
+static rcl_ret_t
+__rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node, bool deferred)
 {
   rcl_ret_t result = RCL_RET_OK;
   RCL_CHECK_ARGUMENT_FOR_NULL(publisher, RCL_RET_PUBLISHER_INVALID);
@@ -209,18 +335,56 @@ rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
-    rmw_ret_t ret =
-      rmw_destroy_publisher(rmw_node, publisher->impl->rmw_handle);
-    if (ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-      result = RCL_RET_ERROR;
+    rcl_context_untrack_entity(node->context, publisher);
+    if (publisher->impl->message_pool.storage) {
+      rcl_ret_t pool_ret = rcl_message_pool_fini(&publisher->impl->message_pool);
+      if (RCL_RET_OK != pool_ret) {
+        result = RCL_RET_ERROR;
+      }
+    }
+    if (publisher->impl->serialized_buffer.buffer) {
+      if (RCUTILS_RET_OK != rcutils_uint8_array_fini(&publisher->impl->serialized_buffer)) {
+        result = RCL_RET_ERROR;
+      }
     }
-    allocator.deallocate(publisher->impl, allocator.state);
+    rcl_entity_statistics_destroy(publisher->impl->statistics, &allocator);
+    bool destroy_inline = true;
+    if (deferred) {
+      rcl_ret_t defer_ret = rcl_context_defer_rmw_destroy(
+        node->context, RCL_RECLAIM_PUBLISHER, rmw_node, publisher->impl->rmw_handle);
+      if (RCL_RET_OK == defer_ret) {
+        destroy_inline = false;
+      } else {
+        // Queueing failed; destroy synchronously rather than leaking.
+        rcl_reset_error();
+      }
+    }
+    if (destroy_inline) {
+      rmw_ret_t ret =
+        rmw_destroy_publisher(rmw_node, publisher->impl->rmw_handle);
+      if (ret != RMW_RET_OK) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+    }
+    rcl_node_deallocate_entity_impl(node, &allocator, publisher->impl);
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Publisher finalized");
   return result;
 }
 
+rcl_ret_t
+rcl_publisher_fini(rcl_publisher_t * publisher, rcl_node_t * node)
+{
+  return __rcl_publisher_fini(publisher, node, false);
+}
+
+rcl_ret_t
+rcl_publisher_fini_deferred(rcl_publisher_t * publisher, rcl_node_t * node)
+{
+  return __rcl_publisher_fini(publisher, node, true);
+}
+
 rcl_publisher_options_t
 rcl_publisher_get_default_options()
 {
@@ -229,20 +393,167 @@ rcl_publisher_get_default_options()
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_default;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.use_intra_process = false;
+  default_options.message_pool_size = 0;
+  default_options.message_pool_message_bound = 0;
+  default_options.enable_statistics = false;
+  default_options.max_serialized_size = 0;
+  default_options.single_threaded = false;
   return default_options;
 }
 
 rcl_ret_t
 rcl_publish(const rcl_publisher_t * publisher, const void * ros_message)
 {
-  if (!rcl_publisher_is_valid(publisher)) {
-    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  RCL_HOT_CHECK_FOR_VALID(rcl_publisher_is_valid(publisher), RCL_RET_PUBLISHER_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_TRACEPOINT("rcl_publish_begin", publisher->impl);
+  if (publisher->impl->intra_process_topic) {
+    // Deliver to same-process subscriptions without crossing into rmw;
+    // the middleware publish below still serves everyone else.
+    rcl_ret_t ret = rcl_intra_process_publish(publisher->impl->intra_process_topic, ros_message);
+    if (RCL_RET_OK != ret) {
+      return ret;  // The rcl error state should already be set.
+    }
   }
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
   if (rmw_publish(publisher->impl->rmw_handle, ros_message) != RMW_RET_OK) {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    rcl_entity_statistics_record_failed(publisher->impl->statistics);
     return RCL_RET_ERROR;
   }
+  rcl_entity_statistics_record_succeeded(publisher->impl->statistics, 1);
+  RCL_TRACEPOINT("rcl_publish_end", publisher->impl);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_batch(
+  const rcl_publisher_t * publisher, const void ** ros_messages, size_t count)
+{
+  RCL_HOT_CHECK_FOR_VALID(rcl_publisher_is_valid(publisher), RCL_RET_PUBLISHER_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_messages, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < count; ++i) {
+    RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_messages[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  // The rmw interface has no batch publish; hand the messages over one by
+  // one, having paid the validation cost above only once for the batch.
+  for (size_t i = 0; i < count; ++i) {
+    if (rmw_publish(publisher->impl->rmw_handle, ros_messages[i]) != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      rcl_entity_statistics_record_failed(publisher->impl->statistics);
+      rcl_entity_statistics_record_succeeded(publisher->impl->statistics, i);
+      return RCL_RET_ERROR;
+    }
+  }
+  rcl_entity_statistics_record_succeeded(publisher->impl->statistics, count);
+  return RCL_RET_OK;
+}
+
+typedef struct rcl_publisher_bundle_impl_t
+{
+  /// The member publisher handles, in publish order; not owned.
+  const rcl_publisher_t ** publishers;
+  size_t number_of_publishers;
+  rcl_allocator_t allocator;
+} rcl_publisher_bundle_impl_t;
+
+rcl_publisher_bundle_t
+rcl_get_zero_initialized_publisher_bundle()
+{
+  static rcl_publisher_bundle_t null_publisher_bundle = {0};
+  return null_publisher_bundle;
+}
+
+rcl_ret_t
+rcl_publisher_bundle_init(
+  rcl_publisher_bundle_t * publisher_bundle,
+  const rcl_publisher_t ** publishers,
+  size_t number_of_publishers,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher_bundle, RCL_RET_INVALID_ARGUMENT);
+  if (publisher_bundle->impl) {
+    RCL_SET_ERROR_MSG("publisher bundle already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(publishers, RCL_RET_INVALID_ARGUMENT);
+  if (0 == number_of_publishers) {
+    RCL_SET_ERROR_MSG("publisher bundle needs at least one publisher");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  // Validate every member here, once, so publishing can skip it.
+  for (size_t i = 0; i < number_of_publishers; ++i) {
+    if (!rcl_publisher_is_valid(publishers[i])) {
+      return RCL_RET_PUBLISHER_INVALID;  // error already set
+    }
+  }
+  rcl_publisher_bundle_impl_t * impl =
+    (rcl_publisher_bundle_impl_t *)allocator->zero_allocate(
+    1, sizeof(rcl_publisher_bundle_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->publishers = (const rcl_publisher_t **)allocator->allocate(
+    sizeof(const rcl_publisher_t *) * number_of_publishers, allocator->state);
+  if (NULL == impl->publishers) {
+    allocator->deallocate(impl, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  memcpy(
+    (void *)impl->publishers, (const void *)publishers,
+    sizeof(const rcl_publisher_t *) * number_of_publishers);
+  impl->number_of_publishers = number_of_publishers;
+  impl->allocator = *allocator;
+  publisher_bundle->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_bundle_fini(rcl_publisher_bundle_t * publisher_bundle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher_bundle, RCL_RET_INVALID_ARGUMENT);
+  if (NULL == publisher_bundle->impl) {
+    return RCL_RET_OK;
+  }
+  rcl_allocator_t allocator = publisher_bundle->impl->allocator;
+  allocator.deallocate((void *)publisher_bundle->impl->publishers, allocator.state);
+  allocator.deallocate(publisher_bundle->impl, allocator.state);
+  publisher_bundle->impl = NULL;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publish_bundle(
+  const rcl_publisher_bundle_t * publisher_bundle, const void ** ros_messages)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(publisher_bundle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    publisher_bundle->impl, "publisher bundle is invalid",
+    return RCL_RET_PUBLISHER_INVALID);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_messages, RCL_RET_INVALID_ARGUMENT);
+  const rcl_publisher_bundle_impl_t * impl = publisher_bundle->impl;
+  for (size_t i = 0; i < impl->number_of_publishers; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_messages[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  // The members were validated when the bundle was built, so this is the
+  // same per-message work as rcl_publish() minus the validation.
+  for (size_t i = 0; i < impl->number_of_publishers; ++i) {
+    const rcl_publisher_t * publisher = impl->publishers[i];
+    if (publisher->impl->intra_process_topic) {
+      rcl_ret_t ret =
+        rcl_intra_process_publish(publisher->impl->intra_process_topic, ros_messages[i]);
+      if (RCL_RET_OK != ret) {
+        return ret;  // The rcl error state should already be set.
+      }
+    }
+    if (rmw_publish(publisher->impl->rmw_handle, ros_messages[i]) != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      rcl_entity_statistics_record_failed(publisher->impl->statistics);
+      return RCL_RET_ERROR;
+    }
+    rcl_entity_statistics_record_succeeded(publisher->impl->statistics, 1);
+  }
   return RCL_RET_OK;
 }
 
@@ -265,6 +576,195 @@ rcl_publish_serialized_message(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_publish_serialized_message_fragments(
+  const rcl_publisher_t * publisher,
+  const rcl_serialized_message_fragment_t * fragments,
+  size_t fragment_count)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(fragments, RCL_RET_INVALID_ARGUMENT);
+  if (0 == fragment_count) {
+    RCL_SET_ERROR_MSG("fragment count is zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  size_t total_length = 0;
+  for (size_t i = 0; i < fragment_count; ++i) {
+    if (NULL == fragments[i].data && fragments[i].length > 0) {
+      RCL_SET_ERROR_MSG("fragment has NULL data but non-zero length");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+    total_length += fragments[i].length;
+  }
+  if (1 == fragment_count) {
+    // publish straight out of the caller's memory: rmw only reads the
+    // serialized message, so aliasing a read-only mapping is fine and the
+    // const cast never leads to a write
+    rcl_serialized_message_t view = rcutils_get_zero_initialized_uint8_array();
+    view.buffer = (uint8_t *)fragments[0].data;
+    view.buffer_length = fragments[0].length;
+    view.buffer_capacity = fragments[0].length;
+    return rcl_publish_serialized_message(publisher, &view);
+  }
+  // gather into the persistent buffer; with max_serialized_size sized to the
+  // largest record this never allocates
+  rcl_serialized_message_t * buffer = &publisher->impl->serialized_buffer;
+  if (buffer->buffer_capacity < total_length) {
+    rcutils_ret_t rcutils_ret;
+    if (NULL == buffer->buffer) {
+      rcl_allocator_t allocator = publisher->impl->options.allocator;
+      rcutils_ret = rcutils_uint8_array_init(buffer, total_length, &allocator);
+    } else {
+      rcutils_ret = rcutils_uint8_array_resize(buffer, total_length);
+    }
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  size_t offset = 0;
+  for (size_t i = 0; i < fragment_count; ++i) {
+    memcpy(buffer->buffer + offset, fragments[i].data, fragments[i].length);
+    offset += fragments[i].length;
+  }
+  buffer->buffer_length = total_length;
+  return rcl_publish_serialized_message(publisher, buffer);
+}
+
+rcl_ret_t
+rcl_publish_as_serialized_message(
+  const rcl_publisher_t * publisher, const void * ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  // Serialize into the persistent buffer; with max_serialized_size set the
+  // capacity was carved out at init and this never allocates.
+  rmw_ret_t ret = rmw_serialize(
+    ros_message, publisher->impl->type_support, &publisher->impl->serialized_buffer);
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  return rcl_publish_serialized_message(publisher, &publisher->impl->serialized_buffer);
+}
+
+rcl_ret_t
+rcl_borrow_loaned_message(
+  const rcl_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(type_support, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  // The rmw interface in use has no message loaning entry points yet; see
+  // rcl_publisher_can_loan_messages().
+  RCL_SET_ERROR_MSG("message loaning is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_return_loaned_message_from_publisher(
+  const rcl_publisher_t * publisher,
+  void * loaned_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_SET_ERROR_MSG("message loaning is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_publish_loaned_message(
+  const rcl_publisher_t * publisher,
+  void * ros_message)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_SET_ERROR_MSG("message loaning is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+bool
+rcl_publisher_can_loan_messages(const rcl_publisher_t * publisher)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return false;  // error already set
+  }
+  // Becomes rmw implementation defined once rmw gains loaning entry points.
+  return false;
+}
+
+rcl_ret_t
+rcl_publisher_acquire_pool_message(
+  const rcl_publisher_t * publisher,
+  void ** message_storage)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_storage, RCL_RET_INVALID_ARGUMENT);
+  if (!publisher->impl->message_pool.storage) {
+    RCL_SET_ERROR_MSG("publisher has no message pool configured");
+    return RCL_RET_UNSUPPORTED;
+  }
+  void * storage = rcl_message_pool_acquire(&publisher->impl->message_pool);
+  if (!storage) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  *message_storage = storage;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_release_pool_message(
+  const rcl_publisher_t * publisher,
+  void * message_storage)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_storage, RCL_RET_INVALID_ARGUMENT);
+  if (!publisher->impl->message_pool.storage) {
+    RCL_SET_ERROR_MSG("publisher has no message pool configured");
+    return RCL_RET_UNSUPPORTED;
+  }
+  return rcl_message_pool_release(&publisher->impl->message_pool, message_storage);
+}
+
+rcl_ret_t
+rcl_publisher_get_statistics(
+  const rcl_publisher_t * publisher,
+  rcl_statistics_t * statistics)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  if (!publisher->impl->statistics) {
+    RCL_SET_ERROR_MSG("publisher does not keep statistics");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_entity_statistics_snapshot(publisher->impl->statistics, statistics);
+  return RCL_RET_OK;
+}
+
+rcl_entity_statistics_t *
+rcl_publisher_get_statistics_block(const rcl_publisher_t * publisher)
+{
+  return publisher->impl->statistics;
+}
+
 const char *
 rcl_publisher_get_topic_name(const rcl_publisher_t * publisher)
 {
@@ -349,6 +849,73 @@ rcl_publisher_get_subscription_count(
   return RCL_RET_OK;
 }
 
+// Determine whether every published message is already trivially acknowledged:
+// under best effort reliability no acknowledgments exist, and with no matched
+// subscriptions there is nobody left to acknowledge.
+static rcl_ret_t
+__rcl_publisher_all_acked_trivially(const rcl_publisher_t * publisher, bool * all_acked)
+{
+  if (RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT == publisher->impl->options.qos.reliability) {
+    *all_acked = true;
+    return RCL_RET_OK;
+  }
+  size_t subscription_count = 0;
+  rmw_ret_t ret = rmw_publisher_count_matched_subscriptions(
+    publisher->impl->rmw_handle, &subscription_count);
+  if (ret != RMW_RET_OK) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return rcl_convert_rmw_ret_to_rcl_ret(ret);
+  }
+  *all_acked = (0 == subscription_count);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_publisher_wait_for_all_acked(
+  const rcl_publisher_t * publisher,
+  int64_t timeout)
+{
+  (void)timeout;  // only used once the rmw interface can observe acknowledgments
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  bool all_acked = false;
+  rcl_ret_t ret = __rcl_publisher_all_acked_trivially(publisher, &all_acked);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (all_acked) {
+    return RCL_RET_OK;
+  }
+  // The rmw interface in use has no entry point for observing
+  // acknowledgments; see the header doc.
+  RCL_SET_ERROR_MSG(
+    "waiting for acknowledgments is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_publisher_notify_on_all_acked(
+  const rcl_publisher_t * publisher,
+  rcl_guard_condition_t * guard_condition)
+{
+  if (!rcl_publisher_is_valid(publisher)) {
+    return RCL_RET_PUBLISHER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(guard_condition, RCL_RET_INVALID_ARGUMENT);
+  bool all_acked = false;
+  rcl_ret_t ret = __rcl_publisher_all_acked_trivially(publisher, &all_acked);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (all_acked) {
+    return rcl_trigger_guard_condition(guard_condition);
+  }
+  RCL_SET_ERROR_MSG(
+    "waiting for acknowledgments is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
 #ifdef __cplusplus
 }
 #endif
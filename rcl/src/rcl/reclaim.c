@@ -0,0 +1,180 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./reclaim.h"
+
+#include "rcl/error_handling.h"
+#include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
+#include "rmw/error_handling.h"
+
+#include "./context_impl.h"
+
+// One parked rmw handle.
+typedef struct rcl_reclaim_entry_t
+{
+  rcl_reclaim_kind_t kind;
+  rmw_node_t * rmw_node;
+  void * rmw_handle;
+  struct rcl_reclaim_entry_t * next;
+} rcl_reclaim_entry_t;
+
+typedef struct rcl_reclaim_queue_t
+{
+  /// Head of a lock-free stack of entries; deferring pushes with a
+  /// compare-and-swap loop, draining detaches the whole stack with one
+  /// exchange, so the two sides never block each other.
+  atomic_uintptr_t head;
+  rcl_allocator_t allocator;
+} rcl_reclaim_queue_t;
+
+// Get the context's queue, creating it on first use; returns NULL and sets
+// an error message on failure.
+static rcl_reclaim_queue_t *
+__get_reclaim_queue(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(context->impl, "context is invalid", return NULL);
+  if (!context->impl->reclaim_queue) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_reclaim_queue_t * queue = (rcl_reclaim_queue_t *)allocator.zero_allocate(
+      1, sizeof(rcl_reclaim_queue_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(queue, "allocating memory failed", return NULL);
+    atomic_init(&queue->head, (uintptr_t)NULL);
+    queue->allocator = allocator;
+    context->impl->reclaim_queue = queue;
+  }
+  return context->impl->reclaim_queue;
+}
+
+rcl_ret_t
+rcl_context_defer_rmw_destroy(
+  rcl_context_t * context,
+  rcl_reclaim_kind_t kind,
+  rmw_node_t * rmw_node,
+  void * rmw_handle)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rmw_node, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(rmw_handle, RCL_RET_INVALID_ARGUMENT);
+  rcl_reclaim_queue_t * queue = __get_reclaim_queue(context);
+  if (!queue) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  rcl_reclaim_entry_t * entry = (rcl_reclaim_entry_t *)queue->allocator.allocate(
+    sizeof(rcl_reclaim_entry_t), queue->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->kind = kind;
+  entry->rmw_node = rmw_node;
+  entry->rmw_handle = rmw_handle;
+  uintptr_t expected;
+  bool exchanged = false;
+  do {
+    rcutils_atomic_load(&queue->head, expected);
+    entry->next = (rcl_reclaim_entry_t *)expected;
+    rcutils_atomic_compare_exchange_strong(
+      &queue->head, exchanged, &expected, (uintptr_t)entry);
+  } while (!exchanged);
+  return RCL_RET_OK;
+}
+
+// Destroy one parked handle; returns RCL_RET_ERROR with the error set on
+// middleware failure.
+static rcl_ret_t
+__reclaim_entry(rcl_reclaim_entry_t * entry)
+{
+  rmw_ret_t ret = RMW_RET_OK;
+  switch (entry->kind) {
+    case RCL_RECLAIM_PUBLISHER:
+      ret = rmw_destroy_publisher(entry->rmw_node, (rmw_publisher_t *)entry->rmw_handle);
+      break;
+    case RCL_RECLAIM_SUBSCRIPTION:
+      ret = rmw_destroy_subscription(entry->rmw_node, (rmw_subscription_t *)entry->rmw_handle);
+      break;
+    case RCL_RECLAIM_SERVICE:
+      ret = rmw_destroy_service(entry->rmw_node, (rmw_service_t *)entry->rmw_handle);
+      break;
+  }
+  if (RMW_RET_OK != ret) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_context_reclaim(rcl_context_t * context, size_t * number_reclaimed)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is invalid", return RCL_RET_INVALID_ARGUMENT);
+  if (number_reclaimed) {
+    *number_reclaimed = 0;
+  }
+  rcl_reclaim_queue_t * queue = context->impl->reclaim_queue;
+  if (!queue) {
+    // Nothing was ever deferred.
+    return RCL_RET_OK;
+  }
+  uintptr_t head;
+  rcutils_atomic_exchange(&queue->head, head, (uintptr_t)NULL);
+  rcl_reclaim_entry_t * entry = (rcl_reclaim_entry_t *)head;
+  rcl_ret_t result = RCL_RET_OK;
+  while (entry) {
+    rcl_reclaim_entry_t * next = entry->next;
+    if (RCL_RET_OK != __reclaim_entry(entry)) {
+      result = RCL_RET_ERROR;  // error already set, keep draining
+    }
+    queue->allocator.deallocate(entry, queue->allocator.state);
+    if (number_reclaimed) {
+      ++(*number_reclaimed);
+    }
+    entry = next;
+  }
+  return result;
+}
+
+void
+rcl_reclaim_queue_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->reclaim_queue) {
+    return;
+  }
+  size_t number_reclaimed = 0;
+  rcl_ret_t ret = rcl_context_reclaim(context, &number_reclaimed);
+  if (RCL_RET_OK != ret) {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to reclaim deferred rmw handles: %s",
+      rcl_get_error_string().str);
+    rcl_reset_error();
+  }
+  if (number_reclaimed > 0) {
+    RCUTILS_LOG_DEBUG_NAMED(
+      ROS_PACKAGE_NAME, "reclaimed %zu deferred rmw handles during context cleanup",
+      number_reclaimed);
+  }
+  rcl_reclaim_queue_t * queue = context->impl->reclaim_queue;
+  rcl_allocator_t allocator = queue->allocator;
+  allocator.deallocate(queue, allocator.state);
+  context->impl->reclaim_queue = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__RECLAIM_H_
+#define RCL__RECLAIM_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+#include "rmw/rmw.h"
+
+// Internal queue of rmw handles awaiting destruction, hung off the context.
+//
+// The rmw destroy functions can block on middleware locks, so the deferred
+// fini variants (rcl_publisher_fini_deferred() and friends) unlink their
+// entity, free the rcl-side state, and park the rmw handle here instead of
+// destroying it inline.  A thread of the application's choosing drains the
+// queue with rcl_context_reclaim(), declared in rcl/context.h.
+//
+// The queue is a lock-free stack: deferring and draining may race with each
+// other, though each side supports only one concurrent caller.
+
+struct rcl_reclaim_queue_t;
+
+/// Kinds of rmw handles the reclamation queue knows how to destroy.
+typedef enum rcl_reclaim_kind_t
+{
+  RCL_RECLAIM_PUBLISHER,
+  RCL_RECLAIM_SUBSCRIPTION,
+  RCL_RECLAIM_SERVICE,
+} rcl_reclaim_kind_t;
+
+/// Queue an rmw handle for destruction by a later rcl_context_reclaim().
+/**
+ * Creates the context's reclamation queue on first use.
+ * The rmw node the handle was created from must stay valid until the handle
+ * is reclaimed.
+ *
+ * \return `RCL_RET_OK` if the handle was queued, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating the queue entry failed.
+ */
+rcl_ret_t
+rcl_context_defer_rmw_destroy(
+  rcl_context_t * context,
+  rcl_reclaim_kind_t kind,
+  rmw_node_t * rmw_node,
+  void * rmw_handle);
+
+/// Drain and free the context's reclamation queue if it was created.
+void
+rcl_reclaim_queue_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__RECLAIM_H_
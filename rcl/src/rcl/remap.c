@@ -14,6 +14,8 @@
 
 #include "rcl/remap.h"
 
+#include <string.h>
+
 #include "./arguments_impl.h"
 #include "./remap_impl.h"
 #include "rcl/error_handling.h"
@@ -35,6 +37,8 @@ rcl_remap_get_zero_initialized()
   rule.node_name = NULL;
   rule.match = NULL;
   rule.replacement = NULL;
+  rule.compiled_match = NULL;
+  rule.compiled_replacement = NULL;
   rule.allocator = rcutils_get_zero_initialized_allocator();
   return rule;
 }
@@ -42,12 +46,12 @@ rcl_remap_get_zero_initialized()
 rcl_ret_t
 rcl_remap_copy(
   const rcl_remap_t * rule,
-  rcl_remap_t * rule_out)
+  rcl_remap_t * rule_out,
+  rcl_allocator_t allocator)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(rule, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(rule_out, RCL_RET_INVALID_ARGUMENT);
 
-  rcl_allocator_t allocator = rule->allocator;
   rule_out->allocator = allocator;
   rule_out->type = rule->type;
   if (NULL != rule->node_name) {
@@ -68,6 +72,18 @@ rcl_remap_copy(
       goto fail;
     }
   }
+  if (NULL != rule->compiled_match) {
+    rule_out->compiled_match = rcutils_strdup(rule->compiled_match, allocator);
+    if (NULL == rule_out->compiled_match) {
+      goto fail;
+    }
+  }
+  if (NULL != rule->compiled_replacement) {
+    rule_out->compiled_replacement = rcutils_strdup(rule->compiled_replacement, allocator);
+    if (NULL == rule_out->compiled_replacement) {
+      goto fail;
+    }
+  }
   return RCL_RET_OK;
 fail:
   if (RCL_RET_OK != rcl_remap_fini(rule_out)) {
@@ -92,17 +108,192 @@ rcl_remap_fini(
     rule->allocator.deallocate(rule->replacement, rule->allocator.state);
     rule->replacement = NULL;
   }
+  if (NULL != rule->compiled_match) {
+    rule->allocator.deallocate(rule->compiled_match, rule->allocator.state);
+    rule->compiled_match = NULL;
+  }
+  if (NULL != rule->compiled_replacement) {
+    rule->allocator.deallocate(rule->compiled_replacement, rule->allocator.state);
+    rule->compiled_replacement = NULL;
+  }
   rule->allocator = rcutils_get_zero_initialized_allocator();
   return RCL_RET_OK;
 }
 
-/// Get the first matching rule in a chain.
+/// Return true if a name expands to itself for every node.
+/**
+ * That is the case for fully qualified names that use neither the private
+ * namespace substitution nor a curly brace substitution.
+ */
+static bool
+_rcl_remap_name_is_static(const char * name)
+{
+  if ('/' != name[0]) {
+    return false;
+  }
+  return NULL == strchr(name, '~') && NULL == strchr(name, '{');
+}
+
+rcl_ret_t
+rcl_remap_compile(
+  rcl_remap_t * rule)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(rule, RCL_RET_INVALID_ARGUMENT);
+  if (!(rule->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP))) {
+    // Node name and namespace rules are not expanded at lookup time.
+    return RCL_RET_OK;
+  }
+  if (NULL != rule->match && _rcl_remap_name_is_static(rule->match)) {
+    rule->compiled_match = rcutils_strdup(rule->match, rule->allocator);
+    if (NULL == rule->compiled_match) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  if (NULL != rule->replacement && _rcl_remap_name_is_static(rule->replacement)) {
+    rule->compiled_replacement = rcutils_strdup(rule->replacement, rule->allocator);
+    if (NULL == rule->compiled_replacement) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+// One bucket chain entry of the rule index.
+typedef struct rcl_remap_index_entry_t
+{
+  const rcl_remap_t * rule;
+  // Position of the rule in the parsed rule array, for first-match ordering.
+  int position;
+  struct rcl_remap_index_entry_t * next;
+} rcl_remap_index_entry_t;
+
+struct rcl_remap_index_t
+{
+  rcl_remap_index_entry_t ** buckets;
+  size_t num_buckets;
+  rcl_allocator_t allocator;
+};
+
+/// djb2 string hash, reduced modulo the bucket count.
+static size_t
+_rcl_remap_index_bucket_of(const rcl_remap_index_t * index, const char * name)
+{
+  size_t hash = 5381;
+  for (const char * c = name; '\0' != *c; ++c) {
+    hash = hash * 33 + (size_t)(unsigned char)*c;
+  }
+  return hash % index->num_buckets;
+}
+
+rcl_ret_t
+rcl_remap_index_init(
+  rcl_remap_index_t ** index,
+  const rcl_remap_t * rules,
+  int num_rules,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(index, RCL_RET_INVALID_ARGUMENT);
+  rcl_remap_index_t * new_index = (rcl_remap_index_t *)allocator.zero_allocate(
+    1, sizeof(rcl_remap_index_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(new_index, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  new_index->allocator = allocator;
+  // Size for a low load factor; rule counts are known and small enough that
+  // doubling the bucket count is cheaper than ever chaining deeply.
+  new_index->num_buckets = 16;
+  while (new_index->num_buckets < 2 * (size_t)num_rules) {
+    new_index->num_buckets *= 2;
+  }
+  new_index->buckets = (rcl_remap_index_entry_t **)allocator.zero_allocate(
+    new_index->num_buckets, sizeof(rcl_remap_index_entry_t *), allocator.state);
+  if (NULL == new_index->buckets) {
+    allocator.deallocate(new_index, allocator.state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (int i = 0; i < num_rules; ++i) {
+    if (NULL == rules[i].compiled_match) {
+      continue;
+    }
+    rcl_remap_index_entry_t * entry = (rcl_remap_index_entry_t *)allocator.allocate(
+      sizeof(rcl_remap_index_entry_t), allocator.state);
+    if (NULL == entry) {
+      rcl_remap_index_fini(new_index);
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      return RCL_RET_BAD_ALLOC;
+    }
+    size_t bucket = _rcl_remap_index_bucket_of(new_index, rules[i].compiled_match);
+    entry->rule = &rules[i];
+    entry->position = i;
+    entry->next = new_index->buckets[bucket];
+    new_index->buckets[bucket] = entry;
+  }
+  *index = new_index;
+  return RCL_RET_OK;
+}
+
+void
+rcl_remap_index_fini(
+  rcl_remap_index_t * index)
+{
+  if (NULL == index) {
+    return;
+  }
+  rcl_allocator_t allocator = index->allocator;
+  for (size_t i = 0; i < index->num_buckets; ++i) {
+    rcl_remap_index_entry_t * entry = index->buckets[i];
+    while (NULL != entry) {
+      rcl_remap_index_entry_t * next = entry->next;
+      allocator.deallocate(entry, allocator.state);
+      entry = next;
+    }
+  }
+  allocator.deallocate(index->buckets, allocator.state);
+  allocator.deallocate(index, allocator.state);
+}
+
+const rcl_remap_t *
+rcl_remap_index_lookup(
+  const rcl_remap_index_t * index,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name,
+  int * rule_position)
+{
+  const rcl_remap_t * best_rule = NULL;
+  int best_position = -1;
+  size_t bucket = _rcl_remap_index_bucket_of(index, name);
+  for (
+    const rcl_remap_index_entry_t * entry = index->buckets[bucket];
+    NULL != entry;
+    entry = entry->next)
+  {
+    const rcl_remap_t * rule = entry->rule;
+    if (!(rule->type & type_bitmask)) {
+      continue;
+    }
+    if (rule->node_name != NULL && 0 != strcmp(rule->node_name, node_name)) {
+      continue;
+    }
+    if (0 != strcmp(rule->compiled_match, name)) {
+      continue;
+    }
+    if (NULL == best_rule || entry->position < best_position) {
+      best_rule = rule;
+      best_position = entry->position;
+    }
+  }
+  *rule_position = best_position;
+  return best_rule;
+}
+
+/// Get the first matching rule in an arguments instance.
 /// \return RCL_RET_OK if no errors occurred while searching for a rule
 RCL_LOCAL
 rcl_ret_t
 _rcl_remap_first_match(
-  rcl_remap_t * remap_rules,
-  int num_rules,
+  rcl_arguments_impl_t * args_impl,
   rcl_remap_type_t type_bitmask,
   const char * name,
   const char * node_name,
@@ -112,8 +303,26 @@ _rcl_remap_first_match(
   rcl_remap_t ** output_rule)
 {
   *output_rule = NULL;
-  for (int i = 0; i < num_rules; ++i) {
-    rcl_remap_t * rule = &(remap_rules[i]);
+  // Precompiled rules are found with a hash probe; only rules whose match
+  // side depends on the node still need the scan below, which arbitrates by
+  // rule position so first-match semantics are kept.
+  int scan_limit = args_impl->num_remap_rules;
+  if (NULL != name && NULL != args_impl->remap_index) {
+    int indexed_position = -1;
+    const rcl_remap_t * indexed_rule = rcl_remap_index_lookup(
+      args_impl->remap_index, type_bitmask, name, node_name, &indexed_position);
+    if (NULL != indexed_rule) {
+      *output_rule = (rcl_remap_t *)indexed_rule;
+      // An earlier non-indexed rule can still win; scan only up to here.
+      scan_limit = indexed_position;
+    }
+  }
+  for (int i = 0; i < scan_limit; ++i) {
+    rcl_remap_t * rule = &(args_impl->remap_rules[i]);
+    if (NULL != rule->compiled_match) {
+      // Only reachable through the index, already considered above.
+      continue;
+    }
     if (!(rule->type & type_bitmask)) {
       // Not the type of remap rule we're looking fore
       continue;
@@ -187,7 +396,7 @@ _rcl_remap_name(
   // Look at local rules first
   if (NULL != local_arguments) {
     rcl_ret_t ret = _rcl_remap_first_match(
-      local_arguments->impl->remap_rules, local_arguments->impl->num_remap_rules, type_bitmask,
+      local_arguments->impl, type_bitmask,
       name, node_name, node_namespace, substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
@@ -196,7 +405,7 @@ _rcl_remap_name(
   // Check global rules if no local rule matched
   if (NULL == rule && NULL != global_arguments) {
     rcl_ret_t ret = _rcl_remap_first_match(
-      global_arguments->impl->remap_rules, global_arguments->impl->num_remap_rules, type_bitmask,
+      global_arguments->impl, type_bitmask,
       name, node_name, node_namespace, substitutions, allocator, &rule);
     if (ret != RCL_RET_OK) {
       return ret;
@@ -204,7 +413,10 @@ _rcl_remap_name(
   }
   // Do the remapping
   if (NULL != rule) {
-    if (rule->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP)) {
+    if (NULL != rule->compiled_replacement) {
+      // the replacement side was precompiled to a FQN when the rule was parsed
+      *output_name = rcutils_strdup(rule->compiled_replacement, allocator);
+    } else if (rule->type & (RCL_TOPIC_REMAP | RCL_SERVICE_REMAP)) {
       // topic and service rules need the replacement to be expanded to a FQN
       rcl_ret_t ret = rcl_expand_topic_name(
         rule->replacement, node_name, node_namespace, substitutions, allocator, output_name);
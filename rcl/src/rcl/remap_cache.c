@@ -0,0 +1,145 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./remap_cache.h"
+
+#include <string.h>
+
+#include "./string_pool.h"
+#include "rcl/error_handling.h"
+#include "rcutils/strdup.h"
+
+// Enough for the distinct names of a typically sized node; entries beyond
+// this overwrite the oldest ones round robin.
+#define RCL_REMAP_CACHE_CAPACITY 32
+
+typedef struct rcl_remap_cache_entry_t
+{
+  rcl_remap_type_t type;
+  // Interned in the context's string pool; the pool owns the storage.
+  const char * expanded_name;
+  // NULL records that no rule matched the expanded name.
+  const char * remapped_name;
+} rcl_remap_cache_entry_t;
+
+struct rcl_remap_cache_t
+{
+  rcl_remap_cache_entry_t entries[RCL_REMAP_CACHE_CAPACITY];
+  size_t count;
+  size_t next_overwrite;
+  rcl_context_t * context;
+  rcl_allocator_t allocator;
+};
+
+rcl_remap_cache_t *
+rcl_remap_cache_create(rcl_context_t * context, const rcl_allocator_t * allocator)
+{
+  rcl_remap_cache_t * cache = (rcl_remap_cache_t *)allocator->zero_allocate(
+    1, sizeof(rcl_remap_cache_t), allocator->state);
+  if (NULL == cache) {
+    return NULL;
+  }
+  cache->context = context;
+  cache->allocator = *allocator;
+  return cache;
+}
+
+void
+rcl_remap_cache_destroy(rcl_remap_cache_t * cache)
+{
+  if (NULL == cache) {
+    return;
+  }
+  // The names live in the context's string pool, not in the cache.
+  cache->allocator.deallocate(cache, cache->allocator.state);
+}
+
+rcl_ret_t
+rcl_remap_cache_lookup(
+  const rcl_remap_cache_t * cache,
+  rcl_remap_type_t type,
+  const char * expanded_name,
+  rcl_allocator_t allocator,
+  bool * hit,
+  char ** remapped_name)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(cache, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(expanded_name, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(hit, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(remapped_name, RCL_RET_INVALID_ARGUMENT);
+  *hit = false;
+  *remapped_name = NULL;
+  for (size_t i = 0; i < cache->count; ++i) {
+    const rcl_remap_cache_entry_t * entry = &cache->entries[i];
+    if (entry->type == type && 0 == strcmp(entry->expanded_name, expanded_name)) {
+      if (NULL != entry->remapped_name) {
+        *remapped_name = rcutils_strdup(entry->remapped_name, allocator);
+        if (NULL == *remapped_name) {
+          RCL_SET_ERROR_MSG("allocating memory failed");
+          return RCL_RET_BAD_ALLOC;
+        }
+      }
+      *hit = true;
+      return RCL_RET_OK;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+void
+rcl_remap_cache_store(
+  rcl_remap_cache_t * cache,
+  rcl_remap_type_t type,
+  const char * expanded_name,
+  const char * remapped_name)
+{
+  if (NULL == cache || NULL == expanded_name) {
+    return;
+  }
+  // Intern both names before touching the cache, so a failed intern never
+  // publishes a half-written entry into the range the lookup scans.
+  const char * interned_expanded = rcl_context_intern_string(cache->context, expanded_name);
+  if (NULL == interned_expanded) {
+    // Not caching is harmless; the next resolution just misses.
+    rcl_reset_error();
+    return;
+  }
+  const char * interned_remapped = NULL;
+  if (NULL != remapped_name) {
+    interned_remapped = rcl_context_intern_string(cache->context, remapped_name);
+    if (NULL == interned_remapped) {
+      rcl_reset_error();
+      return;
+    }
+  }
+  rcl_remap_cache_entry_t * entry;
+  if (cache->count < RCL_REMAP_CACHE_CAPACITY) {
+    entry = &cache->entries[cache->count++];
+  } else {
+    entry = &cache->entries[cache->next_overwrite];
+    cache->next_overwrite = (cache->next_overwrite + 1) % RCL_REMAP_CACHE_CAPACITY;
+  }
+  entry->type = type;
+  entry->expanded_name = interned_expanded;
+  entry->remapped_name = interned_remapped;
+}
+
+#ifdef __cplusplus
+}
+#endif
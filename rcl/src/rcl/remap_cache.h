@@ -0,0 +1,104 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__REMAP_CACHE_H_
+#define RCL__REMAP_CACHE_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+
+#include "rcl/allocator.h"
+#include "rcl/types.h"
+
+#include "rcl/node.h"
+
+#include "./remap_impl.h"
+
+// Internal per-node memo of remap resolutions.
+//
+// A node creating many entities resolves the same expanded names through the
+// same local and global rule sets over and over; the cache remembers the
+// outcome (including "no rule matched") per expanded name and rule type, so
+// each unique resolution is paid for once per node.  The rule sets are fixed
+// after rcl_node_init(), which is what makes memoization safe.
+//
+// The cache has a small fixed capacity and overwrites entries round robin;
+// it is not thread-safe, matching entity creation on a node.
+//
+// Cached names are interned in the context's string pool, so nodes caching
+// the same names ("/tf", "/clock", ...) share one stored copy per context.
+
+struct rcl_remap_cache_t;
+typedef struct rcl_remap_cache_t rcl_remap_cache_t;
+
+/// Allocate an empty cache, or return NULL on allocation failure.
+/**
+ * `context` is the context whose string pool backs the cached names; it must
+ * outlive the cache, which holds for a node's cache and its context.
+ */
+rcl_remap_cache_t *
+rcl_remap_cache_create(rcl_context_t * context, const rcl_allocator_t * allocator);
+
+/// Free a cache; interned names stay in the context's pool.  NULL is ignored.
+void
+rcl_remap_cache_destroy(rcl_remap_cache_t * cache);
+
+/// Look up the memoized resolution of an expanded name.
+/**
+ * On a hit `*hit` is set to true and `*remapped_name` to a copy of the
+ * memoized result, which is NULL when no rule matched the name; the caller
+ * owns the copy.  On a miss `*hit` is false and `*remapped_name` NULL.
+ *
+ * \return `RCL_RET_OK`, `RCL_RET_INVALID_ARGUMENT`, or `RCL_RET_BAD_ALLOC`.
+ */
+rcl_ret_t
+rcl_remap_cache_lookup(
+  const rcl_remap_cache_t * cache,
+  rcl_remap_type_t type,
+  const char * expanded_name,
+  rcl_allocator_t allocator,
+  bool * hit,
+  char ** remapped_name);
+
+/// Memoize the resolution of an expanded name.
+/**
+ * `remapped_name` may be NULL to record that no rule matched; both names are
+ * interned in the context's string pool.  Failing to store is not an error
+ * worth failing entity creation over, so allocation failures only evict the
+ * chosen slot.
+ */
+void
+rcl_remap_cache_store(
+  rcl_remap_cache_t * cache,
+  rcl_remap_type_t type,
+  const char * expanded_name,
+  const char * remapped_name);
+
+/// Get the memo cache of a node, or NULL if it could not be allocated.
+/**
+ * Implemented in node.c, where the node impl struct lives; entity init
+ * functions use this to consult the cache before running the remap rules.
+ */
+rcl_remap_cache_t *
+rcl_node_get_remap_cache(const rcl_node_t * node);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__REMAP_CACHE_H_
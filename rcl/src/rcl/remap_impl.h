@@ -46,14 +46,84 @@ typedef struct rcl_remap_t
   /// Replacement portion of a rule.
   char * replacement;
 
+  /// Match side precompiled to a fully qualified name, or NULL.
+  /**
+   * Filled in by rcl_remap_compile() when the match does not depend on the
+   * node the rule is applied to, so lookups can string compare instead of
+   * running the name expansion machinery per rule.
+   */
+  char * compiled_match;
+  /// Replacement side precompiled to a fully qualified name, or NULL.
+  char * compiled_replacement;
+
   /// Allocator used to allocate objects in this struct
   rcl_allocator_t allocator;
 } rcl_remap_t;
 
+/// Hash index over precompiled remap rules, keyed by the compiled match.
+/**
+ * Built by rcl_remap_index_init() from a parsed rule array; rules without a
+ * compiled match (those that depend on the node they are applied to) are not
+ * indexed and still require a scan.
+ */
+typedef struct rcl_remap_index_t rcl_remap_index_t;
+
+/// Build an index over the rules that have a compiled match side.
+/**
+ * The index borrows the rule array, which must outlive it unchanged.
+ * An index is returned even when no rule qualifies, so lookups can always
+ * consult it; `*index` is left NULL only on error.
+ *
+ * \return `RCL_RET_OK`, `RCL_RET_INVALID_ARGUMENT`, or `RCL_RET_BAD_ALLOC`.
+ */
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_remap_index_init(
+  rcl_remap_index_t ** index,
+  const rcl_remap_t * rules,
+  int num_rules,
+  rcl_allocator_t allocator);
+
+/// Free an index previously built with rcl_remap_index_init().
+void
+rcl_remap_index_fini(
+  rcl_remap_index_t * index);
+
+/// Find the first indexed rule matching a fully qualified name.
+/**
+ * Returns the matching rule with the lowest position in the parsed rule
+ * array that passes the type bitmask and node name checks, or NULL; the
+ * position is reported through `rule_position` so callers can arbitrate
+ * against rules that are not in the index.
+ */
+const rcl_remap_t *
+rcl_remap_index_lookup(
+  const rcl_remap_index_t * index,
+  rcl_remap_type_t type_bitmask,
+  const char * name,
+  const char * node_name,
+  int * rule_position);
+
 /// Get an rcl_remap_t structure initialized with NULL.
 rcl_remap_t
 rcl_remap_get_zero_initialized();
 
+/// Precompile a parsed rule for fast lookups.
+/**
+ * Topic and service rules whose match and replacement sides are already
+ * fully qualified and free of substitutions expand to themselves for every
+ * node, so the expansion is done once here and cached in the rule; rules
+ * that use `~` or `{}` substitutions are left to be expanded per lookup.
+ *
+ * \param[inout] rule A parsed rule to precompile.
+ * \return `RCL_RET_OK` if the rule was processed, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_remap_compile(
+  rcl_remap_t * rule);
+
 /// Copy one remap structure into another.
 /**
  * <hr>
@@ -65,8 +135,9 @@ rcl_remap_get_zero_initialized();
  * Lock-Free          | Yes
  *
  * \param[in] rule The structure to be copied.
- *  Its allocator is used to copy memory into the new structure.
  * \param[out] rule_out A zero-initialized rcl_remap_t structure to be copied into.
+ * \param[in] allocator The allocator used to copy memory into the new structure,
+ *  which becomes its allocator.
  * \return `RCL_RET_OK` if the structure was copied successfully, or
  * \return `RCL_RET_INVALID_ARGUMENT` if any function arguments are invalid, or
  * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
@@ -77,7 +148,8 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_remap_copy(
   const rcl_remap_t * rule,
-  rcl_remap_t * rule_out);
+  rcl_remap_t * rule_out,
+  rcl_allocator_t allocator);
 
 /// Reclaim resources used in an rcl_remap_t structure.
 /**
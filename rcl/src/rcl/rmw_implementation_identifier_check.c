@@ -17,6 +17,8 @@ extern "C"
 {
 #endif
 
+#include "rcl/rmw_implementation_identifier_check.h"
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -24,35 +26,21 @@ extern "C"
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
 #include "rmw/rmw.h"
 
 #include "rcl/types.h"
 #include "./common.h"
 
-// Extracted this portable method of doing a "shared library constructor" from SO:
-//   http://stackoverflow.com/a/2390626/671658
-// Initializer/finalizer sample for MSVC and GCC/Clang.
-// 2010-2016 Joe Lowe. Released into the public domain.
-#if defined(_MSC_VER)
-  #pragma section(".CRT$XCU", read)
-  #define INITIALIZER2_(f, p) \
-  static void f(void); \
-  __declspec(allocate(".CRT$XCU")) void(*f ## _)(void) = f; \
-  __pragma(comment(linker, "/include:" p #f "_")) \
-  static void f(void)
-  #ifdef _WIN64
-    #define INITIALIZER(f) INITIALIZER2_(f, "")
-  #else
-    #define INITIALIZER(f) INITIALIZER2_(f, "_")
-  #endif
-#else
-  #define INITIALIZER(f) \
-  static void f(void) __attribute__((constructor)); \
-  static void f(void)
-#endif
+// Cached verdict of the check, stored as the rcl_ret_t plus one so that zero
+// can mean "not yet computed".
+static atomic_uint_least64_t __rmw_impl_id_check_verdict = ATOMIC_VAR_INIT(0);
 
-INITIALIZER(initialize) {
+/// Compute the verdict by reading the environment, done at most once.
+static rcl_ret_t
+__compute_rmw_implementation_identifier_check(void)
+{
   // If the environment variable RMW_IMPLEMENTATION is set, or
   // the environment variable RCL_ASSERT_RMW_ID_MATCHES is set,
   // check that the result of `rmw_get_implementation_identifier` matches.
@@ -66,14 +54,14 @@ INITIALIZER(initialize) {
       "Error getting environment variable 'RMW_IMPLEMENTATION': %s",
       rcl_get_error_string().str
     );
-    exit(ret);
+    return ret;
   }
   if (strlen(expected_rmw_impl_env) > 0) {
     // Copy the environment variable so it doesn't get over-written by the next getenv call.
     expected_rmw_impl = rcutils_strdup(expected_rmw_impl_env, allocator);
     if (!expected_rmw_impl) {
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "allocation failed");
-      exit(RCL_RET_BAD_ALLOC);
+      return RCL_RET_BAD_ALLOC;
     }
   }
 
@@ -86,14 +74,16 @@ INITIALIZER(initialize) {
       "Error getting environment variable 'RCL_ASSERT_RMW_ID_MATCHES': %s",
       rcl_get_error_string().str
     );
-    exit(ret);
+    allocator.deallocate(expected_rmw_impl, allocator.state);
+    return ret;
   }
   if (strlen(asserted_rmw_impl_env) > 0) {
     // Copy the environment variable so it doesn't get over-written by the next getenv call.
     asserted_rmw_impl = rcutils_strdup(asserted_rmw_impl_env, allocator);
     if (!asserted_rmw_impl) {
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "allocation failed");
-      exit(RCL_RET_BAD_ALLOC);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_BAD_ALLOC;
     }
   }
 
@@ -105,7 +95,9 @@ INITIALIZER(initialize) {
       "variables do not match, exiting with %d.",
       expected_rmw_impl, asserted_rmw_impl, RCL_RET_ERROR
     );
-    exit(RCL_RET_ERROR);
+    allocator.deallocate(expected_rmw_impl, allocator.state);
+    allocator.deallocate(asserted_rmw_impl, allocator.state);
+    return RCL_RET_ERROR;
   }
 
   // Collapse the expected_rmw_impl and asserted_rmw_impl variables so only expected_rmw_impl needs
@@ -135,7 +127,8 @@ INITIALIZER(initialize) {
         RCL_RET_ERROR
       );
       rcl_reset_error();
-      exit(RCL_RET_ERROR);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_ERROR;
     }
     if (strcmp(actual_rmw_impl_id, expected_rmw_impl) != 0) {
       RCUTILS_LOG_ERROR_NAMED(
@@ -145,11 +138,61 @@ INITIALIZER(initialize) {
         actual_rmw_impl_id,
         RCL_RET_MISMATCHED_RMW_ID
       );
-      exit(RCL_RET_MISMATCHED_RMW_ID);
+      allocator.deallocate(expected_rmw_impl, allocator.state);
+      return RCL_RET_MISMATCHED_RMW_ID;
     }
     // Free the memory now that all checking has passed.
     allocator.deallocate((char *)expected_rmw_impl, allocator.state);
   }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_rmw_implementation_identifier_check(void)
+{
+  uint64_t cached_verdict;
+  rcutils_atomic_load(&__rmw_impl_id_check_verdict, cached_verdict);
+  if (0 == cached_verdict) {
+    // Two threads racing here both compute and store the same verdict.
+    rcl_ret_t computed = __compute_rmw_implementation_identifier_check();
+    cached_verdict = (uint64_t)computed + 1;
+    rcutils_atomic_store(&__rmw_impl_id_check_verdict, cached_verdict);
+  }
+  rcl_ret_t ret = (rcl_ret_t)(cached_verdict - 1);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("rmw implementation identifier check failed, see the log for details");
+  }
+  return ret;
+}
+
+// Extracted this portable method of doing a "shared library constructor" from SO:
+//   http://stackoverflow.com/a/2390626/671658
+// Initializer/finalizer sample for MSVC and GCC/Clang.
+// 2010-2016 Joe Lowe. Released into the public domain.
+#if defined(_MSC_VER)
+  #pragma section(".CRT$XCU", read)
+  #define INITIALIZER2_(f, p) \
+  static void f(void); \
+  __declspec(allocate(".CRT$XCU")) void(*f ## _)(void) = f; \
+  __pragma(comment(linker, "/include:" p #f "_")) \
+  static void f(void)
+  #ifdef _WIN64
+    #define INITIALIZER(f) INITIALIZER2_(f, "")
+  #else
+    #define INITIALIZER(f) INITIALIZER2_(f, "_")
+  #endif
+#else
+  #define INITIALIZER(f) \
+  static void f(void) __attribute__((constructor)); \
+  static void f(void)
+#endif
+
+INITIALIZER(initialize) {
+  rcl_ret_t ret = rcl_rmw_implementation_identifier_check();
+  if (ret != RCL_RET_OK) {
+    rcl_reset_error();
+    exit(ret);
+  }
 }
 
 #ifdef __cplusplus
@@ -30,10 +30,23 @@ extern "C"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
+#include "./entity_event_callbacks.h"
+#include "./entity_registry.h"
+#include "./entity_slab.h"
+#include "./entity_statistics.h"
+#include "./reclaim.h"
+#include "./remap_cache.h"
+
 typedef struct rcl_service_impl_t
 {
   rcl_service_options_t options;
   rmw_service_t * rmw_handle;
+  // Invoked from the wait path when new requests are available,
+  // see rcl_service_set_on_new_request_callback().
+  rcl_event_callback_t on_new_request_callback;
+  const void * on_new_request_user_data;
+  // Hot path counters, NULL unless statistics were enabled in the options.
+  rcl_entity_statistics_t * statistics;
 } rcl_service_impl_t;
 
 rcl_service_t
@@ -70,47 +83,43 @@ rcl_service_init(
     RCL_SET_ERROR_MSG("service already initialized, or memory was unintialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given service name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (RCL_RET_BAD_ALLOC == ret) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
+  // Expand the given service name, using the node's cached substitutions map.
+  const rcutils_string_map_t * substitutions_map = rcl_node_get_topic_name_substitutions(node);
+  if (NULL == substitutions_map) {
+    return RCL_RET_NODE_INVALID;  // error already set
   }
+  char expanded_name_buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
   char * expanded_service_name = NULL;
   char * remapped_service_name = NULL;
-  ret = rcl_expand_topic_name(
+  // The fused expansion validates the expanded name in the same pass, so the
+  // separate rmw validation below only runs when remapping changed the name.
+  bool expanded_name_validated = false;
+  int validation_result = RMW_TOPIC_VALID;
+  rcl_ret_t ret = rcl_expand_and_validate_topic_name_with_buffer(
     service_name,
     rcl_node_get_name(node),
     rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_service_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-    return RCL_RET_ERROR;
+    substitutions_map,
+    expanded_name_buffer,
+    sizeof(expanded_name_buffer),
+    &validation_result);
+  if (RCL_RET_OK == ret) {
+    if (RMW_TOPIC_VALID != validation_result) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      return RCL_RET_SERVICE_NAME_INVALID;
+    }
+    expanded_service_name = expanded_name_buffer;
+    expanded_name_validated = true;
+  } else if (RCL_RET_BUFFER_TOO_SMALL == ret) {
+    // unusually long name, fall back to the allocating expansion
+    rcl_reset_error();
+    ret = rcl_expand_topic_name(
+      service_name,
+      rcl_node_get_name(node),
+      rcl_node_get_namespace(node),
+      substitutions_map,
+      *allocator,
+      &expanded_service_name);
   }
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
@@ -131,32 +140,54 @@ rcl_service_init(
   if (node_options->use_global_arguments) {
     global_args = &(node->context->global_arguments);
   }
-  ret = rcl_remap_service_name(
-    &(node_options->arguments), global_args, expanded_service_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_service_name) {
+  rcl_remap_cache_t * remap_cache = rcl_node_get_remap_cache(node);
+  bool remap_cache_hit = false;
+  if (NULL != remap_cache) {
+    ret = rcl_remap_cache_lookup(
+      remap_cache, RCL_SERVICE_REMAP, expanded_service_name, *allocator,
+      &remap_cache_hit, &remapped_service_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+  }
+  if (!remap_cache_hit) {
+    ret = rcl_remap_service_name(
+      &(node_options->arguments), global_args, expanded_service_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_service_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+    rcl_remap_cache_store(
+      remap_cache, RCL_SERVICE_REMAP, expanded_service_name, remapped_service_name);
+  }
+  // A remap rule produced a new name which still needs validating; without
+  // one the expanded name is used, already validated unless the expansion
+  // fell back to the allocating path.
+  bool needs_validation = (NULL != remapped_service_name) || !expanded_name_validated;
+  if (NULL == remapped_service_name) {
     remapped_service_name = expanded_service_name;
     expanded_service_name = NULL;
   }
 
   // Validate the expanded service name.
-  int validation_result;
-  rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_service_name, &validation_result, NULL);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (validation_result != RMW_TOPIC_VALID) {
-    RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
-    ret = RCL_RET_SERVICE_NAME_INVALID;
-    goto cleanup;
+  if (needs_validation) {
+    rmw_ret_t rmw_ret =
+      rmw_validate_full_topic_name(remapped_service_name, &validation_result, NULL);
+    if (rmw_ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = RCL_RET_ERROR;
+      goto cleanup;
+    }
+    if (validation_result != RMW_TOPIC_VALID) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      ret = RCL_RET_SERVICE_NAME_INVALID;
+      goto cleanup;
+    }
   }
-  // Allocate space for the implementation struct.
-  service->impl = (rcl_service_impl_t *)allocator->allocate(
-    sizeof(rcl_service_impl_t), allocator->state);
+  // Allocate space for the implementation struct, from the node's slab so
+  // the node's entity impls sit contiguously.
+  service->impl = (rcl_service_impl_t *)rcl_node_allocate_entity_impl(
+    node, allocator, sizeof(rcl_service_impl_t));
   RCL_CHECK_FOR_NULL_WITH_MSG(
     service->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
 
@@ -180,27 +211,47 @@ rcl_service_init(
   }
   // options
   service->impl->options = *options;
+  service->impl->on_new_request_callback = NULL;
+  service->impl->on_new_request_user_data = NULL;
+  // hot path statistics
+  service->impl->statistics = NULL;
+  if (options->enable_statistics) {
+    service->impl->statistics = rcl_entity_statistics_create(allocator, false);
+    if (!service->impl->statistics) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (RMW_RET_OK != rmw_destroy_service(
+          rcl_node_get_rmw_handle(node), service->impl->rmw_handle))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy rmw service: %s", rmw_get_error_string().str);
+      }
+      goto fail;
+    }
+  }
+  // record for bulk teardown by rcl_context_fini_all_entities()
+  rcl_context_track_entity(node->context, RCL_TRACKED_SERVICE, service, node);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service initialized");
   ret = RCL_RET_OK;
   goto cleanup;
 fail:
   if (service->impl) {
-    allocator->deallocate(service->impl, allocator->state);
+    rcl_node_deallocate_entity_impl(node, allocator, service->impl);
   }
   ret = fail_ret;
   // Fall through to clean up
 cleanup:
-  if (NULL != expanded_service_name) {
+  if (NULL != expanded_service_name && expanded_name_buffer != expanded_service_name) {
     allocator->deallocate(expanded_service_name, allocator->state);
   }
-  if (NULL != remapped_service_name) {
+  if (NULL != remapped_service_name && expanded_name_buffer != remapped_service_name) {
     allocator->deallocate(remapped_service_name, allocator->state);
   }
   return ret;
 }
 
-rcl_ret_t
-rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
+static rcl_ret_t
+__rcl_service_fini(rcl_service_t * service, rcl_node_t * node, bool deferred)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Finalizing service");
   RCL_CHECK_ARGUMENT_FOR_NULL(service, RCL_RET_SERVICE_INVALID);
@@ -215,17 +266,44 @@ rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
-    rmw_ret_t ret = rmw_destroy_service(rmw_node, service->impl->rmw_handle);
-    if (ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-      result = RCL_RET_ERROR;
+    rcl_context_untrack_entity(node->context, service);
+    rcl_entity_statistics_destroy(service->impl->statistics, &allocator);
+    bool destroy_inline = true;
+    if (deferred) {
+      rcl_ret_t defer_ret = rcl_context_defer_rmw_destroy(
+        node->context, RCL_RECLAIM_SERVICE, rmw_node, service->impl->rmw_handle);
+      if (RCL_RET_OK == defer_ret) {
+        destroy_inline = false;
+      } else {
+        // Queueing failed; destroy synchronously rather than leaking.
+        rcl_reset_error();
+      }
+    }
+    if (destroy_inline) {
+      rmw_ret_t ret = rmw_destroy_service(rmw_node, service->impl->rmw_handle);
+      if (ret != RMW_RET_OK) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
     }
-    allocator.deallocate(service->impl, allocator.state);
+    rcl_node_deallocate_entity_impl(node, &allocator, service->impl);
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service finalized");
   return result;
 }
 
+rcl_ret_t
+rcl_service_fini(rcl_service_t * service, rcl_node_t * node)
+{
+  return __rcl_service_fini(service, node, false);
+}
+
+rcl_ret_t
+rcl_service_fini_deferred(rcl_service_t * service, rcl_node_t * node)
+{
+  return __rcl_service_fini(service, node, true);
+}
+
 rcl_service_options_t
 rcl_service_get_default_options()
 {
@@ -234,9 +312,28 @@ rcl_service_get_default_options()
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_services_default;
   default_options.allocator = rcl_get_default_allocator();
+  default_options.enable_statistics = false;
+  default_options.priority = 0;
   return default_options;
 }
 
+rcl_ret_t
+rcl_service_get_statistics(
+  const rcl_service_t * service,
+  rcl_statistics_t * statistics)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  if (!service->impl->statistics) {
+    RCL_SET_ERROR_MSG("service does not keep statistics");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_entity_statistics_snapshot(service->impl->statistics, statistics);
+  return RCL_RET_OK;
+}
+
 const char *
 rcl_service_get_service_name(const rcl_service_t * service)
 {
@@ -288,6 +385,7 @@ rcl_take_request(
     service->impl->rmw_handle, request_header, ros_request, &taken);
   if (RMW_RET_OK != ret) {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    rcl_entity_statistics_record_failed(service->impl->statistics);
     if (RMW_RET_BAD_ALLOC == ret) {
       return RCL_RET_BAD_ALLOC;
     }
@@ -296,8 +394,69 @@ rcl_take_request(
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Service take request succeeded: %s", taken ? "true" : "false");
   if (!taken) {
+    rcl_entity_statistics_record_failed(service->impl->statistics);
     return RCL_RET_SERVICE_TAKE_FAILED;
   }
+  rcl_entity_statistics_record_succeeded(service->impl->statistics, 1);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_request_serialized(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_header,
+  rcl_serialized_message_t * serialized_request)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_request, RCL_RET_INVALID_ARGUMENT);
+  // The rmw interface in use has no serialized service entry points yet;
+  // relays on top of it have to fall back to rcl_take_request().
+  RCL_SET_ERROR_MSG("taking serialized requests is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_take_request_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * request_headers,
+  void ** ros_requests,
+  size_t capacity,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Service server taking batch of service requests");
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_requests, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_requests[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  // Drain up to capacity requests, paying the validation above only once.
+  while (*taken < capacity) {
+    bool request_taken = false;
+    rmw_ret_t ret = rmw_take_request(
+      service->impl->rmw_handle, &request_headers[*taken], ros_requests[*taken], &request_taken);
+    if (RMW_RET_OK != ret) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!request_taken) {
+      break;
+    }
+    ++(*taken);
+  }
+  rcl_entity_statistics_record_succeeded(service->impl->statistics, *taken);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Service batch take took %zu requests", *taken);
   return RCL_RET_OK;
 }
 
@@ -320,8 +479,58 @@ rcl_send_response(
       service->impl->rmw_handle, request_header, ros_response) != RMW_RET_OK)
   {
     RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    rcl_entity_statistics_record_failed(service->impl->statistics);
     return RCL_RET_ERROR;
   }
+  rcl_entity_statistics_record_succeeded(service->impl->statistics, 1);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_send_response_serialized(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_header,
+  const rcl_serialized_message_t * serialized_response)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_header, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_response, RCL_RET_INVALID_ARGUMENT);
+  // The rmw interface in use has no serialized service entry points yet;
+  // relays on top of it have to fall back to rcl_send_response().
+  RCL_SET_ERROR_MSG("sending serialized responses is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_send_response_batch(
+  const rcl_service_t * service,
+  rmw_request_id_t * response_headers,
+  void ** ros_responses,
+  size_t count)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Sending batch of service responses");
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(response_headers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < count; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(ros_responses[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  // Send in order, paying the validation above only once.
+  for (size_t i = 0; i < count; ++i) {
+    if (rmw_send_response(
+        service->impl->rmw_handle, &response_headers[i], ros_responses[i]) != RMW_RET_OK)
+    {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      rcl_entity_statistics_record_failed(service->impl->statistics);
+      rcl_entity_statistics_record_succeeded(service->impl->statistics, i);
+      return RCL_RET_ERROR;
+    }
+  }
+  rcl_entity_statistics_record_succeeded(service->impl->statistics, count);
   return RCL_RET_OK;
 }
 
@@ -336,6 +545,29 @@ rcl_service_is_valid(const rcl_service_t * service)
   return true;
 }
 
+rcl_ret_t
+rcl_service_set_on_new_request_callback(
+  const rcl_service_t * service,
+  rcl_event_callback_t callback,
+  const void * user_data)
+{
+  if (!rcl_service_is_valid(service)) {
+    return RCL_RET_SERVICE_INVALID;  // error already set
+  }
+  service->impl->on_new_request_callback = callback;
+  service->impl->on_new_request_user_data = user_data;
+  return RCL_RET_OK;
+}
+
+void
+rcl_service_dispatch_on_new_request(const rcl_service_t * service)
+{
+  rcl_event_callback_t callback = service->impl->on_new_request_callback;
+  if (NULL != callback) {
+    callback(service->impl->on_new_request_user_data, 1);
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,131 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./string_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "rcl/arena.h"
+#include "rcl/error_handling.h"
+
+#include "./context_impl.h"
+
+// Number of hash buckets; names hash well, so chains stay short even for
+// processes with a few hundred distinct names.
+#define RCL_STRING_POOL_NUM_BUCKETS 64u
+
+// First block sized for the names of a typically sized process; the arena
+// grows as needed beyond that.
+#define RCL_STRING_POOL_INITIAL_BLOCK_SIZE 4096u
+
+typedef struct rcl_string_pool_entry_t
+{
+  struct rcl_string_pool_entry_t * next;
+  uint32_t hash;
+  // the interned characters follow the header in the same carved allocation
+  char value[1];
+} rcl_string_pool_entry_t;
+
+typedef struct rcl_string_pool_t
+{
+  rcl_string_pool_entry_t * buckets[RCL_STRING_POOL_NUM_BUCKETS];
+  rcl_arena_t arena;
+  rcl_allocator_t allocator;
+} rcl_string_pool_t;
+
+/// FNV-1a, enough mixing for short path-like strings.
+static uint32_t
+_rcl_string_pool_hash(const char * value)
+{
+  uint32_t hash = 2166136261u;
+  for (; '\0' != *value; ++value) {
+    hash ^= (uint32_t)(unsigned char)*value;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/// Get the context's pool, creating it on first use.
+static rcl_string_pool_t *
+__string_pool_get(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(context->impl, "context is invalid", return NULL);
+  if (!context->impl->string_pool) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_string_pool_t * pool = (rcl_string_pool_t *)allocator.zero_allocate(
+      1, sizeof(rcl_string_pool_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(pool, "allocating memory failed", return NULL);
+    pool->allocator = allocator;
+    pool->arena = rcl_get_zero_initialized_arena();
+    rcl_ret_t ret = rcl_arena_init(&pool->arena, RCL_STRING_POOL_INITIAL_BLOCK_SIZE, allocator);
+    if (RCL_RET_OK != ret) {
+      allocator.deallocate(pool, allocator.state);
+      return NULL;  // error already set
+    }
+    context->impl->string_pool = pool;
+  }
+  return context->impl->string_pool;
+}
+
+const char *
+rcl_context_intern_string(rcl_context_t * context, const char * value)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(value, NULL);
+  rcl_string_pool_t * pool = __string_pool_get(context);
+  if (!pool) {
+    return NULL;  // error already set
+  }
+  uint32_t hash = _rcl_string_pool_hash(value);
+  size_t bucket = hash % RCL_STRING_POOL_NUM_BUCKETS;
+  rcl_string_pool_entry_t * entry = pool->buckets[bucket];
+  for (; entry; entry = entry->next) {
+    if (entry->hash == hash && 0 == strcmp(entry->value, value)) {
+      return entry->value;
+    }
+  }
+  // entry header and characters share one carved allocation
+  size_t length = strlen(value);
+  rcl_allocator_t arena_allocator = rcl_arena_get_allocator(&pool->arena);
+  entry = (rcl_string_pool_entry_t *)arena_allocator.allocate(
+    sizeof(rcl_string_pool_entry_t) + length, arena_allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return NULL);
+  entry->hash = hash;
+  memcpy(entry->value, value, length + 1);
+  entry->next = pool->buckets[bucket];
+  pool->buckets[bucket] = entry;
+  return entry->value;
+}
+
+void
+rcl_string_pool_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->string_pool) {
+    return;
+  }
+  rcl_string_pool_t * pool = context->impl->string_pool;
+  rcl_arena_fini(&pool->arena);
+  pool->allocator.deallocate(pool, pool->allocator.state);
+  context->impl->string_pool = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,58 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__STRING_POOL_H_
+#define RCL__STRING_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+
+// Internal interned string pool, hung off the context.
+//
+// Topic names, service names and node names repeat heavily across the
+// entities of a process ("/tf", "/clock", "/parameter_events", ...), and the
+// init paths used to keep an owned copy per entity or cache entry.  The pool
+// stores each distinct string once per context and hands out a stable
+// pointer, so duplicate name storage collapses and two interned names can be
+// compared for equality by pointer.
+//
+// Interned strings live until the context is cleaned up and are carved from
+// an arena, so individual callers neither own nor free them.  Interning is
+// not thread-safe, matching entity creation on a context.
+
+struct rcl_string_pool_t;
+
+/// Intern a string in the context's pool, creating the pool on first use.
+/**
+ * Returns a pointer to the pooled copy of `value`, which stays valid and
+ * unchanged until the context is cleaned up; the same pointer is returned
+ * for every equal string interned in the same context.  Returns NULL and
+ * sets an error message if the context is invalid or allocation fails.
+ */
+const char *
+rcl_context_intern_string(rcl_context_t * context, const char * value);
+
+/// Free the context's string pool if it was created.
+void
+rcl_string_pool_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__STRING_POOL_H_
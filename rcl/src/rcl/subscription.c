@@ -25,15 +25,54 @@ extern "C"
 #include "rcl/error_handling.h"
 #include "rcl/expand_topic_name.h"
 #include "rcl/remap.h"
+#include "rcl/tracepoints.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/types/uint8_array.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 #include "rmw/validate_full_topic_name.h"
 
+#include "./entity_event_callbacks.h"
+#include "./entity_registry.h"
+#include "./entity_slab.h"
+#include "./entity_statistics.h"
+#include "./event_impl.h"
+#include "./intra_process.h"
+#include "./reclaim.h"
+#include "./remap_cache.h"
+#include "./message_pool.h"
+
+// Recycled serialized-message buffer, see
+// rcl_subscription_acquire_serialized_message().
+typedef struct rcl_serialized_buffer_entry_t
+{
+  // Must be the first member, so the serialized message pointer handed out
+  // by acquire can be mapped back to its entry on release.
+  rcl_serialized_message_t serialized_message;
+  struct rcl_serialized_buffer_entry_t * next;
+} rcl_serialized_buffer_entry_t;
+
 typedef struct rcl_subscription_impl_t
 {
   rcl_subscription_options_t options;
   rmw_subscription_t * rmw_handle;
+  // Invoked from the wait path when new messages are available,
+  // see rcl_subscription_set_on_new_message_callback().
+  rcl_event_callback_t on_new_message_callback;
+  const void * on_new_message_user_data;
+  // Intra-process fast path state; the guard condition wakes wait sets when
+  // a message pointer arrives and is zero initialized if not opted in.
+  rcl_guard_condition_t intra_process_guard_condition;
+  struct rcl_intra_process_sub_t * intra_process_sub;
+  // Preallocated message storage, zero initialized if not configured.
+  rcl_message_pool_t message_pool;
+  // Hot path counters, NULL unless statistics were enabled in the options.
+  rcl_entity_statistics_t * statistics;
+  // Largest serialized message taken so far, see
+  // rcl_subscription_get_suggested_buffer_size().
+  size_t max_serialized_size;
+  // Free list of recycled serialized-message buffers.
+  rcl_serialized_buffer_entry_t * free_serialized_buffers;
 } rcl_subscription_impl_t;
 
 rcl_subscription_t
@@ -69,46 +108,43 @@ rcl_subscription_init(
     RCL_SET_ERROR_MSG("subscription already initialized, or memory was uninitialized");
     return RCL_RET_ALREADY_INIT;
   }
-  // Expand the given topic name.
-  rcutils_allocator_t rcutils_allocator = *allocator;  // implicit conversion to rcutils version
-  rcutils_string_map_t substitutions_map = rcutils_get_zero_initialized_string_map();
-  rcutils_ret_t rcutils_ret = rcutils_string_map_init(&substitutions_map, 0, rcutils_allocator);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    if (RCUTILS_RET_BAD_ALLOC == rcutils_ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-  rcl_ret_t ret = rcl_get_default_topic_name_substitutions(&substitutions_map);
-  if (ret != RCL_RET_OK) {
-    rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-    if (rcutils_ret != RCUTILS_RET_OK) {
-      RCUTILS_LOG_ERROR_NAMED(
-        ROS_PACKAGE_NAME,
-        "failed to fini string_map (%d) during error handling: %s",
-        rcutils_ret,
-        rcutils_get_error_string().str);
-    }
-    if (RCL_RET_BAD_ALLOC == ret) {
-      return ret;
-    }
-    return RCL_RET_ERROR;
+  // Expand the given topic name, using the node's cached substitutions map.
+  const rcutils_string_map_t * substitutions_map = rcl_node_get_topic_name_substitutions(node);
+  if (NULL == substitutions_map) {
+    return RCL_RET_NODE_INVALID;  // error already set
   }
+  char expanded_name_buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
   char * expanded_topic_name = NULL;
   char * remapped_topic_name = NULL;
-  ret = rcl_expand_topic_name(
+  // The fused expansion validates the expanded name in the same pass, so the
+  // separate rmw validation below only runs when remapping changed the name.
+  bool expanded_name_validated = false;
+  int validation_result = RMW_TOPIC_VALID;
+  rcl_ret_t ret = rcl_expand_and_validate_topic_name_with_buffer(
     topic_name,
     rcl_node_get_name(node),
     rcl_node_get_namespace(node),
-    &substitutions_map,
-    *allocator,
-    &expanded_topic_name);
-  rcutils_ret = rcutils_string_map_fini(&substitutions_map);
-  if (rcutils_ret != RCUTILS_RET_OK) {
-    RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
+    substitutions_map,
+    expanded_name_buffer,
+    sizeof(expanded_name_buffer),
+    &validation_result);
+  if (RCL_RET_OK == ret) {
+    if (RMW_TOPIC_VALID != validation_result) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      return RCL_RET_TOPIC_NAME_INVALID;
+    }
+    expanded_topic_name = expanded_name_buffer;
+    expanded_name_validated = true;
+  } else if (RCL_RET_BUFFER_TOO_SMALL == ret) {
+    // unusually long name, fall back to the allocating expansion
+    rcl_reset_error();
+    ret = rcl_expand_topic_name(
+      topic_name,
+      rcl_node_get_name(node),
+      rcl_node_get_namespace(node),
+      substitutions_map,
+      *allocator,
+      &expanded_topic_name);
   }
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_TOPIC_NAME_INVALID || ret == RCL_RET_UNKNOWN_SUBSTITUTION) {
@@ -129,34 +165,56 @@ rcl_subscription_init(
   if (node_options->use_global_arguments) {
     global_args = &(node->context->global_arguments);
   }
-  ret = rcl_remap_topic_name(
-    &(node_options->arguments), global_args, expanded_topic_name,
-    rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
-  if (RCL_RET_OK != ret) {
-    goto fail;
-  } else if (NULL == remapped_topic_name) {
+  rcl_remap_cache_t * remap_cache = rcl_node_get_remap_cache(node);
+  bool remap_cache_hit = false;
+  if (NULL != remap_cache) {
+    ret = rcl_remap_cache_lookup(
+      remap_cache, RCL_TOPIC_REMAP, expanded_topic_name, *allocator,
+      &remap_cache_hit, &remapped_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+  }
+  if (!remap_cache_hit) {
+    ret = rcl_remap_topic_name(
+      &(node_options->arguments), global_args, expanded_topic_name,
+      rcl_node_get_name(node), rcl_node_get_namespace(node), *allocator, &remapped_topic_name);
+    if (RCL_RET_OK != ret) {
+      goto fail;
+    }
+    rcl_remap_cache_store(remap_cache, RCL_TOPIC_REMAP, expanded_topic_name, remapped_topic_name);
+  }
+  // A remap rule produced a new name which still needs validating; without
+  // one the expanded name is used, already validated unless the expansion
+  // fell back to the allocating path.
+  bool needs_validation = (NULL != remapped_topic_name) || !expanded_name_validated;
+  if (NULL == remapped_topic_name) {
     remapped_topic_name = expanded_topic_name;
     expanded_topic_name = NULL;
   }
 
   // Validate the expanded topic name.
-  int validation_result;
-  rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_topic_name, &validation_result, NULL);
-  if (rmw_ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    ret = RCL_RET_ERROR;
-    goto cleanup;
-  }
-  if (validation_result != RMW_TOPIC_VALID) {
-    RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
-    ret = RCL_RET_TOPIC_NAME_INVALID;
-    goto cleanup;
+  if (needs_validation) {
+    rmw_ret_t rmw_ret = rmw_validate_full_topic_name(remapped_topic_name, &validation_result, NULL);
+    if (rmw_ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      ret = RCL_RET_ERROR;
+      goto cleanup;
+    }
+    if (validation_result != RMW_TOPIC_VALID) {
+      RCL_SET_ERROR_MSG(rmw_full_topic_name_validation_result_string(validation_result));
+      ret = RCL_RET_TOPIC_NAME_INVALID;
+      goto cleanup;
+    }
   }
-  // Allocate memory for the implementation struct.
-  subscription->impl = (rcl_subscription_impl_t *)allocator->allocate(
-    sizeof(rcl_subscription_impl_t), allocator->state);
+  // Allocate memory for the implementation struct, from the node's slab so
+  // the node's entity impls sit contiguously.
+  subscription->impl = (rcl_subscription_impl_t *)rcl_node_allocate_entity_impl(
+    node, allocator, sizeof(rcl_subscription_impl_t));
   RCL_CHECK_FOR_NULL_WITH_MSG(
     subscription->impl, "allocating memory failed", ret = RCL_RET_BAD_ALLOC; goto cleanup);
+  // Zero the message pool first so the fail path can always inspect it safely.
+  subscription->impl->message_pool = rcl_get_zero_initialized_message_pool();
   // Fill out the implemenation struct.
   // rmw_handle
   // TODO(wjwwood): pass allocator once supported in rmw api.
@@ -172,27 +230,118 @@ rcl_subscription_init(
   }
   // options
   subscription->impl->options = *options;
+  subscription->impl->on_new_message_callback = NULL;
+  subscription->impl->on_new_message_user_data = NULL;
+  // intra-process fast path, matched by the expanded and remapped name
+  subscription->impl->intra_process_guard_condition = rcl_get_zero_initialized_guard_condition();
+  subscription->impl->intra_process_sub = NULL;
+  // serialized buffer recycling state
+  subscription->impl->max_serialized_size = 0;
+  subscription->impl->free_serialized_buffers = NULL;
+  // preallocated message pool
+  if (options->message_pool_size > 0) {
+    ret = rcl_message_pool_init(
+      &subscription->impl->message_pool,
+      options->message_pool_size,
+      options->message_pool_message_bound,
+      *allocator);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto destroy_rmw_handle_and_fail;
+    }
+  }
+  if (options->use_intra_process) {
+    rcl_guard_condition_options_t guard_condition_options =
+      rcl_guard_condition_get_default_options();
+    guard_condition_options.allocator = *allocator;
+    ret = rcl_guard_condition_init(
+      &subscription->impl->intra_process_guard_condition, node->context, guard_condition_options);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      goto destroy_rmw_handle_and_fail;
+    }
+    size_t buffer_capacity = options->intra_process_buffer_size;
+    if (0 == buffer_capacity) {
+      buffer_capacity = RCL_INTRA_PROCESS_BUFFER_SIZE_DEFAULT;
+    }
+    ret = rcl_intra_process_register_subscription(
+      node->context, remapped_topic_name, subscription->impl, buffer_capacity,
+      &subscription->impl->intra_process_guard_condition,
+      &subscription->impl->intra_process_sub);
+    if (RCL_RET_OK != ret) {
+      fail_ret = ret;
+      if (RCL_RET_OK != rcl_guard_condition_fini(
+          &subscription->impl->intra_process_guard_condition))
+      {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini guard condition: %s", rcl_get_error_string().str);
+      }
+      goto destroy_rmw_handle_and_fail;
+    }
+  }
+  // hot path statistics
+  subscription->impl->statistics = NULL;
+  if (options->enable_statistics) {
+    subscription->impl->statistics = rcl_entity_statistics_create(allocator, false);
+    if (!subscription->impl->statistics) {
+      RCL_SET_ERROR_MSG("allocating memory failed");
+      fail_ret = RCL_RET_BAD_ALLOC;
+      if (subscription->impl->intra_process_sub) {
+        if (RCL_RET_OK != rcl_intra_process_unregister_subscription(
+            node->context, subscription->impl))
+        {
+          RCUTILS_LOG_ERROR_NAMED(
+            ROS_PACKAGE_NAME, "failed to unregister intra-process subscription: %s",
+            rcl_get_error_string().str);
+        }
+        if (RCL_RET_OK != rcl_guard_condition_fini(
+            &subscription->impl->intra_process_guard_condition))
+        {
+          RCUTILS_LOG_ERROR_NAMED(
+            ROS_PACKAGE_NAME, "failed to fini guard condition: %s", rcl_get_error_string().str);
+        }
+      }
+      goto destroy_rmw_handle_and_fail;
+    }
+  }
+  // record for bulk teardown by rcl_context_fini_all_entities()
+  rcl_context_track_entity(node->context, RCL_TRACKED_SUBSCRIPTION, subscription, node);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription initialized");
+  RCL_TRACEPOINT_REGISTER("rcl_subscription_init", subscription->impl, remapped_topic_name);
   ret = RCL_RET_OK;
   goto cleanup;
+destroy_rmw_handle_and_fail:
+  if (RMW_RET_OK != rmw_destroy_subscription(
+      rcl_node_get_rmw_handle(node), subscription->impl->rmw_handle))
+  {
+    RCUTILS_LOG_ERROR_NAMED(
+      ROS_PACKAGE_NAME, "failed to destroy rmw subscription: %s", rmw_get_error_string().str);
+  }
+  // Fall through to fail
 fail:
   if (subscription->impl) {
-    allocator->deallocate(subscription->impl, allocator->state);
+    if (subscription->impl->message_pool.storage) {
+      if (RCL_RET_OK != rcl_message_pool_fini(&subscription->impl->message_pool)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to fini message pool");
+      }
+    }
+    rcl_node_deallocate_entity_impl(node, allocator, subscription->impl);
   }
   ret = fail_ret;
   // Fall through to cleanup
 cleanup:
-  if (NULL != expanded_topic_name) {
+  if (NULL != expanded_topic_name && expanded_name_buffer != expanded_topic_name) {
     allocator->deallocate(expanded_topic_name, allocator->state);
   }
-  if (NULL != remapped_topic_name) {
+  if (NULL != remapped_topic_name && expanded_name_buffer != remapped_topic_name) {
     allocator->deallocate(remapped_topic_name, allocator->state);
   }
   return ret;
 }
 
-rcl_ret_t
-rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node)
+static rcl_ret_t
+__rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node, bool deferred)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Finalizing subscription");
   rcl_ret_t result = RCL_RET_OK;
@@ -206,24 +355,91 @@ rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node)
     if (!rmw_node) {
       return RCL_RET_INVALID_ARGUMENT;
     }
-    rmw_ret_t ret =
-      rmw_destroy_subscription(rmw_node, subscription->impl->rmw_handle);
-    if (ret != RMW_RET_OK) {
-      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-      result = RCL_RET_ERROR;
+    rcl_context_untrack_entity(node->context, subscription);
+    if (subscription->impl->message_pool.storage) {
+      rcl_ret_t pool_ret = rcl_message_pool_fini(&subscription->impl->message_pool);
+      if (RCL_RET_OK != pool_ret) {
+        result = RCL_RET_ERROR;
+      }
+    }
+    rcl_serialized_buffer_entry_t * entry = subscription->impl->free_serialized_buffers;
+    while (entry) {
+      rcl_serialized_buffer_entry_t * next_entry = entry->next;
+      if (RCUTILS_RET_OK != rcutils_uint8_array_fini(&entry->serialized_message)) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+      allocator.deallocate(entry, allocator.state);
+      entry = next_entry;
+    }
+    if (subscription->impl->intra_process_sub) {
+      rcl_ret_t unregister_ret = rcl_intra_process_unregister_subscription(
+        node->context, subscription->impl);
+      if (RCL_RET_OK != unregister_ret) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to unregister intra-process subscription: %s",
+          rcl_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+      if (RCL_RET_OK != rcl_guard_condition_fini(
+          &subscription->impl->intra_process_guard_condition))
+      {
+        RCL_SET_ERROR_MSG(rcl_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+    }
+    rcl_entity_statistics_destroy(subscription->impl->statistics, &allocator);
+    bool destroy_inline = true;
+    if (deferred) {
+      rcl_ret_t defer_ret = rcl_context_defer_rmw_destroy(
+        node->context, RCL_RECLAIM_SUBSCRIPTION, rmw_node, subscription->impl->rmw_handle);
+      if (RCL_RET_OK == defer_ret) {
+        destroy_inline = false;
+      } else {
+        // Queueing failed; destroy synchronously rather than leaking.
+        rcl_reset_error();
+      }
     }
-    allocator.deallocate(subscription->impl, allocator.state);
+    if (destroy_inline) {
+      rmw_ret_t ret =
+        rmw_destroy_subscription(rmw_node, subscription->impl->rmw_handle);
+      if (ret != RMW_RET_OK) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        result = RCL_RET_ERROR;
+      }
+    }
+    rcl_node_deallocate_entity_impl(node, &allocator, subscription->impl);
   }
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription finalized");
   return result;
 }
 
+rcl_ret_t
+rcl_subscription_fini(rcl_subscription_t * subscription, rcl_node_t * node)
+{
+  return __rcl_subscription_fini(subscription, node, false);
+}
+
+rcl_ret_t
+rcl_subscription_fini_deferred(rcl_subscription_t * subscription, rcl_node_t * node)
+{
+  return __rcl_subscription_fini(subscription, node, true);
+}
+
 rcl_subscription_options_t
 rcl_subscription_get_default_options()
 {
   // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
   static rcl_subscription_options_t default_options = {
     .ignore_local_publications = false,
+    .use_intra_process = false,
+    .intra_process_buffer_size = 0,  // 0 means RCL_INTRA_PROCESS_BUFFER_SIZE_DEFAULT
+    .message_pool_size = 0,
+    .message_pool_message_bound = 0,
+    .enable_statistics = false,
+    .priority = 0,
+    .content_filter = NULL,
+    .content_filter_context = NULL,
   };
   // Must set the allocator and qos after because they are not a compile time constant.
   default_options.qos = rmw_qos_profile_default;
@@ -238,28 +454,159 @@ rcl_take(
   rmw_message_info_t * message_info)
 {
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription taking message");
-  if (!rcl_subscription_is_valid(subscription)) {
-    return RCL_RET_SUBSCRIPTION_INVALID;  // error message already set
-  }
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_FOR_VALID(rcl_subscription_is_valid(subscription), RCL_RET_SUBSCRIPTION_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_TRACEPOINT("rcl_take_begin", subscription->impl);
 
-  // If message_info is NULL, use a place holder which can be discarded.
-  rmw_message_info_t dummy_message_info;
-  rmw_message_info_t * message_info_local = message_info ? message_info : &dummy_message_info;
-  // Call rmw_take_with_info.
+  // When the caller does not want the message info, use the plain take so
+  // the middleware can skip populating it (gid copies show up in profiles).
+  const rcl_subscription_options_t * sub_options = &subscription->impl->options;
   bool taken = false;
-  rmw_ret_t ret =
-    rmw_take_with_info(subscription->impl->rmw_handle, ros_message, &taken, message_info_local);
-  if (ret != RMW_RET_OK) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    if (RMW_RET_BAD_ALLOC == ret) {
-      return RCL_RET_BAD_ALLOC;
+  rmw_ret_t ret;
+  do {
+    if (message_info) {
+      ret = rmw_take_with_info(subscription->impl->rmw_handle, ros_message, &taken, message_info);
+    } else {
+      ret = rmw_take(subscription->impl->rmw_handle, ros_message, &taken);
     }
-    return RCL_RET_ERROR;
-  }
+    if (ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      rcl_entity_statistics_record_failed(subscription->impl->statistics);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    // Drop messages the content filter rejects and look at the next queued
+    // one, so filtered traffic never reaches the caller.
+  } while (taken && NULL != sub_options->content_filter &&
+    !sub_options->content_filter(ros_message, sub_options->content_filter_context));
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Subscription take succeeded: %s", taken ? "true" : "false");
   if (!taken) {
+    rcl_entity_statistics_record_failed(subscription->impl->statistics);
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  rcl_entity_statistics_record_succeeded(subscription->impl->statistics, 1);
+  RCL_TRACEPOINT("rcl_take_end", subscription->impl);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_take_batch(
+  const rcl_subscription_t * subscription,
+  void ** ros_messages,
+  size_t capacity,
+  size_t * taken,
+  rmw_message_info_t * message_infos)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription taking batch of messages");
+  RCL_HOT_CHECK_FOR_VALID(rcl_subscription_is_valid(subscription), RCL_RET_SUBSCRIPTION_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_messages, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_messages[i], RCL_RET_INVALID_ARGUMENT);
+  }
+  // Drain up to capacity messages, paying the validation above only once.
+  // When the caller does not want the message infos, use the plain take so
+  // the middleware can skip populating them.
+  const rcl_subscription_options_t * sub_options = &subscription->impl->options;
+  while (*taken < capacity) {
+    bool message_taken = false;
+    rmw_ret_t ret;
+    if (message_infos) {
+      ret = rmw_take_with_info(
+        subscription->impl->rmw_handle,
+        ros_messages[*taken],
+        &message_taken,
+        &message_infos[*taken]);
+    } else {
+      ret = rmw_take(subscription->impl->rmw_handle, ros_messages[*taken], &message_taken);
+    }
+    if (ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!message_taken) {
+      break;
+    }
+    if (NULL != sub_options->content_filter &&
+      !sub_options->content_filter(
+        ros_messages[*taken], sub_options->content_filter_context))
+    {
+      // Rejected: reuse the slot for the next queued message.
+      continue;
+    }
+    ++(*taken);
+  }
+  rcl_entity_statistics_record_succeeded(subscription->impl->statistics, *taken);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription batch take took %zu messages", *taken);
+  if (0 == *taken) {
+    return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_subscription_drain(
+  const rcl_subscription_t * subscription,
+  void * ros_message,
+  rmw_message_info_t * message_info,
+  size_t max_messages,
+  rcl_subscription_drain_callback_t callback,
+  void * context,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Subscription draining messages");
+  RCL_HOT_CHECK_FOR_VALID(rcl_subscription_is_valid(subscription), RCL_RET_SUBSCRIPTION_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(taken, RCL_RET_INVALID_ARGUMENT);
+  *taken = 0;
+  // Loop the take inside rcl so one crossing services the whole burst,
+  // reusing the scratch message between callback invocations.
+  // When the caller does not want the message info, use the plain take so
+  // the middleware can skip populating it.
+  const rcl_subscription_options_t * sub_options = &subscription->impl->options;
+  while (0 == max_messages || *taken < max_messages) {
+    bool message_taken = false;
+    rmw_ret_t ret;
+    if (message_info) {
+      ret = rmw_take_with_info(
+        subscription->impl->rmw_handle, ros_message, &message_taken, message_info);
+    } else {
+      ret = rmw_take(subscription->impl->rmw_handle, ros_message, &message_taken);
+    }
+    if (ret != RMW_RET_OK) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      if (RMW_RET_BAD_ALLOC == ret) {
+        return RCL_RET_BAD_ALLOC;
+      }
+      return RCL_RET_ERROR;
+    }
+    if (!message_taken) {
+      break;
+    }
+    if (NULL != sub_options->content_filter &&
+      !sub_options->content_filter(ros_message, sub_options->content_filter_context))
+    {
+      // Rejected: take the next queued message without invoking the callback.
+      continue;
+    }
+    ++(*taken);
+    if (!callback(ros_message, message_info, context)) {
+      break;
+    }
+  }
+  rcl_entity_statistics_record_succeeded(subscription->impl->statistics, *taken);
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Subscription drain delivered %zu messages", *taken);
+  if (0 == *taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
   return RCL_RET_OK;
@@ -295,9 +642,201 @@ rcl_take_serialized_message(
   if (!taken) {
     return RCL_RET_SUBSCRIPTION_TAKE_FAILED;
   }
+  // Track the high-water mark so newly acquired buffers can be sized to fit.
+  if (serialized_message->buffer_length > subscription->impl->max_serialized_size) {
+    subscription->impl->max_serialized_size = serialized_message->buffer_length;
+  }
+  return RCL_RET_OK;
+}
+
+size_t
+rcl_subscription_get_suggested_buffer_size(const rcl_subscription_t * subscription)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return 0;  // error already set
+  }
+  return subscription->impl->max_serialized_size;
+}
+
+rcl_ret_t
+rcl_subscription_acquire_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t ** serialized_message)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
+  rcl_serialized_buffer_entry_t * entry = subscription->impl->free_serialized_buffers;
+  if (entry) {
+    subscription->impl->free_serialized_buffers = entry->next;
+    entry->next = NULL;
+  } else {
+    rcl_allocator_t * allocator = &subscription->impl->options.allocator;
+    entry = (rcl_serialized_buffer_entry_t *)allocator->zero_allocate(
+      1, sizeof(rcl_serialized_buffer_entry_t), allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    entry->serialized_message = rcutils_get_zero_initialized_uint8_array();
+    // Size new buffers to the largest message seen, so steady-state takes
+    // need no growth.
+    rcutils_ret_t rcutils_ret = rcutils_uint8_array_init(
+      &entry->serialized_message, subscription->impl->max_serialized_size, allocator);
+    if (RCUTILS_RET_OK != rcutils_ret) {
+      allocator->deallocate(entry, allocator->state);
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  *serialized_message = &entry->serialized_message;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_subscription_release_serialized_message(
+  const rcl_subscription_t * subscription,
+  rcl_serialized_message_t * serialized_message)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(serialized_message, RCL_RET_INVALID_ARGUMENT);
+  // The serialized message is the first member of its entry.
+  rcl_serialized_buffer_entry_t * entry = (rcl_serialized_buffer_entry_t *)serialized_message;
+  entry->serialized_message.buffer_length = 0;
+  entry->next = subscription->impl->free_serialized_buffers;
+  subscription->impl->free_serialized_buffers = entry;
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_take_loaned_message(
+  const rcl_subscription_t * subscription,
+  void ** loaned_message,
+  rmw_message_info_t * message_info)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+  (void)message_info;
+  // The rmw interface in use has no message loaning entry points yet; see
+  // rcl_subscription_can_loan_messages().
+  RCL_SET_ERROR_MSG("message loaning is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+rcl_ret_t
+rcl_return_loaned_message_from_subscription(
+  const rcl_subscription_t * subscription,
+  void * loaned_message)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(loaned_message, RCL_RET_INVALID_ARGUMENT);
+  RCL_SET_ERROR_MSG("message loaning is not supported by the rmw interface in use");
+  return RCL_RET_UNSUPPORTED;
+}
+
+bool
+rcl_subscription_can_loan_messages(const rcl_subscription_t * subscription)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return false;  // error already set
+  }
+  // Becomes rmw implementation defined once rmw gains loaning entry points.
+  return false;
+}
+
+rcl_ret_t
+rcl_take_intra_process(
+  const rcl_subscription_t * subscription,
+  const void ** ros_message)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_message, RCL_RET_INVALID_ARGUMENT);
+  if (!subscription->impl->intra_process_sub) {
+    RCL_SET_ERROR_MSG("subscription did not opt into the intra-process fast path");
+    return RCL_RET_UNSUPPORTED;
+  }
+  return rcl_intra_process_take(subscription->impl->intra_process_sub, ros_message);
+}
+
+const rcl_guard_condition_t *
+rcl_subscription_get_intra_process_guard_condition(const rcl_subscription_t * subscription)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return NULL;  // error already set
+  }
+  if (!subscription->impl->intra_process_sub) {
+    RCL_SET_ERROR_MSG("subscription did not opt into the intra-process fast path");
+    return NULL;
+  }
+  return &subscription->impl->intra_process_guard_condition;
+}
+
+rcl_ret_t
+rcl_subscription_acquire_pool_message(
+  const rcl_subscription_t * subscription,
+  void ** message_storage)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_storage, RCL_RET_INVALID_ARGUMENT);
+  if (!subscription->impl->message_pool.storage) {
+    RCL_SET_ERROR_MSG("subscription has no message pool configured");
+    return RCL_RET_UNSUPPORTED;
+  }
+  void * storage = rcl_message_pool_acquire(&subscription->impl->message_pool);
+  if (!storage) {
+    return RCL_RET_BAD_ALLOC;  // error already set
+  }
+  *message_storage = storage;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_subscription_release_pool_message(
+  const rcl_subscription_t * subscription,
+  void * message_storage)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_storage, RCL_RET_INVALID_ARGUMENT);
+  if (!subscription->impl->message_pool.storage) {
+    RCL_SET_ERROR_MSG("subscription has no message pool configured");
+    return RCL_RET_UNSUPPORTED;
+  }
+  return rcl_message_pool_release(&subscription->impl->message_pool, message_storage);
+}
+
+rcl_ret_t
+rcl_subscription_get_statistics(
+  const rcl_subscription_t * subscription,
+  rcl_statistics_t * statistics)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(statistics, RCL_RET_INVALID_ARGUMENT);
+  if (!subscription->impl->statistics) {
+    RCL_SET_ERROR_MSG("subscription does not keep statistics");
+    return RCL_RET_UNSUPPORTED;
+  }
+  rcl_entity_statistics_snapshot(subscription->impl->statistics, statistics);
+  return RCL_RET_OK;
+}
+
+rcl_entity_statistics_t *
+rcl_subscription_get_statistics_block(const rcl_subscription_t * subscription)
+{
+  return subscription->impl->statistics;
+}
+
 const char *
 rcl_subscription_get_topic_name(const rcl_subscription_t * subscription)
 {
@@ -357,6 +896,29 @@ rcl_subscription_get_publisher_count(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_subscription_set_on_new_message_callback(
+  const rcl_subscription_t * subscription,
+  rcl_event_callback_t callback,
+  const void * user_data)
+{
+  if (!rcl_subscription_is_valid(subscription)) {
+    return RCL_RET_SUBSCRIPTION_INVALID;  // error already set
+  }
+  subscription->impl->on_new_message_callback = callback;
+  subscription->impl->on_new_message_user_data = user_data;
+  return RCL_RET_OK;
+}
+
+void
+rcl_subscription_dispatch_on_new_message(const rcl_subscription_t * subscription)
+{
+  rcl_event_callback_t callback = subscription->impl->on_new_message_callback;
+  if (NULL != callback) {
+    callback(subscription->impl->on_new_message_user_data, 1);
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
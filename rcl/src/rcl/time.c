@@ -15,6 +15,7 @@
 #include "rcl/time.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include "./common.h"
@@ -23,13 +24,180 @@
 #include "rcutils/stdatomic_helper.h"
 #include "rcutils/time.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define RCL_HAVE_TSC_CLOCK 1
+#endif
+
+#if defined(__linux__)
+#include <time.h>
+#define RCL_HAVE_COARSE_CLOCK 1
+#endif
+
 // Internal storage for RCL_ROS_TIME implementation
 typedef struct rcl_ros_clock_storage_t
 {
-  atomic_uint_least64_t current_time;
-  bool active;
+  // The override state is published as a single 64-bit word so that readers
+  // see a consistent (enabled, value) pair with one wait-free atomic load.
+  // Time values are nonnegative nanosecond counts and fit in 63 bits, so the
+  // top bit carries the override-enabled flag.  The low 63 bits hold the last
+  // override value, with 0 meaning time has not been set.
+  atomic_uint_least64_t state;
+  // Minimum steady-clock spacing between fully applied override updates, or 0
+  // to apply every update (see rcl_ros_clock_set_override_rate_limit()).
+  // Updates arriving inside the window are coalesced: they do not publish
+  // state or fire jump callbacks, they only retarget the interpolation below.
+  atomic_uint_least64_t min_update_period;
+  // Seqlock guarding the interpolation anchors: incremented to odd before a
+  // writer touches them and to even afterwards.  There is one writer, the
+  // thread delivering override updates.
+  atomic_uint_least64_t interp_seq;
+  // Readers in a coalescing gap interpolate linearly from the last applied
+  // override (base) to the newest coalesced one (target) by steady time, and
+  // hold at the target value once they pass it.
+  rcl_time_point_value_t interp_base_value;
+  rcl_time_point_value_t interp_base_steady;
+  rcl_time_point_value_t interp_target_value;
+  rcl_time_point_value_t interp_target_steady;
+  // Steady time of the last fully applied override, written and read only by
+  // the update thread to decide whether the next update falls in the window.
+  rcl_time_point_value_t applied_steady;
 } rcl_ros_clock_storage_t;
 
+#define RCL_ROS_TIME_ACTIVE_FLAG (UINT64_C(1) << 63)
+
+// The jump callbacks fire on every ROS time override update, so the list they
+// are traversed from is managed RCU style: a time jump takes a stable snapshot
+// with one atomic load and never blocks, while registration builds a fresh
+// snapshot, swaps it in atomically, and reclaims the old one only after
+// in-flight traversals have drained.
+typedef struct rcl_jump_callback_snapshot_t
+{
+  size_t count;
+  rcl_jump_callback_info_t entries[];
+} rcl_jump_callback_snapshot_t;
+
+typedef struct rcl_jump_callback_list_t
+{
+  // Current rcl_jump_callback_snapshot_t, or 0 when no callbacks are added.
+  atomic_uintptr_t snapshot;
+  // Number of traversals currently in flight.
+  atomic_uint_least64_t readers;
+} rcl_jump_callback_list_t;
+
+// Build a snapshot of the registration-side callback array, sized for `count`
+// entries.  Returns NULL on allocation failure or when count is zero.
+static rcl_jump_callback_snapshot_t *
+_rcl_jump_callback_snapshot_create(const rcl_clock_t * clock, size_t count)
+{
+  if (0 == count) {
+    return NULL;
+  }
+  rcl_jump_callback_snapshot_t * snapshot = clock->allocator.allocate(
+    sizeof(rcl_jump_callback_snapshot_t) + count * sizeof(rcl_jump_callback_info_t),
+    clock->allocator.state);
+  if (NULL != snapshot) {
+    snapshot->count = count;
+  }
+  return snapshot;
+}
+
+// Swap the published snapshot and free the previous one once no traversal can
+// still be using it.  Readers only hold a snapshot across a handful of
+// callback invocations, so the drain resolves quickly; registration is not a
+// hot path and may spin here.
+static void
+_rcl_jump_callback_list_publish(
+  rcl_clock_t * clock, rcl_jump_callback_snapshot_t * snapshot)
+{
+  rcl_jump_callback_list_t * list = clock->jump_callback_list;
+  uintptr_t old_ptr;
+  rcutils_atomic_exchange(&(list->snapshot), old_ptr, (uintptr_t)snapshot);
+  uint64_t readers;
+  do {
+    rcutils_atomic_load(&(list->readers), readers);
+  } while (0 != readers);
+  if (0 != old_ptr) {
+    clock->allocator.deallocate((rcl_jump_callback_snapshot_t *)old_ptr, clock->allocator.state);
+  }
+}
+
+#ifdef RCL_HAVE_TSC_CLOCK
+// Internal storage for the TSC backed RCL_STEADY_TIME implementation
+typedef struct rcl_tsc_clock_storage_t
+{
+  // Tick count and steady time captured together at the last anchor point.
+  uint64_t tsc_base;
+  rcl_time_point_value_t time_base;
+  // Nanoseconds per tick, measured once at init.
+  double ns_per_tick;
+  // Ticks after which the offset is re-anchored to the steady clock.
+  uint64_t reanchor_interval_ticks;
+  // Last value handed out, to keep reads monotonic across re-anchoring.
+  rcl_time_point_value_t last_time;
+} rcl_tsc_clock_storage_t;
+
+// How long init spends measuring the tick rate.
+#define RCL_TSC_CALIBRATION_DURATION_NS (2 * 1000 * 1000)
+// How much runtime may pass between offset re-anchors.
+#define RCL_TSC_REANCHOR_INTERVAL_NS (1000 * 1000 * 1000)
+
+static bool
+_rcl_tsc_is_invariant(void)
+{
+  // CPUID.80000007H:EDX[8] is the invariant TSC flag; without it the
+  // counter may change rate with power states and is useless as a clock.
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (0 == __get_cpuid(0x80000000u, &eax, &ebx, &ecx, &edx) || eax < 0x80000007u) {
+    return false;
+  }
+  if (0 == __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return 0 != (edx & (1u << 8));
+}
+
+// Capture a (tick count, steady time) pair; the tick count is read on both
+// sides of the system call and averaged to center it on the time sample.
+static rcl_ret_t
+_rcl_tsc_sample(uint64_t * tsc, rcl_time_point_value_t * time)
+{
+  uint64_t before = __rdtsc();
+  rcl_ret_t ret = rcutils_steady_time_now(time);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  uint64_t after = __rdtsc();
+  *tsc = before + (after - before) / 2;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static rcl_ret_t
+rcl_get_steady_time_tsc(void * data, rcl_time_point_value_t * current_time)
+{
+  rcl_tsc_clock_storage_t * storage = (rcl_tsc_clock_storage_t *)data;
+  uint64_t ticks = __rdtsc() - storage->tsc_base;
+  if (ticks > storage->reanchor_interval_ticks) {
+    // bound accumulated rate error by re-anchoring on the steady clock
+    rcl_ret_t ret = _rcl_tsc_sample(&storage->tsc_base, &storage->time_base);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+    ticks = __rdtsc() - storage->tsc_base;
+  }
+  rcl_time_point_value_t now =
+    storage->time_base + (rcl_time_point_value_t)((double)ticks * storage->ns_per_tick);
+  if (now < storage->last_time) {
+    now = storage->last_time;
+  }
+  storage->last_time = now;
+  *current_time = now;
+  return RCL_RET_OK;
+}
+#endif  // RCL_HAVE_TSC_CLOCK
+
 // Implementation only
 rcl_ret_t
 rcl_get_steady_time(void * data, rcl_time_point_value_t * current_time)
@@ -53,6 +221,7 @@ rcl_init_generic_clock(rcl_clock_t * clock)
   clock->type = RCL_CLOCK_UNINITIALIZED;
   clock->jump_callbacks = NULL;
   clock->num_jump_callbacks = 0u;
+  clock->jump_callback_list = NULL;
   clock->get_now = NULL;
   clock->data = NULL;
 }
@@ -63,10 +232,54 @@ rcl_ret_t
 rcl_get_ros_time(void * data, rcl_time_point_value_t * current_time)
 {
   rcl_ros_clock_storage_t * t = (rcl_ros_clock_storage_t *)data;
-  if (!t->active) {
+  uint64_t state = rcutils_atomic_load_uint64_t(&(t->state));
+  if (0 == (state & RCL_ROS_TIME_ACTIVE_FLAG)) {
     return rcl_get_system_time(data, current_time);
   }
-  *current_time = rcutils_atomic_load_uint64_t(&(t->current_time));
+  if (0 != rcutils_atomic_load_uint64_t(&(t->min_update_period))) {
+    // Override updates are being coalesced; interpolate between the last
+    // applied value and the newest received one so reads in the gap advance
+    // smoothly instead of repeating the applied value.
+    rcl_time_point_value_t base_value, base_steady, target_value, target_steady;
+    uint64_t seq;
+    do {
+      seq = rcutils_atomic_load_uint64_t(&(t->interp_seq));
+      if (0 != (seq & 1u)) {
+        continue;  // a writer is mid-update, reread
+      }
+      base_value = t->interp_base_value;
+      base_steady = t->interp_base_steady;
+      target_value = t->interp_target_value;
+      target_steady = t->interp_target_steady;
+    } while (seq != rcutils_atomic_load_uint64_t(&(t->interp_seq)));
+    rcl_time_point_value_t published =
+      (rcl_time_point_value_t)(state & ~RCL_ROS_TIME_ACTIVE_FLAG);
+    rcl_time_point_value_t value = published;
+    if (target_value > base_value && target_steady > base_steady) {
+      rcl_time_point_value_t steady_now = 0;
+      if (RCUTILS_RET_OK != rcutils_steady_time_now(&steady_now)) {
+        RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+        return RCL_RET_ERROR;
+      }
+      if (steady_now >= target_steady) {
+        value = target_value;
+      } else {
+        value = base_value +
+          (target_value - base_value) * (steady_now - base_steady) /
+          (target_steady - base_steady);
+      }
+    } else if (0 != target_value) {
+      value = target_value;
+    }
+    if (value < published) {
+      // Stale anchors (e.g. the limit was just reconfigured) must not make
+      // time appear to run behind the published state.
+      value = published;
+    }
+    *current_time = value;
+    return RCL_RET_OK;
+  }
+  *current_time = (rcl_time_point_value_t)(state & ~RCL_ROS_TIME_ACTIVE_FLAG);
   return RCL_RET_OK;
 }
 
@@ -114,6 +327,17 @@ _rcl_clock_generic_fini(
     clock->allocator.deallocate(clock->jump_callbacks, clock->allocator.state);
     clock->jump_callbacks = NULL;
   }
+  if (NULL != clock->jump_callback_list) {
+    // No traversal can be in flight while the clock is being finalized.
+    uintptr_t snap_ptr;
+    rcutils_atomic_load(&(clock->jump_callback_list->snapshot), snap_ptr);
+    if (0 != snap_ptr) {
+      clock->allocator.deallocate(
+        (rcl_jump_callback_snapshot_t *)snap_ptr, clock->allocator.state);
+    }
+    clock->allocator.deallocate(clock->jump_callback_list, clock->allocator.state);
+    clock->jump_callback_list = NULL;
+  }
 }
 
 rcl_ret_t
@@ -147,9 +371,15 @@ rcl_ros_clock_init(
   rcl_init_generic_clock(clock);
   clock->data = allocator->allocate(sizeof(rcl_ros_clock_storage_t), allocator->state);
   rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
-  // 0 is a special value meaning time has not been set
-  atomic_init(&(storage->current_time), 0);
-  storage->active = false;
+  // 0 is a special value meaning time has not been set and not overridden
+  atomic_init(&(storage->state), 0);
+  atomic_init(&(storage->min_update_period), 0);
+  atomic_init(&(storage->interp_seq), 0);
+  storage->interp_base_value = 0;
+  storage->interp_base_steady = 0;
+  storage->interp_target_value = 0;
+  storage->interp_target_steady = 0;
+  storage->applied_steady = 0;
   clock->get_now = rcl_get_ros_time;
   clock->type = RCL_ROS_TIME;
   clock->allocator = *allocator;
@@ -188,6 +418,54 @@ rcl_steady_clock_init(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_steady_clock_init_fast(
+  rcl_clock_t * clock,
+  rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+#ifdef RCL_HAVE_TSC_CLOCK
+  if (!_rcl_tsc_is_invariant()) {
+    return rcl_steady_clock_init(clock, allocator);
+  }
+  rcl_tsc_clock_storage_t * storage = (rcl_tsc_clock_storage_t *)allocator->zero_allocate(
+    1, sizeof(rcl_tsc_clock_storage_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(storage, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  // Measure the tick rate against the steady clock over a short interval.
+  uint64_t start_tsc = 0, end_tsc = 0;
+  rcl_time_point_value_t start_time = 0, end_time = 0;
+  rcl_ret_t ret = _rcl_tsc_sample(&start_tsc, &start_time);
+  while (RCL_RET_OK == ret) {
+    ret = _rcl_tsc_sample(&end_tsc, &end_time);
+    if (end_time - start_time >= RCL_TSC_CALIBRATION_DURATION_NS) {
+      break;
+    }
+  }
+  if (RCL_RET_OK != ret || end_tsc <= start_tsc) {
+    // calibration failed; fall back to the system call backend
+    allocator->deallocate(storage, allocator->state);
+    rcl_reset_error();
+    return rcl_steady_clock_init(clock, allocator);
+  }
+  storage->ns_per_tick = (double)(end_time - start_time) / (double)(end_tsc - start_tsc);
+  storage->reanchor_interval_ticks =
+    (uint64_t)((double)RCL_TSC_REANCHOR_INTERVAL_NS / storage->ns_per_tick);
+  storage->tsc_base = end_tsc;
+  storage->time_base = end_time;
+  storage->last_time = end_time;
+  rcl_init_generic_clock(clock);
+  clock->data = storage;
+  clock->get_now = rcl_get_steady_time_tsc;
+  clock->type = RCL_STEADY_TIME;
+  clock->allocator = *allocator;
+  return RCL_RET_OK;
+#else
+  // no usable tick counter on this platform
+  return rcl_steady_clock_init(clock, allocator);
+#endif  // RCL_HAVE_TSC_CLOCK
+}
+
 rcl_ret_t
 rcl_steady_clock_fini(
   rcl_clock_t * clock)
@@ -198,6 +476,11 @@ rcl_steady_clock_fini(
     return RCL_RET_ERROR;
   }
   _rcl_clock_generic_fini(clock);
+  if (NULL != clock->data) {
+    // the fast backend's calibration storage, see rcl_steady_clock_init_fast()
+    clock->allocator.deallocate(clock->data, clock->allocator.state);
+    clock->data = NULL;
+  }
   return RCL_RET_OK;
 }
 
@@ -215,6 +498,44 @@ rcl_system_clock_init(
   return RCL_RET_OK;
 }
 
+#ifdef RCL_HAVE_COARSE_CLOCK
+// Implementation only
+static rcl_ret_t
+rcl_get_system_time_coarse(void * data, rcl_time_point_value_t * current_time)
+{
+  (void)data;  // unused
+  // The coarse clock is the kernel's last tick timestamp; reading it avoids
+  // the hardware clock read a full time query pays for.
+  struct timespec timespec_now;
+  if (0 != clock_gettime(CLOCK_REALTIME_COARSE, &timespec_now)) {
+    RCL_SET_ERROR_MSG("failed to read the coarse system clock");
+    return RCL_RET_ERROR;
+  }
+  *current_time = RCL_S_TO_NS((rcl_time_point_value_t)timespec_now.tv_sec) +
+    timespec_now.tv_nsec;
+  return RCL_RET_OK;
+}
+#endif  // RCL_HAVE_COARSE_CLOCK
+
+rcl_ret_t
+rcl_system_clock_init_coarse(
+  rcl_clock_t * clock,
+  rcl_allocator_t * allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(allocator, RCL_RET_INVALID_ARGUMENT);
+#ifdef RCL_HAVE_COARSE_CLOCK
+  rcl_init_generic_clock(clock);
+  clock->get_now = rcl_get_system_time_coarse;
+  clock->type = RCL_SYSTEM_TIME;
+  clock->allocator = *allocator;
+  return RCL_RET_OK;
+#else
+  // No coarse source on this platform; fall back to the regular backend.
+  return rcl_system_clock_init(clock, allocator);
+#endif  // RCL_HAVE_COARSE_CLOCK
+}
+
 rcl_ret_t
 rcl_system_clock_fini(
   rcl_clock_t * clock)
@@ -236,12 +557,8 @@ rcl_difference_times(
     RCL_SET_ERROR_MSG("Cannot difference between time points with clocks types.");
     return RCL_RET_ERROR;
   }
-  if (finish->nanoseconds < start->nanoseconds) {
-    rcl_time_point_value_t intermediate = start->nanoseconds - finish->nanoseconds;
-    delta->nanoseconds = -1 * (int64_t) intermediate;
-  } else {
-    delta->nanoseconds = (int64_t)(finish->nanoseconds - start->nanoseconds);
-  }
+  delta->nanoseconds =
+    rcl_difference_time_point_values(start->nanoseconds, finish->nanoseconds);
   return RCL_RET_OK;
 }
 
@@ -262,20 +579,38 @@ _rcl_clock_call_callbacks(
   rcl_clock_t * clock, const rcl_time_jump_t * time_jump, bool before_jump)
 {
   // Internal function; assume parameters are valid.
+  rcl_jump_callback_list_t * list = clock->jump_callback_list;
+  if (NULL == list) {
+    // No callback was ever registered on this clock.
+    return;
+  }
   bool is_clock_change = time_jump->clock_change == RCL_ROS_TIME_ACTIVATED ||
     time_jump->clock_change == RCL_ROS_TIME_DEACTIVATED;
-  for (size_t cb_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
-    rcl_jump_callback_info_t * info = &(clock->jump_callbacks[cb_idx]);
-    if (
-      (is_clock_change && info->threshold.on_clock_change) ||
-      (time_jump->delta.nanoseconds < 0 &&
-      time_jump->delta.nanoseconds <= info->threshold.min_backward.nanoseconds) ||
-      (time_jump->delta.nanoseconds > 0 &&
-      time_jump->delta.nanoseconds >= info->threshold.min_forward.nanoseconds))
-    {
-      info->callback(time_jump, before_jump, info->user_data);
+  // Announce the traversal before taking the snapshot, so registration waits
+  // for it before reclaiming the snapshot's memory.
+  uint64_t unused;
+  rcutils_atomic_fetch_add(&(list->readers), unused, 1);
+  (void)unused;
+  uintptr_t snap_ptr;
+  rcutils_atomic_load(&(list->snapshot), snap_ptr);
+  const rcl_jump_callback_snapshot_t * snapshot =
+    (const rcl_jump_callback_snapshot_t *)snap_ptr;
+  if (NULL != snapshot) {
+    for (size_t cb_idx = 0; cb_idx < snapshot->count; ++cb_idx) {
+      const rcl_jump_callback_info_t * info = &(snapshot->entries[cb_idx]);
+      if (
+        (is_clock_change && info->threshold.on_clock_change) ||
+        (time_jump->delta.nanoseconds < 0 &&
+        time_jump->delta.nanoseconds <= info->threshold.min_backward.nanoseconds) ||
+        (time_jump->delta.nanoseconds > 0 &&
+        time_jump->delta.nanoseconds >= info->threshold.min_forward.nanoseconds))
+      {
+        info->callback(time_jump, before_jump, info->user_data);
+      }
     }
   }
+  rcutils_atomic_fetch_add(&(list->readers), unused, (uint64_t)-1);
+  (void)unused;
 }
 
 rcl_ret_t
@@ -291,12 +626,13 @@ rcl_enable_ros_time_override(rcl_clock_t * clock)
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot enable override.");
     return RCL_RET_ERROR;
   }
-  if (!storage->active) {
+  uint64_t state = rcutils_atomic_load_uint64_t(&(storage->state));
+  if (0 == (state & RCL_ROS_TIME_ACTIVE_FLAG)) {
     rcl_time_jump_t time_jump;
     time_jump.delta.nanoseconds = 0;
     time_jump.clock_change = RCL_ROS_TIME_ACTIVATED;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
-    storage->active = true;
+    rcutils_atomic_store(&(storage->state), state | RCL_ROS_TIME_ACTIVE_FLAG);
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
@@ -316,12 +652,13 @@ rcl_disable_ros_time_override(rcl_clock_t * clock)
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot disable override.");
     return RCL_RET_ERROR;
   }
-  if (storage->active) {
+  uint64_t state = rcutils_atomic_load_uint64_t(&(storage->state));
+  if (0 != (state & RCL_ROS_TIME_ACTIVE_FLAG)) {
     rcl_time_jump_t time_jump;
     time_jump.delta.nanoseconds = 0;
     time_jump.clock_change = RCL_ROS_TIME_DEACTIVATED;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
-    storage->active = false;
+    rcutils_atomic_store(&(storage->state), state & ~RCL_ROS_TIME_ACTIVE_FLAG);
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
@@ -344,7 +681,8 @@ rcl_is_enabled_ros_time_override(
     RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot query override state.");
     return RCL_RET_ERROR;
   }
-  *is_enabled = storage->active;
+  *is_enabled =
+    0 != (rcutils_atomic_load_uint64_t(&(storage->state)) & RCL_ROS_TIME_ACTIVE_FLAG);
   return RCL_RET_OK;
 }
 
@@ -360,7 +698,44 @@ rcl_set_ros_time_override(
   }
   rcl_time_jump_t time_jump;
   rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
-  if (storage->active) {
+  uint64_t state = rcutils_atomic_load_uint64_t(&(storage->state));
+  bool active = 0 != (state & RCL_ROS_TIME_ACTIVE_FLAG);
+  const uint64_t min_period = rcutils_atomic_load_uint64_t(&(storage->min_update_period));
+  rcl_time_point_value_t steady_now = 0;
+  if (active && min_period > 0) {
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&steady_now)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    if (0 != storage->applied_steady &&
+      steady_now - storage->applied_steady < (rcl_time_point_value_t)min_period &&
+      time_value >= storage->interp_target_value)
+    {
+      // Coalesce: retarget the interpolation without publishing state or
+      // walking the jump callbacks.  Readers ramp from the current
+      // interpolated value to the new one over the observed update spacing,
+      // reaching it about when the next update is due.  Backward jumps never
+      // take this path; they are applied (and announced) immediately.
+      rcl_time_point_value_t current_value = 0;
+      rcl_ret_t ret = rcl_get_ros_time(storage, &current_value);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+      rcl_time_point_value_t gap = steady_now - storage->interp_target_steady;
+      if (gap < 0 || gap > (rcl_time_point_value_t)min_period) {
+        gap = 0;
+      }
+      uint64_t seq = rcutils_atomic_load_uint64_t(&(storage->interp_seq));
+      rcutils_atomic_store(&(storage->interp_seq), seq + 1);
+      storage->interp_base_value = current_value;
+      storage->interp_base_steady = steady_now;
+      storage->interp_target_value = time_value;
+      storage->interp_target_steady = steady_now + gap;
+      rcutils_atomic_store(&(storage->interp_seq), seq + 2);
+      return RCL_RET_OK;
+    }
+  }
+  if (active) {
     time_jump.clock_change = RCL_ROS_TIME_NO_CHANGE;
     rcl_time_point_value_t current_time;
     rcl_ret_t ret = rcl_get_ros_time(storage, &current_time);
@@ -370,13 +745,63 @@ rcl_set_ros_time_override(
     time_jump.delta.nanoseconds = time_value - current_time;
     _rcl_clock_call_callbacks(clock, &time_jump, true);
   }
-  rcutils_atomic_store(&(storage->current_time), time_value);
-  if (storage->active) {
+  if (active && min_period > 0) {
+    // This update is fully applied; snap the interpolation anchors to it so
+    // readers in the next coalescing window start from here.
+    uint64_t seq = rcutils_atomic_load_uint64_t(&(storage->interp_seq));
+    rcutils_atomic_store(&(storage->interp_seq), seq + 1);
+    storage->interp_base_value = time_value;
+    storage->interp_base_steady = steady_now;
+    storage->interp_target_value = time_value;
+    storage->interp_target_steady = steady_now;
+    rcutils_atomic_store(&(storage->interp_seq), seq + 2);
+    storage->applied_steady = steady_now;
+  }
+  // Publish the value and the current flag together so a concurrent reader
+  // never observes the override enabled without its value (or vice versa).
+  rcutils_atomic_store(
+    &(storage->state),
+    ((uint64_t)time_value & ~RCL_ROS_TIME_ACTIVE_FLAG) |
+    (active ? RCL_ROS_TIME_ACTIVE_FLAG : 0));
+  if (active) {
     _rcl_clock_call_callbacks(clock, &time_jump, false);
   }
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_ros_clock_set_override_rate_limit(
+  rcl_clock_t * clock,
+  uint64_t min_update_period_ns)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  if (clock->type != RCL_ROS_TIME) {
+    RCL_SET_ERROR_MSG("Clock is not of type RCL_ROS_TIME, cannot set override rate limit.");
+    return RCL_RET_ERROR;
+  }
+  rcl_ros_clock_storage_t * storage = (rcl_ros_clock_storage_t *)clock->data;
+  if (!storage) {
+    RCL_SET_ERROR_MSG("Clock storage is not initialized, cannot set override rate limit.");
+    return RCL_RET_ERROR;
+  }
+  rcutils_atomic_store(&(storage->min_update_period), min_update_period_ns);
+  if (0 == min_update_period_ns) {
+    // Catch the published state up to the newest coalesced value so reads do
+    // not go backward once interpolation stops.
+    uint64_t state = rcutils_atomic_load_uint64_t(&(storage->state));
+    if (0 != (state & RCL_ROS_TIME_ACTIVE_FLAG) &&
+      storage->interp_target_value >
+      (rcl_time_point_value_t)(state & ~RCL_ROS_TIME_ACTIVE_FLAG))
+    {
+      rcutils_atomic_store(
+        &(storage->state),
+        ((uint64_t)storage->interp_target_value & ~RCL_ROS_TIME_ACTIVE_FLAG) |
+        RCL_ROS_TIME_ACTIVE_FLAG);
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_clock_add_jump_callback(
   rcl_clock_t * clock, rcl_jump_threshold_t threshold, rcl_jump_callback_t callback,
@@ -405,11 +830,40 @@ rcl_clock_add_jump_callback(
     }
   }
 
+  // The published list is created on the first registration
+  if (NULL == clock->jump_callback_list) {
+    rcl_jump_callback_list_t * list = clock->allocator.allocate(
+      sizeof(rcl_jump_callback_list_t), clock->allocator.state);
+    if (NULL == list) {
+      RCL_SET_ERROR_MSG("Failed to allocate jump callback list");
+      return RCL_RET_BAD_ALLOC;
+    }
+    atomic_init(&(list->snapshot), 0);
+    atomic_init(&(list->readers), 0);
+    clock->jump_callback_list = list;
+  }
+
+  // Build the new snapshot before touching the registration-side array, so a
+  // failure leaves both views unchanged
+  rcl_jump_callback_snapshot_t * snapshot =
+    _rcl_jump_callback_snapshot_create(clock, clock->num_jump_callbacks + 1);
+  if (NULL == snapshot) {
+    RCL_SET_ERROR_MSG("Failed to allocate jump callback snapshot");
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t cb_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
+    snapshot->entries[cb_idx] = clock->jump_callbacks[cb_idx];
+  }
+  snapshot->entries[clock->num_jump_callbacks].callback = callback;
+  snapshot->entries[clock->num_jump_callbacks].threshold = threshold;
+  snapshot->entries[clock->num_jump_callbacks].user_data = user_data;
+
   // Add the new callback, increasing the size of the callback list
   rcl_jump_callback_info_t * callbacks = clock->allocator.reallocate(
     clock->jump_callbacks, sizeof(rcl_jump_callback_info_t) * (clock->num_jump_callbacks + 1),
     clock->allocator.state);
   if (NULL == callbacks) {
+    clock->allocator.deallocate(snapshot, clock->allocator.state);
     RCL_SET_ERROR_MSG("Failed to realloc jump callbacks");
     return RCL_RET_BAD_ALLOC;
   }
@@ -418,6 +872,7 @@ rcl_clock_add_jump_callback(
   clock->jump_callbacks[clock->num_jump_callbacks].threshold = threshold;
   clock->jump_callbacks[clock->num_jump_callbacks].user_data = user_data;
   ++(clock->num_jump_callbacks);
+  _rcl_jump_callback_list_publish(clock, snapshot);
   return RCL_RET_OK;
 }
 
@@ -431,14 +886,15 @@ rcl_clock_remove_jump_callback(
     return RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(callback, RCL_RET_INVALID_ARGUMENT);
 
-  // Delete callback if found, moving all callbacks after back one
+  // Find the callback to be removed
   bool found_callback = false;
+  size_t removed_idx = 0;
   for (size_t cb_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
     const rcl_jump_callback_info_t * info = &(clock->jump_callbacks[cb_idx]);
-    if (found_callback) {
-      clock->jump_callbacks[cb_idx - 1] = *info;
-    } else if (info->callback == callback && info->user_data == user_data) {
+    if (info->callback == callback && info->user_data == user_data) {
       found_callback = true;
+      removed_idx = cb_idx;
+      break;
     }
   }
   if (!found_callback) {
@@ -446,6 +902,28 @@ rcl_clock_remove_jump_callback(
     return RCL_RET_ERROR;
   }
 
+  // Build the new snapshot before touching the registration-side array, so a
+  // failure leaves both views unchanged
+  rcl_jump_callback_snapshot_t * snapshot = NULL;
+  if (clock->num_jump_callbacks > 1) {
+    snapshot = _rcl_jump_callback_snapshot_create(clock, clock->num_jump_callbacks - 1);
+    if (NULL == snapshot) {
+      RCL_SET_ERROR_MSG("Failed to allocate jump callback snapshot");
+      return RCL_RET_BAD_ALLOC;
+    }
+    for (size_t cb_idx = 0, out_idx = 0; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
+      if (cb_idx != removed_idx) {
+        snapshot->entries[out_idx++] = clock->jump_callbacks[cb_idx];
+      }
+    }
+  }
+
+  // Delete the callback, moving all callbacks after back one
+  for (size_t cb_idx = removed_idx + 1; cb_idx < clock->num_jump_callbacks; ++cb_idx) {
+    clock->jump_callbacks[cb_idx - 1] = clock->jump_callbacks[cb_idx];
+  }
+  _rcl_jump_callback_list_publish(clock, snapshot);
+
   // Shrink size of the callback array
   if (clock->num_jump_callbacks == 1) {
     clock->allocator.deallocate(clock->jump_callbacks, clock->allocator.state);
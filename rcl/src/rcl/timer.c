@@ -22,33 +22,20 @@ extern "C"
 #include <inttypes.h>
 
 #include "rcl/error_handling.h"
+#include "rcl/tracepoints.h"
 #include "rcutils/logging_macros.h"
 #include "rcutils/stdatomic_helper.h"
 #include "rcutils/time.h"
 
-typedef struct rcl_timer_impl_t
+#include "./timer_impl.h"
+
+// Note a change to the timer's schedule or canceled state so that cached
+// deadlines (e.g. in a wait set) are refreshed.
+static void
+__timer_mark_modified(const rcl_timer_t * timer)
 {
-  // The clock providing time.
-  rcl_clock_t * clock;
-  // The associated context.
-  rcl_context_t * context;
-  // A guard condition used to wake a wait set if using ROSTime, else zero initialized.
-  rcl_guard_condition_t guard_condition;
-  // The user supplied callback.
-  atomic_uintptr_t callback;
-  // This is a duration in nanoseconds.
-  atomic_uint_least64_t period;
-  // This is a time in nanoseconds since an unspecified time.
-  atomic_int_least64_t last_call_time;
-  // This is a time in nanoseconds since an unspecified time.
-  atomic_int_least64_t next_call_time;
-  // Credit for time elapsed before ROS time is activated or deactivated.
-  atomic_int_least64_t time_credit;
-  // A flag which indicates if the timer is canceled.
-  atomic_bool canceled;
-  // The user supplied allocator.
-  rcl_allocator_t allocator;
-} rcl_timer_impl_t;
+  atomic_fetch_add(&timer->impl->modification_count, 1);
+}
 
 rcl_timer_t
 rcl_get_zero_initialized_timer()
@@ -69,7 +56,7 @@ void _rcl_timer_time_jump(
       RCL_ROS_TIME_DEACTIVATED == time_jump->clock_change)
     {
       rcl_time_point_value_t now;
-      if (RCL_RET_OK != rcl_clock_get_now(timer->impl->clock, &now)) {
+      if (RCL_RET_OK != rcl_clock_get_now_fast(timer->impl->clock, &now)) {
         RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to get current time in jump callback");
         return;
       }
@@ -84,7 +71,7 @@ void _rcl_timer_time_jump(
     }
   } else {
     rcl_time_point_value_t now;
-    if (RCL_RET_OK != rcl_clock_get_now(timer->impl->clock, &now)) {
+    if (RCL_RET_OK != rcl_clock_get_now_fast(timer->impl->clock, &now)) {
       RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to get current time in jump callback");
       return;
     }
@@ -94,6 +81,13 @@ void _rcl_timer_time_jump(
     if (RCL_ROS_TIME_ACTIVATED == time_jump->clock_change ||
       RCL_ROS_TIME_DEACTIVATED == time_jump->clock_change)
     {
+      // The time source changed; wake any wait in flight so it recomputes
+      // its timeout for the new source (an override-driven clock relies on
+      // this guard condition, a system-time-driven one on the timeout).
+      if (RCL_RET_OK != rcl_trigger_guard_condition(&timer->impl->guard_condition)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "Failed to trigger guard condition in jump callback");
+      }
       // ROS time activated or deactivated
       if (0 == now) {
         // Can't apply time credit if clock is uninitialized
@@ -104,6 +98,7 @@ void _rcl_timer_time_jump(
         // set times in new epoch so timer only waits the remainder of the period
         rcutils_atomic_store(&timer->impl->next_call_time, now - time_credit + period);
         rcutils_atomic_store(&timer->impl->last_call_time, now - time_credit);
+        __timer_mark_modified(timer);
       }
     } else if (next_call_time <= now) {
       // Post Forward jump and timer is ready
@@ -116,6 +111,7 @@ void _rcl_timer_time_jump(
       // next callback should happen after 1 period
       rcutils_atomic_store(&timer->impl->next_call_time, now + period);
       rcutils_atomic_store(&timer->impl->last_call_time, now);
+      __timer_mark_modified(timer);
       return;
     }
   }
@@ -129,6 +125,20 @@ rcl_timer_init(
   int64_t period,
   const rcl_timer_callback_t callback,
   rcl_allocator_t allocator)
+{
+  return rcl_timer_init_with_user_data(
+    timer, clock, context, period, callback, NULL, allocator);
+}
+
+rcl_ret_t
+rcl_timer_init_with_user_data(
+  rcl_timer_t * timer,
+  rcl_clock_t * clock,
+  rcl_context_t * context,
+  int64_t period,
+  const rcl_timer_callback_t callback,
+  void * user_data,
+  rcl_allocator_t allocator)
 {
   RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
@@ -144,7 +154,7 @@ rcl_timer_init(
     return RCL_RET_ALREADY_INIT;
   }
   rcl_time_point_value_t now;
-  rcl_ret_t now_ret = rcl_clock_get_now(clock, &now);
+  rcl_ret_t now_ret = rcl_clock_get_now_fast(clock, &now);
   if (now_ret != RCL_RET_OK) {
     return now_ret;  // rcl error state should already be set.
   }
@@ -173,11 +183,13 @@ rcl_timer_init(
     }
   }
   atomic_init(&impl.callback, (uintptr_t)callback);
+  impl.user_data = user_data;
   atomic_init(&impl.period, period);
   atomic_init(&impl.time_credit, 0);
   atomic_init(&impl.last_call_time, now);
   atomic_init(&impl.next_call_time, now + period);
   atomic_init(&impl.canceled, false);
+  atomic_init(&impl.modification_count, 0);
   impl.allocator = allocator;
   timer->impl = (rcl_timer_impl_t *)allocator.allocate(sizeof(rcl_timer_impl_t), allocator.state);
   if (NULL == timer->impl) {
@@ -233,20 +245,21 @@ rcl_timer_clock(rcl_timer_t * timer, rcl_clock_t ** clock)
   return RCL_RET_OK;
 }
 
-rcl_ret_t
-rcl_timer_call(rcl_timer_t * timer)
+void *
+rcl_timer_get_user_data(const rcl_timer_t * timer)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer, "timer is invalid", return NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return NULL);
+  return timer->impl->user_data;
+}
+
+// Service a timer given an already sampled current time, optionally reporting
+// how many whole periods beyond the first had to be skipped to move the next
+// call time past now.
+static rcl_ret_t
+__timer_call_with_now(
+  rcl_timer_t * timer, rcl_time_point_value_t now, uint64_t * missed_periods)
 {
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Calling timer");
-  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
-  if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
-    RCL_SET_ERROR_MSG("timer is canceled");
-    return RCL_RET_TIMER_CANCELED;
-  }
-  rcl_time_point_value_t now;
-  rcl_ret_t now_ret = rcl_clock_get_now(timer->impl->clock, &now);
-  if (now_ret != RCL_RET_OK) {
-    return now_ret;  // rcl error state should already be set.
-  }
   if (now < 0) {
     RCL_SET_ERROR_MSG("clock now returned negative time point value");
     return RCL_RET_ERROR;
@@ -273,9 +286,13 @@ rcl_timer_call(rcl_timer_t * timer)
       // rounding up without overflow
       int64_t periods_ahead = 1 + (now_ahead - 1) / period;
       next_call_time += periods_ahead * period;
+      if (NULL != missed_periods) {
+        *missed_periods = (uint64_t)periods_ahead;
+      }
     }
   }
   rcutils_atomic_store(&timer->impl->next_call_time, next_call_time);
+  __timer_mark_modified(timer);
 
   if (typed_callback != NULL) {
     int64_t since_last_call = now - previous_ns;
@@ -284,6 +301,83 @@ rcl_timer_call(rcl_timer_t * timer)
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_timer_call(rcl_timer_t * timer)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Calling timer");
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_TRACEPOINT("rcl_timer_call", timer->impl);
+  if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
+    RCL_SET_EXPECTED_ERROR_MSG("timer is canceled");
+    return RCL_RET_TIMER_CANCELED;
+  }
+  rcl_time_point_value_t now;
+  rcl_ret_t now_ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
+  if (now_ret != RCL_RET_OK) {
+    return now_ret;  // rcl error state should already be set.
+  }
+  return __timer_call_with_now(timer, now, NULL);
+}
+
+rcl_ret_t
+rcl_timer_call_with_info(rcl_timer_t * timer, uint64_t * missed_periods)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Calling timer");
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(missed_periods, RCL_RET_INVALID_ARGUMENT);
+  *missed_periods = 0;
+  if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
+    RCL_SET_EXPECTED_ERROR_MSG("timer is canceled");
+    return RCL_RET_TIMER_CANCELED;
+  }
+  rcl_time_point_value_t now;
+  rcl_ret_t now_ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
+  if (now_ret != RCL_RET_OK) {
+    return now_ret;  // rcl error state should already be set.
+  }
+  return __timer_call_with_now(timer, now, missed_periods);
+}
+
+rcl_ret_t
+rcl_timers_call_ready(rcl_timer_t ** timers, size_t timer_count)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timers, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < timer_count; ++i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(timers[i], RCL_RET_INVALID_ARGUMENT);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      timers[i]->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
+  }
+  // Share one clock read between consecutive timers on the same clock; timer
+  // arrays are typically homogeneous so this usually means one read total.
+  rcl_clock_t * sampled_clock = NULL;
+  rcl_time_point_value_t now = 0;
+  rcl_ret_t result = RCL_RET_OK;
+  for (size_t i = 0; i < timer_count; ++i) {
+    rcl_timer_t * timer = timers[i];
+    if (rcutils_atomic_load_bool(&timer->impl->canceled)) {
+      continue;
+    }
+    if (timer->impl->clock != sampled_clock) {
+      rcl_ret_t now_ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
+      if (now_ret != RCL_RET_OK) {
+        if (RCL_RET_OK == result) {
+          result = now_ret;  // rcl error state should already be set.
+        }
+        continue;
+      }
+      sampled_clock = timer->impl->clock;
+    }
+    if (rcutils_atomic_load_int64_t(&timer->impl->next_call_time) > now) {
+      continue;  // not ready yet
+    }
+    rcl_ret_t ret = __timer_call_with_now(timer, now, NULL);
+    if (RCL_RET_OK != ret && RCL_RET_OK == result) {
+      result = ret;
+    }
+  }
+  return result;
+}
+
 rcl_ret_t
 rcl_timer_is_ready(const rcl_timer_t * timer, bool * is_ready)
 {
@@ -304,7 +398,7 @@ rcl_timer_get_time_until_next_call(const rcl_timer_t * timer, int64_t * time_unt
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(time_until_next_call, RCL_RET_INVALID_ARGUMENT);
   rcl_time_point_value_t now;
-  rcl_ret_t ret = rcl_clock_get_now(timer->impl->clock, &now);
+  rcl_ret_t ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
   if (ret != RCL_RET_OK) {
     return ret;  // rcl error state should already be set.
   }
@@ -313,6 +407,15 @@ rcl_timer_get_time_until_next_call(const rcl_timer_t * timer, int64_t * time_unt
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_timer_get_next_call_time(const rcl_timer_t * timer, int64_t * next_call_time)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(next_call_time, RCL_RET_INVALID_ARGUMENT);
+  *next_call_time = rcutils_atomic_load_int64_t(&timer->impl->next_call_time);
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_timer_get_time_since_last_call(
   const rcl_timer_t * timer,
@@ -321,7 +424,7 @@ rcl_timer_get_time_since_last_call(
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(time_since_last_call, RCL_RET_INVALID_ARGUMENT);
   rcl_time_point_value_t now;
-  rcl_ret_t ret = rcl_clock_get_now(timer->impl->clock, &now);
+  rcl_ret_t ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
   if (ret != RCL_RET_OK) {
     return ret;  // rcl error state should already be set.
   }
@@ -345,6 +448,7 @@ rcl_timer_exchange_period(const rcl_timer_t * timer, int64_t new_period, int64_t
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(old_period, RCL_RET_INVALID_ARGUMENT);
   *old_period = rcutils_atomic_exchange_uint64_t(&timer->impl->period, new_period);
+  __timer_mark_modified(timer);
   RCUTILS_LOG_DEBUG_NAMED(
     ROS_PACKAGE_NAME, "Updated timer period from '%" PRIu64 "ns' to '%" PRIu64 "ns'",
     *old_period, new_period);
@@ -375,6 +479,7 @@ rcl_timer_cancel(rcl_timer_t * timer)
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
   rcutils_atomic_store(&timer->impl->canceled, true);
+  __timer_mark_modified(timer);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Timer canceled");
   return RCL_RET_OK;
 }
@@ -394,13 +499,14 @@ rcl_timer_reset(rcl_timer_t * timer)
   RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_FOR_NULL_WITH_MSG(timer->impl, "timer is invalid", return RCL_RET_TIMER_INVALID);
   rcl_time_point_value_t now;
-  rcl_ret_t now_ret = rcl_clock_get_now(timer->impl->clock, &now);
+  rcl_ret_t now_ret = rcl_clock_get_now_fast(timer->impl->clock, &now);
   if (now_ret != RCL_RET_OK) {
     return now_ret;  // rcl error state should already be set.
   }
   int64_t period = rcutils_atomic_load_uint64_t(&timer->impl->period);
   rcutils_atomic_store(&timer->impl->next_call_time, now + period);
   rcutils_atomic_store(&timer->impl->canceled, false);
+  __timer_mark_modified(timer);
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Timer successfully reset");
   return RCL_RET_OK;
 }
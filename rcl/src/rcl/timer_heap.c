@@ -0,0 +1,162 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./timer_heap.h"
+
+#include "rcl/error_handling.h"
+
+rcl_timer_heap_t
+rcl_get_zero_initialized_timer_heap(void)
+{
+  static rcl_timer_heap_t null_heap = {
+    .entries = NULL,
+    .size = 0,
+    .capacity = 0,
+  };
+  return null_heap;
+}
+
+rcl_ret_t
+rcl_timer_heap_init(rcl_timer_heap_t * heap, size_t capacity, rcl_allocator_t allocator)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(heap, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  heap->entries = NULL;
+  heap->size = 0;
+  heap->capacity = 0;
+  heap->allocator = allocator;
+  if (capacity > 0) {
+    heap->entries = (rcl_timer_heap_entry_t *)allocator.allocate(
+      sizeof(rcl_timer_heap_entry_t) * capacity, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      heap->entries, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    heap->capacity = capacity;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_heap_fini(rcl_timer_heap_t * heap)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(heap, RCL_RET_INVALID_ARGUMENT);
+  if (heap->entries) {
+    heap->allocator.deallocate(heap->entries, heap->allocator.state);
+    heap->entries = NULL;
+  }
+  heap->size = 0;
+  heap->capacity = 0;
+  return RCL_RET_OK;
+}
+
+void
+rcl_timer_heap_clear(rcl_timer_heap_t * heap)
+{
+  heap->size = 0;
+}
+
+static void
+__timer_heap_sift_up(rcl_timer_heap_t * heap, size_t i)
+{
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (heap->entries[parent].deadline <= heap->entries[i].deadline) {
+      break;
+    }
+    rcl_timer_heap_entry_t tmp = heap->entries[parent];
+    heap->entries[parent] = heap->entries[i];
+    heap->entries[i] = tmp;
+    i = parent;
+  }
+}
+
+static void
+__timer_heap_sift_down(rcl_timer_heap_t * heap, size_t i)
+{
+  while (true) {
+    size_t smallest = i;
+    size_t left = 2 * i + 1;
+    size_t right = 2 * i + 2;
+    if (left < heap->size && heap->entries[left].deadline < heap->entries[smallest].deadline) {
+      smallest = left;
+    }
+    if (right < heap->size && heap->entries[right].deadline < heap->entries[smallest].deadline) {
+      smallest = right;
+    }
+    if (smallest == i) {
+      break;
+    }
+    rcl_timer_heap_entry_t tmp = heap->entries[smallest];
+    heap->entries[smallest] = heap->entries[i];
+    heap->entries[i] = tmp;
+    i = smallest;
+  }
+}
+
+rcl_ret_t
+rcl_timer_heap_push(
+  rcl_timer_heap_t * heap,
+  const rcl_timer_t * timer,
+  int64_t deadline,
+  uint64_t generation,
+  size_t index)
+{
+  if (heap->size == heap->capacity) {
+    size_t new_capacity = heap->capacity > 0 ? 2 * heap->capacity : 4;
+    rcl_timer_heap_entry_t * new_entries =
+      (rcl_timer_heap_entry_t *)heap->allocator.reallocate(
+      heap->entries, sizeof(rcl_timer_heap_entry_t) * new_capacity, heap->allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      new_entries, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    heap->entries = new_entries;
+    heap->capacity = new_capacity;
+  }
+  heap->entries[heap->size].deadline = deadline;
+  heap->entries[heap->size].generation = generation;
+  heap->entries[heap->size].timer = timer;
+  heap->entries[heap->size].index = index;
+  __timer_heap_sift_up(heap, heap->size++);
+  return RCL_RET_OK;
+}
+
+rcl_timer_heap_entry_t *
+rcl_timer_heap_peek(rcl_timer_heap_t * heap)
+{
+  if (0 == heap->size) {
+    return NULL;
+  }
+  return &heap->entries[0];
+}
+
+void
+rcl_timer_heap_update(
+  rcl_timer_heap_t * heap, size_t i, int64_t new_deadline, uint64_t new_generation)
+{
+  int64_t old_deadline = heap->entries[i].deadline;
+  heap->entries[i].deadline = new_deadline;
+  heap->entries[i].generation = new_generation;
+  if (new_deadline < old_deadline) {
+    __timer_heap_sift_up(heap, i);
+  } else {
+    __timer_heap_sift_down(heap, i);
+  }
+}
+
+#ifdef __cplusplus
+}
+#endif
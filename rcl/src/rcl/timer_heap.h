@@ -0,0 +1,108 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TIMER_HEAP_H_
+#define RCL__TIMER_HEAP_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+
+#include "rcl/allocator.h"
+#include "rcl/timer.h"
+#include "rcl/types.h"
+
+/// A single timer tracked by the heap.
+typedef struct rcl_timer_heap_entry_t
+{
+  /// Absolute next call time of the timer when it was (last) recorded.
+  int64_t deadline;
+  /// The timer's modification count when the deadline was recorded.
+  uint64_t generation;
+  /// The tracked timer.
+  const rcl_timer_t * timer;
+  /// Index of the timer in the owning wait set's timer array.
+  size_t index;
+} rcl_timer_heap_entry_t;
+
+/// Min-heap of timers ordered by absolute next call time.
+/**
+ * Used internally by the wait set so that finding the earliest timer deadline
+ * is O(1) instead of querying every timer on every wait.
+ * Recorded deadlines can go stale when a timer is called or reset; callers
+ * are expected to verify entries against the timer and repair the heap with
+ * rcl_timer_heap_update() as needed.
+ */
+typedef struct rcl_timer_heap_t
+{
+  rcl_timer_heap_entry_t * entries;
+  size_t size;
+  size_t capacity;
+  rcl_allocator_t allocator;
+} rcl_timer_heap_t;
+
+/// Return a rcl_timer_heap_t struct with members set to zero values.
+rcl_timer_heap_t
+rcl_get_zero_initialized_timer_heap(void);
+
+/// Initialize a timer heap with the given initial capacity.
+/**
+ * A capacity of 0 is allowed; storage is allocated on the first push.
+ *
+ * \return `RCL_RET_OK` if initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if heap is `NULL`, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+rcl_ret_t
+rcl_timer_heap_init(rcl_timer_heap_t * heap, size_t capacity, rcl_allocator_t allocator);
+
+/// Finalize a timer heap, freeing its storage.
+rcl_ret_t
+rcl_timer_heap_fini(rcl_timer_heap_t * heap);
+
+/// Remove all entries from the heap without deallocating storage.
+void
+rcl_timer_heap_clear(rcl_timer_heap_t * heap);
+
+/// Add a timer with the given absolute deadline, growing storage if needed.
+/**
+ * \return `RCL_RET_OK` if pushed successfully, or
+ * \return `RCL_RET_BAD_ALLOC` if growing the storage failed.
+ */
+rcl_ret_t
+rcl_timer_heap_push(
+  rcl_timer_heap_t * heap,
+  const rcl_timer_t * timer,
+  int64_t deadline,
+  uint64_t generation,
+  size_t index);
+
+/// Return the entry with the smallest deadline, or `NULL` if the heap is empty.
+rcl_timer_heap_entry_t *
+rcl_timer_heap_peek(rcl_timer_heap_t * heap);
+
+/// Replace the recorded deadline and generation of the entry at heap
+/// position i and restore heap order.
+void
+rcl_timer_heap_update(
+  rcl_timer_heap_t * heap, size_t i, int64_t new_deadline, uint64_t new_generation);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TIMER_HEAP_H_
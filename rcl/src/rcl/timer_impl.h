@@ -0,0 +1,55 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TIMER_IMPL_H_
+#define RCL__TIMER_IMPL_H_
+
+#include "rcl/guard_condition.h"
+#include "rcl/timer.h"
+
+#include "rcutils/stdatomic_helper.h"
+
+typedef struct rcl_timer_impl_t
+{
+  // The clock providing time.
+  rcl_clock_t * clock;
+  // The associated context.
+  rcl_context_t * context;
+  // A guard condition used to wake a wait set if using ROSTime, else zero initialized.
+  rcl_guard_condition_t guard_condition;
+  // The user supplied callback.
+  atomic_uintptr_t callback;
+  // Opaque user data handed back by rcl_timer_get_user_data(); set at init
+  // and immutable afterwards, so callback dispatch can read it directly.
+  void * user_data;
+  // This is a duration in nanoseconds.
+  atomic_uint_least64_t period;
+  // This is a time in nanoseconds since an unspecified time.
+  atomic_int_least64_t last_call_time;
+  // This is a time in nanoseconds since an unspecified time.
+  atomic_int_least64_t next_call_time;
+  // Credit for time elapsed before ROS time is activated or deactivated.
+  atomic_int_least64_t time_credit;
+  // A flag which indicates if the timer is canceled.
+  atomic_bool canceled;
+  // Incremented after every change to the timer's schedule or canceled state,
+  // i.e. when the timer is called, canceled, reset, its period exchanged, or
+  // its times adjusted by a time jump.  Wait sets use this to cache the next
+  // call time and only re-read it when the count has moved on.
+  atomic_uint_least64_t modification_count;
+  // The user supplied allocator.
+  rcl_allocator_t allocator;
+} rcl_timer_impl_t;
+
+#endif  // RCL__TIMER_IMPL_H_
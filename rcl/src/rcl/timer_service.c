@@ -0,0 +1,396 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/timer_service.h"
+
+#include "rcl/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
+
+#include "./timer_heap.h"
+#include "./timer_impl.h"
+
+// The deadline heap doubles as the registry.  An entry's `index` field,
+// unused here for its wait set purpose, flags a parked timer: one that was
+// delivered to the expiry queue (or is due but canceled) and whose recorded
+// deadline is pushed to INT64_MAX until its generation changes again -
+// which rcl_timer_call() and rcl_timer_reset() both cause.
+#define TIMER_SERVICE_ARMED 0
+#define TIMER_SERVICE_PARKED 1
+
+typedef struct rcl_timer_service_impl_t
+{
+  rcl_timer_service_options_t options;
+  // Triggered once per delivering collect; coalescing, so a burst of batches
+  // between drains wakes the consumer only once.
+  rcl_guard_condition_t guard_condition;
+  // Registered timers ordered by recorded absolute deadline.
+  rcl_timer_heap_t heap;
+  // Clock of the first registered timer; all registered timers must share
+  // its type so the absolute deadlines are comparable.  NULL when empty.
+  rcl_clock_t * clock;
+  // Single producer (collect), single consumer (take_expired) ring of due
+  // timer handles.  The indices grow without bound; an entry lives at
+  // index % queue_capacity.
+  const rcl_timer_t ** ring;
+  atomic_uint_least64_t write_index;
+  atomic_uint_least64_t read_index;
+} rcl_timer_service_impl_t;
+
+/// Refresh entries whose timer changed since its deadline was recorded.
+/**
+ * Runs on the driving thread.  A repaired entry is unparked and re-ordered,
+ * which shuffles heap positions, so the scan restarts until a pass finds
+ * nothing to repair; total work is bounded by the number of changed timers.
+ */
+static rcl_ret_t
+__timer_service_repair(rcl_timer_service_impl_t * impl)
+{
+  bool repaired = true;
+  while (repaired) {
+    repaired = false;
+    for (size_t i = 0; i < impl->heap.size; ++i) {
+      rcl_timer_heap_entry_t * entry = &impl->heap.entries[i];
+      uint64_t generation =
+        rcutils_atomic_load_uint64_t(&entry->timer->impl->modification_count);
+      if (generation == entry->generation) {
+        continue;
+      }
+      int64_t deadline = 0;
+      rcl_ret_t ret = rcl_timer_get_next_call_time(entry->timer, &deadline);
+      if (RCL_RET_OK != ret) {
+        return ret;  // The rcl error state should already be set.
+      }
+      entry->index = TIMER_SERVICE_ARMED;
+      rcl_timer_heap_update(&impl->heap, i, deadline, generation);
+      repaired = true;
+      break;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+static rcl_timer_service_impl_t *
+__timer_service_get_impl(const rcl_timer_service_t * timer_service)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_service, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_service->impl,
+    "timer service implementation is invalid",
+    return NULL);
+  return timer_service->impl;
+}
+
+rcl_timer_service_t
+rcl_get_zero_initialized_timer_service(void)
+{
+  static rcl_timer_service_t null_timer_service = {
+    .impl = 0
+  };
+  return null_timer_service;
+}
+
+rcl_timer_service_options_t
+rcl_timer_service_get_default_options(void)
+{
+  // !!! MAKE SURE THAT CHANGES TO THESE DEFAULTS ARE REFLECTED IN THE HEADER DOC STRING
+  rcl_timer_service_options_t default_options = {
+    .queue_capacity = 0,  // 0 means RCL_TIMER_SERVICE_QUEUE_CAPACITY_DEFAULT
+  };
+  default_options.allocator = rcl_get_default_allocator();
+  return default_options;
+}
+
+rcl_ret_t
+rcl_timer_service_init(
+  rcl_timer_service_t * timer_service,
+  rcl_context_t * context,
+  const rcl_timer_service_options_t options)
+{
+  const rcl_allocator_t * allocator = &options.allocator;
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_service, RCL_RET_INVALID_ARGUMENT);
+  if (timer_service->impl) {
+    RCL_SET_ERROR_MSG("timer service already initialized, or memory was unintialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  rcl_timer_service_impl_t * impl = (rcl_timer_service_impl_t *)allocator->allocate(
+    sizeof(rcl_timer_service_impl_t), allocator->state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  impl->options = options;
+  if (0 == impl->options.queue_capacity) {
+    impl->options.queue_capacity = RCL_TIMER_SERVICE_QUEUE_CAPACITY_DEFAULT;
+  }
+  impl->clock = NULL;
+  atomic_init(&impl->write_index, 0);
+  atomic_init(&impl->read_index, 0);
+  impl->ring = (const rcl_timer_t **)allocator->allocate(
+    sizeof(rcl_timer_t *) * impl->options.queue_capacity, allocator->state);
+  if (!impl->ring) {
+    allocator->deallocate(impl, allocator->state);
+    RCL_SET_ERROR_MSG("allocating memory failed");
+    return RCL_RET_BAD_ALLOC;
+  }
+  impl->heap = rcl_get_zero_initialized_timer_heap();
+  rcl_ret_t ret = rcl_timer_heap_init(&impl->heap, 0, options.allocator);
+  if (RCL_RET_OK != ret) {
+    allocator->deallocate((void *)impl->ring, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    return ret;  // error already set
+  }
+  impl->guard_condition = rcl_get_zero_initialized_guard_condition();
+  rcl_guard_condition_options_t guard_condition_options =
+    rcl_guard_condition_get_default_options();
+  guard_condition_options.allocator = options.allocator;
+  guard_condition_options.enable_trigger_coalescing = true;
+  ret = rcl_guard_condition_init(&impl->guard_condition, context, guard_condition_options);
+  if (RCL_RET_OK != ret) {
+    rcl_ret_t heap_ret = rcl_timer_heap_fini(&impl->heap);
+    (void)heap_ret;  // Defensive, shouldn't fail with a valid heap.
+    allocator->deallocate((void *)impl->ring, allocator->state);
+    allocator->deallocate(impl, allocator->state);
+    return ret;  // error already set
+  }
+  timer_service->impl = impl;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_service_fini(rcl_timer_service_t * timer_service)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_service, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t result = RCL_RET_OK;
+  if (timer_service->impl) {
+    // assuming the allocator is valid because it is checked in
+    // rcl_timer_service_init()
+    rcl_allocator_t allocator = timer_service->impl->options.allocator;
+    result = rcl_guard_condition_fini(&timer_service->impl->guard_condition);
+    rcl_ret_t heap_ret = rcl_timer_heap_fini(&timer_service->impl->heap);
+    if (RCL_RET_OK == result) {
+      result = heap_ret;
+    }
+    allocator.deallocate((void *)timer_service->impl->ring, allocator.state);
+    allocator.deallocate(timer_service->impl, allocator.state);
+    timer_service->impl = NULL;
+  }
+  return result;
+}
+
+rcl_ret_t
+rcl_timer_service_add_timer(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t * timer)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  for (size_t i = 0; i < impl->heap.size; ++i) {
+    if (impl->heap.entries[i].timer == timer) {
+      RCL_SET_ERROR_MSG("timer is already registered with the timer service");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+  }
+  rcl_clock_t * clock = NULL;
+  // rcl_timer_clock() does not modify the timer, it is just not const correct.
+  rcl_ret_t ret = rcl_timer_clock((rcl_timer_t *)timer, &clock);
+  if (RCL_RET_OK != ret) {
+    return ret;  // The rcl error state should already be set.
+  }
+  // Absolute deadlines are only comparable when all timers share an epoch.
+  if (RCL_STEADY_TIME != clock->type && RCL_SYSTEM_TIME != clock->type) {
+    RCL_SET_ERROR_MSG("timer service requires timers with steady or system time clocks");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL != impl->clock && clock->type != impl->clock->type) {
+    RCL_SET_ERROR_MSG("timer clock type does not match the timer service's other timers");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  uint64_t generation = rcutils_atomic_load_uint64_t(&timer->impl->modification_count);
+  int64_t deadline = 0;
+  ret = rcl_timer_get_next_call_time(timer, &deadline);
+  if (RCL_RET_OK != ret) {
+    return ret;  // The rcl error state should already be set.
+  }
+  ret = rcl_timer_heap_push(
+    &impl->heap, timer, deadline, generation, TIMER_SERVICE_ARMED);
+  if (RCL_RET_OK != ret) {
+    return ret;  // The rcl error state should already be set.
+  }
+  if (NULL == impl->clock) {
+    impl->clock = clock;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_service_remove_timer(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t * timer)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  rcl_timer_heap_t * heap = &impl->heap;
+  for (size_t i = 0; i < heap->size; ++i) {
+    if (heap->entries[i].timer != timer) {
+      continue;
+    }
+    // Classic heap delete: move the last entry into the hole and let the
+    // update sift it whichever way its deadline demands.
+    rcl_timer_heap_entry_t moved = heap->entries[heap->size - 1];
+    --heap->size;
+    if (i < heap->size) {
+      heap->entries[i].timer = moved.timer;
+      heap->entries[i].index = moved.index;
+      rcl_timer_heap_update(heap, i, moved.deadline, moved.generation);
+    }
+    if (0 == heap->size) {
+      impl->clock = NULL;
+    }
+    return RCL_RET_OK;
+  }
+  RCL_SET_ERROR_MSG("timer is not registered with the timer service");
+  return RCL_RET_INVALID_ARGUMENT;
+}
+
+const rcl_guard_condition_t *
+rcl_timer_service_get_guard_condition(const rcl_timer_service_t * timer_service)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return NULL;  // error already set
+  }
+  return &impl->guard_condition;
+}
+
+rcl_ret_t
+rcl_timer_service_get_next_deadline(
+  rcl_timer_service_t * timer_service,
+  int64_t * deadline)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(deadline, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = __timer_service_repair(impl);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_timer_heap_entry_t * top = rcl_timer_heap_peek(&impl->heap);
+  // Parked entries carry INT64_MAX deadlines, so an all-parked heap reports
+  // "nothing scheduled" just like an empty one.
+  *deadline = (NULL != top) ? top->deadline : INT64_MAX;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_service_collect(
+  rcl_timer_service_t * timer_service,
+  size_t * number_delivered)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_delivered, RCL_RET_INVALID_ARGUMENT);
+  *number_delivered = 0;
+  if (0 == impl->heap.size) {
+    return RCL_RET_OK;
+  }
+  rcl_ret_t ret = __timer_service_repair(impl);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_time_point_value_t now = 0;
+  ret = rcl_clock_get_now_fast(impl->clock, &now);
+  if (RCL_RET_OK != ret) {
+    return ret;  // The rcl error state should already be set.
+  }
+  const size_t queue_capacity = impl->options.queue_capacity;
+  uint64_t write_index = rcutils_atomic_load_uint64_t(&impl->write_index);
+  for (;;) {
+    rcl_timer_heap_entry_t * top = rcl_timer_heap_peek(&impl->heap);
+    if (NULL == top || top->deadline > now) {
+      break;
+    }
+    bool is_ready = false;
+    ret = rcl_timer_is_ready(top->timer, &is_ready);
+    if (RCL_RET_OK != ret) {
+      return ret;  // The rcl error state should already be set.
+    }
+    if (is_ready) {
+      uint64_t read_index = rcutils_atomic_load_uint64_t(&impl->read_index);
+      if (write_index - read_index >= queue_capacity) {
+        // Queue full; the timer stays due and a later collect delivers it.
+        break;
+      }
+      impl->ring[write_index % queue_capacity] = top->timer;
+      rcutils_atomic_store(&impl->write_index, ++write_index);
+      ++(*number_delivered);
+    }
+    // Park the entry: a delivered timer waits for rcl_timer_call(), a due
+    // but unready (canceled) timer waits for rcl_timer_reset().  Both bump
+    // the generation, which unparks it on the next repair.
+    top->index = TIMER_SERVICE_PARKED;
+    rcl_timer_heap_update(&impl->heap, 0, INT64_MAX, top->generation);
+  }
+  if (*number_delivered > 0) {
+    ret = rcl_trigger_guard_condition(&impl->guard_condition);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_service_take_expired(
+  rcl_timer_service_t * timer_service,
+  const rcl_timer_t ** timers,
+  size_t capacity,
+  size_t * number_taken)
+{
+  rcl_timer_service_impl_t * impl = __timer_service_get_impl(timer_service);
+  if (!impl) {
+    return RCL_RET_INVALID_ARGUMENT;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(timers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_taken, RCL_RET_INVALID_ARGUMENT);
+  *number_taken = 0;
+  const size_t queue_capacity = impl->options.queue_capacity;
+  uint64_t read_index = rcutils_atomic_load_uint64_t(&impl->read_index);
+  uint64_t write_index = rcutils_atomic_load_uint64_t(&impl->write_index);
+  while (read_index != write_index && *number_taken < capacity) {
+    timers[(*number_taken)++] = impl->ring[read_index % queue_capacity];
+    rcutils_atomic_store(&impl->read_index, ++read_index);
+  }
+  // Re-arm the coalesced guard condition, so the next delivery crosses into
+  // rmw again and wakes the wait set.
+  size_t ignored = 0;
+  return rcl_guard_condition_take_pending_count(&impl->guard_condition, &ignored);
+}
+
+#ifdef __cplusplus
+}
+#endif
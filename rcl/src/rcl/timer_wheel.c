@@ -0,0 +1,423 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/timer_wheel.h"
+
+#include <stdint.h>
+
+#include "rcl/error_handling.h"
+
+// Number of slots per level; slot indices are extracted with shifts and
+// masks, so this must be a power of two.
+#define RCL_TIMER_WHEEL_SLOT_BITS 6
+#define RCL_TIMER_WHEEL_SLOTS (1 << RCL_TIMER_WHEEL_SLOT_BITS)
+#define RCL_TIMER_WHEEL_SLOT_MASK (RCL_TIMER_WHEEL_SLOTS - 1)
+#define RCL_TIMER_WHEEL_LEVELS 4
+
+typedef struct rcl_timer_wheel_entry_t
+{
+  const rcl_timer_t * timer;
+  // Absolute deadline the entry was bucketed with, in nanoseconds.
+  int64_t deadline;
+  struct rcl_timer_wheel_entry_t * next;
+  struct rcl_timer_wheel_entry_t * prev;
+} rcl_timer_wheel_entry_t;
+
+typedef struct rcl_timer_wheel_impl_t
+{
+  // Head of the doubly linked entry list for each slot of each level.
+  rcl_timer_wheel_entry_t * slots[RCL_TIMER_WHEEL_LEVELS][RCL_TIMER_WHEEL_SLOTS];
+  // Entries for timers that expired while canceled, re-bucketed once the
+  // timer is no longer canceled.
+  rcl_timer_wheel_entry_t * parked;
+  // Recycled entries, reused before allocating new ones.
+  rcl_timer_wheel_entry_t * free_list;
+  // Duration of one level 0 slot in nanoseconds.
+  int64_t resolution;
+  // Time of tick 0; deadlines are bucketed relative to this.
+  int64_t origin;
+  // Next level 0 tick to be processed by rcl_timer_wheel_advance().
+  uint64_t current_tick;
+  // Number of entries bucketed in slots (excludes parked and free entries).
+  size_t size;
+  rcl_allocator_t allocator;
+} rcl_timer_wheel_impl_t;
+
+rcl_timer_wheel_t
+rcl_get_zero_initialized_timer_wheel(void)
+{
+  static rcl_timer_wheel_t null_timer_wheel = {0};
+  return null_timer_wheel;
+}
+
+rcl_timer_wheel_options_t
+rcl_timer_wheel_get_default_options(void)
+{
+  static rcl_timer_wheel_options_t default_options = {
+    .resolution = 1000000,  // 1ms
+  };
+  default_options.allocator = rcl_get_default_allocator();
+  return default_options;
+}
+
+rcl_ret_t
+rcl_timer_wheel_init(
+  rcl_timer_wheel_t * timer_wheel,
+  int64_t start_time,
+  const rcl_timer_wheel_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(
+    &options->allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  if (timer_wheel->impl) {
+    RCL_SET_ERROR_MSG("timer wheel already initialized, or memory was uninitialized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  if (options->resolution <= 0) {
+    RCL_SET_ERROR_MSG("timer wheel resolution must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_allocator_t allocator = options->allocator;
+  timer_wheel->impl = (rcl_timer_wheel_impl_t *)allocator.zero_allocate(
+    1, sizeof(rcl_timer_wheel_impl_t), allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_wheel->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  timer_wheel->impl->resolution = options->resolution;
+  timer_wheel->impl->origin = start_time;
+  timer_wheel->impl->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+static void
+__timer_wheel_free_entry_list(rcl_timer_wheel_impl_t * impl, rcl_timer_wheel_entry_t * head)
+{
+  while (head) {
+    rcl_timer_wheel_entry_t * next = head->next;
+    impl->allocator.deallocate(head, impl->allocator.state);
+    head = next;
+  }
+}
+
+rcl_ret_t
+rcl_timer_wheel_fini(rcl_timer_wheel_t * timer_wheel)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  rcl_timer_wheel_impl_t * impl = timer_wheel->impl;
+  if (!impl) {
+    return RCL_RET_OK;
+  }
+  for (size_t level = 0; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+    for (size_t slot = 0; slot < RCL_TIMER_WHEEL_SLOTS; ++slot) {
+      __timer_wheel_free_entry_list(impl, impl->slots[level][slot]);
+    }
+  }
+  __timer_wheel_free_entry_list(impl, impl->parked);
+  __timer_wheel_free_entry_list(impl, impl->free_list);
+  impl->allocator.deallocate(impl, impl->allocator.state);
+  timer_wheel->impl = NULL;
+  return RCL_RET_OK;
+}
+
+/// Convert an absolute time to a level 0 tick, rounding up.
+static uint64_t
+__timer_wheel_time_to_tick(const rcl_timer_wheel_impl_t * impl, int64_t time)
+{
+  if (time <= impl->origin) {
+    return 0;
+  }
+  return (uint64_t)((time - impl->origin + impl->resolution - 1) / impl->resolution);
+}
+
+/// Link an entry into the slot its deadline falls in, relative to the
+/// current tick; past deadlines go in the next slot to be processed.
+static void
+__timer_wheel_bucket(rcl_timer_wheel_impl_t * impl, rcl_timer_wheel_entry_t * entry)
+{
+  uint64_t tick = __timer_wheel_time_to_tick(impl, entry->deadline);
+  if (tick < impl->current_tick) {
+    tick = impl->current_tick;
+  }
+  uint64_t delta = tick - impl->current_tick;
+  size_t level = 0;
+  while (
+    level + 1 < RCL_TIMER_WHEEL_LEVELS &&
+    delta >= ((uint64_t)RCL_TIMER_WHEEL_SLOTS << (level * RCL_TIMER_WHEEL_SLOT_BITS)))
+  {
+    ++level;
+  }
+  size_t slot = (tick >> (level * RCL_TIMER_WHEEL_SLOT_BITS)) & RCL_TIMER_WHEEL_SLOT_MASK;
+  entry->prev = NULL;
+  entry->next = impl->slots[level][slot];
+  if (entry->next) {
+    entry->next->prev = entry;
+  }
+  impl->slots[level][slot] = entry;
+  ++impl->size;
+}
+
+static rcl_timer_wheel_entry_t *
+__timer_wheel_acquire_entry(rcl_timer_wheel_impl_t * impl)
+{
+  rcl_timer_wheel_entry_t * entry = impl->free_list;
+  if (entry) {
+    impl->free_list = entry->next;
+    return entry;
+  }
+  return (rcl_timer_wheel_entry_t *)impl->allocator.allocate(
+    sizeof(rcl_timer_wheel_entry_t), impl->allocator.state);
+}
+
+static void
+__timer_wheel_release_entry(rcl_timer_wheel_impl_t * impl, rcl_timer_wheel_entry_t * entry)
+{
+  entry->timer = NULL;
+  entry->prev = NULL;
+  entry->next = impl->free_list;
+  impl->free_list = entry;
+}
+
+rcl_ret_t
+rcl_timer_wheel_add(rcl_timer_wheel_t * timer_wheel, const rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_wheel->impl, "timer wheel is invalid", return RCL_RET_NOT_INIT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  int64_t next_call_time;
+  rcl_ret_t ret = rcl_timer_get_next_call_time(timer, &next_call_time);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  rcl_timer_wheel_impl_t * impl = timer_wheel->impl;
+  rcl_timer_wheel_entry_t * entry = __timer_wheel_acquire_entry(impl);
+  RCL_CHECK_FOR_NULL_WITH_MSG(entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->timer = timer;
+  entry->deadline = next_call_time;
+  __timer_wheel_bucket(impl, entry);
+  return RCL_RET_OK;
+}
+
+/// Unlink an entry from the list whose head is *head.
+static void
+__timer_wheel_unlink(rcl_timer_wheel_entry_t ** head, rcl_timer_wheel_entry_t * entry)
+{
+  if (entry->prev) {
+    entry->prev->next = entry->next;
+  } else {
+    *head = entry->next;
+  }
+  if (entry->next) {
+    entry->next->prev = entry->prev;
+  }
+  entry->next = NULL;
+  entry->prev = NULL;
+}
+
+rcl_ret_t
+rcl_timer_wheel_remove(rcl_timer_wheel_t * timer_wheel, const rcl_timer_t * timer)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_wheel->impl, "timer wheel is invalid", return RCL_RET_NOT_INIT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer, RCL_RET_INVALID_ARGUMENT);
+  rcl_timer_wheel_impl_t * impl = timer_wheel->impl;
+  for (size_t level = 0; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+    for (size_t slot = 0; slot < RCL_TIMER_WHEEL_SLOTS; ++slot) {
+      for (rcl_timer_wheel_entry_t * entry = impl->slots[level][slot]; entry;
+        entry = entry->next)
+      {
+        if (entry->timer == timer) {
+          __timer_wheel_unlink(&impl->slots[level][slot], entry);
+          __timer_wheel_release_entry(impl, entry);
+          --impl->size;
+          return RCL_RET_OK;
+        }
+      }
+    }
+  }
+  for (rcl_timer_wheel_entry_t * entry = impl->parked; entry; entry = entry->next) {
+    if (entry->timer == timer) {
+      __timer_wheel_unlink(&impl->parked, entry);
+      __timer_wheel_release_entry(impl, entry);
+      return RCL_RET_OK;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+/// Take every entry out of a higher level slot and re-bucket it, normally
+/// into a finer level now that its deadline is closer.
+static void
+__timer_wheel_cascade(rcl_timer_wheel_impl_t * impl, size_t level, size_t slot)
+{
+  rcl_timer_wheel_entry_t * entry = impl->slots[level][slot];
+  impl->slots[level][slot] = NULL;
+  while (entry) {
+    rcl_timer_wheel_entry_t * next = entry->next;
+    --impl->size;
+    entry->prev = NULL;
+    entry->next = NULL;
+    __timer_wheel_bucket(impl, entry);
+    entry = next;
+  }
+}
+
+/// Re-bucket parked entries whose timers are no longer canceled.
+static void
+__timer_wheel_unpark(rcl_timer_wheel_impl_t * impl)
+{
+  rcl_timer_wheel_entry_t * entry = impl->parked;
+  while (entry) {
+    rcl_timer_wheel_entry_t * next = entry->next;
+    bool is_canceled = false;
+    if (
+      RCL_RET_OK == rcl_timer_is_canceled(entry->timer, &is_canceled) &&
+      !is_canceled &&
+      RCL_RET_OK == rcl_timer_get_next_call_time(entry->timer, &entry->deadline))
+    {
+      __timer_wheel_unlink(&impl->parked, entry);
+      __timer_wheel_bucket(impl, entry);
+    } else {
+      rcl_reset_error();
+    }
+    entry = next;
+  }
+}
+
+rcl_ret_t
+rcl_timer_wheel_advance(
+  rcl_timer_wheel_t * timer_wheel,
+  int64_t current_time,
+  const rcl_timer_t ** expired_timers,
+  size_t capacity,
+  size_t * number_expired)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_wheel->impl, "timer wheel is invalid", return RCL_RET_NOT_INIT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(expired_timers, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_expired, RCL_RET_INVALID_ARGUMENT);
+  rcl_timer_wheel_impl_t * impl = timer_wheel->impl;
+  *number_expired = 0;
+  if (impl->parked) {
+    __timer_wheel_unpark(impl);
+  }
+  uint64_t target_tick = __timer_wheel_time_to_tick(impl, current_time);
+  while (impl->current_tick < target_tick) {
+    if (0 == impl->size) {
+      // Nothing scheduled; jump straight to the target.
+      impl->current_tick = target_tick;
+      break;
+    }
+    size_t slot = impl->current_tick & RCL_TIMER_WHEEL_SLOT_MASK;
+    rcl_timer_wheel_entry_t * entry = impl->slots[0][slot];
+    while (entry) {
+      rcl_timer_wheel_entry_t * next = entry->next;
+      if (entry->deadline <= current_time) {
+        if (*number_expired >= capacity) {
+          // Out of room; leave the tick unprocessed and let the caller
+          // drain the remainder with another advance.
+          return RCL_RET_OK;
+        }
+        __timer_wheel_unlink(&impl->slots[0][slot], entry);
+        --impl->size;
+        bool is_canceled = false;
+        rcl_ret_t ret = rcl_timer_is_canceled(entry->timer, &is_canceled);
+        if (RCL_RET_OK != ret) {
+          rcl_reset_error();
+          is_canceled = true;
+        }
+        if (is_canceled) {
+          // Park until the timer is reset; canceled timers must not spin.
+          entry->next = impl->parked;
+          entry->prev = NULL;
+          if (entry->next) {
+            entry->next->prev = entry;
+          }
+          impl->parked = entry;
+        } else {
+          expired_timers[(*number_expired)++] = entry->timer;
+          // Re-bucket one period out; never closer than one slot so a zero
+          // period timer cannot expire twice within this advance.
+          int64_t period = 0;
+          ret = rcl_timer_get_period(entry->timer, &period);
+          if (RCL_RET_OK != ret) {
+            rcl_reset_error();
+          }
+          if (period < impl->resolution) {
+            period = impl->resolution;
+          }
+          entry->deadline += period;
+          if (entry->deadline <= current_time) {
+            // The timer fell behind by more than a period; skip ahead
+            // rather than replaying every missed expiry.
+            entry->deadline = current_time + period;
+          }
+          __timer_wheel_bucket(impl, entry);
+        }
+      }
+      entry = next;
+    }
+    ++impl->current_tick;
+    // Each time a level wraps around, pull the next slot of the level above
+    // down into the finer levels.
+    uint64_t tick = impl->current_tick;
+    for (size_t level = 1; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+      tick >>= RCL_TIMER_WHEEL_SLOT_BITS;
+      if (0 != (impl->current_tick &
+        ((UINT64_C(1) << (level * RCL_TIMER_WHEEL_SLOT_BITS)) - 1)))
+      {
+        break;
+      }
+      __timer_wheel_cascade(impl, level, tick & RCL_TIMER_WHEEL_SLOT_MASK);
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_timer_wheel_get_next_deadline(
+  const rcl_timer_wheel_t * timer_wheel,
+  int64_t * next_deadline)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(timer_wheel, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    timer_wheel->impl, "timer wheel is invalid", return RCL_RET_NOT_INIT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(next_deadline, RCL_RET_INVALID_ARGUMENT);
+  const rcl_timer_wheel_impl_t * impl = timer_wheel->impl;
+  int64_t earliest = INT64_MAX;
+  for (size_t level = 0; level < RCL_TIMER_WHEEL_LEVELS; ++level) {
+    for (size_t slot = 0; slot < RCL_TIMER_WHEEL_SLOTS; ++slot) {
+      for (const rcl_timer_wheel_entry_t * entry = impl->slots[level][slot]; entry;
+        entry = entry->next)
+      {
+        if (entry->deadline < earliest) {
+          earliest = entry->deadline;
+        }
+      }
+    }
+  }
+  *next_deadline = earliest;
+  return RCL_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,52 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./topic_charclass.h"
+
+// short aliases so the table below lines up in a 16 column grid
+#define __ RCL_TOPIC_CHAR_NONE
+#define AL RCL_TOPIC_CHAR_RUN
+#define DI (RCL_TOPIC_CHAR_RUN | RCL_TOPIC_CHAR_DIGIT)
+#define SL RCL_TOPIC_CHAR_SLASH
+#define TI RCL_TOPIC_CHAR_TILDE
+#define OB RCL_TOPIC_CHAR_OPEN_BRACE
+#define CB RCL_TOPIC_CHAR_CLOSE_BRACE
+
+const uint8_t rcl_topic_char_classes[256] = {
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0x00
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0x10
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, SL,  // 0x20  /
+  DI, DI, DI, DI, DI, DI, DI, DI, DI, DI, __, __, __, __, __, __,  // 0x30  0-9
+  __, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL,  // 0x40  A-O
+  AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, __, __, __, __, AL,  // 0x50  P-Z _
+  __, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL,  // 0x60  a-o
+  AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, AL, OB, __, CB, TI, __,  // 0x70  p-z { } ~
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0x80
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0x90
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xa0
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xb0
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xc0
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xd0
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xe0
+  __, __, __, __, __, __, __, __, __, __, __, __, __, __, __, __,  // 0xf0
+};
+
+#ifdef __cplusplus
+}
+#endif
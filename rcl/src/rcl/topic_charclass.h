@@ -0,0 +1,57 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__TOPIC_CHARCLASS_H_
+#define RCL__TOPIC_CHARCLASS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// Internal character classes for topic name scanning.
+//
+// Topic name validation and expansion both need to classify every character
+// of a name.  Instead of a branch per character, the table below maps each
+// byte to a small bit set, so the scanners can classify with one load and
+// test several classes at once with a mask.
+
+/// Character is not allowed anywhere in a topic name.
+#define RCL_TOPIC_CHAR_NONE 0x00u
+/// Character continues a name or substitution token, i.e. `[A-Za-z0-9_]`.
+#define RCL_TOPIC_CHAR_RUN 0x01u
+/// Character is a digit, i.e. `[0-9]`; always set together with the run bit.
+#define RCL_TOPIC_CHAR_DIGIT 0x02u
+/// Character is the token separator `/`.
+#define RCL_TOPIC_CHAR_SLASH 0x04u
+/// Character is the private namespace substitution `~`.
+#define RCL_TOPIC_CHAR_TILDE 0x08u
+/// Character opens a substitution, `{`.
+#define RCL_TOPIC_CHAR_OPEN_BRACE 0x10u
+/// Character closes a substitution, `}`.
+#define RCL_TOPIC_CHAR_CLOSE_BRACE 0x20u
+
+/// Table mapping each of the 256 byte values to its character class bits.
+extern const uint8_t rcl_topic_char_classes[256];
+
+/// Return the character class bits for the character `c`.
+#define RCL_TOPIC_CHAR_CLASS(c) (rcl_topic_char_classes[(uint8_t)(c)])
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__TOPIC_CHARCLASS_H_
@@ -0,0 +1,34 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/tracepoints.h"
+
+// Default hook: does nothing. Tracing tools interpose this symbol (e.g.
+// with LD_PRELOAD) to receive the events.
+void
+rcl_tracepoint_fire(const char * event_name, const void * handle, const char * info)
+{
+  (void)event_name;
+  (void)handle;
+  (void)info;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -19,12 +19,11 @@ extern "C"
 
 #include "rcl/validate_topic_name.h"
 
-#include <ctype.h>
 #include <string.h>
 
+#include "./topic_charclass.h"
 #include "rcl/allocator.h"
 #include "rcl/error_handling.h"
-#include "rcutils/isalnum_no_locale.h"
 
 rcl_ret_t
 rcl_validate_topic_name(
@@ -55,7 +54,7 @@ rcl_validate_topic_name_with_size(
     return RCL_RET_OK;
   }
   // check that the first character is not a number
-  if (isdigit(topic_name[0]) != 0) {
+  if (RCL_TOPIC_CHAR_CLASS(topic_name[0]) & RCL_TOPIC_CHAR_DIGIT) {
     // this is the case where the topic is relative and the first token starts with a number
     // e.g. 7foo/bar is invalid
     *validation_result = RCL_TOPIC_NAME_INVALID_NAME_TOKEN_STARTS_WITH_NUMBER;
@@ -73,31 +72,71 @@ rcl_validate_topic_name_with_size(
     }
     return RCL_RET_OK;
   }
-  // check for unallowed characters, nested and unmatched {} too
+  // Single pass over the name, checking for unallowed characters and nested
+  // or unmatched {}.  Structural errors anywhere in the name take precedence
+  // over the token checks, which used to run in a separate trailing pass, so
+  // token errors are recorded and only reported once the scan completes.
   bool in_open_curly_brace = false;
   size_t opening_curly_brace_index = 0;
-  for (size_t i = 0; i < topic_name_length; ++i) {
-    if (rcutils_isalnum_no_locale(topic_name[i])) {
-      // if within curly braces and the first character is a number, error
-      // e.g. foo/{4bar} is invalid
+  int token_result = RCL_TOPIC_NAME_VALID;
+  size_t token_index = 0;
+  size_t i = 0;
+  while (i < topic_name_length) {
+    // Fast path: runs of alphanumerics and underscores carry no structural
+    // state, so skip them eight characters at a time.  The guard on the
+    // previous character keeps a digit starting a token or substitution,
+    // and the character after a leading tilde, on the slow path below.
+    while (
+      i + 8 <= topic_name_length &&
+      (0 == i || (RCL_TOPIC_CHAR_CLASS(topic_name[i - 1]) & RCL_TOPIC_CHAR_RUN)))
+    {
+      const uint8_t combined_classes =
+        RCL_TOPIC_CHAR_CLASS(topic_name[i]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 1]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 2]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 3]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 4]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 5]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 6]) &
+        RCL_TOPIC_CHAR_CLASS(topic_name[i + 7]);
+      if (!(combined_classes & RCL_TOPIC_CHAR_RUN)) {
+        // a structural or unallowed character is within these eight
+        break;
+      }
+      i += 8;
+    }
+    if (i >= topic_name_length) {
+      break;
+    }
+    const uint8_t char_class = RCL_TOPIC_CHAR_CLASS(topic_name[i]);
+    if (char_class & RCL_TOPIC_CHAR_RUN) {
+      if (char_class & RCL_TOPIC_CHAR_DIGIT) {
+        // if within curly braces and the first character is a number, error
+        // e.g. foo/{4bar} is invalid
+        if (in_open_curly_brace && i - 1 == opening_curly_brace_index) {
+          *validation_result = RCL_TOPIC_NAME_INVALID_SUBSTITUTION_STARTS_WITH_NUMBER;
+          if (invalid_index) {
+            *invalid_index = i;
+          }
+          return RCL_RET_OK;
+        }
+        // record a token (other than the first) that starts with a number
+        if (i > 0 && topic_name[i - 1] == '/' && RCL_TOPIC_NAME_VALID == token_result) {
+          token_result = RCL_TOPIC_NAME_INVALID_NAME_TOKEN_STARTS_WITH_NUMBER;
+          token_index = i;
+        }
+      }
+      // record the case where first character is ~ but second character is not /
+      // e.g. ~foo is invalid, though a second character that is also the last
+      // is skipped, matching the historical behavior of the trailing pass
       if (
-        isdigit(topic_name[i]) != 0 &&
-        in_open_curly_brace &&
-        i > 0 &&
-        (i - 1 == opening_curly_brace_index))
+        1 == i && i + 1 < topic_name_length &&
+        topic_name[0] == '~' && RCL_TOPIC_NAME_VALID == token_result)
       {
-        *validation_result = RCL_TOPIC_NAME_INVALID_SUBSTITUTION_STARTS_WITH_NUMBER;
-        if (invalid_index) {
-          *invalid_index = i;
-        }
-        return RCL_RET_OK;
+        token_result = RCL_TOPIC_NAME_INVALID_TILDE_NOT_FOLLOWED_BY_FORWARD_SLASH;
+        token_index = 1;
       }
-      // if it is an alpha numeric character, i.e. [0-9|A-Z|a-z], continue
-      continue;
-    } else if (topic_name[i] == '_') {
-      // if it is an underscore, continue
-      continue;
-    } else if (topic_name[i] == '/') {
+    } else if (char_class & RCL_TOPIC_CHAR_SLASH) {
       // if it is a forward slash within {}, error
       if (in_open_curly_brace) {
         *validation_result = RCL_TOPIC_NAME_INVALID_SUBSTITUTION_CONTAINS_UNALLOWED_CHARACTERS;
@@ -106,9 +145,7 @@ rcl_validate_topic_name_with_size(
         }
         return RCL_RET_OK;
       }
-      // if it is a forward slash outside of {}, continue
-      continue;
-    } else if (topic_name[i] == '~') {
+    } else if (char_class & RCL_TOPIC_CHAR_TILDE) {
       // if it is a tilde not in the first position, validation fails
       if (i != 0) {
         *validation_result = RCL_TOPIC_NAME_INVALID_MISPLACED_TILDE;
@@ -117,10 +154,7 @@ rcl_validate_topic_name_with_size(
         }
         return RCL_RET_OK;
       }
-      // if it is a tilde in the first position, continue
-      continue;
-    } else if (topic_name[i] == '{') {
-      opening_curly_brace_index = i;
+    } else if (char_class & RCL_TOPIC_CHAR_OPEN_BRACE) {
       // if starting a nested curly brace, error
       // e.g. foo/{{bar}_baz} is invalid
       //           ^
@@ -131,10 +165,18 @@ rcl_validate_topic_name_with_size(
         }
         return RCL_RET_OK;
       }
+      // a brace after a leading tilde is allowed but not a forward slash
+      // e.g. ~{sub}_foo is invalid
+      if (
+        1 == i && i + 1 < topic_name_length &&
+        topic_name[0] == '~' && RCL_TOPIC_NAME_VALID == token_result)
+      {
+        token_result = RCL_TOPIC_NAME_INVALID_TILDE_NOT_FOLLOWED_BY_FORWARD_SLASH;
+        token_index = 1;
+      }
+      opening_curly_brace_index = i;
       in_open_curly_brace = true;
-      // if it is a new, open curly brace, continue
-      continue;
-    } else if (topic_name[i] == '}') {
+    } else if (char_class & RCL_TOPIC_CHAR_CLOSE_BRACE) {
       // if not preceded by a {, error
       if (!in_open_curly_brace) {
         *validation_result = RCL_TOPIC_NAME_INVALID_UNMATCHED_CURLY_BRACE;
@@ -144,8 +186,6 @@ rcl_validate_topic_name_with_size(
         return RCL_RET_OK;
       }
       in_open_curly_brace = false;
-      // if it is a closing curly brace, continue
-      continue;
     } else {
       // if it is none of these, then it is an unallowed character in a topic name
       if (in_open_curly_brace) {
@@ -158,6 +198,7 @@ rcl_validate_topic_name_with_size(
       }
       return RCL_RET_OK;
     }
+    ++i;
   }
   // check to make sure substitutions were properly closed
   if (in_open_curly_brace) {
@@ -168,31 +209,13 @@ rcl_validate_topic_name_with_size(
     }
     return RCL_RET_OK;
   }
-  // check for tokens (other than the first) that start with a number
-  for (size_t i = 0; i < topic_name_length; ++i) {
-    if (i == topic_name_length - 1) {
-      // if this is the last character, then nothing to check
-      continue;
-    }
-    // past this point, assuming i+1 is a valid index
-    if (topic_name[i] == '/') {
-      if (isdigit(topic_name[i + 1]) != 0) {
-        // this is the case where a '/' if followed by a number, i.e. [0-9]
-        *validation_result = RCL_TOPIC_NAME_INVALID_NAME_TOKEN_STARTS_WITH_NUMBER;
-        if (invalid_index) {
-          *invalid_index = i + 1;
-        }
-        return RCL_RET_OK;
-      }
-    } else if (i == 1 && topic_name[0] == '~') {
-      // special case where first character is ~ but second character is not /
-      // e.g. ~foo is invalid
-      *validation_result = RCL_TOPIC_NAME_INVALID_TILDE_NOT_FOLLOWED_BY_FORWARD_SLASH;
-      if (invalid_index) {
-        *invalid_index = 1;
-      }
-      return RCL_RET_OK;
+  // report any token error recorded during the scan
+  if (RCL_TOPIC_NAME_VALID != token_result) {
+    *validation_result = token_result;
+    if (invalid_index) {
+      *invalid_index = token_index;
     }
+    return RCL_RET_OK;
   }
   // everything was ok, set result to valid topic, avoid setting invalid_index, and return
   *validation_result = RCL_TOPIC_NAME_VALID;
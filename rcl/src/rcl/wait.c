@@ -22,14 +22,42 @@ extern "C"
 #include <assert.h>
 #include <inttypes.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "rcl/counting_allocator.h"
 #include "rcl/error_handling.h"
 #include "rcl/time.h"
+#include "rcl/tracepoints.h"
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rmw/error_handling.h"
 #include "rmw/rmw.h"
 
+#include "./client_group_impl.h"
+#include "./entity_event_callbacks.h"
+#include "./event_impl.h"
+#include "./guard_condition_impl.h"
+#include "./timer_heap.h"
+#include "./timer_impl.h"
+
+// One client group added to the wait set, spanning a contiguous range of the
+// client arrays, see rcl_wait_set_add_client_group().
+typedef struct rcl_wait_set_client_group_record_t
+{
+  const rcl_client_group_t * group;
+  size_t first_index;
+  size_t count;
+  uint8_t priority;
+} rcl_wait_set_client_group_record_t;
+
+// One deadline event added to the wait set, see rcl_wait_set_add_event().
+typedef struct rcl_wait_set_event_record_t
+{
+  const rcl_event_t * event;
+  uint8_t priority;
+} rcl_wait_set_event_record_t;
+
 typedef struct rcl_wait_set_impl_t
 {
   // number of subscriptions that have been added to the wait set
@@ -38,9 +66,17 @@ typedef struct rcl_wait_set_impl_t
   // number of guard_conditions that have been added to the wait set
   size_t guard_condition_index;
   rmw_guard_conditions_t rmw_guard_conditions;
+  // deadline events added to the wait set; sized for one record per guard
+  // condition slot, see rcl_wait_set_add_event()
+  rcl_wait_set_event_record_t * event_records;
+  size_t event_record_count;
   // number of clients that have been added to the wait set
   size_t client_index;
   rmw_clients_t rmw_clients;
+  // client groups added to the wait set; sized for one record per client
+  // slot, which suffices since every group holds at least one client
+  rcl_wait_set_client_group_record_t * client_group_records;
+  size_t client_group_count;
   // number of services that have been added to the wait set
   size_t service_index;
   rmw_services_t rmw_services;
@@ -48,6 +84,82 @@ typedef struct rcl_wait_set_impl_t
   // number of timers that have been added to the wait set
   size_t timer_index;
   rcl_allocator_t allocator;
+  // min-heap over the added timers, keyed by absolute next call time
+  rcl_timer_heap_t timer_heap;
+  // false when the added timers cannot be served by the heap fast path,
+  // e.g. because they do not share a single steady or system time clock type
+  bool timer_heap_usable;
+  // clock of the first added timer, used for a single now() read per wait
+  rcl_clock_t * timer_clock;
+  // single contiguous block backing all entity arrays, their rmw mirrors,
+  // and the ready entity list, carved up in rcl_wait_set_resize()
+  void * entity_arena;
+  size_t entity_arena_size;
+  // compact list of entities made ready by the last wait,
+  // see rcl_wait_set_get_ready_entities()
+  rcl_ready_entity_t * ready_entities;
+  size_t ready_entity_count;
+  size_t ready_entity_capacity;
+  // scratch list used to order ready entities by priority
+  rcl_ready_entity_t * ready_entity_scratch;
+  // per slot dispatch priorities, recorded when the entity is added
+  uint8_t * subscription_priorities;
+  uint8_t * service_priorities;
+  // false until an entity with a non-zero priority is added, so wait sets
+  // which never use priorities skip the ordering pass entirely
+  bool has_priorities;
+  // high-watermark shrink policy, see rcl_wait_set_set_shrink_policy();
+  // a percent of zero means the policy is disabled
+  uint8_t shrink_occupancy_percent;
+  size_t shrink_wait_threshold;
+  // consecutive waits whose occupancy stayed below the policy's percentage
+  size_t shrink_low_streak;
+  // per kind high-watermarks observed during the current low occupancy
+  // streak; the wait set is shrunk to these when the streak is long enough
+  size_t shrink_streak_subscriptions;
+  size_t shrink_streak_guard_conditions;
+  size_t shrink_streak_timers;
+  size_t shrink_streak_clients;
+  size_t shrink_streak_services;
+  // retained mode state, see rcl_wait_set_set_retained()
+  bool retained;
+  // when true the retained snapshot is (re)built on the next rcl_wait() call
+  bool needs_rebuild;
+  // snapshots of the user visible entity arrays, restored before each wait
+  const rcl_subscription_t ** retained_subscriptions;
+  const rcl_guard_condition_t ** retained_guard_conditions;
+  const rcl_timer_t ** retained_timers;
+  const rcl_client_t ** retained_clients;
+  const rcl_service_t ** retained_services;
+  size_t retained_subscription_index;
+  size_t retained_guard_condition_index;
+  size_t retained_timer_index;
+  size_t retained_client_index;
+  size_t retained_service_index;
+  // snapshots of the rmw arrays, restored before each wait
+  void ** retained_rmw_subscriptions;
+  void ** retained_rmw_guard_conditions;
+  void ** retained_rmw_clients;
+  void ** retained_rmw_services;
+  size_t retained_rmw_subscription_count;
+  size_t retained_rmw_guard_condition_count;
+  size_t retained_rmw_client_count;
+  size_t retained_rmw_service_count;
+  // child wait sets attached for composite waits, see rcl_wait_set_attach()
+  rcl_wait_set_t ** children;
+  size_t child_count;
+  size_t child_capacity;
+  // scratch block backing the union rmw arrays of a composite wait
+  void ** composite_handles;
+  size_t composite_handle_capacity;
+  // rmw wait set sized for the union, created on the first composite wait
+  rmw_wait_set_t * composite_rmw_wait_set;
+  size_t composite_rmw_capacity;
+  // cumulative load counters, see rcl_wait_set_get_load(); written by the
+  // waiting thread with atomic stores so any other thread can read them
+  atomic_uint_least64_t load_wait_count;
+  atomic_uint_least64_t load_wake_count;
+  atomic_uint_least64_t load_ready_count;
 } rcl_wait_set_impl_t;
 
 rcl_wait_set_t
@@ -75,15 +187,67 @@ __wait_set_is_valid(const rcl_wait_set_t * wait_set)
   return wait_set && wait_set->impl;
 }
 
+static void
+__wait_set_reset_shrink_streak(rcl_wait_set_impl_t * impl)
+{
+  impl->shrink_low_streak = 0;
+  impl->shrink_streak_subscriptions = 0;
+  impl->shrink_streak_guard_conditions = 0;
+  impl->shrink_streak_timers = 0;
+  impl->shrink_streak_clients = 0;
+  impl->shrink_streak_services = 0;
+}
+
+static void
+__wait_set_release_retained(rcl_wait_set_t * wait_set)
+{
+  rcl_allocator_t allocator = wait_set->impl->allocator;
+#define RETAINED_DEALLOC(Member) \
+  if (wait_set->impl->Member) { \
+    allocator.deallocate((void *)wait_set->impl->Member, allocator.state); \
+    wait_set->impl->Member = NULL; \
+  }
+  RETAINED_DEALLOC(retained_subscriptions)
+  RETAINED_DEALLOC(retained_guard_conditions)
+  RETAINED_DEALLOC(retained_timers)
+  RETAINED_DEALLOC(retained_clients)
+  RETAINED_DEALLOC(retained_services)
+  RETAINED_DEALLOC(retained_rmw_subscriptions)
+  RETAINED_DEALLOC(retained_rmw_guard_conditions)
+  RETAINED_DEALLOC(retained_rmw_clients)
+  RETAINED_DEALLOC(retained_rmw_services)
+#undef RETAINED_DEALLOC
+  wait_set->impl->needs_rebuild = true;
+}
+
 static void
 __wait_set_clean_up(rcl_wait_set_t * wait_set, rcl_allocator_t allocator)
 {
-  if (wait_set->subscriptions) {
+  if (wait_set->impl) {
+    __wait_set_release_retained(wait_set);
+    rcl_ret_t heap_ret = rcl_timer_heap_fini(&wait_set->impl->timer_heap);
+    (void)heap_ret;  // NO LINT
+    assert(RCL_RET_OK == heap_ret);  // Defensive, shouldn't fail with a valid impl.
+  }
+  if (wait_set->impl && wait_set->impl->entity_arena) {
     rcl_ret_t ret = rcl_wait_set_resize(wait_set, 0, 0, 0, 0, 0);
     (void)ret;  // NO LINT
     assert(RCL_RET_OK == ret);  // Defensive, shouldn't fail with size 0.
   }
   if (wait_set->impl) {
+    if (wait_set->impl->children) {
+      allocator.deallocate((void *)wait_set->impl->children, allocator.state);
+    }
+    if (wait_set->impl->composite_handles) {
+      allocator.deallocate((void *)wait_set->impl->composite_handles, allocator.state);
+    }
+    if (wait_set->impl->composite_rmw_wait_set) {
+      if (RMW_RET_OK != rmw_destroy_wait_set(wait_set->impl->composite_rmw_wait_set)) {
+        RCUTILS_LOG_ERROR_NAMED(
+          ROS_PACKAGE_NAME, "failed to destroy composite rmw wait set: %s",
+          rmw_get_error_string().str);
+      }
+    }
     allocator.deallocate(wait_set->impl, allocator.state);
     wait_set->impl = NULL;
   }
@@ -107,6 +271,8 @@ rcl_wait_set_init(
   rcl_ret_t fail_ret = RCL_RET_ERROR;
 
   RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  // Attribute the wait set's allocations; a no-op unless accounting is on.
+  allocator = rcl_counting_allocator_wrap(allocator, RCL_ALLOC_TAG_WAIT_SET);
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   if (__wait_set_is_valid(wait_set)) {
     RCL_SET_ERROR_MSG("wait_set already initialized, or memory was uninitialized.");
@@ -126,6 +292,17 @@ rcl_wait_set_init(
   wait_set->impl->rmw_clients.client_count = 0;
   wait_set->impl->rmw_services.services = NULL;
   wait_set->impl->rmw_services.service_count = 0;
+  wait_set->impl->timer_heap = rcl_get_zero_initialized_timer_heap();
+  rcl_ret_t heap_ret = rcl_timer_heap_init(
+    &wait_set->impl->timer_heap, number_of_timers, allocator);
+  if (RCL_RET_OK != heap_ret) {
+    fail_ret = heap_ret;
+    goto fail;
+  }
+  wait_set->impl->timer_heap_usable = true;
+  atomic_init(&wait_set->impl->load_wait_count, 0);
+  atomic_init(&wait_set->impl->load_wake_count, 0);
+  atomic_init(&wait_set->impl->load_ready_count, 0);
 
   wait_set->impl->rmw_wait_set = rmw_create_wait_set(
     2 * number_of_subscriptions + number_of_guard_conditions + number_of_clients +
@@ -186,19 +363,28 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
   return RCL_RET_OK;
 }
 
+static void
+__wait_set_restore_retained(rcl_wait_set_t * wait_set);
+
 #define SET_ADD(Type) \
-  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT); \
-  if (!__wait_set_is_valid(wait_set)) { \
-    RCL_SET_ERROR_MSG("wait set is invalid"); \
-    return RCL_RET_WAIT_SET_INVALID; \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT); \
+  RCL_HOT_CHECK_FOR_VALID_WITH_MSG( \
+    __wait_set_is_valid(wait_set), "wait set is invalid", RCL_RET_WAIT_SET_INVALID); \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(Type, RCL_RET_INVALID_ARGUMENT); \
+  /* After a wait the user arrays are pruned to the ready entities; in */ \
+  /* retained mode the snapshot still has the full contents, so restore */ \
+  /* it before appending. */ \
+  if (wait_set->impl->retained && !wait_set->impl->needs_rebuild) { \
+    __wait_set_restore_retained(wait_set); \
   } \
-  RCL_CHECK_ARGUMENT_FOR_NULL(Type, RCL_RET_INVALID_ARGUMENT); \
   if (!(wait_set->impl->Type ## _index < wait_set->size_of_ ## Type ## s)) { \
     RCL_SET_ERROR_MSG(#Type "s set is full"); \
     return RCL_RET_WAIT_SET_FULL; \
   } \
   size_t current_index = wait_set->impl->Type ## _index++; \
   wait_set->Type ## s[current_index] = Type; \
+  /* The retained snapshot, if any, no longer matches the set contents. */ \
+  wait_set->impl->needs_rebuild = true; \
   /* Set optional output argument */ \
   if (NULL != index) { \
     *index = current_index; \
@@ -212,6 +398,64 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
   wait_set->impl->RMWStorage[current_index] = rmw_handle->data; \
   wait_set->impl->RMWCount++;
 
+#define SET_ADD_BULK(Type) \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT); \
+  RCL_HOT_CHECK_FOR_VALID_WITH_MSG( \
+    __wait_set_is_valid(wait_set), "wait set is invalid", RCL_RET_WAIT_SET_INVALID); \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(Type ## s, RCL_RET_INVALID_ARGUMENT); \
+  /* After a wait the user arrays are pruned to the ready entities; in */ \
+  /* retained mode the snapshot still has the full contents, so restore */ \
+  /* it before appending. */ \
+  if (wait_set->impl->retained && !wait_set->impl->needs_rebuild) { \
+    __wait_set_restore_retained(wait_set); \
+  } \
+  if (!( \
+      wait_set->impl->Type ## _index + number_of_ ## Type ## s <= \
+      wait_set->size_of_ ## Type ## s)) \
+  { \
+    RCL_SET_ERROR_MSG(#Type "s set is full"); \
+    return RCL_RET_WAIT_SET_FULL; \
+  } \
+  size_t bulk_first_index = wait_set->impl->Type ## _index; \
+  memcpy( \
+    (void *)&wait_set->Type ## s[bulk_first_index], (const void *)Type ## s, \
+    sizeof(rcl_ ## Type ## _t *) * number_of_ ## Type ## s); \
+  wait_set->impl->Type ## _index += number_of_ ## Type ## s; \
+  /* The retained snapshot, if any, no longer matches the set contents. */ \
+  wait_set->impl->needs_rebuild = true; \
+  /* Set optional output argument */ \
+  if (NULL != first_index) { \
+    *first_index = bulk_first_index; \
+  }
+
+#define SET_ADD_BULK_RMW(Type, RMWStorage, RMWCount) \
+  /* Also place all handles into rmw storage. */ \
+  for (size_t bulk_i = 0; bulk_i < number_of_ ## Type ## s; ++bulk_i) { \
+    RCL_HOT_CHECK_ARGUMENT_FOR_NULL(Type ## s[bulk_i], RCL_RET_INVALID_ARGUMENT); \
+    rmw_ ## Type ## _t * rmw_handle = rcl_ ## Type ## _get_rmw_handle(Type ## s[bulk_i]); \
+    RCL_CHECK_FOR_NULL_WITH_MSG( \
+      rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR); \
+    wait_set->impl->RMWStorage[bulk_first_index + bulk_i] = rmw_handle->data; \
+  } \
+  wait_set->impl->RMWCount += number_of_ ## Type ## s;
+
+#define SET_RECORD_PRIORITY(Type, Entity, Index) \
+  /* Carry the entity's dispatch priority into the wait set. */ \
+  { \
+    const rcl_ ## Type ## _options_t * entity_options = rcl_ ## Type ## _get_options(Entity); \
+    RCL_CHECK_FOR_NULL_WITH_MSG( \
+      entity_options, rcl_get_error_string().str, return RCL_RET_ERROR); \
+    wait_set->impl->Type ## _priorities[Index] = entity_options->priority; \
+    if (0 != entity_options->priority) { \
+      wait_set->impl->has_priorities = true; \
+    } \
+  }
+
+#define SET_RECORD_PRIORITY_BULK(Type) \
+  for (size_t bulk_i = 0; bulk_i < number_of_ ## Type ## s; ++bulk_i) { \
+    SET_RECORD_PRIORITY(Type, Type ## s[bulk_i], bulk_first_index + bulk_i) \
+  }
+
 #define SET_CLEAR(Type) \
   do { \
     if (NULL != wait_set->Type ## s) { \
@@ -235,50 +479,64 @@ rcl_wait_set_get_allocator(const rcl_wait_set_t * wait_set, rcl_allocator_t * al
     } \
   } while (false)
 
-#define SET_RESIZE(Type, ExtraDealloc, ExtraRealloc) \
+#define SET_REMOVE_FIND(Type) \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT); \
+  RCL_HOT_CHECK_FOR_VALID_WITH_MSG( \
+    __wait_set_is_valid(wait_set), "wait set is invalid", RCL_RET_WAIT_SET_INVALID); \
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(Type, RCL_RET_INVALID_ARGUMENT); \
+  /* After a wait the user arrays are pruned to the ready entities; in */ \
+  /* retained mode the snapshot still has the full contents, so restore */ \
+  /* it before searching. */ \
+  if (wait_set->impl->retained && !wait_set->impl->needs_rebuild) { \
+    __wait_set_restore_retained(wait_set); \
+  } \
+  size_t found_index = wait_set->impl->Type ## _index; \
+  for (size_t find_i = 0; find_i < wait_set->impl->Type ## _index; ++find_i) { \
+    if (wait_set->Type ## s[find_i] == Type) { \
+      found_index = find_i; \
+      break; \
+    } \
+  } \
+  if (found_index == wait_set->impl->Type ## _index) { \
+    RCL_SET_ERROR_MSG(#Type " is not in the wait set"); \
+    return RCL_RET_INVALID_ARGUMENT; \
+  }
+
+#define SET_REMOVE_COMPACT(Type) \
+  const size_t tail_count = --wait_set->impl->Type ## _index - found_index; \
+  memmove( \
+    (void *)&wait_set->Type ## s[found_index], \
+    (void *)&wait_set->Type ## s[found_index + 1], \
+    sizeof(rcl_ ## Type ## _t *) * tail_count); \
+  wait_set->Type ## s[wait_set->impl->Type ## _index] = NULL; \
+  /* The retained snapshot, if any, no longer matches the set contents. */ \
+  wait_set->impl->needs_rebuild = true;
+
+#define SET_REMOVE_RMW(RMWStorage, RMWCount) \
+  /* Close the gap in the rmw storage the same way. */ \
+  memmove( \
+    &wait_set->impl->RMWStorage[found_index], \
+    &wait_set->impl->RMWStorage[found_index + 1], \
+    sizeof(void *) * tail_count); \
+  wait_set->impl->RMWStorage[--wait_set->impl->RMWCount] = NULL;
+
+#define SET_REMOVE_PRIORITY(Type) \
+  memmove( \
+    &wait_set->impl->Type ## _priorities[found_index], \
+    &wait_set->impl->Type ## _priorities[found_index + 1], \
+    sizeof(uint8_t) * tail_count);
+
+#define READY_ENTITY_APPEND(EntityType, Index, Priority) \
   do { \
-    rcl_allocator_t allocator = wait_set->impl->allocator; \
-    wait_set->size_of_ ## Type ## s = 0; \
-    wait_set->impl->Type ## _index = 0; \
-    if (0 == Type ## s_size) { \
-      if (wait_set->Type ## s) { \
-        allocator.deallocate((void *)wait_set->Type ## s, allocator.state); \
-        wait_set->Type ## s = NULL; \
-      } \
-      ExtraDealloc \
-    } else { \
-      wait_set->Type ## s = (const rcl_ ## Type ## _t **)allocator.reallocate( \
-        (void *)wait_set->Type ## s, sizeof(rcl_ ## Type ## _t *) * Type ## s_size, \
-        allocator.state); \
-      RCL_CHECK_FOR_NULL_WITH_MSG( \
-        wait_set->Type ## s, "allocating memory failed", return RCL_RET_BAD_ALLOC); \
-      memset((void *)wait_set->Type ## s, 0, sizeof(rcl_ ## Type ## _t *) * Type ## s_size); \
-      wait_set->size_of_ ## Type ## s = Type ## s_size; \
-      ExtraRealloc \
+    if (wait_set->impl->ready_entity_count < wait_set->impl->ready_entity_capacity) { \
+      rcl_ready_entity_t * ready_entity = \
+        &wait_set->impl->ready_entities[wait_set->impl->ready_entity_count++]; \
+      ready_entity->type = EntityType; \
+      ready_entity->index = (Index); \
+      ready_entity->priority = (Priority); \
     } \
   } while (false)
 
-#define SET_RESIZE_RMW_DEALLOC(RMWStorage, RMWCount) \
-  /* Also deallocate the rmw storage. */ \
-  if (wait_set->impl->RMWStorage) { \
-    allocator.deallocate((void *)wait_set->impl->RMWStorage, allocator.state); \
-    wait_set->impl->RMWStorage = NULL; \
-    wait_set->impl->RMWCount = 0; \
-  }
-
-#define SET_RESIZE_RMW_REALLOC(Type, RMWStorage, RMWCount) \
-  /* Also resize the rmw storage. */ \
-  wait_set->impl->RMWCount = 0; \
-  wait_set->impl->RMWStorage = (void **)allocator.reallocate( \
-    wait_set->impl->RMWStorage, sizeof(void *) * Type ## s_size, allocator.state); \
-  if (!wait_set->impl->RMWStorage) { \
-    allocator.deallocate((void *)wait_set->Type ## s, allocator.state); \
-    wait_set->size_of_ ## Type ## s = 0; \
-    RCL_SET_ERROR_MSG("allocating memory failed"); \
-    return RCL_RET_BAD_ALLOC; \
-  } \
-  memset(wait_set->impl->RMWStorage, 0, sizeof(void *) * Type ## s_size);
-
 /* Implementation-specific notes:
  *
  * Add the rmw representation to the underlying rmw array and increment
@@ -292,6 +550,38 @@ rcl_wait_set_add_subscription(
 {
   SET_ADD(subscription)
   SET_ADD_RMW(subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count)
+  SET_RECORD_PRIORITY(subscription, subscription, current_index)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_add_subscriptions(
+  rcl_wait_set_t * wait_set,
+  const rcl_subscription_t ** subscriptions,
+  size_t number_of_subscriptions,
+  size_t * first_index)
+{
+  SET_ADD_BULK(subscription)
+  SET_ADD_BULK_RMW(subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count)
+  SET_RECORD_PRIORITY_BULK(subscription)
+  return RCL_RET_OK;
+}
+
+/* Implementation-specific notes:
+ *
+ * The entries after the removed one are moved down one spot, in the entity
+ * array, its rmw mirror, and the recorded priorities, so the arrays stay
+ * contiguous and the next wait's post-wait scans see no gap.
+ */
+rcl_ret_t
+rcl_wait_set_remove_subscription(
+  rcl_wait_set_t * wait_set,
+  const rcl_subscription_t * subscription)
+{
+  SET_REMOVE_FIND(subscription)
+  SET_REMOVE_COMPACT(subscription)
+  SET_REMOVE_RMW(rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count)
+  SET_REMOVE_PRIORITY(subscription)
   return RCL_RET_OK;
 }
 
@@ -329,6 +619,43 @@ rcl_wait_set_clear(rcl_wait_set_t * wait_set)
     rmw_services.services,
     rmw_services.service_count);
 
+  wait_set->impl->needs_rebuild = true;
+  wait_set->impl->has_priorities = false;
+  wait_set->impl->client_group_count = 0;
+  wait_set->impl->event_record_count = 0;
+  rcl_timer_heap_clear(&wait_set->impl->timer_heap);
+  wait_set->impl->timer_heap_usable = true;
+  wait_set->impl->timer_clock = NULL;
+
+  // Apply a pending high-watermark shrink now that the contents are being
+  // discarded anyway, so the entity arrays are never reallocated while the
+  // caller may still be reading them after a wait.
+  if (
+    wait_set->impl->shrink_wait_threshold > 0 &&
+    wait_set->impl->shrink_low_streak >= wait_set->impl->shrink_wait_threshold)
+  {
+    const size_t subscriptions_size = wait_set->impl->shrink_streak_subscriptions;
+    const size_t guard_conditions_size = wait_set->impl->shrink_streak_guard_conditions;
+    const size_t timers_size = wait_set->impl->shrink_streak_timers;
+    const size_t clients_size = wait_set->impl->shrink_streak_clients;
+    const size_t services_size = wait_set->impl->shrink_streak_services;
+    __wait_set_reset_shrink_streak(wait_set->impl);
+    if (
+      subscriptions_size != wait_set->size_of_subscriptions ||
+      guard_conditions_size != wait_set->size_of_guard_conditions ||
+      timers_size != wait_set->size_of_timers ||
+      clients_size != wait_set->size_of_clients ||
+      services_size != wait_set->size_of_services)
+    {
+      rcl_ret_t ret = rcl_wait_set_resize(
+        wait_set, subscriptions_size, guard_conditions_size, timers_size,
+        clients_size, services_size);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+    }
+  }
+
   return RCL_RET_OK;
 }
 
@@ -348,62 +675,265 @@ rcl_wait_set_resize(
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set->impl, RCL_RET_WAIT_SET_INVALID);
-  SET_RESIZE(
-    subscription,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count),
-    SET_RESIZE_RMW_REALLOC(
-      subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count)
-  );
-  // Guard condition RCL size is the resize amount given
-  SET_RESIZE(guard_condition,;,;);  // NOLINT
-
-  // Guard condition RMW size needs to be guard conditions + timers
-  rmw_guard_conditions_t * rmw_gcs = &(wait_set->impl->rmw_guard_conditions);
+  // The retained snapshot buffers are sized for the old capacities.
+  __wait_set_release_retained(wait_set);
+  // Timer array indices recorded in the heap are invalidated by a resize.
+  rcl_timer_heap_clear(&wait_set->impl->timer_heap);
+  wait_set->impl->timer_heap_usable = true;
+  wait_set->impl->timer_clock = NULL;
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  rcl_allocator_t allocator = impl->allocator;
+
+  // Invalidate the old layout up front; on failure the wait set ends up
+  // empty but in a consistent state.
+  wait_set->subscriptions = NULL;
+  wait_set->size_of_subscriptions = 0;
+  wait_set->guard_conditions = NULL;
+  wait_set->size_of_guard_conditions = 0;
+  wait_set->timers = NULL;
+  wait_set->size_of_timers = 0;
+  wait_set->clients = NULL;
+  wait_set->size_of_clients = 0;
+  wait_set->services = NULL;
+  wait_set->size_of_services = 0;
+  impl->subscription_index = 0;
+  impl->guard_condition_index = 0;
+  impl->timer_index = 0;
+  impl->client_index = 0;
+  impl->service_index = 0;
+  impl->rmw_subscriptions.subscribers = NULL;
+  impl->rmw_subscriptions.subscriber_count = 0;
+  impl->rmw_guard_conditions.guard_conditions = NULL;
+  impl->rmw_guard_conditions.guard_condition_count = 0;
+  impl->rmw_clients.clients = NULL;
+  impl->rmw_clients.client_count = 0;
+  impl->rmw_services.services = NULL;
+  impl->rmw_services.service_count = 0;
+  impl->client_group_records = NULL;
+  impl->client_group_count = 0;
+  impl->event_records = NULL;
+  impl->event_record_count = 0;
+  impl->ready_entities = NULL;
+  impl->ready_entity_count = 0;
+  impl->ready_entity_capacity = 0;
+  impl->ready_entity_scratch = NULL;
+  impl->subscription_priorities = NULL;
+  impl->service_priorities = NULL;
+  impl->has_priorities = false;
+
+  // One contiguous arena backs the rcl entity arrays, their rmw mirrors, and
+  // the ready entity list, so resizing is a single reallocation and waiting
+  // works on one cache friendly block.
+  const size_t number_of_entities = subscriptions_size + guard_conditions_size +
+    timers_size + clients_size + services_size;
+  // The rmw guard condition array also holds one slot per timer.
   const size_t num_rmw_gc = guard_conditions_size + timers_size;
-  // Clear added guard conditions
-  rmw_gcs->guard_condition_count = 0u;
-  if (0u == num_rmw_gc) {
-    if (rmw_gcs->guard_conditions) {
-      wait_set->impl->allocator.deallocate(
-        (void *)rmw_gcs->guard_conditions, wait_set->impl->allocator.state);
-      rmw_gcs->guard_conditions = NULL;
+  const size_t number_of_rmw_handles =
+    subscriptions_size + num_rmw_gc + clients_size + services_size;
+  // Events contribute ready entries on top of the entity count, so the
+  // ready lists are sized for both.
+  const size_t number_of_ready_slots = number_of_entities + guard_conditions_size;
+  const size_t arena_size =
+    sizeof(void *) * (number_of_entities + number_of_rmw_handles) +
+    2 * sizeof(rcl_ready_entity_t) * number_of_ready_slots +
+    sizeof(rcl_wait_set_client_group_record_t) * clients_size +
+    sizeof(rcl_wait_set_event_record_t) * guard_conditions_size +
+    sizeof(uint8_t) * (subscriptions_size + services_size);
+  if (0 == arena_size) {
+    if (impl->entity_arena) {
+      allocator.deallocate(impl->entity_arena, allocator.state);
+      impl->entity_arena = NULL;
     }
-  } else {
-    rmw_gcs->guard_conditions = (void **)wait_set->impl->allocator.reallocate(
-      rmw_gcs->guard_conditions, sizeof(void *) * num_rmw_gc, wait_set->impl->allocator.state);
-    if (!rmw_gcs->guard_conditions) {
-      // Deallocate rcl arrays to match unallocated rmw guard conditions
-      wait_set->impl->allocator.deallocate(
-        (void *)wait_set->guard_conditions, wait_set->impl->allocator.state);
-      wait_set->size_of_guard_conditions = 0u;
-      wait_set->guard_conditions = NULL;
-      wait_set->impl->allocator.deallocate(
-        (void *)wait_set->timers, wait_set->impl->allocator.state);
-      wait_set->size_of_timers = 0u;
-      wait_set->timers = NULL;
+    impl->entity_arena_size = 0;
+    return RCL_RET_OK;
+  }
+  if (arena_size != impl->entity_arena_size) {
+    void * entity_arena = allocator.reallocate(impl->entity_arena, arena_size, allocator.state);
+    if (!entity_arena) {
+      // The old block is untouched by a failed reallocate, release it.
+      allocator.deallocate(impl->entity_arena, allocator.state);
+      impl->entity_arena = NULL;
+      impl->entity_arena_size = 0;
       RCL_SET_ERROR_MSG("allocating memory failed");
       return RCL_RET_BAD_ALLOC;
     }
-    memset(rmw_gcs->guard_conditions, 0, sizeof(void *) * num_rmw_gc);
-  }
-
-  SET_RESIZE(timer,;,;);  // NOLINT
-  SET_RESIZE(client,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_clients.clients, rmw_clients.client_count),
-    SET_RESIZE_RMW_REALLOC(
-      client, rmw_clients.clients, rmw_clients.client_count)
-  );
-  SET_RESIZE(service,
-    SET_RESIZE_RMW_DEALLOC(
-      rmw_services.services, rmw_services.service_count),
-    SET_RESIZE_RMW_REALLOC(
-      service, rmw_services.services, rmw_services.service_count)
-  );
+    impl->entity_arena = entity_arena;
+    impl->entity_arena_size = arena_size;
+  }
+  memset(impl->entity_arena, 0, arena_size);
+
+  // Carve the arrays out of the arena.  Every chunk is a whole number of
+  // pointers, so each one stays suitably aligned.
+  uint8_t * arena_ptr = (uint8_t *)impl->entity_arena;
+#define ARENA_CARVE(Type) \
+  do { \
+    if (Type ## s_size > 0) { \
+      wait_set->Type ## s = (const rcl_ ## Type ## _t **)(void *)arena_ptr; \
+      arena_ptr += sizeof(void *) * Type ## s_size; \
+      wait_set->size_of_ ## Type ## s = Type ## s_size; \
+    } \
+  } while (false)
+  ARENA_CARVE(subscription);
+  ARENA_CARVE(guard_condition);
+  ARENA_CARVE(timer);
+  ARENA_CARVE(client);
+  ARENA_CARVE(service);
+#undef ARENA_CARVE
+  if (subscriptions_size > 0) {
+    impl->rmw_subscriptions.subscribers = (void **)(void *)arena_ptr;
+    arena_ptr += sizeof(void *) * subscriptions_size;
+  }
+  if (num_rmw_gc > 0) {
+    impl->rmw_guard_conditions.guard_conditions = (void **)(void *)arena_ptr;
+    arena_ptr += sizeof(void *) * num_rmw_gc;
+  }
+  if (clients_size > 0) {
+    impl->rmw_clients.clients = (void **)(void *)arena_ptr;
+    arena_ptr += sizeof(void *) * clients_size;
+  }
+  if (services_size > 0) {
+    impl->rmw_services.services = (void **)(void *)arena_ptr;
+    arena_ptr += sizeof(void *) * services_size;
+  }
+  impl->ready_entities = (rcl_ready_entity_t *)(void *)arena_ptr;
+  arena_ptr += sizeof(rcl_ready_entity_t) * number_of_ready_slots;
+  impl->ready_entity_capacity = number_of_ready_slots;
+  impl->ready_entity_scratch = (rcl_ready_entity_t *)(void *)arena_ptr;
+  arena_ptr += sizeof(rcl_ready_entity_t) * number_of_ready_slots;
+  if (clients_size > 0) {
+    impl->client_group_records = (rcl_wait_set_client_group_record_t *)(void *)arena_ptr;
+    arena_ptr += sizeof(rcl_wait_set_client_group_record_t) * clients_size;
+  }
+  if (guard_conditions_size > 0) {
+    impl->event_records = (rcl_wait_set_event_record_t *)(void *)arena_ptr;
+    arena_ptr += sizeof(rcl_wait_set_event_record_t) * guard_conditions_size;
+  }
+  // The byte arrays go last so the pointer sized chunks above stay aligned.
+  if (subscriptions_size > 0) {
+    impl->subscription_priorities = arena_ptr;
+    arena_ptr += sizeof(uint8_t) * subscriptions_size;
+  }
+  if (services_size > 0) {
+    impl->service_priorities = arena_ptr;
+    arena_ptr += sizeof(uint8_t) * services_size;
+  }
+  assert((size_t)(arena_ptr - (uint8_t *)impl->entity_arena) == arena_size);  // NO LINT
+
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_shrink_to_fit(rcl_wait_set_t * wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set->impl, RCL_RET_WAIT_SET_INVALID);
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  // Events count against the guard condition capacity without occupying a
+  // guard condition slot, so keep room for whichever is larger.
+  size_t guard_conditions_size = impl->guard_condition_index;
+  if (impl->event_record_count > guard_conditions_size) {
+    guard_conditions_size = impl->event_record_count;
+  }
+  if (
+    impl->subscription_index == wait_set->size_of_subscriptions &&
+    guard_conditions_size == wait_set->size_of_guard_conditions &&
+    impl->timer_index == wait_set->size_of_timers &&
+    impl->client_index == wait_set->size_of_clients &&
+    impl->service_index == wait_set->size_of_services)
+  {
+    return RCL_RET_OK;
+  }
+  return rcl_wait_set_resize(
+    wait_set, impl->subscription_index, guard_conditions_size,
+    impl->timer_index, impl->client_index, impl->service_index);
+}
+
+rcl_ret_t
+rcl_wait_set_set_shrink_policy(
+  rcl_wait_set_t * wait_set,
+  uint8_t occupancy_percent,
+  size_t number_of_waits)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set->impl, RCL_RET_WAIT_SET_INVALID);
+  if (occupancy_percent > 100) {
+    RCL_SET_ERROR_MSG("occupancy_percent must be in [0, 100]");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (0 == occupancy_percent || 0 == number_of_waits) {
+    // Disable the policy.
+    wait_set->impl->shrink_occupancy_percent = 0;
+    wait_set->impl->shrink_wait_threshold = 0;
+  } else {
+    wait_set->impl->shrink_occupancy_percent = occupancy_percent;
+    wait_set->impl->shrink_wait_threshold = number_of_waits;
+  }
+  __wait_set_reset_shrink_streak(wait_set->impl);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_attach(rcl_wait_set_t * parent, rcl_wait_set_t * child)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(parent, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(child, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(parent) || !__wait_set_is_valid(child)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  if (parent == child) {
+    RCL_SET_ERROR_MSG("cannot attach a wait set to itself");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Composition is one level deep; deeper nesting would make readiness
+  // reporting ambiguous and permits attachment cycles.
+  if (child->impl->child_count > 0) {
+    RCL_SET_ERROR_MSG("cannot attach a wait set which has children of its own");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  rcl_wait_set_impl_t * impl = parent->impl;
+  for (size_t i = 0; i < impl->child_count; ++i) {
+    if (impl->children[i] == child) {
+      RCL_SET_ERROR_MSG("wait set is already attached");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+  }
+  if (impl->child_count == impl->child_capacity) {
+    rcl_allocator_t allocator = impl->allocator;
+    size_t new_capacity = impl->child_capacity ? 2 * impl->child_capacity : 4;
+    rcl_wait_set_t ** children = (rcl_wait_set_t **)allocator.reallocate(
+      (void *)impl->children, sizeof(rcl_wait_set_t *) * new_capacity, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      children, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->children = children;
+    impl->child_capacity = new_capacity;
+  }
+  impl->children[impl->child_count++] = child;
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_wait_set_detach(rcl_wait_set_t * parent, rcl_wait_set_t * child)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(parent, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(child, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(parent)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  rcl_wait_set_impl_t * impl = parent->impl;
+  for (size_t i = 0; i < impl->child_count; ++i) {
+    if (impl->children[i] == child) {
+      // Attachment order has no meaning to the union, so close the gap with
+      // the last entry.
+      impl->children[i] = impl->children[--impl->child_count];
+      return RCL_RET_OK;
+    }
+  }
+  RCL_SET_ERROR_MSG("wait set is not attached");
+  return RCL_RET_INVALID_ARGUMENT;
+}
+
 rcl_ret_t
 rcl_wait_set_add_guard_condition(
   rcl_wait_set_t * wait_set,
@@ -418,17 +948,118 @@ rcl_wait_set_add_guard_condition(
 }
 
 rcl_ret_t
-rcl_wait_set_add_timer(
+rcl_wait_set_add_guard_conditions(
   rcl_wait_set_t * wait_set,
-  const rcl_timer_t * timer,
+  const rcl_guard_condition_t ** guard_conditions,
+  size_t number_of_guard_conditions,
+  size_t * first_index)
+{
+  SET_ADD_BULK(guard_condition)
+  SET_ADD_BULK_RMW(guard_condition, rmw_guard_conditions.guard_conditions,
+    rmw_guard_conditions.guard_condition_count)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_remove_guard_condition(
+  rcl_wait_set_t * wait_set,
+  const rcl_guard_condition_t * guard_condition)
+{
+  SET_REMOVE_FIND(guard_condition)
+  SET_REMOVE_COMPACT(guard_condition)
+  // Timer guard conditions live past the first size_of_guard_conditions rmw
+  // slots, so compacting the user range here cannot disturb them.
+  SET_REMOVE_RMW(
+    rmw_guard_conditions.guard_conditions, rmw_guard_conditions.guard_condition_count)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_add_event(
+  rcl_wait_set_t * wait_set,
+  const rcl_event_t * event,
   size_t * index)
 {
-  SET_ADD(timer)
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_FOR_VALID_WITH_MSG(
+    __wait_set_is_valid(wait_set), "wait set is invalid", RCL_RET_WAIT_SET_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(event, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    event->impl, "event is invalid", return RCL_RET_INVALID_ARGUMENT);
+  // After a wait the user arrays are pruned to the ready entities; in
+  // retained mode the snapshot still has the full contents, so restore it
+  // before appending.
+  if (wait_set->impl->retained && !wait_set->impl->needs_rebuild) {
+    __wait_set_restore_retained(wait_set);
+  }
+  // The record array is sized by the guard condition capacity.
+  if (!(wait_set->impl->event_record_count < wait_set->size_of_guard_conditions)) {
+    RCL_SET_ERROR_MSG("events set is full");
+    return RCL_RET_WAIT_SET_FULL;
+  }
+  rcl_wait_set_event_record_t * record =
+    &wait_set->impl->event_records[wait_set->impl->event_record_count];
+  record->event = event;
+  record->priority = event->impl->options.priority;
+  if (0 != record->priority) {
+    wait_set->impl->has_priorities = true;
+  }
+  if (NULL != index) {
+    *index = wait_set->impl->event_record_count;
+  }
+  ++wait_set->impl->event_record_count;
+  return RCL_RET_OK;
+}
+
+/* Record a newly added timer in the deadline heap and, if it has one, put
+ * its guard condition into the rmw guard condition array.
+ */
+static rcl_ret_t
+__wait_set_track_added_timer(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t * timer,
+  size_t current_index)
+{
+  // Track the timer in the deadline heap if the fast path is still usable.
+  if (wait_set->impl->timer_heap_usable) {
+    rcl_clock_t * clock = NULL;
+    // rcl_timer_clock() does not modify the timer, it is just not const correct.
+    rcl_ret_t clock_ret = rcl_timer_clock((rcl_timer_t *)timer, &clock);
+    if (RCL_RET_OK != clock_ret) {
+      return clock_ret;  // The rcl error state should already be set.
+    }
+    if (NULL == wait_set->impl->timer_clock) {
+      wait_set->impl->timer_clock = clock;
+    }
+    // The heap orders absolute deadlines, which is only meaningful when all
+    // timers share an epoch; restrict it to steady/system time of one type.
+    if (
+      (RCL_STEADY_TIME != clock->type && RCL_SYSTEM_TIME != clock->type) ||
+      clock->type != wait_set->impl->timer_clock->type)
+    {
+      wait_set->impl->timer_heap_usable = false;
+      rcl_timer_heap_clear(&wait_set->impl->timer_heap);
+    } else {
+      // Read the generation before the deadline: if the timer mutates in
+      // between, the next generation check will simply force a refresh.
+      uint64_t generation = rcutils_atomic_load_uint64_t(&timer->impl->modification_count);
+      int64_t deadline = 0;
+      rcl_ret_t deadline_ret = rcl_timer_get_next_call_time(timer, &deadline);
+      if (RCL_RET_OK != deadline_ret) {
+        return deadline_ret;  // The rcl error state should already be set.
+      }
+      rcl_ret_t push_ret = rcl_timer_heap_push(
+        &wait_set->impl->timer_heap, timer, deadline, generation, current_index);
+      if (RCL_RET_OK != push_ret) {
+        return push_ret;  // The rcl error state should already be set.
+      }
+    }
+  }
   // Add timer guard conditions to end of rmw guard condtion set.
   rcl_guard_condition_t * guard_condition = rcl_timer_get_guard_condition(timer);
   if (NULL != guard_condition) {
     // rcl_wait() will take care of moving these backwards and setting guard_condition_count.
-    const size_t index = wait_set->size_of_guard_conditions + (wait_set->impl->timer_index - 1);
+    const size_t index = wait_set->size_of_guard_conditions + current_index;
     rmw_guard_condition_t * rmw_handle = rcl_guard_condition_get_rmw_handle(guard_condition);
     RCL_CHECK_FOR_NULL_WITH_MSG(
       rmw_handle, rcl_get_error_string().str, return RCL_RET_ERROR);
@@ -437,6 +1068,68 @@ rcl_wait_set_add_timer(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_wait_set_add_timer(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t * timer,
+  size_t * index)
+{
+  SET_ADD(timer)
+  return __wait_set_track_added_timer(wait_set, timer, current_index);
+}
+
+rcl_ret_t
+rcl_wait_set_add_timers(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t ** timers,
+  size_t number_of_timers,
+  size_t * first_index)
+{
+  SET_ADD_BULK(timer)
+  for (size_t bulk_i = 0; bulk_i < number_of_timers; ++bulk_i) {
+    RCL_CHECK_ARGUMENT_FOR_NULL(timers[bulk_i], RCL_RET_INVALID_ARGUMENT);
+    rcl_ret_t ret = __wait_set_track_added_timer(
+      wait_set, timers[bulk_i], bulk_first_index + bulk_i);
+    if (RCL_RET_OK != ret) {
+      return ret;  // The rcl error state should already be set.
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_remove_timer(
+  rcl_wait_set_t * wait_set,
+  const rcl_timer_t * timer)
+{
+  SET_REMOVE_FIND(timer)
+  SET_REMOVE_COMPACT(timer)
+  // Timer guard conditions occupy one rmw guard condition slot per timer
+  // past the real guard conditions; close the gap in that range too.
+  void ** timer_gc_slots =
+    &wait_set->impl->rmw_guard_conditions.guard_conditions[wait_set->size_of_guard_conditions];
+  memmove(
+    &timer_gc_slots[found_index], &timer_gc_slots[found_index + 1],
+    sizeof(void *) * tail_count);
+  timer_gc_slots[wait_set->impl->timer_index] = NULL;
+  // The heap entries record each timer's position in the compacted array, so
+  // rebuild the heap over the remaining timers instead of repairing indices
+  // in place.
+  rcl_timer_heap_clear(&wait_set->impl->timer_heap);
+  wait_set->impl->timer_heap_usable = true;
+  wait_set->impl->timer_clock = NULL;
+  for (size_t timer_i = 0; timer_i < wait_set->impl->timer_index; ++timer_i) {
+    if (!wait_set->timers[timer_i]) {
+      continue;
+    }
+    rcl_ret_t ret = __wait_set_track_added_timer(wait_set, wait_set->timers[timer_i], timer_i);
+    if (RCL_RET_OK != ret) {
+      return ret;  // The rcl error state should already be set.
+    }
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_wait_set_add_client(
   rcl_wait_set_t * wait_set,
@@ -448,6 +1141,111 @@ rcl_wait_set_add_client(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_wait_set_add_clients(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_t ** clients,
+  size_t number_of_clients,
+  size_t * first_index)
+{
+  SET_ADD_BULK(client)
+  SET_ADD_BULK_RMW(client, rmw_clients.clients, rmw_clients.client_count)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_remove_client(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_t * client)
+{
+  SET_REMOVE_FIND(client)
+  // Grouped clients span contiguous index ranges their group records point
+  // into; removing a member would shift a range out from under its record.
+  for (size_t group_i = 0; group_i < wait_set->impl->client_group_count; ++group_i) {
+    const rcl_wait_set_client_group_record_t * record =
+      &wait_set->impl->client_group_records[group_i];
+    if (found_index >= record->first_index && found_index < record->first_index + record->count) {
+      RCL_SET_ERROR_MSG("client was added as part of a client group");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
+  }
+  SET_REMOVE_COMPACT(client)
+  SET_REMOVE_RMW(rmw_clients.clients, rmw_clients.client_count)
+  // Group ranges past the removed slot moved down with the compaction.
+  for (size_t group_i = 0; group_i < wait_set->impl->client_group_count; ++group_i) {
+    rcl_wait_set_client_group_record_t * record =
+      &wait_set->impl->client_group_records[group_i];
+    if (record->first_index > found_index) {
+      --record->first_index;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_add_client_group(
+  rcl_wait_set_t * wait_set,
+  const rcl_client_group_t * group,
+  size_t * index)
+{
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_HOT_CHECK_FOR_VALID_WITH_MSG(
+    __wait_set_is_valid(wait_set), "wait set is invalid", RCL_RET_WAIT_SET_INVALID);
+  RCL_HOT_CHECK_ARGUMENT_FOR_NULL(group, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    group->impl, "client group is invalid", return RCL_RET_INVALID_ARGUMENT);
+  const size_t count = group->impl->client_count;
+  if (0 == count) {
+    RCL_SET_ERROR_MSG("client group is empty");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // After a wait the user arrays are pruned to the ready entities; in
+  // retained mode the snapshot still has the full contents, so restore it
+  // before appending.
+  if (wait_set->impl->retained && !wait_set->impl->needs_rebuild) {
+    __wait_set_restore_retained(wait_set);
+  }
+  if (!(wait_set->impl->client_index + count <= wait_set->size_of_clients)) {
+    RCL_SET_ERROR_MSG("clients set is full");
+    return RCL_RET_WAIT_SET_FULL;
+  }
+  const size_t first_index = wait_set->impl->client_index;
+  for (size_t member = 0; member < count; ++member) {
+    const rcl_client_t * client = group->impl->clients[member];
+    rmw_client_t * rmw_handle = rcl_client_get_rmw_handle(client);
+    if (NULL == rmw_handle) {
+      // Scrub the partially filled span so the post-wait scans cannot
+      // mistake the stale entries for ready clients.
+      while (member > 0) {
+        --member;
+        wait_set->clients[first_index + member] = NULL;
+        wait_set->impl->rmw_clients.clients[first_index + member] = NULL;
+      }
+      return RCL_RET_ERROR;  // error already set
+    }
+    wait_set->clients[first_index + member] = client;
+    wait_set->impl->rmw_clients.clients[first_index + member] = rmw_handle->data;
+  }
+  wait_set->impl->client_index += count;
+  wait_set->impl->rmw_clients.client_count += count;
+  // The retained snapshot, if any, no longer matches the set contents.
+  wait_set->impl->needs_rebuild = true;
+  rcl_wait_set_client_group_record_t * record =
+    &wait_set->impl->client_group_records[wait_set->impl->client_group_count];
+  record->group = group;
+  record->first_index = first_index;
+  record->count = count;
+  record->priority = group->impl->options.priority;
+  if (0 != record->priority) {
+    wait_set->impl->has_priorities = true;
+  }
+  if (NULL != index) {
+    *index = wait_set->impl->client_group_count;
+  }
+  ++wait_set->impl->client_group_count;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_wait_set_add_service(
   rcl_wait_set_t * wait_set,
@@ -456,34 +1254,260 @@ rcl_wait_set_add_service(
 {
   SET_ADD(service)
   SET_ADD_RMW(service, rmw_services.services, rmw_services.service_count)
+  SET_RECORD_PRIORITY(service, service, current_index)
   return RCL_RET_OK;
 }
 
 rcl_ret_t
-rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+rcl_wait_set_add_services(
+  rcl_wait_set_t * wait_set,
+  const rcl_service_t ** services,
+  size_t number_of_services,
+  size_t * first_index)
+{
+  SET_ADD_BULK(service)
+  SET_ADD_BULK_RMW(service, rmw_services.services, rmw_services.service_count)
+  SET_RECORD_PRIORITY_BULK(service)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_remove_service(
+  rcl_wait_set_t * wait_set,
+  const rcl_service_t * service)
+{
+  SET_REMOVE_FIND(service)
+  SET_REMOVE_COMPACT(service)
+  SET_REMOVE_RMW(rmw_services.services, rmw_services.service_count)
+  SET_REMOVE_PRIORITY(service)
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_set_retained(rcl_wait_set_t * wait_set, bool retained)
 {
   RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
   if (!__wait_set_is_valid(wait_set)) {
     RCL_SET_ERROR_MSG("wait set is invalid");
     return RCL_RET_WAIT_SET_INVALID;
   }
-  if (
-    wait_set->size_of_subscriptions == 0 &&
-    wait_set->size_of_guard_conditions == 0 &&
-    wait_set->size_of_timers == 0 &&
-    wait_set->size_of_clients == 0 &&
-    wait_set->size_of_services == 0)
-  {
-    RCL_SET_ERROR_MSG("wait set is empty");
-    return RCL_RET_WAIT_SET_EMPTY;
+  if (retained && !wait_set->impl->retained) {
+    // Force a snapshot of the current contents on the next rcl_wait().
+    wait_set->impl->needs_rebuild = true;
   }
-  // Calculate the timeout argument.
-  // By default, set the timer to block indefinitely if none of the below conditions are met.
-  rmw_time_t * timeout_argument = NULL;
-  rmw_time_t temporary_timeout_storage;
+  wait_set->impl->retained = retained;
+  return RCL_RET_OK;
+}
 
-  bool is_timer_timeout = false;
-  int64_t min_timeout = timeout > 0 ? timeout : INT64_MAX;
+/* Capture the current contents of the wait set so that subsequent waits can
+ * restore them without the caller re-adding every entity.
+ */
+static rcl_ret_t
+__wait_set_snapshot_retained(rcl_wait_set_t * wait_set)
+{
+  rcl_allocator_t allocator = wait_set->impl->allocator;
+#define RETAINED_SNAPSHOT(Type) \
+  do { \
+    if (wait_set->size_of_ ## Type ## s > 0u) { \
+      wait_set->impl->retained_ ## Type ## s = \
+        (const rcl_ ## Type ## _t **)allocator.reallocate( \
+        (void *)wait_set->impl->retained_ ## Type ## s, \
+        sizeof(rcl_ ## Type ## _t *) * wait_set->size_of_ ## Type ## s, allocator.state); \
+      RCL_CHECK_FOR_NULL_WITH_MSG( \
+        wait_set->impl->retained_ ## Type ## s, "allocating memory failed", \
+        return RCL_RET_BAD_ALLOC); \
+      memcpy( \
+        (void *)wait_set->impl->retained_ ## Type ## s, (void *)wait_set->Type ## s, \
+        sizeof(rcl_ ## Type ## _t *) * wait_set->size_of_ ## Type ## s); \
+    } \
+    wait_set->impl->retained_ ## Type ## _index = wait_set->impl->Type ## _index; \
+  } while (false)
+  RETAINED_SNAPSHOT(subscription);
+  RETAINED_SNAPSHOT(guard_condition);
+  RETAINED_SNAPSHOT(timer);
+  RETAINED_SNAPSHOT(client);
+  RETAINED_SNAPSHOT(service);
+#undef RETAINED_SNAPSHOT
+#define RETAINED_SNAPSHOT_RMW(Member, RMWStorage, RMWCount, Size) \
+  do { \
+    if ((Size) > 0u) { \
+      wait_set->impl->retained_rmw_ ## Member = (void **)allocator.reallocate( \
+        (void *)wait_set->impl->retained_rmw_ ## Member, \
+        sizeof(void *) * (Size), allocator.state); \
+      RCL_CHECK_FOR_NULL_WITH_MSG( \
+        wait_set->impl->retained_rmw_ ## Member, "allocating memory failed", \
+        return RCL_RET_BAD_ALLOC); \
+      memcpy( \
+        wait_set->impl->retained_rmw_ ## Member, wait_set->impl->RMWStorage, \
+        sizeof(void *) * (Size)); \
+    } \
+    wait_set->impl->retained_rmw_ ## Member ## _count = wait_set->impl->RMWCount; \
+  } while (false)
+  RETAINED_SNAPSHOT_RMW(
+    subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count,
+    wait_set->size_of_subscriptions);
+  // The rmw guard condition array also holds one slot per timer.
+  RETAINED_SNAPSHOT_RMW(
+    guard_condition, rmw_guard_conditions.guard_conditions,
+    rmw_guard_conditions.guard_condition_count,
+    wait_set->size_of_guard_conditions + wait_set->size_of_timers);
+  RETAINED_SNAPSHOT_RMW(
+    client, rmw_clients.clients, rmw_clients.client_count, wait_set->size_of_clients);
+  RETAINED_SNAPSHOT_RMW(
+    service, rmw_services.services, rmw_services.service_count, wait_set->size_of_services);
+#undef RETAINED_SNAPSHOT_RMW
+  wait_set->impl->needs_rebuild = false;
+  return RCL_RET_OK;
+}
+
+/* Restore the wait set contents from the retained snapshot, undoing the
+ * pruning done by rmw_wait() and the post-wait fixup loops.
+ */
+static void
+__wait_set_restore_retained(rcl_wait_set_t * wait_set)
+{
+#define RETAINED_RESTORE(Type) \
+  do { \
+    if (wait_set->impl->retained_ ## Type ## s) { \
+      memcpy( \
+        (void *)wait_set->Type ## s, (void *)wait_set->impl->retained_ ## Type ## s, \
+        sizeof(rcl_ ## Type ## _t *) * wait_set->size_of_ ## Type ## s); \
+    } \
+    wait_set->impl->Type ## _index = wait_set->impl->retained_ ## Type ## _index; \
+  } while (false)
+  RETAINED_RESTORE(subscription);
+  RETAINED_RESTORE(guard_condition);
+  RETAINED_RESTORE(timer);
+  RETAINED_RESTORE(client);
+  RETAINED_RESTORE(service);
+#undef RETAINED_RESTORE
+#define RETAINED_RESTORE_RMW(Member, RMWStorage, RMWCount, Size) \
+  do { \
+    if (wait_set->impl->retained_rmw_ ## Member) { \
+      memcpy( \
+        wait_set->impl->RMWStorage, wait_set->impl->retained_rmw_ ## Member, \
+        sizeof(void *) * (Size)); \
+    } \
+    wait_set->impl->RMWCount = wait_set->impl->retained_rmw_ ## Member ## _count; \
+  } while (false)
+  RETAINED_RESTORE_RMW(
+    subscription, rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count,
+    wait_set->size_of_subscriptions);
+  RETAINED_RESTORE_RMW(
+    guard_condition, rmw_guard_conditions.guard_conditions,
+    rmw_guard_conditions.guard_condition_count,
+    wait_set->size_of_guard_conditions + wait_set->size_of_timers);
+  RETAINED_RESTORE_RMW(
+    client, rmw_clients.clients, rmw_clients.client_count, wait_set->size_of_clients);
+  RETAINED_RESTORE_RMW(
+    service, rmw_services.services, rmw_services.service_count, wait_set->size_of_services);
+#undef RETAINED_RESTORE_RMW
+}
+
+/* Pre-wait half of one wait set's processing: restore or snapshot the
+ * retained contents, account the shrink policy, reset the ready entity list,
+ * move timer guard conditions into the waitable range, and fold the set's
+ * earliest timer and event deadlines into the caller's timeout accumulators.
+ * Factored out of __rcl_wait() so a composite wait can run it once per
+ * attached child as well as for the parent itself.
+ */
+static rcl_ret_t
+__wait_set_prepare(
+  rcl_wait_set_t * wait_set,
+  int64_t * min_timeout_arg,
+  bool * is_timer_timeout_arg,
+  bool * needs_finite_timeout)
+{
+  int64_t min_timeout = *min_timeout_arg;
+  bool is_timer_timeout = *is_timer_timeout_arg;
+  // Invalidate the ready entity list from any previous wait.
+  wait_set->impl->ready_entity_count = 0;
+  if (wait_set->impl->retained) {
+    if (wait_set->impl->needs_rebuild) {
+      rcl_ret_t snapshot_ret = __wait_set_snapshot_retained(wait_set);
+      if (RCL_RET_OK != snapshot_ret) {
+        return snapshot_ret;  // The rcl error state should already be set.
+      }
+    } else {
+      __wait_set_restore_retained(wait_set);
+    }
+  }
+  // High-watermark shrink policy bookkeeping: count consecutive waits whose
+  // occupancy stays below the configured percentage of the total capacity,
+  // and remember the per kind peaks of the streak.  The shrink itself is
+  // applied by rcl_wait_set_clear().
+  if (wait_set->impl->shrink_occupancy_percent > 0) {
+    rcl_wait_set_impl_t * impl = wait_set->impl;
+    size_t guard_condition_occupancy = impl->guard_condition_index;
+    if (impl->event_record_count > guard_condition_occupancy) {
+      guard_condition_occupancy = impl->event_record_count;
+    }
+    const size_t occupancy = impl->subscription_index + guard_condition_occupancy +
+      impl->timer_index + impl->client_index + impl->service_index;
+    const size_t capacity = wait_set->size_of_subscriptions +
+      wait_set->size_of_guard_conditions + wait_set->size_of_timers +
+      wait_set->size_of_clients + wait_set->size_of_services;
+    if (100 * occupancy < (size_t)impl->shrink_occupancy_percent * capacity) {
+      ++impl->shrink_low_streak;
+#define SHRINK_STREAK_PEAK(Member, Occupancy) \
+  if ((Occupancy) > impl->Member) { \
+    impl->Member = (Occupancy); \
+  }
+      SHRINK_STREAK_PEAK(shrink_streak_subscriptions, impl->subscription_index)
+      SHRINK_STREAK_PEAK(shrink_streak_guard_conditions, guard_condition_occupancy)
+      SHRINK_STREAK_PEAK(shrink_streak_timers, impl->timer_index)
+      SHRINK_STREAK_PEAK(shrink_streak_clients, impl->client_index)
+      SHRINK_STREAK_PEAK(shrink_streak_services, impl->service_index)
+#undef SHRINK_STREAK_PEAK
+    } else {
+      __wait_set_reset_shrink_streak(impl);
+    }
+  }
+  // Consult the timer heap for the earliest deadline when possible, so the
+  // scan below does not need to read the clock for every timer.
+  bool use_timer_heap =
+    wait_set->impl->timer_heap_usable &&
+    wait_set->impl->timer_heap.size > 0 &&
+    wait_set->impl->timer_heap.size == wait_set->impl->timer_index;
+  int64_t heap_timer_timeout = INT64_MAX;
+  if (use_timer_heap) {
+    rcl_timer_heap_t * heap = &wait_set->impl->timer_heap;
+    rcl_timer_heap_entry_t * top = rcl_timer_heap_peek(heap);
+    while (NULL != top) {
+      uint64_t generation =
+        rcutils_atomic_load_uint64_t(&top->timer->impl->modification_count);
+      if (generation != top->generation) {
+        // The timer was called, canceled, reset, or its period exchanged
+        // since the deadline was recorded.
+        bool is_canceled = false;
+        rcl_ret_t ret = rcl_timer_is_canceled(top->timer, &is_canceled);
+        if (ret != RCL_RET_OK) {
+          return ret;  // The rcl error state should already be set.
+        }
+        if (is_canceled) {
+          // Canceled timers make the recorded deadlines unreliable; fall back
+          // to the linear scan until the wait set contents are rebuilt.
+          wait_set->impl->timer_heap_usable = false;
+          use_timer_heap = false;
+          break;
+        }
+        int64_t fresh_deadline = 0;
+        ret = rcl_timer_get_next_call_time(top->timer, &fresh_deadline);
+        if (ret != RCL_RET_OK) {
+          return ret;  // The rcl error state should already be set.
+        }
+        // Repair the heap and look at the new minimum.
+        rcl_timer_heap_update(heap, 0, fresh_deadline, generation);
+        top = rcl_timer_heap_peek(heap);
+        continue;
+      }
+      rcl_ret_t ret = rcl_timer_get_time_until_next_call(top->timer, &heap_timer_timeout);
+      if (ret != RCL_RET_OK) {
+        return ret;  // The rcl error state should already be set.
+      }
+      break;
+    }
+  }
   // calculate the number of valid (non-NULL and non-canceled) timers
   size_t number_of_valid_timers = wait_set->size_of_timers;
   {  // scope to prevent i from colliding below
@@ -505,13 +1529,28 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
       }
       rmw_guard_conditions_t * rmw_gcs = &(wait_set->impl->rmw_guard_conditions);
       size_t gc_idx = wait_set->size_of_guard_conditions + i;
+      bool wakes_via_guard_condition = false;
       if (NULL != rmw_gcs->guard_conditions[gc_idx]) {
         // This timer has a guard condition, so move it to make a legal wait set.
         rmw_gcs->guard_conditions[rmw_gcs->guard_condition_count] =
           rmw_gcs->guard_conditions[gc_idx];
         ++(rmw_gcs->guard_condition_count);
-      } else {
-        // No guard condition, instead use to set the rmw_wait timeout
+        // Only ROS time timers have a guard condition.  While the override
+        // drives the clock, the deadline can only be crossed by an override
+        // advancing, and the timer's jump callback wakes this wait through
+        // the guard condition, so no timeout polling is needed.  With the
+        // override inactive the clock follows system time and no jump will
+        // fire, so fall back to the timeout below.
+        bool override_enabled = false;
+        rcl_ret_t override_ret = rcl_is_enabled_ros_time_override(
+          wait_set->timers[i]->impl->clock, &override_enabled);
+        if (RCL_RET_OK != override_ret) {
+          return override_ret;  // The rcl error state should already be set.
+        }
+        wakes_via_guard_condition = override_enabled;
+      }
+      if (!wakes_via_guard_condition && !use_timer_heap) {
+        // No guard condition wakeup, instead use to set the rmw_wait timeout
         int64_t timer_timeout = INT64_MAX;
         rcl_ret_t ret = rcl_timer_get_time_until_next_call(wait_set->timers[i], &timer_timeout);
         if (ret != RCL_RET_OK) {
@@ -524,13 +1563,247 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
       }
     }
   }
+  if (use_timer_heap && number_of_valid_timers > 0 && heap_timer_timeout < min_timeout) {
+    is_timer_timeout = true;
+    min_timeout = heap_timer_timeout;
+  }
+  // Wake no later than the earliest event deadline, so a missed deadline is
+  // detected when it happens rather than on the next unrelated wake.
+  if (wait_set->impl->event_record_count > 0) {
+    rcl_time_point_value_t event_now = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&event_now)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    for (size_t event_i = 0; event_i < wait_set->impl->event_record_count; ++event_i) {
+      int64_t until_deadline = rcl_event_time_until_deadline(
+        wait_set->impl->event_records[event_i].event, event_now);
+      if (until_deadline < min_timeout) {
+        is_timer_timeout = true;
+        min_timeout = until_deadline;
+      }
+    }
+  }
+  if (number_of_valid_timers > 0 || wait_set->impl->event_record_count > 0) {
+    *needs_finite_timeout = true;
+  }
+  *min_timeout_arg = min_timeout;
+  *is_timer_timeout_arg = is_timer_timeout;
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+__wait_set_process(rcl_wait_set_t * wait_set, bool * is_timer_timeout);
+
+/* A local guard condition triggered before this thread registered as a
+ * waiter would not have interrupted rmw_wait; report any pending flag so the
+ * wait degrades to a poll, see __rcl_wait().
+ */
+static bool
+__wait_set_local_trigger_pending(const rcl_wait_set_t * wait_set)
+{
+  for (size_t gc_i = 0; gc_i < wait_set->impl->guard_condition_index; ++gc_i) {
+    const rcl_guard_condition_t * guard_condition = wait_set->guard_conditions[gc_i];
+    if (NULL != guard_condition && guard_condition->impl->options.local &&
+      rcutils_atomic_load_bool(&guard_condition->impl->local_triggered))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Wait on the union of the wait set and its attached children: gather every
+ * member's rmw handle arrays into the composite scratch block, hand the union
+ * to rmw_wait through a dedicated rmw wait set sized for all members, and
+ * scatter the results back into each member's own arrays so the per set
+ * post-wait processing sees them in place.
+ */
+static rcl_ret_t
+__wait_set_composite_wait(
+  rcl_wait_set_t * wait_set, rmw_time_t * timeout_argument, rmw_ret_t * rmw_ret)
+{
+  rcl_wait_set_impl_t * impl = wait_set->impl;
+  rcl_allocator_t allocator = impl->allocator;
+  size_t total_subscriptions = impl->rmw_subscriptions.subscriber_count;
+  size_t total_guard_conditions = impl->rmw_guard_conditions.guard_condition_count;
+  size_t total_clients = impl->rmw_clients.client_count;
+  size_t total_services = impl->rmw_services.service_count;
+  for (size_t child_i = 0; child_i < impl->child_count; ++child_i) {
+    const rcl_wait_set_impl_t * child_impl = impl->children[child_i]->impl;
+    total_subscriptions += child_impl->rmw_subscriptions.subscriber_count;
+    total_guard_conditions += child_impl->rmw_guard_conditions.guard_condition_count;
+    total_clients += child_impl->rmw_clients.client_count;
+    total_services += child_impl->rmw_services.service_count;
+  }
+  const size_t total_handles =
+    total_subscriptions + total_guard_conditions + total_clients + total_services;
+  if (total_handles > impl->composite_handle_capacity) {
+    void ** handles = (void **)allocator.reallocate(
+      (void *)impl->composite_handles, sizeof(void *) * total_handles, allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(handles, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+    impl->composite_handles = handles;
+    impl->composite_handle_capacity = total_handles;
+  }
+  // Size the dedicated rmw wait set the same way rcl_wait_set_init() does,
+  // recreating it only when the union has outgrown it.
+  const size_t rmw_capacity =
+    2 * total_subscriptions + total_guard_conditions + total_clients + total_services;
+  if (NULL == impl->composite_rmw_wait_set || rmw_capacity > impl->composite_rmw_capacity) {
+    if (NULL != impl->composite_rmw_wait_set) {
+      if (RMW_RET_OK != rmw_destroy_wait_set(impl->composite_rmw_wait_set)) {
+        RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+        impl->composite_rmw_wait_set = NULL;
+        impl->composite_rmw_capacity = 0;
+        return RCL_RET_ERROR;
+      }
+      impl->composite_rmw_wait_set = NULL;
+      impl->composite_rmw_capacity = 0;
+    }
+    impl->composite_rmw_wait_set = rmw_create_wait_set(rmw_capacity);
+    if (NULL == impl->composite_rmw_wait_set) {
+      RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    impl->composite_rmw_capacity = rmw_capacity;
+  }
+  // Gather the members' slices into the union, parent first and children in
+  // attachment order, so the scatter below can walk the same layout.
+  void ** cursor = impl->composite_handles;
+#define COMPOSITE_FOR_EACH_MEMBER(Action) \
+  do { \
+    rcl_wait_set_impl_t * member_impl = impl; \
+    Action \
+    for (size_t member_i = 0; member_i < impl->child_count; ++member_i) { \
+      member_impl = impl->children[member_i]->impl; \
+      Action \
+    } \
+  } while (false)
+#define COMPOSITE_GATHER(RMWStorage, RMWCount) \
+  COMPOSITE_FOR_EACH_MEMBER( \
+    if (member_impl->RMWCount > 0) { \
+      memcpy(cursor, member_impl->RMWStorage, sizeof(void *) * member_impl->RMWCount); \
+    } \
+    cursor += member_impl->RMWCount;)
+#define COMPOSITE_SCATTER(RMWStorage, RMWCount) \
+  COMPOSITE_FOR_EACH_MEMBER( \
+    if (member_impl->RMWCount > 0) { \
+      memcpy(member_impl->RMWStorage, cursor, sizeof(void *) * member_impl->RMWCount); \
+    } \
+    cursor += member_impl->RMWCount;)
+  rmw_subscriptions_t union_subscriptions;
+  union_subscriptions.subscribers = cursor;
+  union_subscriptions.subscriber_count = total_subscriptions;
+  COMPOSITE_GATHER(rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count);
+  rmw_guard_conditions_t union_guard_conditions;
+  union_guard_conditions.guard_conditions = cursor;
+  union_guard_conditions.guard_condition_count = total_guard_conditions;
+  COMPOSITE_GATHER(
+    rmw_guard_conditions.guard_conditions, rmw_guard_conditions.guard_condition_count);
+  rmw_clients_t union_clients;
+  union_clients.clients = cursor;
+  union_clients.client_count = total_clients;
+  COMPOSITE_GATHER(rmw_clients.clients, rmw_clients.client_count);
+  rmw_services_t union_services;
+  union_services.services = cursor;
+  union_services.service_count = total_services;
+  COMPOSITE_GATHER(rmw_services.services, rmw_services.service_count);
+
+  *rmw_ret = rmw_wait(
+    &union_subscriptions,
+    &union_guard_conditions,
+    &union_services,
+    &union_clients,
+    impl->composite_rmw_wait_set,
+    timeout_argument);
+
+  // Entries pruned by rmw_wait propagate back to their owning member.
+  cursor = impl->composite_handles;
+  COMPOSITE_SCATTER(rmw_subscriptions.subscribers, rmw_subscriptions.subscriber_count);
+  COMPOSITE_SCATTER(
+    rmw_guard_conditions.guard_conditions, rmw_guard_conditions.guard_condition_count);
+  COMPOSITE_SCATTER(rmw_clients.clients, rmw_clients.client_count);
+  COMPOSITE_SCATTER(rmw_services.services, rmw_services.service_count);
+#undef COMPOSITE_SCATTER
+#undef COMPOSITE_GATHER
+#undef COMPOSITE_FOR_EACH_MEMBER
+  return RCL_RET_OK;
+}
+
+static rcl_ret_t
+__rcl_wait(
+  rcl_wait_set_t * wait_set,
+  int64_t timeout,
+  rcl_clock_t * deadline_clock,
+  rcl_time_point_value_t deadline)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  const size_t child_count = wait_set->impl->child_count;
+  size_t number_of_entities = wait_set->size_of_subscriptions +
+    wait_set->size_of_guard_conditions + wait_set->size_of_timers +
+    wait_set->size_of_clients + wait_set->size_of_services +
+    wait_set->impl->event_record_count;
+  for (size_t child_i = 0; child_i < child_count; ++child_i) {
+    rcl_wait_set_t * child = wait_set->impl->children[child_i];
+    if (!__wait_set_is_valid(child)) {
+      RCL_SET_ERROR_MSG("attached wait set is invalid");
+      return RCL_RET_WAIT_SET_INVALID;
+    }
+    number_of_entities += child->size_of_subscriptions +
+      child->size_of_guard_conditions + child->size_of_timers +
+      child->size_of_clients + child->size_of_services +
+      child->impl->event_record_count;
+  }
+  if (0 == number_of_entities) {
+    RCL_SET_ERROR_MSG("wait set is empty");
+    return RCL_RET_WAIT_SET_EMPTY;
+  }
+  // Calculate the timeout argument.
+  // By default, set the timer to block indefinitely if none of the below conditions are met.
+  rmw_time_t * timeout_argument = NULL;
+  rmw_time_t temporary_timeout_storage;
+
+  bool is_timer_timeout = false;
+  int64_t min_timeout = timeout > 0 ? timeout : INT64_MAX;
+  bool needs_finite_timeout = false;
+  rcl_ret_t prepare_ret = __wait_set_prepare(
+    wait_set, &min_timeout, &is_timer_timeout, &needs_finite_timeout);
+  if (RCL_RET_OK != prepare_ret) {
+    return prepare_ret;  // The rcl error state should already be set.
+  }
+  for (size_t child_i = 0; child_i < child_count; ++child_i) {
+    prepare_ret = __wait_set_prepare(
+      wait_set->impl->children[child_i], &min_timeout, &is_timer_timeout,
+      &needs_finite_timeout);
+    if (RCL_RET_OK != prepare_ret) {
+      return prepare_ret;  // The rcl error state should already be set.
+    }
+  }
+  if (NULL != deadline_clock) {
+    // Convert the absolute deadline to a relative timeout as late as
+    // possible, so that time spent above does not drift the wake up time.
+    rcl_time_point_value_t now;
+    rcl_ret_t deadline_ret = rcl_clock_get_now_fast(deadline_clock, &now);
+    if (RCL_RET_OK != deadline_ret) {
+      return deadline_ret;  // The rcl error state should already be set.
+    }
+    int64_t until_deadline = deadline > now ? deadline - now : 0;
+    if (until_deadline < min_timeout) {
+      is_timer_timeout = false;
+      min_timeout = until_deadline;
+    }
+  }
 
   if (timeout == 0) {
     // Then it is non-blocking, so set the temporary storage to 0, 0 and pass it.
     temporary_timeout_storage.sec = 0;
     temporary_timeout_storage.nsec = 0;
     timeout_argument = &temporary_timeout_storage;
-  } else if (timeout > 0 || number_of_valid_timers > 0) {
+  } else if (timeout > 0 || needs_finite_timeout || NULL != deadline_clock) {
     // If min_timeout was negative, we need to wake up immediately.
     if (min_timeout < 0) {
       min_timeout = 0;
@@ -549,40 +1822,153 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     ROS_PACKAGE_NAME, "Timeout calculated based on next scheduled timer: %s",
     is_timer_timeout ? "true" : "false");
 
+  // Local guard conditions are triggered purely in-process, so a flag set
+  // before this point would not interrupt rmw_wait.  Register this thread as
+  // a waiter first, then check the flags once more: a trigger arriving after
+  // the check sees the registration and interrupts the wait through the
+  // shared wakeup guard condition.
+  rcl_guard_condition_waiter_enter();
+  bool local_trigger_pending = __wait_set_local_trigger_pending(wait_set);
+  for (size_t child_i = 0; !local_trigger_pending && child_i < child_count; ++child_i) {
+    local_trigger_pending =
+      __wait_set_local_trigger_pending(wait_set->impl->children[child_i]);
+  }
+  if (local_trigger_pending) {
+    // Do not block; the flag is consumed after the wait.
+    temporary_timeout_storage.sec = 0;
+    temporary_timeout_storage.nsec = 0;
+    timeout_argument = &temporary_timeout_storage;
+    is_timer_timeout = true;
+  }
+
   // Wait.
-  rmw_ret_t ret = rmw_wait(
-    &wait_set->impl->rmw_subscriptions,
-    &wait_set->impl->rmw_guard_conditions,
-    &wait_set->impl->rmw_services,
-    &wait_set->impl->rmw_clients,
-    wait_set->impl->rmw_wait_set,
-    timeout_argument);
+  RCL_TRACEPOINT("rcl_wait_begin", wait_set);
+  rmw_ret_t ret;
+  if (child_count > 0) {
+    rcl_ret_t composite_ret = __wait_set_composite_wait(wait_set, timeout_argument, &ret);
+    if (RCL_RET_OK != composite_ret) {
+      rcl_guard_condition_waiter_exit();
+      return composite_ret;  // The rcl error state should already be set.
+    }
+  } else {
+    ret = rmw_wait(
+      &wait_set->impl->rmw_subscriptions,
+      &wait_set->impl->rmw_guard_conditions,
+      &wait_set->impl->rmw_services,
+      &wait_set->impl->rmw_clients,
+      wait_set->impl->rmw_wait_set,
+      timeout_argument);
+  }
+  rcl_guard_condition_waiter_exit();
+  RCL_TRACEPOINT("rcl_wait_rmw_done", wait_set);
+
+  if (ret != RMW_RET_OK && ret != RMW_RET_TIMEOUT) {
+    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
+    return RCL_RET_ERROR;
+  }
+
+  // Translate the rmw results into per entity readiness, for this wait set
+  // and then for every attached child, so readiness is reported per member.
+  rcl_ret_t process_ret = __wait_set_process(wait_set, &is_timer_timeout);
+  if (RCL_RET_OK != process_ret) {
+    return process_ret;  // The rcl error state should already be set.
+  }
+  for (size_t child_i = 0; child_i < child_count; ++child_i) {
+    process_ret = __wait_set_process(wait_set->impl->children[child_i], &is_timer_timeout);
+    if (RCL_RET_OK != process_ret) {
+      return process_ret;  // The rcl error state should already be set.
+    }
+  }
 
+  RCL_TRACEPOINT("rcl_wait_end", wait_set);
+  if (RMW_RET_TIMEOUT == ret && !is_timer_timeout) {
+    return RCL_RET_TIMEOUT;
+  }
+  return RCL_RET_OK;
+}
+
+/* Post-wait half of one wait set's processing: translate what rmw_wait left
+ * in the rmw arrays into per entity readiness, nulling entries that are not
+ * ready and building the ready entity list.
+ */
+static rcl_ret_t
+__wait_set_process(rcl_wait_set_t * wait_set, bool * is_timer_timeout_arg)
+{
+  bool is_timer_timeout = *is_timer_timeout_arg;
   // Items that are not ready will have been set to NULL by rmw_wait.
   // We now update our handles accordingly.
 
   // Check for ready timers
   // and set not ready timers (which includes canceled timers) to NULL.
+  // Matches the heap usability decision made before the wait: the paths that
+  // clear use_timer_heap there also clear timer_heap_usable.
+  bool use_timer_heap =
+    wait_set->impl->timer_heap_usable &&
+    wait_set->impl->timer_heap.size > 0 &&
+    wait_set->impl->timer_heap.size == wait_set->impl->timer_index;
   size_t i;
-  for (i = 0; i < wait_set->impl->timer_index; ++i) {
-    if (!wait_set->timers[i]) {
-      continue;
+  if (use_timer_heap) {
+    // Only timers whose recorded deadline has passed can be ready, so a
+    // single clock read replaces querying every timer.
+    rcl_timer_heap_t * heap = &wait_set->impl->timer_heap;
+    rcl_time_point_value_t now = 0;
+    rcl_ret_t now_ret = rcl_clock_get_now_fast(wait_set->impl->timer_clock, &now);
+    if (now_ret != RCL_RET_OK) {
+      return now_ret;  // The rcl error state should already be set.
     }
-    bool is_ready = false;
-    rcl_ret_t ret = rcl_timer_is_ready(wait_set->timers[i], &is_ready);
-    if (ret != RCL_RET_OK) {
-      return ret;  // The rcl error state should already be set.
+    memset(
+      (void *)wait_set->timers, 0, sizeof(rcl_timer_t *) * wait_set->impl->timer_index);
+    i = 0;
+    while (i < heap->size) {
+      if (heap->entries[i].deadline > now) {
+        ++i;
+        continue;
+      }
+      bool is_ready = false;
+      rcl_ret_t timer_ret = rcl_timer_is_ready(heap->entries[i].timer, &is_ready);
+      if (timer_ret != RCL_RET_OK) {
+        return timer_ret;  // The rcl error state should already be set.
+      }
+      RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Timer in wait set is ready");
+      if (is_ready) {
+        wait_set->timers[heap->entries[i].index] = heap->entries[i].timer;
+        READY_ENTITY_APPEND(RCL_WAIT_SET_TIMER, heap->entries[i].index, 0);
+        ++i;
+        continue;
+      }
+      uint64_t generation =
+        rcutils_atomic_load_uint64_t(&heap->entries[i].timer->impl->modification_count);
+      if (generation != heap->entries[i].generation) {
+        int64_t fresh_deadline = 0;
+        timer_ret = rcl_timer_get_next_call_time(heap->entries[i].timer, &fresh_deadline);
+        if (timer_ret != RCL_RET_OK) {
+          return timer_ret;  // The rcl error state should already be set.
+        }
+        // Repairing may pull an unvisited entry up to this position, so do
+        // not advance; sifting only touches positions below i.
+        rcl_timer_heap_update(heap, i, fresh_deadline, generation);
+      } else {
+        ++i;
+      }
     }
-    RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Timer in wait set is ready");
-    if (!is_ready) {
-      wait_set->timers[i] = NULL;
+  } else {
+    for (i = 0; i < wait_set->impl->timer_index; ++i) {
+      if (!wait_set->timers[i]) {
+        continue;
+      }
+      bool is_ready = false;
+      rcl_ret_t ret = rcl_timer_is_ready(wait_set->timers[i], &is_ready);
+      if (ret != RCL_RET_OK) {
+        return ret;  // The rcl error state should already be set.
+      }
+      RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Timer in wait set is ready");
+      if (!is_ready) {
+        wait_set->timers[i] = NULL;
+      } else {
+        READY_ENTITY_APPEND(RCL_WAIT_SET_TIMER, i, 0);
+      }
     }
   }
-  // Check for timeout, return RCL_RET_TIMEOUT only if it wasn't a timer.
-  if (ret != RMW_RET_OK && ret != RMW_RET_TIMEOUT) {
-    RCL_SET_ERROR_MSG(rmw_get_error_string().str);
-    return RCL_RET_ERROR;
-  }
   // Set corresponding rcl subscription handles NULL.
   for (i = 0; i < wait_set->size_of_subscriptions; ++i) {
     bool is_ready = wait_set->impl->rmw_subscriptions.subscribers[i] != NULL;
@@ -590,15 +1976,56 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
       is_ready, ROS_PACKAGE_NAME, "Subscription in wait set is ready");
     if (!is_ready) {
       wait_set->subscriptions[i] = NULL;
+    } else {
+      READY_ENTITY_APPEND(
+        RCL_WAIT_SET_SUBSCRIPTION, i, wait_set->impl->subscription_priorities[i]);
+      rcl_subscription_dispatch_on_new_message(wait_set->subscriptions[i]);
     }
   }
   // Set corresponding rcl guard_condition handles NULL.
   for (i = 0; i < wait_set->size_of_guard_conditions; ++i) {
+    const rcl_guard_condition_t * guard_condition = wait_set->guard_conditions[i];
     bool is_ready = wait_set->impl->rmw_guard_conditions.guard_conditions[i] != NULL;
+    if (NULL != guard_condition && guard_condition->impl->options.local) {
+      // The shared rmw slot only says that some local guard condition in the
+      // process fired; the per guard condition flag is authoritative, and
+      // consuming it here re-arms the trigger fast path.
+      bool was_triggered = false;
+      rcutils_atomic_exchange(&guard_condition->impl->local_triggered, was_triggered, false);
+      is_ready = was_triggered;
+      if (is_ready) {
+        // The wake may have come from the timeout math, not from rmw.
+        is_timer_timeout = true;
+      }
+    }
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(
       is_ready, ROS_PACKAGE_NAME, "Guard condition in wait set is ready");
     if (!is_ready) {
       wait_set->guard_conditions[i] = NULL;
+    } else {
+      READY_ENTITY_APPEND(RCL_WAIT_SET_GUARD_CONDITION, i, 0);
+    }
+  }
+  // Demultiplex grouped clients: record each group's ready members inside
+  // the group and report the whole group as a single ready entity.  Consuming
+  // the spans here keeps grouped clients out of the per-client scan below.
+  for (i = 0; i < wait_set->impl->client_group_count; ++i) {
+    rcl_wait_set_client_group_record_t * record = &wait_set->impl->client_group_records[i];
+    rcl_client_group_impl_t * group_impl = record->group->impl;
+    group_impl->ready_count = 0;
+    for (size_t member = 0; member < record->count; ++member) {
+      const size_t slot = record->first_index + member;
+      if (NULL != wait_set->impl->rmw_clients.clients[slot]) {
+        group_impl->ready_clients[group_impl->ready_count++] = wait_set->clients[slot];
+        rcl_client_dispatch_on_new_response(wait_set->clients[slot]);
+        wait_set->impl->rmw_clients.clients[slot] = NULL;
+      }
+      wait_set->clients[slot] = NULL;
+    }
+    RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(
+      group_impl->ready_count > 0, ROS_PACKAGE_NAME, "Client group in wait set is ready");
+    if (group_impl->ready_count > 0) {
+      READY_ENTITY_APPEND(RCL_WAIT_SET_CLIENT_GROUP, i, record->priority);
     }
   }
   // Set corresponding rcl client handles NULL.
@@ -607,6 +2034,9 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Client in wait set is ready");
     if (!is_ready) {
       wait_set->clients[i] = NULL;
+    } else {
+      READY_ENTITY_APPEND(RCL_WAIT_SET_CLIENT, i, 0);
+      rcl_client_dispatch_on_new_response(wait_set->clients[i]);
     }
   }
   // Set corresponding rcl service handles NULL.
@@ -615,12 +2045,121 @@ rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
     RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Service in wait set is ready");
     if (!is_ready) {
       wait_set->services[i] = NULL;
+    } else {
+      READY_ENTITY_APPEND(RCL_WAIT_SET_SERVICE, i, wait_set->impl->service_priorities[i]);
+      rcl_service_dispatch_on_new_request(wait_set->services[i]);
     }
   }
 
-  if (RMW_RET_TIMEOUT == ret && !is_timer_timeout) {
-    return RCL_RET_TIMEOUT;
+  // Check the deadline events against the clock; no rmw involvement.
+  if (wait_set->impl->event_record_count > 0) {
+    rcl_time_point_value_t event_now = 0;
+    if (RCUTILS_RET_OK != rcutils_steady_time_now(&event_now)) {
+      RCL_SET_ERROR_MSG(rcutils_get_error_string().str);
+      return RCL_RET_ERROR;
+    }
+    for (i = 0; i < wait_set->impl->event_record_count; ++i) {
+      const rcl_wait_set_event_record_t * record = &wait_set->impl->event_records[i];
+      bool is_ready = rcl_event_time_until_deadline(record->event, event_now) <= 0;
+      RCUTILS_LOG_DEBUG_EXPRESSION_NAMED(is_ready, ROS_PACKAGE_NAME, "Event in wait set is ready");
+      if (is_ready) {
+        READY_ENTITY_APPEND(RCL_WAIT_SET_EVENT, i, record->priority);
+      }
+    }
+  }
+
+  // Order the ready entity list by descending priority, so dispatching it
+  // front to back serves urgent entities first.  A stable counting pass
+  // through the scratch list keeps equal priorities in discovery order;
+  // wait sets which never saw a non-zero priority skip this entirely.
+  if (wait_set->impl->has_priorities && wait_set->impl->ready_entity_count > 1) {
+    size_t counts[UINT8_MAX + 1] = {0};
+    const size_t ready_count = wait_set->impl->ready_entity_count;
+    rcl_ready_entity_t * entities = wait_set->impl->ready_entities;
+    rcl_ready_entity_t * scratch = wait_set->impl->ready_entity_scratch;
+    for (i = 0; i < ready_count; ++i) {
+      ++counts[entities[i].priority];
+    }
+    // Running the prefix sums from the highest priority down places the
+    // highest bucket at the front of the list.
+    size_t offset = 0;
+    for (size_t priority = UINT8_MAX + 1; priority > 0; --priority) {
+      size_t bucket_size = counts[priority - 1];
+      counts[priority - 1] = offset;
+      offset += bucket_size;
+    }
+    for (i = 0; i < ready_count; ++i) {
+      scratch[counts[entities[i].priority]++] = entities[i];
+    }
+    memcpy(entities, scratch, sizeof(rcl_ready_entity_t) * ready_count);
+  }
+
+  // Account this wait towards the load counters, so other threads comparing
+  // wait sets through rcl_wait_set_get_load() read well defined values.
+  uint64_t unused = 0;
+  rcutils_atomic_fetch_add(&wait_set->impl->load_wait_count, unused, 1);
+  if (wait_set->impl->ready_entity_count > 0) {
+    rcutils_atomic_fetch_add(&wait_set->impl->load_wake_count, unused, 1);
+    rcutils_atomic_fetch_add(
+      &wait_set->impl->load_ready_count, unused,
+      (uint64_t)wait_set->impl->ready_entity_count);
+  }
+  (void)unused;
+
+  *is_timer_timeout_arg = is_timer_timeout;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait(rcl_wait_set_t * wait_set, int64_t timeout)
+{
+  return __rcl_wait(wait_set, timeout, NULL, 0);
+}
+
+rcl_ret_t
+rcl_wait_until(
+  rcl_wait_set_t * wait_set,
+  rcl_time_point_value_t deadline,
+  rcl_clock_t * clock)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(clock, RCL_RET_INVALID_ARGUMENT);
+  return __rcl_wait(wait_set, -1, clock, deadline);
+}
+
+rcl_ret_t
+rcl_wait_set_get_ready_entities(
+  const rcl_wait_set_t * wait_set,
+  const rcl_ready_entity_t ** ready_entities,
+  size_t * number_of_ready_entities)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ready_entities, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(number_of_ready_entities, RCL_RET_INVALID_ARGUMENT);
+  *ready_entities = wait_set->impl->ready_entities;
+  *number_of_ready_entities = wait_set->impl->ready_entity_count;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_wait_set_get_load(const rcl_wait_set_t * wait_set, rcl_wait_set_load_t * load)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  if (!__wait_set_is_valid(wait_set)) {
+    RCL_SET_ERROR_MSG("wait set is invalid");
+    return RCL_RET_WAIT_SET_INVALID;
   }
+  RCL_CHECK_ARGUMENT_FOR_NULL(load, RCL_RET_INVALID_ARGUMENT);
+  load->entity_count = wait_set->impl->subscription_index +
+    wait_set->impl->guard_condition_index + wait_set->impl->timer_index +
+    wait_set->impl->client_index + wait_set->impl->service_index +
+    wait_set->impl->event_record_count;
+  load->wait_count = rcutils_atomic_load_uint64_t(&wait_set->impl->load_wait_count);
+  load->wake_count = rcutils_atomic_load_uint64_t(&wait_set->impl->load_wake_count);
+  load->ready_entity_count = rcutils_atomic_load_uint64_t(&wait_set->impl->load_ready_count);
   return RCL_RET_OK;
 }
 
@@ -0,0 +1,177 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "./wait_set_pool.h"
+
+#include "rcl/error_handling.h"
+#include "rcl/wait.h"
+#include "rcutils/logging_macros.h"
+
+#include "./context_impl.h"
+
+// One pooled wait set.  The wait set is the first member so the pointer
+// handed to callers can be mapped back to its entry on release.
+typedef struct rcl_wait_set_pool_entry_t
+{
+  rcl_wait_set_t wait_set;
+  struct rcl_wait_set_pool_entry_t * next;
+} rcl_wait_set_pool_entry_t;
+
+typedef struct rcl_wait_set_pool_t
+{
+  /// Entries not currently handed out; acquired entries are only tracked by
+  /// their caller until released.
+  rcl_wait_set_pool_entry_t * free_list;
+  rcl_allocator_t allocator;
+} rcl_wait_set_pool_t;
+
+// Get the context's pool, creating it on first use; returns NULL and sets
+// an error message on failure.
+static rcl_wait_set_pool_t *
+__get_wait_set_pool(rcl_context_t * context)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, NULL);
+  RCL_CHECK_FOR_NULL_WITH_MSG(context->impl, "context is invalid", return NULL);
+  if (!context->impl->wait_set_pool) {
+    rcl_allocator_t allocator = context->impl->allocator;
+    rcl_wait_set_pool_t * pool = (rcl_wait_set_pool_t *)allocator.zero_allocate(
+      1, sizeof(rcl_wait_set_pool_t), allocator.state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(pool, "allocating memory failed", return NULL);
+    pool->allocator = allocator;
+    context->impl->wait_set_pool = pool;
+  }
+  return context->impl->wait_set_pool;
+}
+
+rcl_ret_t
+rcl_context_acquire_wait_set(
+  rcl_context_t * context,
+  size_t number_of_subscriptions,
+  size_t number_of_guard_conditions,
+  size_t number_of_timers,
+  size_t number_of_clients,
+  size_t number_of_services,
+  rcl_wait_set_t ** wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  rcl_wait_set_pool_t * pool = __get_wait_set_pool(context);
+  if (!pool) {
+    return RCL_RET_ERROR;  // error already set
+  }
+  rcl_wait_set_pool_entry_t * entry = pool->free_list;
+  if (entry) {
+    pool->free_list = entry->next;
+    entry->next = NULL;
+    // A recycled set keeps its capacity and rmw wait set; only adjust it
+    // when the requested sizes differ.
+    if (
+      entry->wait_set.size_of_subscriptions != number_of_subscriptions ||
+      entry->wait_set.size_of_guard_conditions != number_of_guard_conditions ||
+      entry->wait_set.size_of_timers != number_of_timers ||
+      entry->wait_set.size_of_clients != number_of_clients ||
+      entry->wait_set.size_of_services != number_of_services)
+    {
+      rcl_ret_t ret = rcl_wait_set_resize(
+        &entry->wait_set, number_of_subscriptions, number_of_guard_conditions,
+        number_of_timers, number_of_clients, number_of_services);
+      if (RCL_RET_OK != ret) {
+        // The set may be in a partially resized state; drop it rather than
+        // pooling something inconsistent.
+        rcl_ret_t fini_ret = rcl_wait_set_fini(&entry->wait_set);
+        if (RCL_RET_OK != fini_ret) {
+          RCUTILS_LOG_ERROR_NAMED(
+            ROS_PACKAGE_NAME, "failed to fini wait set dropped from pool");
+        }
+        pool->allocator.deallocate(entry, pool->allocator.state);
+        return ret;  // error already set
+      }
+    } else {
+      rcl_ret_t ret = rcl_wait_set_clear(&entry->wait_set);
+      if (RCL_RET_OK != ret) {
+        return ret;  // error already set
+      }
+    }
+    *wait_set = &entry->wait_set;
+    return RCL_RET_OK;
+  }
+  // Nothing pooled; construct a fresh entry.
+  entry = (rcl_wait_set_pool_entry_t *)pool->allocator.zero_allocate(
+    1, sizeof(rcl_wait_set_pool_entry_t), pool->allocator.state);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    entry, "allocating memory failed", return RCL_RET_BAD_ALLOC);
+  entry->wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &entry->wait_set, number_of_subscriptions, number_of_guard_conditions,
+    number_of_timers, number_of_clients, number_of_services, pool->allocator);
+  if (RCL_RET_OK != ret) {
+    pool->allocator.deallocate(entry, pool->allocator.state);
+    return ret;  // error already set
+  }
+  *wait_set = &entry->wait_set;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_context_release_wait_set(rcl_context_t * context, rcl_wait_set_t * wait_set)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(context, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(wait_set, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl, "context is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_FOR_NULL_WITH_MSG(
+    context->impl->wait_set_pool, "context has no wait set pool",
+    return RCL_RET_INVALID_ARGUMENT);
+  rcl_wait_set_pool_t * pool = context->impl->wait_set_pool;
+  // The wait set is the first member of its entry, see
+  // rcl_wait_set_pool_entry_t.
+  rcl_wait_set_pool_entry_t * entry = (rcl_wait_set_pool_entry_t *)wait_set;
+  entry->next = pool->free_list;
+  pool->free_list = entry;
+  return RCL_RET_OK;
+}
+
+void
+rcl_wait_set_pool_fini(rcl_context_t * context)
+{
+  if (!context || !context->impl || !context->impl->wait_set_pool) {
+    return;
+  }
+  rcl_wait_set_pool_t * pool = context->impl->wait_set_pool;
+  rcl_wait_set_pool_entry_t * entry = pool->free_list;
+  while (entry) {
+    rcl_wait_set_pool_entry_t * next = entry->next;
+    rcl_ret_t ret = rcl_wait_set_fini(&entry->wait_set);
+    if (RCL_RET_OK != ret) {
+      RCUTILS_LOG_ERROR_NAMED(
+        ROS_PACKAGE_NAME, "failed to fini pooled wait set: %s",
+        rcl_get_error_string().str);
+      rcl_reset_error();
+    }
+    pool->allocator.deallocate(entry, pool->allocator.state);
+    entry = next;
+  }
+  rcl_allocator_t allocator = pool->allocator;
+  allocator.deallocate(pool, allocator.state);
+  context->impl->wait_set_pool = NULL;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCL__WAIT_SET_POOL_H_
+#define RCL__WAIT_SET_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include "rcl/context.h"
+
+// Internal pool of initialized wait sets, hung off the context.
+//
+// Callers that create a wait set per blocking call (a service wait, a single take
+// with a timeout) would otherwise pay rcl_wait_set_init's full allocation
+// chain plus rmw wait set creation every time.  Released sets keep their
+// capacity and middleware handle, so a later acquire only resizes when the
+// requested sizes differ.
+//
+// The public entry points are rcl_context_acquire_wait_set() and
+// rcl_context_release_wait_set(), declared in rcl/wait.h.
+
+struct rcl_wait_set_pool_t;
+
+/// Free the context's wait set pool if it was created.
+void
+rcl_wait_set_pool_fini(rcl_context_t * context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RCL__WAIT_SET_POOL_H_
@@ -0,0 +1,105 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "rcl/arena.h"
+#include "rcl/error_handling.h"
+
+#ifdef RMW_IMPLEMENTATION
+# define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
+# define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
+#else
+# define CLASSNAME(NAME, SUFFIX) NAME
+#endif
+
+class CLASSNAME (TestArenaFixture, RMW_IMPLEMENTATION) : public ::testing::Test
+{
+public:
+  void SetUp()
+  {
+  }
+
+  void TearDown()
+  {
+  }
+};
+
+TEST_F(CLASSNAME(TestArenaFixture, RMW_IMPLEMENTATION), test_allocator_init_and_carve) {
+  rcl_arena_t arena = rcl_get_zero_initialized_arena();
+  rcl_allocator_t allocator;
+
+  rcl_ret_t ret = rcl_arena_allocator_init(
+    nullptr, &arena, 1024, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_arena_allocator_init(&allocator, &arena, 1024, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // many small allocations are carved from the same block
+  char * first = static_cast<char *>(allocator.allocate(16, allocator.state));
+  ASSERT_NE(nullptr, first);
+  std::memset(first, 0xab, 16);
+  for (int i = 0; i < 10; ++i) {
+    void * pointer = allocator.allocate(16, allocator.state);
+    ASSERT_NE(nullptr, pointer);
+    // deallocate is a no-op, but must be callable
+    allocator.deallocate(pointer, allocator.state);
+  }
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(static_cast<char>(0xab), first[i]);
+  }
+
+  // zero_allocate returns zeroed memory
+  char * zeroed = static_cast<char *>(allocator.zero_allocate(4, 8, allocator.state));
+  ASSERT_NE(nullptr, zeroed);
+  for (size_t i = 0; i < 32; ++i) {
+    EXPECT_EQ(0, zeroed[i]);
+  }
+
+  // reallocate preserves the old contents
+  char * grown = static_cast<char *>(allocator.reallocate(first, 64, allocator.state));
+  ASSERT_NE(nullptr, grown);
+  for (size_t i = 0; i < 16; ++i) {
+    EXPECT_EQ(static_cast<char>(0xab), grown[i]);
+  }
+
+  rcl_arena_fini(&arena);
+}
+
+TEST_F(CLASSNAME(TestArenaFixture, RMW_IMPLEMENTATION), test_reset_reuses_block) {
+  rcl_arena_t arena = rcl_get_zero_initialized_arena();
+  rcl_allocator_t allocator;
+  rcl_ret_t ret = rcl_arena_allocator_init(&allocator, &arena, 64, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // force the arena to chain multiple blocks
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_NE(nullptr, allocator.allocate(64, allocator.state));
+  }
+
+  rcl_arena_reset(&arena);
+
+  // after the reset the retained block satisfies allocations again
+  void * pointer = allocator.allocate(64, allocator.state);
+  ASSERT_NE(nullptr, pointer);
+
+  // resetting an empty or finalized arena is a no-op
+  rcl_arena_fini(&arena);
+  rcl_arena_reset(&arena);
+  rcl_arena_fini(&arena);
+}
@@ -19,6 +19,7 @@
 #include "rcl/arguments.h"
 
 #include "rcl/error_handling.h"
+#include "rcl/remap.h"
 
 #ifdef RMW_IMPLEMENTATION
 # define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
@@ -202,6 +203,70 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_copy) {
   EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&copied_args));
 }
 
+TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_serialize_round_trip) {
+  const char * argv[] = {
+    "process_name", "/foo/bar:=/fiz/buz", "__params:=parameter_filepath", "not-a-ros-arg"
+  };
+  int argc = sizeof(argv) / sizeof(const char *);
+  rcl_allocator_t alloc = rcl_get_default_allocator();
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+  rcl_ret_t ret = rcl_parse_arguments(argc, argv, alloc, &parsed_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  uint8_t * blob = NULL;
+  size_t blob_length = 0;
+  ret = rcl_arguments_serialize(&parsed_args, alloc, &blob, &blob_length);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_NE(nullptr, blob);
+  ASSERT_GT(blob_length, 0u);
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
+
+  rcl_arguments_t loaded_args = rcl_get_zero_initialized_arguments();
+  ret = rcl_arguments_deserialize(blob, blob_length, alloc, &loaded_args);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // The loaded arguments are independent of the blob.
+  alloc.deallocate(blob, alloc.state);
+  EXPECT_UNPARSED(loaded_args, 0, 3);
+  EXPECT_EQ(1, rcl_arguments_get_param_files_count(&loaded_args));
+  char ** parameter_files = NULL;
+  ret = rcl_arguments_get_param_files(&loaded_args, alloc, &parameter_files);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("parameter_filepath", parameter_files[0]);
+  alloc.deallocate(parameter_files[0], alloc.state);
+  alloc.deallocate(parameter_files, alloc.state);
+  // The remap rules survived the round trip.
+  char * output = NULL;
+  ret = rcl_remap_topic_name(&loaded_args, NULL, "/foo/bar", "NodeName", "/", alloc, &output);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_NE(nullptr, output);
+  EXPECT_STREQ("/fiz/buz", output);
+  alloc.deallocate(output, alloc.state);
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&loaded_args));
+}
+
+TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_deserialize_malformed) {
+  rcl_allocator_t alloc = rcl_get_default_allocator();
+  rcl_arguments_t args = rcl_get_zero_initialized_arguments();
+  // Not a blob at all.
+  const uint8_t junk[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_arguments_deserialize(junk, sizeof(junk), alloc, &args));
+  rcl_reset_error();
+  // A genuine blob cut short is rejected rather than read out of bounds.
+  const char * argv[] = {"process_name", "/foo/bar:=/fiz/buz"};
+  int argc = sizeof(argv) / sizeof(const char *);
+  rcl_arguments_t parsed_args = rcl_get_zero_initialized_arguments();
+  ASSERT_EQ(RCL_RET_OK, rcl_parse_arguments(argc, argv, alloc, &parsed_args));
+  uint8_t * blob = NULL;
+  size_t blob_length = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_arguments_serialize(&parsed_args, alloc, &blob, &blob_length));
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
+  EXPECT_EQ(
+    RCL_RET_INVALID_ARGUMENT, rcl_arguments_deserialize(blob, blob_length / 2, alloc, &args));
+  rcl_reset_error();
+  alloc.deallocate(blob, alloc.state);
+}
+
 TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_two_namespace) {
   const char * argv[] = {"process_name", "__ns:=/foo/bar", "__ns:=/fiz/buz"};
   int argc = sizeof(argv) / sizeof(const char *);
@@ -330,6 +395,11 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_param_argument_
 
   int parameter_filecount = rcl_arguments_get_param_files_count(&parsed_args);
   EXPECT_EQ(0, parameter_filecount);
+  const char * const * parameter_files_view = NULL;
+  int view_count = 42;
+  ret = rcl_arguments_get_param_files_view(&parsed_args, &parameter_files_view, &view_count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0, view_count);
   EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&parsed_args));
 }
 
@@ -381,6 +451,16 @@ TEST_F(CLASSNAME(TestArgumentsFixture, RMW_IMPLEMENTATION), test_param_argument_
   ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
   EXPECT_STREQ("parameter_filepath1", parameter_files[0]);
   EXPECT_STREQ("parameter_filepath2", parameter_files[1]);
+
+  // The borrowed view sees the same paths without copying them.
+  const char * const * parameter_files_view = NULL;
+  int view_count = 0;
+  ret = rcl_arguments_get_param_files_view(&parsed_args, &parameter_files_view, &view_count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(2, view_count);
+  EXPECT_STREQ("parameter_filepath1", parameter_files_view[0]);
+  EXPECT_STREQ("parameter_filepath2", parameter_files_view[1]);
+
   for (int i = 0; i < parameter_filecount; ++i) {
     alloc.deallocate(parameter_files[i], alloc.state);
   }
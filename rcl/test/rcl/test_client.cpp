@@ -102,6 +102,88 @@ TEST_F(TestClientFixture, test_client_nominal) {
 }
 
 
+/* Testing in-flight request tracking.
+ */
+TEST_F(TestClientFixture, test_client_in_flight_requests) {
+  rcl_ret_t ret;
+  rcl_client_t client = rcl_get_zero_initialized_client();
+
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  client_options.max_in_flight_requests = 2;
+  ret = rcl_client_init(&client, this->node_ptr, ts, "add_two_ints", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  size_t in_flight_count = 42;
+  ret = rcl_client_get_in_flight_count(&client, &in_flight_count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, in_flight_count);
+
+  test_msgs__srv__Primitives_Request req;
+  test_msgs__srv__Primitives_Request__init(&req);
+  req.uint8_value = 1;
+  req.uint32_value = 2;
+
+  // Fill the table, attaching user data to the first request.
+  int user_data_storage = 0;
+  int64_t first_sequence_number = 0;
+  ret = rcl_send_request(&client, &req, &first_sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_client_set_request_user_data(&client, first_sequence_number, &user_data_storage);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  int64_t second_sequence_number = 0;
+  ret = rcl_send_request(&client, &req, &second_sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_client_get_in_flight_count(&client, &in_flight_count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2u, in_flight_count);
+
+  // A third request must be rejected rather than outrunning the table.
+  int64_t third_sequence_number = 0;
+  ret = rcl_send_request(&client, &req, &third_sequence_number);
+  EXPECT_EQ(RCL_RET_CLIENT_IN_FLIGHT_FULL, ret);
+  rcl_reset_error();
+
+  // Attaching user data to an unknown sequence number fails.
+  ret = rcl_client_set_request_user_data(&client, 12345, &user_data_storage);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Testing that the tracking accessors reject clients without a table.
+ */
+TEST_F(TestClientFixture, test_client_in_flight_requests_disabled) {
+  rcl_ret_t ret;
+  rcl_client_t client = rcl_get_zero_initialized_client();
+
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, "add_two_ints", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  size_t in_flight_count = 0;
+  ret = rcl_client_get_in_flight_count(&client, &in_flight_count);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  const void * user_data = nullptr;
+  ret = rcl_client_get_completed_request_user_data(&client, &user_data);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  ret = rcl_client_set_request_user_data(&client, 1, &in_flight_count);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+}
+
 /* Testing the client init and fini functions.
  */
 TEST_F(TestClientFixture, test_client_init_fini) {
@@ -199,3 +281,108 @@ TEST_F(TestClientFixture, test_client_init_fini) {
   EXPECT_EQ(RCL_RET_BAD_ALLOC, ret) << rcl_get_error_string().str;
   rcl_reset_error();
 }
+
+/* Testing the client group lifecycle and its wait set integration.
+ */
+TEST_F(TestClientFixture, test_client_group) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+
+  rcl_client_t first_client = rcl_get_zero_initialized_client();
+  ret = rcl_client_init(&first_client, this->node_ptr, ts, "grouped_one", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&first_client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_client_t second_client = rcl_get_zero_initialized_client();
+  ret = rcl_client_init(&second_client, this->node_ptr, ts, "grouped_two", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&second_client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Initializing with an invalid allocator should fail.
+  rcl_client_group_t group = rcl_get_zero_initialized_client_group();
+  rcl_client_group_options_t group_options = rcl_client_group_get_default_options();
+  group_options.allocator.allocate = nullptr;
+  ret = rcl_client_group_init(&group, group_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  group_options = rcl_client_group_get_default_options();
+  group_options.max_clients = 2;
+  ret = rcl_client_group_init(&group, group_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_group_fini(&group);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // An empty group cannot be added to a wait set.
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 0, 0, 2, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_client_group(&wait_set, &group, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Membership bookkeeping: duplicates are rejected and capacity is enforced.
+  ret = rcl_client_group_add_client(&group, &first_client);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_client_group_add_client(&group, &first_client);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_client_group_add_client(&group, &second_client);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_client_t third_client = rcl_get_zero_initialized_client();
+  ret = rcl_client_init(&third_client, this->node_ptr, ts, "grouped_three", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&third_client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_client_group_add_client(&group, &third_client);
+  EXPECT_EQ(RCL_RET_CLIENT_GROUP_FULL, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  size_t count = 0;
+  ret = rcl_client_group_get_number_of_clients(&group, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2u, count);
+
+  // Waiting on the group with no responses pending should time out and
+  // report no ready entities and an empty ready list.
+  size_t group_index = 42;
+  ret = rcl_wait_set_add_client_group(&wait_set, &group, &group_index);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, group_index);
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  const rcl_ready_entity_t * ready_entities = nullptr;
+  size_t number_of_ready_entities = 42;
+  ret = rcl_wait_set_get_ready_entities(&wait_set, &ready_entities, &number_of_ready_entities);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_of_ready_entities);
+  const rcl_client_t ** ready_clients = nullptr;
+  size_t number_ready = 42;
+  ret = rcl_client_group_get_ready_clients(&group, &ready_clients, &number_ready);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_ready);
+
+  // Removal: a member leaves, a non-member is rejected.
+  ret = rcl_client_group_remove_client(&group, &second_client);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_client_group_remove_client(&group, &second_client);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_client_group_get_number_of_clients(&group, &count);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, count);
+}
@@ -0,0 +1,107 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "rcl/counting_allocator.h"
+#include "rcl/error_handling.h"
+
+#ifdef RMW_IMPLEMENTATION
+# define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
+# define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
+#else
+# define CLASSNAME(NAME, SUFFIX) NAME
+#endif
+
+// This test runs with RCL_ALLOCATION_STATS=1 in the environment, see the
+// test's ENV entry in CMakeLists.txt, so accounting is enabled.
+
+TEST(CLASSNAME(TestCountingAllocator, RMW_IMPLEMENTATION), test_invalid_arguments) {
+  rcl_alloc_stats_t stats;
+  rcl_ret_t ret = rcl_get_allocation_stats(RCL_ALLOC_TAG_NODE, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_get_allocation_stats(RCL_ALLOC_TAG_COUNT, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+TEST(CLASSNAME(TestCountingAllocator, RMW_IMPLEMENTATION), test_counts_bytes_and_peak) {
+  rcl_reset_allocation_stats();
+  rcl_allocator_t allocator =
+    rcl_counting_allocator_wrap(rcl_get_default_allocator(), RCL_ALLOC_TAG_GRAPH);
+
+  rcl_alloc_stats_t stats;
+  ASSERT_EQ(RCL_RET_OK, rcl_get_allocation_stats(RCL_ALLOC_TAG_GRAPH, &stats)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(0u, stats.allocation_count);
+  EXPECT_EQ(0u, stats.current_bytes);
+
+  void * first = allocator.allocate(100, allocator.state);
+  ASSERT_NE(nullptr, first);
+  char * zeroed = static_cast<char *>(allocator.zero_allocate(10, 10, allocator.state));
+  ASSERT_NE(nullptr, zeroed);
+  for (size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(0, zeroed[i]);
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_get_allocation_stats(RCL_ALLOC_TAG_GRAPH, &stats)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(2u, stats.allocation_count);
+  EXPECT_EQ(200u, stats.total_bytes);
+  EXPECT_EQ(200u, stats.current_bytes);
+  EXPECT_EQ(200u, stats.peak_bytes);
+
+  // growing a block counts the growth; the written bytes survive the move
+  std::memset(first, 0xab, 100);
+  first = allocator.reallocate(first, 300, allocator.state);
+  ASSERT_NE(nullptr, first);
+  for (size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ('\xab', static_cast<char *>(first)[i]);
+  }
+  ASSERT_EQ(RCL_RET_OK, rcl_get_allocation_stats(RCL_ALLOC_TAG_GRAPH, &stats)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(3u, stats.allocation_count);
+  EXPECT_EQ(400u, stats.total_bytes);
+  EXPECT_EQ(400u, stats.current_bytes);
+  EXPECT_EQ(400u, stats.peak_bytes);
+
+  // deallocation lowers current_bytes but leaves the peak standing
+  allocator.deallocate(first, allocator.state);
+  allocator.deallocate(zeroed, allocator.state);
+  allocator.deallocate(nullptr, allocator.state);
+  ASSERT_EQ(RCL_RET_OK, rcl_get_allocation_stats(RCL_ALLOC_TAG_GRAPH, &stats)) <<
+    rcl_get_error_string().str;
+  EXPECT_EQ(0u, stats.current_bytes);
+  EXPECT_EQ(400u, stats.peak_bytes);
+
+  // logging the stats is a smoke test; output goes to the rcl logger
+  rcl_log_allocation_stats();
+  rcl_reset_allocation_stats();
+}
+
+TEST(CLASSNAME(TestCountingAllocator, RMW_IMPLEMENTATION), test_tag_binds_one_allocator) {
+  // the tag is bound to the default allocator by the previous test or here
+  rcl_allocator_t wrapped =
+    rcl_counting_allocator_wrap(rcl_get_default_allocator(), RCL_ALLOC_TAG_GRAPH);
+  EXPECT_NE(wrapped.allocate, rcl_get_default_allocator().allocate);
+
+  // a different inner allocator for the same tag comes back unwrapped
+  rcl_allocator_t other = rcl_get_default_allocator();
+  other.state = &other;  // any distinct state
+  rcl_allocator_t not_wrapped = rcl_counting_allocator_wrap(other, RCL_ALLOC_TAG_GRAPH);
+  EXPECT_EQ(not_wrapped.allocate, other.allocate);
+  EXPECT_EQ(not_wrapped.state, other.state);
+}
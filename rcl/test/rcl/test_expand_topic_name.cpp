@@ -22,6 +22,7 @@
 #include "rcl/expand_topic_name.h"
 
 #include "rcl/error_handling.h"
+#include "rmw/validate_full_topic_name.h"
 
 using namespace std::string_literals;
 
@@ -47,6 +48,146 @@ TEST(test_expand_topic_name, normal) {
   }
 }
 
+TEST(test_expand_topic_name, with_buffer) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  const char * ns = "/my_ns";
+  const char * node = "my_node";
+  char buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
+
+  // substitutions and relative name
+  {
+    std::string expected = std::string(ns) + "/" + node + "/chatter";
+    ret = rcl_expand_topic_name_with_buffer(
+      "{node}/chatter", node, ns, &subs, buffer, sizeof(buffer));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ(expected.c_str(), buffer);
+  }
+
+  // namespace tilde
+  {
+    std::string expected = std::string(ns) + "/" + node + "/chatter";
+    ret = rcl_expand_topic_name_with_buffer(
+      "~/chatter", node, ns, &subs, buffer, sizeof(buffer));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ(expected.c_str(), buffer);
+  }
+
+  // already absolute name is unchanged
+  {
+    ret = rcl_expand_topic_name_with_buffer(
+      "/absolute/name", node, ns, &subs, buffer, sizeof(buffer));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ("/absolute/name", buffer);
+  }
+
+  // result matches the allocating variant
+  {
+    char * expanded_topic = NULL;
+    ret = rcl_expand_topic_name("{ns}/chatter", node, ns, &subs, allocator, &expanded_topic);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_expand_topic_name_with_buffer(
+      "{ns}/chatter", node, ns, &subs, buffer, sizeof(buffer));
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_STREQ(expanded_topic, buffer);
+    allocator.deallocate(expanded_topic, allocator.state);
+  }
+
+  // too small a buffer is reported, not truncated
+  {
+    char small_buffer[8];
+    ret = rcl_expand_topic_name_with_buffer(
+      "~/chatter", node, ns, &subs, small_buffer, sizeof(small_buffer));
+    EXPECT_EQ(RCL_RET_BUFFER_TOO_SMALL, ret);
+    rcl_reset_error();
+  }
+
+  // unknown substitutions are still an error
+  {
+    ret = rcl_expand_topic_name_with_buffer(
+      "{unknown_substitution}/chatter", node, ns, &subs, buffer, sizeof(buffer));
+    EXPECT_EQ(RCL_RET_UNKNOWN_SUBSTITUTION, ret);
+    rcl_reset_error();
+  }
+
+  rcu_ret = rcutils_string_map_fini(&subs);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+}
+
+TEST(test_expand_topic_name, expand_and_validate) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  const char * ns = "/my_ns";
+  const char * node = "my_node";
+  char buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
+  int validation_result;
+
+  // a valid name expands and validates in one call
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "~/chatter", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(RMW_TOPIC_VALID, validation_result);
+    EXPECT_STREQ("/my_ns/my_node/chatter", buffer);
+  }
+
+  // a substitution creating '//' fails full name validation, as
+  // rmw_validate_full_topic_name() would after a separate expansion
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "/foo/{namespace}", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(RMW_TOPIC_INVALID_CONTAINS_REPEATED_FORWARD_SLASH, validation_result);
+  }
+
+  // unallowed characters are reported through the validation result
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "/white space", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(RMW_TOPIC_INVALID_CONTAINS_UNALLOWED_CHARACTERS, validation_result);
+  }
+
+  // a token starting with a number is invalid
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "/foo/1chatter", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(RMW_TOPIC_INVALID_NAME_TOKEN_STARTS_WITH_NUMBER, validation_result);
+  }
+
+  // unknown substitutions are still a function error
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "{unknown_substitution}", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_UNKNOWN_SUBSTITUTION, ret);
+    rcl_reset_error();
+  }
+
+  // an unmatched '{' is caught without the separate input validation pass
+  {
+    ret = rcl_expand_and_validate_topic_name_with_buffer(
+      "/chatter/{node", node, ns, &subs, buffer, sizeof(buffer), &validation_result);
+    EXPECT_EQ(RCL_RET_TOPIC_NAME_INVALID, ret);
+    rcl_reset_error();
+  }
+
+  rcu_ret = rcutils_string_map_fini(&subs);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+}
+
 TEST(test_expand_topic_name, invalid_arguments) {
   rcl_ret_t ret;
   rcl_allocator_t allocator = rcl_get_default_allocator();
@@ -220,3 +361,129 @@ TEST(test_expand_topic_name, custom_substitution) {
     EXPECT_STREQ("/my_ns/pong", expanded_topic);
   }
 }
+
+TEST(test_expand_topic_name, template_compile_and_render) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  std::vector<std::vector<std::string>> topics_that_should_expand_to = {
+    // {"input_topic", "node_name", "/namespace", "expected result"},
+    {"/chatter", "my_node", "/my_ns", "/chatter"},
+    {"chatter", "my_node", "/my_ns", "/my_ns/chatter"},
+    {"{node}/chatter", "my_node", "/my_ns", "/my_ns/my_node/chatter"},
+    {"/{node}", "my_node", "/my_ns", "/my_node"},
+    {"{node}", "my_node", "/my_ns", "/my_ns/my_node"},
+    {"{ns}", "my_node", "/my_ns", "/my_ns"},
+    {"{namespace}", "my_node", "/my_ns", "/my_ns"},
+    {"{namespace}/{node}/chatter", "my_node", "/my_ns", "/my_ns/my_node/chatter"},
+    {"ping", "my_node", "/", "/ping"},
+    {"~", "my_node", "/", "/my_node"},
+    {"~", "my_node", "/my_ns", "/my_ns/my_node"},
+    {"~/ping", "my_node", "/", "/my_node/ping"},
+    {"~/ping", "my_node", "/my_ns", "/my_ns/my_node/ping"},
+  };
+
+  for (const auto & inout : topics_that_should_expand_to) {
+    const char * topic = inout.at(0).c_str();
+    const char * node = inout.at(1).c_str();
+    const char * ns = inout.at(2).c_str();
+    std::string expected = inout.at(3);
+    rcl_topic_template_t topic_template = rcl_get_zero_initialized_topic_template();
+    ret = rcl_topic_template_compile(topic, allocator, &topic_template);
+    std::stringstream ss;
+    ss << "^ While rendering '" << topic <<
+      "' with node '" << node << "' and namespace '" << ns << "'";
+    ASSERT_EQ(RCL_RET_OK, ret) << ss.str() << ": " << rcl_get_error_string().str;
+    char buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
+    // a compiled template can be rendered repeatedly
+    for (int i = 0; i < 2; ++i) {
+      ret = rcl_topic_template_render(
+        &topic_template, node, ns, &subs, buffer, sizeof(buffer));
+      EXPECT_EQ(RCL_RET_OK, ret) << ss.str() << ": " << rcl_get_error_string().str;
+      EXPECT_STREQ(expected.c_str(), buffer) << ss.str() << " strings did not match.\n";
+    }
+    EXPECT_EQ(RCL_RET_OK, rcl_topic_template_fini(&topic_template));
+  }
+}
+
+TEST(test_expand_topic_name, template_substitutions) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_get_default_topic_name_substitutions(&subs);
+  ASSERT_EQ(RCL_RET_OK, ret);
+
+  rcl_topic_template_t topic_template = rcl_get_zero_initialized_topic_template();
+  ret = rcl_topic_template_compile("{ping}", allocator, &topic_template);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  char buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
+
+  // the custom substitution is looked up at render time, so it can appear
+  // in the map after the template is compiled and change between renders
+  ret = rcl_topic_template_render(
+    &topic_template, "my_node", "/my_ns", &subs, buffer, sizeof(buffer));
+  EXPECT_EQ(RCL_RET_UNKNOWN_SUBSTITUTION, ret);
+  rcl_reset_error();
+
+  rcu_ret = rcutils_string_map_set(&subs, "ping", "pong");
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+  ret = rcl_topic_template_render(
+    &topic_template, "my_node", "/my_ns", &subs, buffer, sizeof(buffer));
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("/my_ns/pong", buffer);
+
+  EXPECT_EQ(RCL_RET_OK, rcl_topic_template_fini(&topic_template));
+}
+
+TEST(test_expand_topic_name, template_invalid_arguments) {
+  rcl_ret_t ret;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcutils_string_map_t subs = rcutils_get_zero_initialized_string_map();
+  rcutils_ret_t rcu_ret = rcutils_string_map_init(&subs, 0, allocator);
+  ASSERT_EQ(RCUTILS_RET_OK, rcu_ret);
+
+  rcl_topic_template_t topic_template = rcl_get_zero_initialized_topic_template();
+  ret = rcl_topic_template_compile(nullptr, allocator, &topic_template);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_topic_template_compile("chatter", allocator, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // an invalid spec is rejected at compile time
+  ret = rcl_topic_template_compile("chatter name", allocator, &topic_template);
+  EXPECT_EQ(RCL_RET_TOPIC_NAME_INVALID, ret);
+  rcl_reset_error();
+
+  // rendering an uncompiled template is an error
+  char buffer[RCL_EXPAND_TOPIC_NAME_BUFFER_LENGTH];
+  ret = rcl_topic_template_render(
+    &topic_template, "my_node", "/my_ns", &subs, buffer, sizeof(buffer));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ASSERT_EQ(RCL_RET_OK, rcl_topic_template_compile("chatter", allocator, &topic_template));
+  // compiling into an already compiled template is an error
+  ret = rcl_topic_template_compile("other", allocator, &topic_template);
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, ret);
+  rcl_reset_error();
+
+  // a too small buffer is reported, not truncated
+  ret = rcl_topic_template_render(
+    &topic_template, "my_node", "/my_ns", &subs, buffer, 4);
+  EXPECT_EQ(RCL_RET_BUFFER_TOO_SMALL, ret);
+  rcl_reset_error();
+
+  EXPECT_EQ(RCL_RET_OK, rcl_topic_template_fini(&topic_template));
+  // repeat fini is ok
+  EXPECT_EQ(RCL_RET_OK, rcl_topic_template_fini(&topic_template));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_topic_template_fini(nullptr));
+  rcl_reset_error();
+}
@@ -29,6 +29,7 @@
 
 #include "rcl/rcl.h"
 #include "rcl/graph.h"
+#include "rcl/graph_event_filter.h"
 
 #include "rcutils/logging_macros.h"
 
@@ -572,3 +573,136 @@ TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_rcl_service_server_
   wait_for_service_state_to_change(false, is_available);
   ASSERT_FALSE(is_available);
 }
+
+/* Test the graph event filter over the graph guard condition.
+ */
+TEST_F(CLASSNAME(TestGraphFixture, RMW_IMPLEMENTATION), test_graph_event_filter) {
+  rcl_ret_t ret;
+  rcl_graph_event_filter_options_t filter_options =
+    rcl_graph_event_filter_get_default_options();
+
+  // Check invalid arguments.
+  rcl_graph_event_filter_t filter = rcl_get_zero_initialized_graph_event_filter();
+  ret = rcl_graph_event_filter_init(&filter, nullptr, filter_options);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  filter_options.event_mask = 0xffffffffu;
+  ret = rcl_graph_event_filter_init(&filter, this->node_ptr, filter_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Watch topic changes only.
+  filter_options.event_mask = RCL_GRAPH_EVENT_TOPICS_CHANGED;
+  ret = rcl_graph_event_filter_init(&filter, this->node_ptr, filter_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_graph_event_filter_fini(&filter)) << rcl_get_error_string().str;
+  });
+  const rcl_guard_condition_t * filtered_guard_condition =
+    rcl_graph_event_filter_get_guard_condition(&filter);
+  ASSERT_NE(nullptr, filtered_guard_condition) << rcl_get_error_string().str;
+
+  // Nothing changed since init, so nothing is pending.
+  uint32_t events = 0;
+  ret = rcl_graph_event_filter_take_events(&filter, &events);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, events);
+
+  // Create a publisher on a new topic and pump until the change is seen;
+  // discovery is asynchronous, so poll.
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_t pub = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t pub_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(
+    &pub, this->node_ptr, ts, "/chatter_test_graph_event_filter", &pub_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&pub, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  uint32_t delivered = 0;
+  for (size_t i = 0; i < 100 && 0 == delivered; ++i) {
+    ret = rcl_graph_event_filter_process(&filter, &delivered);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    if (0 == delivered) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  EXPECT_EQ(RCL_GRAPH_EVENT_TOPICS_CHANGED, delivered);
+
+  // The delivery is accumulated until taken, then the filter is empty again.
+  ret = rcl_graph_event_filter_take_events(&filter, &events);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_GRAPH_EVENT_TOPICS_CHANGED, events);
+  ret = rcl_graph_event_filter_take_events(&filter, &events);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, events);
+
+  // A filter watching only services never wakes for topic changes.
+  rcl_graph_event_filter_t service_filter = rcl_get_zero_initialized_graph_event_filter();
+  filter_options.event_mask = RCL_GRAPH_EVENT_SERVICES_CHANGED;
+  ret = rcl_graph_event_filter_init(&service_filter, this->node_ptr, filter_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(
+      RCL_RET_OK, rcl_graph_event_filter_fini(&service_filter)) << rcl_get_error_string().str;
+  });
+  rcl_publisher_t pub2 = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &pub2, this->node_ptr, ts, "/chatter_test_graph_event_filter_other", &pub_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&pub2, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  for (size_t i = 0; i < 10; ++i) {
+    ret = rcl_graph_event_filter_process(&service_filter, &delivered);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(0u, delivered);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // With a long minimum interval, the pump does not deliver again until the
+  // interval has passed, no matter how often it is called.
+  rcl_graph_event_filter_t debounced = rcl_get_zero_initialized_graph_event_filter();
+  filter_options.event_mask = RCL_GRAPH_EVENT_TOPICS_CHANGED;
+  filter_options.min_interval = RCL_S_TO_NS(3600);
+  ret = rcl_graph_event_filter_init(&debounced, this->node_ptr, filter_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(
+      RCL_RET_OK, rcl_graph_event_filter_fini(&debounced)) << rcl_get_error_string().str;
+  });
+  rcl_publisher_t pub3 = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &pub3, this->node_ptr, ts, "/chatter_test_graph_event_filter_third", &pub_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&pub3, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  delivered = 0;
+  for (size_t i = 0; i < 100 && 0 == delivered; ++i) {
+    ret = rcl_graph_event_filter_process(&debounced, &delivered);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    if (0 == delivered) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+  ASSERT_EQ(RCL_GRAPH_EVENT_TOPICS_CHANGED, delivered);
+  rcl_publisher_t pub4 = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &pub4, this->node_ptr, ts, "/chatter_test_graph_event_filter_fourth", &pub_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&pub4, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  for (size_t i = 0; i < 10; ++i) {
+    ret = rcl_graph_event_filter_process(&debounced, &delivered);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(0u, delivered);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
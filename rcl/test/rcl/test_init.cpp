@@ -22,6 +22,8 @@
 #include "rcl/error_handling.h"
 #include "rcutils/format_string.h"
 #include "rcutils/snprintf.h"
+#include "test_msgs/msg/primitives.h"
+#include "test_msgs/srv/primitives.h"
 
 #include "../src/rcl/init_options_impl.h"
 
@@ -259,3 +261,73 @@ TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_get_instance_id_a
   ret = rcl_context_fini(&context);
   EXPECT_EQ(ret, RCL_RET_OK);
 }
+
+/* Tests bulk entity teardown with rcl_context_fini_all_entities().
+ */
+TEST_F(CLASSNAME(TestRCLFixture, RMW_IMPLEMENTATION), test_rcl_context_fini_all_entities) {
+  rcl_ret_t ret;
+  // Invalid arguments.
+  ret = rcl_context_fini_all_entities(nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  ret = rcl_context_fini_all_entities(&context);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A context with no entities tears down trivially.
+  ret = rcl_context_fini_all_entities(&context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Create one entity of each kind on a node.
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  rcl_node_options_t node_options = rcl_node_get_default_options();
+  ret = rcl_node_init(&node, "fini_all_entities_node", "", &context, &node_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  const rosidl_message_type_support_t * msg_ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const rosidl_service_type_support_t * srv_ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, Primitives);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, &node, msg_ts, "fini_all_chatter", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(
+    &subscription, &node, msg_ts, "fini_all_chatter", &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, &node, srv_ts, "fini_all_service", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, &node, srv_ts, "fini_all_service", &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // An entity finalized individually is no longer tracked and is skipped.
+  rcl_publisher_t finished_publisher = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &finished_publisher, &node, msg_ts, "fini_all_finished", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_fini(&finished_publisher, &node);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Bulk teardown may run after shutdown, finalizing everything at once.
+  ret = rcl_shutdown(&context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_fini_all_entities(&context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(rcl_node_is_valid(&node));
+  rcl_reset_error();
+  // A second call finds nothing left to do.
+  ret = rcl_context_fini_all_entities(&context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_fini(&context);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
@@ -0,0 +1,238 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "rcl/latency_probe.h"
+
+#include "rcl/rcl.h"
+
+#include "test_msgs/msg/primitives.h"
+#include "test_msgs/srv/primitives.h"
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcl/error_handling.h"
+
+#ifdef RMW_IMPLEMENTATION
+# define CLASSNAME_(NAME, SUFFIX) NAME ## __ ## SUFFIX
+# define CLASSNAME(NAME, SUFFIX) CLASSNAME_(NAME, SUFFIX)
+#else
+# define CLASSNAME(NAME, SUFFIX) NAME
+#endif
+
+class CLASSNAME (TestLatencyProbeFixture, RMW_IMPLEMENTATION) : public ::testing::Test
+{
+public:
+  rcl_context_t * context_ptr;
+  rcl_node_t * node_ptr;
+  void SetUp()
+  {
+    rcl_ret_t ret;
+    {
+      rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+      ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+      OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+        EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+      });
+      this->context_ptr = new rcl_context_t;
+      *this->context_ptr = rcl_get_zero_initialized_context();
+      ret = rcl_init(0, nullptr, &init_options, this->context_ptr);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+    this->node_ptr = new rcl_node_t;
+    *this->node_ptr = rcl_get_zero_initialized_node();
+    const char * name = "test_latency_probe_node";
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    ret = rcl_node_init(this->node_ptr, name, "", this->context_ptr, &node_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    rcl_ret_t ret = rcl_node_fini(this->node_ptr);
+    delete this->node_ptr;
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_shutdown(this->context_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_context_fini(this->context_ptr);
+    delete this->context_ptr;
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+};
+
+static void
+expect_ordered_stats(const rcl_latency_stats_t & stats, uint64_t expected_samples)
+{
+  EXPECT_EQ(expected_samples, stats.sample_count);
+  EXPECT_GT(stats.min, 0);
+  EXPECT_LE(stats.min, stats.p50);
+  EXPECT_LE(stats.p50, stats.p90);
+  EXPECT_LE(stats.p90, stats.p99);
+  EXPECT_LE(stats.p99, stats.max);
+}
+
+/* Check invalid arguments to the latency probe functions.
+ */
+TEST_F(CLASSNAME(TestLatencyProbeFixture, RMW_IMPLEMENTATION), test_invalid_arguments) {
+  const rosidl_message_type_support_t * msg_ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_latency_probe_t probe = rcl_get_zero_initialized_latency_probe();
+  rcl_latency_probe_options_t options = rcl_latency_probe_get_default_options();
+
+  rcl_ret_t ret = rcl_latency_probe_init(nullptr, this->node_ptr, msg_ts, nullptr, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_latency_probe_init(&probe, nullptr, msg_ts, nullptr, &options);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_latency_probe_init(&probe, this->node_ptr, msg_ts, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // At least one type support is required.
+  ret = rcl_latency_probe_init(&probe, this->node_ptr, nullptr, nullptr, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  options.max_samples = 0;
+  ret = rcl_latency_probe_init(&probe, this->node_ptr, msg_ts, nullptr, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // An uninitialized probe cannot measure or report.
+  rcl_latency_stats_t stats;
+  ret = rcl_latency_probe_get_message_stats(&probe, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Measure message and service round trips over the loopback entities.
+ */
+TEST_F(CLASSNAME(TestLatencyProbeFixture, RMW_IMPLEMENTATION), test_measure_nominal) {
+  const rosidl_message_type_support_t * msg_ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const rosidl_service_type_support_t * srv_ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+  rcl_latency_probe_t probe = rcl_get_zero_initialized_latency_probe();
+  rcl_latency_probe_options_t options = rcl_latency_probe_get_default_options();
+  rcl_ret_t ret = rcl_latency_probe_init(&probe, this->node_ptr, msg_ts, srv_ts, &options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_latency_probe_fini(&probe, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Before any measurement the stats are empty, which is not an error.
+  rcl_latency_stats_t stats;
+  ret = rcl_latency_probe_get_message_stats(&probe, &stats);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, stats.sample_count);
+
+  test_msgs__msg__Primitives msg;
+  test_msgs__msg__Primitives__init(&msg);
+  msg.int64_value = 42;
+  test_msgs__msg__Primitives scratch_msg;
+  test_msgs__msg__Primitives__init(&scratch_msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__Primitives__fini(&msg);
+    test_msgs__msg__Primitives__fini(&scratch_msg);
+  });
+
+  // Discovery between the loopback pair may still be in progress; retry
+  // until the first measurement makes it through.
+  const size_t kIterations = 5u;
+  int64_t per_trip_timeout = RCL_MS_TO_NS(1000);
+  ret = RCL_RET_TIMEOUT;
+  for (int attempt = 0; RCL_RET_TIMEOUT == ret && attempt < 10; ++attempt) {
+    ret = rcl_latency_probe_measure_messages(
+      &probe, &msg, &scratch_msg, kIterations, per_trip_timeout);
+    if (RCL_RET_TIMEOUT == ret) {
+      rcl_reset_error();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(42, scratch_msg.int64_value);
+
+  ret = rcl_latency_probe_get_message_stats(&probe, &stats);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_ordered_stats(stats, kIterations);
+
+  test_msgs__srv__Primitives_Request request;
+  test_msgs__srv__Primitives_Request__init(&request);
+  test_msgs__srv__Primitives_Request scratch_request;
+  test_msgs__srv__Primitives_Request__init(&scratch_request);
+  test_msgs__srv__Primitives_Response response;
+  test_msgs__srv__Primitives_Response__init(&response);
+  test_msgs__srv__Primitives_Response scratch_response;
+  test_msgs__srv__Primitives_Response__init(&scratch_response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__srv__Primitives_Request__fini(&request);
+    test_msgs__srv__Primitives_Request__fini(&scratch_request);
+    test_msgs__srv__Primitives_Response__fini(&response);
+    test_msgs__srv__Primitives_Response__fini(&scratch_response);
+  });
+
+  ret = RCL_RET_TIMEOUT;
+  for (int attempt = 0; RCL_RET_TIMEOUT == ret && attempt < 10; ++attempt) {
+    ret = rcl_latency_probe_measure_services(
+      &probe, &request, &scratch_request, &response, &scratch_response,
+      kIterations, per_trip_timeout);
+    if (RCL_RET_TIMEOUT == ret) {
+      rcl_reset_error();
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ret = rcl_latency_probe_get_service_stats(&probe, &stats);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  expect_ordered_stats(stats, kIterations);
+}
+
+/* A probe initialized with only one channel rejects use of the other.
+ */
+TEST_F(CLASSNAME(TestLatencyProbeFixture, RMW_IMPLEMENTATION), test_single_channel) {
+  const rosidl_message_type_support_t * msg_ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_latency_probe_t probe = rcl_get_zero_initialized_latency_probe();
+  rcl_latency_probe_options_t options = rcl_latency_probe_get_default_options();
+  rcl_ret_t ret = rcl_latency_probe_init(&probe, this->node_ptr, msg_ts, nullptr, &options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_latency_probe_fini(&probe, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  test_msgs__srv__Primitives_Request request;
+  test_msgs__srv__Primitives_Request__init(&request);
+  test_msgs__srv__Primitives_Response response;
+  test_msgs__srv__Primitives_Response__init(&response);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__srv__Primitives_Request__fini(&request);
+    test_msgs__srv__Primitives_Response__fini(&response);
+  });
+  ret = rcl_latency_probe_measure_services(
+    &probe, &request, &request, &response, &response, 1u, RCL_MS_TO_NS(100));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  rcl_latency_stats_t stats;
+  ret = rcl_latency_probe_get_service_stats(&probe, &stats);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
@@ -217,6 +217,19 @@ TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_token)
   EXPECT_LEX(RCL_LEXEME_TOKEN, "_GHI_", "_GHI_");
 }
 
+TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_long_token)
+{
+  // Long runs of token body characters are consumed by the lexer's fast scan
+  std::string long_token(300, 'a');
+  EXPECT_LEX(RCL_LEXEME_TOKEN, long_token.c_str(), long_token.c_str());
+  EXPECT_LEX(RCL_LEXEME_TOKEN, long_token.c_str(), (long_token + ":=").c_str());
+  std::string underscored = long_token + "_" + long_token;
+  EXPECT_LEX(RCL_LEXEME_TOKEN, underscored.c_str(), underscored.c_str());
+  // A long run that turns out to be a url scheme prefix is still backtracked
+  std::string rostopic_token = "rostopic" + long_token;
+  EXPECT_LEX(RCL_LEXEME_TOKEN, rostopic_token.c_str(), rostopic_token.c_str());
+}
+
 TEST_F(CLASSNAME(TestLexerFixture, RMW_IMPLEMENTATION), test_url_scheme)
 {
   // No text after scheme
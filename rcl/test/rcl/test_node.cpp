@@ -421,6 +421,133 @@ TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_life_cycle)
   }
 }
 
+/* Tests that copying node options shares the parsed arguments.
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_options_copy) {
+  rcl_ret_t ret;
+  const char * argv[] = {"process_name", "__ns:=/foo", "foo:=bar"};
+  int argc = sizeof(argv) / sizeof(const char *);
+  rcl_node_options_t options = rcl_node_get_default_options();
+  options.domain_id = 42;
+  options.use_global_arguments = false;
+  ret = rcl_parse_arguments(argc, argv, rcl_get_default_allocator(), &options.arguments);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_node_options_t copied_options = rcl_node_get_default_options();
+  ret = rcl_node_options_copy(&options, &copied_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(42u, copied_options.domain_id);
+  EXPECT_FALSE(copied_options.use_global_arguments);
+  // The arguments are shared by reference count, not deep-copied.
+  EXPECT_EQ(options.arguments.impl, copied_options.arguments.impl);
+
+  // Copying into itself is rejected.
+  ret = rcl_node_options_copy(&options, &options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // The copy stays usable after the original releases its reference.
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&options.arguments));
+  int unparsed_count = rcl_arguments_get_count_unparsed(&copied_options.arguments);
+  EXPECT_EQ(1, unparsed_count);
+  EXPECT_EQ(RCL_RET_OK, rcl_arguments_fini(&copied_options.arguments));
+}
+
+/* Tests the two phase init, i.e. rcl_node_init_async / rcl_node_init_complete.
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_init_async) {
+  rcl_ret_t ret;
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  rcl_node_t node = rcl_get_zero_initialized_node();
+  const char * name = "test_rcl_node_init_async_node";
+  const char * namespace_ = "/ns";
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+  // Completing without a staged init should fail.
+  ret = rcl_node_init_complete(&node);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  ASSERT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+  // After the async portion the node is staged but not yet valid.
+  ret = rcl_node_init_async(&node, name, namespace_, &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(rcl_node_is_valid(&node));
+  rcl_reset_error();
+  // Completing makes it valid and usable.
+  ret = rcl_node_init_complete(&node);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(rcl_node_is_valid(&node));
+  EXPECT_STREQ(name, rcl_node_get_name(&node));
+  // A second completion has nothing in flight.
+  ret = rcl_node_init_complete(&node);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  ASSERT_TRUE(rcl_error_is_set());
+  rcl_reset_error();
+  ret = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  // A staged node that is never completed can still be finalized.
+  node = rcl_get_zero_initialized_node();
+  ret = rcl_node_init_async(&node, name, namespace_, &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_node_fini(&node);
+  EXPECT_EQ(RCL_RET_OK, ret);
+}
+
+/* Tests sharing one middleware participant between nodes in a context.
+ */
+TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_shared_participant) {
+  rcl_ret_t ret;
+  rcl_context_t context = rcl_get_zero_initialized_context();
+  rcl_node_options_t default_options = rcl_node_get_default_options();
+  rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+  ret = rcl_init_options_init(&init_options, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+  });
+  // the mode defaults to off and round trips through set/get
+  bool share_participant = true;
+  ret = rcl_init_options_get_share_participant(&init_options, &share_participant);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_FALSE(share_participant);
+  ret = rcl_init_options_set_share_participant(&init_options, true);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_init_options_get_share_participant(&init_options, &share_participant);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_TRUE(share_participant);
+  ret = rcl_init(0, nullptr, &init_options, &context);
+  ASSERT_EQ(RCL_RET_OK, ret);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    ASSERT_EQ(RCL_RET_OK, rcl_shutdown(&context));
+    ASSERT_EQ(RCL_RET_OK, rcl_context_fini(&context));
+  });
+  // both nodes end up multiplexed onto one rmw node
+  rcl_node_t node1 = rcl_get_zero_initialized_node();
+  rcl_node_t node2 = rcl_get_zero_initialized_node();
+  ret = rcl_node_init(&node1, "shared_participant_node1", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_node_init(&node2, "shared_participant_node2", "/ns", &context, &default_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(rcl_node_get_rmw_handle(&node1), rcl_node_get_rmw_handle(&node2));
+  // finalizing one node must keep the shared participant alive for the other
+  ret = rcl_node_fini(&node1);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  EXPECT_TRUE(rcl_node_is_valid(&node2));
+  ret = rcl_node_fini(&node2);
+  EXPECT_EQ(RCL_RET_OK, ret);
+}
+
 /* Tests the node name restrictions enforcement.
  */
 TEST_F(CLASSNAME(TestNodeFixture, RMW_IMPLEMENTATION), test_rcl_node_name_restrictions) {
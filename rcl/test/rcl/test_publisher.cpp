@@ -16,7 +16,9 @@
 
 #include "rcl/publisher.h"
 
+#include "rcl/entity_batch.h"
 #include "rcl/rcl.h"
+#include "rmw/rmw.h"
 #include "test_msgs/msg/primitives.h"
 #include "rosidl_generator_c/string_functions.h"
 
@@ -267,3 +269,532 @@ TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_init_
   EXPECT_EQ(RCL_RET_BAD_ALLOC, ret) << rcl_get_error_string().str;
   rcl_reset_error();
 }
+
+/* Basic test of publishing a batch of messages.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publish_batch) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic_name = "chatter_batch";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  test_msgs__msg__Primitives msgs[3];
+  const void * msg_ptrs[3];
+  for (size_t i = 0; i < 3; ++i) {
+    test_msgs__msg__Primitives__init(&msgs[i]);
+    msgs[i].int64_value = static_cast<int64_t>(i);
+    msg_ptrs[i] = &msgs[i];
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    for (size_t i = 0; i < 3; ++i) {
+      test_msgs__msg__Primitives__fini(&msgs[i]);
+    }
+  });
+  ret = rcl_publish_batch(&publisher, msg_ptrs, 3);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // An empty batch is a no-op.
+  ret = rcl_publish_batch(&publisher, msg_ptrs, 0);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A batch containing a null message is rejected.
+  msg_ptrs[1] = nullptr;
+  ret = rcl_publish_batch(&publisher, msg_ptrs, 3);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Test finalizing a publisher with deferred middleware destruction.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_fini_deferred) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  // Draining an empty (never created) queue succeeds with zero reclaimed.
+  size_t number_reclaimed = 42;
+  ret = rcl_context_reclaim(this->context_ptr, &number_reclaimed);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_reclaimed);
+  ret = rcl_context_reclaim(nullptr, &number_reclaimed);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // Deferred fini parks the rmw handle until the next reclaim.
+  rcl_publisher_t publisher_a = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &publisher_a, this->node_ptr, ts, "chatter_deferred_a", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_publisher_t publisher_b = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &publisher_b, this->node_ptr, ts, "chatter_deferred_b", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_fini_deferred(&publisher_a, this->node_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_fini_deferred(&publisher_b, this->node_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_reclaim(this->context_ptr, &number_reclaimed);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2u, number_reclaimed);
+  // The queue is empty again, and the count output is optional.
+  ret = rcl_context_reclaim(this->context_ptr, nullptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_reclaim(this->context_ptr, &number_reclaimed);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_reclaimed);
+  // Handles never reclaimed explicitly are drained during context cleanup.
+  rcl_publisher_t publisher_c = rcl_get_zero_initialized_publisher();
+  ret = rcl_publisher_init(
+    &publisher_c, this->node_ptr, ts, "chatter_deferred_c", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_fini_deferred(&publisher_c, this->node_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_reclaim(this->context_ptr, &number_reclaimed);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, number_reclaimed);
+}
+
+/* Test publishing through the persistent serialization buffer.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publish_as_serialized) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic_name = "chatter_serialized";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  EXPECT_EQ(0u, publisher_options.max_serialized_size);
+  // Primitives is bounded; presize the serialization buffer generously.
+  publisher_options.max_serialized_size = 1024;
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  test_msgs__msg__Primitives msg;
+  test_msgs__msg__Primitives__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__Primitives__fini(&msg);
+  });
+  msg.int64_value = 42;
+  ret = rcl_publish_as_serialized_message(&publisher, &msg);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // The buffer is reused across calls.
+  msg.int64_value = 43;
+  ret = rcl_publish_as_serialized_message(&publisher, &msg);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A null message is rejected.
+  ret = rcl_publish_as_serialized_message(&publisher, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Test publishing a serialized message given as fragments.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publish_serialized_fragments) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic_name = "chatter_fragments";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.max_serialized_size = 1024;
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // serialize a message to get a valid byte stream to fragment
+  test_msgs__msg__Primitives msg;
+  test_msgs__msg__Primitives__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__Primitives__fini(&msg);
+  });
+  msg.int64_value = 42;
+  rcl_serialized_message_t serialized = rcutils_get_zero_initialized_uint8_array();
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ASSERT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_init(&serialized, 1024, &allocator));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCUTILS_RET_OK, rcutils_uint8_array_fini(&serialized));
+  });
+  ASSERT_EQ(RMW_RET_OK, rmw_serialize(&msg, ts, &serialized));
+  ASSERT_GT(serialized.buffer_length, 1u);
+
+  // a single fragment is published without a copy
+  rcl_serialized_message_fragment_t whole = {serialized.buffer, serialized.buffer_length};
+  ret = rcl_publish_serialized_message_fragments(&publisher, &whole, 1);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // multiple fragments are gathered into the publisher's buffer
+  size_t split = serialized.buffer_length / 2;
+  rcl_serialized_message_fragment_t parts[2] = {
+    {serialized.buffer, split},
+    {serialized.buffer + split, serialized.buffer_length - split},
+  };
+  ret = rcl_publish_serialized_message_fragments(&publisher, parts, 2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // invalid arguments are rejected
+  ret = rcl_publish_serialized_message_fragments(&publisher, nullptr, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_publish_serialized_message_fragments(&publisher, &whole, 0);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  rcl_serialized_message_fragment_t bad = {nullptr, 8};
+  ret = rcl_publish_serialized_message_fragments(&publisher, &bad, 1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Test publishing one message per member through a publisher bundle.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_bundle) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_publisher_t publishers[3];
+  const char * topic_names[3] = {"bundle_a", "bundle_b", "bundle_c"};
+  for (size_t i = 0; i < 3; ++i) {
+    publishers[i] = rcl_get_zero_initialized_publisher();
+    ret = rcl_publisher_init(
+      &publishers[i], this->node_ptr, ts, topic_names[i], &publisher_options);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    for (size_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publishers[i], this->node_ptr)) <<
+        rcl_get_error_string().str;
+    }
+  });
+  const rcl_publisher_t * publisher_ptrs[3] = {
+    &publishers[0], &publishers[1], &publishers[2]};
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  // An empty bundle is rejected.
+  rcl_publisher_bundle_t bundle = rcl_get_zero_initialized_publisher_bundle();
+  ret = rcl_publisher_bundle_init(&bundle, publisher_ptrs, 0, &allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // A bundle containing an invalid publisher is rejected.
+  rcl_publisher_t invalid_publisher = rcl_get_zero_initialized_publisher();
+  const rcl_publisher_t * bad_ptrs[2] = {&publishers[0], &invalid_publisher};
+  ret = rcl_publisher_bundle_init(&bundle, bad_ptrs, 2, &allocator);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+
+  ret = rcl_publisher_bundle_init(&bundle, publisher_ptrs, 3, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Initializing twice is rejected.
+  ret = rcl_publisher_bundle_init(&bundle, publisher_ptrs, 3, &allocator);
+  EXPECT_EQ(RCL_RET_ALREADY_INIT, ret);
+  rcl_reset_error();
+
+  test_msgs__msg__Primitives msgs[3];
+  const void * msg_ptrs[3];
+  for (size_t i = 0; i < 3; ++i) {
+    test_msgs__msg__Primitives__init(&msgs[i]);
+    msgs[i].int64_value = static_cast<int64_t>(i);
+    msg_ptrs[i] = &msgs[i];
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    for (size_t i = 0; i < 3; ++i) {
+      test_msgs__msg__Primitives__fini(&msgs[i]);
+    }
+  });
+  ret = rcl_publish_bundle(&bundle, msg_ptrs);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A null message for any member is rejected.
+  msg_ptrs[1] = nullptr;
+  ret = rcl_publish_bundle(&bundle, msg_ptrs);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_publisher_bundle_fini(&bundle);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Finalizing a zero-initialized bundle is a no-op.
+  ret = rcl_publisher_bundle_fini(&bundle);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Test the loaned message API surface; the middleware in use reports
+ * loaning as unsupported.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_loaned_message) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic_name = "chatter_loan";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  if (!rcl_publisher_can_loan_messages(&publisher)) {
+    void * loaned_message = nullptr;
+    ret = rcl_borrow_loaned_message(&publisher, ts, &loaned_message);
+    EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+    rcl_reset_error();
+  }
+  // Invalid publishers are rejected before the support check.
+  void * loaned_message = nullptr;
+  ret = rcl_borrow_loaned_message(nullptr, ts, &loaned_message);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_publisher_can_loan_messages(nullptr));
+  rcl_reset_error();
+}
+
+/* Test waiting for acknowledgments of published messages.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_wait_for_all_acked) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.qos.reliability = RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, "chatter_acked", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // A best effort publisher has no acknowledgments to wait for.
+  ret = rcl_publisher_wait_for_all_acked(&publisher, 0);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // The asynchronous variant fires the guard condition before returning.
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, this->context_ptr, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_guard_condition_fini(&guard_condition);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_publisher_notify_on_all_acked(&publisher, &guard_condition);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A reliable publisher with no matched subscriptions is also fully acked.
+  rcl_publisher_t reliable_publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t reliable_options = rcl_publisher_get_default_options();
+  reliable_options.qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+  ret = rcl_publisher_init(
+    &reliable_publisher, this->node_ptr, ts, "chatter_acked_reliable", &reliable_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&reliable_publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  size_t subscription_count = 42;
+  ret = rcl_publisher_get_subscription_count(&reliable_publisher, &subscription_count);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  if (0 == subscription_count) {
+    ret = rcl_publisher_wait_for_all_acked(&reliable_publisher, 0);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  // Invalid arguments are rejected.
+  ret = rcl_publisher_wait_for_all_acked(nullptr, 0);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_publisher_notify_on_all_acked(nullptr, &guard_condition);
+  EXPECT_EQ(RCL_RET_PUBLISHER_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_publisher_notify_on_all_acked(&publisher, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+/* Test the preallocated message pool configured through publisher options.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_message_pool) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic_name = "chatter_pool";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.message_pool_size = 2;
+  publisher_options.message_pool_message_bound = sizeof(test_msgs__msg__Primitives);
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic_name, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // Acquire, use, and release pool slots without touching the allocator.
+  void * first = nullptr;
+  void * second = nullptr;
+  ret = rcl_publisher_acquire_pool_message(&publisher, &first);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_acquire_pool_message(&publisher, &second);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(first, second);
+  // The pool is exhausted at its configured size.
+  void * third = nullptr;
+  ret = rcl_publisher_acquire_pool_message(&publisher, &third);
+  EXPECT_EQ(RCL_RET_BAD_ALLOC, ret);
+  rcl_reset_error();
+  // Publishing from a pool slot works like any other message.
+  auto * msg = static_cast<test_msgs__msg__Primitives *>(first);
+  test_msgs__msg__Primitives__init(msg);
+  msg->int64_value = 42;
+  ret = rcl_publish(&publisher, msg);
+  test_msgs__msg__Primitives__fini(msg);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Released slots can be acquired again.
+  ret = rcl_publisher_release_pool_message(&publisher, first);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_release_pool_message(&publisher, second);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_acquire_pool_message(&publisher, &third);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_publisher_release_pool_message(&publisher, third);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A publisher without a pool reports unsupported.
+  rcl_publisher_t plain_publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t plain_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&plain_publisher, this->node_ptr, ts, "chatter_no_pool", &plain_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&plain_publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_publisher_acquire_pool_message(&plain_publisher, &third);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+}
+
+/* Test the opt-in publisher statistics.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_publisher_statistics) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.enable_statistics = true;
+  ret = rcl_publisher_init(
+    &publisher, this->node_ptr, ts, "chatter_statistics", &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_statistics_t statistics;
+  ret = rcl_publisher_get_statistics(&publisher, &statistics);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, statistics.succeeded_count);
+  EXPECT_EQ(0u, statistics.failed_count);
+  EXPECT_EQ(0, statistics.last_activity_time);
+
+  test_msgs__msg__Primitives msg;
+  test_msgs__msg__Primitives__init(&msg);
+  msg.int64_value = 42;
+  ret = rcl_publish(&publisher, &msg);
+  test_msgs__msg__Primitives__fini(&msg);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ret = rcl_publisher_get_statistics(&publisher, &statistics);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, statistics.succeeded_count);
+  EXPECT_EQ(0u, statistics.failed_count);
+  EXPECT_NE(0, statistics.last_activity_time);
+
+  // A publisher that did not opt in has no statistics to report.
+  rcl_publisher_t plain_publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t plain_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(
+    &plain_publisher, this->node_ptr, ts, "chatter_statistics_plain", &plain_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&plain_publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_publisher_get_statistics(&plain_publisher, &statistics);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+}
+
+/* Test creating a batch of entities on one node with rcl_node_create_entities.
+ */
+TEST_F(CLASSNAME(TestPublisherFixture, RMW_IMPLEMENTATION), test_create_entities) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_t second_publisher = rcl_get_zero_initialized_publisher();
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  rcl_entity_spec_t specs[3];
+  specs[0].kind = RCL_ENTITY_KIND_PUBLISHER;
+  specs[0].type_support = ts;
+  specs[0].topic_name = "batch_chatter";
+  specs[0].publisher_options = &publisher_options;
+  specs[0].publisher = &publisher;
+  specs[1].kind = RCL_ENTITY_KIND_SUBSCRIPTION;
+  specs[1].type_support = ts;
+  specs[1].topic_name = "batch_chatter";
+  specs[1].subscription_options = &subscription_options;
+  specs[1].subscription = &subscription;
+  specs[2].kind = RCL_ENTITY_KIND_PUBLISHER;
+  specs[2].type_support = ts;
+  specs[2].topic_name = "batch_chatter_other";
+  specs[2].publisher_options = &publisher_options;
+  specs[2].publisher = &second_publisher;
+  ret = rcl_node_create_entities(this->node_ptr, specs, 3);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&publisher, this->node_ptr)) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_subscription_fini(&subscription, this->node_ptr)) <<
+      rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_publisher_fini(&second_publisher, this->node_ptr)) <<
+      rcl_get_error_string().str;
+  });
+  EXPECT_TRUE(rcl_publisher_is_valid(&publisher));
+  EXPECT_TRUE(rcl_subscription_is_valid(&subscription));
+  EXPECT_TRUE(rcl_publisher_is_valid(&second_publisher));
+  EXPECT_EQ(strcmp(rcl_publisher_get_topic_name(&publisher), "/batch_chatter"), 0);
+
+  // invalid arguments are rejected before anything is created
+  ret = rcl_node_create_entities(nullptr, specs, 3);
+  EXPECT_EQ(RCL_RET_NODE_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_node_create_entities(this->node_ptr, nullptr, 3);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // a failing entity unwinds the ones created before it
+  rcl_publisher_t unwound_publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_t failing_publisher = rcl_get_zero_initialized_publisher();
+  rcl_entity_spec_t failing_specs[2];
+  failing_specs[0].kind = RCL_ENTITY_KIND_PUBLISHER;
+  failing_specs[0].type_support = ts;
+  failing_specs[0].topic_name = "batch_unwound";
+  failing_specs[0].publisher_options = &publisher_options;
+  failing_specs[0].publisher = &unwound_publisher;
+  failing_specs[1].kind = RCL_ENTITY_KIND_PUBLISHER;
+  failing_specs[1].type_support = ts;
+  failing_specs[1].topic_name = "invalid topic name";
+  failing_specs[1].publisher_options = &publisher_options;
+  failing_specs[1].publisher = &failing_publisher;
+  ret = rcl_node_create_entities(this->node_ptr, failing_specs, 2);
+  EXPECT_NE(RCL_RET_OK, ret);
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_publisher_is_valid(&unwound_publisher));
+  rcl_reset_error();
+  EXPECT_FALSE(rcl_publisher_is_valid(&failing_publisher));
+  rcl_reset_error();
+}
@@ -213,3 +213,157 @@ TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_nominal)
   EXPECT_EQ(client_response.uint64_value, 3ULL);
   EXPECT_EQ(header.sequence_number, 1);
 }
+
+/* Test batched taking of requests and sending of responses.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_batch) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+  const char * topic = "primitives_batch";
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, topic, &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, topic, &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+
+  // Send two requests before the service looks at its queue.
+  test_msgs__srv__Primitives_Request client_request;
+  test_msgs__srv__Primitives_Request__init(&client_request);
+  client_request.uint8_value = 1;
+  client_request.uint32_value = 2;
+  int64_t sequence_number;
+  ret = rcl_send_request(&client, &client_request, &sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  client_request.uint32_value = 3;
+  ret = rcl_send_request(&client, &client_request, &sequence_number);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  test_msgs__srv__Primitives_Request__fini(&client_request);
+
+  bool success;
+  wait_for_service_to_be_ready(&service, 10, 100, success);
+  ASSERT_TRUE(success);
+
+  {
+    // Drain both requests in one call; capacity is one larger than what is
+    // pending to check that falling short of capacity is not an error.
+    test_msgs__srv__Primitives_Request service_requests[3];
+    void * request_ptrs[3];
+    rmw_request_id_t headers[3];
+    for (size_t i = 0; i < 3; ++i) {
+      test_msgs__srv__Primitives_Request__init(&service_requests[i]);
+      request_ptrs[i] = &service_requests[i];
+    }
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      for (size_t i = 0; i < 3; ++i) {
+        test_msgs__srv__Primitives_Request__fini(&service_requests[i]);
+      }
+    });
+    size_t taken = 0;
+    do {
+      ret = rcl_take_request_batch(&service, headers, request_ptrs, 3, &taken);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+      if (taken < 2) {
+        wait_for_service_to_be_ready(&service, 10, 100, success);
+        ASSERT_TRUE(success);
+      }
+    } while (taken < 2);
+    EXPECT_EQ(2u, taken);
+    EXPECT_EQ(2UL, service_requests[0].uint32_value);
+    EXPECT_EQ(3UL, service_requests[1].uint32_value);
+
+    // Answer both in one call.
+    test_msgs__srv__Primitives_Response service_responses[2];
+    void * response_ptrs[2];
+    for (size_t i = 0; i < 2; ++i) {
+      test_msgs__srv__Primitives_Response__init(&service_responses[i]);
+      service_responses[i].uint64_value =
+        service_requests[i].uint8_value + service_requests[i].uint32_value;
+      response_ptrs[i] = &service_responses[i];
+    }
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      for (size_t i = 0; i < 2; ++i) {
+        test_msgs__srv__Primitives_Response__fini(&service_responses[i]);
+      }
+    });
+    ret = rcl_send_response_batch(&service, headers, response_ptrs, 2);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  // Both responses arrive at the client.
+  for (uint64_t expected : {3ULL, 4ULL}) {
+    test_msgs__srv__Primitives_Response client_response;
+    test_msgs__srv__Primitives_Response__init(&client_response);
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      test_msgs__srv__Primitives_Response__fini(&client_response);
+    });
+    rmw_request_id_t header;
+    do {
+      ret = rcl_take_response(&client, &header, &client_response);
+    } while (RCL_RET_CLIENT_TAKE_FAILED == ret &&
+      (std::this_thread::sleep_for(std::chrono::milliseconds(100)), true));
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(expected, client_response.uint64_value);
+  }
+}
+
+/* Test the serialized service entry points.
+ *
+ * The rmw interface in use has no serialized service support, so these are
+ * expected to fail with RCL_RET_UNSUPPORTED after validating their arguments.
+ */
+TEST_F(CLASSNAME(TestServiceFixture, RMW_IMPLEMENTATION), test_service_serialized) {
+  rcl_ret_t ret;
+  const rosidl_service_type_support_t * ts = ROSIDL_GET_SRV_TYPE_SUPPORT(
+    test_msgs, srv, Primitives);
+
+  rcl_service_t service = rcl_get_zero_initialized_service();
+  rcl_service_options_t service_options = rcl_service_get_default_options();
+  ret = rcl_service_init(&service, this->node_ptr, ts, "primitives_serialized", &service_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_service_fini(&service, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_client_t client = rcl_get_zero_initialized_client();
+  rcl_client_options_t client_options = rcl_client_get_default_options();
+  ret = rcl_client_init(&client, this->node_ptr, ts, "primitives_serialized", &client_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_client_fini(&client, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
+  rmw_request_id_t header;
+  int64_t sequence_number = 0;
+
+  ret = rcl_take_request_serialized(&service, &header, &serialized_msg);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  ret = rcl_send_response_serialized(&service, &header, &serialized_msg);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  ret = rcl_send_request_serialized(&client, &serialized_msg, &sequence_number);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  ret = rcl_take_response_serialized(&client, &header, &serialized_msg);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+}
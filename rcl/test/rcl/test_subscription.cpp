@@ -17,6 +17,7 @@
 #include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "rcl/subscription.h"
 
@@ -230,3 +231,554 @@ TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription
     ASSERT_EQ(std::string(test_string), std::string(msg.string_value.data, msg.string_value.size));
   }
 }
+
+/* Test the serialized buffer recycling helpers.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_serialized_buffer_reuse) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "test_serialized_buffer_reuse";
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // Nothing taken yet, no suggestion.
+  EXPECT_EQ(0u, rcl_subscription_get_suggested_buffer_size(&subscription));
+  // Invalid arguments are rejected.
+  rcl_serialized_message_t * serialized_message = nullptr;
+  ret = rcl_subscription_acquire_serialized_message(nullptr, &serialized_message);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_subscription_acquire_serialized_message(&subscription, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // Acquire, release, and re-acquire: the same buffer comes back.
+  ret = rcl_subscription_acquire_serialized_message(&subscription, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_NE(nullptr, serialized_message);
+  EXPECT_EQ(0u, serialized_message->buffer_length);
+  ret = rcl_subscription_release_serialized_message(&subscription, serialized_message);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_serialized_message_t * second_serialized_message = nullptr;
+  ret = rcl_subscription_acquire_serialized_message(&subscription, &second_serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(serialized_message, second_serialized_message);
+  // Two buffers can be out at once; both are recycled by fini.
+  ret = rcl_subscription_acquire_serialized_message(&subscription, &serialized_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(serialized_message, second_serialized_message);
+  ret = rcl_subscription_release_serialized_message(&subscription, serialized_message);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_subscription_release_serialized_message(&subscription, second_serialized_message);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+/* Basic test for setting and clearing the on new message callback.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_on_new_message_callback) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "test_on_new_message_callback";
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  rcl_ret_t ret =
+    rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  auto callback = [](const void * /* user_data */, size_t /* number_of_events */) {};
+  ret = rcl_subscription_set_on_new_message_callback(&subscription, callback, nullptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_subscription_set_on_new_message_callback(&subscription, nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // An invalid subscription is rejected.
+  ret = rcl_subscription_set_on_new_message_callback(nullptr, callback, nullptr);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+}
+
+/* Test taking a batch of messages with rcl_take_batch.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_take_batch) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "rcl_test_subscription_take_batch";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // TODO(wjwwood): add logic to wait for the connection to be established
+  //                probably using the count_subscriptions busy wait mechanism
+  //                until then we will sleep for a short period of time
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  for (int64_t i = 0; i < 3; ++i) {
+    test_msgs__msg__Primitives msg;
+    test_msgs__msg__Primitives__init(&msg);
+    msg.int64_value = i;
+    ret = rcl_publish(&publisher, &msg);
+    test_msgs__msg__Primitives__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  bool success;
+  wait_for_subscription_to_be_ready(&subscription, 10, 100, success);
+  ASSERT_TRUE(success);
+  {
+    test_msgs__msg__Primitives msgs[4];
+    void * msg_ptrs[4];
+    for (size_t i = 0; i < 4; ++i) {
+      test_msgs__msg__Primitives__init(&msgs[i]);
+      msg_ptrs[i] = &msgs[i];
+    }
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      for (size_t i = 0; i < 4; ++i) {
+        test_msgs__msg__Primitives__fini(&msgs[i]);
+      }
+    });
+    size_t taken = 0;
+    ret = rcl_take_batch(&subscription, msg_ptrs, 4, &taken, nullptr);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ASSERT_EQ(3u, taken);
+    for (int64_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(i, msgs[i].int64_value);
+    }
+    // Nothing left to take.
+    ret = rcl_take_batch(&subscription, msg_ptrs, 4, &taken, nullptr);
+    EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+    EXPECT_EQ(0u, taken);
+    rcl_reset_error();
+  }
+}
+
+// Appends the int64_value of each drained message to the context vector.
+static bool
+collect_int64_values(const void * ros_message, const rmw_message_info_t *, void * context)
+{
+  const test_msgs__msg__Primitives * msg =
+    static_cast<const test_msgs__msg__Primitives *>(ros_message);
+  static_cast<std::vector<int64_t> *>(context)->push_back(msg->int64_value);
+  return true;
+}
+
+// Collects like collect_int64_values but stops the drain after one message.
+static bool
+collect_one_int64_value(const void * ros_message, const rmw_message_info_t * info, void * context)
+{
+  collect_int64_values(ros_message, info, context);
+  return false;
+}
+
+/* Test draining messages through a callback with rcl_subscription_drain.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_drain) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "rcl_test_subscription_drain";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // TODO(wjwwood): add logic to wait for the connection to be established
+  //                probably using the count_subscriptions busy wait mechanism
+  //                until then we will sleep for a short period of time
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  for (int64_t i = 0; i < 5; ++i) {
+    test_msgs__msg__Primitives msg;
+    test_msgs__msg__Primitives__init(&msg);
+    msg.int64_value = i;
+    ret = rcl_publish(&publisher, &msg);
+    test_msgs__msg__Primitives__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  bool success;
+  wait_for_subscription_to_be_ready(&subscription, 10, 100, success);
+  ASSERT_TRUE(success);
+  test_msgs__msg__Primitives scratch;
+  test_msgs__msg__Primitives__init(&scratch);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__Primitives__fini(&scratch);
+  });
+  std::vector<int64_t> values;
+  size_t taken = 0;
+  // Bounded drain takes only max_messages and leaves the rest queued.
+  ret = rcl_subscription_drain(
+    &subscription, &scratch, nullptr, 2, collect_int64_values, &values, &taken);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(2u, taken);
+  // A callback returning false stops the drain early.
+  ret = rcl_subscription_drain(
+    &subscription, &scratch, nullptr, 0, collect_one_int64_value, &values, &taken);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, taken);
+  // An unbounded drain empties the queue.
+  ret = rcl_subscription_drain(
+    &subscription, &scratch, nullptr, 0, collect_int64_values, &values, &taken);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(2u, taken);
+  ASSERT_EQ(5u, values.size());
+  for (int64_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, values[i]);
+  }
+  // Nothing left to take.
+  ret = rcl_subscription_drain(
+    &subscription, &scratch, nullptr, 0, collect_int64_values, &values, &taken);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+  EXPECT_EQ(0u, taken);
+  rcl_reset_error();
+  // Invalid arguments are rejected.
+  ret = rcl_subscription_drain(
+    nullptr, &scratch, nullptr, 0, collect_int64_values, &values, &taken);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_INVALID, ret);
+  rcl_reset_error();
+  ret = rcl_subscription_drain(
+    &subscription, nullptr, nullptr, 0, collect_int64_values, &values, &taken);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_subscription_drain(
+    &subscription, &scratch, nullptr, 0, nullptr, &values, &taken);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+// Accepts messages whose int64_value is divisible by the context value.
+static bool
+divisible_int64_filter(const void * ros_message, void * context)
+{
+  const test_msgs__msg__Primitives * msg =
+    static_cast<const test_msgs__msg__Primitives *>(ros_message);
+  return 0 == (msg->int64_value % *static_cast<int64_t *>(context));
+}
+
+/* Test that a content filter set in the options drops messages inside take.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_content_filter) {
+  rcl_ret_t ret;
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "rcl_test_subscription_content_filter";
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  int64_t divisor = 2;
+  subscription_options.content_filter = divisible_int64_filter;
+  subscription_options.content_filter_context = &divisor;
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // TODO(wjwwood): add logic to wait for the connection to be established
+  //                probably using the count_subscriptions busy wait mechanism
+  //                until then we will sleep for a short period of time
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  for (int64_t i = 0; i < 5; ++i) {
+    test_msgs__msg__Primitives msg;
+    test_msgs__msg__Primitives__init(&msg);
+    msg.int64_value = i;
+    ret = rcl_publish(&publisher, &msg);
+    test_msgs__msg__Primitives__fini(&msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  bool success;
+  wait_for_subscription_to_be_ready(&subscription, 10, 100, success);
+  ASSERT_TRUE(success);
+  {
+    // Only the even values 0, 2 and 4 pass the filter.
+    test_msgs__msg__Primitives msgs[5];
+    void * msg_ptrs[5];
+    for (size_t i = 0; i < 5; ++i) {
+      test_msgs__msg__Primitives__init(&msgs[i]);
+      msg_ptrs[i] = &msgs[i];
+    }
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      for (size_t i = 0; i < 5; ++i) {
+        test_msgs__msg__Primitives__fini(&msgs[i]);
+      }
+    });
+    size_t taken = 0;
+    ret = rcl_take_batch(&subscription, msg_ptrs, 5, &taken, nullptr);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ASSERT_EQ(3u, taken);
+    for (int64_t i = 0; i < 3; ++i) {
+      EXPECT_EQ(2 * i, msgs[i].int64_value);
+    }
+    // The rejected messages were consumed, not left queued.
+    ret = rcl_take_batch(&subscription, msg_ptrs, 5, &taken, nullptr);
+    EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+    EXPECT_EQ(0u, taken);
+    rcl_reset_error();
+  }
+}
+
+/* Test the intra-process fast path between a publisher and subscription.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_intra_process) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "rcl_test_subscription_intra_process";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  publisher_options.use_intra_process = true;
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.use_intra_process = true;
+  subscription_options.ignore_local_publications = true;
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // The guard condition is available for wait sets.
+  const rcl_guard_condition_t * guard_condition =
+    rcl_subscription_get_intra_process_guard_condition(&subscription);
+  ASSERT_NE(nullptr, guard_condition) << rcl_get_error_string().str;
+
+  // Nothing pending yet.
+  const void * taken_message = nullptr;
+  ret = rcl_take_intra_process(&subscription, &taken_message);
+  EXPECT_EQ(RCL_RET_SUBSCRIPTION_TAKE_FAILED, ret);
+
+  // The published pointer is moved through, not copied.
+  test_msgs__msg__Primitives msg;
+  test_msgs__msg__Primitives__init(&msg);
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    test_msgs__msg__Primitives__fini(&msg);
+  });
+  msg.int64_value = 42;
+  ret = rcl_publish(&publisher, &msg);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_take_intra_process(&subscription, &taken_message);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(static_cast<const void *>(&msg), taken_message);
+
+  // A subscription without the option reports unsupported.
+  rcl_subscription_t plain_subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t plain_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&plain_subscription, this->node_ptr, ts, topic, &plain_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&plain_subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_take_intra_process(&plain_subscription, &taken_message);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret);
+  rcl_reset_error();
+  EXPECT_EQ(nullptr, rcl_subscription_get_intra_process_guard_condition(&plain_subscription));
+  rcl_reset_error();
+}
+
+/* Test that the subscription priority orders the ready entity list.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_priority) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "/chatter_test_subscription_priority";
+  rcl_publisher_t publisher = rcl_get_zero_initialized_publisher();
+  rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
+  ret = rcl_publisher_init(&publisher, this->node_ptr, ts, topic, &publisher_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_publisher_fini(&publisher, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // The low priority subscription is added to the wait set first, so without
+  // the priority ordering it would also come out of the ready list first.
+  rcl_subscription_t subscription_low = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&subscription_low, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription_low, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_subscription_t subscription_high = rcl_get_zero_initialized_subscription();
+  subscription_options.priority = 7;
+  ret = rcl_subscription_init(&subscription_high, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription_high, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // TODO(wjwwood): add logic to wait for the connection to be established
+  std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+  {
+    test_msgs__msg__Primitives msg;
+    test_msgs__msg__Primitives__init(&msg);
+    msg.int64_value = 42;
+    OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+      test_msgs__msg__Primitives__fini(&msg);
+    });
+    ret = rcl_publish(&publisher, &msg);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 2, 0, 0, 0, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  // Wait until the message has arrived at both subscriptions.
+  const rcl_ready_entity_t * ready_entities = nullptr;
+  size_t number_of_ready_entities = 0u;
+  for (size_t i = 0; i < 100 && number_of_ready_entities != 2u; ++i) {
+    ret = rcl_wait_set_clear(&wait_set);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_add_subscription(&wait_set, &subscription_low, NULL);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_add_subscription(&wait_set, &subscription_high, NULL);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+    if (RCL_RET_TIMEOUT == ret) {
+      continue;
+    }
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_get_ready_entities(&wait_set, &ready_entities, &number_of_ready_entities);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  ASSERT_EQ(2u, number_of_ready_entities);
+  // The high priority subscription sits at index 1 but is reported first.
+  EXPECT_EQ(RCL_WAIT_SET_SUBSCRIPTION, ready_entities[0].type);
+  EXPECT_EQ(1u, ready_entities[0].index);
+  EXPECT_EQ(7u, ready_entities[0].priority);
+  EXPECT_EQ(RCL_WAIT_SET_SUBSCRIPTION, ready_entities[1].type);
+  EXPECT_EQ(0u, ready_entities[1].index);
+  EXPECT_EQ(0u, ready_entities[1].priority);
+}
+
+/* Test the deadline event bound to a subscription waking a wait set.
+ */
+TEST_F(CLASSNAME(TestSubscriptionFixture, RMW_IMPLEMENTATION), test_subscription_deadline_event) {
+  rcl_ret_t ret;
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Primitives);
+  const char * topic = "/chatter_test_subscription_deadline_event";
+  rcl_subscription_t subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t subscription_options = rcl_subscription_get_default_options();
+  subscription_options.enable_statistics = true;
+  ret = rcl_subscription_init(&subscription, this->node_ptr, ts, topic, &subscription_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // A deadline of zero is rejected.
+  rcl_event_t event = rcl_get_zero_initialized_event();
+  rcl_event_options_t event_options = rcl_event_get_default_options();
+  ret = rcl_event_init_for_subscription(&event, &subscription, event_options);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // A subscription without statistics cannot back an event.
+  rcl_subscription_t plain_subscription = rcl_get_zero_initialized_subscription();
+  rcl_subscription_options_t plain_options = rcl_subscription_get_default_options();
+  ret = rcl_subscription_init(&plain_subscription, this->node_ptr, ts, topic, &plain_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_subscription_fini(&plain_subscription, this->node_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  event_options.deadline = RCL_MS_TO_NS(200);
+  ret = rcl_event_init_for_subscription(&event, &plain_subscription, event_options);
+  EXPECT_EQ(RCL_RET_UNSUPPORTED, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_event_init_for_subscription(&event, &subscription, event_options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_event_fini(&event);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Immediately after init nothing is missed yet.
+  rcl_event_status_t status;
+  ret = rcl_event_take(&event, &status);
+  EXPECT_EQ(RCL_RET_EVENT_TAKE_FAILED, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Event capacity comes out of the guard condition sizing.
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  size_t event_index = 42;
+  ret = rcl_wait_set_add_event(&wait_set, &event, &event_index);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, event_index);
+
+  // With no traffic on the topic the wait wakes on the deadline, well before
+  // the ten second timeout, and reports the event ready.
+  ret = rcl_wait(&wait_set, RCL_S_TO_NS(10));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  const rcl_ready_entity_t * ready_entities = nullptr;
+  size_t number_of_ready_entities = 0u;
+  ret = rcl_wait_set_get_ready_entities(&wait_set, &ready_entities, &number_of_ready_entities);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_of_ready_entities);
+  EXPECT_EQ(RCL_WAIT_SET_EVENT, ready_entities[0].type);
+  EXPECT_EQ(0u, ready_entities[0].index);
+
+  // Taking the miss fills the status and re-arms the event.
+  ret = rcl_event_take(&event, &status);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, status.total_count);
+  EXPECT_GE(status.time_since_last_activity, event_options.deadline);
+  ret = rcl_event_take(&event, &status);
+  EXPECT_EQ(RCL_RET_EVENT_TAKE_FAILED, ret) << rcl_get_error_string().str;
+  rcl_reset_error();
+}
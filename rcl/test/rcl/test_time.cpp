@@ -248,6 +248,113 @@ TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), default_clock_instanciation) {
   ASSERT_TRUE(rcl_clock_valid(system_clock));
 }
 
+TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), fast_steady_clock) {
+  rcl_clock_t fast_clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t retval = rcl_steady_clock_init_fast(&fast_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_steady_clock_fini(&fast_clock)) << rcl_get_error_string().str;
+  });
+  ASSERT_TRUE(rcl_clock_valid(&fast_clock));
+  EXPECT_EQ(fast_clock.type, RCL_STEADY_TIME) <<
+    "Expected time source of type RCL_STEADY_TIME";
+
+  // Reads are monotonic and track the regular steady clock.
+  rcl_clock_t steady_clock;
+  retval = rcl_steady_clock_init(&steady_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_steady_clock_fini(&steady_clock)) << rcl_get_error_string().str;
+  });
+  rcl_time_point_value_t previous = 0;
+  for (int i = 0; i < 1000; ++i) {
+    rcl_time_point_value_t now = 0;
+    retval = rcl_clock_get_now(&fast_clock, &now);
+    ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+    EXPECT_GE(now, previous);
+    previous = now;
+  }
+  rcl_time_point_value_t reference = 0;
+  retval = rcl_clock_get_now(&steady_clock, &reference);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_time_point_value_t now = 0;
+  retval = rcl_clock_get_now(&fast_clock, &now);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  // generous bound; the backends should agree within milliseconds
+  EXPECT_LT(llabs(static_cast<long long>(now - reference)), RCL_MS_TO_NS(100));
+}
+
+TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), clock_get_now_fast) {
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_time_point_value_t now = 0;
+
+  // Invalid arguments fall through to the regular dispatch and its checks.
+  rcl_ret_t retval = rcl_clock_get_now_fast(nullptr, &now);
+  EXPECT_EQ(retval, RCL_RET_INVALID_ARGUMENT) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Plain steady clock takes the devirtualized path.
+  rcl_clock_t steady_clock;
+  retval = rcl_steady_clock_init(&steady_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_steady_clock_fini(&steady_clock)) << rcl_get_error_string().str;
+  });
+  rcl_time_point_value_t reference = 0;
+  retval = rcl_clock_get_now(&steady_clock, &reference);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  retval = rcl_clock_get_now_fast(&steady_clock, &now);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_GE(now, reference);
+  EXPECT_LT(llabs(static_cast<long long>(now - reference)), RCL_MS_TO_NS(100));
+
+  // A ROS clock keeps going through its registered get_now, so an override
+  // set on it is still observed.
+  rcl_clock_t ros_clock;
+  retval = rcl_ros_clock_init(&ros_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_ros_clock_fini(&ros_clock)) << rcl_get_error_string().str;
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(&ros_clock)) << rcl_get_error_string().str;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(&ros_clock, RCL_S_TO_NS(42))) <<
+    rcl_get_error_string().str;
+  retval = rcl_clock_get_now_fast(&ros_clock, &now);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_S_TO_NS(42), now);
+}
+
+TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), coarse_system_clock) {
+  rcl_clock_t coarse_clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_ret_t retval = rcl_system_clock_init_coarse(&coarse_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_system_clock_fini(&coarse_clock)) << rcl_get_error_string().str;
+  });
+  ASSERT_TRUE(rcl_clock_valid(&coarse_clock));
+  EXPECT_EQ(coarse_clock.type, RCL_SYSTEM_TIME) <<
+    "Expected time source of type RCL_SYSTEM_TIME";
+
+  rcl_clock_t system_clock;
+  retval = rcl_system_clock_init(&system_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_system_clock_fini(&system_clock)) << rcl_get_error_string().str;
+  });
+  rcl_time_point_value_t reference = 0;
+  retval = rcl_clock_get_now(&system_clock, &reference);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_time_point_value_t now = 0;
+  retval = rcl_clock_get_now(&coarse_clock, &now);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_NE(0, now);
+  // the coarse clock only advances on scheduler ticks, so allow a wide margin
+  EXPECT_LT(llabs(static_cast<long long>(now - reference)), RCL_S_TO_NS(1));
+}
+
 TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), specific_clock_instantiation) {
   rcl_allocator_t allocator = rcl_get_default_allocator();
   {
@@ -379,6 +486,21 @@ TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), rcl_time_difference_signed) {
   }
 }
 
+// The inline arithmetic core agrees with the checked wrapper.
+TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), rcl_time_difference_inline) {
+  EXPECT_EQ(1000LL, rcl_difference_time_point_values(1000, 2000));
+  EXPECT_EQ(-1000LL, rcl_difference_time_point_values(2000, 1000));
+  EXPECT_EQ(0LL, rcl_difference_time_point_values(2000, 2000));
+  EXPECT_EQ(
+    2147483647LL,
+    rcl_difference_time_point_values(
+      RCL_S_TO_NS(1514423496LL), RCL_S_TO_NS(1514423498LL) + 147483647LL));
+  EXPECT_EQ(
+    -2147483647LL,
+    rcl_difference_time_point_values(
+      RCL_S_TO_NS(1514423498LL) + 147483647LL, RCL_S_TO_NS(1514423496LL)));
+}
+
 static bool pre_callback_called = false;
 static bool post_callback_called = false;
 
@@ -587,6 +709,95 @@ TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), rcl_time_backward_jump_callbacks)
   EXPECT_FALSE(post_callback_called);
 }
 
+TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), rcl_time_override_rate_limit) {
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t * ros_clock =
+    reinterpret_cast<rcl_clock_t *>(allocator.allocate(sizeof(rcl_clock_t), allocator.state));
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    allocator.deallocate(ros_clock, allocator.state);
+  });
+  rcl_ret_t retval = rcl_ros_clock_init(ros_clock, &allocator);
+  ASSERT_EQ(retval, RCL_RET_OK) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(ros_clock));
+  });
+  rcl_ret_t ret;
+  const rcl_time_point_value_t sec_1 = RCL_S_TO_NS(1);
+
+  // Invalid arguments are rejected.
+  ret = rcl_ros_clock_set_override_rate_limit(nullptr, RCL_S_TO_NS(600));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  {
+    rcl_clock_t steady_clock;
+    ASSERT_EQ(RCL_RET_OK, rcl_steady_clock_init(&steady_clock, &allocator));
+    EXPECT_EQ(RCL_RET_ERROR, rcl_ros_clock_set_override_rate_limit(&steady_clock, 0));
+    rcl_reset_error();
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&steady_clock));
+  }
+
+  // A window much longer than the test coalesces everything after the first
+  // applied update.
+  ASSERT_EQ(RCL_RET_OK, rcl_ros_clock_set_override_rate_limit(ros_clock, RCL_S_TO_NS(600))) <<
+    rcl_get_error_string().str;
+
+  rcl_time_jump_t time_jump;
+  rcl_jump_threshold_t threshold;
+  threshold.on_clock_change = false;
+  threshold.min_forward.nanoseconds = 1;
+  threshold.min_backward.nanoseconds = -1;
+  ASSERT_EQ(RCL_RET_OK,
+    rcl_clock_add_jump_callback(ros_clock, threshold, clock_callback, &time_jump)) <<
+    rcl_get_error_string().str;
+  reset_callback_triggers();
+
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(ros_clock)) << rcl_get_error_string().str;
+  // The first update is always fully applied.
+  ret = rcl_set_ros_time_override(ros_clock, sec_1);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_TRUE(pre_callback_called);
+  EXPECT_TRUE(post_callback_called);
+  reset_callback_triggers();
+
+  // Updates inside the window are coalesced: no jump callbacks, but reads
+  // still advance toward the newest value.
+  ret = rcl_set_ros_time_override(ros_clock, 2 * sec_1);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_FALSE(pre_callback_called);
+  EXPECT_FALSE(post_callback_called);
+  rcl_time_point_value_t query_now = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_get_now(ros_clock, &query_now)) << rcl_get_error_string().str;
+  EXPECT_GE(query_now, sec_1);
+  EXPECT_LE(query_now, 2 * sec_1);
+
+  ret = rcl_set_ros_time_override(ros_clock, 3 * sec_1);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_FALSE(pre_callback_called);
+  EXPECT_FALSE(post_callback_called);
+  rcl_time_point_value_t later_now = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_get_now(ros_clock, &later_now)) << rcl_get_error_string().str;
+  EXPECT_GE(later_now, query_now);
+  EXPECT_LE(later_now, 3 * sec_1);
+
+  // Backward jumps are never coalesced.
+  ret = rcl_set_ros_time_override(ros_clock, sec_1);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_TRUE(pre_callback_called);
+  EXPECT_TRUE(post_callback_called);
+  reset_callback_triggers();
+
+  // Disabling the limit restores per-update application.
+  ASSERT_EQ(RCL_RET_OK, rcl_ros_clock_set_override_rate_limit(ros_clock, 0)) <<
+    rcl_get_error_string().str;
+  ret = rcl_set_ros_time_override(ros_clock, 5 * sec_1);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_TRUE(pre_callback_called);
+  EXPECT_TRUE(post_callback_called);
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_get_now(ros_clock, &query_now)) << rcl_get_error_string().str;
+  EXPECT_EQ(5 * sec_1, query_now);
+  reset_callback_triggers();
+}
+
 TEST(CLASSNAME(rcl_time, RMW_IMPLEMENTATION), rcl_clock_add_jump_callback) {
   rcl_allocator_t allocator = rcl_get_default_allocator();
   rcl_clock_t * clock =
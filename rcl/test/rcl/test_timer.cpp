@@ -17,6 +17,7 @@
 #include <thread>
 
 #include "rcl/timer.h"
+#include "rcl/timer_service.h"
 
 #include "rcl/rcl.h"
 
@@ -493,3 +494,334 @@ TEST_F(TestTimerFixture, test_ros_time_wakes_wait) {
   EXPECT_TRUE(timer_was_ready);
   EXPECT_LT(finish - start, std::chrono::milliseconds(100));
 }
+
+TEST_F(TestTimerFixture, test_ros_time_inactive_uses_timeout) {
+  rcl_ret_t ret;
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ASSERT_EQ(RCL_RET_OK, rcl_clock_init(RCL_ROS_TIME, &clock, &allocator)) <<
+    rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_clock_fini(&clock)) << rcl_get_error_string().str;
+  });
+  // The override stays inactive, so the clock follows system time and the
+  // deadline must be reached through the wait timeout, not a jump callback.
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(50), nullptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer)) << rcl_get_error_string().str;
+  });
+
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 0, 1, 0, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  ASSERT_EQ(RCL_RET_OK, rcl_wait_set_add_timer(&wait_set, &timer, NULL)) <<
+    rcl_get_error_string().str;
+
+  auto start = std::chrono::steady_clock::now();
+  ret = rcl_wait(&wait_set, RCL_S_TO_NS(5));
+  auto finish = std::chrono::steady_clock::now();
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(nullptr, wait_set.timers[0]);
+  // The wait woke for the timer deadline, long before the 5 second cap.
+  EXPECT_LT(finish - start, std::chrono::seconds(1));
+}
+
+TEST_F(TestTimerFixture, test_timer_call_with_info) {
+  rcl_ret_t ret;
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_ROS_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(&clock)) << rcl_get_error_string().str;
+  const rcl_time_point_value_t start = RCL_S_TO_NS(1);
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(&clock, start)) << rcl_get_error_string().str;
+
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(100), nullptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_fini(&timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Sleep through two extra periods; one call catches the timer up and
+  // reports the overrun.
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(&clock, start + RCL_MS_TO_NS(350))) <<
+    rcl_get_error_string().str;
+  uint64_t missed_periods = 0;
+  ret = rcl_timer_call_with_info(&timer, &missed_periods);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(2u, missed_periods);
+  int64_t next_call_time = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_get_next_call_time(&timer, &next_call_time));
+  EXPECT_EQ(start + RCL_MS_TO_NS(400), next_call_time);
+
+  // A timer serviced on schedule reports no missed periods.
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(&clock, start + RCL_MS_TO_NS(400))) <<
+    rcl_get_error_string().str;
+  ret = rcl_timer_call_with_info(&timer, &missed_periods);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, missed_periods);
+}
+
+TEST_F(TestTimerFixture, test_timer_user_data) {
+  rcl_ret_t ret;
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // The callback reads its closure straight off the timer.
+  int call_count = 0;
+  auto callback = [](rcl_timer_t * timer, int64_t) {
+    int * count = static_cast<int *>(rcl_timer_get_user_data(timer));
+    ASSERT_NE(nullptr, count);
+    ++(*count);
+  };
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init_with_user_data(
+    &timer, &clock, this->context_ptr, 0, callback, &call_count,
+    rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_fini(&timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_EQ(&call_count, rcl_timer_get_user_data(&timer));
+  ret = rcl_timer_call(&timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1, call_count);
+
+  // Without user data the accessor returns null, as it does for an
+  // invalid timer.
+  rcl_timer_t plain_timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &plain_timer, &clock, this->context_ptr, 0, nullptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_fini(&plain_timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  EXPECT_EQ(nullptr, rcl_timer_get_user_data(&plain_timer));
+  EXPECT_EQ(nullptr, rcl_timer_get_user_data(nullptr));
+  rcl_reset_error();
+}
+
+TEST_F(TestTimerFixture, test_timers_call_ready) {
+  rcl_ret_t ret;
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_ROS_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_enable_ros_time_override(&clock)) << rcl_get_error_string().str;
+  const rcl_time_point_value_t start = RCL_S_TO_NS(1);
+  ASSERT_EQ(RCL_RET_OK, rcl_set_ros_time_override(&clock, start)) << rcl_get_error_string().str;
+
+  rcl_timer_t short_timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &short_timer, &clock, this->context_ptr, RCL_MS_TO_NS(100), nullptr,
+    rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_timer_t long_timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &long_timer, &clock, this->context_ptr, RCL_MS_TO_NS(500), nullptr,
+    rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_fini(&short_timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_timer_fini(&long_timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Only the short timer is ready; the batch call services it and skips the
+  // other without error.
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(&clock, start + RCL_MS_TO_NS(100))) <<
+    rcl_get_error_string().str;
+  rcl_timer_t * timers[] = {&short_timer, &long_timer};
+  ret = rcl_timers_call_ready(timers, 2);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  int64_t next_call_time = 0;
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_get_next_call_time(&short_timer, &next_call_time));
+  EXPECT_EQ(start + RCL_MS_TO_NS(200), next_call_time);
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_get_next_call_time(&long_timer, &next_call_time));
+  EXPECT_EQ(start + RCL_MS_TO_NS(500), next_call_time);
+
+  // A canceled timer is skipped even when its period has elapsed.
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_cancel(&short_timer)) << rcl_get_error_string().str;
+  ASSERT_EQ(
+    RCL_RET_OK, rcl_set_ros_time_override(&clock, start + RCL_MS_TO_NS(500))) <<
+    rcl_get_error_string().str;
+  ret = rcl_timers_call_ready(timers, 2);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_get_next_call_time(&short_timer, &next_call_time));
+  EXPECT_EQ(start + RCL_MS_TO_NS(200), next_call_time);
+  ASSERT_EQ(RCL_RET_OK, rcl_timer_get_next_call_time(&long_timer, &next_call_time));
+  EXPECT_EQ(start + RCL_MS_TO_NS(1000), next_call_time);
+}
+
+TEST_F(TestTimerFixture, test_get_next_call_time) {
+  rcl_ret_t ret;
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(50), nullptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_fini(&timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  int64_t next_call_time = 0;
+  ret = rcl_timer_get_next_call_time(&timer, &next_call_time);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // The next call time is absolute on the timer's clock, so it should equal
+  // now plus the time until the next call, modulo the time between reads.
+  rcl_time_point_value_t now = 0;
+  ret = rcl_clock_get_now(&clock, &now);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  int64_t time_until_next_call = 0;
+  ret = rcl_timer_get_time_until_next_call(&timer, &time_until_next_call);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_GE(next_call_time, now);
+  EXPECT_LE(next_call_time, now + time_until_next_call + RCL_MS_TO_NS(1));
+
+  // The next call time is stable until the timer is called.
+  int64_t next_call_time_again = 0;
+  ret = rcl_timer_get_next_call_time(&timer, &next_call_time_again);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(next_call_time, next_call_time_again);
+}
+
+TEST_F(TestTimerFixture, test_timer_service) {
+  rcl_ret_t ret;
+
+  rcl_clock_t clock;
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  ret = rcl_clock_init(RCL_STEADY_TIME, &clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &clock, this->context_ptr, RCL_MS_TO_NS(5), nullptr, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_timer_service_t timer_service = rcl_get_zero_initialized_timer_service();
+  ret = rcl_timer_service_init(
+    &timer_service, this->context_ptr, rcl_timer_service_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_timer_service_fini(&timer_service);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_timer_fini(&timer);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // With no registered timers nothing is scheduled.
+  int64_t deadline = 0;
+  ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(INT64_MAX, deadline);
+
+  ret = rcl_timer_service_add_timer(&timer_service, &timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Adding a timer twice is rejected.
+  ret = rcl_timer_service_add_timer(&timer_service, &timer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(INT64_MAX, deadline);
+
+  // Nothing is delivered before the deadline.
+  size_t number_delivered = 42u;
+  ret = rcl_timer_service_collect(&timer_service, &number_delivered);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_delivered);
+
+  // Play the role of the driving thread: sleep past the deadline, collect.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ret = rcl_timer_service_collect(&timer_service, &number_delivered);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_delivered);
+
+  // The collect triggered the guard condition, so a consumer waiting on it
+  // wakes up without polling the timer.
+  const rcl_guard_condition_t * guard_condition =
+    rcl_timer_service_get_guard_condition(&timer_service);
+  ASSERT_NE(nullptr, guard_condition) << rcl_get_error_string().str;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(&wait_set, guard_condition, NULL);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(guard_condition, wait_set.guard_conditions[0]);
+
+  const rcl_timer_t * expired[4] = {nullptr};
+  size_t number_taken = 0u;
+  ret = rcl_timer_service_take_expired(&timer_service, expired, 4, &number_taken);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_taken);
+  EXPECT_EQ(&timer, expired[0]);
+
+  // Until the taken timer is called it is parked: it does not come back out
+  // of collect and does not contribute a deadline.
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ret = rcl_timer_service_collect(&timer_service, &number_delivered);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_delivered);
+  ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(INT64_MAX, deadline);
+
+  // Calling the timer re-arms it with its next deadline.
+  ret = rcl_timer_call(&timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(INT64_MAX, deadline);
+
+  ret = rcl_timer_service_remove_timer(&timer_service, &timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_service_remove_timer(&timer_service, &timer);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_timer_service_get_next_deadline(&timer_service, &deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(INT64_MAX, deadline);
+}
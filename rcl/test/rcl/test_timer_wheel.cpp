@@ -0,0 +1,173 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "rcl/timer_wheel.h"
+
+#include "rcl/rcl.h"
+
+#include "osrf_testing_tools_cpp/scope_exit.hpp"
+#include "rcl/error_handling.h"
+
+class TestTimerWheelFixture : public ::testing::Test
+{
+public:
+  rcl_context_t * context_ptr;
+  rcl_clock_t clock;
+  rcl_allocator_t allocator;
+
+  void SetUp()
+  {
+    rcl_ret_t ret;
+    allocator = rcl_get_default_allocator();
+    {
+      rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+      ret = rcl_init_options_init(&init_options, allocator);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+      OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+        EXPECT_EQ(RCL_RET_OK, rcl_init_options_fini(&init_options)) << rcl_get_error_string().str;
+      });
+      this->context_ptr = new rcl_context_t;
+      *this->context_ptr = rcl_get_zero_initialized_context();
+      ret = rcl_init(0, nullptr, &init_options, this->context_ptr);
+      ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+    ret = rcl_steady_clock_init(&this->clock, &allocator);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+
+  void TearDown()
+  {
+    rcl_ret_t ret = rcl_clock_fini(&this->clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_shutdown(this->context_ptr);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_context_fini(this->context_ptr);
+    delete this->context_ptr;
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+};
+
+static void timer_wheel_test_callback(rcl_timer_t *, int64_t) {}
+
+/* Timers bucketed on the wheel expire in deadline order as it is advanced.
+ */
+TEST_F(TestTimerWheelFixture, test_timer_wheel_expiry) {
+  rcl_time_point_value_t now;
+  rcl_ret_t ret = rcl_clock_get_now(&this->clock, &now);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_timer_wheel_t wheel = rcl_get_zero_initialized_timer_wheel();
+  rcl_timer_wheel_options_t options = rcl_timer_wheel_get_default_options();
+  ret = rcl_timer_wheel_init(&wheel, now, &options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_wheel_fini(&wheel)) << rcl_get_error_string().str;
+  });
+
+  rcl_timer_t short_timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &short_timer, &this->clock, this->context_ptr, RCL_MS_TO_NS(10),
+    timer_wheel_test_callback, this->allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_timer_t long_timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &long_timer, &this->clock, this->context_ptr, RCL_S_TO_NS(3600),
+    timer_wheel_test_callback, this->allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&short_timer)) << rcl_get_error_string().str;
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&long_timer)) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_timer_wheel_add(&wheel, &short_timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_wheel_add(&wheel, &long_timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  int64_t next_deadline = 0;
+  ret = rcl_timer_wheel_get_next_deadline(&wheel, &next_deadline);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_LE(next_deadline, now + RCL_MS_TO_NS(10));
+
+  // Nothing expires before the earliest deadline.
+  const rcl_timer_t * expired[4] = {nullptr};
+  size_t number_expired = 42;
+  ret = rcl_timer_wheel_advance(&wheel, now, expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_expired);
+
+  // Only the short timer expires within a minute.
+  ret = rcl_timer_wheel_advance(&wheel, now + RCL_S_TO_NS(60), expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_expired);
+  EXPECT_EQ(&short_timer, expired[0]);
+
+  // Periodic timers are re-bucketed automatically.
+  ret = rcl_timer_wheel_advance(&wheel, now + RCL_S_TO_NS(120), expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_expired);
+  EXPECT_EQ(&short_timer, expired[0]);
+
+  // Removed timers stop expiring.
+  ret = rcl_timer_wheel_remove(&wheel, &short_timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_wheel_advance(&wheel, now + RCL_S_TO_NS(180), expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_expired);
+}
+
+/* Canceled timers are parked and resume expiring after a reset.
+ */
+TEST_F(TestTimerWheelFixture, test_timer_wheel_canceled) {
+  rcl_time_point_value_t now;
+  rcl_ret_t ret = rcl_clock_get_now(&this->clock, &now);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_timer_wheel_t wheel = rcl_get_zero_initialized_timer_wheel();
+  rcl_timer_wheel_options_t options = rcl_timer_wheel_get_default_options();
+  ret = rcl_timer_wheel_init(&wheel, now, &options);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_wheel_fini(&wheel)) << rcl_get_error_string().str;
+  });
+
+  rcl_timer_t timer = rcl_get_zero_initialized_timer();
+  ret = rcl_timer_init(
+    &timer, &this->clock, this->context_ptr, RCL_MS_TO_NS(10),
+    timer_wheel_test_callback, this->allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_timer_fini(&timer)) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_timer_wheel_add(&wheel, &timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_cancel(&timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  const rcl_timer_t * expired[4] = {nullptr};
+  size_t number_expired = 42;
+  ret = rcl_timer_wheel_advance(&wheel, now + RCL_S_TO_NS(1), expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_expired);
+
+  ret = rcl_timer_reset(&timer);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_timer_wheel_advance(&wheel, now + RCL_S_TO_NS(2), expired, 4, &number_expired);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_expired);
+  EXPECT_EQ(&timer, expired[0]);
+}
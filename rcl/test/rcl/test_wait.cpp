@@ -477,3 +477,628 @@ TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), add_with_index) {
     EXPECT_EQ(&guard_conditions[i], wait_set.guard_conditions[i]);
   }
 }
+
+// Check that a retained wait set stays populated across waits without re-adding
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), retained_mode) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 2, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond1);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond2);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Repeatedly wait without clearing or re-adding entities between spins.
+  for (int i = 0; i < 3; ++i) {
+    ret = rcl_trigger_guard_condition(&guard_cond2);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    // Pruning still applies per wait: only the triggered condition is set.
+    EXPECT_EQ(nullptr, wait_set.guard_conditions[0]);
+    EXPECT_EQ(&guard_cond2, wait_set.guard_conditions[1]);
+  }
+}
+
+// Check that adding to a retained wait set after a wait keeps the entities
+// that were pruned as not ready by that wait.
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), retained_add_after_wait) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 3, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond3 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond3, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond1);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond2);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond3);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Wait once so the retained snapshot exists and the first condition,
+  // which is not ready, was pruned from the user arrays.
+  ret = rcl_trigger_guard_condition(&guard_cond2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, wait_set.guard_conditions[0]);
+  EXPECT_EQ(&guard_cond2, wait_set.guard_conditions[1]);
+
+  // Add a third condition without clearing; the pruned first condition must
+  // survive the append and still fire on the next wait.
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond3, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_trigger_guard_condition(&guard_cond1);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_trigger_guard_condition(&guard_cond3);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_cond1, wait_set.guard_conditions[0]);
+  EXPECT_EQ(nullptr, wait_set.guard_conditions[1]);
+  EXPECT_EQ(&guard_cond3, wait_set.guard_conditions[2]);
+}
+
+// Check that a single entity can be removed from a retained wait set and
+// migrated to a sibling wait set without rebuilding either.
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), entity_migration) {
+  rcl_wait_set_t busy_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&busy_set, 0, 2, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_wait_set_t idle_set = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&idle_set, 0, 2, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&busy_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&idle_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&busy_set, &guard_cond1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&busy_set, &guard_cond2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&busy_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_fini(&idle_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond1);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond2);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Entities not in the set cannot be removed.
+  ret = rcl_wait_set_remove_guard_condition(&idle_set, &guard_cond1);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Wait once so the retained snapshot exists and the arrays were pruned.
+  ret = rcl_trigger_guard_condition(&guard_cond2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&busy_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, busy_set.guard_conditions[0]);
+
+  // Migrate the first condition: remove from the busy set, add to the idle
+  // one.  The removal must find it even though the last wait pruned it.
+  ret = rcl_wait_set_remove_guard_condition(&busy_set, &guard_cond1);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&idle_set, &guard_cond1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // The migrated condition now wakes the idle set and no longer the busy one.
+  ret = rcl_trigger_guard_condition(&guard_cond1);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&busy_set, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+  rcl_reset_error();
+  ret = rcl_wait(&idle_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_cond1, idle_set.guard_conditions[0]);
+
+  // The remaining condition moved down into the vacated spot.
+  ret = rcl_trigger_guard_condition(&guard_cond2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&busy_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_cond2, busy_set.guard_conditions[0]);
+}
+
+// Check the cumulative load counters used to compare wait sets
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_set_load) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&wait_set, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  ret = rcl_wait_set_get_load(nullptr, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  rcl_wait_set_load_t load;
+  ret = rcl_wait_set_get_load(&wait_set, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Before any wait only the entity count is non-zero.
+  ret = rcl_wait_set_get_load(&wait_set, &load);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, load.entity_count);
+  EXPECT_EQ(0u, load.wait_count);
+  EXPECT_EQ(0u, load.wake_count);
+  EXPECT_EQ(0u, load.ready_entity_count);
+
+  // One wake with a ready entity and one timeout.
+  ret = rcl_trigger_guard_condition(&guard_cond);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+  rcl_reset_error();
+
+  ret = rcl_wait_set_get_load(&wait_set, &load);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, load.entity_count);
+  EXPECT_EQ(2u, load.wait_count);
+  EXPECT_EQ(1u, load.wake_count);
+  EXPECT_EQ(1u, load.ready_entity_count);
+}
+
+// Wait on a parent wait set with attached children and check that readiness
+// is reported per member.
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), composite_wait_set) {
+  rcl_wait_set_t parent = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&parent, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_wait_set_t child = rcl_get_zero_initialized_wait_set();
+  ret = rcl_wait_set_init(&child, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t parent_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &parent_cond, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t child_cond = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &child_cond, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&parent);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_fini(&child);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&parent_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&child_cond);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Invalid attachments are rejected.
+  ret = rcl_wait_set_attach(&parent, &parent);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_wait_set_attach(&parent, &child);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_attach(&parent, &child);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // A parent with children cannot itself be attached.
+  ret = rcl_wait_set_attach(&child, &parent);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // Retained mode keeps both members populated across spins.
+  ret = rcl_wait_set_set_retained(&parent, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_retained(&child, true);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&parent, &parent_cond, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&child, &child_cond, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Only the child's condition fires: the parent wait wakes and readiness
+  // shows up on the child, not the parent.
+  ret = rcl_trigger_guard_condition(&child_cond);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&parent, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(nullptr, parent.guard_conditions[0]);
+  EXPECT_EQ(&child_cond, child.guard_conditions[0]);
+  const rcl_ready_entity_t * ready_entities = nullptr;
+  size_t number_of_ready_entities = 42u;
+  ret = rcl_wait_set_get_ready_entities(&child, &ready_entities, &number_of_ready_entities);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_of_ready_entities);
+  EXPECT_EQ(RCL_WAIT_SET_GUARD_CONDITION, ready_entities[0].type);
+  ret = rcl_wait_set_get_ready_entities(&parent, &ready_entities, &number_of_ready_entities);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_of_ready_entities);
+
+  // And the other way around on the next spin.
+  ret = rcl_trigger_guard_condition(&parent_cond);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&parent, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&parent_cond, parent.guard_conditions[0]);
+  EXPECT_EQ(nullptr, child.guard_conditions[0]);
+
+  // After detaching, the child's entities no longer wake the parent.
+  ret = rcl_wait_set_detach(&parent, &child);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_detach(&parent, &child);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_trigger_guard_condition(&child_cond);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&parent, RCL_MS_TO_NS(20));
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret);
+  rcl_reset_error();
+  // Consume the pending trigger by waiting on the child directly.
+  ret = rcl_wait(&child, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&child_cond, child.guard_conditions[0]);
+}
+
+// Check the compact ready entity list populated by rcl_wait
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), ready_entities_list) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 2, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond1 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond1, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  rcl_guard_condition_t guard_cond2 = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_cond2, this->context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond1, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_cond2, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond1);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_guard_condition_fini(&guard_cond2);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  // Before any wait the list is empty.
+  const rcl_ready_entity_t * ready_entities = nullptr;
+  size_t number_of_ready_entities = 42u;
+  ret = rcl_wait_set_get_ready_entities(&wait_set, &ready_entities, &number_of_ready_entities);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, number_of_ready_entities);
+
+  ret = rcl_trigger_guard_condition(&guard_cond2);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  ret = rcl_wait_set_get_ready_entities(&wait_set, &ready_entities, &number_of_ready_entities);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_EQ(1u, number_of_ready_entities);
+  EXPECT_EQ(RCL_WAIT_SET_GUARD_CONDITION, ready_entities[0].type);
+  EXPECT_EQ(1u, ready_entities[0].index);
+  EXPECT_EQ(&guard_cond2, wait_set.guard_conditions[ready_entities[0].index]);
+}
+
+// Check that bulk adds fill the set like repeated single adds
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), bulk_add) {
+  const size_t kNumEntities = 3u;
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(
+    &wait_set, 0, kNumEntities, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  rcl_guard_condition_t guard_conditions[kNumEntities];
+  const rcl_guard_condition_t * guard_condition_ptrs[kNumEntities];
+  for (size_t i = 0u; i < kNumEntities; ++i) {
+    guard_conditions[i] = rcl_get_zero_initialized_guard_condition();
+    ret = rcl_guard_condition_init(
+      &guard_conditions[i], this->context_ptr, rcl_guard_condition_get_default_options());
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    guard_condition_ptrs[i] = &guard_conditions[i];
+  }
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    for (size_t i = 0u; i < kNumEntities; ++i) {
+      ret = rcl_guard_condition_fini(&guard_conditions[i]);
+      EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    }
+  });
+
+  size_t first_index = 42u;
+  ret = rcl_wait_set_add_guard_conditions(
+    &wait_set, guard_condition_ptrs, kNumEntities, &first_index);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, first_index);
+  for (size_t i = 0u; i < kNumEntities; ++i) {
+    EXPECT_EQ(&guard_conditions[i], wait_set.guard_conditions[i]);
+  }
+
+  // The set is now full, so another bulk add must fail.
+  ret = rcl_wait_set_add_guard_conditions(&wait_set, guard_condition_ptrs, kNumEntities, NULL);
+  EXPECT_EQ(RCL_RET_WAIT_SET_FULL, ret);
+  rcl_reset_error();
+
+  // The bulk populated set behaves normally in a wait.
+  ret = rcl_trigger_guard_condition(&guard_conditions[1]);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(&wait_set, RCL_MS_TO_NS(100));
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(&guard_conditions[1], wait_set.guard_conditions[1]);
+}
+
+// Test rcl_wait_until with an absolute deadline.
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_until_deadline) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 1, 0, 0, 0, rcl_get_default_allocator());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_wait_set_fini(&wait_set);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, context_ptr, rcl_guard_condition_get_default_options());
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_guard_condition_fini(&guard_condition);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+  rcl_clock_t clock;
+  ret = rcl_steady_clock_init(&clock, &allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    rcl_ret_t ret = rcl_clock_fini(&clock);
+    EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  });
+
+  rcl_time_point_value_t now;
+  ret = rcl_clock_get_now(&clock, &now);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // An untriggered guard condition waits until the deadline.
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  int64_t timeout = RCL_MS_TO_NS(10);  // nanoseconds
+  std::chrono::steady_clock::time_point before_sc = std::chrono::steady_clock::now();
+  ret = rcl_wait_until(&wait_set, now + timeout, &clock);
+  std::chrono::steady_clock::time_point after_sc = std::chrono::steady_clock::now();
+  ASSERT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  int64_t diff = std::chrono::duration_cast<std::chrono::nanoseconds>(after_sc - before_sc).count();
+  EXPECT_LE(diff, timeout + TOLERANCE);
+
+  // A deadline in the past is non-blocking.
+  ret = rcl_wait_set_clear(&wait_set);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  before_sc = std::chrono::steady_clock::now();
+  ret = rcl_wait_until(&wait_set, now - RCL_MS_TO_NS(1), &clock);
+  after_sc = std::chrono::steady_clock::now();
+  ASSERT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  diff = std::chrono::duration_cast<std::chrono::nanoseconds>(after_sc - before_sc).count();
+  EXPECT_LE(diff, TOLERANCE);
+
+  // A NULL clock is rejected.
+  ret = rcl_wait_until(&wait_set, now, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+}
+
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), wait_set_pool) {
+  // Acquiring with invalid arguments is rejected.
+  rcl_wait_set_t * wait_set_ptr = nullptr;
+  rcl_ret_t ret = rcl_context_acquire_wait_set(nullptr, 0, 1, 0, 0, 0, &wait_set_ptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_context_acquire_wait_set(this->context_ptr, 0, 1, 0, 0, 0, nullptr);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // Releasing before anything was pooled is rejected.
+  rcl_wait_set_t dummy = rcl_get_zero_initialized_wait_set();
+  ret = rcl_context_release_wait_set(this->context_ptr, &dummy);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  // An acquired set is ready to use.
+  ret = rcl_context_acquire_wait_set(this->context_ptr, 0, 1, 0, 0, 0, &wait_set_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ASSERT_NE(nullptr, wait_set_ptr);
+  EXPECT_EQ(1u, wait_set_ptr->size_of_guard_conditions);
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, this->context_ptr, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition)) <<
+      rcl_get_error_string().str;
+  });
+  ret = rcl_wait_set_add_guard_condition(wait_set_ptr, &guard_condition, NULL);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait(wait_set_ptr, 0);
+  EXPECT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+  ret = rcl_context_release_wait_set(this->context_ptr, wait_set_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Re-acquiring with the same sizes recycles the released set, cleared.
+  rcl_wait_set_t * second_wait_set_ptr = nullptr;
+  ret = rcl_context_acquire_wait_set(this->context_ptr, 0, 1, 0, 0, 0, &second_wait_set_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(wait_set_ptr, second_wait_set_ptr);
+  EXPECT_EQ(nullptr, second_wait_set_ptr->guard_conditions[0]);
+
+  // Acquiring again while the first set is out constructs a distinct one,
+  // and different sizes are accommodated by resizing on reuse.
+  rcl_wait_set_t * third_wait_set_ptr = nullptr;
+  ret = rcl_context_acquire_wait_set(this->context_ptr, 1, 2, 0, 0, 0, &third_wait_set_ptr);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_NE(second_wait_set_ptr, third_wait_set_ptr);
+  EXPECT_EQ(1u, third_wait_set_ptr->size_of_subscriptions);
+  EXPECT_EQ(2u, third_wait_set_ptr->size_of_guard_conditions);
+  ret = rcl_context_release_wait_set(this->context_ptr, third_wait_set_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_context_release_wait_set(this->context_ptr, second_wait_set_ptr);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // Pooled sets are finalized with the context in TearDown.
+}
+
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), shrink_to_fit) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 8, 8, 8, 8, 8, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, this->context_ptr, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition)) <<
+      rcl_get_error_string().str;
+  });
+
+  // Shrinking with one guard condition added drops the other capacities.
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_shrink_to_fit(&wait_set);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(0u, wait_set.size_of_subscriptions);
+  EXPECT_EQ(1u, wait_set.size_of_guard_conditions);
+  EXPECT_EQ(0u, wait_set.size_of_timers);
+  EXPECT_EQ(0u, wait_set.size_of_clients);
+  EXPECT_EQ(0u, wait_set.size_of_services);
+  // Like a resize, the shrink leaves the set empty but usable.
+  ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  // A second shrink at exact occupancy is a no-op.
+  ret = rcl_wait_set_shrink_to_fit(&wait_set);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(1u, wait_set.size_of_guard_conditions);
+}
+
+TEST_F(CLASSNAME(WaitSetTestFixture, RMW_IMPLEMENTATION), shrink_policy) {
+  rcl_wait_set_t wait_set = rcl_get_zero_initialized_wait_set();
+  rcl_ret_t ret = rcl_wait_set_init(&wait_set, 0, 8, 0, 0, 0, rcl_get_default_allocator());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_wait_set_fini(&wait_set)) << rcl_get_error_string().str;
+  });
+  rcl_guard_condition_t guard_condition = rcl_get_zero_initialized_guard_condition();
+  ret = rcl_guard_condition_init(
+    &guard_condition, this->context_ptr, rcl_guard_condition_get_default_options());
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT({
+    EXPECT_EQ(RCL_RET_OK, rcl_guard_condition_fini(&guard_condition)) <<
+      rcl_get_error_string().str;
+  });
+
+  // An out of range percentage is rejected.
+  ret = rcl_wait_set_set_shrink_policy(&wait_set, 101, 3);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  // Shrink once the occupancy stays below 50% for 2 consecutive waits.
+  ret = rcl_wait_set_set_shrink_policy(&wait_set, 50, 2);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // Two low occupancy waits arm the shrink, and the following clear
+  // applies it; the arrays are untouched between the wait and the clear.
+  for (int i = 0; i < 2; ++i) {
+    ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait(&wait_set, 0);
+    ASSERT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+    EXPECT_EQ(8u, wait_set.size_of_guard_conditions);
+    ret = rcl_wait_set_clear(&wait_set);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  // Shrunk to the streak's high-watermark of one guard condition.
+  EXPECT_EQ(1u, wait_set.size_of_guard_conditions);
+
+  // Disabling the policy stops further shrinking.
+  ret = rcl_wait_set_resize(&wait_set, 0, 8, 0, 0, 0);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_wait_set_set_shrink_policy(&wait_set, 0, 0);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  for (int i = 0; i < 3; ++i) {
+    ret = rcl_wait_set_add_guard_condition(&wait_set, &guard_condition, NULL);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+    ret = rcl_wait(&wait_set, 0);
+    ASSERT_EQ(RCL_RET_TIMEOUT, ret) << rcl_get_error_string().str;
+    ret = rcl_wait_set_clear(&wait_set);
+    ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  }
+  EXPECT_EQ(8u, wait_set.size_of_guard_conditions);
+}
@@ -0,0 +1,169 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "rcl/error_handling.h"
+#include "rcl/rcl.h"
+#include "rcl_action/rcl_action.h"
+#include "rosidl_generator_c/action_type_support_struct.h"
+#include "test_msgs/action/fibonacci.h"
+
+#define BENCHMARK_CHECK(ret) \
+  do { \
+    if (RCL_RET_OK != (ret)) { \
+      fprintf( \
+        stderr, "%s:%d: %s\n", __FILE__, __LINE__, rcl_get_error_string().str); \
+      exit(1); \
+    } \
+  } while (0)
+
+namespace
+{
+
+/// Context, node, clock and action server, torn down in reverse order.
+class ActionServerFixture
+{
+public:
+  explicit ActionServerFixture(int64_t result_timeout_ns)
+  {
+    rcl_init_options_t init_options = rcl_get_zero_initialized_init_options();
+    BENCHMARK_CHECK(rcl_init_options_init(&init_options, rcl_get_default_allocator()));
+    context = rcl_get_zero_initialized_context();
+    BENCHMARK_CHECK(rcl_init(0, nullptr, &init_options, &context));
+    BENCHMARK_CHECK(rcl_init_options_fini(&init_options));
+    node = rcl_get_zero_initialized_node();
+    rcl_node_options_t node_options = rcl_node_get_default_options();
+    BENCHMARK_CHECK(
+      rcl_node_init(&node, "benchmark_goals_node", "", &context, &node_options));
+    BENCHMARK_CHECK(
+      rcl_clock_init(RCL_STEADY_TIME, &clock, &node_options.allocator));
+    const rosidl_action_type_support_t * type_support =
+      ROSIDL_GET_ACTION_TYPE_SUPPORT(test_msgs, Fibonacci);
+    action_server = rcl_action_get_zero_initialized_server();
+    rcl_action_server_options_t options = rcl_action_server_get_default_options();
+    options.result_timeout.nanoseconds = result_timeout_ns;
+    BENCHMARK_CHECK(
+      rcl_action_server_init(
+        &action_server, &node, &clock, type_support, "benchmark_goals", &options));
+  }
+
+  ~ActionServerFixture()
+  {
+    BENCHMARK_CHECK(rcl_action_server_fini(&action_server, &node));
+    BENCHMARK_CHECK(rcl_clock_fini(&clock));
+    BENCHMARK_CHECK(rcl_node_fini(&node));
+    BENCHMARK_CHECK(rcl_shutdown(&context));
+    BENCHMARK_CHECK(rcl_context_fini(&context));
+  }
+
+  rcl_context_t context;
+  rcl_node_t node;
+  rcl_clock_t clock;
+  rcl_action_server_t action_server;
+};
+
+void set_goal_uuid(rcl_action_goal_info_t * goal_info, uint64_t value)
+{
+  memcpy(goal_info->uuid, &value, sizeof(value));
+  memcpy(goal_info->uuid + sizeof(value), &value, sizeof(value));
+}
+
+}  // namespace
+
+/// Measure accepting N goals, then terminating and expiring them all.
+/**
+ * Each iteration covers the full server-side goal lifecycle: accept,
+ * execute, succeed and expire.
+ * Expiration is timed together with acceptance since expiring pops the
+ * tracking structures that accepting filled.
+ */
+static void BM_goal_accept_and_expire(benchmark::State & state)
+{
+  const size_t num_goals = static_cast<size_t>(state.range(0));
+  // A zero result timeout makes every terminated goal immediately eligible
+  // for expiration.
+  ActionServerFixture fixture(0);
+
+  uint64_t next_uuid = 1;
+  for (auto _ : state) {
+    (void)_;
+    for (size_t i = 0; i < num_goals; ++i) {
+      rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+      set_goal_uuid(&goal_info, next_uuid++);
+      rcl_action_goal_handle_t * goal_handle =
+        rcl_action_accept_new_goal(&fixture.action_server, &goal_info);
+      if (nullptr == goal_handle) {
+        fprintf(stderr, "failed to accept goal: %s\n", rcl_get_error_string().str);
+        exit(1);
+      }
+      BENCHMARK_CHECK(rcl_action_update_goal_state(goal_handle, GOAL_EVENT_EXECUTE));
+      BENCHMARK_CHECK(rcl_action_update_goal_state(goal_handle, GOAL_EVENT_SET_SUCCEEDED));
+    }
+    size_t num_expired = 0;
+    do {
+      rcl_action_goal_info_t expired_goal;
+      BENCHMARK_CHECK(
+        rcl_action_expire_goals(&fixture.action_server, &expired_goal, 1, &num_expired));
+    } while (num_expired > 0);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_goals));
+}
+BENCHMARK(BM_goal_accept_and_expire)->Arg(1)->Arg(8)->Arg(64)->Arg(256);
+
+/// Measure rcl_action_expire_goals when nothing is eligible to expire.
+/**
+ * This is the cost the server timer pays every wakeup while goals are
+ * active; with the deadline heap it should stay flat in the goal count.
+ */
+static void BM_goal_expire_none_pending(benchmark::State & state)
+{
+  const size_t num_goals = static_cast<size_t>(state.range(0));
+  // A long result timeout keeps every deadline in the future so nothing is
+  // ever popped from the heap.
+  ActionServerFixture fixture(RCL_S_TO_NS(3600));
+
+  for (size_t i = 0; i < num_goals; ++i) {
+    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+    set_goal_uuid(&goal_info, i + 1);
+    rcl_action_goal_handle_t * goal_handle =
+      rcl_action_accept_new_goal(&fixture.action_server, &goal_info);
+    if (nullptr == goal_handle) {
+      fprintf(stderr, "failed to accept goal: %s\n", rcl_get_error_string().str);
+      exit(1);
+    }
+    // Active goals are tracked but never expired.
+    BENCHMARK_CHECK(rcl_action_update_goal_state(goal_handle, GOAL_EVENT_EXECUTE));
+  }
+
+  for (auto _ : state) {
+    (void)_;
+    size_t num_expired = 0;
+    rcl_action_goal_info_t expired_goal;
+    BENCHMARK_CHECK(
+      rcl_action_expire_goals(&fixture.action_server, &expired_goal, 1, &num_expired));
+    if (num_expired != 0) {
+      state.SkipWithError("active goals unexpectedly expired");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_goal_expire_none_pending)->Arg(1)->Arg(64)->Arg(1024);
+
+BENCHMARK_MAIN();
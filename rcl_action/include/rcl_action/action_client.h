@@ -20,6 +20,7 @@ extern "C"
 {
 #endif
 
+#include "rcl_action/names.h"
 #include "rcl_action/types.h"
 #include "rcl_action/visibility_control.h"
 #include "rcl/macros.h"
@@ -373,6 +374,51 @@ rcl_action_take_feedback(
   const rcl_action_client_t * action_client,
   void * ros_feedback);
 
+/// Take a batch of ROS feedback messages using a rcl_action_client_t.
+/**
+ * This is equivalent to calling rcl_action_take_feedback() repeatedly until
+ * it reports that nothing was taken, except that the action client is
+ * validated only once and up to `capacity` messages are drained in one call,
+ * which amortizes the per-call overhead when catching up on high-rate
+ * feedback from many goals.
+ *
+ * All `capacity` entries of `ros_feedback_messages` must point to
+ * preallocated feedback messages of the correct type; the first `*taken` of
+ * them are filled in.
+ *
+ * \see rcl_action_take_feedback() for the type and allocation caveats that
+ *   apply to each message in the batch.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling a feedback message, avoided for fixed sizes</i>
+ *
+ * \param[in] action_client handle to the client that will take action feedback
+ * \param[inout] ros_feedback_messages array of pointers to allocated feedback
+ *   messages to fill
+ * \param[in] capacity number of messages in the array
+ * \param[out] taken how many messages were actually taken
+ * \return `RCL_RET_OK` if one or more messages were taken, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ACTION_CLIENT_TAKE_FAILED` if no messages were available, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_take_feedback_batch(
+  const rcl_action_client_t * action_client,
+  void ** ros_feedback_messages,
+  size_t capacity,
+  size_t * taken);
+
 /// Take a ROS status message using a rcl_action_client_t.
 /**
  * The caller is responsible for ensuring that the type of `ros_status_array`
@@ -522,6 +568,86 @@ rcl_action_take_result_response(
   rmw_request_id_t * response_header,
   void * ros_result);
 
+/// Send a ROS result request and tag it for response correlation.
+/**
+ * This behaves like rcl_action_send_result_request(), but additionally records
+ * the caller supplied `tag` against the request's sequence number in a
+ * preallocated table internal to the action client.
+ * The tag is surfaced again, and dropped from the table, when the matching
+ * response is taken with rcl_action_take_result_response_tagged(), so callers
+ * running many concurrent goals do not need to correlate sequence numbers
+ * themselves.
+ *
+ * The tag is an opaque pointer owned by the caller; it is never dereferenced
+ * or deallocated by the action client.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the number of in-flight tags outgrows the preallocated table</i>
+ *
+ * \param[in] action_client handle to the client that will make the result request
+ * \param[in] ros_result_request pointer to a ROS result request message
+ * \param[out] sequence_number pointer to the result request sequence number
+ * \param[in] tag opaque caller pointer returned with the matching response
+ * \return `RCL_RET_OK` if the request was sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if the request was sent but tagging it failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_send_result_request_tagged(
+  const rcl_action_client_t * action_client,
+  const void * ros_result_request,
+  int64_t * sequence_number,
+  void * tag);
+
+/// Take a ROS result message and the tag recorded when its request was sent.
+/**
+ * This behaves like rcl_action_take_result_response(), but additionally looks
+ * up the response's sequence number in the action client's tag table, writing
+ * the tag recorded by rcl_action_send_result_request_tagged() to `tag` and
+ * removing it from the table.
+ * If the request was sent without a tag, `tag` is set to `NULL`.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if required when filling the result response message, avoided for fixed sizes</i>
+ *
+ * \param[in] action_client handle to the client that will take the result response
+ * \param[out] response_header pointer to the result response header
+ * \param[out] ros_result_response preallocated, zero-initialized, struct where the ROS
+ *   result message is copied.
+ * \param[out] tag the tag recorded for the request, or `NULL` if none was recorded
+ * \return `RCL_RET_OK` if the response was taken successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ACTION_CLIENT_TAKE_FAILED` if take failed but no error occurred
+ *         in the middleware, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_take_result_response_tagged(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_result_response,
+  void ** tag);
+
 /// Send a cancel request for a goal using a rcl_action_client_t.
 /**
  * This is a non-blocking call.
@@ -614,6 +740,220 @@ rcl_action_take_cancel_response(
   rmw_request_id_t * response_header,
   void * ros_cancel_response);
 
+/// Record a caller tag for an accepted goal, keyed by its goal ID.
+/**
+ * The tag can later be retrieved in constant time with
+ * rcl_action_client_get_goal_tag(), e.g. to correlate a feedback or status
+ * message carrying the goal ID with caller state, and should be removed with
+ * rcl_action_client_remove_goal_tag() once the goal reaches a terminal state.
+ * Setting a tag for a goal ID that already has one replaces the previous tag.
+ *
+ * The tag is an opaque pointer owned by the caller; it is never dereferenced
+ * or deallocated by the action client.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the number of tagged goals outgrows the preallocated table</i>
+ *
+ * \param[in] action_client handle to the client tracking the goal
+ * \param[in] goal_info pointer to a goal info message carrying the goal ID
+ * \param[in] tag opaque caller pointer associated with the goal
+ * \return `RCL_RET_OK` if the tag was recorded successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_set_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info,
+  void * tag);
+
+/// Get the caller tag recorded for a goal, keyed by its goal ID.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client tracking the goal
+ * \param[in] goal_info pointer to a goal info message carrying the goal ID
+ * \param[out] tag the tag recorded with rcl_action_client_set_goal_tag()
+ * \return `RCL_RET_OK` if the tag was retrieved successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ERROR` if no tag is recorded for the goal ID.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_get_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info,
+  void ** tag);
+
+/// Remove the caller tag recorded for a goal, keyed by its goal ID.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client tracking the goal
+ * \param[in] goal_info pointer to a goal info message carrying the goal ID
+ * \return `RCL_RET_OK` if the tag was removed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ERROR` if no tag is recorded for the goal ID.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_remove_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info);
+
+/// Register a goal ID the client is interested in.
+/**
+ * While at least one goal ID filter is registered, the take functions drop
+ * status and feedback concerning other goals instead of delivering it:
+ * rcl_action_take_status() compacts the status array down to the filtered
+ * goals, and rcl_action_take_feedback() and rcl_action_take_feedback_batch()
+ * discard non-matching messages and move on to the next one, so a client
+ * tracking two goals on a busy shared action does not hand every bystander
+ * goal's traffic to the caller.
+ *
+ * Feedback messages are concrete action specific types this library cannot
+ * look into, so feedback is only filtered once an extractor has been
+ * registered with rcl_action_client_set_feedback_goal_id_extractor();
+ * status filtering needs no extractor.
+ * With no filters registered everything is delivered, as before.
+ *
+ * Registering a goal ID that is already registered is not an error.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only if the number of filters outgrows the preallocated table</i>
+ *
+ * \param[in] action_client handle to the client filtering its intake
+ * \param[in] goal_info pointer to a goal info message carrying the goal ID
+ * \return `RCL_RET_OK` if the filter was registered successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_add_goal_id_filter(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info);
+
+/// Unregister a goal ID registered with rcl_action_client_add_goal_id_filter().
+/**
+ * Removing the last filter turns filtering off, i.e. every message is
+ * delivered again; it does not restrict intake to nothing.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client filtering its intake
+ * \param[in] goal_info pointer to a goal info message carrying the goal ID
+ * \return `RCL_RET_OK` if the filter was removed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid, or
+ * \return `RCL_RET_ERROR` if no filter is registered for the goal ID.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_remove_goal_id_filter(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info);
+
+/// Unregister every goal ID filter, turning filtering off.
+/**
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client filtering its intake
+ * \return `RCL_RET_OK` if the filters were cleared successfully, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_clear_goal_id_filters(
+  const rcl_action_client_t * action_client);
+
+/// Function extracting the goal ID from a taken feedback message.
+/**
+ * Given a feedback message of the action specific type, returns a pointer to
+ * its UUID_SIZE byte goal ID, or `NULL` if the message should be delivered
+ * without filtering.  The returned pointer only has to stay valid for the
+ * duration of the take call that invoked the extractor.
+ */
+typedef const uint8_t * (* rcl_action_feedback_goal_id_extractor_t)(
+  const void * ros_feedback);
+
+/// Register the extractor used to filter feedback messages by goal ID.
+/**
+ * The feedback topic carries a concrete action specific message type this
+ * library cannot look into, so goal ID filtering of feedback needs the
+ * caller to point out where the goal ID lives; typically the extractor is
+ * one line returning the address of the message's goal ID field.
+ *
+ * Passing `NULL` unregisters the extractor, which stops feedback filtering
+ * while leaving status filtering in effect.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client handle to the client filtering its intake
+ * \param[in] extractor the extractor to register, or `NULL` to unregister
+ * \return `RCL_RET_OK` if the extractor was registered successfully, or
+ * \return `RCL_RET_ACTION_CLIENT_INVALID` if the action client is invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_client_set_feedback_goal_id_extractor(
+  const rcl_action_client_t * action_client,
+  rcl_action_feedback_goal_id_extractor_t extractor);
+
 /// Get the name of the action for a rcl_action_client_t.
 /**
  * This function returns the action client's name string.
@@ -641,6 +981,33 @@ RCL_WARN_UNUSED
 const char *
 rcl_action_client_get_action_name(const rcl_action_client_t * action_client);
 
+/// Get the derived service and topic names for an action client.
+/**
+ * This function returns the names derived from the action name at init time,
+ * so no formatting or allocation happens per call.
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - action client is `NULL`
+ *   - action client is invalid (e.g. never called init or called fini)
+ *
+ * The returned struct and its strings are only valid as long as the action
+ * client is valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_client the pointer to the action client
+ * \return the derived names if successful, otherwise `NULL`
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+const rcl_action_names_t *
+rcl_action_client_get_names(const rcl_action_client_t * action_client);
+
 /// Return the options for a rcl_action_client_t.
 /**
  * This function returns the action client's internal options struct.
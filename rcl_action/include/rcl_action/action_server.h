@@ -21,6 +21,7 @@ extern "C"
 #endif
 
 #include "rcl_action/goal_handle.h"
+#include "rcl_action/names.h"
 #include "rcl_action/types.h"
 #include "rcl_action/visibility_control.h"
 #include "rcl/macros.h"
@@ -54,6 +55,24 @@ typedef struct rcl_action_server_options_t
   rcl_clock_type_t clock_type;
   /// Goal handles that have results longer than this time are deallocated.
   rcl_duration_t result_timeout;
+  /// Number of goal handles to preallocate storage for.
+  /**
+   * The storage grows geometrically beyond this as goals are accepted, so it
+   * is a sizing hint rather than a limit.
+   */
+  size_t goal_handle_capacity;
+  /// If true, bursts of status publications are coalesced.
+  /**
+   * With coalescing enabled, rcl_action_publish_status() publishes at most
+   * once per status_publish_period: the first call in a period publishes
+   * immediately, later calls only mark the status dirty and return.
+   * A deferred publication is detected with
+   * rcl_action_server_status_flush_due() and performed by calling
+   * rcl_action_publish_status() again once it reports due.
+   */
+  bool enable_status_coalescing;
+  /// Minimum time between two status publications when coalescing.
+  rcl_duration_t status_publish_period;
 } rcl_action_server_options_t;
 
 /// Return a rcl_action_server_t struct with members set to `NULL`.
@@ -221,6 +240,9 @@ rcl_action_server_fini(rcl_action_server_t * action_server, rcl_node_t * node);
  * - status_topic_qos = rcl_action_qos_profile_status_default;
  * - allocator = rcl_get_default_allocator();
  * - result_timeout = RCUTILS_S_TO_NS(15 * 60);  // 15 minutes
+ * - goal_handle_capacity = 16;
+ * - enable_status_coalescing = false;
+ * - status_publish_period = RCUTILS_MS_TO_NS(10);  // 100 Hz cap
  */
 RCL_ACTION_PUBLIC
 RCL_WARN_UNUSED
@@ -436,11 +458,61 @@ rcl_action_publish_feedback(
   const rcl_action_server_t * action_server,
   void * ros_feedback);
 
+/// Publish a batch of ROS feedback messages using an action server.
+/**
+ * This is equivalent to calling rcl_action_publish_feedback() once per
+ * message, but the action server is validated only once for the whole batch,
+ * which reduces the per-message overhead when publishing high-rate feedback
+ * for many goals at once.
+ *
+ * All `count` entries of `ros_feedback_messages` must be non-null feedback
+ * messages of the type associated with the action server.
+ * The messages are handed to the middleware in array order; if publishing
+ * fails part way through, the messages before the failing one have already
+ * been handed to the middleware.
+ *
+ * \see rcl_action_publish_feedback() for the type, ownership, and
+ *   thread-safety caveats that apply to each message in the batch.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] for unique pairs of action servers and feedback, see
+ *   rcl_action_publish_feedback()</i>
+ *
+ * \param[in] action_server handle to the action server that will publish the feedback
+ * \param[in] ros_feedback_messages array of pointers to goal feedback messages
+ * \param[in] count number of messages in the array
+ * \return `RCL_RET_OK` if all messages were published successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_publish_feedback_batch(
+  const rcl_action_server_t * action_server,
+  const void ** ros_feedback_messages,
+  size_t count);
+
 /// Get a status array message for accepted goals associated with an action server.
 /**
  * The provided `status_message` should be zero-initialized with
  * rcl_action_get_zero_initialized_goal_status_array() before calling this function.
  *
+ * The message borrows a status array that lives inside the action server, so
+ * no memory is allocated: goal information is recorded as goals are accepted
+ * and only the status codes are refreshed by this call.
+ * The borrowed array is valid until the set of tracked goals next changes
+ * (a goal is accepted or expires) and must not outlive the action server.
+ * Passing the message to rcl_action_goal_status_array_fini() is still safe;
+ * it will not free the action server's storage.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -471,6 +543,13 @@ rcl_action_get_goal_status_array(
  * A status array message associated with the action server can be created with
  * rcl_action_get_goal_status_array().
  *
+ * When status coalescing is enabled in the action server options, at most
+ * one publication per status_publish_period reaches the wire: the first
+ * call in a period publishes immediately, later calls only mark the status
+ * dirty and return `RCL_RET_OK` without publishing.
+ * Use rcl_action_server_status_flush_due() to learn when a deferred
+ * publication should be performed by calling this function again.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -493,6 +572,36 @@ rcl_action_publish_status(
   const rcl_action_server_t * action_server,
   const void * status_message);
 
+/// Check whether a deferred status publication is due.
+/**
+ * Only meaningful when status coalescing is enabled in the action server
+ * options; without coalescing `due` is always set to false.
+ * `due` becomes true once a call to rcl_action_publish_status() was
+ * deferred and the status publish period has elapsed since the last
+ * publication; build a fresh status array and publish it then.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server that is queried
+ * \param[out] due set to true if a deferred status publication is due
+ * \return `RCL_RET_OK` if the check was performed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_server_status_flush_due(
+  const rcl_action_server_t * action_server,
+  bool * due);
+
 /// Take a pending result request using an action server.
 /**
  * \todo TODO(jacobperron) blocking of take?
@@ -569,6 +678,81 @@ rcl_action_send_result_response(
   rmw_request_id_t * response_header,
   void * ros_result_response);
 
+/// Record a result requester to be answered when the goal result is ready.
+/**
+ * Several clients may request the result of the same goal before it has one.
+ * Rather than answering each requester with a separate
+ * rcl_action_send_result_response() call, the requesters of a tracked goal
+ * can be recorded with this function and answered together with a single
+ * rcl_action_send_deferred_result_responses() call once the result is known.
+ *
+ * The goal identified by `goal_info` must be tracked by the action server,
+ * i.e. rcl_action_server_goal_exists() returns true for it.
+ * Requesters recorded for a goal that expires before its deferred responses
+ * are sent are discarded.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server that took the result request
+ * \param[in] goal_info message containing the UUID of the requested goal
+ * \param[in] request_header pointer to the header of the taken result request
+ * \return `RCL_RET_OK` if the requester was recorded successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_ACTION_GOAL_HANDLE_INVALID` if the goal is not tracked, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_defer_result_response(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_info_t * goal_info,
+  const rmw_request_id_t * request_header);
+
+/// Send one result response to every recorded requester of a goal.
+/**
+ * This is a non-blocking call.
+ *
+ * Sends `ros_result_response` to each requester previously recorded for the
+ * goal with rcl_action_defer_result_response() and forgets the requesters.
+ * If no requesters were recorded for the goal, nothing is sent.
+ *
+ * The caller is responsible for ensuring that the type of `ros_result_response`
+ * and the type associate with the client (via the type support) match.
+ * Passing a different type produces undefined behavior and cannot be checked
+ * by this function and therefore no deliberate error will occur.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server that will send the result responses
+ * \param[in] goal_info message containing the UUID of the goal with a result
+ * \param[in] ros_result_response a ROS result response message to send
+ * \return `RCL_RET_OK` if the responses were sent successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_send_deferred_result_responses(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_info_t * goal_info,
+  void * ros_result_response);
+
 /// Expires goals associated with an action server.
 /**
  * A goal is 'expired' if it has been in a terminal state (has a result) for longer
@@ -733,6 +917,48 @@ rcl_action_process_cancel_request(
   const rcl_action_cancel_request_t * cancel_request,
   rcl_action_cancel_response_t * cancel_response);
 
+/// Process a batch of cancel requests using an action server.
+/**
+ * This is a non-blocking call.
+ *
+ * Equivalent to calling rcl_action_process_cancel_request() once per request,
+ * but the goal table is scanned only once for the whole batch.
+ * `cancel_responses[i]` receives the response for `cancel_requests[i]` and
+ * must be a zero-initialized cancel response struct.
+ * The cancel policy per request is the same as for
+ * rcl_action_process_cancel_request().
+ *
+ * If processing any request fails, the remaining requests are still
+ * processed and the error of the last failing request is returned.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server handle to the action server that will process the cancel requests
+ * \param[in] cancel_requests an array of C-typed ROS cancel requests to process
+ * \param[in] num_requests the number of requests in `cancel_requests`
+ * \param[out] cancel_responses an array of `num_requests` zero-initialized cancel
+ *   response structs where the goal info of goals which should be cancelled are copied
+ * \return `RCL_RET_OK` if all requests were processed successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ACTION_SERVER_INVALID` if the action server is invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed, or
+ * \return `RCL_RET_ERROR` if an unspecified error occurs.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_process_cancel_requests(
+  const rcl_action_server_t * action_server,
+  const rcl_action_cancel_request_t * cancel_requests,
+  size_t num_requests,
+  rcl_action_cancel_response_t * cancel_responses);
+
 /// Send a cancel response using an action server.
 /**
  * This is a non-blocking call.
@@ -789,6 +1015,34 @@ RCL_WARN_UNUSED
 const char *
 rcl_action_server_get_action_name(const rcl_action_server_t * action_server);
 
+/// Get the derived service and topic names for an action server.
+/**
+ * This function returns the names derived from the action name at init time,
+ * so no formatting or allocation happens per call.
+ * This function can fail, and therefore return `NULL`, if the:
+ *   - action server is `NULL`
+ *   - action server is invalid (e.g. never called init or called fini)
+ *
+ * The returned struct and its strings are only valid as long as the action
+ * server is valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[in] action_server pointer to the action server
+ * \return the derived names if successful, or
+ * \return `NULL` otherwise.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+const rcl_action_names_t *
+rcl_action_server_get_names(const rcl_action_server_t * action_server);
+
 /// Return the rcl_action_server_options_t for an action server.
 /**
  * This function returns the action server's internal options struct.
@@ -59,6 +59,13 @@ rcl_action_get_zero_initialized_goal_handle(void);
  * Goal handles are created with rcl_action_accept_new_goal() and destroyed with
  * rcl_action_clear_expired_goals() or rcl_action_server_fini().
  *
+ * An initialized goal handle is safe for concurrent single-writer/multi-reader
+ * use: one thread may transition the state with rcl_action_update_goal_state()
+ * while any number of threads query it with rcl_action_goal_handle_get_status(),
+ * rcl_action_goal_handle_is_active(), and rcl_action_goal_handle_is_cancelable()
+ * without external locking.
+ * Initialization and finalization must still be serialized with all other use.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
@@ -118,13 +125,19 @@ rcl_action_goal_handle_fini(rcl_action_goal_handle_t * goal_handle);
 /**
  * This is a non-blocking call.
  *
+ * The new state is release-stored, so a reader that observes it also observes
+ * everything written while the goal was still in the previous state.
+ * Only one thread may transition a given goal handle at a time; queries from
+ * other threads need no locking.
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Thread-Safe        | Yes [1]
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
+ * <i>[1] against concurrent queries; transitions themselves must come from one thread</i>
  *
  * \param[inout] goal_handle struct containing goal state to transition
  * \param[in] goal_event the event used to transition the goal state
@@ -168,12 +181,15 @@ rcl_action_goal_handle_get_info(
 /**
  * This is a non-blocking call.
  *
+ * The state is loaded relaxed, so status queries never contend with a thread
+ * transitioning the goal with rcl_action_update_goal_state().
+ *
  * <hr>
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] goal_handle struct containing the goal and metadata
@@ -197,8 +213,8 @@ rcl_action_goal_handle_get_status(
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] goal_handle struct containing the goal and metadata
@@ -219,8 +235,8 @@ rcl_action_goal_handle_is_active(const rcl_action_goal_handle_t * goal_handle);
  * Attribute          | Adherence
  * ------------------ | -------------
  * Allocates Memory   | No
- * Thread-Safe        | No
- * Uses Atomics       | No
+ * Thread-Safe        | Yes
+ * Uses Atomics       | Yes
  * Lock-Free          | Yes
  *
  * \param[in] goal_handle struct containing the goal and metadata
@@ -213,6 +213,83 @@ rcl_action_get_status_topic_name(
   rcl_allocator_t allocator,
   char ** status_topic_name);
 
+/// All names derived from one action name, backed by a single allocation.
+typedef struct rcl_action_names_t
+{
+  /// Contiguous buffer holding every derived name.
+  char * buffer;
+  const char * goal_service_name;
+  const char * cancel_service_name;
+  const char * result_service_name;
+  const char * feedback_topic_name;
+  const char * status_topic_name;
+  /// Allocator used to initialize this struct.
+  rcl_allocator_t allocator;
+} rcl_action_names_t;
+
+/// Return a rcl_action_names_t with members set to `NULL`.
+/**
+ * Should be called to get a null rcl_action_names_t before passing to
+ * rcl_action_names_init().
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_action_names_t
+rcl_action_get_zero_initialized_names(void);
+
+/// Get every name derived from an action name in one pass.
+/**
+ * Computes the same names as rcl_action_get_goal_service_name() and friends,
+ * but formats all five into a single contiguous allocation, so callers that
+ * need several of them pay for one allocation instead of five.
+ * The name pointers stay valid until rcl_action_names_fini() is called.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] names a preallocated, zero-initialized, names struct to be initialized
+ * \param[in] action_name The name of the action whose derived names are being returned.
+ * \param[in] allocator A valid allocator to be used.
+ * \return `RCL_RET_OK` if the names were computed successfully, or
+ * \return `RCL_RET_ACTION_NAME_INVALID` if the action name is not valid
+ *   (i.e. empty), or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_names_init(
+  rcl_action_names_t * names,
+  const char * action_name,
+  rcl_allocator_t allocator);
+
+/// Finalize a rcl_action_names_t.
+/**
+ * After calling, the derived name pointers are no longer valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] names the names struct to be deinitialized
+ * \return `RCL_RET_OK` if the names were deinitialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_names_fini(rcl_action_names_t * names);
+
 #ifdef __cplusplus
 }
 #endif
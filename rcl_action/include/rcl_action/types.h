@@ -79,6 +79,30 @@ typedef struct rcl_action_cancel_response_t
   rcl_allocator_t allocator;
 } rcl_action_cancel_response_t;
 
+/// Pool of preallocated storage for action messages.
+/**
+ * Hands out pre-sized goal status arrays and cancel responses with O(1)
+ * acquire and release, so action-heavy nodes do not go to the allocator
+ * for every message.
+ */
+typedef struct rcl_action_message_pool_t
+{
+  /// One contiguous slab backing every pooled buffer.
+  uint8_t * slab;
+  /// Size in bytes of one pooled buffer.
+  size_t buffer_stride;
+  /// Maximum number of entries one pooled buffer can hold.
+  size_t buffer_capacity;
+  /// Total number of pooled buffers.
+  size_t num_buffers;
+  /// Stack of indices of the buffers not currently handed out.
+  size_t * free_indices;
+  /// Number of entries in `free_indices`.
+  size_t num_free;
+  /// Allocator used to initialize this struct and for fallback allocations.
+  rcl_allocator_t allocator;
+} rcl_action_message_pool_t;
+
 /// Goal states
 // TODO(jacobperron): Let states be defined by action_msgs/msg/goal_status.h
 // Ideally, we could use an enum type directly from the message when the feature
@@ -291,6 +315,196 @@ RCL_WARN_UNUSED
 rcl_ret_t
 rcl_action_cancel_response_fini(rcl_action_cancel_response_t * cancel_response);
 
+/// Return a rcl_action_message_pool_t with members set to `NULL`.
+/**
+ * Should be called to get a null rcl_action_message_pool_t before passing to
+ * rcl_action_message_pool_init().
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_action_message_pool_t
+rcl_action_get_zero_initialized_message_pool(void);
+
+/// Initialize a rcl_action_message_pool_t.
+/**
+ * After calling this function on a rcl_action_message_pool_t, goal status
+ * arrays and cancel responses can be acquired from it with
+ * rcl_action_message_pool_acquire_goal_status_array() and
+ * rcl_action_message_pool_acquire_cancel_response() instead of being
+ * initialized with a fresh allocation per use.
+ *
+ * Each of the `num_messages` pooled buffers is sized to hold
+ * `message_capacity` goal status or goal info entries.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Yes
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[out] message_pool a preallocated, zero-initialized, message pool to be initialized
+ * \param[in] num_messages the number of messages to preallocate storage for.
+ *   Must be greater than zero
+ * \param[in] message_capacity the number of entries each pooled message can hold.
+ *   Must be greater than zero
+ * \param[in] allocator a valid allocator
+ * \return `RCL_RET_OK` if the message pool was initialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the message pool has already been initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if allocating memory failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_init(
+  rcl_action_message_pool_t * message_pool,
+  const size_t num_messages,
+  const size_t message_capacity,
+  const rcl_allocator_t allocator);
+
+/// Finalize a rcl_action_message_pool_t.
+/**
+ * After calling, messages acquired from the pool are no longer valid.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] message_pool the message pool to be deinitialized
+ * \return `RCL_RET_OK` if the message pool was deinitialized successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_fini(rcl_action_message_pool_t * message_pool);
+
+/// Acquire a pre-sized rcl_action_goal_status_array_t from a message pool.
+/**
+ * Equivalent to rcl_action_goal_status_array_init(), but the storage comes
+ * from the pool in O(1) when a buffer is available.
+ * If the pool is exhausted, or `num_status` exceeds the pooled buffer
+ * capacity, the storage falls back to the pool's allocator.
+ * In either case the status array must be returned with
+ * rcl_action_message_pool_release_goal_status_array().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when falling back to the allocator</i>
+ *
+ * \param[inout] message_pool the message pool to acquire storage from
+ * \param[out] status_array a preallocated, zero-initialized, goal status array message
+ *   to be initialized
+ * \param[in] num_status the number of status messages to provide space for.
+ *   Must be greater than zero
+ * \return `RCL_RET_OK` if the status array was acquired successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the status array has already been initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if a fallback allocation failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_acquire_goal_status_array(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_goal_status_array_t * status_array,
+  const size_t num_status);
+
+/// Return a rcl_action_goal_status_array_t to the message pool it came from.
+/**
+ * Pooled storage is recycled in O(1); fallback allocations are deallocated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] message_pool the message pool the status array was acquired from
+ * \param[inout] status_array the goal status array message to be released
+ * \return `RCL_RET_OK` if the status array was released successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_release_goal_status_array(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_goal_status_array_t * status_array);
+
+/// Acquire a pre-sized rcl_action_cancel_response_t from a message pool.
+/**
+ * Equivalent to rcl_action_cancel_response_init(), but the storage comes
+ * from the pool in O(1) when a buffer is available.
+ * If the pool is exhausted, or `num_goals_canceling` exceeds the pooled
+ * buffer capacity, the storage falls back to the pool's allocator.
+ * In either case the cancel response must be returned with
+ * rcl_action_message_pool_release_cancel_response().
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | Maybe [1]
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ * <i>[1] only when falling back to the allocator</i>
+ *
+ * \param[inout] message_pool the message pool to acquire storage from
+ * \param[out] cancel_response a preallocated, zero-initialized, cancel response message
+ *   to be initialized
+ * \param[in] num_goals_canceling the number of goals canceling to provide space for.
+ *   Must be greater than zero
+ * \return `RCL_RET_OK` if the cancel response was acquired successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid, or
+ * \return `RCL_RET_ALREADY_INIT` if the cancel response has already been initialized, or
+ * \return `RCL_RET_BAD_ALLOC` if a fallback allocation failed.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_acquire_cancel_response(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_cancel_response_t * cancel_response,
+  const size_t num_goals_canceling);
+
+/// Return a rcl_action_cancel_response_t to the message pool it came from.
+/**
+ * Pooled storage is recycled in O(1); fallback allocations are deallocated.
+ *
+ * <hr>
+ * Attribute          | Adherence
+ * ------------------ | -------------
+ * Allocates Memory   | No
+ * Thread-Safe        | No
+ * Uses Atomics       | No
+ * Lock-Free          | Yes
+ *
+ * \param[inout] message_pool the message pool the cancel response was acquired from
+ * \param[inout] cancel_response the cancel response message to be released
+ * \return `RCL_RET_OK` if the cancel response was released successfully, or
+ * \return `RCL_RET_INVALID_ARGUMENT` if any arguments are invalid.
+ */
+RCL_ACTION_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_action_message_pool_release_cancel_response(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_cancel_response_t * cancel_response);
+
 #ifdef __cplusplus
 }
 #endif
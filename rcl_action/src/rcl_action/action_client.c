@@ -19,6 +19,8 @@ extern "C"
 
 #include "rcl_action/action_client.h"
 
+#include <string.h>
+
 #include "rcl_action/default_qos.h"
 #include "rcl_action/names.h"
 #include "rcl_action/types.h"
@@ -37,6 +39,37 @@ extern "C"
 #include "rmw/types.h"
 
 
+/// Number of service clients an action client registers with a wait set.
+#define RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS 3u
+/// Number of subscriptions an action client registers with a wait set.
+#define RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS 2u
+
+/// Initial slot count of the caller tag tables, sized so tagging stays
+/// allocation free until more than half this many entries are in flight.
+#define RCL_ACTION_CLIENT_INITIAL_TAG_CAPACITY 64u
+
+/// One slot of an open addressing table correlating in-flight requests or
+/// accepted goals with caller supplied tags.
+/**
+ * Sequence number keys occupy the first eight key bytes with the rest zeroed;
+ * goal keys use all UUID_SIZE bytes.
+ */
+typedef struct tag_table_entry_t
+{
+  uint8_t key[UUID_SIZE];
+  void * tag;
+  bool occupied;
+  bool tombstone;
+} tag_table_entry_t;
+
+typedef struct tag_table_t
+{
+  tag_table_entry_t * entries;
+  size_t capacity;  ///< Always a power of two
+  size_t num_occupied;  ///< Entries holding a tag
+  size_t num_used;  ///< Occupied entries plus tombstones
+} tag_table_t;
+
 typedef struct rcl_action_client_impl_t
 {
   rcl_client_t goal_client;
@@ -46,12 +79,27 @@ typedef struct rcl_action_client_impl_t
   rcl_subscription_t status_subscription;
   rcl_action_client_options_t options;
   char * action_name;
+  // Every name derived from the action name, in one allocation
+  rcl_action_names_t names;
   // Wait set records
-  size_t wait_set_goal_client_index;
-  size_t wait_set_cancel_client_index;
-  size_t wait_set_result_client_index;
-  size_t wait_set_feedback_subscription_index;
-  size_t wait_set_status_subscription_index;
+  // Precomputed bundles of the entities registered with a wait set, in the
+  // order their readiness flags are reported, paired with the wait set slots
+  // assigned on the last add
+  const rcl_client_t * wait_set_clients[RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS];
+  size_t wait_set_client_indices[RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS];
+  const rcl_subscription_t * wait_set_subscriptions[RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS];
+  size_t wait_set_subscription_indices[RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS];
+  // Caller supplied tags for in-flight result requests, keyed by sequence
+  // number, and for accepted goals, keyed by goal UUID
+  tag_table_t request_tags;
+  tag_table_t goal_tags;
+  // Goal IDs the client wants status and feedback for; while non-empty, the
+  // take functions drop messages concerning other goals (tags are NULL, the
+  // table is used as a set)
+  tag_table_t goal_id_filters;
+  // Caller registered accessor for the goal ID inside the action specific
+  // feedback message type, or NULL while feedback is not filtered
+  rcl_action_feedback_goal_id_extractor_t feedback_goal_id_extractor;
 } rcl_action_client_impl_t;
 
 rcl_action_client_t
@@ -61,19 +109,154 @@ rcl_action_get_zero_initialized_client(void)
   return null_action_client;
 }
 
+// Implementation only
+static size_t
+_tag_key_hash(const uint8_t * key)
+{
+  // FNV-1a over the 16 key bytes, the same scheme the action server uses
+  // for its goal UUID map
+  size_t hash = (size_t)14695981039346656037ULL;
+  for (size_t i = 0u; i < UUID_SIZE; ++i) {
+    hash ^= (size_t)key[i];
+    hash *= (size_t)1099511628211ULL;
+  }
+  return hash;
+}
+
+// Implementation only
+static void
+_tag_key_from_sequence_number(int64_t sequence_number, uint8_t * key)
+{
+  memset(key, 0, UUID_SIZE);
+  memcpy(key, &sequence_number, sizeof(sequence_number));
+}
+
+// Implementation only
+static rcl_ret_t
+_tag_table_init(tag_table_t * table, size_t capacity_hint, rcl_allocator_t allocator)
+{
+  // Keep the load factor at or below 50% for short probe sequences
+  size_t capacity = 2u;
+  while (capacity < (2u * capacity_hint)) {
+    capacity *= 2u;
+  }
+  table->entries = (tag_table_entry_t *)allocator.zero_allocate(
+    capacity, sizeof(tag_table_entry_t), allocator.state);
+  if (!table->entries) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  table->capacity = capacity;
+  table->num_occupied = 0u;
+  table->num_used = 0u;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static void
+_tag_table_fini(tag_table_t * table, rcl_allocator_t allocator)
+{
+  allocator.deallocate(table->entries, allocator.state);
+  table->entries = NULL;
+  table->capacity = 0u;
+  table->num_occupied = 0u;
+  table->num_used = 0u;
+}
+
+// Implementation only
+static tag_table_entry_t *
+_tag_table_find(const tag_table_t * table, const uint8_t * key)
+{
+  if (0u == table->capacity) {
+    return NULL;
+  }
+  size_t idx = _tag_key_hash(key) & (table->capacity - 1u);
+  while (table->entries[idx].occupied || table->entries[idx].tombstone) {
+    if (table->entries[idx].occupied && uuidcmp(table->entries[idx].key, key)) {
+      return &table->entries[idx];
+    }
+    idx = (idx + 1u) & (table->capacity - 1u);
+  }
+  return NULL;
+}
+
+// Implementation only
+static rcl_ret_t
+_tag_table_insert(
+  tag_table_t * table, const uint8_t * key, void * tag, rcl_allocator_t allocator)
+{
+  tag_table_entry_t * existing = _tag_table_find(table, key);
+  if (NULL != existing) {
+    existing->tag = tag;
+    return RCL_RET_OK;
+  }
+  // Grow when entries plus tombstones reach half the slots; rehashing also
+  // reclaims the tombstones
+  if ((2u * (table->num_used + 1u)) > table->capacity) {
+    tag_table_t new_table;
+    rcl_ret_t ret = _tag_table_init(&new_table, table->num_occupied + 1u, allocator);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+    for (size_t i = 0u; i < table->capacity; ++i) {
+      if (table->entries[i].occupied) {
+        ret = _tag_table_insert(
+          &new_table, table->entries[i].key, table->entries[i].tag, allocator);
+        if (RCL_RET_OK != ret) {
+          _tag_table_fini(&new_table, allocator);
+          return ret;
+        }
+      }
+    }
+    _tag_table_fini(table, allocator);
+    *table = new_table;
+  }
+  size_t idx = _tag_key_hash(key) & (table->capacity - 1u);
+  while (table->entries[idx].occupied) {
+    idx = (idx + 1u) & (table->capacity - 1u);
+  }
+  if (!table->entries[idx].tombstone) {
+    ++table->num_used;
+  }
+  memcpy(table->entries[idx].key, key, UUID_SIZE);
+  table->entries[idx].tag = tag;
+  table->entries[idx].occupied = true;
+  table->entries[idx].tombstone = false;
+  ++table->num_occupied;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static void
+_tag_table_clear(tag_table_t * table)
+{
+  if (0u == table->capacity) {
+    return;
+  }
+  memset(table->entries, 0, table->capacity * sizeof(tag_table_entry_t));
+  table->num_occupied = 0u;
+  table->num_used = 0u;
+}
+
+// Implementation only
+static bool
+_tag_table_remove(tag_table_t * table, const uint8_t * key, void ** tag)
+{
+  tag_table_entry_t * entry = _tag_table_find(table, key);
+  if (NULL == entry) {
+    return false;
+  }
+  if (NULL != tag) {
+    *tag = entry->tag;
+  }
+  entry->tag = NULL;
+  entry->occupied = false;
+  entry->tombstone = true;
+  --table->num_occupied;
+  return true;
+}
+
 // \internal Initializes an action client specific service client.
 #define CLIENT_INIT(Type) \
-  char * Type ## _service_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _service_name(action_name, allocator, &Type ## _service_name); \
-  if (RCL_RET_OK != ret) { \
-    RCL_SET_ERROR_MSG("failed to get " #Type " service name"); \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_client_options_t Type ## _service_client_options = { \
     .qos = options->Type ## _service_qos, .allocator = allocator \
   }; \
@@ -82,9 +265,8 @@ rcl_action_get_zero_initialized_client(void)
     &action_client->impl->Type ## _client, \
     node, \
     type_support->Type ## _service_type_support, \
-    Type ## _service_name, \
+    action_client->impl->names.Type ## _service_name, \
     &Type ## _service_client_options); \
-  allocator.deallocate(Type ## _service_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -98,17 +280,6 @@ rcl_action_get_zero_initialized_client(void)
 
 // \internal Initializes an action client specific topic subscription.
 #define SUBSCRIPTION_INIT(Type) \
-  char * Type ## _topic_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _topic_name(action_name, allocator, &Type ## _topic_name); \
-  if (RCL_RET_OK != ret) { \
-    RCL_SET_ERROR_MSG("failed to get " #Type " topic name"); \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_subscription_options_t Type ## _topic_subscription_options = { \
     .qos = options->Type ## _topic_qos, \
     .ignore_local_publications = false, \
@@ -119,9 +290,8 @@ rcl_action_get_zero_initialized_client(void)
     &action_client->impl->Type ## _subscription, \
     node, \
     type_support->Type ## _message_type_support, \
-    Type ## _topic_name, \
+    action_client->impl->names.Type ## _topic_name, \
     &Type ## _topic_subscription_options); \
-  allocator.deallocate(Type ## _topic_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -165,6 +335,14 @@ rcl_action_client_init(
     action_client->impl, "allocating memory failed", return RCL_RET_BAD_ALLOC);
 
   // Copy action client name and options.
+  action_client->impl->names = rcl_action_get_zero_initialized_names();
+  action_client->impl->request_tags.entries = NULL;
+  action_client->impl->request_tags.capacity = 0u;
+  action_client->impl->request_tags.num_occupied = 0u;
+  action_client->impl->request_tags.num_used = 0u;
+  action_client->impl->goal_tags = action_client->impl->request_tags;
+  action_client->impl->goal_id_filters = action_client->impl->request_tags;
+  action_client->impl->feedback_goal_id_extractor = NULL;
   action_client->impl->action_name = rcutils_strdup(action_name, allocator);
   if (NULL == action_client->impl->action_name) {
     ret = RCL_RET_BAD_ALLOC;
@@ -172,6 +350,34 @@ rcl_action_client_init(
   }
   action_client->impl->options = *options;
 
+  // Derive every service and topic name in one pass.
+  ret = rcl_action_names_init(&action_client->impl->names, action_name, allocator);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("failed to get action service and topic names");
+    if (RCL_RET_BAD_ALLOC != ret && RCL_RET_ACTION_NAME_INVALID != ret) {
+      ret = RCL_RET_ERROR;
+    }
+    goto fail;
+  }
+
+  // Preallocate the caller tag tables so steady state correlation does not
+  // allocate.
+  ret = _tag_table_init(
+    &action_client->impl->request_tags, RCL_ACTION_CLIENT_INITIAL_TAG_CAPACITY, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+  ret = _tag_table_init(
+    &action_client->impl->goal_tags, RCL_ACTION_CLIENT_INITIAL_TAG_CAPACITY, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+  ret = _tag_table_init(
+    &action_client->impl->goal_id_filters, RCL_ACTION_CLIENT_INITIAL_TAG_CAPACITY, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+
   // Initialize action service clients.
   CLIENT_INIT(goal);
   CLIENT_INIT(cancel);
@@ -181,6 +387,14 @@ rcl_action_client_init(
   SUBSCRIPTION_INIT(feedback);
   SUBSCRIPTION_INIT(status);
 
+  // Precompute the wait set bundles; impl is heap allocated, so these
+  // pointers stay valid for the lifetime of the action client
+  action_client->impl->wait_set_clients[0] = &action_client->impl->goal_client;
+  action_client->impl->wait_set_clients[1] = &action_client->impl->cancel_client;
+  action_client->impl->wait_set_clients[2] = &action_client->impl->result_client;
+  action_client->impl->wait_set_subscriptions[0] = &action_client->impl->feedback_subscription;
+  action_client->impl->wait_set_subscriptions[1] = &action_client->impl->status_subscription;
+
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action client initialized");
   return ret;
 fail:
@@ -220,6 +434,12 @@ rcl_action_client_fini(rcl_action_client_t * action_client, rcl_node_t * node)
   }
   rcl_allocator_t * allocator = &action_client->impl->options.allocator;
   allocator->deallocate(action_client->impl->action_name, allocator->state);
+  if (RCL_RET_OK != rcl_action_names_fini(&action_client->impl->names)) {
+    ret = RCL_RET_ERROR;
+  }
+  _tag_table_fini(&action_client->impl->request_tags, *allocator);
+  _tag_table_fini(&action_client->impl->goal_tags, *allocator);
+  _tag_table_fini(&action_client->impl->goal_id_filters, *allocator);
   allocator->deallocate(action_client->impl, allocator->state);
   action_client->impl = NULL;
   RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action client finalized");
@@ -314,6 +534,53 @@ rcl_action_take_result_response(
   TAKE_SERVICE_RESPONSE(result, response_header, ros_result_response);
 }
 
+rcl_ret_t
+rcl_action_send_result_request_tagged(
+  const rcl_action_client_t * action_client,
+  const void * ros_result_request,
+  int64_t * sequence_number,
+  void * tag)
+{
+  rcl_ret_t ret = rcl_action_send_result_request(
+    action_client, ros_result_request, sequence_number);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  uint8_t key[UUID_SIZE];
+  _tag_key_from_sequence_number(*sequence_number, key);
+  ret = _tag_table_insert(
+    &action_client->impl->request_tags, key, tag,
+    action_client->impl->options.allocator);
+  if (RCL_RET_OK != ret) {
+    // The request went out, but the response cannot be tagged
+    RCL_SET_ERROR_MSG("failed to record tag for result request");
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_take_result_response_tagged(
+  const rcl_action_client_t * action_client,
+  rmw_request_id_t * response_header,
+  void * ros_result_response,
+  void ** tag)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(tag, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = rcl_action_take_result_response(
+    action_client, response_header, ros_result_response);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  uint8_t key[UUID_SIZE];
+  _tag_key_from_sequence_number(response_header->sequence_number, key);
+  if (!_tag_table_remove(&action_client->impl->request_tags, key, tag)) {
+    // The request was not sent with the tagged variant
+    *tag = NULL;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_action_send_cancel_request(
   const rcl_action_client_t * action_client,
@@ -332,34 +599,120 @@ rcl_action_take_cancel_response(
   TAKE_SERVICE_RESPONSE(cancel, response_header, ros_cancel_response);
 }
 
-// \internal Takes an action client specific topic message.
-#define TAKE_MESSAGE(Type) \
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking action " #Type); \
-  if (!rcl_action_client_is_valid(action_client)) { \
-    return RCL_RET_ACTION_CLIENT_INVALID;  /* error already set */ \
-  } \
-  RCL_CHECK_ARGUMENT_FOR_NULL(ros_ ## Type, RCL_RET_INVALID_ARGUMENT); \
-  rmw_message_info_t message_info; /* ignored */ \
-  rcl_ret_t ret = rcl_take( \
-    &action_client->impl->Type ## _subscription, ros_ ## Type, &message_info); \
-  if (RCL_RET_OK != ret) { \
-    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) { \
-      return RCL_RET_ACTION_CLIENT_TAKE_FAILED; \
-    } \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      return RCL_RET_BAD_ALLOC; \
-    } \
-    return RCL_RET_ERROR; \
-  } \
-  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action " #Type " taken"); \
+// \internal Takes one action client specific topic message, mapping the
+// subscription return codes onto the action client ones.
+static rcl_ret_t
+_take_message(const rcl_subscription_t * subscription, void * ros_message)
+{
+  rmw_message_info_t message_info;  // ignored
+  rcl_ret_t ret = rcl_take(subscription, ros_message, &message_info);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      return RCL_RET_ACTION_CLIENT_TAKE_FAILED;
+    }
+    if (RCL_RET_BAD_ALLOC == ret) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RCL_RET_ERROR;
+  }
   return RCL_RET_OK;
+}
+
+// Implementation only
+static bool
+_goal_id_filters_active(const rcl_action_client_impl_t * impl)
+{
+  return impl->goal_id_filters.num_occupied > 0u;
+}
+
+// Implementation only
+static bool
+_goal_id_filter_match(const rcl_action_client_impl_t * impl, const uint8_t * uuid)
+{
+  return NULL != _tag_table_find(&impl->goal_id_filters, uuid);
+}
 
 rcl_ret_t
 rcl_action_take_feedback(
   const rcl_action_client_t * action_client,
   void * ros_feedback)
 {
-  TAKE_MESSAGE(feedback);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking action feedback");
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_client_impl_t * impl = action_client->impl;
+  for (;;) {
+    rcl_ret_t ret = _take_message(&impl->feedback_subscription, ros_feedback);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set, including take failed once drained
+    }
+    if (!_goal_id_filters_active(impl) || NULL == impl->feedback_goal_id_extractor) {
+      break;
+    }
+    const uint8_t * uuid = impl->feedback_goal_id_extractor(ros_feedback);
+    if (NULL == uuid || _goal_id_filter_match(impl, uuid)) {
+      break;
+    }
+    // feedback for a goal the client is not interested in; drop it and
+    // take the next message
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action feedback taken");
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_take_feedback_batch(
+  const rcl_action_client_t * action_client,
+  void ** ros_feedback_messages,
+  size_t capacity,
+  size_t * taken)
+{
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking batch of action feedback");
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  // rcl_take_batch() null-checks the arrays and each message itself.
+  rcl_ret_t ret = rcl_take_batch(
+    &action_client->impl->feedback_subscription,
+    ros_feedback_messages, capacity, taken, NULL);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      return RCL_RET_ACTION_CLIENT_TAKE_FAILED;
+    }
+    if (RCL_RET_BAD_ALLOC == ret) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    if (RCL_RET_INVALID_ARGUMENT == ret) {
+      return RCL_RET_INVALID_ARGUMENT;  // error already set
+    }
+    return RCL_RET_ERROR;
+  }
+  rcl_action_client_impl_t * impl = action_client->impl;
+  if (_goal_id_filters_active(impl) && NULL != impl->feedback_goal_id_extractor) {
+    // Partition the filtered messages out of the prefix; the caller's
+    // preallocated messages are all still in the array, just reordered.
+    size_t num_kept = 0u;
+    for (size_t i = 0u; i < *taken; ++i) {
+      const uint8_t * uuid = impl->feedback_goal_id_extractor(ros_feedback_messages[i]);
+      if (NULL == uuid || _goal_id_filter_match(impl, uuid)) {
+        if (num_kept != i) {
+          void * swap = ros_feedback_messages[num_kept];
+          ros_feedback_messages[num_kept] = ros_feedback_messages[i];
+          ros_feedback_messages[i] = swap;
+        }
+        ++num_kept;
+      }
+    }
+    *taken = num_kept;
+    if (0u == num_kept) {
+      return RCL_RET_ACTION_CLIENT_TAKE_FAILED;
+    }
+  }
+  RCUTILS_LOG_DEBUG_NAMED(
+    ROS_PACKAGE_NAME, "Action feedback batch took %zu messages", *taken);
+  return RCL_RET_OK;
 }
 
 rcl_ret_t
@@ -367,7 +720,150 @@ rcl_action_take_status(
   const rcl_action_client_t * action_client,
   void * ros_status)
 {
-  TAKE_MESSAGE(status);
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Taking action status");
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_status, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_client_impl_t * impl = action_client->impl;
+  rcl_ret_t ret = _take_message(&impl->status_subscription, ros_status);
+  if (RCL_RET_OK != ret) {
+    return ret;  // error already set
+  }
+  if (_goal_id_filters_active(impl)) {
+    // The status topic carries action_msgs/GoalStatusArray regardless of the
+    // action type, so the array can be compacted down to the filtered goals
+    // in place; the entries are plain data.
+    action_msgs__msg__GoalStatusArray * status_array =
+      (action_msgs__msg__GoalStatusArray *)ros_status;
+    size_t num_kept = 0u;
+    for (size_t i = 0u; i < status_array->status_list.size; ++i) {
+      if (_goal_id_filter_match(impl, status_array->status_list.data[i].goal_info.uuid)) {
+        if (num_kept != i) {
+          status_array->status_list.data[num_kept] = status_array->status_list.data[i];
+        }
+        ++num_kept;
+      }
+    }
+    status_array->status_list.size = num_kept;
+  }
+  RCUTILS_LOG_DEBUG_NAMED(ROS_PACKAGE_NAME, "Action status taken");
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_set_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info,
+  void * tag)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = _tag_table_insert(
+    &action_client->impl->goal_tags, goal_info->uuid, tag,
+    action_client->impl->options.allocator);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("failed to record tag for goal");
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_get_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info,
+  void ** tag)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(tag, RCL_RET_INVALID_ARGUMENT);
+  const tag_table_entry_t * entry =
+    _tag_table_find(&action_client->impl->goal_tags, goal_info->uuid);
+  if (NULL == entry) {
+    RCL_SET_ERROR_MSG("no tag recorded for goal");
+    return RCL_RET_ERROR;
+  }
+  *tag = entry->tag;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_remove_goal_tag(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  if (!_tag_table_remove(&action_client->impl->goal_tags, goal_info->uuid, NULL)) {
+    RCL_SET_ERROR_MSG("no tag recorded for goal");
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_add_goal_id_filter(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  rcl_ret_t ret = _tag_table_insert(
+    &action_client->impl->goal_id_filters, goal_info->uuid, NULL,
+    action_client->impl->options.allocator);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("failed to record goal ID filter");
+    return RCL_RET_BAD_ALLOC;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_remove_goal_id_filter(
+  const rcl_action_client_t * action_client,
+  const rcl_action_goal_info_t * goal_info)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  if (!_tag_table_remove(&action_client->impl->goal_id_filters, goal_info->uuid, NULL)) {
+    RCL_SET_ERROR_MSG("no filter registered for goal ID");
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_clear_goal_id_filters(
+  const rcl_action_client_t * action_client)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  _tag_table_clear(&action_client->impl->goal_id_filters);
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_client_set_feedback_goal_id_extractor(
+  const rcl_action_client_t * action_client,
+  rcl_action_feedback_goal_id_extractor_t extractor)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
+  }
+  action_client->impl->feedback_goal_id_extractor = extractor;
+  return RCL_RET_OK;
 }
 
 const char *
@@ -379,6 +875,15 @@ rcl_action_client_get_action_name(const rcl_action_client_t * action_client)
   return action_client->impl->action_name;
 }
 
+const rcl_action_names_t *
+rcl_action_client_get_names(const rcl_action_client_t * action_client)
+{
+  if (!rcl_action_client_is_valid(action_client)) {
+    return NULL;  // error already set
+  }
+  return &action_client->impl->names;
+}
+
 const rcl_action_client_options_t *
 rcl_action_client_get_options(const rcl_action_client_t * action_client)
 {
@@ -436,54 +941,32 @@ rcl_action_wait_set_add_action_client(
     return RCL_RET_ACTION_CLIENT_INVALID;  // error already set
   }
 
-  // Wait on action goal service response messages.
-  ret = rcl_wait_set_add_client(
-    wait_set,
-    &action_client->impl->goal_client,
-    &action_client->impl->wait_set_goal_client_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-  // Wait on action cancel service response messages.
-  ret = rcl_wait_set_add_client(
-    wait_set,
-    &action_client->impl->cancel_client,
-    &action_client->impl->wait_set_cancel_client_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
+  // Splice in the precomputed bundles as one batch.
+  // Wait on action goal, cancel and result service response messages.
+  rcl_action_client_impl_t * impl = action_client->impl;
+  for (size_t i = 0u; i < RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS; ++i) {
+    ret = rcl_wait_set_add_client(
+      wait_set, impl->wait_set_clients[i], &impl->wait_set_client_indices[i]);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
   }
-  // Wait on action result service response messages.
-  ret = rcl_wait_set_add_client(
-    wait_set,
-    &action_client->impl->result_client,
-    &action_client->impl->wait_set_result_client_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-  // Wait on action feedback messages.
-  ret = rcl_wait_set_add_subscription(
-    wait_set,
-    &action_client->impl->feedback_subscription,
-    &action_client->impl->wait_set_feedback_subscription_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-  // Wait on action status messages.
-  ret = rcl_wait_set_add_subscription(
-    wait_set,
-    &action_client->impl->status_subscription,
-    &action_client->impl->wait_set_status_subscription_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
+  // Wait on action feedback and status messages.
+  for (size_t i = 0u; i < RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS; ++i) {
+    ret = rcl_wait_set_add_subscription(
+      wait_set, impl->wait_set_subscriptions[i], &impl->wait_set_subscription_indices[i]);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
   }
 
   if (NULL != client_index) {
     // The goal client was the first added
-    *client_index = action_client->impl->wait_set_goal_client_index;
+    *client_index = impl->wait_set_client_indices[0];
   }
   if (NULL != subscription_index) {
     // The feedback subscription was the first added
-    *subscription_index = action_client->impl->wait_set_feedback_subscription_index;
+    *subscription_index = impl->wait_set_subscription_indices[0];
   }
   return RCL_RET_OK;
 }
@@ -534,42 +1017,29 @@ rcl_action_client_wait_set_get_entities_ready(
   RCL_CHECK_ARGUMENT_FOR_NULL(is_result_response_ready, RCL_RET_INVALID_ARGUMENT);
 
   const rcl_action_client_impl_t * impl = action_client->impl;
-  const size_t feedback_index = impl->wait_set_feedback_subscription_index;
-  const size_t status_index = impl->wait_set_status_subscription_index;
-  const size_t goal_index = impl->wait_set_goal_client_index;
-  const size_t cancel_index = impl->wait_set_cancel_client_index;
-  const size_t result_index = impl->wait_set_result_client_index;
-  if (feedback_index >= wait_set->size_of_subscriptions) {
-    RCL_SET_ERROR_MSG("wait set index for feedback subscription is out of bounds");
-    return RCL_RET_ERROR;
+  // Classify readiness with one table lookup per bundled entity
+  bool * const subscription_ready_flags[RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS] = {
+    is_feedback_ready, is_status_ready};
+  bool * const client_ready_flags[RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS] = {
+    is_goal_response_ready, is_cancel_response_ready, is_result_response_ready};
+  for (size_t i = 0u; i < RCL_ACTION_CLIENT_NUM_WAIT_SET_SUBSCRIPTIONS; ++i) {
+    const size_t subscription_index = impl->wait_set_subscription_indices[i];
+    if (subscription_index >= wait_set->size_of_subscriptions) {
+      RCL_SET_ERROR_MSG("wait set index for subscription is out of bounds");
+      return RCL_RET_ERROR;
+    }
+    *subscription_ready_flags[i] =
+      (impl->wait_set_subscriptions[i] == wait_set->subscriptions[subscription_index]);
   }
-  if (status_index >= wait_set->size_of_subscriptions) {
-    RCL_SET_ERROR_MSG("wait set index for status subscription is out of bounds");
-    return RCL_RET_ERROR;
+  for (size_t i = 0u; i < RCL_ACTION_CLIENT_NUM_WAIT_SET_CLIENTS; ++i) {
+    const size_t client_index = impl->wait_set_client_indices[i];
+    if (client_index >= wait_set->size_of_clients) {
+      RCL_SET_ERROR_MSG("wait set index for client is out of bounds");
+      return RCL_RET_ERROR;
+    }
+    *client_ready_flags[i] =
+      (impl->wait_set_clients[i] == wait_set->clients[client_index]);
   }
-  if (goal_index >= wait_set->size_of_clients) {
-    RCL_SET_ERROR_MSG("wait set index for goal client is out of bounds");
-    return RCL_RET_ERROR;
-  }
-  if (cancel_index >= wait_set->size_of_clients) {
-    RCL_SET_ERROR_MSG("wait set index for cancel client is out of bounds");
-    return RCL_RET_ERROR;
-  }
-  if (result_index >= wait_set->size_of_clients) {
-    RCL_SET_ERROR_MSG("wait set index for result client is out of bounds");
-    return RCL_RET_ERROR;
-  }
-
-  const rcl_subscription_t * feedback_subscription = wait_set->subscriptions[feedback_index];
-  const rcl_subscription_t * status_subscription = wait_set->subscriptions[status_index];
-  const rcl_client_t * goal_client = wait_set->clients[goal_index];
-  const rcl_client_t * cancel_client = wait_set->clients[cancel_index];
-  const rcl_client_t * result_client = wait_set->clients[result_index];
-  *is_feedback_ready = (&impl->feedback_subscription == feedback_subscription);
-  *is_status_ready = (&impl->status_subscription == status_subscription);
-  *is_goal_response_ready = (&impl->goal_client == goal_client);
-  *is_cancel_response_ready = (&impl->cancel_client == cancel_client);
-  *is_result_response_ready = (&impl->result_client == result_client);
   return RCL_RET_OK;
 }
 
@@ -19,6 +19,8 @@ extern "C"
 
 #include "rcl_action/action_server.h"
 
+#include <string.h>
+
 #include "rcl_action/default_qos.h"
 #include "rcl_action/goal_handle.h"
 #include "rcl_action/names.h"
@@ -34,6 +36,54 @@ extern "C"
 
 #include "rmw/rmw.h"
 
+/// One slot of the UUID to goal handle hash map.
+typedef struct goal_uuid_map_entry_t
+{
+  uint8_t uuid[UUID_SIZE];
+  rcl_action_goal_handle_t * goal_handle;  ///< NULL when the slot holds no goal
+  bool tombstone;  ///< Slot freed by a removal; probe sequences continue past it
+} goal_uuid_map_entry_t;
+
+/// Open-addressing hash map from goal UUID to live goal handle.
+/**
+ * Kept in sync with the goal handle array so that duplicate-goal checks and
+ * cancel-by-UUID lookups do not scale with the number of live goals.
+ */
+typedef struct goal_uuid_map_t
+{
+  goal_uuid_map_entry_t * entries;
+  size_t capacity;  ///< Number of slots; always a power of two
+  size_t num_occupied;  ///< Slots holding a goal
+  size_t num_used;  ///< Slots holding a goal or a tombstone
+} goal_uuid_map_t;
+
+/// Number of services an action server registers with a wait set.
+#define RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES 3u
+
+/// One entry of the goal expiry deadline heap.
+typedef struct goal_deadline_t
+{
+  int64_t deadline;  ///< Time at which the goal's result expires
+  rcl_action_goal_handle_t * goal_handle;
+} goal_deadline_t;
+
+/// Requesters waiting on the result of one goal.
+typedef struct goal_result_requesters_t
+{
+  uint8_t uuid[UUID_SIZE];
+  rmw_request_id_t * headers;
+  size_t num_headers;
+  size_t header_capacity;
+} goal_result_requesters_t;
+
+/// Per-goal snapshot used while resolving cancel requests.
+typedef struct cancel_scratch_entry_t
+{
+  rcl_action_goal_info_t info;
+  int64_t nanosec;
+  bool cancelable;
+} cancel_scratch_entry_t;
+
 /// Internal rcl_action implementation struct.
 typedef struct rcl_action_server_impl_t
 {
@@ -44,16 +94,46 @@ typedef struct rcl_action_server_impl_t
   rcl_publisher_t status_publisher;
   rcl_timer_t expire_timer;
   char * action_name;
+  // Every name derived from the action name, in one allocation
+  rcl_action_names_t names;
   rcl_action_server_options_t options;
   // Array of goal handles
   rcl_action_goal_handle_t ** goal_handles;
   size_t num_goal_handles;
+  // Allocated length of goal_handles and free_goal_handles
+  size_t goal_handle_capacity;
+  // Recycled goal handle allocations, reused by the next accepted goal
+  rcl_action_goal_handle_t ** free_goal_handles;
+  size_t num_free_goal_handles;
+  // Hash map from goal UUID to live goal handle
+  goal_uuid_map_t goal_map;
+  // Min-heap of expiry deadlines over the inactive goals
+  goal_deadline_t * expire_heap;
+  size_t expire_heap_size;
+  // Persistent status array lent out by rcl_action_get_goal_status_array();
+  // entry i mirrors goal_handles[i], so only status codes are refreshed on read
+  rcl_action_goal_status_t * goal_statuses;
+  // Result requesters recorded per goal while the result is pending; one
+  // rcl_action_send_deferred_result_responses() answers the whole batch
+  goal_result_requesters_t * result_requesters;
+  size_t num_result_requesters;
+  size_t result_requester_capacity;
+  // Scratch reused across cancel request processing; holds one snapshot of
+  // the goal table so a batch of requests resolves against a single scan
+  cancel_scratch_entry_t * cancel_scratch;
+  size_t cancel_scratch_capacity;
+  // Coalesced status publishing: set when a publication was deferred inside
+  // the rate limit window, see rcl_action_publish_status()
+  bool status_dirty;
+  rcl_time_point_value_t last_status_publish_time;
   // Clock
   rcl_clock_t clock;
   // Wait set records
-  size_t wait_set_goal_service_index;
-  size_t wait_set_cancel_service_index;
-  size_t wait_set_result_service_index;
+  // Precomputed bundle of the services registered with a wait set, in the
+  // order their readiness flags are reported, paired with the wait set slots
+  // assigned on the last add
+  const rcl_service_t * wait_set_services[RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES];
+  size_t wait_set_service_indices[RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES];
   size_t wait_set_expire_timer_index;
 } rcl_action_server_impl_t;
 
@@ -64,19 +144,130 @@ rcl_action_get_zero_initialized_server(void)
   return null_action_server;
 }
 
+// Implementation only
+static size_t
+_goal_uuid_hash(const uint8_t * uuid)
+{
+  // FNV-1a over the 16 UUID bytes
+  size_t hash = (size_t)14695981039346656037ULL;
+  for (size_t i = 0u; i < UUID_SIZE; ++i) {
+    hash ^= (size_t)uuid[i];
+    hash *= (size_t)1099511628211ULL;
+  }
+  return hash;
+}
+
+// Implementation only
+static rcl_ret_t
+_goal_uuid_map_init(goal_uuid_map_t * map, size_t capacity_hint, rcl_allocator_t allocator)
+{
+  // Keep the load factor at or below 50% for short probe sequences
+  size_t capacity = 2u;
+  while (capacity < (2u * capacity_hint)) {
+    capacity *= 2u;
+  }
+  map->entries = (goal_uuid_map_entry_t *)allocator.zero_allocate(
+    capacity, sizeof(goal_uuid_map_entry_t), allocator.state);
+  if (!map->entries) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  map->capacity = capacity;
+  map->num_occupied = 0u;
+  map->num_used = 0u;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static void
+_goal_uuid_map_fini(goal_uuid_map_t * map, rcl_allocator_t allocator)
+{
+  allocator.deallocate(map->entries, allocator.state);
+  map->entries = NULL;
+  map->capacity = 0u;
+  map->num_occupied = 0u;
+  map->num_used = 0u;
+}
+
+// Implementation only
+static rcl_action_goal_handle_t *
+_goal_uuid_map_lookup(const goal_uuid_map_t * map, const uint8_t * uuid)
+{
+  if (0u == map->capacity) {
+    return NULL;
+  }
+  size_t idx = _goal_uuid_hash(uuid) & (map->capacity - 1u);
+  while (NULL != map->entries[idx].goal_handle || map->entries[idx].tombstone) {
+    if (NULL != map->entries[idx].goal_handle && uuidcmp(map->entries[idx].uuid, uuid)) {
+      return map->entries[idx].goal_handle;
+    }
+    idx = (idx + 1u) & (map->capacity - 1u);
+  }
+  return NULL;
+}
+
+// Implementation only
+static rcl_ret_t
+_goal_uuid_map_insert(
+  goal_uuid_map_t * map,
+  const uint8_t * uuid,
+  rcl_action_goal_handle_t * goal_handle,
+  rcl_allocator_t allocator)
+{
+  // Grow when goals plus tombstones reach half the slots; rehashing also
+  // reclaims the tombstones
+  if ((2u * (map->num_used + 1u)) > map->capacity) {
+    goal_uuid_map_t new_map;
+    rcl_ret_t ret = _goal_uuid_map_init(&new_map, map->num_occupied + 1u, allocator);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+    for (size_t i = 0u; i < map->capacity; ++i) {
+      if (NULL != map->entries[i].goal_handle) {
+        ret = _goal_uuid_map_insert(
+          &new_map, map->entries[i].uuid, map->entries[i].goal_handle, allocator);
+        if (RCL_RET_OK != ret) {
+          _goal_uuid_map_fini(&new_map, allocator);
+          return ret;
+        }
+      }
+    }
+    _goal_uuid_map_fini(map, allocator);
+    *map = new_map;
+  }
+  size_t idx = _goal_uuid_hash(uuid) & (map->capacity - 1u);
+  while (NULL != map->entries[idx].goal_handle) {
+    idx = (idx + 1u) & (map->capacity - 1u);
+  }
+  if (!map->entries[idx].tombstone) {
+    ++map->num_used;
+  }
+  memcpy(map->entries[idx].uuid, uuid, UUID_SIZE);
+  map->entries[idx].goal_handle = goal_handle;
+  map->entries[idx].tombstone = false;
+  ++map->num_occupied;
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static void
+_goal_uuid_map_remove(goal_uuid_map_t * map, const uint8_t * uuid)
+{
+  if (0u == map->capacity) {
+    return;
+  }
+  size_t idx = _goal_uuid_hash(uuid) & (map->capacity - 1u);
+  while (NULL != map->entries[idx].goal_handle || map->entries[idx].tombstone) {
+    if (NULL != map->entries[idx].goal_handle && uuidcmp(map->entries[idx].uuid, uuid)) {
+      map->entries[idx].goal_handle = NULL;
+      map->entries[idx].tombstone = true;
+      --map->num_occupied;
+      return;
+    }
+    idx = (idx + 1u) & (map->capacity - 1u);
+  }
+}
+
 #define SERVICE_INIT(Type) \
-  char * Type ## _service_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _service_name(action_name, allocator, &Type ## _service_name); \
-  if (RCL_RET_OK != ret) { \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else if (RCL_RET_ACTION_NAME_INVALID == ret) { \
-      ret = RCL_RET_ACTION_NAME_INVALID; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_service_options_t Type ## _service_options = { \
     .qos = options->Type ## _service_qos, .allocator = allocator \
   }; \
@@ -84,9 +275,8 @@ rcl_action_get_zero_initialized_server(void)
     &action_server->impl->Type ## _service, \
     node, \
     type_support->Type ## _service_type_support, \
-    Type ## _service_name, \
+    action_server->impl->names.Type ## _service_name, \
     &Type ## _service_options); \
-  allocator.deallocate(Type ## _service_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -99,18 +289,6 @@ rcl_action_get_zero_initialized_server(void)
   }
 
 #define PUBLISHER_INIT(Type) \
-  char * Type ## _topic_name = NULL; \
-  ret = rcl_action_get_ ## Type ## _topic_name(action_name, allocator, &Type ## _topic_name); \
-  if (RCL_RET_OK != ret) { \
-    if (RCL_RET_BAD_ALLOC == ret) { \
-      ret = RCL_RET_BAD_ALLOC; \
-    } else if (RCL_RET_ACTION_NAME_INVALID == ret) { \
-      ret = RCL_RET_ACTION_NAME_INVALID; \
-    } else { \
-      ret = RCL_RET_ERROR; \
-    } \
-    goto fail; \
-  } \
   rcl_publisher_options_t Type ## _publisher_options = { \
     .qos = options->Type ## _topic_qos, .allocator = allocator \
   }; \
@@ -118,9 +296,8 @@ rcl_action_get_zero_initialized_server(void)
     &action_server->impl->Type ## _publisher, \
     node, \
     type_support->Type ## _message_type_support, \
-    Type ## _topic_name, \
+    action_server->impl->names.Type ## _topic_name, \
     &Type ## _publisher_options); \
-  allocator.deallocate(Type ## _topic_name, allocator.state); \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_BAD_ALLOC == ret) { \
       ret = RCL_RET_BAD_ALLOC; \
@@ -176,17 +353,86 @@ rcl_action_server_init(
   action_server->impl->feedback_publisher = rcl_get_zero_initialized_publisher();
   action_server->impl->status_publisher = rcl_get_zero_initialized_publisher();
   action_server->impl->action_name = NULL;
+  action_server->impl->names = rcl_action_get_zero_initialized_names();
   action_server->impl->options = *options;  // copy options
   action_server->impl->goal_handles = NULL;
   action_server->impl->num_goal_handles = 0u;
+  action_server->impl->goal_handle_capacity = 0u;
+  action_server->impl->free_goal_handles = NULL;
+  action_server->impl->num_free_goal_handles = 0u;
+  action_server->impl->goal_map.entries = NULL;
+  action_server->impl->goal_map.capacity = 0u;
+  action_server->impl->goal_map.num_occupied = 0u;
+  action_server->impl->goal_map.num_used = 0u;
+  action_server->impl->expire_heap = NULL;
+  action_server->impl->expire_heap_size = 0u;
+  action_server->impl->goal_statuses = NULL;
+  action_server->impl->result_requesters = NULL;
+  action_server->impl->num_result_requesters = 0u;
+  action_server->impl->result_requester_capacity = 0u;
+  action_server->impl->cancel_scratch = NULL;
+  action_server->impl->cancel_scratch_capacity = 0u;
+  action_server->impl->status_dirty = false;
+  action_server->impl->last_status_publish_time = 0;
   action_server->impl->clock.type = RCL_CLOCK_UNINITIALIZED;
 
   rcl_ret_t ret = RCL_RET_OK;
+
+  // Preallocate goal handle storage and the UUID map so steady-state goal
+  // acceptance does not go to the allocator
+  size_t goal_handle_capacity = options->goal_handle_capacity;
+  if (0u == goal_handle_capacity) {
+    goal_handle_capacity = 1u;
+  }
+  action_server->impl->goal_handles = (rcl_action_goal_handle_t **)allocator.zero_allocate(
+    goal_handle_capacity, sizeof(rcl_action_goal_handle_t *), allocator.state);
+  if (!action_server->impl->goal_handles) {
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  action_server->impl->free_goal_handles = (rcl_action_goal_handle_t **)allocator.zero_allocate(
+    goal_handle_capacity, sizeof(rcl_action_goal_handle_t *), allocator.state);
+  if (!action_server->impl->free_goal_handles) {
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  action_server->impl->expire_heap = (goal_deadline_t *)allocator.zero_allocate(
+    goal_handle_capacity, sizeof(goal_deadline_t), allocator.state);
+  if (!action_server->impl->expire_heap) {
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  action_server->impl->goal_statuses = (rcl_action_goal_status_t *)allocator.zero_allocate(
+    goal_handle_capacity, sizeof(rcl_action_goal_status_t), allocator.state);
+  if (!action_server->impl->goal_statuses) {
+    ret = RCL_RET_BAD_ALLOC;
+    goto fail;
+  }
+  action_server->impl->goal_handle_capacity = goal_handle_capacity;
+  ret = _goal_uuid_map_init(&action_server->impl->goal_map, goal_handle_capacity, allocator);
+  if (RCL_RET_OK != ret) {
+    goto fail;
+  }
+  // Derive every service and topic name in one pass
+  ret = rcl_action_names_init(&action_server->impl->names, action_name, allocator);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_BAD_ALLOC != ret && RCL_RET_ACTION_NAME_INVALID != ret) {
+      ret = RCL_RET_ERROR;
+    }
+    goto fail;
+  }
+
   // Initialize services
   SERVICE_INIT(goal);
   SERVICE_INIT(cancel);
   SERVICE_INIT(result);
 
+  // Precompute the wait set bundle; impl is heap allocated, so these pointers
+  // stay valid for the lifetime of the action server
+  action_server->impl->wait_set_services[0] = &action_server->impl->goal_service;
+  action_server->impl->wait_set_services[1] = &action_server->impl->cancel_service;
+  action_server->impl->wait_set_services[2] = &action_server->impl->result_service;
+
   // Initialize publishers
   PUBLISHER_INIT(feedback);
   PUBLISHER_INIT(status);
@@ -262,12 +508,35 @@ rcl_action_server_fini(rcl_action_server_t * action_server, rcl_node_t * node)
       allocator.deallocate(action_server->impl->action_name, allocator.state);
       action_server->impl->action_name = NULL;
     }
+    // Deallocate derived names
+    if (rcl_action_names_fini(&action_server->impl->names) != RCL_RET_OK) {
+      ret = RCL_RET_ERROR;
+    }
     // Deallocate goal handles storage, but don't fini them.
     for (size_t i = 0; i < action_server->impl->num_goal_handles; ++i) {
       allocator.deallocate(action_server->impl->goal_handles[i], allocator.state);
     }
     allocator.deallocate(action_server->impl->goal_handles, allocator.state);
     action_server->impl->goal_handles = NULL;
+    // Deallocate recycled goal handle allocations and the UUID map
+    for (size_t i = 0; i < action_server->impl->num_free_goal_handles; ++i) {
+      allocator.deallocate(action_server->impl->free_goal_handles[i], allocator.state);
+    }
+    allocator.deallocate(action_server->impl->free_goal_handles, allocator.state);
+    action_server->impl->free_goal_handles = NULL;
+    allocator.deallocate(action_server->impl->expire_heap, allocator.state);
+    action_server->impl->expire_heap = NULL;
+    allocator.deallocate(action_server->impl->goal_statuses, allocator.state);
+    action_server->impl->goal_statuses = NULL;
+    // Deallocate any result requesters that were never answered
+    for (size_t i = 0; i < action_server->impl->num_result_requesters; ++i) {
+      allocator.deallocate(action_server->impl->result_requesters[i].headers, allocator.state);
+    }
+    allocator.deallocate(action_server->impl->result_requesters, allocator.state);
+    action_server->impl->result_requesters = NULL;
+    allocator.deallocate(action_server->impl->cancel_scratch, allocator.state);
+    action_server->impl->cancel_scratch = NULL;
+    _goal_uuid_map_fini(&action_server->impl->goal_map, allocator);
     // Deallocate struct
     allocator.deallocate(action_server->impl, allocator.state);
     action_server->impl = NULL;
@@ -287,6 +556,9 @@ rcl_action_server_get_default_options(void)
   default_options.status_topic_qos = rcl_action_qos_profile_status_default;
   default_options.allocator = rcl_get_default_allocator();
   default_options.result_timeout.nanoseconds = RCUTILS_S_TO_NS(15 * 60);  // 15 minutes
+  default_options.goal_handle_capacity = 16u;
+  default_options.enable_status_coalescing = false;
+  default_options.status_publish_period.nanoseconds = RCUTILS_MS_TO_NS(10);  // 100 Hz cap
   return default_options;
 }
 
@@ -358,6 +630,11 @@ _nanosec_to_goal_info_stamp(const int64_t * nanosec, rcl_action_goal_info_t * go
   goal_info->stamp.nanosec = *nanosec % RCUTILS_S_TO_NS(1);
 }
 
+// Implementation only; defined with the other deadline-heap helpers below
+static void
+_deadline_heap_push(
+  rcl_action_server_impl_t * impl, int64_t deadline, rcl_action_goal_handle_t * goal_handle);
+
 rcl_action_goal_handle_t *
 rcl_action_accept_new_goal(
   rcl_action_server_t * action_server,
@@ -369,33 +646,65 @@ rcl_action_accept_new_goal(
   RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, NULL);
 
   // Check if goal with same ID already exists
-  if (rcl_action_server_goal_exists(action_server, goal_info)) {
+  if (NULL != _goal_uuid_map_lookup(&action_server->impl->goal_map, goal_info->uuid)) {
     RCL_SET_ERROR_MSG("goal ID already exists");
     return NULL;
   }
 
-  // Allocate space in the goal handle pointer array
+  // Double the goal handle storage when it is full, rather than growing it
+  // by one element per accepted goal
   rcl_allocator_t allocator = action_server->impl->options.allocator;
-  rcl_action_goal_handle_t ** goal_handles = action_server->impl->goal_handles;
   const size_t num_goal_handles = action_server->impl->num_goal_handles;
-  // TODO(jacobperron): Don't allocate for every accepted goal handle,
-  //                    instead double the memory allocated if needed.
-  const size_t new_num_goal_handles = num_goal_handles + 1u;
-  void * tmp_ptr = allocator.reallocate(
-    goal_handles, new_num_goal_handles * sizeof(rcl_action_goal_handle_t *), allocator.state);
-  if (!tmp_ptr) {
-    RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
-    return NULL;
+  if (num_goal_handles == action_server->impl->goal_handle_capacity) {
+    const size_t new_capacity = 2u * action_server->impl->goal_handle_capacity;
+    void * tmp_ptr = allocator.reallocate(
+      action_server->impl->goal_handles,
+      new_capacity * sizeof(rcl_action_goal_handle_t *), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal handle pointer");
+      return NULL;
+    }
+    action_server->impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
+    tmp_ptr = allocator.reallocate(
+      action_server->impl->free_goal_handles,
+      new_capacity * sizeof(rcl_action_goal_handle_t *), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal handle free list");
+      return NULL;
+    }
+    action_server->impl->free_goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
+    tmp_ptr = allocator.reallocate(
+      action_server->impl->expire_heap,
+      new_capacity * sizeof(goal_deadline_t), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal deadline heap");
+      return NULL;
+    }
+    action_server->impl->expire_heap = (goal_deadline_t *)tmp_ptr;
+    tmp_ptr = allocator.reallocate(
+      action_server->impl->goal_statuses,
+      new_capacity * sizeof(rcl_action_goal_status_t), allocator.state);
+    if (!tmp_ptr) {
+      RCL_SET_ERROR_MSG("memory allocation failed for goal status array");
+      return NULL;
+    }
+    action_server->impl->goal_statuses = (rcl_action_goal_status_t *)tmp_ptr;
+    action_server->impl->goal_handle_capacity = new_capacity;
   }
-  goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
 
-  // Allocate space for a new goal handle
-  tmp_ptr = allocator.allocate(sizeof(rcl_action_goal_handle_t), allocator.state);
-  if (!tmp_ptr) {
-    RCL_SET_ERROR_MSG("memory allocation failed for new goal handle");
-    return NULL;
+  // Reuse a recycled goal handle allocation when one is available
+  rcl_action_goal_handle_t * goal_handle;
+  if (action_server->impl->num_free_goal_handles > 0u) {
+    goal_handle =
+      action_server->impl->free_goal_handles[--action_server->impl->num_free_goal_handles];
+  } else {
+    goal_handle = (rcl_action_goal_handle_t *)allocator.allocate(
+      sizeof(rcl_action_goal_handle_t), allocator.state);
+    if (!goal_handle) {
+      RCL_SET_ERROR_MSG("memory allocation failed for new goal handle");
+      return NULL;
+    }
   }
-  goal_handles[num_goal_handles] = (rcl_action_goal_handle_t *) tmp_ptr;
 
   // Re-stamp goal info with current time
   rcl_action_goal_info_t goal_info_stamp_now = rcl_action_get_zero_initialized_goal_info();
@@ -403,82 +712,144 @@ rcl_action_accept_new_goal(
   rcl_time_point_value_t now_time_point;
   rcl_ret_t ret = rcl_clock_get_now(&action_server->impl->clock, &now_time_point);
   if (RCL_RET_OK != ret) {
-    return NULL;  // Error already set
+    goto fail;  // Error already set
   }
   _nanosec_to_goal_info_stamp(&now_time_point, &goal_info_stamp_now);
 
   // Create a new goal handle
-  *goal_handles[num_goal_handles] = rcl_action_get_zero_initialized_goal_handle();
-  ret = rcl_action_goal_handle_init(
-    goal_handles[num_goal_handles], &goal_info_stamp_now, allocator);
+  *goal_handle = rcl_action_get_zero_initialized_goal_handle();
+  ret = rcl_action_goal_handle_init(goal_handle, &goal_info_stamp_now, allocator);
   if (RCL_RET_OK != ret) {
     RCL_SET_ERROR_MSG("failed to initialize goal handle");
-    return NULL;
+    goto fail;
   }
 
-  action_server->impl->goal_handles = goal_handles;
-  action_server->impl->num_goal_handles = new_num_goal_handles;
-  return goal_handles[num_goal_handles];
+  // Track the goal in the UUID map
+  ret = _goal_uuid_map_insert(
+    &action_server->impl->goal_map, goal_info->uuid, goal_handle, allocator);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("memory allocation failed for goal UUID map");
+    goto fail;
+  }
+
+  // Track the goal's expiry deadline; an active goal is never expired, its
+  // entry is refreshed if the deadline passes while it is still running
+  _deadline_heap_push(
+    action_server->impl, now_time_point +
+    (int64_t)action_server->impl->options.result_timeout.nanoseconds, goal_handle);
+
+  // Record the goal's status entry; only the status code changes after this
+  action_server->impl->goal_statuses[num_goal_handles].goal_info = goal_info_stamp_now;
+  action_server->impl->goal_statuses[num_goal_handles].status = GOAL_STATE_ACCEPTED;
+
+  action_server->impl->goal_handles[num_goal_handles] = goal_handle;
+  action_server->impl->num_goal_handles = num_goal_handles + 1u;
+  return goal_handle;
+fail:
+  // The storage was popped before anything could fail, so there is room for it
+  action_server->impl->free_goal_handles[action_server->impl->num_free_goal_handles++] =
+    goal_handle;
+  return NULL;
+}
+
+// Implementation only
+static void
+_deadline_heap_push(
+  rcl_action_server_impl_t * impl, int64_t deadline, rcl_action_goal_handle_t * goal_handle)
+{
+  // The heap is sized with the goal handle storage, so there is always room
+  size_t idx = impl->expire_heap_size++;
+  while (idx > 0u) {
+    const size_t parent = (idx - 1u) / 2u;
+    if (impl->expire_heap[parent].deadline <= deadline) {
+      break;
+    }
+    impl->expire_heap[idx] = impl->expire_heap[parent];
+    idx = parent;
+  }
+  impl->expire_heap[idx].deadline = deadline;
+  impl->expire_heap[idx].goal_handle = goal_handle;
+}
+
+// Implementation only
+static void
+_deadline_heap_pop(rcl_action_server_impl_t * impl)
+{
+  const goal_deadline_t last = impl->expire_heap[--impl->expire_heap_size];
+  size_t idx = 0u;
+  while (true) {
+    size_t child = (2u * idx) + 1u;
+    if (child >= impl->expire_heap_size) {
+      break;
+    }
+    if ((child + 1u) < impl->expire_heap_size &&
+      impl->expire_heap[child + 1u].deadline < impl->expire_heap[child].deadline)
+    {
+      ++child;
+    }
+    if (last.deadline <= impl->expire_heap[child].deadline) {
+      break;
+    }
+    impl->expire_heap[idx] = impl->expire_heap[child];
+    idx = child;
+  }
+  if (impl->expire_heap_size > 0u) {
+    impl->expire_heap[idx] = last;
+  }
 }
 
 // Implementation only
 static rcl_ret_t
-_recalculate_expire_timer(
-  rcl_timer_t * expire_timer,
-  const int64_t timeout,
-  rcl_action_goal_handle_t ** goal_handles,
-  size_t num_goal_handles,
-  rcl_clock_t * clock)
+_arm_expire_timer(rcl_action_server_impl_t * impl, int64_t current_time)
 {
-  size_t num_inactive_goals = 0u;
-  int64_t minimum_period = 0;
+  if (0u == impl->expire_heap_size) {
+    // No inactive goals, so no idea when the next goal will expire; cancel timer
+    return rcl_timer_cancel(&impl->expire_timer);
+  }
+  // Make timer fire at the earliest deadline in the heap
+  int64_t period = impl->expire_heap[0].deadline - current_time;
+  if (period < 0) {
+    period = 0;
+  }
+  rcl_ret_t ret = rcl_timer_reset(&impl->expire_timer);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  int64_t old_period;
+  return rcl_timer_exchange_period(&impl->expire_timer, period, &old_period);
+}
 
+// Implementation only
+static rcl_ret_t
+_recalculate_expire_timer(rcl_action_server_impl_t * impl)
+{
   // Get current time (nanosec)
   int64_t current_time;
-  rcl_ret_t ret = rcl_clock_get_now(clock, &current_time);
+  rcl_ret_t ret = rcl_clock_get_now(&impl->clock, &current_time);
   if (RCL_RET_OK != ret) {
     return RCL_RET_ERROR;
   }
 
-  for (size_t i = 0; i < num_goal_handles; ++i) {
-    rcl_action_goal_handle_t * goal_handle = goal_handles[i];
-    if (!rcl_action_goal_handle_is_active(goal_handle)) {
-      ++num_inactive_goals;
-
-      rcl_action_goal_info_t goal_info;
-      ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        return RCL_RET_ERROR;
-      }
-
-      int64_t delta = timeout - current_time - _goal_info_stamp_to_nanosec(&goal_info);
-      if (delta < minimum_period) {
-        minimum_period = delta;
-      }
-    }
-  }
-
-  if (0u == num_goal_handles || 0u == num_inactive_goals) {
-    // No idea when the next goal will expire, so cancel timer
-    return rcl_timer_cancel(expire_timer);
-  } else {
-    if (minimum_period < 0) {
-      // Time jumped backwards
-      minimum_period = 0;
-    }
-    // Un-cancel timer
-    ret = rcl_timer_reset(expire_timer);
+  // Rebuild the deadline heap over every tracked goal, so the timer is armed
+  // to the true earliest deadline
+  const int64_t timeout = (int64_t)impl->options.result_timeout.nanoseconds;
+  impl->expire_heap_size = 0u;
+  for (size_t i = 0; i < impl->num_goal_handles; ++i) {
+    rcl_action_goal_handle_t * goal_handle = impl->goal_handles[i];
+    rcl_action_goal_info_t goal_info;
+    ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
     if (RCL_RET_OK != ret) {
-      return ret;
+      return RCL_RET_ERROR;
     }
-    // Make timer fire when next goal expires
-    int64_t old_period;
-    ret = rcl_timer_exchange_period(expire_timer, minimum_period, &old_period);
-    if (RCL_RET_OK != ret) {
-      return ret;
+    int64_t deadline = _goal_info_stamp_to_nanosec(&goal_info) + timeout;
+    if (deadline < current_time && rcl_action_goal_handle_is_active(goal_handle)) {
+      // An active goal cannot expire yet; look at it again a full timeout
+      // from now so its past-due deadline cannot spin the timer
+      deadline = current_time + timeout;
     }
+    _deadline_heap_push(impl, deadline, goal_handle);
   }
-  return RCL_RET_OK;
+  return _arm_expire_timer(impl, current_time);
 }
 
 rcl_ret_t
@@ -498,6 +869,54 @@ rcl_action_publish_feedback(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_publish_feedback_batch(
+  const rcl_action_server_t * action_server,
+  const void ** ros_feedback_messages,
+  size_t count)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_feedback_messages, RCL_RET_INVALID_ARGUMENT);
+
+  // rcl_publish_batch() null-checks each message and validates once itself.
+  rcl_ret_t ret = rcl_publish_batch(
+    &action_server->impl->feedback_publisher, ros_feedback_messages, count);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_INVALID_ARGUMENT == ret) {
+      return RCL_RET_INVALID_ARGUMENT;  // error already set
+    }
+    return RCL_RET_ERROR;  // error already set
+  }
+  return RCL_RET_OK;
+}
+
+// Implementation only
+static void
+_noop_deallocate(void * pointer, void * state)
+{
+  // Used so that finalizing a lent-out status array does not free the
+  // action server's storage
+  (void)pointer;
+  (void)state;
+}
+
+// Implementation only
+static void
+_drop_result_requesters(rcl_action_server_impl_t * impl, const uint8_t * uuid)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  for (size_t i = 0u; i < impl->num_result_requesters; ++i) {
+    if (uuidcmp(impl->result_requesters[i].uuid, uuid)) {
+      allocator.deallocate(impl->result_requesters[i].headers, allocator.state);
+      impl->result_requesters[i] = impl->result_requesters[impl->num_result_requesters - 1u];
+      impl->num_result_requesters--;
+      return;
+    }
+  }
+}
+
 rcl_ret_t
 rcl_action_get_goal_status_array(
   const rcl_action_server_t * action_server,
@@ -508,45 +927,30 @@ rcl_action_get_goal_status_array(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(status_message, RCL_RET_INVALID_ARGUMENT);
 
-  // If number of goals is zero, then we don't need to do any allocation
-  size_t num_goals = action_server->impl->num_goal_handles;
+  rcl_action_server_impl_t * impl = action_server->impl;
+  const size_t num_goals = impl->num_goal_handles;
   if (0u == num_goals) {
     status_message->msg.status_list.size = 0u;
     return RCL_RET_OK;
   }
 
-  // Allocate status array
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
-  rcl_ret_t ret = rcl_action_goal_status_array_init(status_message, num_goals, allocator);
-  if (RCL_RET_OK != ret) {
-    if (RCL_RET_BAD_ALLOC == ret) {
-      return RCL_RET_BAD_ALLOC;
-    }
-    return RCL_RET_ERROR;
-  }
-
-  // Populate status array
+  // The goal info entries were recorded when the goals were accepted and
+  // mirror the goal handle array; only the status codes need refreshing
   for (size_t i = 0u; i < num_goals; ++i) {
-    ret = rcl_action_goal_handle_get_info(
-      action_server->impl->goal_handles[i], &status_message->msg.status_list.data[i].goal_info);
-    if (RCL_RET_OK != ret) {
-      ret = RCL_RET_ERROR;
-      goto fail;
-    }
-    ret = rcl_action_goal_handle_get_status(
-      action_server->impl->goal_handles[i], &status_message->msg.status_list.data[i].status);
+    rcl_ret_t ret = rcl_action_goal_handle_get_status(
+      impl->goal_handles[i], &impl->goal_statuses[i].status);
     if (RCL_RET_OK != ret) {
-      ret = RCL_RET_ERROR;
-      goto fail;
+      return RCL_RET_ERROR;
     }
   }
+
+  // Lend out the persistent array; it stays valid until the goal set next
+  // changes, and the no-op deallocator makes a caller-side fini harmless
+  status_message->msg.status_list.data = impl->goal_statuses;
+  status_message->msg.status_list.size = num_goals;
+  status_message->allocator = impl->options.allocator;
+  status_message->allocator.deallocate = _noop_deallocate;
   return RCL_RET_OK;
-fail:
-  {
-    rcl_ret_t ret_throwaway = rcl_action_goal_status_array_fini(status_message);
-    (void)ret_throwaway;
-    return ret;
-  }
 }
 
 rcl_ret_t
@@ -559,13 +963,57 @@ rcl_action_publish_status(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(status_message, RCL_RET_INVALID_ARGUMENT);
 
-  rcl_ret_t ret = rcl_publish(&action_server->impl->status_publisher, status_message);
+  rcl_action_server_impl_t * impl = action_server->impl;
+  if (impl->options.enable_status_coalescing) {
+    // At most one publication per period reaches the wire; a burst of goal
+    // transitions inside the window collapses into the deferred one, which
+    // carries the latest statuses when it is flushed.
+    rcl_time_point_value_t now = 0;
+    rcl_ret_t clock_ret = rcl_clock_get_now(&impl->clock, &now);
+    if (RCL_RET_OK != clock_ret) {
+      return RCL_RET_ERROR;  // error already set
+    }
+    const int64_t since_last_publish =
+      rcl_difference_time_point_values(impl->last_status_publish_time, now);
+    if (since_last_publish < impl->options.status_publish_period.nanoseconds) {
+      impl->status_dirty = true;
+      return RCL_RET_OK;
+    }
+    impl->last_status_publish_time = now;
+    impl->status_dirty = false;
+  }
+  rcl_ret_t ret = rcl_publish(&impl->status_publisher, status_message);
   if (RCL_RET_OK != ret) {
     return RCL_RET_ERROR;  // error already set
   }
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_action_server_status_flush_due(
+  const rcl_action_server_t * action_server,
+  bool * due)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(due, RCL_RET_INVALID_ARGUMENT);
+  rcl_action_server_impl_t * impl = action_server->impl;
+  *due = false;
+  if (!impl->options.enable_status_coalescing || !impl->status_dirty) {
+    return RCL_RET_OK;
+  }
+  rcl_time_point_value_t now = 0;
+  rcl_ret_t clock_ret = rcl_clock_get_now(&impl->clock, &now);
+  if (RCL_RET_OK != clock_ret) {
+    return RCL_RET_ERROR;  // error already set
+  }
+  const int64_t since_last_publish =
+    rcl_difference_time_point_values(impl->last_status_publish_time, now);
+  *due = since_last_publish >= impl->options.status_publish_period.nanoseconds;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_action_take_result_request(
   const rcl_action_server_t * action_server,
@@ -584,6 +1032,103 @@ rcl_action_send_result_response(
   SEND_SERVICE_RESPONSE(result, response_header, ros_result_response);
 }
 
+rcl_ret_t
+rcl_action_defer_result_response(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_info_t * goal_info,
+  const rmw_request_id_t * request_header)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(request_header, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_action_server_impl_t * impl = action_server->impl;
+  if (NULL == _goal_uuid_map_lookup(&impl->goal_map, goal_info->uuid)) {
+    RCL_SET_ERROR_MSG("goal is not being tracked by this action server");
+    return RCL_RET_ACTION_GOAL_HANDLE_INVALID;
+  }
+  rcl_allocator_t allocator = impl->options.allocator;
+  // Find the requester list for this goal, or start one
+  goal_result_requesters_t * requesters = NULL;
+  for (size_t i = 0u; i < impl->num_result_requesters; ++i) {
+    if (uuidcmp(impl->result_requesters[i].uuid, goal_info->uuid)) {
+      requesters = &impl->result_requesters[i];
+      break;
+    }
+  }
+  if (NULL == requesters) {
+    if (impl->num_result_requesters == impl->result_requester_capacity) {
+      size_t new_capacity =
+        (0u == impl->result_requester_capacity) ? 4u : (2u * impl->result_requester_capacity);
+      goal_result_requesters_t * new_requesters =
+        (goal_result_requesters_t *)allocator.reallocate(
+        impl->result_requesters,
+        new_capacity * sizeof(goal_result_requesters_t),
+        allocator.state);
+      if (!new_requesters) {
+        RCL_SET_ERROR_MSG("memory allocation failed for result requesters");
+        return RCL_RET_BAD_ALLOC;
+      }
+      impl->result_requesters = new_requesters;
+      impl->result_requester_capacity = new_capacity;
+    }
+    requesters = &impl->result_requesters[impl->num_result_requesters++];
+    memcpy(requesters->uuid, goal_info->uuid, UUID_SIZE);
+    requesters->headers = NULL;
+    requesters->num_headers = 0u;
+    requesters->header_capacity = 0u;
+  }
+  if (requesters->num_headers == requesters->header_capacity) {
+    size_t new_capacity =
+      (0u == requesters->header_capacity) ? 4u : (2u * requesters->header_capacity);
+    rmw_request_id_t * new_headers = (rmw_request_id_t *)allocator.reallocate(
+      requesters->headers, new_capacity * sizeof(rmw_request_id_t), allocator.state);
+    if (!new_headers) {
+      RCL_SET_ERROR_MSG("memory allocation failed for result request headers");
+      return RCL_RET_BAD_ALLOC;
+    }
+    requesters->headers = new_headers;
+    requesters->header_capacity = new_capacity;
+  }
+  requesters->headers[requesters->num_headers++] = *request_header;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_send_deferred_result_responses(
+  const rcl_action_server_t * action_server,
+  const rcl_action_goal_info_t * goal_info,
+  void * ros_result_response)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ros_result_response, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_action_server_impl_t * impl = action_server->impl;
+  rcl_ret_t ret_final = RCL_RET_OK;
+  for (size_t i = 0u; i < impl->num_result_requesters; ++i) {
+    if (!uuidcmp(impl->result_requesters[i].uuid, goal_info->uuid)) {
+      continue;
+    }
+    // The same response message answers every recorded requester
+    for (size_t j = 0u; j < impl->result_requesters[i].num_headers; ++j) {
+      rmw_request_id_t response_header = impl->result_requesters[i].headers[j];
+      rcl_ret_t ret = rcl_send_response(
+        &impl->result_service, &response_header, ros_result_response);
+      if (RCL_RET_OK != ret) {
+        ret_final = RCL_RET_ERROR;  // error already set
+      }
+    }
+    break;
+  }
+  _drop_result_requesters(impl, goal_info->uuid);
+  return ret_final;
+}
+
 rcl_ret_t
 rcl_action_expire_goals(
   const rcl_action_server_t * action_server,
@@ -610,24 +1155,26 @@ rcl_action_expire_goals(
     return RCL_RET_ERROR;
   }
 
-  // Used for shrinking goal handle array
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
-
+  rcl_action_server_impl_t * impl = action_server->impl;
   size_t num_goals_expired = 0u;
   rcl_ret_t ret_final = RCL_RET_OK;
-  const int64_t timeout = (int64_t)action_server->impl->options.result_timeout.nanoseconds;
-  rcl_action_goal_handle_t * goal_handle;
+  const int64_t timeout = (int64_t)impl->options.result_timeout.nanoseconds;
   rcl_action_goal_info_t goal_info;
-  int64_t goal_time;
-  size_t num_goal_handles = action_server->impl->num_goal_handles;
-  for (size_t i = 0u; i < num_goal_handles; ++i) {
-    if (output_expired && i >= expired_goals_capacity) {
+  size_t num_goal_handles = impl->num_goal_handles;
+  // Pop only the goals whose deadline has passed; unexpired goals are never
+  // visited
+  while (impl->expire_heap_size > 0u && impl->expire_heap[0].deadline < current_time) {
+    if (output_expired && num_goals_expired >= expired_goals_capacity) {
       // no more space to output expired goals, so stop expiring them
       break;
     }
-    goal_handle = action_server->impl->goal_handles[i];
+    rcl_action_goal_handle_t * goal_handle = impl->expire_heap[0].goal_handle;
+    _deadline_heap_pop(impl);
     // Expiration only applys to terminated goals
     if (rcl_action_goal_handle_is_active(goal_handle)) {
+      // Keep tracking the goal, but push its deadline into the future so the
+      // timer is not spun by a goal that outlives its own result timeout
+      _deadline_heap_push(impl, current_time + timeout, goal_handle);
       continue;
     }
     rcl_action_goal_info_t * info_ptr = &goal_info;
@@ -639,44 +1186,33 @@ rcl_action_expire_goals(
       ret_final = RCL_RET_ERROR;
       continue;
     }
-    goal_time = _goal_info_stamp_to_nanosec(info_ptr);
-    if ((current_time - goal_time) > timeout) {
-      // Stop tracking goal handle
-      // Fill in any gaps left in the array with pointers from the end
-      --num_goal_handles;
-      action_server->impl->goal_handles[i] = action_server->impl->goal_handles[num_goal_handles];
-      allocator.deallocate(action_server->impl->goal_handles[num_goal_handles], allocator.state);
-      action_server->impl->goal_handles[num_goal_handles] = NULL;
-      ++num_goals_expired;
+    // Stop tracking goal handle
+    // Fill in any gaps left in the array with pointers from the end
+    for (size_t i = 0u; i < num_goal_handles; ++i) {
+      if (impl->goal_handles[i] == goal_handle) {
+        --num_goal_handles;
+        impl->goal_handles[i] = impl->goal_handles[num_goal_handles];
+        impl->goal_handles[num_goal_handles] = NULL;
+        // Keep the status entries mirroring the goal handle array
+        impl->goal_statuses[i] = impl->goal_statuses[num_goal_handles];
+        break;
+      }
     }
+    // Recycle the allocation for a future goal and drop the UUID map entry;
+    // the storage keeps its capacity for the next burst of goals
+    _goal_uuid_map_remove(&impl->goal_map, info_ptr->uuid);
+    _drop_result_requesters(impl, info_ptr->uuid);
+    impl->free_goal_handles[impl->num_free_goal_handles++] = goal_handle;
+    ++num_goals_expired;
   }
 
-  if (num_goals_expired > 0u) {
-    // Shrink goal handle array if some goals expired
-    if (0u == num_goal_handles) {
-      allocator.deallocate(action_server->impl->goal_handles, allocator.state);
-      action_server->impl->goal_handles = NULL;
-      action_server->impl->num_goal_handles = num_goal_handles;
-    } else {
-      void * tmp_ptr = allocator.reallocate(
-        action_server->impl->goal_handles,
-        num_goal_handles * sizeof(rcl_action_goal_handle_t *),
-        allocator.state);
-      if (!tmp_ptr) {
-        RCL_SET_ERROR_MSG("failed to shrink size of goal handle array");
-        ret_final = RCL_RET_ERROR;
-      } else {
-        action_server->impl->goal_handles = (rcl_action_goal_handle_t **)tmp_ptr;
-        action_server->impl->num_goal_handles = num_goal_handles;
-      }
-    }
+  impl->num_goal_handles = num_goal_handles;
+  // Re-arm the timer to the next deadline left in the heap; don't let its
+  // result mask an error recorded while expiring
+  rcl_ret_t arm_ret = _arm_expire_timer(impl, current_time);
+  if (RCL_RET_OK == ret_final) {
+    ret_final = arm_ret;
   }
-  ret_final = _recalculate_expire_timer(
-    &action_server->impl->expire_timer,
-    action_server->impl->options.result_timeout.nanoseconds,
-    action_server->impl->goal_handles,
-    action_server->impl->num_goal_handles,
-    &action_server->impl->clock);
 
   // If argument is not null, then set it
   if (NULL != num_expired) {
@@ -689,12 +1225,7 @@ rcl_ret_t
 rcl_action_notify_goal_done(
   const rcl_action_server_t * action_server)
 {
-  return _recalculate_expire_timer(
-    &action_server->impl->expire_timer,
-    action_server->impl->options.result_timeout.nanoseconds,
-    action_server->impl->goal_handles,
-    action_server->impl->num_goal_handles,
-    &action_server->impl->clock);
+  return _recalculate_expire_timer(action_server->impl);
 }
 
 rcl_ret_t
@@ -706,115 +1237,169 @@ rcl_action_take_cancel_request(
   TAKE_SERVICE_REQUEST(cancel, request_header, ros_cancel_request);
 }
 
-rcl_ret_t
-rcl_action_process_cancel_request(
-  const rcl_action_server_t * action_server,
-  const rcl_action_cancel_request_t * cancel_request,
-  rcl_action_cancel_response_t * cancel_response)
+// Implementation only
+static rcl_ret_t
+_cancel_scratch_snapshot(rcl_action_server_impl_t * impl, size_t * num_entries)
 {
-  if (!rcl_action_server_is_valid(action_server)) {
-    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  const size_t total_num_goals = impl->num_goal_handles;
+  if (total_num_goals > impl->cancel_scratch_capacity) {
+    rcl_allocator_t allocator = impl->options.allocator;
+    cancel_scratch_entry_t * new_scratch = (cancel_scratch_entry_t *)allocator.reallocate(
+      impl->cancel_scratch, total_num_goals * sizeof(cancel_scratch_entry_t), allocator.state);
+    if (!new_scratch) {
+      RCL_SET_ERROR_MSG("allocation failed for cancel scratch storage");
+      return RCL_RET_BAD_ALLOC;
+    }
+    impl->cancel_scratch = new_scratch;
+    impl->cancel_scratch_capacity = total_num_goals;
   }
-  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_request, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_response, RCL_RET_INVALID_ARGUMENT);
-
-  rcl_allocator_t allocator = action_server->impl->options.allocator;
-  const size_t total_num_goals = action_server->impl->num_goal_handles;
-
-  // Storage for pointers to active goals handles that will be transitioned to canceling
-  // Note, we need heap allocation for MSVC support
-  rcl_action_goal_handle_t ** goal_handles_to_cancel =
-    (rcl_action_goal_handle_t **)allocator.allocate(
-    sizeof(rcl_action_goal_handle_t *) * total_num_goals, allocator.state);
-  if (!goal_handles_to_cancel) {
-    RCL_SET_ERROR_MSG("allocation failed for temporary goal handle array");
-    return RCL_RET_BAD_ALLOC;
+  size_t num = 0u;
+  rcl_ret_t ret_final = RCL_RET_OK;
+  for (size_t i = 0u; i < total_num_goals; ++i) {
+    rcl_action_goal_handle_t * goal_handle = impl->goal_handles[i];
+    cancel_scratch_entry_t * entry = &impl->cancel_scratch[num];
+    rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &entry->info);
+    if (RCL_RET_OK != ret) {
+      ret_final = RCL_RET_ERROR;
+      continue;
+    }
+    entry->nanosec = _goal_info_stamp_to_nanosec(&entry->info);
+    entry->cancelable = rcl_action_goal_handle_is_cancelable(goal_handle);
+    ++num;
   }
-  size_t num_goals_to_cancel = 0u;
+  *num_entries = num;
+  return ret_final;
+}
 
-  // Request data
-  const rcl_action_goal_info_t * request_goal_info = &cancel_request->goal_info;
-  const uint8_t * request_uuid = request_goal_info->uuid;
-  int64_t request_nanosec = _goal_info_stamp_to_nanosec(request_goal_info);
+// Implementation only
+static rcl_ret_t
+_resolve_cancel_request(
+  rcl_action_server_impl_t * impl,
+  const rcl_action_cancel_request_t * cancel_request,
+  size_t num_entries,
+  rcl_action_cancel_response_t * cancel_response)
+{
+  rcl_allocator_t allocator = impl->options.allocator;
+  const uint8_t * request_uuid = cancel_request->goal_info.uuid;
+  int64_t request_nanosec = _goal_info_stamp_to_nanosec(&cancel_request->goal_info);
+  rcl_ret_t ret;
 
-  rcl_ret_t ret_final = RCL_RET_OK;
-  // Determine how many goals should transition to canceling
   if (!uuidcmpzero(request_uuid) && (0u == request_nanosec)) {
     // UUID is not zero and timestamp is zero; cancel exactly one goal (if it exists)
-    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
-    rcl_action_goal_handle_t * goal_handle;
-    for (size_t i = 0u; i < total_num_goals; ++i) {
-      goal_handle = action_server->impl->goal_handles[i];
-      rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        ret_final = RCL_RET_ERROR;
-        continue;
-      }
-
-      if (uuidcmp(request_uuid, goal_info.uuid)) {
-        if (rcl_action_goal_handle_is_cancelable(goal_handle)) {
-          goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
-        }
-        break;
-      }
+    rcl_action_goal_handle_t * goal_handle =
+      _goal_uuid_map_lookup(&impl->goal_map, request_uuid);
+    if (NULL == goal_handle || !rcl_action_goal_handle_is_cancelable(goal_handle)) {
+      cancel_response->msg.goals_canceling.data = NULL;
+      cancel_response->msg.goals_canceling.size = 0u;
+      return RCL_RET_OK;
     }
-  } else {
-    if (uuidcmpzero(request_uuid) && (0u == request_nanosec)) {
-      // UUID and timestamp are both zero; cancel all goals
-      // Set timestamp to max to cancel all active goals in the following for-loop
-      request_nanosec = INT64_MAX;
+    ret = rcl_action_cancel_response_init(cancel_response, 1u, allocator);
+    if (RCL_RET_OK != ret) {
+      // error already set
+      return (RCL_RET_BAD_ALLOC == ret) ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
     }
+    ret = rcl_action_goal_handle_get_info(
+      goal_handle, &cancel_response->msg.goals_canceling.data[0]);
+    return (RCL_RET_OK == ret) ? RCL_RET_OK : RCL_RET_ERROR;  // error already set
+  }
 
-    // Cancel all active goals at or before the timestamp
-    // Also cancel any goal matching the UUID in the cancel request
-    rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
-    rcl_action_goal_handle_t * goal_handle;
-    for (size_t i = 0u; i < total_num_goals; ++i) {
-      goal_handle = action_server->impl->goal_handles[i];
-      rcl_ret_t ret = rcl_action_goal_handle_get_info(goal_handle, &goal_info);
-      if (RCL_RET_OK != ret) {
-        ret_final = RCL_RET_ERROR;
-        continue;
-      }
+  if (uuidcmpzero(request_uuid) && (0u == request_nanosec)) {
+    // UUID and timestamp are both zero; cancel all goals
+    // Set timestamp to max to cancel all active goals in the following for-loops
+    request_nanosec = INT64_MAX;
+  }
 
-      const int64_t goal_nanosec = _goal_info_stamp_to_nanosec(&goal_info);
-      if (rcl_action_goal_handle_is_cancelable(goal_handle) &&
-        ((goal_nanosec <= request_nanosec) || uuidcmp(request_uuid, goal_info.uuid)))
-      {
-        goal_handles_to_cancel[num_goals_to_cancel++] = goal_handle;
-      }
+  // Cancel all active goals at or before the timestamp
+  // Also cancel any goal matching the UUID in the cancel request
+  const cancel_scratch_entry_t * entries = impl->cancel_scratch;
+  size_t num_goals_to_cancel = 0u;
+  for (size_t i = 0u; i < num_entries; ++i) {
+    if (entries[i].cancelable &&
+      ((entries[i].nanosec <= request_nanosec) || uuidcmp(request_uuid, entries[i].info.uuid)))
+    {
+      ++num_goals_to_cancel;
     }
   }
-
   if (0u == num_goals_to_cancel) {
     cancel_response->msg.goals_canceling.data = NULL;
     cancel_response->msg.goals_canceling.size = 0u;
-    goto cleanup;
+    return RCL_RET_OK;
   }
 
-  // Allocate space in response
-  rcl_ret_t ret = rcl_action_cancel_response_init(
-    cancel_response, num_goals_to_cancel, allocator);
+  // Allocate space in response and fill it from the snapshot
+  ret = rcl_action_cancel_response_init(cancel_response, num_goals_to_cancel, allocator);
   if (RCL_RET_OK != ret) {
-    if (RCL_RET_BAD_ALLOC == ret) {
-      ret_final = RCL_RET_BAD_ALLOC;  // error already set
+    // error already set
+    return (RCL_RET_BAD_ALLOC == ret) ? RCL_RET_BAD_ALLOC : RCL_RET_ERROR;
+  }
+  size_t num_copied = 0u;
+  for (size_t i = 0u; i < num_entries; ++i) {
+    if (entries[i].cancelable &&
+      ((entries[i].nanosec <= request_nanosec) || uuidcmp(request_uuid, entries[i].info.uuid)))
+    {
+      cancel_response->msg.goals_canceling.data[num_copied++] = entries[i].info;
     }
-    ret_final = RCL_RET_ERROR;  // error already set
-    goto cleanup;
   }
+  return RCL_RET_OK;
+}
 
-  // Add goal info to output struct
-  rcl_action_goal_handle_t * goal_handle;
-  for (size_t i = 0u; i < num_goals_to_cancel; ++i) {
-    goal_handle = goal_handles_to_cancel[i];
-    ret = rcl_action_goal_handle_get_info(
-      goal_handle, &cancel_response->msg.goals_canceling.data[i]);
+rcl_ret_t
+rcl_action_process_cancel_request(
+  const rcl_action_server_t * action_server,
+  const rcl_action_cancel_request_t * cancel_request,
+  rcl_action_cancel_response_t * cancel_response)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_request, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_response, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_action_server_impl_t * impl = action_server->impl;
+  const uint8_t * request_uuid = cancel_request->goal_info.uuid;
+  const int64_t request_nanosec = _goal_info_stamp_to_nanosec(&cancel_request->goal_info);
+
+  size_t num_entries = 0u;
+  rcl_ret_t ret_final = RCL_RET_OK;
+  if (uuidcmpzero(request_uuid) || (0u != request_nanosec)) {
+    // Only requests that select goals by timestamp need the snapshot; a
+    // single-goal cancel resolves through the UUID map without a scan
+    ret_final = _cancel_scratch_snapshot(impl, &num_entries);
+    if (RCL_RET_BAD_ALLOC == ret_final) {
+      return ret_final;  // error already set
+    }
+  }
+  rcl_ret_t ret = _resolve_cancel_request(impl, cancel_request, num_entries, cancel_response);
+  return (RCL_RET_OK != ret) ? ret : ret_final;
+}
+
+rcl_ret_t
+rcl_action_process_cancel_requests(
+  const rcl_action_server_t * action_server,
+  const rcl_action_cancel_request_t * cancel_requests,
+  size_t num_requests,
+  rcl_action_cancel_response_t * cancel_responses)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return RCL_RET_ACTION_SERVER_INVALID;  // error already set
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_requests, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_responses, RCL_RET_INVALID_ARGUMENT);
+
+  rcl_action_server_impl_t * impl = action_server->impl;
+  // One scan of the goal table serves every request in the batch
+  size_t num_entries = 0u;
+  rcl_ret_t ret_final = _cancel_scratch_snapshot(impl, &num_entries);
+  if (RCL_RET_BAD_ALLOC == ret_final) {
+    return ret_final;  // error already set
+  }
+  for (size_t i = 0u; i < num_requests; ++i) {
+    rcl_ret_t ret = _resolve_cancel_request(
+      impl, &cancel_requests[i], num_entries, &cancel_responses[i]);
     if (RCL_RET_OK != ret) {
-      ret_final = RCL_RET_ERROR;  // error already set
+      ret_final = ret;
     }
   }
-cleanup:
-  allocator.deallocate(goal_handles_to_cancel, allocator.state);
   return ret_final;
 }
 
@@ -836,6 +1421,15 @@ rcl_action_server_get_action_name(const rcl_action_server_t * action_server)
   return action_server->impl->action_name;
 }
 
+const rcl_action_names_t *
+rcl_action_server_get_names(const rcl_action_server_t * action_server)
+{
+  if (!rcl_action_server_is_valid(action_server)) {
+    return NULL;  // error already set
+  }
+  return &action_server->impl->names;
+}
+
 const rcl_action_server_options_t *
 rcl_action_server_get_options(const rcl_action_server_t * action_server)
 {
@@ -871,20 +1465,8 @@ rcl_action_server_goal_exists(
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(goal_info, false);
 
-  rcl_action_goal_info_t gh_goal_info = rcl_action_get_zero_initialized_goal_info();
-  rcl_ret_t ret;
-  for (size_t i = 0u; i < action_server->impl->num_goal_handles; ++i) {
-    ret = rcl_action_goal_handle_get_info(action_server->impl->goal_handles[i], &gh_goal_info);
-    if (RCL_RET_OK != ret) {
-      RCL_SET_ERROR_MSG("failed to get info for goal handle");
-      return false;
-    }
-    // Compare UUIDs
-    if (uuidcmp(gh_goal_info.uuid, goal_info->uuid)) {
-      return true;
-    }
-  }
-  return false;
+  // The UUID map mirrors the goal handle array, so this is a single lookup
+  return NULL != _goal_uuid_map_lookup(&action_server->impl->goal_map, goal_info->uuid);
 }
 
 bool
@@ -961,38 +1543,26 @@ rcl_action_wait_set_add_action_server(
     return RCL_RET_ACTION_SERVER_INVALID;  // error already set
   }
 
-  rcl_ret_t ret = rcl_wait_set_add_service(
-    wait_set,
-    &action_server->impl->goal_service,
-    &action_server->impl->wait_set_goal_service_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-  ret = rcl_wait_set_add_service(
-    wait_set,
-    &action_server->impl->cancel_service,
-    &action_server->impl->wait_set_cancel_service_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
-  }
-  ret = rcl_wait_set_add_service(
-    wait_set,
-    &action_server->impl->result_service,
-    &action_server->impl->wait_set_result_service_index);
-  if (RCL_RET_OK != ret) {
-    return ret;
+  // Splice in the precomputed bundle as one batch
+  rcl_action_server_impl_t * impl = action_server->impl;
+  for (size_t i = 0u; i < RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES; ++i) {
+    rcl_ret_t ret = rcl_wait_set_add_service(
+      wait_set, impl->wait_set_services[i], &impl->wait_set_service_indices[i]);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
   }
-  ret = rcl_wait_set_add_timer(
+  rcl_ret_t ret = rcl_wait_set_add_timer(
     wait_set,
-    &action_server->impl->expire_timer,
-    &action_server->impl->wait_set_expire_timer_index);
+    &impl->expire_timer,
+    &impl->wait_set_expire_timer_index);
   if (RCL_RET_OK != ret) {
     return ret;
   }
 
   if (NULL != service_index) {
     // The goal service was the first added
-    *service_index = action_server->impl->wait_set_goal_service_index;
+    *service_index = impl->wait_set_service_indices[0];
   }
   return RCL_RET_OK;
 }
@@ -1041,13 +1611,14 @@ rcl_action_server_wait_set_get_entities_ready(
   RCL_CHECK_ARGUMENT_FOR_NULL(is_goal_expired, RCL_RET_INVALID_ARGUMENT);
 
   const rcl_action_server_impl_t * impl = action_server->impl;
-  const rcl_service_t * goal_service = wait_set->services[impl->wait_set_goal_service_index];
-  const rcl_service_t * cancel_service = wait_set->services[impl->wait_set_cancel_service_index];
-  const rcl_service_t * result_service = wait_set->services[impl->wait_set_result_service_index];
+  // Classify readiness with one table lookup per bundled entity
+  bool * const ready_flags[RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES] = {
+    is_goal_request_ready, is_cancel_request_ready, is_result_request_ready};
+  for (size_t i = 0u; i < RCL_ACTION_SERVER_NUM_WAIT_SET_SERVICES; ++i) {
+    *ready_flags[i] =
+      (impl->wait_set_services[i] == wait_set->services[impl->wait_set_service_indices[i]]);
+  }
   const rcl_timer_t * expire_timer = wait_set->timers[impl->wait_set_expire_timer_index];
-  *is_goal_request_ready = (&impl->goal_service == goal_service);
-  *is_cancel_request_ready = (&impl->cancel_service == cancel_service);
-  *is_result_request_ready = (&impl->result_service == result_service);
   *is_goal_expired = (&impl->expire_timer == expire_timer);
   return RCL_RET_OK;
 }
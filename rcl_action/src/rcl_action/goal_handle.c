@@ -21,11 +21,16 @@ extern "C"
 
 #include "rcl/rcl.h"
 #include "rcl/error_handling.h"
+#include "rcutils/stdatomic_helper.h"
 
 typedef struct rcl_action_goal_handle_impl_t
 {
   rcl_action_goal_info_t info;
-  rcl_action_goal_state_t state;
+  // Current goal state, holding rcl_action_goal_state_t values.
+  // Transitions are release-stored by the single writer (the thread calling
+  // rcl_action_update_goal_state()) and queries load it relaxed, so status
+  // reads from other threads never contend with the writer.
+  atomic_int state;
   rcl_allocator_t allocator;
 } rcl_action_goal_handle_impl_t;
 
@@ -61,7 +66,7 @@ rcl_action_goal_handle_init(
   // Copy goal info (assuming it is trivially copyable)
   goal_handle->impl->info = *goal_info;
   // Initialize state to ACCEPTED
-  goal_handle->impl->state = GOAL_STATE_ACCEPTED;
+  atomic_init(&goal_handle->impl->state, GOAL_STATE_ACCEPTED);
   // Copy the allocator
   goal_handle->impl->allocator = allocator;
   return RCL_RET_OK;
@@ -85,12 +90,15 @@ rcl_action_update_goal_state(
   if (!rcl_action_goal_handle_is_valid(goal_handle)) {
     return RCL_RET_ACTION_GOAL_HANDLE_INVALID;  // error message is set
   }
-  rcl_action_goal_state_t new_state = rcl_action_transition_goal_state(
-    goal_handle->impl->state, goal_event);
+  rcl_action_goal_state_t state = (rcl_action_goal_state_t)atomic_load_explicit(
+    &goal_handle->impl->state, memory_order_relaxed);
+  rcl_action_goal_state_t new_state = rcl_action_transition_goal_state(state, goal_event);
   if (GOAL_STATE_UNKNOWN == new_state) {
     return RCL_RET_ACTION_GOAL_EVENT_INVALID;
   }
-  goal_handle->impl->state = new_state;
+  // Release so a reader that observes the new state also observes everything
+  // written while the goal was still in the previous state.
+  atomic_store_explicit(&goal_handle->impl->state, new_state, memory_order_release);
   return RCL_RET_OK;
 }
 
@@ -117,7 +125,8 @@ rcl_action_goal_handle_get_status(
     return RCL_RET_ACTION_GOAL_HANDLE_INVALID;  // error message is set
   }
   RCL_CHECK_ARGUMENT_FOR_NULL(status, RCL_RET_INVALID_ARGUMENT);
-  *status = goal_handle->impl->state;
+  *status = (rcl_action_goal_state_t)atomic_load_explicit(
+    &goal_handle->impl->state, memory_order_relaxed);
   return RCL_RET_OK;
 }
 
@@ -127,7 +136,9 @@ rcl_action_goal_handle_is_active(const rcl_action_goal_handle_t * goal_handle)
   if (!rcl_action_goal_handle_is_valid(goal_handle)) {
     return false;  // error message is set
   }
-  switch (goal_handle->impl->state) {
+  rcl_action_goal_state_t state = (rcl_action_goal_state_t)atomic_load_explicit(
+    &goal_handle->impl->state, memory_order_relaxed);
+  switch (state) {
     case GOAL_STATE_ACCEPTED:
     case GOAL_STATE_EXECUTING:
     case GOAL_STATE_CANCELING:
@@ -144,8 +155,10 @@ rcl_action_goal_handle_is_cancelable(const rcl_action_goal_handle_t * goal_handl
     return false;  // error message is set
   }
   // Check if the state machine reports a cancel event is valid
+  rcl_action_goal_state_t current_state = (rcl_action_goal_state_t)atomic_load_explicit(
+    &goal_handle->impl->state, memory_order_relaxed);
   rcl_action_goal_state_t state = rcl_action_transition_goal_state(
-    goal_handle->impl->state, GOAL_EVENT_CANCEL);
+    current_state, GOAL_EVENT_CANCEL);
   return GOAL_STATE_CANCELING == state;
 }
 
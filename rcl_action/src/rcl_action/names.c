@@ -149,6 +149,88 @@ rcl_action_get_status_topic_name(
   return RCL_RET_OK;
 }
 
+rcl_action_names_t
+rcl_action_get_zero_initialized_names(void)
+{
+  static rcl_action_names_t names = {
+    NULL, NULL, NULL, NULL, NULL, NULL, {NULL, NULL, NULL, NULL, NULL}};
+  return names;
+}
+
+rcl_ret_t
+rcl_action_names_init(
+  rcl_action_names_t * names,
+  const char * action_name,
+  rcl_allocator_t allocator)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "allocator is invalid", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(action_name, RCL_RET_INVALID_ARGUMENT);
+  if (0 == strlen(action_name)) {
+    RCL_SET_ERROR_MSG("invalid empty action name");
+    return RCL_RET_ACTION_NAME_INVALID;
+  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(names, RCL_RET_INVALID_ARGUMENT);
+  if (NULL != names->buffer) {
+    RCL_SET_ERROR_MSG("writing initialized action names may leak memory");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  // Keep the suffix order in sync with the pointer assignments below
+  static const char * const suffixes[] = {
+    "/_action/send_goal",
+    "/_action/cancel_goal",
+    "/_action/get_result",
+    "/_action/feedback",
+    "/_action/status",
+  };
+  const size_t num_names = sizeof(suffixes) / sizeof(suffixes[0]);
+  const size_t action_name_length = strlen(action_name);
+  size_t buffer_length = 0u;
+  for (size_t i = 0u; i < num_names; ++i) {
+    buffer_length += action_name_length + strlen(suffixes[i]) + 1u;
+  }
+  names->buffer = (char *)allocator.allocate(buffer_length, allocator.state);
+  if (NULL == names->buffer) {
+    RCL_SET_ERROR_MSG("failed to allocate memory for action names");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  // Format every derived name into the one buffer
+  const char * derived_names[sizeof(suffixes) / sizeof(suffixes[0])];
+  char * cursor = names->buffer;
+  for (size_t i = 0u; i < num_names; ++i) {
+    derived_names[i] = cursor;
+    memcpy(cursor, action_name, action_name_length);
+    cursor += action_name_length;
+    const size_t suffix_length = strlen(suffixes[i]) + 1u;  // include terminator
+    memcpy(cursor, suffixes[i], suffix_length);
+    cursor += suffix_length;
+  }
+  names->goal_service_name = derived_names[0];
+  names->cancel_service_name = derived_names[1];
+  names->result_service_name = derived_names[2];
+  names->feedback_topic_name = derived_names[3];
+  names->status_topic_name = derived_names[4];
+  names->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_names_fini(rcl_action_names_t * names)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(names, RCL_RET_INVALID_ARGUMENT);
+  if (names->buffer) {
+    names->allocator.deallocate(names->buffer, names->allocator.state);
+    names->buffer = NULL;
+    names->goal_service_name = NULL;
+    names->cancel_service_name = NULL;
+    names->result_service_name = NULL;
+    names->feedback_topic_name = NULL;
+    names->status_topic_name = NULL;
+  }
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
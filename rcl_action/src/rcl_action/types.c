@@ -16,6 +16,8 @@ extern "C"
 {
 #endif
 
+#include <string.h>
+
 #include "rcl_action/types.h"
 
 #include "rcl/error_handling.h"
@@ -132,6 +134,206 @@ rcl_action_cancel_response_fini(rcl_action_cancel_response_t * cancel_response)
   return RCL_RET_OK;
 }
 
+rcl_action_message_pool_t
+rcl_action_get_zero_initialized_message_pool(void)
+{
+  static rcl_action_message_pool_t message_pool = {
+    NULL, 0, 0, 0, NULL, 0, {NULL, NULL, NULL, NULL, NULL}};
+  return message_pool;
+}
+
+rcl_ret_t
+rcl_action_message_pool_init(
+  rcl_action_message_pool_t * message_pool,
+  const size_t num_messages,
+  const size_t message_capacity,
+  const rcl_allocator_t allocator)
+{
+  RCL_CHECK_ALLOCATOR_WITH_MSG(&allocator, "invalid allocator", return RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  // Number and capacity of pooled buffers must be greater than 0
+  if (0 == num_messages || 0 == message_capacity) {
+    RCL_SET_ERROR_MSG("num_messages and message_capacity must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Ensure message pool is zero initialized
+  if (NULL != message_pool->slab) {
+    RCL_SET_ERROR_MSG("message_pool already inititalized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  // One pooled buffer must fit either entry type
+  size_t entry_size = sizeof(rcl_action_goal_status_t);
+  if (sizeof(rcl_action_goal_info_t) > entry_size) {
+    entry_size = sizeof(rcl_action_goal_info_t);
+  }
+  message_pool->buffer_stride = message_capacity * entry_size;
+  message_pool->slab = (uint8_t *) allocator.zero_allocate(
+    num_messages, message_pool->buffer_stride, allocator.state);
+  if (!message_pool->slab) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  message_pool->free_indices = (size_t *) allocator.allocate(
+    num_messages * sizeof(size_t), allocator.state);
+  if (!message_pool->free_indices) {
+    allocator.deallocate(message_pool->slab, allocator.state);
+    message_pool->slab = NULL;
+    return RCL_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0u; i < num_messages; ++i) {
+    message_pool->free_indices[i] = i;
+  }
+  message_pool->buffer_capacity = message_capacity;
+  message_pool->num_buffers = num_messages;
+  message_pool->num_free = num_messages;
+  message_pool->allocator = allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_message_pool_fini(rcl_action_message_pool_t * message_pool)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  if (message_pool->slab) {
+    message_pool->allocator.deallocate(message_pool->slab, message_pool->allocator.state);
+    message_pool->slab = NULL;
+    message_pool->allocator.deallocate(message_pool->free_indices, message_pool->allocator.state);
+    message_pool->free_indices = NULL;
+    message_pool->buffer_stride = 0u;
+    message_pool->buffer_capacity = 0u;
+    message_pool->num_buffers = 0u;
+    message_pool->num_free = 0u;
+  }
+  return RCL_RET_OK;
+}
+
+// \internal Takes a pooled buffer off the free stack, or returns `NULL` if
+// the pool cannot serve the request.
+static void *
+_message_pool_acquire_buffer(rcl_action_message_pool_t * message_pool, const size_t num_entries)
+{
+  if (num_entries > message_pool->buffer_capacity || 0u == message_pool->num_free) {
+    return NULL;
+  }
+  const size_t index = message_pool->free_indices[--message_pool->num_free];
+  return message_pool->slab + (index * message_pool->buffer_stride);
+}
+
+// \internal Pushes a pooled buffer back onto the free stack, or returns false
+// if the buffer is not pool storage.
+static bool
+_message_pool_release_buffer(rcl_action_message_pool_t * message_pool, void * buffer)
+{
+  uint8_t * bytes = (uint8_t *) buffer;
+  if (NULL == message_pool->slab ||
+    bytes < message_pool->slab ||
+    bytes >= message_pool->slab + (message_pool->num_buffers * message_pool->buffer_stride))
+  {
+    return false;
+  }
+  message_pool->free_indices[message_pool->num_free++] =
+    (size_t)(bytes - message_pool->slab) / message_pool->buffer_stride;
+  return true;
+}
+
+rcl_ret_t
+rcl_action_message_pool_acquire_goal_status_array(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_goal_status_array_t * status_array,
+  const size_t num_status)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(status_array, RCL_RET_INVALID_ARGUMENT);
+  // Size of array to provide must be greater than 0
+  if (0 == num_status) {
+    RCL_SET_ERROR_MSG("num_status must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Ensure status array is zero initialized
+  if (status_array->msg.status_list.size > 0) {
+    RCL_SET_ERROR_MSG("status_array already inititalized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  void * buffer = _message_pool_acquire_buffer(message_pool, num_status);
+  if (NULL == buffer) {
+    // Pool exhausted or request too big for a pooled buffer; fall back to the allocator
+    return rcl_action_goal_status_array_init(status_array, num_status, message_pool->allocator);
+  }
+  // Recycled buffers hold stale entries from their previous use
+  memset(buffer, 0, num_status * sizeof(rcl_action_goal_status_t));
+  status_array->msg.status_list.data = (rcl_action_goal_status_t *) buffer;
+  status_array->msg.status_list.size = num_status;
+  status_array->allocator = message_pool->allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_message_pool_release_goal_status_array(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_goal_status_array_t * status_array)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(status_array, RCL_RET_INVALID_ARGUMENT);
+  if (status_array->msg.status_list.data) {
+    if (!_message_pool_release_buffer(message_pool, status_array->msg.status_list.data)) {
+      // Not pool storage; this was a fallback allocation
+      return rcl_action_goal_status_array_fini(status_array);
+    }
+    status_array->msg.status_list.data = NULL;
+    status_array->msg.status_list.size = 0u;
+  }
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_message_pool_acquire_cancel_response(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_cancel_response_t * cancel_response,
+  const size_t num_goals_canceling)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_response, RCL_RET_INVALID_ARGUMENT);
+  // Size of array to provide must be greater than 0
+  if (0 == num_goals_canceling) {
+    RCL_SET_ERROR_MSG("num_goals_canceling must be greater than zero");
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  // Ensure cancel response is zero initialized
+  if (cancel_response->msg.goals_canceling.size > 0) {
+    RCL_SET_ERROR_MSG("cancel_response already inititalized");
+    return RCL_RET_ALREADY_INIT;
+  }
+  void * buffer = _message_pool_acquire_buffer(message_pool, num_goals_canceling);
+  if (NULL == buffer) {
+    // Pool exhausted or request too big for a pooled buffer; fall back to the allocator
+    return rcl_action_cancel_response_init(
+      cancel_response, num_goals_canceling, message_pool->allocator);
+  }
+  // Recycled buffers hold stale entries from their previous use
+  memset(buffer, 0, num_goals_canceling * sizeof(rcl_action_goal_info_t));
+  cancel_response->msg.goals_canceling.data = (rcl_action_goal_info_t *) buffer;
+  cancel_response->msg.goals_canceling.size = num_goals_canceling;
+  cancel_response->allocator = message_pool->allocator;
+  return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_action_message_pool_release_cancel_response(
+  rcl_action_message_pool_t * message_pool,
+  rcl_action_cancel_response_t * cancel_response)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(message_pool, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(cancel_response, RCL_RET_INVALID_ARGUMENT);
+  if (cancel_response->msg.goals_canceling.data) {
+    if (!_message_pool_release_buffer(message_pool, cancel_response->msg.goals_canceling.data)) {
+      // Not pool storage; this was a fallback allocation
+      return rcl_action_cancel_response_fini(cancel_response);
+    }
+    cancel_response->msg.goals_canceling.data = NULL;
+    cancel_response->msg.goals_canceling.size = 0u;
+  }
+  return RCL_RET_OK;
+}
+
 #ifdef __cplusplus
 }
 #endif
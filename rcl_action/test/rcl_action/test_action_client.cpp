@@ -223,3 +223,87 @@ TEST_F(TestActionClientFixture, test_action_client_get_options) {
   options = rcl_action_client_get_options(&this->action_client);
   ASSERT_NE(options, nullptr) << rcl_get_error_string().str;
 }
+
+TEST_F(TestActionClientFixture, test_action_client_goal_tags) {
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  for (uint8_t i = 0; i < UUID_SIZE; ++i) {
+    goal_info.uuid[i] = i;
+  }
+  int caller_state = 0;
+
+  rcl_ret_t ret = rcl_action_client_set_goal_tag(nullptr, &goal_info, &caller_state);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_client_set_goal_tag(&this->action_client, nullptr, &caller_state);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // No tag recorded yet
+  void * tag = nullptr;
+  ret = rcl_action_client_get_goal_tag(&this->action_client, &goal_info, &tag);
+  EXPECT_EQ(ret, RCL_RET_ERROR) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_client_set_goal_tag(&this->action_client, &goal_info, &caller_state);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_get_goal_tag(&this->action_client, &goal_info, &tag);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(tag, &caller_state);
+
+  // Setting a tag again replaces the previous one
+  int other_caller_state = 0;
+  ret = rcl_action_client_set_goal_tag(&this->action_client, &goal_info, &other_caller_state);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_get_goal_tag(&this->action_client, &goal_info, &tag);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(tag, &other_caller_state);
+
+  ret = rcl_action_client_remove_goal_tag(&this->action_client, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_remove_goal_tag(&this->action_client, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_ERROR) << rcl_get_error_string().str;
+  rcl_reset_error();
+}
+
+TEST_F(TestActionClientFixture, test_action_client_goal_id_filters) {
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  for (uint8_t i = 0; i < UUID_SIZE; ++i) {
+    goal_info.uuid[i] = i;
+  }
+
+  rcl_ret_t ret = rcl_action_client_add_goal_id_filter(nullptr, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ret = rcl_action_client_add_goal_id_filter(&this->action_client, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // No filter registered yet
+  ret = rcl_action_client_remove_goal_id_filter(&this->action_client, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_ERROR) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_client_add_goal_id_filter(&this->action_client, &goal_info);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  // Registering the same goal ID again is not an error
+  ret = rcl_action_client_add_goal_id_filter(&this->action_client, &goal_info);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_remove_goal_id_filter(&this->action_client, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // Clearing removes every registered filter
+  ret = rcl_action_client_add_goal_id_filter(&this->action_client, &goal_info);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_clear_goal_id_filters(&this->action_client);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_remove_goal_id_filter(&this->action_client, &goal_info);
+  EXPECT_EQ(ret, RCL_RET_ERROR) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Unregistering the extractor when none is registered is fine
+  ret = rcl_action_client_set_feedback_goal_id_extractor(&this->action_client, nullptr);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_client_set_feedback_goal_id_extractor(nullptr, nullptr);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID) << rcl_get_error_string().str;
+  rcl_reset_error();
+}
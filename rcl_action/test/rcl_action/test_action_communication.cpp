@@ -668,6 +668,202 @@ TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_valid_feedba
   test_msgs__action__Fibonacci_Feedback__fini(&outgoing_feedback);
 }
 
+TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_valid_feedback_batch_comm)
+{
+  const size_t num_feedback = 3;
+  test_msgs__action__Fibonacci_Feedback outgoing_feedback[num_feedback];
+  test_msgs__action__Fibonacci_Feedback incoming_feedback[num_feedback + 1];
+  const void * outgoing_messages[num_feedback];
+  void * incoming_messages[num_feedback + 1];
+  for (size_t i = 0; i < num_feedback; ++i) {
+    test_msgs__action__Fibonacci_Feedback__init(&outgoing_feedback[i]);
+    ASSERT_TRUE(rosidl_generator_c__int32__Sequence__init(
+        &outgoing_feedback[i].sequence, 1));
+    outgoing_feedback[i].sequence.data[0] = static_cast<int32_t>(i);
+    init_test_uuid0(outgoing_feedback[i].uuid);
+    outgoing_messages[i] = &outgoing_feedback[i];
+  }
+  for (size_t i = 0; i < num_feedback + 1; ++i) {
+    test_msgs__action__Fibonacci_Feedback__init(&incoming_feedback[i]);
+    incoming_messages[i] = &incoming_feedback[i];
+  }
+
+  // Publish feedback batch with null action server
+  rcl_ret_t ret = rcl_action_publish_feedback_batch(
+    nullptr, outgoing_messages, num_feedback);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Publish feedback batch with null messages
+  ret = rcl_action_publish_feedback_batch(&this->action_server, nullptr, num_feedback);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Publish feedback batch with valid arguments
+  ret = rcl_action_publish_feedback_batch(
+    &this->action_server, outgoing_messages, num_feedback);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_wait_set_add_action_client(
+    &this->wait_set, &this->action_client, NULL, NULL);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // Take feedback batch with null action client
+  size_t taken = 0u;
+  ret = rcl_action_take_feedback_batch(
+    nullptr, incoming_messages, num_feedback + 1, &taken);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_INVALID);
+  rcl_reset_error();
+
+  // Take feedback batch with null taken count
+  ret = rcl_action_take_feedback_batch(
+    &this->action_client, incoming_messages, num_feedback + 1, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Take the whole batch with valid arguments; the extra capacity stays unused
+  ret = rcl_action_take_feedback_batch(
+    &this->action_client, incoming_messages, num_feedback + 1, &taken);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ASSERT_EQ(taken, num_feedback);
+  for (size_t i = 0; i < num_feedback; ++i) {
+    EXPECT_TRUE(uuidcmp(outgoing_feedback[i].uuid, incoming_feedback[i].uuid));
+    ASSERT_EQ(incoming_feedback[i].sequence.size, 1u);
+    EXPECT_EQ(incoming_feedback[i].sequence.data[0], static_cast<int32_t>(i));
+  }
+
+  // Nothing left to take
+  ret = rcl_action_take_feedback_batch(
+    &this->action_client, incoming_messages, num_feedback + 1, &taken);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_TAKE_FAILED);
+  EXPECT_EQ(taken, 0u);
+  rcl_reset_error();
+
+  for (size_t i = 0; i < num_feedback; ++i) {
+    test_msgs__action__Fibonacci_Feedback__fini(&outgoing_feedback[i]);
+  }
+  for (size_t i = 0; i < num_feedback + 1; ++i) {
+    test_msgs__action__Fibonacci_Feedback__fini(&incoming_feedback[i]);
+  }
+}
+
+static const uint8_t *
+fibonacci_feedback_goal_id(const void * ros_feedback)
+{
+  return static_cast<const test_msgs__action__Fibonacci_Feedback *>(ros_feedback)->uuid;
+}
+
+TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_goal_id_filtered_comm)
+{
+  // Accept two goals so the status array has a tracked and a bystander entry
+  rcl_action_goal_info_t tracked_goal_info = rcl_action_get_zero_initialized_goal_info();
+  rcl_action_goal_info_t other_goal_info = rcl_action_get_zero_initialized_goal_info();
+  init_test_uuid0(tracked_goal_info.uuid);
+  init_test_uuid1(other_goal_info.uuid);
+  rcl_action_goal_handle_t * tracked_goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &tracked_goal_info);
+  ASSERT_NE(tracked_goal_handle, nullptr) << rcl_get_error_string().str;
+  rcl_action_goal_handle_t * other_goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &other_goal_info);
+  ASSERT_NE(other_goal_handle, nullptr) << rcl_get_error_string().str;
+
+  // Only track the first goal
+  rcl_ret_t ret = rcl_action_client_add_goal_id_filter(
+    &this->action_client, &tracked_goal_info);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  rcl_action_goal_status_array_t status_array =
+    rcl_action_get_zero_initialized_goal_status_array();
+  ret = rcl_action_get_goal_status_array(&this->action_server, &status_array);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ASSERT_EQ(status_array.msg.status_list.size, 2u);
+  ret = rcl_action_publish_status(&this->action_server, &status_array.msg);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_action_wait_set_add_action_client(
+    &this->wait_set, &this->action_client, NULL, NULL);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // The status array is compacted down to the tracked goal
+  action_msgs__msg__GoalStatusArray incoming_status_array;
+  action_msgs__msg__GoalStatusArray__init(&incoming_status_array);
+  ret = rcl_action_take_status(&this->action_client, &incoming_status_array);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+  ASSERT_EQ(incoming_status_array.status_list.size, 1u);
+  EXPECT_TRUE(uuidcmp(
+      tracked_goal_info.uuid, incoming_status_array.status_list.data[0].goal_info.uuid));
+
+  // Feedback filtering needs the caller to point out the goal ID field
+  ret = rcl_action_client_set_feedback_goal_id_extractor(
+    &this->action_client, fibonacci_feedback_goal_id);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  test_msgs__action__Fibonacci_Feedback outgoing_feedback;
+  test_msgs__action__Fibonacci_Feedback incoming_feedback;
+  test_msgs__action__Fibonacci_Feedback__init(&outgoing_feedback);
+  test_msgs__action__Fibonacci_Feedback__init(&incoming_feedback);
+  ASSERT_TRUE(rosidl_generator_c__int32__Sequence__init(
+      &outgoing_feedback.sequence, 1));
+
+  // Publish feedback for the bystander goal first, then for the tracked one
+  init_test_uuid1(outgoing_feedback.uuid);
+  outgoing_feedback.sequence.data[0] = 1;
+  ret = rcl_action_publish_feedback(&this->action_server, &outgoing_feedback);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  init_test_uuid0(outgoing_feedback.uuid);
+  outgoing_feedback.sequence.data[0] = 0;
+  ret = rcl_action_publish_feedback(&this->action_server, &outgoing_feedback);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  ret = rcl_wait_set_clear(&this->wait_set);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_action_wait_set_add_action_client(
+    &this->wait_set, &this->action_client, NULL, NULL);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  ret = rcl_wait(&this->wait_set, RCL_S_TO_NS(10));
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+
+  // The bystander feedback is dropped, so the first take yields the
+  // tracked goal's message
+  ret = rcl_action_take_feedback(&this->action_client, &incoming_feedback);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  rcl_reset_error();
+  EXPECT_TRUE(uuidcmp(tracked_goal_info.uuid, incoming_feedback.uuid));
+  ASSERT_EQ(incoming_feedback.sequence.size, 1u);
+  EXPECT_EQ(incoming_feedback.sequence.data[0], 0);
+
+  // Nothing left after the drop
+  ret = rcl_action_take_feedback(&this->action_client, &incoming_feedback);
+  EXPECT_EQ(ret, RCL_RET_ACTION_CLIENT_TAKE_FAILED);
+  rcl_reset_error();
+
+  // Clearing the filters turns filtering back off
+  ret = rcl_action_client_clear_goal_id_filters(&this->action_client);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  test_msgs__action__Fibonacci_Feedback__fini(&incoming_feedback);
+  test_msgs__action__Fibonacci_Feedback__fini(&outgoing_feedback);
+  action_msgs__msg__GoalStatusArray__fini(&incoming_status_array);
+  ret = rcl_action_goal_status_array_fini(&status_array);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(tracked_goal_handle));
+  EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(other_goal_handle));
+}
+
 TEST_F(CLASSNAME(TestActionCommunication, RMW_IMPLEMENTATION), test_invalid_goal_request_opts)
 {
   test_msgs__action__Fibonacci_Goal_Request outgoing_goal_request;
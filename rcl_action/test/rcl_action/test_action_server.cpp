@@ -289,6 +289,46 @@ TEST_F(TestActionServer, test_action_accept_new_goal)
   }
 }
 
+TEST_F(TestActionServer, test_action_accept_many_goals)
+{
+  // Accept enough goals to grow past the preallocated capacity and check that
+  // the UUID lookups stay consistent with the goal handle array
+  const size_t num_goals = 40u;
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  std::vector<rcl_action_goal_handle_t> handles;
+  for (size_t i = 0u; i < num_goals; ++i) {
+    goal_info.uuid[0] = static_cast<uint8_t>(i + 1u);
+    goal_info.uuid[1] = static_cast<uint8_t>((i + 1u) >> 8);
+    rcl_action_goal_handle_t * goal_handle =
+      rcl_action_accept_new_goal(&this->action_server, &goal_info);
+    ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+    handles.push_back(*goal_handle);
+  }
+
+  size_t num_tracked = 0u;
+  rcl_action_goal_handle_t ** goal_handle_array = {nullptr};
+  rcl_ret_t ret = rcl_action_server_get_goal_handles(
+    &this->action_server, &goal_handle_array, &num_tracked);
+  ASSERT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(num_tracked, num_goals);
+
+  for (size_t i = 0u; i < num_goals; ++i) {
+    goal_info.uuid[0] = static_cast<uint8_t>(i + 1u);
+    goal_info.uuid[1] = static_cast<uint8_t>((i + 1u) >> 8);
+    EXPECT_TRUE(rcl_action_server_goal_exists(&this->action_server, &goal_info));
+    // Duplicates are still rejected
+    EXPECT_EQ(nullptr, rcl_action_accept_new_goal(&this->action_server, &goal_info));
+    rcl_reset_error();
+  }
+  goal_info.uuid[0] = 0xffu;
+  goal_info.uuid[1] = 0xffu;
+  EXPECT_FALSE(rcl_action_server_goal_exists(&this->action_server, &goal_info));
+
+  for (auto & handle : handles) {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(&handle));
+  }
+}
+
 TEST_F(TestActionServer, test_action_clear_expired_goals)
 {
   const size_t capacity = 1u;
@@ -378,6 +418,58 @@ TEST_F(TestActionServer, test_action_process_cancel_request)
   EXPECT_EQ(cancel_response.msg.goals_canceling.size, 0u);
 }
 
+TEST_F(TestActionServer, test_action_defer_result_response)
+{
+  rcl_action_goal_info_t goal_info = rcl_action_get_zero_initialized_goal_info();
+  init_test_uuid0(goal_info.uuid);
+  rmw_request_id_t request_header;
+  request_header.sequence_number = 1;
+
+  // Defer with a null action server
+  rcl_ret_t ret = rcl_action_defer_result_response(nullptr, &goal_info, &request_header);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Defer with null goal info
+  ret = rcl_action_defer_result_response(&this->action_server, nullptr, &request_header);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Defer with null request header
+  ret = rcl_action_defer_result_response(&this->action_server, &goal_info, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Defer for a goal that is not tracked by the action server
+  ret = rcl_action_defer_result_response(&this->action_server, &goal_info, &request_header);
+  EXPECT_EQ(ret, RCL_RET_ACTION_GOAL_HANDLE_INVALID);
+  rcl_reset_error();
+
+  // Defer multiple requesters for an accepted goal
+  rcl_action_goal_handle_t * goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &goal_info);
+  ASSERT_NE(goal_handle, nullptr) << rcl_get_error_string().str;
+  for (int64_t i = 0; i < 5; ++i) {
+    request_header.sequence_number = i;
+    ret = rcl_action_defer_result_response(&this->action_server, &goal_info, &request_header);
+    EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  }
+
+  // Sending deferred responses for a goal with no recorded requesters is a no-op
+  rcl_action_goal_info_t other_goal_info = rcl_action_get_zero_initialized_goal_info();
+  init_test_uuid1(other_goal_info.uuid);
+  rcl_action_goal_handle_t * other_goal_handle =
+    rcl_action_accept_new_goal(&this->action_server, &other_goal_info);
+  ASSERT_NE(other_goal_handle, nullptr) << rcl_get_error_string().str;
+  int not_a_real_response;
+  ret = rcl_action_send_deferred_result_responses(
+    &this->action_server, &other_goal_info, &not_a_real_response);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(goal_handle));
+  EXPECT_EQ(RCL_RET_OK, rcl_action_goal_handle_fini(other_goal_handle));
+}
+
 TEST_F(TestActionServer, test_action_server_get_goal_status_array)
 {
   rcl_action_goal_status_array_t status_array =
@@ -487,6 +579,77 @@ TEST_F(TestActionServer, test_action_server_get_options)
   EXPECT_NE(options, nullptr) << rcl_get_error_string().str;
 }
 
+TEST_F(TestActionServer, test_action_server_status_coalescing)
+{
+  // Coalescing is off by default
+  rcl_action_server_options_t options = rcl_action_server_get_default_options();
+  EXPECT_FALSE(options.enable_status_coalescing);
+
+  // Flush is never due on a server without coalescing
+  bool due = true;
+  rcl_ret_t ret = rcl_action_server_status_flush_due(&this->action_server, &due);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_FALSE(due);
+
+  // Query with null action server
+  ret = rcl_action_server_status_flush_due(nullptr, &due);
+  EXPECT_EQ(ret, RCL_RET_ACTION_SERVER_INVALID);
+  rcl_reset_error();
+
+  // Query with null due flag
+  ret = rcl_action_server_status_flush_due(&this->action_server, nullptr);
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  rcl_reset_error();
+
+  // Bring up a second server with coalescing enabled
+  const rosidl_action_type_support_t * ts = ROSIDL_GET_ACTION_TYPE_SUPPORT(
+    test_msgs, Fibonacci);
+  options.enable_status_coalescing = true;
+  options.status_publish_period.nanoseconds = RCL_MS_TO_NS(200);
+  rcl_action_server_t coalescing_server = rcl_action_get_zero_initialized_server();
+  ret = rcl_action_server_init(
+    &coalescing_server, &this->node, &this->clock, ts,
+    "test_action_server_coalescing", &options);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  rcl_action_goal_status_array_t status_array =
+    rcl_action_get_zero_initialized_goal_status_array();
+  ret = rcl_action_get_goal_status_array(&coalescing_server, &status_array);
+  ASSERT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // The first publication in a period goes out immediately
+  ret = rcl_action_publish_status(&coalescing_server, &status_array.msg);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // A second publication within the period is deferred, not an error
+  ret = rcl_action_publish_status(&coalescing_server, &status_array.msg);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+
+  // The deferred publication is not due until the period elapses
+  due = true;
+  ret = rcl_action_server_status_flush_due(&coalescing_server, &due);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_FALSE(due);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ret = rcl_action_server_status_flush_due(&coalescing_server, &due);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_TRUE(due);
+
+  // Flushing publishes and clears the dirty flag
+  ret = rcl_action_publish_status(&coalescing_server, &status_array.msg);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  due = true;
+  ret = rcl_action_server_status_flush_due(&coalescing_server, &due);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_FALSE(due);
+
+  ret = rcl_action_goal_status_array_fini(&status_array);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  ret = rcl_action_server_fini(&coalescing_server, &this->node);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+}
+
 class TestActionServerCancelPolicy : public TestActionServer
 {
 protected:
@@ -547,6 +710,31 @@ TEST_F(TestActionServerCancelPolicy, test_action_process_cancel_request_all_goal
   EXPECT_EQ(RCL_RET_OK, rcl_action_cancel_response_fini(&cancel_response));
 }
 
+TEST_F(TestActionServerCancelPolicy, test_action_process_cancel_requests_batch)
+{
+  // Resolve a "cancel all" and a single goal cancel in one batch
+  rcl_action_cancel_request_t cancel_requests[2] = {
+    rcl_action_get_zero_initialized_cancel_request(),
+    rcl_action_get_zero_initialized_cancel_request()};
+  init_test_uuid0(cancel_requests[1].goal_info.uuid);
+  rcl_action_cancel_response_t cancel_responses[2] = {
+    rcl_action_get_zero_initialized_cancel_response(),
+    rcl_action_get_zero_initialized_cancel_response()};
+  rcl_ret_t ret = rcl_action_process_cancel_requests(
+    &this->action_server, cancel_requests, 2u, cancel_responses);
+  EXPECT_EQ(ret, RCL_RET_OK) << rcl_get_error_string().str;
+  EXPECT_NE(cancel_responses[0].msg.goals_canceling.data, nullptr);
+  ASSERT_EQ(cancel_responses[0].msg.goals_canceling.size, (size_t)NUM_GOALS);
+  ASSERT_EQ(cancel_responses[1].msg.goals_canceling.size, 1u);
+  EXPECT_TRUE(
+    uuidcmp(
+      cancel_responses[1].msg.goals_canceling.data[0].uuid,
+      cancel_requests[1].goal_info.uuid));
+  for (auto & cancel_response : cancel_responses) {
+    EXPECT_EQ(RCL_RET_OK, rcl_action_cancel_response_fini(&cancel_response));
+  }
+}
+
 TEST_F(TestActionServerCancelPolicy, test_action_process_cancel_request_single_goal)
 {
   // Request to cancel a specific goal
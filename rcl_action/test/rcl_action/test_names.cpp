@@ -137,3 +137,36 @@ INSTANTIATE_TEST_CASE_P(
   TestActionServiceAndTopicNames, TestActionDerivedName,
   ::testing::ValuesIn(action_service_and_topic_subjects),
   ::testing::PrintToStringParamName());
+
+TEST(TestActionNames, validate_names_struct)
+{
+  rcl_allocator_t default_allocator = rcl_get_default_allocator();
+
+  rcl_action_names_t names = rcl_action_get_zero_initialized_names();
+  rcl_ret_t ret = rcl_action_names_init(nullptr, "test_it", default_allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_action_names_init(&names, nullptr, default_allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+  ret = rcl_action_names_init(&names, "", default_allocator);
+  EXPECT_EQ(RCL_RET_ACTION_NAME_INVALID, ret);
+  rcl_reset_error();
+
+  ret = rcl_action_names_init(&names, "test_it", default_allocator);
+  ASSERT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_STREQ("test_it/_action/send_goal", names.goal_service_name);
+  EXPECT_STREQ("test_it/_action/cancel_goal", names.cancel_service_name);
+  EXPECT_STREQ("test_it/_action/get_result", names.result_service_name);
+  EXPECT_STREQ("test_it/_action/feedback", names.feedback_topic_name);
+  EXPECT_STREQ("test_it/_action/status", names.status_topic_name);
+
+  // Initializing twice would leak the first buffer
+  ret = rcl_action_names_init(&names, "test_it", default_allocator);
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, ret);
+  rcl_reset_error();
+
+  ret = rcl_action_names_fini(&names);
+  EXPECT_EQ(RCL_RET_OK, ret);
+  EXPECT_EQ(nullptr, names.goal_service_name);
+}
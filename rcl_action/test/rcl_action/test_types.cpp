@@ -161,3 +161,62 @@ TEST(TestActionTypes, test_init_fini_cancel_response)
   ret = rcl_action_cancel_response_fini(&cancel_response);
   EXPECT_EQ(ret, RCL_RET_OK);
 }
+
+TEST(TestActionTypes, test_message_pool)
+{
+  // Initialize with invalid message pool
+  rcl_ret_t ret = rcl_action_message_pool_init(nullptr, 2, 4, rcl_get_default_allocator());
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+
+  // Initialize with zero sizes
+  rcl_action_message_pool_t message_pool = rcl_action_get_zero_initialized_message_pool();
+  ret = rcl_action_message_pool_init(&message_pool, 0, 4, rcl_get_default_allocator());
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+  ret = rcl_action_message_pool_init(&message_pool, 2, 0, rcl_get_default_allocator());
+  EXPECT_EQ(ret, RCL_RET_INVALID_ARGUMENT);
+
+  // Initialize with valid arguments
+  ret = rcl_action_message_pool_init(&message_pool, 2, 4, rcl_get_default_allocator());
+  ASSERT_EQ(ret, RCL_RET_OK);
+
+  // Acquire a status array and a cancel response from the pool
+  rcl_action_goal_status_array_t status_array =
+    rcl_action_get_zero_initialized_goal_status_array();
+  ret = rcl_action_message_pool_acquire_goal_status_array(&message_pool, &status_array, 3);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(status_array.msg.status_list.size, 3u);
+  ASSERT_NE(status_array.msg.status_list.data, nullptr);
+  EXPECT_EQ(status_array.msg.status_list.data[0].status, 0);
+  rcl_action_cancel_response_t cancel_response = rcl_action_get_zero_initialized_cancel_response();
+  ret = rcl_action_message_pool_acquire_cancel_response(&message_pool, &cancel_response, 4);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(cancel_response.msg.goals_canceling.size, 4u);
+  EXPECT_NE(cancel_response.msg.goals_canceling.data, nullptr);
+
+  // The pool is exhausted, so a third acquire falls back to the allocator
+  rcl_action_goal_status_array_t fallback_array =
+    rcl_action_get_zero_initialized_goal_status_array();
+  ret = rcl_action_message_pool_acquire_goal_status_array(&message_pool, &fallback_array, 3);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(fallback_array.msg.status_list.size, 3u);
+  EXPECT_NE(fallback_array.msg.status_list.data, nullptr);
+
+  // Release everything; the pooled buffer should come back for reuse
+  ret = rcl_action_message_pool_release_goal_status_array(&message_pool, &fallback_array);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  rcl_action_goal_status_t * pooled_data = status_array.msg.status_list.data;
+  ret = rcl_action_message_pool_release_goal_status_array(&message_pool, &status_array);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(status_array.msg.status_list.data, nullptr);
+  ret = rcl_action_message_pool_acquire_goal_status_array(&message_pool, &status_array, 2);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  EXPECT_EQ(status_array.msg.status_list.data, pooled_data);
+  ret = rcl_action_message_pool_release_goal_status_array(&message_pool, &status_array);
+  EXPECT_EQ(ret, RCL_RET_OK);
+  ret = rcl_action_message_pool_release_cancel_response(&message_pool, &cancel_response);
+  EXPECT_EQ(ret, RCL_RET_OK);
+
+  // Finalize
+  ret = rcl_action_message_pool_fini(&message_pool);
+  EXPECT_EQ(ret, RCL_RET_OK);
+}
@@ -15,6 +15,9 @@
 #ifndef RCL_LIFECYCLE__DATA_TYPES_H_
 #define RCL_LIFECYCLE__DATA_TYPES_H_
 
+#include "lifecycle_msgs/msg/transition_event.h"
+#include "lifecycle_msgs/srv/get_available_transitions.h"
+
 #include "rcl/rcl.h"
 
 #include "rcl_lifecycle/visibility_control.h"
@@ -49,8 +52,30 @@ typedef struct rcl_lifecycle_transition_map_t
   unsigned int states_size;
   rcl_lifecycle_transition_t * transitions;
   unsigned int transitions_size;
+  // Direct index from state id to its slot in states, stored as slot + 1
+  // so zero marks an id without a state
+  unsigned int * state_index;
+  unsigned int state_index_size;
+  // Direct index from transition id to its slot in transitions, stored as
+  // slot + 1 so zero marks an id without a transition
+  unsigned int * transition_index;
+  unsigned int transition_index_size;
+  // True when states and transitions reference shared static storage,
+  // e.g. the default state machine; such a map must not be modified or freed
+  bool is_static;
 } rcl_lifecycle_transition_map_t;
 
+/// Per-interface enable flags for the communication surface of a state machine.
+typedef struct rcl_lifecycle_com_interface_options_t
+{
+  bool enable_transition_event_publisher;
+  bool enable_change_state_service;
+  bool enable_get_state_service;
+  bool enable_get_available_states_service;
+  bool enable_get_available_transitions_service;
+  bool enable_get_transition_graph_service;
+} rcl_lifecycle_com_interface_options_t;
+
 typedef struct rcl_lifecycle_com_interface_t
 {
   rcl_node_t * node_handle;
@@ -60,15 +85,59 @@ typedef struct rcl_lifecycle_com_interface_t
   rcl_service_t srv_get_available_states;
   rcl_service_t srv_get_available_transitions;
   rcl_service_t srv_get_transition_graph;
+  // Which interfaces have been created so far
+  rcl_lifecycle_com_interface_options_t enabled;
+  // Type supports retained so disabled interfaces can be created later
+  const rosidl_message_type_support_t * ts_pub_notify;
+  const rosidl_service_type_support_t * ts_srv_change_state;
+  const rosidl_service_type_support_t * ts_srv_get_state;
+  const rosidl_service_type_support_t * ts_srv_get_available_states;
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions;
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph;
+  // Preinitialized transition event message reused for every notification
+  lifecycle_msgs__msg__TransitionEvent transition_event_msg;
 } rcl_lifecycle_com_interface_t;
 
+// The assumption that this is big enough for an atomic_uintptr_t is
+// ensured with a static_assert in the rcl_lifecycle.c file.
+// In most cases it should just be a plain pointer.
+#if !defined(RCL_LIFECYCLE_ATOMIC_CURRENT_STATE_STORAGE_SIZE)
+#define RCL_LIFECYCLE_ATOMIC_CURRENT_STATE_STORAGE_SIZE sizeof(uintptr_t)
+#endif
+
+/// A lazily materialized GetAvailableTransitions response for one state.
+typedef struct rcl_lifecycle_available_transitions_cache_entry_t
+{
+  lifecycle_msgs__srv__GetAvailableTransitions_Response response;
+  // Number of valid transitions when the response was built, plus one;
+  // zero marks an entry that has not been built yet
+  unsigned int built_size;
+} rcl_lifecycle_available_transitions_cache_entry_t;
+
 typedef struct rcl_lifecycle_state_machine_t
 {
-  const rcl_lifecycle_state_t * current_state;
+  /// Private storage for the current state atomic.
+  /**
+   * Accessing the current state should be done using the function
+   * `rcl_lifecycle_get_current_state()` because the current state is
+   * published atomically by transitions and needs to be loaded atomically
+   * to be read safely from other threads.
+   *
+   * The current state should not be changed manually - doing so is
+   * undefined behavior.
+   *
+   * C11 atomics (i.e. "stdatomic.h") cannot be used directly
+   * here in the case that this header is included into a C++ program.
+   */
+  uint8_t current_state_storage[RCL_LIFECYCLE_ATOMIC_CURRENT_STATE_STORAGE_SIZE];
   // Map/Associated array of registered states and transitions
   rcl_lifecycle_transition_map_t transition_map;
   // Communication interface into a ROS world
   rcl_lifecycle_com_interface_t com_interface;
+  // Available-transition responses cached per state slot, built on first
+  // use by rcl_lifecycle_get_available_transitions()
+  rcl_lifecycle_available_transitions_cache_entry_t * available_transitions_cache;
+  unsigned int available_transitions_cache_size;
 } rcl_lifecycle_state_machine_t;
 
 #ifdef __cplusplus
@@ -79,6 +79,32 @@ RCL_LIFECYCLE_PUBLIC
 rcl_lifecycle_state_machine_t
 rcl_lifecycle_get_zero_initialized_state_machine();
 
+/// Return options with every communication interface enabled
+RCL_LIFECYCLE_PUBLIC
+rcl_lifecycle_com_interface_options_t
+rcl_lifecycle_com_interface_get_default_options();
+
+/// Initialize a state machine, creating only the enabled com interfaces
+/**
+ * Interfaces left disabled in \p com_interface_options can be created
+ * later with rcl_lifecycle_state_machine_enable_com_interface().
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_state_machine_init_with_options(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  const rcl_lifecycle_com_interface_options_t * com_interface_options,
+  bool default_states,
+  const rcl_allocator_t * allocator);
+
 RCL_LIFECYCLE_PUBLIC
 RCL_WARN_UNUSED
 rcl_ret_t
@@ -94,6 +120,15 @@ rcl_lifecycle_state_machine_init(
   bool default_states,
   const rcl_allocator_t * allocator);
 
+/// Create com interfaces that were left disabled at initialization
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+rcl_ret_t
+rcl_lifecycle_state_machine_enable_com_interface(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rcl_lifecycle_com_interface_options_t * com_interface_options);
+
 RCL_LIFECYCLE_PUBLIC
 RCL_WARN_UNUSED
 rcl_ret_t
@@ -108,6 +143,32 @@ rcl_ret_t
 rcl_lifecycle_state_machine_is_initialized(
   const rcl_lifecycle_state_machine_t * state_machine);
 
+/// Return the current state, loaded atomically
+/**
+ * Safe to call concurrently with a transition; readers never block and
+ * never contend with rcl_lifecycle_trigger_transition_by_id() or
+ * rcl_lifecycle_trigger_transition_by_label().
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+const rcl_lifecycle_state_t *
+rcl_lifecycle_get_current_state(
+  const rcl_lifecycle_state_machine_t * state_machine);
+
+/// Return the available transitions of the current state as a response message
+/**
+ * The response is materialized once per state and cached inside the state
+ * machine, so repeated queries for the same state only copy the cached
+ * message. The returned pointer is owned by the state machine and stays
+ * valid until the state machine is finalized.
+ */
+RCL_LIFECYCLE_PUBLIC
+RCL_WARN_UNUSED
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_available_transitions(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator);
+
 RCL_LIFECYCLE_PUBLIC
 RCL_WARN_UNUSED
 const rcl_lifecycle_transition_t *
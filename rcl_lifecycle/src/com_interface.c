@@ -36,13 +36,12 @@ extern "C"
 
 #include "rcl_lifecycle/data_types.h"
 
-static lifecycle_msgs__msg__TransitionEvent msg;
 static const char * pub_transition_event_topic = "~/transition_event";
 static const char * srv_change_state_service = "~/change_state";
 static const char * srv_get_state_service = "~/get_state";
 static const char * srv_get_available_states_service = "~/get_available_states";
 static const char * srv_get_available_transitions_service = "~/get_available_transitions";
-static const char * srv_get_transition_graph = "~/get_transition_graph";
+static const char * srv_get_transition_graph_service = "~/get_transition_graph";
 
 rcl_lifecycle_com_interface_t
 rcl_lifecycle_get_zero_initialized_com_interface()
@@ -55,106 +54,135 @@ rcl_lifecycle_get_zero_initialized_com_interface()
   com_interface.srv_get_available_states = rcl_get_zero_initialized_service();
   com_interface.srv_get_available_transitions = rcl_get_zero_initialized_service();
   com_interface.srv_get_transition_graph = rcl_get_zero_initialized_service();
+  memset(&com_interface.enabled, 0, sizeof(com_interface.enabled));
+  com_interface.ts_pub_notify = NULL;
+  com_interface.ts_srv_change_state = NULL;
+  com_interface.ts_srv_get_state = NULL;
+  com_interface.ts_srv_get_available_states = NULL;
+  com_interface.ts_srv_get_available_transitions = NULL;
+  com_interface.ts_srv_get_transition_graph = NULL;
+  memset(&com_interface.transition_event_msg, 0, sizeof(com_interface.transition_event_msg));
   return com_interface;
 }
 
-rcl_ret_t
-rcl_lifecycle_com_interface_init(
+rcl_lifecycle_com_interface_options_t
+rcl_lifecycle_com_interface_get_default_options()
+{
+  // every interface is enabled by default, matching the behavior before the
+  // flags existed
+  rcl_lifecycle_com_interface_options_t options;
+  options.enable_transition_event_publisher = true;
+  options.enable_change_state_service = true;
+  options.enable_get_state_service = true;
+  options.enable_get_available_states_service = true;
+  options.enable_get_available_transitions_service = true;
+  options.enable_get_transition_graph_service = true;
+  return options;
+}
+
+// \internal Creates one lifecycle service if it is enabled and not created yet.
+#define COM_SERVICE_INIT(Type) \
+  if (options->enable_ ## Type ## _service && \
+    !com_interface->enabled.enable_ ## Type ## _service) \
+  { \
+    if (!com_interface->ts_srv_ ## Type) { \
+      RCL_SET_ERROR_MSG("no type support retained for " #Type " service"); \
+      return RCL_RET_INVALID_ARGUMENT; \
+    } \
+    rcl_service_options_t service_options = rcl_service_get_default_options(); \
+    rcl_ret_t ret = rcl_service_init( \
+      &com_interface->srv_ ## Type, node_handle, \
+      com_interface->ts_srv_ ## Type, srv_ ## Type ## _service, &service_options); \
+    if (ret != RCL_RET_OK) { \
+      return ret; \
+    } \
+    com_interface->enabled.enable_ ## Type ## _service = true; \
+  }
+
+// create every interface enabled in options that has not been created yet
+static rcl_ret_t
+_com_interface_create_enabled(
   rcl_lifecycle_com_interface_t * com_interface,
   rcl_node_t * node_handle,
-  const rosidl_message_type_support_t * ts_pub_notify,
-  const rosidl_service_type_support_t * ts_srv_change_state,
-  const rosidl_service_type_support_t * ts_srv_get_state,
-  const rosidl_service_type_support_t * ts_srv_get_available_states,
-  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
-  const rosidl_service_type_support_t * ts_srv_get_transition_graph)
+  const rcl_lifecycle_com_interface_options_t * options)
 {
-  RCL_CHECK_ARGUMENT_FOR_NULL(com_interface, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(node_handle, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_pub_notify, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_change_state, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_state, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_available_states, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_available_transitions, RCL_RET_INVALID_ARGUMENT);
-  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_transition_graph, RCL_RET_INVALID_ARGUMENT);
-
   // initialize publisher
+  if (options->enable_transition_event_publisher &&
+    !com_interface->enabled.enable_transition_event_publisher)
   {
+    if (!com_interface->ts_pub_notify) {
+      RCL_SET_ERROR_MSG("no type support retained for transition event publisher");
+      return RCL_RET_INVALID_ARGUMENT;
+    }
     rcl_publisher_options_t publisher_options = rcl_publisher_get_default_options();
     rcl_ret_t ret = rcl_publisher_init(
       &com_interface->pub_transition_event, node_handle,
-      ts_pub_notify, pub_transition_event_topic, &publisher_options);
-
+      com_interface->ts_pub_notify, pub_transition_event_topic, &publisher_options);
     if (ret != RCL_RET_OK) {
-      goto fail;
+      return ret;
     }
 
-    // initialize static message for notification
-    lifecycle_msgs__msg__TransitionEvent__init(&msg);
+    // initialize the reused message for notification once
+    lifecycle_msgs__msg__TransitionEvent__init(&com_interface->transition_event_msg);
+    com_interface->enabled.enable_transition_event_publisher = true;
   }
 
   // initialize change state service
-  {
-    rcl_service_options_t service_options = rcl_service_get_default_options();
-    rcl_ret_t ret = rcl_service_init(
-      &com_interface->srv_change_state, node_handle,
-      ts_srv_change_state, srv_change_state_service, &service_options);
-
-    if (ret != RCL_RET_OK) {
-      goto fail;
-    }
-  }
+  COM_SERVICE_INIT(change_state);
 
   // initialize get state service
-  {
-    rcl_service_options_t service_options = rcl_service_get_default_options();
-    rcl_ret_t ret = rcl_service_init(
-      &com_interface->srv_get_state, node_handle,
-      ts_srv_get_state, srv_get_state_service, &service_options);
-
-    if (ret != RCL_RET_OK) {
-      goto fail;
-    }
-  }
+  COM_SERVICE_INIT(get_state);
 
   // initialize get available states service
-  {
-    rcl_service_options_t service_options = rcl_service_get_default_options();
-    rcl_ret_t ret = rcl_service_init(
-      &com_interface->srv_get_available_states, node_handle,
-      ts_srv_get_available_states, srv_get_available_states_service, &service_options);
-
-    if (ret != RCL_RET_OK) {
-      goto fail;
-    }
-  }
+  COM_SERVICE_INIT(get_available_states);
 
   // initialize get available transitions service
-  {
-    rcl_service_options_t service_options = rcl_service_get_default_options();
-    rcl_ret_t ret = rcl_service_init(
-      &com_interface->srv_get_available_transitions, node_handle,
-      ts_srv_get_available_transitions, srv_get_available_transitions_service, &service_options);
-
-    if (ret != RCL_RET_OK) {
-      goto fail;
-    }
-  }
+  COM_SERVICE_INIT(get_available_transitions);
 
   // initialize get transition graph service
-  {
-    rcl_service_options_t service_options = rcl_service_get_default_options();
-    rcl_ret_t ret = rcl_service_init(
-      &com_interface->srv_get_transition_graph, node_handle,
-      ts_srv_get_transition_graph, srv_get_transition_graph, &service_options);
+  COM_SERVICE_INIT(get_transition_graph);
 
-    if (ret != RCL_RET_OK) {
-      goto fail;
-    }
-  }
   return RCL_RET_OK;
+}
+
+rcl_ret_t
+rcl_lifecycle_com_interface_init(
+  rcl_lifecycle_com_interface_t * com_interface,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  const rcl_lifecycle_com_interface_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(com_interface, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_pub_notify, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_change_state, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_state, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_available_states, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_available_transitions, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(ts_srv_get_transition_graph, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+
+  // retain the type supports, so interfaces left disabled here can still be
+  // created later with rcl_lifecycle_com_interface_enable
+  com_interface->ts_pub_notify = ts_pub_notify;
+  com_interface->ts_srv_change_state = ts_srv_change_state;
+  com_interface->ts_srv_get_state = ts_srv_get_state;
+  com_interface->ts_srv_get_available_states = ts_srv_get_available_states;
+  com_interface->ts_srv_get_available_transitions = ts_srv_get_available_transitions;
+  com_interface->ts_srv_get_transition_graph = ts_srv_get_transition_graph;
+
+  rcl_ret_t ret = _com_interface_create_enabled(com_interface, node_handle, options);
+  if (ret == RCL_RET_OK) {
+    return RCL_RET_OK;
+  }
 
-fail:
+  // creation failed part way, tear down whatever was brought up
+  memset(&com_interface->enabled, 0, sizeof(com_interface->enabled));
   if (RCL_RET_OK != rcl_publisher_fini(&com_interface->pub_transition_event, node_handle)) {
     RCUTILS_LOG_ERROR_NAMED(ROS_PACKAGE_NAME, "Failed to destroy transition_event publisher");
   }
@@ -179,6 +207,19 @@ fail:
   return RCL_RET_ERROR;
 }
 
+rcl_ret_t
+rcl_lifecycle_com_interface_enable(
+  rcl_lifecycle_com_interface_t * com_interface,
+  rcl_node_t * node_handle,
+  const rcl_lifecycle_com_interface_options_t * options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(com_interface, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(node_handle, RCL_RET_INVALID_ARGUMENT);
+  RCL_CHECK_ARGUMENT_FOR_NULL(options, RCL_RET_INVALID_ARGUMENT);
+
+  return _com_interface_create_enabled(com_interface, node_handle, options);
+}
+
 rcl_ret_t
 rcl_lifecycle_com_interface_fini(
   rcl_lifecycle_com_interface_t * com_interface,
@@ -233,7 +274,7 @@ rcl_lifecycle_com_interface_fini(
 
   // destroy the publisher
   {
-    lifecycle_msgs__msg__TransitionEvent__fini(&msg);
+    lifecycle_msgs__msg__TransitionEvent__fini(&com_interface->transition_event_msg);
 
     rcl_ret_t ret = rcl_publisher_fini(
       &com_interface->pub_transition_event, node_handle);
@@ -242,20 +283,59 @@ rcl_lifecycle_com_interface_fini(
     }
   }
 
+  memset(&com_interface->enabled, 0, sizeof(com_interface->enabled));
+  com_interface->ts_pub_notify = NULL;
+  com_interface->ts_srv_change_state = NULL;
+  com_interface->ts_srv_get_state = NULL;
+  com_interface->ts_srv_get_available_states = NULL;
+  com_interface->ts_srv_get_available_transitions = NULL;
+  com_interface->ts_srv_get_transition_graph = NULL;
+
   return fcn_ret;
 }
 
+// update one state field of the reused transition event message
+static rcl_ret_t
+_transition_event_set_state(
+  lifecycle_msgs__msg__State * event_state, const rcl_lifecycle_state_t * state)
+{
+  event_state->id = state->id;
+  const size_t label_length = strlen(state->label);
+  if (event_state->label.capacity > label_length) {
+    // the label fits into the buffer of a previous event, so just copy it
+    // in place and keep the publish path allocation free
+    memcpy(event_state->label.data, state->label, label_length + 1);
+    event_state->label.size = label_length;
+    return RCL_RET_OK;
+  }
+  if (!rosidl_generator_c__String__assign(&event_state->label, state->label)) {
+    RCL_SET_ERROR_MSG("failed to assign state label to transition event message");
+    return RCL_RET_ERROR;
+  }
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_lifecycle_com_interface_publish_notification(
   rcl_lifecycle_com_interface_t * com_interface,
   const rcl_lifecycle_state_t * start, const rcl_lifecycle_state_t * goal)
 {
-  msg.start_state.id = start->id;
-  rosidl_generator_c__String__assign(&msg.start_state.label, start->label);
-  msg.goal_state.id = goal->id;
-  rosidl_generator_c__String__assign(&msg.goal_state.label, goal->label);
+  if (!com_interface->enabled.enable_transition_event_publisher) {
+    RCL_SET_ERROR_MSG("transition event publisher is not enabled");
+    return RCL_RET_ERROR;
+  }
+
+  lifecycle_msgs__msg__TransitionEvent * msg = &com_interface->transition_event_msg;
+  rcl_ret_t ret = _transition_event_set_state(&msg->start_state, start);
+  if (ret != RCL_RET_OK) {
+    return ret;  // error already set
+  }
+  ret = _transition_event_set_state(&msg->goal_state, goal);
+  if (ret != RCL_RET_OK) {
+    return ret;  // error already set
+  }
 
-  return rcl_publish(&com_interface->pub_transition_event, &msg);
+  return rcl_publish(&com_interface->pub_transition_event, msg);
 }
 
 #ifdef __cplusplus
@@ -27,6 +27,9 @@ extern "C"
 rcl_lifecycle_com_interface_t
 rcl_lifecycle_get_zero_initialized_com_interface();
 
+rcl_lifecycle_com_interface_options_t
+rcl_lifecycle_com_interface_get_default_options();
+
 rcl_ret_t
 RCL_WARN_UNUSED
 rcl_lifecycle_com_interface_init(
@@ -37,7 +40,15 @@ rcl_lifecycle_com_interface_init(
   const rosidl_service_type_support_t * ts_srv_get_state,
   const rosidl_service_type_support_t * ts_srv_get_available_states,
   const rosidl_service_type_support_t * ts_srv_get_available_transitions,
-  const rosidl_service_type_support_t * ts_srv_get_transition_graph);
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  const rcl_lifecycle_com_interface_options_t * options);
+
+rcl_ret_t
+RCL_WARN_UNUSED
+rcl_lifecycle_com_interface_enable(
+  rcl_lifecycle_com_interface_t * com_interface,
+  rcl_node_t * node_handle,
+  const rcl_lifecycle_com_interface_options_t * options);
 
 rcl_ret_t
 RCL_WARN_UNUSED
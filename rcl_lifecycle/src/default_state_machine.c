@@ -24,6 +24,8 @@
 #include "rcl/error_handling.h"
 #include "rcl/rcl.h"
 
+#include "rcutils/stdatomic_helper.h"
+
 #include "rcl_lifecycle/transition_map.h"
 
 #ifdef __cplusplus
@@ -41,660 +43,223 @@ const char * rcl_lifecycle_transition_success_label = "transition_success";
 const char * rcl_lifecycle_transition_failure_label = "transition_failure";
 const char * rcl_lifecycle_transition_error_label = "transition_error";
 
-rcl_ret_t
-_register_primary_states(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
-{
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // default values for when registering states
-  // all states are registered with no transitions attached
-  // the valid transitions per state are filled once transitions are registered
-  rcl_lifecycle_transition_t * valid_transitions = NULL;
-  unsigned int valid_transition_size = 0;
-
-  // register unknown state
-  {
-    rcl_lifecycle_state_t rcl_state_unknown = {
-      "unknown", lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_unknown, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register unconfigured state
-  {
-    rcl_lifecycle_state_t rcl_state_unconfigured = {
-      "unconfigured", lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_unconfigured, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register inactive state
-  {
-    rcl_lifecycle_state_t rcl_state_inactive = {
-      "inactive", lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_inactive, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register active state
-  {
-    rcl_lifecycle_state_t rcl_state_active = {
-      "active", lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_active, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
+// The default state machine as despicted on design.ros2.org is identical and
+// immutable for every node, so it is built once at compile time and shared by
+// reference instead of being registered state by state through the dynamic
+// transition map API, which reallocates per registration.
 
-  // register finalized state
-  {
-    rcl_lifecycle_state_t rcl_state_finalized = {
-      "finalized", lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_finalized, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  return ret;
-}
-
-rcl_ret_t
-_register_transition_states(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
+// Indices of the states in the shared state array
+enum
 {
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // default values for when registering states
-  // all states are registered with no transitions attached
-  // the valid transitions per state are filled once transitions are registered
-  rcl_lifecycle_transition_t * valid_transitions = NULL;
-  unsigned int valid_transition_size = 0;
-
-  // register configuring state
-  {
-    rcl_lifecycle_state_t rcl_state_configuring = {
-      "configuring", lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_configuring, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register cleaningup state
-  {
-    rcl_lifecycle_state_t rcl_state_cleaningup = {
-      "cleaningup", lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_cleaningup, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register shutting down state
-  {
-    rcl_lifecycle_state_t rcl_state_shuttingdown = {
-      "shuttingdown", lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_shuttingdown, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register activating state
-  {
-    rcl_lifecycle_state_t rcl_state_activating = {
-      "activating", lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_activating, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register deactivating state
-  {
-    rcl_lifecycle_state_t rcl_state_deactivating = {
-      "deactivating", lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_deactivating, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register errorprocessing state
-  {
-    rcl_lifecycle_state_t rcl_state_errorprocessing = {
-      "errorprocessing", lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING,
-      valid_transitions, valid_transition_size
-    };
-    ret = rcl_lifecycle_register_state(
-      transition_map, rcl_state_errorprocessing, allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  return ret;
-}
-
-rcl_ret_t
-_register_transitions(
-  rcl_lifecycle_transition_map_t * transition_map, const rcutils_allocator_t * allocator)
-{
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // retrieve primary and transition states from the transition map
-  // note: These states are pointing to the states inside the map
-  // the states created before (see _register_primary_states) were copied into the map
-  // and thus have to be retrieved from the map again to not invalidate pointers.
-
-  rcl_lifecycle_state_t * unconfigured_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED);
-  rcl_lifecycle_state_t * inactive_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
-  rcl_lifecycle_state_t * active_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE);
-  rcl_lifecycle_state_t * finalized_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED);
-
-  rcl_lifecycle_state_t * configuring_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING);
-  rcl_lifecycle_state_t * activating_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING);
-  rcl_lifecycle_state_t * deactivating_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING);
-  rcl_lifecycle_state_t * cleaningup_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP);
-  rcl_lifecycle_state_t * shuttingdown_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN);
-  rcl_lifecycle_state_t * errorprocessing_state = rcl_lifecycle_get_state(
-    transition_map, lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING);
-
-  // register transition from unconfigured to configuring
-  {
-    rcl_lifecycle_transition_t rcl_transition_configure = {
-      rcl_lifecycle_configure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
-      unconfigured_state, configuring_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_configure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from configuring to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
-      configuring_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
+  DEFAULT_STATE_UNKNOWN = 0,
+  DEFAULT_STATE_UNCONFIGURED,
+  DEFAULT_STATE_INACTIVE,
+  DEFAULT_STATE_ACTIVE,
+  DEFAULT_STATE_FINALIZED,
+  DEFAULT_STATE_CONFIGURING,
+  DEFAULT_STATE_CLEANINGUP,
+  DEFAULT_STATE_SHUTTINGDOWN,
+  DEFAULT_STATE_ACTIVATING,
+  DEFAULT_STATE_DEACTIVATING,
+  DEFAULT_STATE_ERRORPROCESSING,
+  DEFAULT_STATE_COUNT
+};
+
+#define DEFAULT_TRANSITION_COUNT 25u
+
+// Tentative definition; the transitions reference the states and the states
+// reference slices of the transition array, so one of them has to be named
+// before it is initialized
+static rcl_lifecycle_transition_t _default_transitions[DEFAULT_TRANSITION_COUNT];
+
+// The transitions are grouped by their start state, so every state can point
+// at a contiguous slice of the shared transition array as its valid
+// transitions instead of owning a separate copy
+static rcl_lifecycle_state_t _default_states[DEFAULT_STATE_COUNT] = {
+  {"unknown", lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN,
+    NULL, 0},
+  {"unconfigured", lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    &_default_transitions[0], 2},
+  {"inactive", lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE,
+    &_default_transitions[2], 3},
+  {"active", lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE,
+    &_default_transitions[5], 2},
+  {"finalized", lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED,
+    NULL, 0},
+  {"configuring", lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
+    &_default_transitions[7], 3},
+  {"cleaningup", lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP,
+    &_default_transitions[10], 3},
+  {"shuttingdown", lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN,
+    &_default_transitions[13], 3},
+  {"activating", lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING,
+    &_default_transitions[16], 3},
+  {"deactivating", lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING,
+    &_default_transitions[19], 3},
+  {"errorprocessing", lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING,
+    &_default_transitions[22], 3},
+};
+
+static rcl_lifecycle_transition_t _default_transitions[DEFAULT_TRANSITION_COUNT] = {
+  // transitions out of the unconfigured state
+  {"configure",
+    lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE,
+    &_default_states[DEFAULT_STATE_UNCONFIGURED], &_default_states[DEFAULT_STATE_CONFIGURING]},
+  {"shutdown",
+    lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN,
+    &_default_states[DEFAULT_STATE_UNCONFIGURED], &_default_states[DEFAULT_STATE_SHUTTINGDOWN]},
+  // transitions out of the inactive state
+  {"cleanup",
+    lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP,
+    &_default_states[DEFAULT_STATE_INACTIVE], &_default_states[DEFAULT_STATE_CLEANINGUP]},
+  {"activate",
+    lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
+    &_default_states[DEFAULT_STATE_INACTIVE], &_default_states[DEFAULT_STATE_ACTIVATING]},
+  {"shutdown",
+    lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN,
+    &_default_states[DEFAULT_STATE_INACTIVE], &_default_states[DEFAULT_STATE_SHUTTINGDOWN]},
+  // transitions out of the active state
+  {"deactivate",
+    lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
+    &_default_states[DEFAULT_STATE_ACTIVE], &_default_states[DEFAULT_STATE_DEACTIVATING]},
+  {"shutdown",
+    lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN,
+    &_default_states[DEFAULT_STATE_ACTIVE], &_default_states[DEFAULT_STATE_SHUTTINGDOWN]},
+  // transitions out of the configuring state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS,
+    &_default_states[DEFAULT_STATE_CONFIGURING], &_default_states[DEFAULT_STATE_INACTIVE]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE,
+    &_default_states[DEFAULT_STATE_CONFIGURING], &_default_states[DEFAULT_STATE_UNCONFIGURED]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR,
+    &_default_states[DEFAULT_STATE_CONFIGURING], &_default_states[DEFAULT_STATE_ERRORPROCESSING]},
+  // transitions out of the cleaningup state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS,
+    &_default_states[DEFAULT_STATE_CLEANINGUP], &_default_states[DEFAULT_STATE_UNCONFIGURED]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE,
+    &_default_states[DEFAULT_STATE_CLEANINGUP], &_default_states[DEFAULT_STATE_INACTIVE]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR,
+    &_default_states[DEFAULT_STATE_CLEANINGUP], &_default_states[DEFAULT_STATE_ERRORPROCESSING]},
+  // transitions out of the shuttingdown state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS,
+    &_default_states[DEFAULT_STATE_SHUTTINGDOWN], &_default_states[DEFAULT_STATE_FINALIZED]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE,
+    &_default_states[DEFAULT_STATE_SHUTTINGDOWN], &_default_states[DEFAULT_STATE_FINALIZED]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR,
+    &_default_states[DEFAULT_STATE_SHUTTINGDOWN], &_default_states[DEFAULT_STATE_ERRORPROCESSING]},
+  // transitions out of the activating state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
+    &_default_states[DEFAULT_STATE_ACTIVATING], &_default_states[DEFAULT_STATE_ACTIVE]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE,
+    &_default_states[DEFAULT_STATE_ACTIVATING], &_default_states[DEFAULT_STATE_INACTIVE]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR,
+    &_default_states[DEFAULT_STATE_ACTIVATING], &_default_states[DEFAULT_STATE_ERRORPROCESSING]},
+  // transitions out of the deactivating state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
+    &_default_states[DEFAULT_STATE_DEACTIVATING], &_default_states[DEFAULT_STATE_INACTIVE]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE,
+    &_default_states[DEFAULT_STATE_DEACTIVATING], &_default_states[DEFAULT_STATE_ACTIVE]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR,
+    &_default_states[DEFAULT_STATE_DEACTIVATING], &_default_states[DEFAULT_STATE_ERRORPROCESSING]},
+  // transitions out of the errorprocessing state
+  {"transition_success",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS,
+    &_default_states[DEFAULT_STATE_ERRORPROCESSING], &_default_states[DEFAULT_STATE_UNCONFIGURED]},
+  {"transition_failure",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE,
+    &_default_states[DEFAULT_STATE_ERRORPROCESSING], &_default_states[DEFAULT_STATE_FINALIZED]},
+  {"transition_error",
+    lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR,
+    &_default_states[DEFAULT_STATE_ERRORPROCESSING], &_default_states[DEFAULT_STATE_FINALIZED]},
+};
+
+// Direct lookup indexes for the shared machine; entries hold slot + 1 so
+// zero marks an id without a state or transition
+static unsigned int _default_state_index[] = {
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_UNKNOWN] = DEFAULT_STATE_UNKNOWN + 1,
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED] = DEFAULT_STATE_UNCONFIGURED + 1,
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE] = DEFAULT_STATE_INACTIVE + 1,
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE] = DEFAULT_STATE_ACTIVE + 1,
+  [lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED] = DEFAULT_STATE_FINALIZED + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING] = DEFAULT_STATE_CONFIGURING + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP] = DEFAULT_STATE_CLEANINGUP + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN] = DEFAULT_STATE_SHUTTINGDOWN + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING] = DEFAULT_STATE_ACTIVATING + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING] = DEFAULT_STATE_DEACTIVATING + 1,
+  [lifecycle_msgs__msg__State__TRANSITION_STATE_ERRORPROCESSING] =
+    DEFAULT_STATE_ERRORPROCESSING + 1,
+};
+
+static unsigned int _default_transition_index[] = {
+  [lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE] = 1,
+  [lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN] = 2,
+  [lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP] = 3,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE] = 4,
+  [lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN] = 5,
+  [lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE] = 6,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN] = 7,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_SUCCESS] = 8,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE] = 9,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR] = 10,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS] = 11,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE] = 12,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR] = 13,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS] = 14,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE] = 15,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR] = 16,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS] = 17,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE] = 18,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR] = 19,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS] = 20,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE] = 21,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR] = 22,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS] = 23,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE] = 24,
+  [lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR] = 25,
+};
 
-  // register transition from configuring to unconfigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_FAILURE,
-      configuring_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from configuring to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_configure_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CONFIGURE_ERROR,
-      configuring_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_configure_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to cleaningup
-  {
-    rcl_lifecycle_transition_t rcl_transition_cleanup = {
-      rcl_lifecycle_cleanup_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_CLEANUP,
-      inactive_state, cleaningup_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_cleanup,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from cleaningup to unconfigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_SUCCESS,
-      cleaningup_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from cleaningup to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_FAILURE,
-      cleaningup_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from cleaniningup to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_cleanup_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_CLEANUP_ERROR,
-      cleaningup_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_cleanup_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to activating
-  {
-    rcl_lifecycle_transition_t rcl_transition_activate = {
-      rcl_lifecycle_activate_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ACTIVATE,
-      inactive_state, activating_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_activate,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to active
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_SUCCESS,
-      activating_state, active_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_FAILURE,
-      activating_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from activating to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_activate_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ACTIVATE_ERROR,
-      activating_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_activate_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from active to deactivating
-  {
-    rcl_lifecycle_transition_t rcl_transition_deactivate = {
-      rcl_lifecycle_deactivate_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_DEACTIVATE,
-      active_state, deactivating_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_deactivate,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to inactive
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_SUCCESS,
-      deactivating_state, inactive_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to active
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_FAILURE,
-      deactivating_state, active_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from deactivating to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_deactivate_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_DEACTIVATE_ERROR,
-      deactivating_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_deactivate_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from unconfigured to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_unconfigured_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_UNCONFIGURED_SHUTDOWN,
-      unconfigured_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_unconfigured_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from inactive to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_inactive_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_INACTIVE_SHUTDOWN,
-      inactive_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_inactive_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from active to shuttingdown
-  {
-    rcl_lifecycle_transition_t rcl_transition_active_shutdown = {
-      rcl_lifecycle_shutdown_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ACTIVE_SHUTDOWN,
-      active_state, shuttingdown_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_active_shutdown,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_SUCCESS,
-      shuttingdown_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_FAILURE,
-      shuttingdown_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from shutting down to errorprocessing
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_shutdown_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_SHUTDOWN_ERROR,
-      shuttingdown_state, errorprocessing_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_shutdown_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to uncofigured
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_success = {
-      rcl_lifecycle_transition_success_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_SUCCESS,
-      errorprocessing_state, unconfigured_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_success,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_failure = {
-      rcl_lifecycle_transition_failure_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_FAILURE,
-      errorprocessing_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_failure,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  // register transition from errorprocessing to finalized
-  {
-    rcl_lifecycle_transition_t rcl_transition_on_error_error = {
-      rcl_lifecycle_transition_error_label,
-      lifecycle_msgs__msg__Transition__TRANSITION_ON_ERROR_ERROR,
-      errorprocessing_state, finalized_state
-    };
-    ret = rcl_lifecycle_register_transition(
-      transition_map,
-      rcl_transition_on_error_error,
-      allocator);
-    if (ret != RCL_RET_OK) {
-      return ret;
-    }
-  }
-
-  return ret;
-}
-
-// default implementation as despicted on
-// design.ros2.org
 rcl_ret_t
 rcl_lifecycle_init_default_state_machine(
   rcl_lifecycle_state_machine_t * state_machine, const rcutils_allocator_t * allocator)
 {
-  rcl_ret_t ret = RCL_RET_ERROR;
-
-  // ***************************
-  // register all primary states
-  // ***************************
-  ret = _register_primary_states(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
-  }
-
-  // ******************************
-  // register all transition states
-  // ******************************
-  ret = _register_transition_states(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
-  }
-
-  // ************************
-  // register all transitions
-  // ************************
-  ret = _register_transitions(&state_machine->transition_map, allocator);
-  if (ret != RCL_RET_OK) {
-    goto fail;
-  }
+  RCL_CHECK_ARGUMENT_FOR_NULL(state_machine, RCL_RET_INVALID_ARGUMENT);
+  // nothing is allocated, the shared machine only has to be referenced
+  (void)allocator;
+
+  state_machine->transition_map.states = _default_states;
+  state_machine->transition_map.states_size = DEFAULT_STATE_COUNT;
+  state_machine->transition_map.transitions = _default_transitions;
+  state_machine->transition_map.transitions_size = DEFAULT_TRANSITION_COUNT;
+  state_machine->transition_map.state_index = _default_state_index;
+  state_machine->transition_map.state_index_size =
+    sizeof(_default_state_index) / sizeof(_default_state_index[0]);
+  state_machine->transition_map.transition_index = _default_transition_index;
+  state_machine->transition_map.transition_index_size =
+    sizeof(_default_transition_index) / sizeof(_default_transition_index[0]);
+  state_machine->transition_map.is_static = true;
 
   // *************************************
   // set the initial state to unconfigured
   // *************************************
-  state_machine->current_state = rcl_lifecycle_get_state(
-    &state_machine->transition_map, lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED);
-
-  return ret;
+  rcutils_atomic_store(
+    (atomic_uintptr_t *)(&state_machine->current_state_storage),
+    (uintptr_t)&_default_states[DEFAULT_STATE_UNCONFIGURED]);
 
-fail:
-  if (rcl_lifecycle_transition_map_fini(&state_machine->transition_map, allocator) != RCL_RET_OK) {
-    RCL_SET_ERROR_MSG("could not free lifecycle transition map. Leaking memory!\n");
-  }
-  return RCL_RET_ERROR;
+  return RCL_RET_OK;
 }
 
 #ifdef __cplusplus
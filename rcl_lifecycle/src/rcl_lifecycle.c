@@ -23,12 +23,18 @@ extern "C"
 #include <stdlib.h>
 #include <string.h>
 
+#include "lifecycle_msgs/msg/transition_description.h"
+#include "lifecycle_msgs/srv/get_available_transitions.h"
+
 #include "rcl/rcl.h"
 #include "rcl/error_handling.h"
 
 #include "rcutils/logging_macros.h"
+#include "rcutils/stdatomic_helper.h"
 #include "rcutils/strdup.h"
 
+#include "rosidl_generator_c/string_functions.h"
+
 #include "rcl_lifecycle/default_state_machine.h"
 #include "rcl_lifecycle/transition_map.h"
 
@@ -168,19 +174,70 @@ rcl_lifecycle_transition_fini(
   return ret;
 }
 
+// The current state is stored in pre-allocated storage inside the state
+// machine and accessed through an atomic so that state queries never
+// contend with transitions.
+#define CURRENT_STATE_ATOMIC(state_machine) \
+  ((atomic_uintptr_t *)(&(state_machine)->current_state_storage))
+
+static void
+_set_current_state(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_lifecycle_state_t * state)
+{
+  rcutils_atomic_store(CURRENT_STATE_ATOMIC(state_machine), (uintptr_t)state);
+}
+
+const rcl_lifecycle_state_t *
+rcl_lifecycle_get_current_state(const rcl_lifecycle_state_machine_t * state_machine)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(state_machine, "state machine pointer is null", return NULL);
+
+  uintptr_t current_state;
+  rcutils_atomic_load(CURRENT_STATE_ATOMIC(state_machine), current_state);
+  return (const rcl_lifecycle_state_t *)current_state;
+}
+
 // get zero initialized state machine here
 rcl_lifecycle_state_machine_t
 rcl_lifecycle_get_zero_initialized_state_machine()
 {
   rcl_lifecycle_state_machine_t state_machine;
-  state_machine.current_state = NULL;
+  // ensure assumption about static storage
+  static_assert(
+    sizeof(state_machine.current_state_storage) >= sizeof(atomic_uintptr_t),
+    "expected rcl_lifecycle_state_machine_t's current state storage to be "
+    ">= size of atomic_uintptr_t");
+  // initialize atomic
+  atomic_init(CURRENT_STATE_ATOMIC(&state_machine), (uintptr_t)NULL);
   state_machine.transition_map = rcl_lifecycle_get_zero_initialized_transition_map();
   state_machine.com_interface = rcl_lifecycle_get_zero_initialized_com_interface();
+  state_machine.available_transitions_cache = NULL;
+  state_machine.available_transitions_cache_size = 0;
   return state_machine;
 }
 
+static void
+_available_transitions_cache_fini(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  if (!state_machine->available_transitions_cache) {
+    return;
+  }
+  for (unsigned int i = 0; i < state_machine->available_transitions_cache_size; ++i) {
+    if (state_machine->available_transitions_cache[i].built_size != 0) {
+      lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(
+        &state_machine->available_transitions_cache[i].response);
+    }
+  }
+  allocator->deallocate(state_machine->available_transitions_cache, allocator->state);
+  state_machine->available_transitions_cache = NULL;
+  state_machine->available_transitions_cache_size = 0;
+}
+
 rcl_ret_t
-rcl_lifecycle_state_machine_init(
+rcl_lifecycle_state_machine_init_with_options(
   rcl_lifecycle_state_machine_t * state_machine,
   rcl_node_t * node_handle,
   const rosidl_message_type_support_t * ts_pub_notify,
@@ -189,6 +246,7 @@ rcl_lifecycle_state_machine_init(
   const rosidl_service_type_support_t * ts_srv_get_available_states,
   const rosidl_service_type_support_t * ts_srv_get_available_transitions,
   const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  const rcl_lifecycle_com_interface_options_t * com_interface_options,
   bool default_states,
   const rcl_allocator_t * allocator)
 {
@@ -201,7 +259,8 @@ rcl_lifecycle_state_machine_init(
     &state_machine->com_interface, node_handle,
     ts_pub_notify,
     ts_srv_change_state, ts_srv_get_state,
-    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph);
+    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph,
+    com_interface_options);
   if (ret != RCL_RET_OK) {
     return RCL_RET_ERROR;
   }
@@ -222,6 +281,41 @@ rcl_lifecycle_state_machine_init(
   return RCL_RET_OK;
 }
 
+rcl_ret_t
+rcl_lifecycle_state_machine_init(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rosidl_message_type_support_t * ts_pub_notify,
+  const rosidl_service_type_support_t * ts_srv_change_state,
+  const rosidl_service_type_support_t * ts_srv_get_state,
+  const rosidl_service_type_support_t * ts_srv_get_available_states,
+  const rosidl_service_type_support_t * ts_srv_get_available_transitions,
+  const rosidl_service_type_support_t * ts_srv_get_transition_graph,
+  bool default_states,
+  const rcl_allocator_t * allocator)
+{
+  // every com interface is enabled to keep the historic behavior
+  rcl_lifecycle_com_interface_options_t com_interface_options =
+    rcl_lifecycle_com_interface_get_default_options();
+  return rcl_lifecycle_state_machine_init_with_options(
+    state_machine, node_handle,
+    ts_pub_notify,
+    ts_srv_change_state, ts_srv_get_state,
+    ts_srv_get_available_states, ts_srv_get_available_transitions, ts_srv_get_transition_graph,
+    &com_interface_options, default_states, allocator);
+}
+
+rcl_ret_t
+rcl_lifecycle_state_machine_enable_com_interface(
+  rcl_lifecycle_state_machine_t * state_machine,
+  rcl_node_t * node_handle,
+  const rcl_lifecycle_com_interface_options_t * com_interface_options)
+{
+  RCL_CHECK_ARGUMENT_FOR_NULL(state_machine, RCL_RET_INVALID_ARGUMENT);
+  return rcl_lifecycle_com_interface_enable(
+    &state_machine->com_interface, node_handle, com_interface_options);
+}
+
 rcl_ret_t
 rcl_lifecycle_state_machine_fini(
   rcl_lifecycle_state_machine_t * state_machine,
@@ -235,6 +329,8 @@ rcl_lifecycle_state_machine_fini(
 
   rcl_ret_t fcn_ret = RCL_RET_OK;
 
+  _available_transitions_cache_fini(state_machine, allocator);
+
   if (rcl_lifecycle_com_interface_fini(&state_machine->com_interface, node_handle) != RCL_RET_OK) {
     RCL_SET_ERROR_MSG("could not free lifecycle com interface. Leaking memory!\n");
     fcn_ret = RCL_RET_ERROR;
@@ -253,11 +349,16 @@ rcl_lifecycle_state_machine_fini(
 rcl_ret_t
 rcl_lifecycle_state_machine_is_initialized(const rcl_lifecycle_state_machine_t * state_machine)
 {
-  if (!state_machine->com_interface.srv_get_state.impl) {
+  // only interfaces that were enabled are expected to exist
+  if (state_machine->com_interface.enabled.enable_get_state_service &&
+    !state_machine->com_interface.srv_get_state.impl)
+  {
     RCL_SET_ERROR_MSG("get_state service is null");
     return RCL_RET_ERROR;
   }
-  if (!state_machine->com_interface.srv_change_state.impl) {
+  if (state_machine->com_interface.enabled.enable_change_state_service &&
+    !state_machine->com_interface.srv_change_state.impl)
+  {
     RCL_SET_ERROR_MSG("change_state service is null");
     return RCL_RET_ERROR;
   }
@@ -297,7 +398,11 @@ rcl_lifecycle_get_transition_by_label(
   RCL_CHECK_FOR_NULL_WITH_MSG(state, "state pointer is null", return NULL);
 
   for (unsigned int i = 0; i < state->valid_transition_size; ++i) {
-    if (strcmp(state->valid_transitions[i].label, label) == 0) {
+    // labels usually reference the shared label constants, so compare the
+    // pointers before falling back to a string comparison
+    if (state->valid_transitions[i].label == label ||
+      strcmp(state->valid_transitions[i].label, label) == 0)
+    {
       return &state->valid_transitions[i];
     }
   }
@@ -310,6 +415,85 @@ rcl_lifecycle_get_transition_by_label(
   return NULL;
 }
 
+static bool
+_available_transitions_build_response(
+  lifecycle_msgs__srv__GetAvailableTransitions_Response * response,
+  const rcl_lifecycle_state_t * state)
+{
+  if (!lifecycle_msgs__srv__GetAvailableTransitions_Response__init(response)) {
+    return false;
+  }
+  if (!lifecycle_msgs__msg__TransitionDescription__Sequence__init(
+      &response->available_transitions, state->valid_transition_size))
+  {
+    lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(response);
+    return false;
+  }
+  for (unsigned int i = 0; i < state->valid_transition_size; ++i) {
+    const rcl_lifecycle_transition_t * transition = &state->valid_transitions[i];
+    lifecycle_msgs__msg__TransitionDescription * description =
+      &response->available_transitions.data[i];
+    description->transition.id = (uint8_t)transition->id;
+    description->start_state.id = (uint8_t)transition->start->id;
+    description->goal_state.id = (uint8_t)transition->goal->id;
+    if (!rosidl_generator_c__String__assign(
+        &description->transition.label, transition->label) ||
+      !rosidl_generator_c__String__assign(
+        &description->start_state.label, transition->start->label) ||
+      !rosidl_generator_c__String__assign(
+        &description->goal_state.label, transition->goal->label))
+    {
+      lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(response);
+      return false;
+    }
+  }
+  return true;
+}
+
+const lifecycle_msgs__srv__GetAvailableTransitions_Response *
+rcl_lifecycle_get_available_transitions(
+  rcl_lifecycle_state_machine_t * state_machine,
+  const rcl_allocator_t * allocator)
+{
+  RCL_CHECK_FOR_NULL_WITH_MSG(state_machine, "state machine pointer is null", return NULL);
+  RCL_CHECK_ALLOCATOR_WITH_MSG(allocator, "invalid allocator", return NULL);
+
+  const rcl_lifecycle_state_t * current_state = rcl_lifecycle_get_current_state(state_machine);
+  RCL_CHECK_FOR_NULL_WITH_MSG(current_state, "no current state set", return NULL);
+
+  const rcl_lifecycle_transition_map_t * map = &state_machine->transition_map;
+  // one cache entry per state slot; resize when states were registered
+  // since the cache was created
+  if (state_machine->available_transitions_cache_size != map->states_size) {
+    _available_transitions_cache_fini(state_machine, allocator);
+    state_machine->available_transitions_cache = allocator->zero_allocate(
+      map->states_size, sizeof(rcl_lifecycle_available_transitions_cache_entry_t),
+      allocator->state);
+    RCL_CHECK_FOR_NULL_WITH_MSG(
+      state_machine->available_transitions_cache,
+      "failed to allocate available transitions cache", return NULL);
+    state_machine->available_transitions_cache_size = map->states_size;
+  }
+
+  unsigned int slot = (unsigned int)(current_state - map->states);
+  rcl_lifecycle_available_transitions_cache_entry_t * entry =
+    &state_machine->available_transitions_cache[slot];
+  // rebuild when transitions were registered since the entry was built
+  if (entry->built_size != current_state->valid_transition_size + 1) {
+    if (entry->built_size != 0) {
+      lifecycle_msgs__srv__GetAvailableTransitions_Response__fini(&entry->response);
+      entry->built_size = 0;
+    }
+    if (!_available_transitions_build_response(&entry->response, current_state)) {
+      RCL_SET_ERROR_MSG("failed to materialize available transitions response");
+      return NULL;
+    }
+    entry->built_size = current_state->valid_transition_size + 1;
+  }
+
+  return &entry->response;
+}
+
 rcl_ret_t
 _trigger_transition(
   rcl_lifecycle_state_machine_t * state_machine,
@@ -327,11 +511,12 @@ _trigger_transition(
       ROS_PACKAGE_NAME, "No valid goal is set");
     return RCL_RET_ERROR;
   }
-  state_machine->current_state = transition->goal;
+  // publish the new state atomically so concurrent readers see it without locking
+  _set_current_state(state_machine, transition->goal);
 
   if (publish_notification) {
     rcl_ret_t ret = rcl_lifecycle_com_interface_publish_notification(
-      &state_machine->com_interface, transition->start, state_machine->current_state);
+      &state_machine->com_interface, transition->start, transition->goal);
     if (ret != RCL_RET_OK) {
       RCL_SET_ERROR_MSG("Could not publish transition");
       return RCL_RET_ERROR;
@@ -353,7 +538,7 @@ rcl_lifecycle_trigger_transition_by_id(
   }
 
   const rcl_lifecycle_transition_t * transition =
-    rcl_lifecycle_get_transition_by_id(state_machine->current_state, id);
+    rcl_lifecycle_get_transition_by_id(rcl_lifecycle_get_current_state(state_machine), id);
 
   return _trigger_transition(state_machine, transition, publish_notification);
 }
@@ -370,7 +555,7 @@ rcl_lifecycle_trigger_transition_by_label(
   }
 
   const rcl_lifecycle_transition_t * transition =
-    rcl_lifecycle_get_transition_by_label(state_machine->current_state, label);
+    rcl_lifecycle_get_transition_by_label(rcl_lifecycle_get_current_state(state_machine), label);
 
   return _trigger_transition(state_machine, transition, publish_notification);
 }
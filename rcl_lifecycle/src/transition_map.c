@@ -34,6 +34,11 @@ rcl_lifecycle_get_zero_initialized_transition_map()
   transition_map.states_size = 0;
   transition_map.transitions = NULL;
   transition_map.transitions_size = 0;
+  transition_map.state_index = NULL;
+  transition_map.state_index_size = 0;
+  transition_map.transition_index = NULL;
+  transition_map.transition_index_size = 0;
+  transition_map.is_static = false;
 
   return transition_map;
 }
@@ -55,22 +60,74 @@ rcl_lifecycle_transition_map_fini(
 {
   rcl_ret_t fcn_ret = RCL_RET_OK;
 
+  // a static map only references shared storage, so there is nothing to free
+  if (transition_map->is_static) {
+    transition_map->states = NULL;
+    transition_map->states_size = 0;
+    transition_map->transitions = NULL;
+    transition_map->transitions_size = 0;
+    transition_map->state_index = NULL;
+    transition_map->state_index_size = 0;
+    transition_map->transition_index = NULL;
+    transition_map->transition_index_size = 0;
+    transition_map->is_static = false;
+    return fcn_ret;
+  }
+
   // free the primary states
   allocator->deallocate(transition_map->states, allocator->state);
   transition_map->states = NULL;
   // free the tansitions
   allocator->deallocate(transition_map->transitions, allocator->state);
   transition_map->transitions = NULL;
+  // free the lookup indexes
+  allocator->deallocate(transition_map->state_index, allocator->state);
+  transition_map->state_index = NULL;
+  transition_map->state_index_size = 0;
+  allocator->deallocate(transition_map->transition_index, allocator->state);
+  transition_map->transition_index = NULL;
+  transition_map->transition_index_size = 0;
 
   return fcn_ret;
 }
 
+// record id -> slot in a direct lookup index, growing it to cover the id
+static rcl_ret_t
+_transition_map_index_insert(
+  unsigned int ** index,
+  unsigned int * index_size,
+  unsigned int id,
+  unsigned int slot,
+  const rcutils_allocator_t * allocator)
+{
+  if (id >= *index_size) {
+    unsigned int new_size = id + 1;
+    unsigned int * new_index = allocator->reallocate(
+      *index, new_size * sizeof(unsigned int), allocator->state);
+    if (!new_index) {
+      RCL_SET_ERROR_MSG("failed to reallocate memory for lookup index");
+      return RCL_RET_ERROR;
+    }
+    memset(&new_index[*index_size], 0, (new_size - *index_size) * sizeof(unsigned int));
+    *index = new_index;
+    *index_size = new_size;
+  }
+  // slots are stored off by one so zero can mark an unset id
+  (*index)[id] = slot + 1;
+  return RCL_RET_OK;
+}
+
 rcl_ret_t
 rcl_lifecycle_register_state(
   rcl_lifecycle_transition_map_t * transition_map,
   rcl_lifecycle_state_t state,
   const rcutils_allocator_t * allocator)
 {
+  if (transition_map->is_static) {
+    RCL_SET_ERROR_MSG("cannot register a state on a statically initialized transition map\n");
+    return RCL_RET_ERROR;
+  }
+
   if (rcl_lifecycle_get_state(transition_map, state.id) != NULL) {
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("state %u is already registered\n", state.id);
     return RCL_RET_ERROR;
@@ -92,7 +149,9 @@ rcl_lifecycle_register_state(
   transition_map->states = new_states;
   transition_map->states[transition_map->states_size - 1] = state;
 
-  return RCL_RET_OK;
+  return _transition_map_index_insert(
+    &transition_map->state_index, &transition_map->state_index_size,
+    state.id, transition_map->states_size - 1, allocator);
 }
 
 rcl_ret_t
@@ -104,6 +163,11 @@ rcl_lifecycle_register_transition(
   RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
     allocator, "invalid allocator", return RCL_RET_ERROR)
 
+  if (transition_map->is_static) {
+    RCL_SET_ERROR_MSG("cannot register a transition on a statically initialized transition map\n");
+    return RCL_RET_ERROR;
+  }
+
   rcl_lifecycle_state_t * state = rcl_lifecycle_get_state(transition_map, transition.start->id);
   if (!state) {
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("state %u is not registered\n", transition.start->id);
@@ -124,6 +188,19 @@ rcl_lifecycle_register_transition(
   // finally set the new transition to the end of the array
   transition_map->transitions[transition_map->transitions_size - 1] = transition;
 
+  // only the first transition registered for an id is indexed, matching the
+  // linear scan which returned the first match
+  if (transition.id >= transition_map->transition_index_size ||
+    transition_map->transition_index[transition.id] == 0)
+  {
+    rcl_ret_t index_ret = _transition_map_index_insert(
+      &transition_map->transition_index, &transition_map->transition_index_size,
+      transition.id, transition_map->transitions_size - 1, allocator);
+    if (index_ret != RCL_RET_OK) {
+      return index_ret;  // error already set
+    }
+  }
+
   // we have to copy the transitons here once more to the actual state
   // as we can't assign only the pointer. This pointer gets invalidated whenever
   // we add a new transition and re-shuffle/re-allocate new memory for it.
@@ -148,6 +225,16 @@ rcl_lifecycle_get_state(
   rcl_lifecycle_transition_map_t * transition_map,
   unsigned int state_id)
 {
+  // resolve the id with one index lookup when the index is available
+  if (transition_map->state_index) {
+    if (state_id >= transition_map->state_index_size ||
+      transition_map->state_index[state_id] == 0)
+    {
+      return NULL;
+    }
+    return &transition_map->states[transition_map->state_index[state_id] - 1];
+  }
+
   for (unsigned int i = 0; i < transition_map->states_size; ++i) {
     if (transition_map->states[i].id == state_id) {
       return &transition_map->states[i];
@@ -161,6 +248,16 @@ rcl_lifecycle_get_transitions(
   rcl_lifecycle_transition_map_t * transition_map,
   unsigned int transition_id)
 {
+  // resolve the id with one index lookup when the index is available
+  if (transition_map->transition_index) {
+    if (transition_id >= transition_map->transition_index_size ||
+      transition_map->transition_index[transition_id] == 0)
+    {
+      return NULL;
+    }
+    return &transition_map->transitions[transition_map->transition_index[transition_id] - 1];
+  }
+
   for (unsigned int i = 0; i < transition_map->transitions_size; ++i) {
     if (transition_map->transitions[i].id == transition_id) {
       return &transition_map->transitions[i];
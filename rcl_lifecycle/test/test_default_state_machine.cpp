@@ -31,6 +31,7 @@
 
 #include "rcl_lifecycle/rcl_lifecycle.h"
 #include "rcl_lifecycle/default_state_machine.h"
+#include "rcl_lifecycle/transition_map.h"
 
 class TestDefaultStateMachine : public ::testing::Test
 {
@@ -84,12 +85,12 @@ test_trigger_transition(
   unsigned int expected_goal_state)
 {
   EXPECT_EQ(
-    expected_current_state, state_machine->current_state->id);
+    expected_current_state, rcl_lifecycle_get_current_state(state_machine)->id);
   EXPECT_EQ(
     RCL_RET_OK, rcl_lifecycle_trigger_transition_by_id(
       state_machine, key_id, false));
   EXPECT_EQ(
-    expected_goal_state, state_machine->current_state->id);
+    expected_goal_state, rcl_lifecycle_get_current_state(state_machine)->id);
 }
 
 /*
@@ -119,6 +120,70 @@ TEST_F(TestDefaultStateMachine, default_init) {
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 }
 
+TEST_F(TestDefaultStateMachine, default_init_shared_static) {
+  rcl_lifecycle_state_machine_t state_machine_a =
+    rcl_lifecycle_get_zero_initialized_state_machine();
+  rcl_lifecycle_state_machine_t state_machine_b =
+    rcl_lifecycle_get_zero_initialized_state_machine();
+
+  auto ret = rcl_lifecycle_init_default_state_machine(&state_machine_a, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  ret = rcl_lifecycle_init_default_state_machine(&state_machine_b, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // every default machine references the same static states and transitions
+  EXPECT_TRUE(state_machine_a.transition_map.is_static);
+  EXPECT_EQ(state_machine_a.transition_map.states, state_machine_b.transition_map.states);
+  EXPECT_EQ(state_machine_a.transition_map.transitions, state_machine_b.transition_map.transitions);
+
+  // the shared machine must refuse dynamic registration
+  rcl_lifecycle_state_t extra_state = {"extra", 100, NULL, 0};
+  ret = rcl_lifecycle_register_state(
+    &state_machine_a.transition_map, extra_state, this->allocator);
+  EXPECT_EQ(RCL_RET_ERROR, ret);
+  rcl_reset_error();
+
+  // finalizing one machine must not affect the other
+  ret = rcl_lifecycle_state_machine_fini(&state_machine_a, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+  EXPECT_EQ(
+    RCL_RET_OK, rcl_lifecycle_transition_map_is_initialized(&state_machine_b.transition_map));
+  ret = rcl_lifecycle_state_machine_fini(&state_machine_b, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
+TEST_F(TestDefaultStateMachine, available_transitions_cached) {
+  rcl_lifecycle_state_machine_t state_machine = rcl_lifecycle_get_zero_initialized_state_machine();
+  auto ret = rcl_lifecycle_init_default_state_machine(&state_machine, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+
+  // unconfigured offers configure and shutdown
+  const lifecycle_msgs__srv__GetAvailableTransitions_Response * response =
+    rcl_lifecycle_get_available_transitions(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, response) << rcl_get_error_string().str;
+  ASSERT_EQ(2u, response->available_transitions.size);
+  EXPECT_STREQ("configure", response->available_transitions.data[0].transition.label.data);
+  EXPECT_STREQ("shutdown", response->available_transitions.data[1].transition.label.data);
+
+  // a repeated query returns the cached message
+  const lifecycle_msgs__srv__GetAvailableTransitions_Response * response_again =
+    rcl_lifecycle_get_available_transitions(&state_machine, this->allocator);
+  EXPECT_EQ(response, response_again);
+
+  // after a transition the answer follows the new current state
+  EXPECT_EQ(
+    RCL_RET_OK, rcl_lifecycle_trigger_transition_by_id(
+      &state_machine, lifecycle_msgs__msg__Transition__TRANSITION_CONFIGURE, false));
+  response = rcl_lifecycle_get_available_transitions(&state_machine, this->allocator);
+  ASSERT_NE(nullptr, response) << rcl_get_error_string().str;
+  ASSERT_EQ(3u, response->available_transitions.size);
+  EXPECT_STREQ(
+    "transition_success", response->available_transitions.data[0].transition.label.data);
+
+  ret = rcl_lifecycle_state_machine_fini(&state_machine, this->node_ptr, this->allocator);
+  EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
+}
+
 TEST_F(TestDefaultStateMachine, default_sequence) {
   rcl_ret_t ret;
 
@@ -234,7 +299,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
       EXPECT_EQ(
-        state_machine.current_state->id,
+        rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED);
     }
   }
@@ -253,7 +318,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING);
     }
   }
@@ -273,7 +338,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
       RCUTILS_LOG_INFO_NAMED(ROS_PACKAGE_NAME, "applying key %u", *it);
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__PRIMARY_STATE_INACTIVE);
     }
   }
@@ -292,7 +357,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__TRANSITION_STATE_ACTIVATING);
     }
   }
@@ -311,7 +376,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__PRIMARY_STATE_ACTIVE);
     }
   }
@@ -330,7 +395,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__TRANSITION_STATE_DEACTIVATING);
     }
   }
@@ -355,7 +420,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__TRANSITION_STATE_CLEANINGUP);
     }
   }
@@ -380,7 +445,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
 
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__TRANSITION_STATE_SHUTTINGDOWN);
     }
   }
@@ -395,7 +460,7 @@ TEST_F(TestDefaultStateMachine, wrong_default_sequence) {
     for (auto it = transition_ids.begin(); it != transition_ids.end(); ++it) {
       EXPECT_EQ(RCL_RET_ERROR, rcl_lifecycle_trigger_transition_by_id(&state_machine, *it, false));
       rcl_reset_error();
-      EXPECT_EQ(state_machine.current_state->id,
+      EXPECT_EQ(rcl_lifecycle_get_current_state(&state_machine)->id,
         lifecycle_msgs__msg__State__PRIMARY_STATE_FINALIZED);
     }
   }
@@ -82,12 +82,12 @@ test_trigger_transition(
   unsigned int expected_goal_state)
 {
   EXPECT_EQ(
-    expected_current_state, state_machine->current_state->id);
+    expected_current_state, rcl_lifecycle_get_current_state(state_machine)->id);
   EXPECT_EQ(
     RCL_RET_OK, rcl_lifecycle_trigger_transition_by_id(
       state_machine, key_id, false));
   EXPECT_EQ(
-    expected_goal_state, state_machine->current_state->id);
+    expected_goal_state, rcl_lifecycle_get_current_state(state_machine)->id);
 }
 
 TEST_F(TestMultipleInstances, default_sequence_error_unresolved) {
@@ -116,11 +116,14 @@ TEST_F(TestMultipleInstances, default_sequence_error_unresolved) {
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
 
   EXPECT_EQ(
-    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING, state_machine1.current_state->id);
+    lifecycle_msgs__msg__State__TRANSITION_STATE_CONFIGURING,
+    rcl_lifecycle_get_current_state(&state_machine1)->id);
   EXPECT_EQ(
-    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED, state_machine2.current_state->id);
+    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    rcl_lifecycle_get_current_state(&state_machine2)->id);
   EXPECT_EQ(
-    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED, state_machine3.current_state->id);
+    lifecycle_msgs__msg__State__PRIMARY_STATE_UNCONFIGURED,
+    rcl_lifecycle_get_current_state(&state_machine3)->id);
 
   ret = rcl_lifecycle_state_machine_fini(&state_machine1, this->node_ptr, this->allocator);
   EXPECT_EQ(RCL_RET_OK, ret) << rcl_get_error_string().str;
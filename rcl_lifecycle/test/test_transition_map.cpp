@@ -93,3 +93,42 @@ TEST_F(TestTransitionMap, initialized) {
 
   EXPECT_EQ(RCL_RET_OK, rcl_lifecycle_transition_map_fini(&transition_map, &allocator));
 }
+
+TEST_F(TestTransitionMap, indexed_lookup) {
+  rcl_lifecycle_transition_map_t transition_map =
+    rcl_lifecycle_get_zero_initialized_transition_map();
+
+  rcl_allocator_t allocator = rcl_get_default_allocator();
+
+  // register states with sparse, out of order ids
+  rcl_lifecycle_state_t state7 = {"my_state_7", 7, NULL, 0};
+  EXPECT_EQ(RCL_RET_OK, rcl_lifecycle_register_state(&transition_map, state7, &allocator));
+  rcl_lifecycle_state_t state3 = {"my_state_3", 3, NULL, 0};
+  EXPECT_EQ(RCL_RET_OK, rcl_lifecycle_register_state(&transition_map, state3, &allocator));
+
+  rcl_lifecycle_state_t * lookup_state = rcl_lifecycle_get_state(&transition_map, 7);
+  ASSERT_NE(nullptr, lookup_state);
+  EXPECT_STREQ("my_state_7", lookup_state->label);
+  lookup_state = rcl_lifecycle_get_state(&transition_map, 3);
+  ASSERT_NE(nullptr, lookup_state);
+  EXPECT_STREQ("my_state_3", lookup_state->label);
+
+  // ids inside and beyond the index have no state registered
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_state(&transition_map, 5));
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_state(&transition_map, 100));
+
+  rcl_lifecycle_transition_t transition73 = {"from7to3", 42,
+    rcl_lifecycle_get_state(&transition_map, 7),
+    rcl_lifecycle_get_state(&transition_map, 3)};
+  EXPECT_EQ(
+    RCL_RET_OK, rcl_lifecycle_register_transition(&transition_map, transition73, &allocator));
+
+  rcl_lifecycle_transition_t * lookup_transition =
+    rcl_lifecycle_get_transitions(&transition_map, 42);
+  ASSERT_NE(nullptr, lookup_transition);
+  EXPECT_STREQ("from7to3", lookup_transition->label);
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_transitions(&transition_map, 41));
+  EXPECT_EQ(nullptr, rcl_lifecycle_get_transitions(&transition_map, 100));
+
+  EXPECT_EQ(RCL_RET_OK, rcl_lifecycle_transition_map_fini(&transition_map, &allocator));
+}
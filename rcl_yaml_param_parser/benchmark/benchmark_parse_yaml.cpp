@@ -0,0 +1,118 @@
+// Copyright 2019 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include "rcl_yaml_param_parser/parser.h"
+#include "rcutils/allocator.h"
+
+namespace
+{
+
+/// Write a parameter file with `num_nodes` nodes of `params_per_node`
+/// parameters each and return its path.
+std::string write_config_file(size_t num_nodes, size_t params_per_node)
+{
+  std::string path = "benchmark_parse_yaml_" + std::to_string(num_nodes) +
+    "x" + std::to_string(params_per_node) + ".yaml";
+  std::ofstream file(path);
+  if (!file) {
+    fprintf(stderr, "failed to open '%s' for writing\n", path.c_str());
+    exit(1);
+  }
+  for (size_t n = 0; n < num_nodes; ++n) {
+    file << "node" << n << ":\n";
+    file << "  ros__parameters:\n";
+    for (size_t p = 0; p < params_per_node; ++p) {
+      file << "    param" << p << ": " << (n * params_per_node + p) << "\n";
+    }
+  }
+  return path;
+}
+
+}  // namespace
+
+/// Measure parsing a file of range(0) nodes x range(1) parameters each.
+static void BM_parse_yaml_file(benchmark::State & state)
+{
+  const size_t num_nodes = static_cast<size_t>(state.range(0));
+  const size_t params_per_node = static_cast<size_t>(state.range(1));
+  const std::string path = write_config_file(num_nodes, params_per_node);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    (void)_;
+    rcl_params_t * params = rcl_yaml_node_struct_init(allocator);
+    if (nullptr == params) {
+      state.SkipWithError("failed to initialize parameter struct");
+      break;
+    }
+    if (!rcl_parse_yaml_file(path.c_str(), params)) {
+      rcl_yaml_node_struct_fini(params);
+      state.SkipWithError("failed to parse generated parameter file");
+      break;
+    }
+    rcl_yaml_node_struct_fini(params);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<int64_t>(num_nodes * params_per_node));
+
+  remove(path.c_str());
+}
+BENCHMARK(BM_parse_yaml_file)
+->Args({1, 10})
+->Args({1, 100})
+->Args({10, 100})
+->Args({100, 100});
+
+/// Same file sizes, but preallocating the struct with capacity hints.
+static void BM_parse_yaml_file_with_capacity(benchmark::State & state)
+{
+  const size_t num_nodes = static_cast<size_t>(state.range(0));
+  const size_t params_per_node = static_cast<size_t>(state.range(1));
+  const std::string path = write_config_file(num_nodes, params_per_node);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+
+  for (auto _ : state) {
+    (void)_;
+    rcl_params_t * params = rcl_yaml_node_struct_init_with_capacity(
+      num_nodes, params_per_node, allocator);
+    if (nullptr == params) {
+      state.SkipWithError("failed to initialize parameter struct");
+      break;
+    }
+    if (!rcl_parse_yaml_file(path.c_str(), params)) {
+      rcl_yaml_node_struct_fini(params);
+      state.SkipWithError("failed to parse generated parameter file");
+      break;
+    }
+    rcl_yaml_node_struct_fini(params);
+  }
+  state.SetItemsProcessed(
+    state.iterations() * static_cast<int64_t>(num_nodes * params_per_node));
+
+  remove(path.c_str());
+}
+BENCHMARK(BM_parse_yaml_file_with_capacity)
+->Args({1, 10})
+->Args({1, 100})
+->Args({10, 100})
+->Args({100, 100});
+
+BENCHMARK_MAIN();
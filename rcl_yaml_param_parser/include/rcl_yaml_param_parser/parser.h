@@ -15,8 +15,10 @@
 #ifndef RCL_YAML_PARAM_PARSER__PARSER_H_
 #define RCL_YAML_PARAM_PARSER__PARSER_H_
 
+#include <stdint.h>
 #include <stdlib.h>
 
+#include "rcl/guard_condition.h"
 #include "rcl_yaml_param_parser/types.h"
 #include "rcl_yaml_param_parser/visibility_control.h"
 
@@ -32,12 +34,59 @@ RCL_YAML_PARAM_PARSER_PUBLIC
 rcl_params_t * rcl_yaml_node_struct_init(
   const rcutils_allocator_t allocator);
 
+/// \brief Init param structure with capacity hints
+/// The node and parameter arrays grow geometrically as entries are added, so
+/// the hints are not limits; callers that know their config size can use them
+/// to preallocate exactly once.
+/// \param[in] num_nodes_hint expected number of nodes
+/// \param[in] params_per_node_hint expected number of parameters per node
+/// \param[in] allocator memory allocator to be used
+/// \return a pointer to param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
+  size_t num_nodes_hint,
+  size_t params_per_node_hint,
+  const rcutils_allocator_t allocator);
+
+/// \brief Share a param structure by reference instead of copying it
+/// The parsed tree is effectively immutable once populated, so every node
+/// in a process reading the same configuration can share one tree: each
+/// additional owner takes a reference and finalizes it as usual with
+/// rcl_yaml_node_struct_fini, and the storage is released when the last
+/// owner is finalized.
+/// Like the rest of this API, taking and releasing references is not
+/// thread-safe; callers sharing a struct across threads must serialize
+/// these calls.
+/// \param[inout] params_st points to the populated paramter struct
+/// \return params_st with an additional reference, or NULL if it is NULL
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_node_struct_ref(
+  rcl_params_t * params_st);
+
 /// \brief Free param structure
+/// Decrements the reference count and releases the storage only when the
+/// last reference is finalized.
 /// \param[in] params_st points to the populated paramter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
 void rcl_yaml_node_struct_fini(
   rcl_params_t * params_st);
 
+/// \brief Look up a parameter value by node and parameter name
+/// The lookup goes through a hash index over the names, so it stays O(1)
+/// regardless of the number of nodes and parameters.
+/// The index is built on the first lookup and refreshed automatically after
+/// more entries have been parsed into the struct.
+/// \param[in] node_name is the full name of the node, as stored in the struct
+/// \param[in] param_name is the full name of the parameter
+/// \param[inout] params_st points to the populated paramter struct
+/// \return a pointer to the value stored in the struct on success, or
+/// \return NULL if the node or parameter is unknown or on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_variant_t * rcl_yaml_node_struct_get(
+  const char * node_name,
+  const char * param_name,
+  rcl_params_t * params_st);
+
 /// \brief Parse the YAML file, initialize and populate params_st
 /// \param[in] file_path is the path to the YAML file
 /// \param[inout] params_st points to the populated paramter struct
@@ -47,6 +96,209 @@ bool rcl_parse_yaml_file(
   const char * file_path,
   rcl_params_t * params_st);
 
+/// \brief Parse several YAML files and populate params_st
+/// The result is the same as calling rcl_parse_yaml_file once per path in
+/// array order, but independent files are parsed concurrently into per-file
+/// trees and merged into params_st in order, so a large configuration loads
+/// in roughly the time of its largest single file.
+/// When thread_count is 0 or 1, there is only one file, or the platform has
+/// no thread support, the files are parsed sequentially instead; thread_count
+/// is a hint and is clamped to the number of files.
+/// With more than one thread the allocator that params_st was created with
+/// must be thread-safe, which the default allocator is.
+/// \param[in] file_paths is the array of paths to the YAML files
+/// \param[in] count is the number of paths in the array
+/// \param[in] thread_count is the number of parser threads to use
+/// \param[inout] params_st points to the populated paramter struct
+/// \return true on success and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  size_t count,
+  size_t thread_count,
+  rcl_params_t * params_st);
+
+/// \brief Apply an overlay parameter tree on top of a base tree
+/// Walks only the overlay: every override is resolved through the hash index
+/// over the base's names, so layering a small override file onto a large base
+/// costs O(overlay), not O(base), and untouched base entries are left as is.
+/// Parameters present in both trees take the overlay's value; nodes and
+/// parameters only present in the overlay are appended as deep copies, so the
+/// overlay can be finalized independently afterwards.
+/// Value pointers previously returned by rcl_yaml_node_struct_get for
+/// overridden parameters are invalidated by the merge.
+/// \param[inout] base points to the populated tree receiving the overrides
+/// \param[in] overlay points to the tree holding the overrides
+/// \return RCL_RET_OK on success, or
+/// \return RCL_RET_INVALID_ARGUMENT for NULL arguments, or
+/// \return RCL_RET_BAD_ALLOC on allocation failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_ret_t rcl_yaml_params_merge(
+  rcl_params_t * base,
+  const rcl_params_t * overlay);
+
+/// \brief The set of parameters changed by one poll of a file watch
+/// The arrays are parallel: entry i names parameter parameter_names[i] of
+/// node node_names[i], whose value changed or which was newly added.
+/// The name strings are owned by the watched tree and stay valid for its
+/// lifetime; the arrays themselves are owned by the watch and are only valid
+/// until the next poll or until the watch is finalized.
+typedef struct rcl_yaml_params_delta_s
+{
+  const char ** node_names;
+  const char ** parameter_names;
+  size_t num_entries;
+} rcl_yaml_params_delta_t;
+
+/// A watch over one parameter file, created by rcl_yaml_params_watch_init
+typedef struct rcl_yaml_params_watch_s rcl_yaml_params_watch_t;
+
+/// \brief Watch a YAML file for changes to fold into a parameter tree
+/// The watch records the file's modification time and size; each call to
+/// rcl_yaml_params_watch_poll compares them and only re-parses the file when
+/// they differ, so an unchanged file costs one stat call per poll and nodes
+/// can pick up configuration edits without restarting.
+/// A changed file is parsed into a fresh tree and diffed against params_st
+/// through the hash index over its names: parameters whose value actually
+/// changed, and new nodes and parameters, are folded into params_st in place
+/// with the same overlay semantics as rcl_yaml_params_merge, and reported in
+/// the poll's delta.  Parameters removed from the file keep their last value,
+/// like an overlay that no longer mentions them.
+/// The watch takes a reference on params_st and releases it when finalized.
+/// When guard_condition is not NULL it is triggered by any poll that applied
+/// changes, so a wait set can sleep on the file instead of polling values;
+/// the guard condition is borrowed and must outlive the watch.  Like the
+/// rest of this API the watch is not thread-safe: polls must be serialized
+/// with other access to params_st, which is what makes the in-place update
+/// safe without locking.  Modification time is compared at filesystem
+/// granularity; the size is compared as well to narrow the window on
+/// filesystems with coarse timestamps.
+/// \param[in] file_path is the path to the YAML file to watch
+/// \param[inout] params_st points to the populated tree receiving changes
+/// \param[in] guard_condition is triggered when a poll applies changes,
+///   or NULL for none
+/// \return a pointer to the watch on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_yaml_params_watch_t * rcl_yaml_params_watch_init(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_guard_condition_t * guard_condition);
+
+/// \brief Check the watched file and apply its changes if it was modified
+/// When the file is unchanged this returns immediately and sets *delta to
+/// NULL.  When it was modified the changes are applied to the watched tree
+/// and *delta is set to the changed-parameter delta, which may be empty if
+/// the rewrite did not change any value; the guard condition is only
+/// triggered when the delta is non-empty.
+/// A file that is missing, for instance mid-way through an atomic replace,
+/// is treated as unchanged and picked up on a later poll.  A file that no
+/// longer parses leaves the tree untouched and returns an error, but is
+/// still recorded as seen so an unrepaired file is not re-parsed on every
+/// poll.
+/// Value pointers previously returned by rcl_yaml_node_struct_get for
+/// changed parameters are invalidated, as with rcl_yaml_params_merge.
+/// \param[inout] watch points to the watch to poll
+/// \param[out] delta is set to the delta of this poll, or NULL if the file
+///   was unchanged; may itself be NULL if the caller only wants the update
+/// \return RCL_RET_OK on success, whether or not anything changed, or
+/// \return RCL_RET_INVALID_ARGUMENT for a NULL watch, or
+/// \return RCL_RET_ERROR if the file no longer parses, or
+/// \return RCL_RET_BAD_ALLOC on allocation failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_ret_t rcl_yaml_params_watch_poll(
+  rcl_yaml_params_watch_t * watch,
+  const rcl_yaml_params_delta_t ** delta);
+
+/// \brief Finalize a file watch
+/// Releases the watch's reference on the watched tree; values already folded
+/// into the tree are unaffected.
+/// \param[in] watch points to the watch to finalize, may be NULL
+RCL_YAML_PARAM_PARSER_PUBLIC
+void rcl_yaml_params_watch_fini(
+  rcl_yaml_params_watch_t * watch);
+
+/// \brief Check a YAML file without building a parameter tree
+/// Runs the file's event stream through the same structural and type checks
+/// as rcl_parse_yaml_file — well-formed YAML, node names before
+/// ros__parameters, scalar size limits, uniformly typed sequences, no
+/// aliases — but tracks namespaces as counts and lengths only, so no memory
+/// is allocated and nothing has to be freed afterwards.
+/// Intended for deployment gates that validate many configuration files
+/// whose contents are never used.
+/// \param[in] file_path is the path to the YAML file
+/// \return true when the file would parse and false on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+bool rcl_validate_yaml_file(
+  const char * file_path);
+
+/// \brief Get a scalar parameter as a bool, converting it on first access
+/// Scalars are stored as raw text by the parser and classified lazily, so
+/// parse time does not pay for converting parameters that are never read.
+/// The conversion result is cached in the variant; later accesses are free.
+/// The conversion is made with the owning tree's own allocator, so the
+/// converted value lives in the tree's arena and is released with the tree.
+/// \param[inout] param_value points to the value stored in the struct
+/// \param[inout] params_st points to the struct the value is stored in
+/// \return a pointer to the value, or NULL if it is not of this type
+RCL_YAML_PARAM_PARSER_PUBLIC
+const bool * rcl_yaml_variant_get_bool(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st);
+
+/// \brief Get a scalar parameter as an int64_t, converting it on first access
+/// \sa rcl_yaml_variant_get_bool
+RCL_YAML_PARAM_PARSER_PUBLIC
+const int64_t * rcl_yaml_variant_get_int(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st);
+
+/// \brief Get a scalar parameter as a double, converting it on first access
+/// \sa rcl_yaml_variant_get_bool
+RCL_YAML_PARAM_PARSER_PUBLIC
+const double * rcl_yaml_variant_get_double(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st);
+
+/// \brief Get a scalar parameter as a string, converting it on first access
+/// \sa rcl_yaml_variant_get_bool
+RCL_YAML_PARAM_PARSER_PUBLIC
+const char * rcl_yaml_variant_get_string(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st);
+
+/// \brief Serialize a parameter structure into a flat binary image
+/// The image is pointer free and self delimiting, so it can be written to a
+/// file once and handed to rcl_yaml_params_deserialize by every process that
+/// needs the same parameters, skipping the YAML parse entirely.
+/// The image uses host byte order and is intended as a same-machine cache,
+/// not as an interchange format.
+/// \param[in] params_st points to the populated parameter struct
+/// \param[in] allocator memory allocator used for the image
+/// \param[out] buffer is set to the allocated image, owned by the caller
+/// \param[out] buffer_length is set to the image size in bytes
+/// \return RCL_RET_OK on success, or
+/// \return RCL_RET_INVALID_ARGUMENT for NULL arguments, or
+/// \return RCL_RET_BAD_ALLOC on allocation failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_ret_t rcl_yaml_params_serialize(
+  const rcl_params_t * params_st,
+  const rcutils_allocator_t allocator,
+  uint8_t ** buffer,
+  size_t * buffer_length);
+
+/// \brief Rebuild a parameter structure from a serialized image
+/// The buffer may be a read-only memory mapping of a cache file; it is only
+/// read during this call and the returned struct does not reference it.
+/// \param[in] buffer points to an image written by rcl_yaml_params_serialize
+/// \param[in] buffer_length is the image size in bytes
+/// \param[in] allocator memory allocator to be used
+/// \return a pointer to param structure on success or NULL on failure
+RCL_YAML_PARAM_PARSER_PUBLIC
+rcl_params_t * rcl_yaml_params_deserialize(
+  const uint8_t * buffer,
+  size_t buffer_length,
+  const rcutils_allocator_t allocator);
+
 /// \brief Print the parameter structure to stdout
 /// \param[in] params_st points to the populated parameter struct
 RCL_YAML_PARAM_PARSER_PUBLIC
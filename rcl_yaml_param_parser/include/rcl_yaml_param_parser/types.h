@@ -15,6 +15,7 @@
 #define RCL_YAML_PARAM_PARSER__TYPES_H_
 
 #include "rcl/allocator.h"
+#include "rcl/arena.h"
 #include "rcutils/types/string_array.h"
 
 /// \typedef rcl_bool_array_t
@@ -54,6 +55,7 @@ typedef struct rcl_byte_array_s
 /// Only one pointer in this struct will store the value
 typedef struct rcl_variant_s
 {
+  char * raw_value;  ///< Unclassified scalar text; resolved on first typed access
   bool * bool_value;  ///< If bool, gets stored here
   int64_t * integer_value;  ///< If integer, gets stored here
   double * double_value;  ///< If double, gets stored here
@@ -72,6 +74,7 @@ typedef struct rcl_node_params_s
   char ** parameter_names;  ///< Array of parameter names (keys)
   rcl_variant_t * parameter_values;  ///< Array of coressponding parameter values
   size_t num_params;  ///< Number of parameters in the node
+  size_t capacity_params;  ///< Allocated length of the parameter arrays
 } rcl_node_params_t;
 
 /// \typedef rcl_params_t
@@ -81,7 +84,12 @@ typedef struct rcl_params_s
   char ** node_names;  ///< List of names of the node
   rcl_node_params_t * params;  ///<  Array of parameters
   size_t num_nodes;       ///< Number of nodes
-  rcl_allocator_t allocator;  ///< Allocator used
+  size_t capacity_nodes;  ///< Allocated length of the node arrays
+  size_t params_per_node_hint;  ///< Initial capacity of each node's parameter arrays
+  rcl_allocator_t allocator;  ///< Allocator used; carves out of `arena` when one is set
+  struct rcl_params_index_s * index;  ///< Hash index over the names, built on first lookup
+  rcl_arena_t * arena;  ///< Backs every allocation in the tree; released as one by fini
+  size_t ref_count;  ///< Number of owners; fini releases storage when it reaches zero
 } rcl_params_t;
 
 #endif  // RCL_YAML_PARAM_PARSER__TYPES_H_
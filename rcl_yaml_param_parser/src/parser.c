@@ -18,8 +18,18 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include <yaml.h>
 
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define RCL_YAML_HAVE_MMAP 1
+#include <pthread.h>
+#define RCL_YAML_HAVE_PTHREAD 1
+#endif
+
 #include "rcl_yaml_param_parser/parser.h"
 #include "rcl_yaml_param_parser/types.h"
 
@@ -67,11 +77,13 @@ typedef struct namespace_tracker_s
 #define NODE_NS_SEPERATOR "/"
 #define PARAMETER_NS_SEPERATOR "."
 
-#define MAX_NUM_NODE_ENTRIES 256U
-#define MAX_NUM_PARAMS_PER_NODE 512U
+/// Default capacity hints; the arrays grow geometrically past them as needed
+#define DEFAULT_NUM_NODE_ENTRIES 256U
+#define DEFAULT_NUM_PARAMS_PER_NODE 512U
 
 static rcl_ret_t node_params_init(
   rcl_node_params_t * node_params,
+  size_t capacity,
   const rcl_allocator_t allocator);
 
 static rcl_ret_t add_val_to_bool_arr(
@@ -332,52 +344,387 @@ static rcl_ret_t replace_ns(
 ///
 static rcl_ret_t node_params_init(
   rcl_node_params_t * node_params,
+  size_t capacity,
   const rcl_allocator_t allocator)
 {
   if (NULL == node_params) {
     return RCL_RET_INVALID_ARGUMENT;
   }
+  if (0U == capacity) {
+    capacity = 1U;
+  }
 
-  node_params->parameter_names = allocator.zero_allocate(MAX_NUM_PARAMS_PER_NODE,
+  node_params->parameter_names = allocator.zero_allocate(capacity,
       sizeof(char *), allocator.state);
   if (NULL == node_params->parameter_names) {
     return RCL_RET_BAD_ALLOC;
   }
 
-  node_params->parameter_values = allocator.zero_allocate(MAX_NUM_PARAMS_PER_NODE,
+  node_params->parameter_values = allocator.zero_allocate(capacity,
       sizeof(rcl_variant_t), allocator.state);
   if (NULL == node_params->parameter_values) {
     allocator.deallocate(node_params->parameter_names, allocator.state);
     return RCL_RET_BAD_ALLOC;
   }
+  node_params->capacity_params = capacity;
+
+  return RCL_RET_OK;
+}
+
+///
+/// Double the node arrays when another node entry would not fit
+///
+static rcl_ret_t ensure_node_capacity(rcl_params_t * params_st)
+{
+  rcl_allocator_t allocator = params_st->allocator;
+
+  if (params_st->num_nodes < params_st->capacity_nodes) {
+    return RCL_RET_OK;
+  }
+  const size_t new_capacity = (2U * params_st->capacity_nodes);
+  char ** node_names = allocator.zero_allocate(new_capacity, sizeof(char *), allocator.state);
+  if (NULL == node_names) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcl_node_params_t * params = allocator.zero_allocate(new_capacity, sizeof(rcl_node_params_t),
+      allocator.state);
+  if (NULL == params) {
+    allocator.deallocate(node_names, allocator.state);
+    return RCL_RET_BAD_ALLOC;
+  }
+  memmove(node_names, params_st->node_names, (params_st->num_nodes * sizeof(char *)));
+  memmove(params, params_st->params, (params_st->num_nodes * sizeof(rcl_node_params_t)));
+  allocator.deallocate(params_st->node_names, allocator.state);
+  allocator.deallocate(params_st->params, allocator.state);
+  params_st->node_names = node_names;
+  params_st->params = params;
+  params_st->capacity_nodes = new_capacity;
+  return RCL_RET_OK;
+}
+
+///
+/// Double a node's parameter arrays when another parameter would not fit
+///
+static rcl_ret_t ensure_param_capacity(
+  rcl_node_params_t * node_params,
+  const rcl_allocator_t allocator)
+{
+  if (node_params->num_params < node_params->capacity_params) {
+    return RCL_RET_OK;
+  }
+  const size_t new_capacity = (2U * node_params->capacity_params);
+  char ** parameter_names = allocator.zero_allocate(new_capacity, sizeof(char *),
+      allocator.state);
+  if (NULL == parameter_names) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  rcl_variant_t * parameter_values = allocator.zero_allocate(new_capacity, sizeof(rcl_variant_t),
+      allocator.state);
+  if (NULL == parameter_values) {
+    allocator.deallocate(parameter_names, allocator.state);
+    return RCL_RET_BAD_ALLOC;
+  }
+  memmove(parameter_names, node_params->parameter_names,
+    (node_params->num_params * sizeof(char *)));
+  memmove(parameter_values, node_params->parameter_values,
+    (node_params->num_params * sizeof(rcl_variant_t)));
+  allocator.deallocate(node_params->parameter_names, allocator.state);
+  allocator.deallocate(node_params->parameter_values, allocator.state);
+  node_params->parameter_names = parameter_names;
+  node_params->parameter_values = parameter_values;
+  node_params->capacity_params = new_capacity;
+  return RCL_RET_OK;
+}
+
+/// Bucket of the parameter name hash table; keyed on (node index, name)
+typedef struct param_hash_bucket_s
+{
+  size_t node_idx_plus1;  ///< Zero marks an empty bucket
+  size_t param_idx;
+} param_hash_bucket_t;
+
+/// Hash index over node and parameter names.  Built lazily on the first
+/// lookup and rebuilt whenever entries were added since the last build, so
+/// the parser never pays for index maintenance per entry.
+struct rcl_params_index_s
+{
+  size_t indexed_nodes;   ///< Node count when the index was last built
+  size_t indexed_params;  ///< Total parameter count when the index was last built
+  size_t node_bucket_count;
+  size_t * node_buckets;  ///< Node index + 1, zero marks an empty bucket
+  size_t param_bucket_count;
+  param_hash_bucket_t * param_buckets;
+};
+
+/// FNV-1a, seeded so parameter names can be keyed on their node as well
+static size_t hash_name(size_t seed, const char * name)
+{
+  size_t hash = 14695981039346656037ULL ^ seed;
+  for (const char * c = name; '\0' != *c; ++c) {
+    hash = (hash ^ (size_t)(unsigned char)(*c)) * 1099511628211ULL;
+  }
+  return hash;
+}
+
+/// Smallest power of two holding `count` entries at 50% load
+static size_t bucket_count_for(size_t count)
+{
+  size_t bucket_count = 8U;
+  while (bucket_count < (2U * count)) {
+    bucket_count *= 2U;
+  }
+  return bucket_count;
+}
+
+///
+/// (Re)build the hash index from the current contents of the struct
+///
+static rcl_ret_t build_params_index(rcl_params_t * params_st)
+{
+  rcl_allocator_t allocator = params_st->allocator;
+
+  if (NULL == params_st->index) {
+    params_st->index = allocator.zero_allocate(1U, sizeof(struct rcl_params_index_s),
+        allocator.state);
+    if (NULL == params_st->index) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  struct rcl_params_index_s * index = params_st->index;
+
+  size_t total_params = 0U;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    total_params += params_st->params[node_idx].num_params;
+  }
+
+  const size_t node_bucket_count = bucket_count_for(params_st->num_nodes);
+  size_t * node_buckets = allocator.zero_allocate(node_bucket_count, sizeof(size_t),
+      allocator.state);
+  if (NULL == node_buckets) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  const size_t param_bucket_count = bucket_count_for(total_params);
+  param_hash_bucket_t * param_buckets = allocator.zero_allocate(param_bucket_count,
+      sizeof(param_hash_bucket_t), allocator.state);
+  if (NULL == param_buckets) {
+    allocator.deallocate(node_buckets, allocator.state);
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    if (NULL == params_st->node_names[node_idx]) {
+      continue;
+    }
+    size_t bucket = hash_name(0U, params_st->node_names[node_idx]) & (node_bucket_count - 1U);
+    while (0U != node_buckets[bucket]) {
+      bucket = (bucket + 1U) & (node_bucket_count - 1U);
+    }
+    node_buckets[bucket] = (node_idx + 1U);
+
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+      if (NULL == node_params->parameter_names[parameter_idx]) {
+        continue;
+      }
+      size_t param_bucket =
+        hash_name(node_idx + 1U, node_params->parameter_names[parameter_idx]) &
+        (param_bucket_count - 1U);
+      while (0U != param_buckets[param_bucket].node_idx_plus1) {
+        param_bucket = (param_bucket + 1U) & (param_bucket_count - 1U);
+      }
+      param_buckets[param_bucket].node_idx_plus1 = (node_idx + 1U);
+      param_buckets[param_bucket].param_idx = parameter_idx;
+    }
+  }
+
+  if (NULL != index->node_buckets) {
+    allocator.deallocate(index->node_buckets, allocator.state);
+  }
+  if (NULL != index->param_buckets) {
+    allocator.deallocate(index->param_buckets, allocator.state);
+  }
+  index->node_bucket_count = node_bucket_count;
+  index->node_buckets = node_buckets;
+  index->param_bucket_count = param_bucket_count;
+  index->param_buckets = param_buckets;
+  index->indexed_nodes = params_st->num_nodes;
+  index->indexed_params = total_params;
+  return RCL_RET_OK;
+}
+
+///
+/// Free the hash index
+///
+static void params_index_fini(rcl_params_t * params_st)
+{
+  rcl_allocator_t allocator = params_st->allocator;
+
+  if (NULL == params_st->index) {
+    return;
+  }
+  if (NULL != params_st->index->node_buckets) {
+    allocator.deallocate(params_st->index->node_buckets, allocator.state);
+  }
+  if (NULL != params_st->index->param_buckets) {
+    allocator.deallocate(params_st->index->param_buckets, allocator.state);
+  }
+  allocator.deallocate(params_st->index, allocator.state);
+  params_st->index = NULL;
+}
+
+///
+/// Rebuild the hash index if entries were added since it was last built
+///
+static rcl_ret_t refresh_params_index(rcl_params_t * params_st)
+{
+  const struct rcl_params_index_s * index = params_st->index;
 
+  if ((NULL == index) || (index->indexed_nodes != params_st->num_nodes)) {
+    return build_params_index(params_st);
+  }
+  size_t total_params = 0U;
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    total_params += params_st->params[node_idx].num_params;
+  }
+  if (total_params != index->indexed_params) {
+    return build_params_index(params_st);
+  }
   return RCL_RET_OK;
 }
 
+///
+/// Find a node by name through the hash index; the index must be fresh
+///
+static bool find_node_index(
+  const rcl_params_t * params_st,
+  const char * node_name,
+  size_t * node_idx)
+{
+  const struct rcl_params_index_s * index = params_st->index;
+
+  size_t bucket = hash_name(0U, node_name) & (index->node_bucket_count - 1U);
+  while (0U != index->node_buckets[bucket]) {
+    const size_t candidate_idx = (index->node_buckets[bucket] - 1U);
+    if (0 == strcmp(params_st->node_names[candidate_idx], node_name)) {
+      *node_idx = candidate_idx;
+      return true;
+    }
+    bucket = (bucket + 1U) & (index->node_bucket_count - 1U);
+  }
+  return false;
+}
+
+///
+/// Find a node's parameter by name through the hash index
+///
+static bool find_param_index(
+  const rcl_params_t * params_st,
+  const size_t node_idx,
+  const char * param_name,
+  size_t * param_idx)
+{
+  const struct rcl_params_index_s * index = params_st->index;
+  const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+
+  size_t bucket = hash_name(node_idx + 1U, param_name) & (index->param_bucket_count - 1U);
+  while (0U != index->param_buckets[bucket].node_idx_plus1) {
+    const param_hash_bucket_t * entry = &(index->param_buckets[bucket]);
+    if (((entry->node_idx_plus1 - 1U) == node_idx) &&
+      (0 == strcmp(node_params->parameter_names[entry->param_idx], param_name)))
+    {
+      *param_idx = entry->param_idx;
+      return true;
+    }
+    bucket = (bucket + 1U) & (index->param_bucket_count - 1U);
+  }
+  return false;
+}
+
+///
+/// Look up a parameter value through the hash index
+///
+rcl_variant_t * rcl_yaml_node_struct_get(
+  const char * node_name,
+  const char * param_name,
+  rcl_params_t * params_st)
+{
+  if ((NULL == node_name) || (NULL == param_name) || (NULL == params_st)) {
+    return NULL;
+  }
+  if (RCL_RET_OK != refresh_params_index(params_st)) {
+    return NULL;
+  }
+
+  size_t node_idx;
+  if (!find_node_index(params_st, node_name, &node_idx)) {
+    return NULL;
+  }
+  size_t param_idx;
+  if (!find_param_index(params_st, node_idx, param_name, &param_idx)) {
+    return NULL;
+  }
+  return &(params_st->params[node_idx].parameter_values[param_idx]);
+}
+
 ///
 /// Create the rcl_params_t parameter structure
 ///
 rcl_params_t * rcl_yaml_node_struct_init(
   const rcl_allocator_t allocator)
+{
+  return rcl_yaml_node_struct_init_with_capacity(
+    DEFAULT_NUM_NODE_ENTRIES, DEFAULT_NUM_PARAMS_PER_NODE, allocator);
+}
+
+///
+/// Create the rcl_params_t parameter structure with capacity hints
+///
+rcl_params_t * rcl_yaml_node_struct_init_with_capacity(
+  size_t num_nodes_hint,
+  size_t params_per_node_hint,
+  const rcl_allocator_t allocator)
 {
   rcl_params_t * params_st;
 
+  if (0U == num_nodes_hint) {
+    num_nodes_hint = 1U;
+  }
+  if (0U == params_per_node_hint) {
+    params_per_node_hint = 1U;
+  }
+
   params_st = allocator.zero_allocate(1, sizeof(rcl_params_t), allocator.state);
   if (NULL == params_st) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
     return NULL;
   }
 
-  params_st->node_names = allocator.zero_allocate(MAX_NUM_NODE_ENTRIES,
-      sizeof(char *), allocator.state);
+  /// Every allocation in the tree is carved out of one arena, so fini
+  /// releases the whole tree in a handful of frees instead of one per entry
+  params_st->arena = allocator.zero_allocate(1, sizeof(rcl_arena_t), allocator.state);
+  if (NULL == params_st->arena) {
+    allocator.deallocate(params_st, allocator.state);
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    return NULL;
+  }
+  if (RCL_RET_OK != rcl_arena_init(params_st->arena, 16U * 1024U, allocator)) {
+    allocator.deallocate(params_st->arena, allocator.state);
+    allocator.deallocate(params_st, allocator.state);
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error initializing arena");
+    return NULL;
+  }
+  params_st->allocator = rcl_arena_get_allocator(params_st->arena);
+
+  params_st->node_names = params_st->allocator.zero_allocate(num_nodes_hint,
+      sizeof(char *), params_st->allocator.state);
   if (NULL == params_st->node_names) {
     rcl_yaml_node_struct_fini(params_st);
     RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
     return NULL;
   }
 
-  params_st->params = allocator.zero_allocate(MAX_NUM_NODE_ENTRIES, sizeof(rcl_node_params_t),
-      allocator.state);
+  params_st->params = params_st->allocator.zero_allocate(num_nodes_hint,
+      sizeof(rcl_node_params_t), params_st->allocator.state);
   if (NULL == params_st->params) {
     rcl_yaml_node_struct_fini(params_st);
     RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
@@ -385,8 +732,23 @@ rcl_params_t * rcl_yaml_node_struct_init(
   }
 
   params_st->num_nodes = 0U;
-  params_st->allocator = allocator;
+  params_st->capacity_nodes = num_nodes_hint;
+  params_st->params_per_node_hint = params_per_node_hint;
+  params_st->ref_count = 1U;
+
+  return params_st;
+}
 
+///
+/// Take a reference on the param structure instead of copying it
+///
+rcl_params_t * rcl_yaml_node_struct_ref(
+  rcl_params_t * params_st)
+{
+  if (NULL == params_st) {
+    return NULL;
+  }
+  params_st->ref_count++;
   return params_st;
 }
 
@@ -405,6 +767,22 @@ void rcl_yaml_node_struct_fini(
   if (NULL == params_st) {
     return;
   }
+
+  /// Shared structs are only released by the last owner
+  if (params_st->ref_count > 1U) {
+    params_st->ref_count--;
+    return;
+  }
+
+  if (NULL != params_st->arena) {
+    /// Everything in the tree, including the hash index, lives in the arena;
+    /// release it as one instead of walking the entries
+    allocator = params_st->arena->allocator;
+    rcl_arena_fini(params_st->arena);
+    allocator.deallocate(params_st->arena, allocator.state);
+    allocator.deallocate(params_st, allocator.state);
+    return;
+  }
   allocator = params_st->allocator;
 
   for (node_idx = 0; node_idx < params_st->num_nodes; node_idx++) {
@@ -429,6 +807,9 @@ void rcl_yaml_node_struct_fini(
           }
 
           if (NULL != param_var) {
+            if (NULL != param_var->raw_value) {
+              allocator.deallocate(param_var->raw_value, allocator.state);
+            }
             if (NULL != param_var->bool_value) {
               allocator.deallocate(param_var->bool_value, allocator.state);
             } else if (NULL != param_var->integer_value) {
@@ -480,6 +861,7 @@ void rcl_yaml_node_struct_fini(
     allocator.deallocate(params_st->params, allocator.state);
     params_st->params = NULL;
   }
+  params_index_fini(params_st);
   params_st->num_nodes = 0U;
   allocator.deallocate(params_st, allocator.state);
 }
@@ -529,6 +911,8 @@ void rcl_yaml_node_struct_print(
               printf(": %lf\n", *(param_var->double_value));
             } else if (NULL != param_var->string_value) {
               printf(": %s\n", param_var->string_value);
+            } else if (NULL != param_var->raw_value) {
+              printf(": %s\n", param_var->raw_value);
             } else if (NULL != param_var->bool_array_value) {
               printf(": ");
               for (size_t i = 0; i < param_var->bool_array_value->size; i++) {
@@ -570,6 +954,112 @@ void rcl_yaml_node_struct_print(
   }
 }
 
+///
+/// Classify a variant's raw scalar text and cache the converted value
+/// On success the raw text is released and exactly one typed field is set
+///
+static bool resolve_raw_value(
+  rcl_variant_t * param_value,
+  const rcl_allocator_t allocator)
+{
+  void * ret_val;
+  data_types_t val_type;
+
+  if (NULL == param_value->raw_value) {
+    return false;
+  }
+  ret_val = get_value(param_value->raw_value, &val_type, allocator);
+  if (NULL == ret_val) {
+    return false;
+  }
+  switch (val_type) {
+    case DATA_TYPE_BOOL:
+      param_value->bool_value = (bool *)ret_val;
+      break;
+    case DATA_TYPE_INT64:
+      param_value->integer_value = (int64_t *)ret_val;
+      break;
+    case DATA_TYPE_DOUBLE:
+      param_value->double_value = (double *)ret_val;
+      break;
+    case DATA_TYPE_STRING:
+      param_value->string_value = (char *)ret_val;
+      break;
+    default:
+      allocator.deallocate(ret_val, allocator.state);
+      return false;
+  }
+  allocator.deallocate(param_value->raw_value, allocator.state);
+  param_value->raw_value = NULL;
+  return true;
+}
+
+///
+/// Get a scalar parameter as a bool, converting it on first access
+/// The conversion uses the tree's own allocator, so the converted value
+/// lives in the tree's arena and the raw text release is a no-op there.
+///
+const bool * rcl_yaml_variant_get_bool(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st)
+{
+  if ((NULL == param_value) || (NULL == params_st)) {
+    return NULL;
+  }
+  if ((NULL == param_value->bool_value) && (NULL != param_value->raw_value)) {
+    (void)resolve_raw_value(param_value, params_st->allocator);
+  }
+  return param_value->bool_value;
+}
+
+///
+/// Get a scalar parameter as an int64_t, converting it on first access
+///
+const int64_t * rcl_yaml_variant_get_int(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st)
+{
+  if ((NULL == param_value) || (NULL == params_st)) {
+    return NULL;
+  }
+  if ((NULL == param_value->integer_value) && (NULL != param_value->raw_value)) {
+    (void)resolve_raw_value(param_value, params_st->allocator);
+  }
+  return param_value->integer_value;
+}
+
+///
+/// Get a scalar parameter as a double, converting it on first access
+///
+const double * rcl_yaml_variant_get_double(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st)
+{
+  if ((NULL == param_value) || (NULL == params_st)) {
+    return NULL;
+  }
+  if ((NULL == param_value->double_value) && (NULL != param_value->raw_value)) {
+    (void)resolve_raw_value(param_value, params_st->allocator);
+  }
+  return param_value->double_value;
+}
+
+///
+/// Get a scalar parameter as a string, converting it on first access
+///
+const char * rcl_yaml_variant_get_string(
+  rcl_variant_t * param_value,
+  rcl_params_t * params_st)
+{
+  if ((NULL == param_value) || (NULL == params_st)) {
+    return NULL;
+  }
+  if ((NULL == param_value->string_value) && (NULL != param_value->raw_value)) {
+    (void)resolve_raw_value(param_value, params_st->allocator);
+  }
+  return param_value->string_value;
+}
+
 ///
 /// Add a value to a bool array. Create the array if it does not exist
 ///
@@ -704,24 +1194,20 @@ static rcl_ret_t add_val_to_string_arr(
 }
 
 ///
-/// Determine the type of the value and return the converted value
+/// Determine the type of the value without allocating; exactly the out value
+/// matching the returned type is written
 /// NOTE: Only canonical forms supported as of now
 ///
-static void * get_value(
+static data_types_t classify_scalar(
   const char * const value,
-  data_types_t * val_type,
-  const rcl_allocator_t allocator)
+  bool * bool_value,
+  int64_t * int_value,
+  double * double_value)
 {
-  void * ret_val;
   int64_t ival;
   double dval;
   char * endptr = NULL;
 
-  if ((NULL == value) || (NULL == val_type)) {
-    RCL_SET_ERROR_MSG("Invalid arguments");
-    return NULL;
-  }
-
   /// Check if it is bool
   if ((0 == strncmp(value, "Y", strlen(value))) ||
     (0 == strncmp(value, "y", strlen(value))) ||
@@ -735,13 +1221,8 @@ static void * get_value(
     (0 == strncmp(value, "On", strlen(value))) ||
     (0 == strncmp(value, "ON", strlen(value))))
   {
-    *val_type = DATA_TYPE_BOOL;
-    ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-    if (NULL == ret_val) {
-      return NULL;
-    }
-    *((bool *)ret_val) = true;
-    return ret_val;
+    *bool_value = true;
+    return DATA_TYPE_BOOL;
   }
 
   if ((0 == strncmp(value, "N", strlen(value))) ||
@@ -756,13 +1237,8 @@ static void * get_value(
     (0 == strncmp(value, "Off", strlen(value))) ||
     (0 == strncmp(value, "OFF", strlen(value))))
   {
-    *val_type = DATA_TYPE_BOOL;
-    ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
-    if (NULL == ret_val) {
-      return NULL;
-    }
-    *((bool *)ret_val) = false;
-    return ret_val;
+    *bool_value = false;
+    return DATA_TYPE_BOOL;
   }
 
   /// Check for int
@@ -771,13 +1247,8 @@ static void * get_value(
   if ((0 == errno) && (NULL != endptr)) {
     if ((NULL != endptr) && (endptr != value)) {
       if (('\0' != *value) && ('\0' == *endptr)) {
-        *val_type = DATA_TYPE_INT64;
-        ret_val = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
-        if (NULL == ret_val) {
-          return NULL;
-        }
-        *((int64_t *)ret_val) = ival;
-        return ret_val;
+        *int_value = ival;
+        return DATA_TYPE_INT64;
       }
     }
   }
@@ -789,47 +1260,83 @@ static void * get_value(
   if ((0 == errno) && (NULL != endptr)) {
     if ((NULL != endptr) && (endptr != value)) {
       if (('\0' != *value) && ('\0' == *endptr)) {
-        *val_type = DATA_TYPE_DOUBLE;
-        ret_val = allocator.zero_allocate(1U, sizeof(double), allocator.state);
-        if (NULL == ret_val) {
-          return NULL;
-        }
-        *((double *)ret_val) = dval;
-        return ret_val;
+        *double_value = dval;
+        return DATA_TYPE_DOUBLE;
       }
     }
   }
   errno = 0;
 
   /// It is a string
-  *val_type = DATA_TYPE_STRING;
-  ret_val = rcutils_strdup(value, allocator);
-  return ret_val;
+  return DATA_TYPE_STRING;
 }
 
 ///
-/// Parse the value part of the <key:value> pair
+/// Classify the value and return it converted into allocated storage
 ///
-static rcl_ret_t parse_value(
-  const yaml_event_t event,
-  const bool is_seq,
-  data_types_t * seq_data_type,
-  rcl_params_t * params_st)
+static void * get_value(
+  const char * const value,
+  data_types_t * val_type,
+  const rcl_allocator_t allocator)
 {
   void * ret_val;
-  data_types_t val_type;
-  int res = RCL_RET_OK;
-  rcl_allocator_t allocator;
+  bool bval = false;
+  int64_t ival = 0;
+  double dval = 0.0;
 
-  if ((NULL == params_st) || (0U == params_st->num_nodes) || (NULL == seq_data_type)) {
-    return RCL_RET_INVALID_ARGUMENT;
+  if ((NULL == value) || (NULL == val_type)) {
+    RCL_SET_ERROR_MSG("Invalid arguments");
+    return NULL;
   }
-  allocator = params_st->allocator;
 
-  const size_t node_idx = (params_st->num_nodes - 1U);
-  if (0U == params_st->params[node_idx].num_params) {
-    return RCL_RET_INVALID_ARGUMENT;
-  }
+  *val_type = classify_scalar(value, &bval, &ival, &dval);
+  switch (*val_type) {
+    case DATA_TYPE_BOOL:
+      ret_val = allocator.zero_allocate(1U, sizeof(bool), allocator.state);
+      if (NULL != ret_val) {
+        *((bool *)ret_val) = bval;
+      }
+      return ret_val;
+    case DATA_TYPE_INT64:
+      ret_val = allocator.zero_allocate(1U, sizeof(int64_t), allocator.state);
+      if (NULL != ret_val) {
+        *((int64_t *)ret_val) = ival;
+      }
+      return ret_val;
+    case DATA_TYPE_DOUBLE:
+      ret_val = allocator.zero_allocate(1U, sizeof(double), allocator.state);
+      if (NULL != ret_val) {
+        *((double *)ret_val) = dval;
+      }
+      return ret_val;
+    default:
+      return rcutils_strdup(value, allocator);
+  }
+}
+
+///
+/// Parse the value part of the <key:value> pair
+///
+static rcl_ret_t parse_value(
+  const yaml_event_t event,
+  const bool is_seq,
+  data_types_t * seq_data_type,
+  rcl_params_t * params_st)
+{
+  void * ret_val;
+  data_types_t val_type;
+  int res = RCL_RET_OK;
+  rcl_allocator_t allocator;
+
+  if ((NULL == params_st) || (0U == params_st->num_nodes) || (NULL == seq_data_type)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  allocator = params_st->allocator;
+
+  const size_t node_idx = (params_st->num_nodes - 1U);
+  if (0U == params_st->params[node_idx].num_params) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
 
   const size_t parameter_idx = ((params_st->params[node_idx].num_params) - 1U);
   const size_t val_size = event.data.scalar.length;
@@ -859,7 +1366,18 @@ static rcl_ret_t parse_value(
 
   param_value = &(params_st->params[node_idx].parameter_values[parameter_idx]);
 
-  // param_value->string_value = rcutils_strdup(value, allocator);
+  if (false == is_seq) {
+    /// Keep the scalar text as is; it is classified and converted on first
+    /// typed access, so parsing does not pay for parameters never read
+    param_value->raw_value = rcutils_strdup(value, allocator);
+    if (NULL == param_value->raw_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    return RCL_RET_OK;
+  }
+
+  /// Sequence entries are classified eagerly; the element type decides which
+  /// typed array the entry is appended to
   ret_val = get_value(value, &val_type, allocator);
   if (NULL == ret_val) {
     RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing value %s at line %d", value, line_num);
@@ -873,9 +1391,7 @@ static rcl_ret_t parse_value(
       res = RCL_RET_ERROR;
       break;
     case DATA_TYPE_BOOL:
-      if (false == is_seq) {
-        param_value->bool_value = (bool *)ret_val;
-      } else {
+      {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
           param_value->bool_array_value =
@@ -903,9 +1419,7 @@ static rcl_ret_t parse_value(
       }
       break;
     case DATA_TYPE_INT64:
-      if (false == is_seq) {
-        param_value->integer_value = (int64_t *)ret_val;
-      } else {
+      {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
           param_value->integer_array_value =
@@ -933,9 +1447,7 @@ static rcl_ret_t parse_value(
       }
       break;
     case DATA_TYPE_DOUBLE:
-      if (false == is_seq) {
-        param_value->double_value = (double *)ret_val;
-      } else {
+      {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
           param_value->double_array_value =
@@ -963,9 +1475,7 @@ static rcl_ret_t parse_value(
       }
       break;
     case DATA_TYPE_STRING:
-      if (false == is_seq) {
-        param_value->string_value = (char *)ret_val;
-      } else {
+      {
         if (DATA_TYPE_UNKNOWN == *seq_data_type) {
           *seq_data_type = val_type;
           param_value->string_array_value =
@@ -1070,6 +1580,10 @@ static rcl_ret_t parse_key(
           }
           /// The previous key(last name in namespace) was the node name. Remove it
           /// from the namespace
+          res = ensure_node_capacity(params_st);
+          if (RCL_RET_OK != res) {
+            return res;
+          }
           char * node_name_ns = rcutils_strdup(ns_tracker->node_ns, allocator);
           if (NULL == node_name_ns) {
             return RCL_RET_BAD_ALLOC;
@@ -1082,7 +1596,8 @@ static rcl_ret_t parse_key(
               "Internal error adding node namespace at line %d", line_num);
             return res;
           }
-          res = node_params_init(&(params_st->params[num_nodes]), allocator);
+          res = node_params_init(&(params_st->params[num_nodes]),
+              params_st->params_per_node_hint, allocator);
           if (RCL_RET_OK != res) {
             RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
               "Error creating node parameter at line %d", line_num);
@@ -1120,6 +1635,10 @@ static rcl_ret_t parse_key(
           *is_new_map = false;
         }
         /// Add a parameter name into the node parameters
+        res = ensure_param_capacity(&(params_st->params[node_idx]), allocator);
+        if (RCL_RET_OK != res) {
+          return res;
+        }
         parameter_idx = params_st->params[node_idx].num_params;
         parameter_ns = ns_tracker->parameter_ns;
         if (NULL == parameter_ns) {
@@ -1328,9 +1847,38 @@ static rcl_ret_t parse_events(
   return res;
 }
 
+#ifdef RCL_YAML_HAVE_MMAP
+///
+/// Map the whole file read-only so libyaml consumes it in place, instead of
+/// streaming it through stdio a buffer at a time.  Returns false when the
+/// file cannot be mapped (e.g. a pipe or an empty file); the caller then
+/// falls back to the stdio path.
+///
+static bool map_yaml_file(const char * file_path, const uint8_t ** data, size_t * size)
+{
+  int fd = open(file_path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if ((0 != fstat(fd, &file_stat)) || (file_stat.st_size <= 0)) {
+    close(fd);
+    return false;
+  }
+  void * mapping = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (MAP_FAILED == mapping) {
+    return false;
+  }
+  *data = (const uint8_t *)mapping;
+  *size = (size_t)file_stat.st_size;
+  return true;
+}
+#endif  // RCL_YAML_HAVE_MMAP
+
 ///
 /// TODO (anup.pemmaiah): Support string yaml similar to yaml file
-/// TODO (anup.pemmaiah): Support Mutiple yaml files
 ///
 ///
 /// Parse the YAML file and populate params_st
@@ -1340,10 +1888,14 @@ bool rcl_parse_yaml_file(
   rcl_params_t * params_st)
 {
   int32_t res;
-  FILE * yaml_file;
+  FILE * yaml_file = NULL;
   yaml_parser_t parser;
   namespace_tracker_t ns_tracker;
   rcutils_allocator_t allocator;
+#ifdef RCL_YAML_HAVE_MMAP
+  const uint8_t * mapped_data = NULL;
+  size_t mapped_size = 0U;
+#endif
 
   if (NULL == params_st) {
     RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
@@ -1362,20 +1914,33 @@ bool rcl_parse_yaml_file(
     return false;
   }
 
-  yaml_file = fopen(file_path, "r");
-  if (NULL == yaml_file) {
-    yaml_parser_delete(&parser);
-    RCL_SET_ERROR_MSG("Error opening YAML file");
-    return false;
+#ifdef RCL_YAML_HAVE_MMAP
+  if (map_yaml_file(file_path, &mapped_data, &mapped_size)) {
+    yaml_parser_set_input_string(&parser, mapped_data, mapped_size);
+  } else
+#endif
+  {
+    yaml_file = fopen(file_path, "r");
+    if (NULL == yaml_file) {
+      yaml_parser_delete(&parser);
+      RCL_SET_ERROR_MSG("Error opening YAML file");
+      return false;
+    }
+    yaml_parser_set_input_file(&parser, yaml_file);
   }
 
-  yaml_parser_set_input_file(&parser, yaml_file);
-
   memset(&ns_tracker, 0, sizeof(namespace_tracker_t));
   res = parse_events(&parser, &ns_tracker, params_st);
 
   yaml_parser_delete(&parser);
-  fclose(yaml_file);
+  if (NULL != yaml_file) {
+    fclose(yaml_file);
+  }
+#ifdef RCL_YAML_HAVE_MMAP
+  if (NULL != mapped_data) {
+    munmap((void *)mapped_data, mapped_size);
+  }
+#endif
 
   if (RCL_RET_OK != res) {
     if (NULL != ns_tracker.node_ns) {
@@ -1390,3 +1955,1467 @@ bool rcl_parse_yaml_file(
 
   return true;
 }
+
+/// Deepest parameter namespace nesting the validator tracks; far beyond any
+/// practical configuration, deeper files are rejected
+#define VALIDATE_MAX_PARAM_NS_DEPTH 64U
+
+///
+/// Run the event stream through the structural and type checks of a parse
+/// without building the tree.  Namespaces are tracked as counts and lengths
+/// only, so validation performs no allocations at all.
+///
+static rcl_ret_t validate_events(yaml_parser_t * parser)
+{
+  int32_t done_parsing = 0;
+  yaml_event_t event;
+  rcl_ret_t res = RCL_RET_OK;
+  bool is_key = true;
+  bool is_seq = false;
+  bool is_new_map = false;
+  bool have_param_key = false;
+  uint32_t line_num = 0;
+  data_types_t seq_data_type = DATA_TYPE_UNKNOWN;
+  uint32_t map_level = 1U;
+  uint32_t map_depth = 0U;
+  uint32_t num_node_ns = 0U;
+  size_t param_ns_depth = 0U;
+  size_t param_ns_len = 0U;
+  size_t last_key_len = 0U;
+  size_t param_ns_len_stack[VALIDATE_MAX_PARAM_NS_DEPTH];
+
+  while (0 == done_parsing) {
+    if (RCL_RET_OK != res) {
+      return res;
+    }
+    res = yaml_parser_parse(parser, &event);
+    if (0 == res) {
+      RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Error parsing a event near line %d", line_num);
+      return RCL_RET_ERROR;
+    }
+    res = RCL_RET_OK;
+    line_num = ((uint32_t)(event.start_mark.line) + 1U);
+    switch (event.type) {
+      case YAML_STREAM_END_EVENT:
+        done_parsing = 1;
+        break;
+      case YAML_SCALAR_EVENT:
+        {
+          const size_t val_size = event.data.scalar.length;
+          const char * value = (char *)event.data.scalar.value;
+          if (val_size > MAX_STRING_SIZE) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "Scalar value at line %d is bigger than %d bytes", line_num, MAX_STRING_SIZE);
+            res = RCL_RET_ERROR;
+            break;
+          }
+          if ((0U == val_size) || (NULL == value)) {
+            RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+              "No %s at line %d", is_key ? "key" : "value", line_num);
+            res = RCL_RET_ERROR;
+            break;
+          }
+          if (true == is_key) {
+            if (MAP_NODE_NAME_LVL == map_level) {
+              if (0 != strncmp(PARAMS_KEY, value, strlen(PARAMS_KEY))) {
+                num_node_ns++;
+              } else {
+                if (0U == num_node_ns) {
+                  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                    "There are no node names before %s at line %d", PARAMS_KEY, line_num);
+                  res = RCL_RET_ERROR;
+                  break;
+                }
+                num_node_ns--;
+                map_level++;
+                have_param_key = false;
+                param_ns_depth = 0U;
+                param_ns_len = 0U;
+              }
+            } else if (MAP_PARAMS_LVL == map_level) {
+              if (true == is_new_map) {
+                /// The previous key is promoted to a parameter namespace
+                if (!have_param_key) {
+                  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                    "Internal error creating param namespace at line %d", line_num);
+                  res = RCL_RET_ERROR;
+                  break;
+                }
+                if (VALIDATE_MAX_PARAM_NS_DEPTH == param_ns_depth) {
+                  RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                    "Parameter namespaces nested too deeply at line %d", line_num);
+                  res = RCL_RET_ERROR;
+                  break;
+                }
+                param_ns_len_stack[param_ns_depth] = param_ns_len;
+                param_ns_depth++;
+                param_ns_len = last_key_len;
+                is_new_map = false;
+              }
+              if ((0U != param_ns_len) &&
+                ((param_ns_len + val_size + 2U) > MAX_STRING_SIZE))
+              {
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "The name length exceeds the MAX size %d at line %d",
+                  MAX_STRING_SIZE, line_num);
+                res = RCL_RET_ERROR;
+                break;
+              }
+              last_key_len = (0U == param_ns_len) ? val_size : (param_ns_len + 1U + val_size);
+              have_param_key = true;
+            } else {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown map level at line %d", line_num);
+              res = RCL_RET_ERROR;
+              break;
+            }
+            is_key = false;
+          } else {
+            if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Cannot have a value before %s at line %d", PARAMS_KEY, line_num);
+              res = RCL_RET_ERROR;
+              break;
+            }
+            if (!have_param_key) {
+              RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                "Cannot have a value without a key at line %d", line_num);
+              res = RCL_RET_ERROR;
+              break;
+            }
+            if (true == is_seq) {
+              bool bval;
+              int64_t ival;
+              double dval;
+              const data_types_t val_type = classify_scalar(value, &bval, &ival, &dval);
+              if (DATA_TYPE_UNKNOWN == seq_data_type) {
+                seq_data_type = val_type;
+              } else if (val_type != seq_data_type) {
+                RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+                  "Sequence should be of same type at line %d", line_num);
+                res = RCL_RET_ERROR;
+                break;
+              }
+            } else {
+              is_key = true;
+            }
+          }
+        }
+        break;
+      case YAML_SEQUENCE_START_EVENT:
+        if (true == is_key) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Sequences cannot be key at line %d", line_num);
+          res = RCL_RET_ERROR;
+          break;
+        }
+        if (map_level < (uint32_t)(MAP_PARAMS_LVL)) {
+          RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "Sequences can only be values and not keys in params. Error at line %d\n", line_num);
+          res = RCL_RET_ERROR;
+          break;
+        }
+        is_seq = true;
+        seq_data_type = DATA_TYPE_UNKNOWN;
+        break;
+      case YAML_SEQUENCE_END_EVENT:
+        is_seq = false;
+        is_key = true;
+        break;
+      case YAML_MAPPING_START_EVENT:
+        map_depth++;
+        is_new_map = true;
+        is_key = true;
+        /// Disable new map if it is PARAMS_KEY map
+        if ((MAP_PARAMS_LVL == map_level) &&
+          ((map_depth - (num_node_ns + 1U)) == 2U))
+        {
+          is_new_map = false;
+        }
+        break;
+      case YAML_MAPPING_END_EVENT:
+        if (MAP_PARAMS_LVL == map_level) {
+          if (param_ns_depth > 0U) {
+            param_ns_depth--;
+            param_ns_len = param_ns_len_stack[param_ns_depth];
+          } else {
+            map_level--;
+          }
+        } else {
+          if ((MAP_NODE_NAME_LVL == map_level) &&
+            (map_depth == (num_node_ns + 1U)) &&
+            (num_node_ns > 0U))
+          {
+            num_node_ns--;
+          }
+        }
+        map_depth--;
+        break;
+      case YAML_ALIAS_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Will not support aliasing at line %d\n", line_num);
+        res = RCL_RET_ERROR;
+        break;
+      case YAML_STREAM_START_EVENT:
+      case YAML_DOCUMENT_START_EVENT:
+      case YAML_DOCUMENT_END_EVENT:
+        break;
+      case YAML_NO_EVENT:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+          "Received an empty event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        break;
+      default:
+        RCL_SET_ERROR_MSG_WITH_FORMAT_STRING("Unknown YAML event at line %d", line_num);
+        res = RCL_RET_ERROR;
+        break;
+    }
+    yaml_event_delete(&event);
+  }
+  return res;
+}
+
+///
+/// Check the YAML file for well-formedness and type consistency without
+/// building a parameter tree
+///
+bool rcl_validate_yaml_file(const char * file_path)
+{
+  int32_t res;
+  FILE * yaml_file = NULL;
+  yaml_parser_t parser;
+#ifdef RCL_YAML_HAVE_MMAP
+  const uint8_t * mapped_data = NULL;
+  size_t mapped_size = 0U;
+#endif
+
+  if (NULL == file_path) {
+    RCL_SET_ERROR_MSG("YAML file path is NULL");
+    return false;
+  }
+
+  res = yaml_parser_initialize(&parser);
+  if (0 == res) {
+    RCL_SET_ERROR_MSG("Could not initialize the parser");
+    return false;
+  }
+
+#ifdef RCL_YAML_HAVE_MMAP
+  if (map_yaml_file(file_path, &mapped_data, &mapped_size)) {
+    yaml_parser_set_input_string(&parser, mapped_data, mapped_size);
+  } else
+#endif
+  {
+    yaml_file = fopen(file_path, "r");
+    if (NULL == yaml_file) {
+      yaml_parser_delete(&parser);
+      RCL_SET_ERROR_MSG("Error opening YAML file");
+      return false;
+    }
+    yaml_parser_set_input_file(&parser, yaml_file);
+  }
+
+  res = validate_events(&parser);
+
+  yaml_parser_delete(&parser);
+  if (NULL != yaml_file) {
+    fclose(yaml_file);
+  }
+#ifdef RCL_YAML_HAVE_MMAP
+  if (NULL != mapped_data) {
+    munmap((void *)mapped_data, mapped_size);
+  }
+#endif
+
+  return RCL_RET_OK == res;
+}
+
+///
+/// Duplicate a flat value into the destination tree's allocator
+///
+static void * copy_bytes(const void * src, size_t size, const rcl_allocator_t allocator)
+{
+  void * dst = allocator.allocate(size, allocator.state);
+  if (NULL != dst) {
+    memmove(dst, src, size);
+  }
+  return dst;
+}
+
+///
+/// Deep copy one parameter value between trees with different arenas
+///
+static rcl_ret_t copy_variant(
+  rcl_variant_t * dst_value,
+  const rcl_variant_t * src_value,
+  const rcl_allocator_t allocator)
+{
+  if (NULL != src_value->raw_value) {
+    dst_value->raw_value = rcutils_strdup(src_value->raw_value, allocator);
+    if (NULL == dst_value->raw_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  }
+  if (NULL != src_value->bool_value) {
+    dst_value->bool_value = copy_bytes(src_value->bool_value, sizeof(bool), allocator);
+    if (NULL == dst_value->bool_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  } else if (NULL != src_value->integer_value) {
+    dst_value->integer_value = copy_bytes(src_value->integer_value, sizeof(int64_t), allocator);
+    if (NULL == dst_value->integer_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  } else if (NULL != src_value->double_value) {
+    dst_value->double_value = copy_bytes(src_value->double_value, sizeof(double), allocator);
+    if (NULL == dst_value->double_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  } else if (NULL != src_value->string_value) {
+    dst_value->string_value = rcutils_strdup(src_value->string_value, allocator);
+    if (NULL == dst_value->string_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+  } else if (NULL != src_value->byte_array_value) {
+    dst_value->byte_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_byte_array_t), allocator.state);
+    if (NULL == dst_value->byte_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    dst_value->byte_array_value->size = src_value->byte_array_value->size;
+    if (0U != src_value->byte_array_value->size) {
+      dst_value->byte_array_value->values = copy_bytes(src_value->byte_array_value->values,
+          (src_value->byte_array_value->size * sizeof(uint8_t)), allocator);
+      if (NULL == dst_value->byte_array_value->values) {
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  } else if (NULL != src_value->bool_array_value) {
+    dst_value->bool_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+    if (NULL == dst_value->bool_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    dst_value->bool_array_value->size = src_value->bool_array_value->size;
+    if (0U != src_value->bool_array_value->size) {
+      dst_value->bool_array_value->values = copy_bytes(src_value->bool_array_value->values,
+          (src_value->bool_array_value->size * sizeof(bool)), allocator);
+      if (NULL == dst_value->bool_array_value->values) {
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  } else if (NULL != src_value->integer_array_value) {
+    dst_value->integer_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+    if (NULL == dst_value->integer_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    dst_value->integer_array_value->size = src_value->integer_array_value->size;
+    if (0U != src_value->integer_array_value->size) {
+      dst_value->integer_array_value->values = copy_bytes(src_value->integer_array_value->values,
+          (src_value->integer_array_value->size * sizeof(int64_t)), allocator);
+      if (NULL == dst_value->integer_array_value->values) {
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  } else if (NULL != src_value->double_array_value) {
+    dst_value->double_array_value =
+      allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
+    if (NULL == dst_value->double_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    dst_value->double_array_value->size = src_value->double_array_value->size;
+    if (0U != src_value->double_array_value->size) {
+      dst_value->double_array_value->values = copy_bytes(src_value->double_array_value->values,
+          (src_value->double_array_value->size * sizeof(double)), allocator);
+      if (NULL == dst_value->double_array_value->values) {
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  } else if (NULL != src_value->string_array_value) {
+    dst_value->string_array_value =
+      allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
+    if (NULL == dst_value->string_array_value) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    rcutils_allocator_t string_allocator = allocator;
+    if (RCUTILS_RET_OK != rcutils_string_array_init(dst_value->string_array_value,
+      src_value->string_array_value->size, &string_allocator))
+    {
+      return RCL_RET_BAD_ALLOC;
+    }
+    for (size_t idx = 0U; idx < src_value->string_array_value->size; idx++) {
+      if (NULL == src_value->string_array_value->data[idx]) {
+        continue;
+      }
+      dst_value->string_array_value->data[idx] =
+        rcutils_strdup(src_value->string_array_value->data[idx], allocator);
+      if (NULL == dst_value->string_array_value->data[idx]) {
+        return RCL_RET_BAD_ALLOC;
+      }
+    }
+  } else {
+    /// Nothing to do to keep pclint happy
+  }
+  return RCL_RET_OK;
+}
+
+///
+/// Append one node entry and deep copies of all its parameters to a tree
+///
+static rcl_ret_t append_node_params(
+  rcl_params_t * dst,
+  const char * node_name,
+  const rcl_node_params_t * src_node)
+{
+  const rcl_allocator_t allocator = dst->allocator;
+
+  rcl_ret_t ret = ensure_node_capacity(dst);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  char * node_name_copy = rcutils_strdup(node_name, allocator);
+  if (NULL == node_name_copy) {
+    return RCL_RET_BAD_ALLOC;
+  }
+  dst->node_names[dst->num_nodes] = node_name_copy;
+  rcl_node_params_t * dst_node = &(dst->params[dst->num_nodes]);
+  ret = node_params_init(dst_node, src_node->num_params, allocator);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+  dst->num_nodes++;
+  for (size_t parameter_idx = 0U; parameter_idx < src_node->num_params; parameter_idx++) {
+    char * param_name = rcutils_strdup(src_node->parameter_names[parameter_idx], allocator);
+    if (NULL == param_name) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    dst_node->parameter_names[dst_node->num_params] = param_name;
+    ret = copy_variant(&(dst_node->parameter_values[dst_node->num_params]),
+        &(src_node->parameter_values[parameter_idx]), allocator);
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+    dst_node->num_params++;
+  }
+  return RCL_RET_OK;
+}
+
+///
+/// Append the contents of a per-file tree to the destination tree, producing
+/// the same node and parameter entries a sequential parse of the file into
+/// the destination would have
+///
+static rcl_ret_t merge_parsed_params(rcl_params_t * dst, const rcl_params_t * src)
+{
+  for (size_t node_idx = 0U; node_idx < src->num_nodes; node_idx++) {
+    rcl_ret_t ret = append_node_params(dst, src->node_names[node_idx],
+        &(src->params[node_idx]));
+    if (RCL_RET_OK != ret) {
+      return ret;
+    }
+  }
+  return RCL_RET_OK;
+}
+
+///
+/// Overlay one parameter tree onto another through the hash index
+///
+rcl_ret_t rcl_yaml_params_merge(
+  rcl_params_t * base,
+  const rcl_params_t * overlay)
+{
+  if ((NULL == base) || (NULL == overlay)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  const rcl_allocator_t allocator = base->allocator;
+
+  /// The index makes every override an O(1) lookup, so the walk only pays
+  /// for the overlay's entries, not for the size of the base
+  rcl_ret_t ret = refresh_params_index(base);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+
+  for (size_t node_idx = 0U; node_idx < overlay->num_nodes; node_idx++) {
+    const rcl_node_params_t * overlay_node = &(overlay->params[node_idx]);
+    size_t base_node_idx;
+    if (!find_node_index(base, overlay->node_names[node_idx], &base_node_idx)) {
+      /// Unknown node: the whole entry is new, append it as one
+      ret = append_node_params(base, overlay->node_names[node_idx], overlay_node);
+      if (RCL_RET_OK != ret) {
+        return ret;
+      }
+      continue;
+    }
+    rcl_node_params_t * base_node = &(base->params[base_node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < overlay_node->num_params; parameter_idx++) {
+      const char * param_name = overlay_node->parameter_names[parameter_idx];
+      const rcl_variant_t * overlay_value = &(overlay_node->parameter_values[parameter_idx]);
+      size_t base_param_idx;
+      if (find_param_index(base, base_node_idx, param_name, &base_param_idx)) {
+        /// Known parameter: replace the value in place; the old value stays
+        /// in the tree's arena until the tree is finalized
+        rcl_variant_t * base_value = &(base_node->parameter_values[base_param_idx]);
+        memset(base_value, 0, sizeof(rcl_variant_t));
+        ret = copy_variant(base_value, overlay_value, allocator);
+      } else {
+        ret = ensure_param_capacity(base_node, allocator);
+        if (RCL_RET_OK == ret) {
+          char * param_name_copy = rcutils_strdup(param_name, allocator);
+          if (NULL == param_name_copy) {
+            return RCL_RET_BAD_ALLOC;
+          }
+          base_node->parameter_names[base_node->num_params] = param_name_copy;
+          ret = copy_variant(&(base_node->parameter_values[base_node->num_params]),
+              overlay_value, allocator);
+          if (RCL_RET_OK == ret) {
+            base_node->num_params++;
+          }
+        }
+      }
+      if (RCL_RET_OK != ret) {
+        return ret;
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
+#ifdef RCL_YAML_HAVE_PTHREAD
+/// One parser thread's slice of the file list; files are striped across the
+/// workers so the slots never overlap
+typedef struct parse_worker_s
+{
+  const char * const * file_paths;
+  size_t count;
+  size_t first;   ///< Index of this worker's first file
+  size_t stride;  ///< Number of workers
+  rcl_allocator_t allocator;  ///< Thread-safe base allocator for the trees
+  rcl_params_t ** trees;  ///< Per-file output slots, shared by index
+  size_t failed_file;  ///< First file this worker could not parse, or SIZE_MAX
+} parse_worker_t;
+
+static void * parse_worker_run(void * arg)
+{
+  parse_worker_t * worker = (parse_worker_t *)arg;
+
+  for (size_t idx = worker->first; idx < worker->count; idx += worker->stride) {
+    rcl_params_t * tree = rcl_yaml_node_struct_init(worker->allocator);
+    if ((NULL == tree) || !rcl_parse_yaml_file(worker->file_paths[idx], tree)) {
+      /// rcl_parse_yaml_file finalizes the tree on failure; the error state
+      /// is thread local, so the caller reports the file by index instead
+      worker->failed_file = idx;
+      return NULL;
+    }
+    worker->trees[idx] = tree;
+  }
+  return NULL;
+}
+
+///
+/// Parse independent files concurrently into per-file trees, then merge them
+/// into params_st in path order so override semantics match a sequential load
+///
+static bool parse_yaml_files_parallel(
+  const char * const * file_paths,
+  size_t count,
+  size_t thread_count,
+  rcl_params_t * params_st)
+{
+  /// The per-file trees must not share the destination's arena; carve them
+  /// out of the arena's backing allocator, which has to be thread-safe
+  const rcl_allocator_t allocator =
+    (NULL != params_st->arena) ? params_st->arena->allocator : params_st->allocator;
+
+  rcl_params_t ** trees = allocator.zero_allocate(count, sizeof(rcl_params_t *),
+      allocator.state);
+  parse_worker_t * workers = allocator.zero_allocate(thread_count, sizeof(parse_worker_t),
+      allocator.state);
+  pthread_t * threads = allocator.zero_allocate(thread_count, sizeof(pthread_t),
+      allocator.state);
+  if ((NULL == trees) || (NULL == workers) || (NULL == threads)) {
+    allocator.deallocate(trees, allocator.state);
+    allocator.deallocate(workers, allocator.state);
+    allocator.deallocate(threads, allocator.state);
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Error allocating mem");
+    return false;
+  }
+
+  for (size_t thread_idx = 0U; thread_idx < thread_count; thread_idx++) {
+    workers[thread_idx].file_paths = file_paths;
+    workers[thread_idx].count = count;
+    workers[thread_idx].first = thread_idx;
+    workers[thread_idx].stride = thread_count;
+    workers[thread_idx].allocator = allocator;
+    workers[thread_idx].trees = trees;
+    workers[thread_idx].failed_file = SIZE_MAX;
+  }
+  /// Worker 0 runs on the calling thread; a worker whose thread cannot be
+  /// created just runs inline, degrading towards a sequential parse
+  size_t started = 0U;
+  for (size_t thread_idx = 1U; thread_idx < thread_count; thread_idx++) {
+    if (0 != pthread_create(&threads[thread_idx], NULL, parse_worker_run,
+      &workers[thread_idx]))
+    {
+      parse_worker_run(&workers[thread_idx]);
+      continue;
+    }
+    threads[started] = threads[thread_idx];
+    started++;
+  }
+  parse_worker_run(&workers[0U]);
+  for (size_t thread_idx = 0U; thread_idx < started; thread_idx++) {
+    pthread_join(threads[thread_idx], NULL);
+  }
+
+  size_t failed_file = SIZE_MAX;
+  for (size_t thread_idx = 0U; thread_idx < thread_count; thread_idx++) {
+    if (workers[thread_idx].failed_file < failed_file) {
+      failed_file = workers[thread_idx].failed_file;
+    }
+  }
+  bool success = (SIZE_MAX == failed_file);
+  if (!success) {
+    RCL_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "Error parsing parameter file '%s'", file_paths[failed_file]);
+  }
+
+  for (size_t idx = 0U; success && (idx < count); idx++) {
+    if (RCL_RET_OK != merge_parsed_params(params_st, trees[idx])) {
+      RCL_SET_ERROR_MSG("Error merging parsed parameter files");
+      success = false;
+    }
+  }
+  for (size_t idx = 0U; idx < count; idx++) {
+    rcl_yaml_node_struct_fini(trees[idx]);
+  }
+  allocator.deallocate(trees, allocator.state);
+  allocator.deallocate(workers, allocator.state);
+  allocator.deallocate(threads, allocator.state);
+
+  if (!success) {
+    rcl_yaml_node_struct_fini(params_st);
+  }
+  return success;
+}
+#endif  // RCL_YAML_HAVE_PTHREAD
+
+///
+/// Parse a list of YAML files in order, concurrently where possible
+///
+bool rcl_parse_yaml_files(
+  const char * const * file_paths,
+  size_t count,
+  size_t thread_count,
+  rcl_params_t * params_st)
+{
+  if (NULL == params_st) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Pass a initialized paramter structure");
+    return false;
+  }
+  if (NULL == file_paths) {
+    RCL_SET_ERROR_MSG("YAML file path array is NULL");
+    return false;
+  }
+  for (size_t idx = 0U; idx < count; idx++) {
+    if (NULL == file_paths[idx]) {
+      RCL_SET_ERROR_MSG("YAML file path is NULL");
+      return false;
+    }
+  }
+
+  if (0U == thread_count) {
+    thread_count = 1U;
+  }
+  if (thread_count > count) {
+    thread_count = count;
+  }
+#ifdef RCL_YAML_HAVE_PTHREAD
+  if (thread_count > 1U) {
+    return parse_yaml_files_parallel(file_paths, count, thread_count, params_st);
+  }
+#endif
+
+  for (size_t idx = 0U; idx < count; idx++) {
+    if (!rcl_parse_yaml_file(file_paths[idx], params_st)) {
+      /// error already set; the struct has been finalized
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Header and value tags of the binary cache image.  The image is host byte
+/// order and carries a version so stale caches are rejected, not misread.
+#define CACHE_MAGIC 0x504C4352u  ///< "RCLP"
+#define CACHE_VERSION 1u
+
+typedef enum cache_value_tag_e
+{
+  CACHE_TAG_BOOL = 1U,
+  CACHE_TAG_INT64 = 2U,
+  CACHE_TAG_DOUBLE = 3U,
+  CACHE_TAG_STRING = 4U,
+  CACHE_TAG_BOOL_ARRAY = 5U,
+  CACHE_TAG_INT64_ARRAY = 6U,
+  CACHE_TAG_DOUBLE_ARRAY = 7U,
+  CACHE_TAG_STRING_ARRAY = 8U,
+  CACHE_TAG_RAW = 9U
+} cache_value_tag_t;
+
+/// Bounds-checked cursor over a serialized image
+typedef struct cache_reader_s
+{
+  const uint8_t * data;
+  size_t size;
+  size_t offset;
+} cache_reader_t;
+
+static bool cache_read(cache_reader_t * reader, void * out, size_t length)
+{
+  if ((reader->size - reader->offset) < length) {
+    return false;
+  }
+  memcpy(out, (reader->data + reader->offset), length);
+  reader->offset += length;
+  return true;
+}
+
+static bool cache_read_u64(cache_reader_t * reader, uint64_t * out)
+{
+  return cache_read(reader, out, sizeof(*out));
+}
+
+/// Read a length-prefixed string into freshly allocated memory
+static char * cache_read_string(cache_reader_t * reader, const rcl_allocator_t allocator)
+{
+  uint64_t length;
+  if (!cache_read_u64(reader, &length)) {
+    return NULL;
+  }
+  if ((reader->size - reader->offset) < length) {
+    return NULL;
+  }
+  char * str = allocator.allocate((size_t)length + 1U, allocator.state);
+  if (NULL == str) {
+    return NULL;
+  }
+  memcpy(str, (reader->data + reader->offset), (size_t)length);
+  str[length] = '\0';
+  reader->offset += (size_t)length;
+  return str;
+}
+
+/// Unchecked cursor used when filling a buffer of precomputed size
+typedef struct cache_writer_s
+{
+  uint8_t * data;
+  size_t offset;
+} cache_writer_t;
+
+static void cache_write(cache_writer_t * writer, const void * in, size_t length)
+{
+  memcpy((writer->data + writer->offset), in, length);
+  writer->offset += length;
+}
+
+static void cache_write_u64(cache_writer_t * writer, uint64_t value)
+{
+  cache_write(writer, &value, sizeof(value));
+}
+
+static void cache_write_string(cache_writer_t * writer, const char * str)
+{
+  const uint64_t length = strlen(str);
+  cache_write_u64(writer, length);
+  cache_write(writer, str, (size_t)length);
+}
+
+static size_t cache_string_size(const char * str)
+{
+  return sizeof(uint64_t) + strlen(str);
+}
+
+/// Size of a variant's serialized form: a tag byte plus the payload
+static size_t cache_value_size(const rcl_variant_t * value)
+{
+  size_t size = 1U;
+  if (NULL != value->bool_value) {
+    size += 1U;
+  } else if (NULL != value->integer_value) {
+    size += sizeof(int64_t);
+  } else if (NULL != value->double_value) {
+    size += sizeof(double);
+  } else if (NULL != value->string_value) {
+    size += cache_string_size(value->string_value);
+  } else if (NULL != value->bool_array_value) {
+    size += sizeof(uint64_t) + value->bool_array_value->size;
+  } else if (NULL != value->integer_array_value) {
+    size += sizeof(uint64_t) + (value->integer_array_value->size * sizeof(int64_t));
+  } else if (NULL != value->double_array_value) {
+    size += sizeof(uint64_t) + (value->double_array_value->size * sizeof(double));
+  } else if (NULL != value->string_array_value) {
+    size += sizeof(uint64_t);
+    for (size_t i = 0U; i < value->string_array_value->size; i++) {
+      size += cache_string_size(value->string_array_value->data[i]);
+    }
+  } else if (NULL != value->raw_value) {
+    size += cache_string_size(value->raw_value);
+  }
+  return size;
+}
+
+static void cache_write_value(cache_writer_t * writer, const rcl_variant_t * value)
+{
+  if (NULL != value->bool_value) {
+    const uint8_t tag = CACHE_TAG_BOOL;
+    const uint8_t payload = *(value->bool_value) ? 1U : 0U;
+    cache_write(writer, &tag, 1U);
+    cache_write(writer, &payload, 1U);
+  } else if (NULL != value->integer_value) {
+    const uint8_t tag = CACHE_TAG_INT64;
+    cache_write(writer, &tag, 1U);
+    cache_write(writer, value->integer_value, sizeof(int64_t));
+  } else if (NULL != value->double_value) {
+    const uint8_t tag = CACHE_TAG_DOUBLE;
+    cache_write(writer, &tag, 1U);
+    cache_write(writer, value->double_value, sizeof(double));
+  } else if (NULL != value->string_value) {
+    const uint8_t tag = CACHE_TAG_STRING;
+    cache_write(writer, &tag, 1U);
+    cache_write_string(writer, value->string_value);
+  } else if (NULL != value->bool_array_value) {
+    const uint8_t tag = CACHE_TAG_BOOL_ARRAY;
+    cache_write(writer, &tag, 1U);
+    cache_write_u64(writer, value->bool_array_value->size);
+    for (size_t i = 0U; i < value->bool_array_value->size; i++) {
+      const uint8_t payload = value->bool_array_value->values[i] ? 1U : 0U;
+      cache_write(writer, &payload, 1U);
+    }
+  } else if (NULL != value->integer_array_value) {
+    const uint8_t tag = CACHE_TAG_INT64_ARRAY;
+    cache_write(writer, &tag, 1U);
+    cache_write_u64(writer, value->integer_array_value->size);
+    cache_write(writer, value->integer_array_value->values,
+      (value->integer_array_value->size * sizeof(int64_t)));
+  } else if (NULL != value->double_array_value) {
+    const uint8_t tag = CACHE_TAG_DOUBLE_ARRAY;
+    cache_write(writer, &tag, 1U);
+    cache_write_u64(writer, value->double_array_value->size);
+    cache_write(writer, value->double_array_value->values,
+      (value->double_array_value->size * sizeof(double)));
+  } else if (NULL != value->string_array_value) {
+    const uint8_t tag = CACHE_TAG_STRING_ARRAY;
+    cache_write(writer, &tag, 1U);
+    cache_write_u64(writer, value->string_array_value->size);
+    for (size_t i = 0U; i < value->string_array_value->size; i++) {
+      cache_write_string(writer, value->string_array_value->data[i]);
+    }
+  } else if (NULL != value->raw_value) {
+    /// Scalars not yet accessed stay unclassified in the cache as well
+    const uint8_t tag = CACHE_TAG_RAW;
+    cache_write(writer, &tag, 1U);
+    cache_write_string(writer, value->raw_value);
+  } else {
+    /// A parameter with no value yet; tag zero round-trips to an empty variant
+    const uint8_t tag = 0U;
+    cache_write(writer, &tag, 1U);
+  }
+}
+
+/// Read one variant back; allocations come from the struct's arena
+static bool cache_read_value(
+  cache_reader_t * reader, rcl_variant_t * value, const rcl_allocator_t allocator)
+{
+  uint8_t tag;
+  uint64_t count;
+
+  if (!cache_read(reader, &tag, 1U)) {
+    return false;
+  }
+  switch (tag) {
+    case 0U:
+      return true;
+    case CACHE_TAG_BOOL:
+      {
+        uint8_t payload;
+        if (!cache_read(reader, &payload, 1U)) {
+          return false;
+        }
+        value->bool_value = allocator.allocate(sizeof(bool), allocator.state);
+        if (NULL == value->bool_value) {
+          return false;
+        }
+        *(value->bool_value) = (0U != payload);
+        return true;
+      }
+    case CACHE_TAG_INT64:
+      value->integer_value = allocator.allocate(sizeof(int64_t), allocator.state);
+      if (NULL == value->integer_value) {
+        return false;
+      }
+      return cache_read(reader, value->integer_value, sizeof(int64_t));
+    case CACHE_TAG_DOUBLE:
+      value->double_value = allocator.allocate(sizeof(double), allocator.state);
+      if (NULL == value->double_value) {
+        return false;
+      }
+      return cache_read(reader, value->double_value, sizeof(double));
+    case CACHE_TAG_STRING:
+      value->string_value = cache_read_string(reader, allocator);
+      return NULL != value->string_value;
+    case CACHE_TAG_BOOL_ARRAY:
+      if (!cache_read_u64(reader, &count)) {
+        return false;
+      }
+      value->bool_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_bool_array_t), allocator.state);
+      if (NULL == value->bool_array_value) {
+        return false;
+      }
+      value->bool_array_value->values =
+        allocator.allocate((size_t)count * sizeof(bool), allocator.state);
+      if (NULL == value->bool_array_value->values) {
+        return false;
+      }
+      for (uint64_t i = 0U; i < count; i++) {
+        uint8_t payload;
+        if (!cache_read(reader, &payload, 1U)) {
+          return false;
+        }
+        value->bool_array_value->values[i] = (0U != payload);
+      }
+      value->bool_array_value->size = (size_t)count;
+      return true;
+    case CACHE_TAG_INT64_ARRAY:
+      if (!cache_read_u64(reader, &count)) {
+        return false;
+      }
+      value->integer_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_int64_array_t), allocator.state);
+      if (NULL == value->integer_array_value) {
+        return false;
+      }
+      value->integer_array_value->values =
+        allocator.allocate((size_t)count * sizeof(int64_t), allocator.state);
+      if (NULL == value->integer_array_value->values) {
+        return false;
+      }
+      if (!cache_read(reader, value->integer_array_value->values,
+        (size_t)count * sizeof(int64_t)))
+      {
+        return false;
+      }
+      value->integer_array_value->size = (size_t)count;
+      return true;
+    case CACHE_TAG_DOUBLE_ARRAY:
+      if (!cache_read_u64(reader, &count)) {
+        return false;
+      }
+      value->double_array_value =
+        allocator.zero_allocate(1U, sizeof(rcl_double_array_t), allocator.state);
+      if (NULL == value->double_array_value) {
+        return false;
+      }
+      value->double_array_value->values =
+        allocator.allocate((size_t)count * sizeof(double), allocator.state);
+      if (NULL == value->double_array_value->values) {
+        return false;
+      }
+      if (!cache_read(reader, value->double_array_value->values,
+        (size_t)count * sizeof(double)))
+      {
+        return false;
+      }
+      value->double_array_value->size = (size_t)count;
+      return true;
+    case CACHE_TAG_STRING_ARRAY:
+      if (!cache_read_u64(reader, &count)) {
+        return false;
+      }
+      value->string_array_value =
+        allocator.zero_allocate(1U, sizeof(rcutils_string_array_t), allocator.state);
+      if (NULL == value->string_array_value) {
+        return false;
+      }
+      if (RCL_RET_OK !=
+        rcutils_string_array_init(value->string_array_value, (size_t)count, &allocator))
+      {
+        return false;
+      }
+      for (uint64_t i = 0U; i < count; i++) {
+        value->string_array_value->data[i] = cache_read_string(reader, allocator);
+        if (NULL == value->string_array_value->data[i]) {
+          return false;
+        }
+      }
+      return true;
+    case CACHE_TAG_RAW:
+      value->raw_value = cache_read_string(reader, allocator);
+      return NULL != value->raw_value;
+    default:
+      return false;
+  }
+}
+
+///
+/// Serialize the parameter struct into a flat binary image
+///
+rcl_ret_t rcl_yaml_params_serialize(
+  const rcl_params_t * params_st,
+  const rcl_allocator_t allocator,
+  uint8_t ** buffer,
+  size_t * buffer_length)
+{
+  if ((NULL == params_st) || (NULL == buffer) || (NULL == buffer_length)) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+
+  /// First pass: measure
+  size_t image_size = (2U * sizeof(uint32_t)) + sizeof(uint64_t);
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    image_size += cache_string_size(params_st->node_names[node_idx]);
+    image_size += sizeof(uint64_t);
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+      image_size += cache_string_size(node_params->parameter_names[parameter_idx]);
+      image_size += cache_value_size(&(node_params->parameter_values[parameter_idx]));
+    }
+  }
+
+  uint8_t * image = allocator.allocate(image_size, allocator.state);
+  if (NULL == image) {
+    RCL_SET_ERROR_MSG("Error allocating serialization buffer");
+    return RCL_RET_BAD_ALLOC;
+  }
+
+  /// Second pass: fill
+  cache_writer_t writer = {image, 0U};
+  const uint32_t magic = CACHE_MAGIC;
+  const uint32_t version = CACHE_VERSION;
+  cache_write(&writer, &magic, sizeof(magic));
+  cache_write(&writer, &version, sizeof(version));
+  cache_write_u64(&writer, params_st->num_nodes);
+  for (size_t node_idx = 0U; node_idx < params_st->num_nodes; node_idx++) {
+    cache_write_string(&writer, params_st->node_names[node_idx]);
+    const rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    cache_write_u64(&writer, node_params->num_params);
+    for (size_t parameter_idx = 0U; parameter_idx < node_params->num_params; parameter_idx++) {
+      cache_write_string(&writer, node_params->parameter_names[parameter_idx]);
+      cache_write_value(&writer, &(node_params->parameter_values[parameter_idx]));
+    }
+  }
+
+  *buffer = image;
+  *buffer_length = image_size;
+  return RCL_RET_OK;
+}
+
+///
+/// Rebuild a parameter struct from a serialized image
+///
+rcl_params_t * rcl_yaml_params_deserialize(
+  const uint8_t * buffer,
+  size_t buffer_length,
+  const rcl_allocator_t allocator)
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t num_nodes;
+
+  if (NULL == buffer) {
+    return NULL;
+  }
+  cache_reader_t reader = {buffer, buffer_length, 0U};
+  if (!cache_read(&reader, &magic, sizeof(magic)) ||
+    !cache_read(&reader, &version, sizeof(version)) ||
+    !cache_read_u64(&reader, &num_nodes))
+  {
+    return NULL;
+  }
+  if ((CACHE_MAGIC != magic) || (CACHE_VERSION != version)) {
+    RCUTILS_SAFE_FWRITE_TO_STDERR("Unknown parameter cache format");
+    return NULL;
+  }
+
+  rcl_params_t * params_st =
+    rcl_yaml_node_struct_init_with_capacity((size_t)num_nodes, 1U, allocator);
+  if (NULL == params_st) {
+    return NULL;
+  }
+  /// Tree contents come from the struct's arena, like the YAML parse path
+  const rcl_allocator_t tree_allocator = params_st->allocator;
+
+  for (uint64_t node_idx = 0U; node_idx < num_nodes; node_idx++) {
+    uint64_t num_params;
+
+    if (RCL_RET_OK != ensure_node_capacity(params_st)) {
+      goto fail;
+    }
+    char * node_name = cache_read_string(&reader, tree_allocator);
+    if (NULL == node_name) {
+      goto fail;
+    }
+    params_st->node_names[node_idx] = node_name;
+    if (!cache_read_u64(&reader, &num_params)) {
+      goto fail;
+    }
+    rcl_node_params_t * node_params = &(params_st->params[node_idx]);
+    if (RCL_RET_OK != node_params_init(node_params, (size_t)num_params, tree_allocator)) {
+      goto fail;
+    }
+    params_st->num_nodes++;
+    for (uint64_t parameter_idx = 0U; parameter_idx < num_params; parameter_idx++) {
+      node_params->parameter_names[parameter_idx] = cache_read_string(&reader, tree_allocator);
+      if (NULL == node_params->parameter_names[parameter_idx]) {
+        goto fail;
+      }
+      node_params->num_params++;
+      if (!cache_read_value(
+          &reader, &(node_params->parameter_values[parameter_idx]), tree_allocator))
+      {
+        goto fail;
+      }
+    }
+  }
+  return params_st;
+
+fail:
+  RCUTILS_SAFE_FWRITE_TO_STDERR("Malformed parameter cache");
+  rcl_yaml_node_struct_fini(params_st);
+  return NULL;
+}
+
+/// A watch over one parameter file: the stat of the file as last seen, the
+/// tree changes are folded into, and the delta of the most recent poll
+struct rcl_yaml_params_watch_s
+{
+  char * file_path;
+  rcl_params_t * params_st;  ///< Referenced; released when the watch is finalized
+  rcl_guard_condition_t * guard_condition;  ///< Borrowed, may be NULL
+  rcl_allocator_t allocator;  ///< Backing allocator; watch memory is freed across polls
+  int64_t seen_mtime;
+  int64_t seen_size;
+  rcl_yaml_params_delta_t delta;
+  size_t delta_capacity;
+};
+
+/// Read the file's modification time and size; false when it cannot be statted
+static bool watch_stat_file(const char * file_path, int64_t * mtime, int64_t * size)
+{
+  struct stat file_info;
+
+  if (0 != stat(file_path, &file_info)) {
+    return false;
+  }
+  *mtime = (int64_t)file_info.st_mtime;
+  *size = (int64_t)file_info.st_size;
+  return true;
+}
+
+///
+/// Compare two parameter values.  A scalar a reader already converted has had
+/// its raw text released, so where only one side is still raw it is resolved
+/// first and the comparison is made on the typed values; values of different
+/// or unresolvable types compare as changed.
+///
+static bool variants_equal(
+  rcl_variant_t * lhs,
+  const rcl_allocator_t lhs_allocator,
+  rcl_variant_t * rhs,
+  const rcl_allocator_t rhs_allocator)
+{
+  if ((NULL != lhs->raw_value) && (NULL != rhs->raw_value)) {
+    return 0 == strcmp(lhs->raw_value, rhs->raw_value);
+  }
+  if ((NULL != lhs->raw_value) && !resolve_raw_value(lhs, lhs_allocator)) {
+    return false;
+  }
+  if ((NULL != rhs->raw_value) && !resolve_raw_value(rhs, rhs_allocator)) {
+    return false;
+  }
+  if ((NULL != lhs->bool_value) && (NULL != rhs->bool_value)) {
+    return *(lhs->bool_value) == *(rhs->bool_value);
+  }
+  if ((NULL != lhs->integer_value) && (NULL != rhs->integer_value)) {
+    return *(lhs->integer_value) == *(rhs->integer_value);
+  }
+  if ((NULL != lhs->double_value) && (NULL != rhs->double_value)) {
+    return *(lhs->double_value) == *(rhs->double_value);
+  }
+  if ((NULL != lhs->string_value) && (NULL != rhs->string_value)) {
+    return 0 == strcmp(lhs->string_value, rhs->string_value);
+  }
+  if ((NULL != lhs->byte_array_value) && (NULL != rhs->byte_array_value)) {
+    return (lhs->byte_array_value->size == rhs->byte_array_value->size) &&
+           ((0U == lhs->byte_array_value->size) ||
+           (0 == memcmp(lhs->byte_array_value->values, rhs->byte_array_value->values,
+           lhs->byte_array_value->size * sizeof(uint8_t))));
+  }
+  if ((NULL != lhs->bool_array_value) && (NULL != rhs->bool_array_value)) {
+    return (lhs->bool_array_value->size == rhs->bool_array_value->size) &&
+           ((0U == lhs->bool_array_value->size) ||
+           (0 == memcmp(lhs->bool_array_value->values, rhs->bool_array_value->values,
+           lhs->bool_array_value->size * sizeof(bool))));
+  }
+  if ((NULL != lhs->integer_array_value) && (NULL != rhs->integer_array_value)) {
+    return (lhs->integer_array_value->size == rhs->integer_array_value->size) &&
+           ((0U == lhs->integer_array_value->size) ||
+           (0 == memcmp(lhs->integer_array_value->values, rhs->integer_array_value->values,
+           lhs->integer_array_value->size * sizeof(int64_t))));
+  }
+  if ((NULL != lhs->double_array_value) && (NULL != rhs->double_array_value)) {
+    return (lhs->double_array_value->size == rhs->double_array_value->size) &&
+           ((0U == lhs->double_array_value->size) ||
+           (0 == memcmp(lhs->double_array_value->values, rhs->double_array_value->values,
+           lhs->double_array_value->size * sizeof(double))));
+  }
+  if ((NULL != lhs->string_array_value) && (NULL != rhs->string_array_value)) {
+    if (lhs->string_array_value->size != rhs->string_array_value->size) {
+      return false;
+    }
+    for (size_t idx = 0U; idx < lhs->string_array_value->size; idx++) {
+      const char * lhs_str = lhs->string_array_value->data[idx];
+      const char * rhs_str = rhs->string_array_value->data[idx];
+      if ((NULL == lhs_str) != (NULL == rhs_str)) {
+        return false;
+      }
+      if ((NULL != lhs_str) && (0 != strcmp(lhs_str, rhs_str))) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+///
+/// Record one changed parameter in the watch's delta
+///
+static rcl_ret_t watch_delta_append(
+  rcl_yaml_params_watch_t * watch,
+  const char * node_name,
+  const char * param_name)
+{
+  const rcl_allocator_t allocator = watch->allocator;
+
+  if (watch->delta.num_entries >= watch->delta_capacity) {
+    const size_t new_capacity =
+      (0U == watch->delta_capacity) ? 8U : (2U * watch->delta_capacity);
+    const char ** node_names = allocator.reallocate((void *)watch->delta.node_names,
+        (new_capacity * sizeof(const char *)), allocator.state);
+    if (NULL == node_names) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    watch->delta.node_names = node_names;
+    const char ** parameter_names = allocator.reallocate((void *)watch->delta.parameter_names,
+        (new_capacity * sizeof(const char *)), allocator.state);
+    if (NULL == parameter_names) {
+      return RCL_RET_BAD_ALLOC;
+    }
+    watch->delta.parameter_names = parameter_names;
+    watch->delta_capacity = new_capacity;
+  }
+  watch->delta.node_names[watch->delta.num_entries] = node_name;
+  watch->delta.parameter_names[watch->delta.num_entries] = param_name;
+  watch->delta.num_entries++;
+  return RCL_RET_OK;
+}
+
+///
+/// Fold a freshly parsed tree into the watched tree, recording every
+/// parameter whose value actually differs.  Mirrors rcl_yaml_params_merge,
+/// but values that compare equal are skipped so the delta names only real
+/// changes; the delta entries point at the watched tree's name strings.
+///
+static rcl_ret_t watch_apply_changes(
+  rcl_yaml_params_watch_t * watch,
+  rcl_params_t * fresh)
+{
+  rcl_params_t * base = watch->params_st;
+  const rcl_allocator_t allocator = base->allocator;
+
+  rcl_ret_t ret = refresh_params_index(base);
+  if (RCL_RET_OK != ret) {
+    return ret;
+  }
+
+  for (size_t node_idx = 0U; node_idx < fresh->num_nodes; node_idx++) {
+    rcl_node_params_t * fresh_node = &(fresh->params[node_idx]);
+    size_t base_node_idx;
+    if (!find_node_index(base, fresh->node_names[node_idx], &base_node_idx)) {
+      /// Unknown node: every parameter of the appended entry is a change
+      ret = append_node_params(base, fresh->node_names[node_idx], fresh_node);
+      if (RCL_RET_OK != ret) {
+        return ret;
+      }
+      const size_t new_node_idx = base->num_nodes - 1U;
+      const rcl_node_params_t * new_node = &(base->params[new_node_idx]);
+      for (size_t parameter_idx = 0U; parameter_idx < new_node->num_params; parameter_idx++) {
+        ret = watch_delta_append(watch, base->node_names[new_node_idx],
+            new_node->parameter_names[parameter_idx]);
+        if (RCL_RET_OK != ret) {
+          return ret;
+        }
+      }
+      continue;
+    }
+    rcl_node_params_t * base_node = &(base->params[base_node_idx]);
+    for (size_t parameter_idx = 0U; parameter_idx < fresh_node->num_params; parameter_idx++) {
+      const char * param_name = fresh_node->parameter_names[parameter_idx];
+      rcl_variant_t * fresh_value = &(fresh_node->parameter_values[parameter_idx]);
+      size_t base_param_idx;
+      if (find_param_index(base, base_node_idx, param_name, &base_param_idx)) {
+        rcl_variant_t * base_value = &(base_node->parameter_values[base_param_idx]);
+        if (variants_equal(base_value, allocator, fresh_value, fresh->allocator)) {
+          continue;
+        }
+        memset(base_value, 0, sizeof(rcl_variant_t));
+        ret = copy_variant(base_value, fresh_value, allocator);
+        if (RCL_RET_OK != ret) {
+          return ret;
+        }
+        ret = watch_delta_append(watch, base->node_names[base_node_idx],
+            base_node->parameter_names[base_param_idx]);
+      } else {
+        ret = ensure_param_capacity(base_node, allocator);
+        if (RCL_RET_OK != ret) {
+          return ret;
+        }
+        char * param_name_copy = rcutils_strdup(param_name, allocator);
+        if (NULL == param_name_copy) {
+          return RCL_RET_BAD_ALLOC;
+        }
+        base_node->parameter_names[base_node->num_params] = param_name_copy;
+        ret = copy_variant(&(base_node->parameter_values[base_node->num_params]),
+            fresh_value, allocator);
+        if (RCL_RET_OK != ret) {
+          return ret;
+        }
+        base_node->num_params++;
+        ret = watch_delta_append(watch, base->node_names[base_node_idx], param_name_copy);
+      }
+      if (RCL_RET_OK != ret) {
+        return ret;
+      }
+    }
+  }
+  return RCL_RET_OK;
+}
+
+///
+/// Start watching a YAML file for changes to fold into a parameter tree
+///
+rcl_yaml_params_watch_t * rcl_yaml_params_watch_init(
+  const char * file_path,
+  rcl_params_t * params_st,
+  rcl_guard_condition_t * guard_condition)
+{
+  if ((NULL == file_path) || (NULL == params_st)) {
+    return NULL;
+  }
+  /// Watch memory is allocated and released across polls, so it comes from
+  /// the tree's backing allocator, not from the arena, which never frees
+  const rcl_allocator_t allocator =
+    (NULL != params_st->arena) ? params_st->arena->allocator : params_st->allocator;
+
+  rcl_yaml_params_watch_t * watch = allocator.zero_allocate(1U,
+      sizeof(rcl_yaml_params_watch_t), allocator.state);
+  if (NULL == watch) {
+    return NULL;
+  }
+  watch->file_path = rcutils_strdup(file_path, allocator);
+  if (NULL == watch->file_path) {
+    allocator.deallocate(watch, allocator.state);
+    return NULL;
+  }
+  watch->allocator = allocator;
+  watch->params_st = rcl_yaml_node_struct_ref(params_st);
+  watch->guard_condition = guard_condition;
+  /// The current file is the baseline the caller already parsed; a file
+  /// missing at init is fine, the first poll that sees it parses it
+  watch->seen_mtime = -1;
+  watch->seen_size = -1;
+  (void)watch_stat_file(watch->file_path, &(watch->seen_mtime), &(watch->seen_size));
+  return watch;
+}
+
+///
+/// Check the watched file and apply its changes if it was modified
+///
+rcl_ret_t rcl_yaml_params_watch_poll(
+  rcl_yaml_params_watch_t * watch,
+  const rcl_yaml_params_delta_t ** delta)
+{
+  if (NULL == watch) {
+    return RCL_RET_INVALID_ARGUMENT;
+  }
+  if (NULL != delta) {
+    *delta = NULL;
+  }
+
+  int64_t mtime;
+  int64_t size;
+  if (!watch_stat_file(watch->file_path, &mtime, &size)) {
+    /// Missing, for instance mid-way through an atomic replace; keep the
+    /// last seen stat and pick the file up on a later poll
+    return RCL_RET_OK;
+  }
+  if ((mtime == watch->seen_mtime) && (size == watch->seen_size)) {
+    return RCL_RET_OK;
+  }
+  /// Record the stat before parsing so a file that fails to parse is not
+  /// re-parsed on every poll until it is edited again
+  watch->seen_mtime = mtime;
+  watch->seen_size = size;
+
+  rcl_params_t * fresh = rcl_yaml_node_struct_init(watch->allocator);
+  if (NULL == fresh) {
+    RCL_SET_ERROR_MSG("Error allocating tree for re-parse");
+    return RCL_RET_BAD_ALLOC;
+  }
+  if (!rcl_parse_yaml_file(watch->file_path, fresh)) {
+    /// error already set; the fresh tree has been finalized and the
+    /// watched tree is untouched
+    return RCL_RET_ERROR;
+  }
+
+  watch->delta.num_entries = 0U;
+  rcl_ret_t ret = watch_apply_changes(watch, fresh);
+  rcl_yaml_node_struct_fini(fresh);
+  if (RCL_RET_OK != ret) {
+    RCL_SET_ERROR_MSG("Error applying re-parsed parameter file");
+    return ret;
+  }
+
+  if ((0U != watch->delta.num_entries) && (NULL != watch->guard_condition)) {
+    ret = rcl_trigger_guard_condition(watch->guard_condition);
+    if (RCL_RET_OK != ret) {
+      return ret;  // error already set
+    }
+  }
+  if (NULL != delta) {
+    *delta = &(watch->delta);
+  }
+  return RCL_RET_OK;
+}
+
+///
+/// Finalize a file watch
+///
+void rcl_yaml_params_watch_fini(
+  rcl_yaml_params_watch_t * watch)
+{
+  if (NULL == watch) {
+    return;
+  }
+  const rcl_allocator_t allocator = watch->allocator;
+  rcl_yaml_node_struct_fini(watch->params_st);
+  if (NULL != watch->delta.node_names) {
+    allocator.deallocate((void *)watch->delta.node_names, allocator.state);
+  }
+  if (NULL != watch->delta.parameter_names) {
+    allocator.deallocate((void *)watch->delta.parameter_names, allocator.state);
+  }
+  allocator.deallocate(watch->file_path, allocator.state);
+  allocator.deallocate(watch, allocator.state);
+}
@@ -43,6 +43,153 @@ TEST(test_file_parser, correct_syntax) {
   allocator.deallocate(path, allocator.state);
 }
 
+TEST(test_file_parser, hash_index_lookup) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  EXPECT_TRUE(res);
+
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("lidar_ns/lidar_1", "driver1.dx", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const double * dval = rcl_yaml_variant_get_double(param_value, params_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(4.56, *dval);
+
+  param_value = rcl_yaml_node_struct_get("camera", "name", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, params_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("camera1", sval);
+
+  EXPECT_TRUE(NULL == rcl_yaml_node_struct_get("camera", "no_such_param", params_hdl));
+  EXPECT_TRUE(NULL == rcl_yaml_node_struct_get("no_such_node", "name", params_hdl));
+
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+TEST(test_file_parser, lazy_scalar_conversion) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  EXPECT_TRUE(res);
+
+  // Scalars stay as raw text until the first typed access.
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("lidar_ns/lidar_1", "driver1.dx", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  EXPECT_FALSE(NULL == param_value->raw_value);
+  EXPECT_TRUE(NULL == param_value->double_value);
+
+  // Any typed access classifies the raw text; a wrong-type ask returns NULL
+  // but still leaves the converted value cached under its real type.
+  EXPECT_TRUE(NULL == rcl_yaml_variant_get_string(param_value, params_hdl));
+
+  const double * dval = rcl_yaml_variant_get_double(param_value, params_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(4.56, *dval);
+  EXPECT_TRUE(NULL == param_value->raw_value);
+  EXPECT_EQ(dval, rcl_yaml_variant_get_double(param_value, params_hdl));
+
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+TEST(test_file_parser, shared_struct_by_reference) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  EXPECT_TRUE(res);
+
+  rcl_params_t * shared_hdl = rcl_yaml_node_struct_ref(params_hdl);
+  EXPECT_EQ(params_hdl, shared_hdl);
+
+  // Finalizing one owner leaves the tree usable for the other.
+  rcl_yaml_node_struct_fini(params_hdl);
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("camera", "name", shared_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, shared_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("camera1", sval);
+
+  rcl_yaml_node_struct_fini(shared_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
+TEST(test_file_parser, serialize_roundtrip) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path));
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  bool res = rcl_parse_yaml_file(path, params_hdl);
+  EXPECT_TRUE(res);
+
+  uint8_t * buffer = NULL;
+  size_t buffer_length = 0U;
+  ASSERT_EQ(RCL_RET_OK, rcl_yaml_params_serialize(params_hdl, allocator, &buffer, &buffer_length));
+  ASSERT_FALSE(NULL == buffer);
+  EXPECT_LT(0U, buffer_length);
+
+  rcl_params_t * copy_hdl = rcl_yaml_params_deserialize(buffer, buffer_length, allocator);
+  ASSERT_FALSE(NULL == copy_hdl);
+  EXPECT_EQ(params_hdl->num_nodes, copy_hdl->num_nodes);
+
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("lidar_ns/lidar_1", "driver1.dx", copy_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const double * dval = rcl_yaml_variant_get_double(param_value, copy_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(4.56, *dval);
+
+  param_value = rcl_yaml_node_struct_get("lidar_ns/lidar_1", "ports", copy_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  ASSERT_FALSE(NULL == param_value->integer_array_value);
+  ASSERT_EQ(3U, param_value->integer_array_value->size);
+  EXPECT_EQ(2438, param_value->integer_array_value->values[0]);
+
+  param_value = rcl_yaml_node_struct_get("camera", "name", copy_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, copy_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("camera1", sval);
+
+  // A truncated image is rejected, not misread.
+  EXPECT_TRUE(NULL == rcl_yaml_params_deserialize(buffer, buffer_length / 2U, allocator));
+
+  rcl_yaml_node_struct_fini(copy_hdl);
+  allocator.deallocate(buffer, allocator.state);
+  rcl_yaml_node_struct_fini(params_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path, allocator.state);
+}
+
 TEST(test_file_parser, multi_ns_correct_syntax) {
   rcutils_reset_error();
   EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
@@ -206,6 +353,292 @@ TEST(test_file_parser, indented_ns) {
   allocator.deallocate(path, allocator.state);
 }
 
+TEST(test_file_parser, parse_yaml_files) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * path1 = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  char * path2 = rcutils_join_path(test_path, "multi_ns_correct.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(path1));
+  EXPECT_TRUE(rcutils_exists(path2));
+  const char * paths[2] = {path1, path2};
+
+  // Invalid arguments
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  EXPECT_FALSE(rcl_parse_yaml_files(NULL, 2U, 2U, params_hdl));
+  rcutils_reset_error();
+  EXPECT_FALSE(rcl_parse_yaml_files(paths, 2U, 2U, NULL));
+  rcutils_reset_error();
+  const char * bad_paths[2] = {path1, NULL};
+  EXPECT_FALSE(rcl_parse_yaml_files(bad_paths, 2U, 2U, params_hdl));
+  rcutils_reset_error();
+
+  // Parse both files concurrently
+  bool res = rcl_parse_yaml_files(paths, 2U, 2U, params_hdl);
+  ASSERT_TRUE(res) << rcutils_get_error_string().str;
+
+  // Reference result of the sequential loads, in the same order
+  rcl_params_t * seq_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == seq_hdl);
+  ASSERT_TRUE(rcl_parse_yaml_file(path1, seq_hdl));
+  ASSERT_TRUE(rcl_parse_yaml_file(path2, seq_hdl));
+  ASSERT_EQ(seq_hdl->num_nodes, params_hdl->num_nodes);
+  for (size_t node_idx = 0U; node_idx < seq_hdl->num_nodes; node_idx++) {
+    EXPECT_STREQ(seq_hdl->node_names[node_idx], params_hdl->node_names[node_idx]);
+    EXPECT_EQ(
+      seq_hdl->params[node_idx].num_params, params_hdl->params[node_idx].num_params);
+  }
+
+  // Entries from the first file
+  rcl_variant_t * param_value =
+    rcl_yaml_node_struct_get("camera", "name", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, params_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("camera1", sval);
+
+  // Entries from the second file
+  param_value = rcl_yaml_node_struct_get(
+    "lidar_ns/lidar_1/lidar11/lidar111", "driver1.driver11.driver111.dx", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const double * dval = rcl_yaml_variant_get_double(param_value, params_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(4.56, *dval);
+
+  rcl_yaml_node_struct_fini(seq_hdl);
+  rcl_yaml_node_struct_fini(params_hdl);
+
+  // A single thread takes the sequential path
+  params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  res = rcl_parse_yaml_files(paths, 2U, 1U, params_hdl);
+  EXPECT_TRUE(res);
+  EXPECT_FALSE(NULL == rcl_yaml_node_struct_get("camera", "name", params_hdl));
+  rcl_yaml_node_struct_fini(params_hdl);
+
+  // A parse failure anywhere finalizes the struct, like rcl_parse_yaml_file
+  char * bad_path = rcutils_join_path(test_path, "no_value1.yaml", allocator);
+  const char * mixed_paths[2] = {path1, bad_path};
+  params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  EXPECT_FALSE(rcl_parse_yaml_files(mixed_paths, 2U, 2U, params_hdl));
+  rcutils_reset_error();
+
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(path1, allocator.state);
+  allocator.deallocate(path2, allocator.state);
+  allocator.deallocate(bad_path, allocator.state);
+}
+
+TEST(test_file_parser, params_merge) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+  char * base_path = rcutils_join_path(test_path, "correct_config.yaml", allocator);
+  char * overlay_path = rcutils_join_path(test_path, "overlay_config.yaml", allocator);
+  EXPECT_TRUE(rcutils_exists(base_path));
+  EXPECT_TRUE(rcutils_exists(overlay_path));
+
+  rcl_params_t * base_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == base_hdl);
+  ASSERT_TRUE(rcl_parse_yaml_file(base_path, base_hdl));
+  rcl_params_t * overlay_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == overlay_hdl);
+  ASSERT_TRUE(rcl_parse_yaml_file(overlay_path, overlay_hdl));
+
+  // Invalid arguments
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_yaml_params_merge(NULL, overlay_hdl));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_yaml_params_merge(base_hdl, NULL));
+
+  const size_t num_base_nodes = base_hdl->num_nodes;
+  ASSERT_EQ(RCL_RET_OK, rcl_yaml_params_merge(base_hdl, overlay_hdl));
+
+  // Overridden parameters take the overlay's value
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("camera", "name", base_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, base_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("camera_override", sval);
+
+  param_value = rcl_yaml_node_struct_get("lidar_ns/lidar_1", "driver1.dx", base_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const double * dval = rcl_yaml_variant_get_double(param_value, base_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(9.99, *dval);
+
+  // Parameters only in the overlay are appended to the existing node
+  param_value = rcl_yaml_node_struct_get("camera", "zoom", base_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const int64_t * ival = rcl_yaml_variant_get_int(param_value, base_hdl);
+  ASSERT_FALSE(NULL == ival);
+  EXPECT_EQ(3, *ival);
+
+  // Nodes only in the overlay are appended whole
+  EXPECT_EQ(num_base_nodes + 1U, base_hdl->num_nodes);
+  param_value = rcl_yaml_node_struct_get("site", "location", base_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  sval = rcl_yaml_variant_get_string(param_value, base_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("lab", sval);
+
+  // Untouched base entries are left as is
+  param_value = rcl_yaml_node_struct_get("lidar_ns/lidar_1", "driver1.dy", base_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  dval = rcl_yaml_variant_get_double(param_value, base_hdl);
+  ASSERT_FALSE(NULL == dval);
+  EXPECT_DOUBLE_EQ(2.30, *dval);
+
+  // The overlay is unchanged and independently owned
+  param_value = rcl_yaml_node_struct_get("camera", "name", overlay_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  rcl_yaml_node_struct_fini(overlay_hdl);
+  param_value = rcl_yaml_node_struct_get("site", "location", base_hdl);
+  EXPECT_FALSE(NULL == param_value);
+
+  rcl_yaml_node_struct_fini(base_hdl);
+  allocator.deallocate(test_path, allocator.state);
+  allocator.deallocate(base_path, allocator.state);
+  allocator.deallocate(overlay_path, allocator.state);
+}
+
+static void write_file(const char * path, const char * contents)
+{
+  FILE * file = fopen(path, "w");
+  ASSERT_FALSE(NULL == file);
+  fputs(contents, file);
+  fclose(file);
+}
+
+TEST(test_file_parser, params_watch) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * path = rcutils_join_path(cur_dir, "watched_config.yaml", allocator);
+
+  // Revisions deliberately differ in size so the change is seen even on
+  // filesystems with coarse modification timestamps.
+  write_file(
+    path,
+    "robot:\n"
+    "  ros__parameters:\n"
+    "    name: first\n"
+    "    rate: 10\n");
+  rcl_params_t * params_hdl = rcl_yaml_node_struct_init(allocator);
+  EXPECT_FALSE(NULL == params_hdl);
+  ASSERT_TRUE(rcl_parse_yaml_file(path, params_hdl));
+
+  // Invalid arguments
+  EXPECT_TRUE(NULL == rcl_yaml_params_watch_init(NULL, params_hdl, NULL));
+  EXPECT_TRUE(NULL == rcl_yaml_params_watch_init(path, NULL, NULL));
+  EXPECT_EQ(RCL_RET_INVALID_ARGUMENT, rcl_yaml_params_watch_poll(NULL, NULL));
+
+  rcl_yaml_params_watch_t * watch = rcl_yaml_params_watch_init(path, params_hdl, NULL);
+  ASSERT_FALSE(NULL == watch);
+
+  // The file as it was at init is the baseline; nothing to report
+  rcl_yaml_params_delta_t sentinel = {NULL, NULL, 0U};
+  const rcl_yaml_params_delta_t * delta = &sentinel;
+  EXPECT_EQ(RCL_RET_OK, rcl_yaml_params_watch_poll(watch, &delta));
+  EXPECT_TRUE(NULL == delta);
+
+  // One changed value and one new parameter; the unchanged one is not reported
+  write_file(
+    path,
+    "robot:\n"
+    "  ros__parameters:\n"
+    "    name: second_name\n"
+    "    rate: 10\n"
+    "    retries: 3\n");
+  ASSERT_EQ(RCL_RET_OK, rcl_yaml_params_watch_poll(watch, &delta));
+  ASSERT_FALSE(NULL == delta);
+  ASSERT_EQ(2U, delta->num_entries);
+  EXPECT_STREQ("robot", delta->node_names[0]);
+  EXPECT_STREQ("name", delta->parameter_names[0]);
+  EXPECT_STREQ("robot", delta->node_names[1]);
+  EXPECT_STREQ("retries", delta->parameter_names[1]);
+
+  rcl_variant_t * param_value = rcl_yaml_node_struct_get("robot", "name", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const char * sval = rcl_yaml_variant_get_string(param_value, params_hdl);
+  ASSERT_FALSE(NULL == sval);
+  EXPECT_STREQ("second_name", sval);
+  param_value = rcl_yaml_node_struct_get("robot", "retries", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  const int64_t * ival = rcl_yaml_variant_get_int(param_value, params_hdl);
+  ASSERT_FALSE(NULL == ival);
+  EXPECT_EQ(3, *ival);
+
+  // A file that no longer parses leaves the tree untouched
+  write_file(path, "robot: [\n");
+  EXPECT_EQ(RCL_RET_ERROR, rcl_yaml_params_watch_poll(watch, &delta));
+  EXPECT_TRUE(NULL == delta);
+  rcutils_reset_error();
+  param_value = rcl_yaml_node_struct_get("robot", "name", params_hdl);
+  ASSERT_FALSE(NULL == param_value);
+  EXPECT_STREQ("second_name", rcl_yaml_variant_get_string(param_value, params_hdl));
+
+  // The bad file was recorded as seen, so it is not re-parsed until edited
+  EXPECT_EQ(RCL_RET_OK, rcl_yaml_params_watch_poll(watch, &delta));
+  EXPECT_TRUE(NULL == delta);
+
+  // The watch holds a reference, so the tree outlives the caller's fini
+  rcl_yaml_node_struct_fini(params_hdl);
+  write_file(
+    path,
+    "robot:\n"
+    "  ros__parameters:\n"
+    "    name: third_and_final_name\n"
+    "    rate: 10\n"
+    "    retries: 3\n");
+  ASSERT_EQ(RCL_RET_OK, rcl_yaml_params_watch_poll(watch, &delta));
+  ASSERT_FALSE(NULL == delta);
+  ASSERT_EQ(1U, delta->num_entries);
+  EXPECT_STREQ("name", delta->parameter_names[0]);
+
+  rcl_yaml_params_watch_fini(watch);
+  remove(path);
+  allocator.deallocate(path, allocator.state);
+}
+
+TEST(test_file_parser, validate_yaml_file) {
+  rcutils_reset_error();
+  EXPECT_TRUE(rcutils_get_cwd(cur_dir, 1024));
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  char * test_path = rcutils_join_path(cur_dir, "test", allocator);
+
+  // Null path
+  EXPECT_FALSE(rcl_validate_yaml_file(NULL));
+  rcutils_reset_error();
+
+  // Files that parse also validate
+  const char * good_files[] = {
+    "correct_config.yaml", "multi_ns_correct.yaml", "root_ns.yaml", "overlay_config.yaml"};
+  for (const char * file_name : good_files) {
+    char * path = rcutils_join_path(test_path, file_name, allocator);
+    EXPECT_TRUE(rcutils_exists(path));
+    EXPECT_TRUE(rcl_validate_yaml_file(path)) <<
+      file_name << ": " << rcutils_get_error_string().str;
+    allocator.deallocate(path, allocator.state);
+  }
+
+  // Files that fail to parse also fail to validate
+  const char * bad_files[] = {
+    "params_with_no_node.yaml", "no_alias_support.yaml", "max_string_sz.yaml",
+    "no_value1.yaml", "seq_map1.yaml"};
+  for (const char * file_name : bad_files) {
+    char * path = rcutils_join_path(test_path, file_name, allocator);
+    EXPECT_TRUE(rcutils_exists(path));
+    EXPECT_FALSE(rcl_validate_yaml_file(path)) << file_name;
+    rcutils_reset_error();
+    allocator.deallocate(path, allocator.state);
+  }
+
+  allocator.deallocate(test_path, allocator.state);
+}
+
 int32_t main(int32_t argc, char ** argv)
 {
   ::testing::InitGoogleTest(&argc, argv);